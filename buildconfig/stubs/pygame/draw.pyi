@@ -1,5 +1,6 @@
-from typing import Optional, Sequence
+from typing import Any, Optional, Sequence, Union
 
+from pygame.mask import Mask
 from pygame.rect import Rect
 from pygame.surface import Surface
 
@@ -72,3 +73,119 @@ def aalines(
     points: Sequence[Coordinate],
     blend: int = 1,
 ) -> Rect: ...
+def lines_batch(
+    surface: Surface,
+    color: Union[ColorValue, Sequence[ColorValue], Any],
+    lines: Union[Sequence[Union[Sequence[float], RectValue]], Any],
+    width: int = 1,
+) -> Rect: ...
+def circles(
+    surface: Surface,
+    color: Union[ColorValue, Sequence[ColorValue], Any],
+    centers: Union[Sequence[Coordinate], Any],
+    radius: Union[float, Sequence[float], Any],
+    width: int = 0,
+) -> Rect: ...
+def rects(
+    surface: Surface,
+    color: Union[ColorValue, Sequence[ColorValue], Any],
+    rects: Union[Sequence[RectValue], Any],
+    width: int = 0,
+) -> Rect: ...
+def aapolygon(
+    surface: Surface,
+    color: ColorValue,
+    points: Sequence[Coordinate],
+    width: float = 0,
+) -> Rect: ...
+def aacircle(
+    surface: Surface,
+    color: ColorValue,
+    center: Coordinate,
+    radius: float,
+    width: float = 0,
+) -> Rect: ...
+def aastroke(
+    surface: Surface,
+    color: ColorValue,
+    closed: bool,
+    points: Sequence[Coordinate],
+    width: float = 1,
+) -> Rect: ...
+def flood_fill(
+    surface: Surface,
+    color: Optional[ColorValue],
+    pos: Coordinate,
+    tolerance: int = 0,
+    mask: Optional[Mask] = None,
+) -> Rect: ...
+
+class Path:
+    def __init__(self) -> None: ...
+    def move_to(self, pos: Coordinate) -> None: ...
+    def line_to(self, pos: Coordinate) -> None: ...
+    def quad_to(self, control: Coordinate, pos: Coordinate) -> None: ...
+    def cubic_to(
+        self, control1: Coordinate, control2: Coordinate, pos: Coordinate
+    ) -> None: ...
+    def arc(
+        self,
+        center: Coordinate,
+        radius: float,
+        start_angle: float,
+        stop_angle: float,
+    ) -> None: ...
+    def close(self) -> None: ...
+    def add_polygon(self, points: Sequence[Coordinate]) -> None: ...
+    def add_rect(self, rect: RectValue, border_radius: float = 0) -> None: ...
+    def add_circle(self, center: Coordinate, radius: float) -> None: ...
+    def clear(self) -> None: ...
+    def draw(
+        self,
+        surface: Surface,
+        color: ColorValue,
+        pos: Coordinate = (0, 0),
+        width: float = 0,
+    ) -> Rect: ...
+
+class RenderQueue:
+    def __init__(self) -> None: ...
+    def __len__(self) -> int: ...
+    def fill(self, color: ColorValue, rect: Optional[RectValue] = None) -> None: ...
+    def blit(
+        self,
+        source: Surface,
+        dest: Union[Coordinate, RectValue],
+        area: Optional[RectValue] = None,
+        special_flags: int = 0,
+    ) -> None: ...
+    def rect(self, color: ColorValue, rect: RectValue, width: int = 0) -> None: ...
+    def line(
+        self,
+        color: ColorValue,
+        start_pos: Coordinate,
+        end_pos: Coordinate,
+        width: int = 1,
+    ) -> None: ...
+    def lines(
+        self,
+        color: ColorValue,
+        closed: bool,
+        points: Sequence[Coordinate],
+        width: int = 1,
+    ) -> None: ...
+    def circle(
+        self, color: ColorValue, center: Coordinate, radius: float, width: int = 0
+    ) -> None: ...
+    def polygon(
+        self, color: ColorValue, points: Sequence[Coordinate], width: int = 0
+    ) -> None: ...
+    def path(
+        self,
+        path: Path,
+        color: ColorValue,
+        pos: Coordinate = (0, 0),
+        width: float = 0,
+    ) -> None: ...
+    def clear(self) -> None: ...
+    def execute(self, surface: Surface) -> Rect: ...
@@ -33,6 +33,7 @@ def get(
     pump: Any = True,
     exclude: Optional[_EventTypes] = None,
 ) -> List[Event]: ...
+def get_into(buffer: Any, pump: Any = True, coalesce: bool = False) -> int: ...
 def poll() -> Event: ...
 def wait(timeout: int = 0) -> Event: ...
 def peek(eventtype: Optional[_EventTypes] = None, pump: Any = True) -> bool: ...
@@ -41,7 +42,11 @@ def event_name(type: int) -> str: ...
 def set_blocked(type: Optional[_EventTypes]) -> None: ...
 def set_allowed(type: Optional[_EventTypes]) -> None: ...
 def get_blocked(type: _EventTypes) -> bool: ...
+def set_coalesce(type: _EventTypes, coalesce: bool = True) -> None: ...
+def set_rate_limit(type: _EventTypes, rate: float = 0) -> None: ...
+def get_filter_stats() -> Tuple[int, int]: ...
 def set_grab(grab: bool) -> None: ...
 def get_grab() -> bool: ...
 def post(event: Event) -> bool: ...
+def post_payload(type: int, payload: bytes = b"") -> bool: ...
 def custom_type() -> int: ...
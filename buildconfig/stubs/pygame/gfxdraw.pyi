@@ -1,10 +1,13 @@
-from typing import Sequence
+from typing import Any, Optional, Sequence, Union
 
 from pygame.surface import Surface
 
 from ._common import ColorValue, Coordinate, RectValue
 
 def pixel(surface: Surface, x: int, y: int, color: ColorValue) -> None: ...
+def pixels(
+    surface: Surface, points: Sequence[Coordinate], color: ColorValue
+) -> None: ...
 def hline(surface: Surface, x1: int, x2: int, y: int, color: ColorValue) -> None: ...
 def vline(surface: Surface, x: int, y1: int, y2: int, color: ColorValue) -> None: ...
 def line(
@@ -12,6 +15,9 @@ def line(
 ) -> None: ...
 def rectangle(surface: Surface, rect: RectValue, color: ColorValue) -> None: ...
 def box(surface: Surface, rect: RectValue, color: ColorValue) -> None: ...
+def boxes(
+    surface: Surface, rects: Sequence[RectValue], color: ColorValue
+) -> None: ...
 def circle(surface: Surface, x: int, y: int, r: int, color: ColorValue) -> None: ...
 def aacircle(surface: Surface, x: int, y: int, r: int, color: ColorValue) -> None: ...
 def filled_circle(
@@ -86,6 +92,15 @@ def filled_polygon(
 def textured_polygon(
     surface: Surface, points: Sequence[Coordinate], texture: Surface, tx: int, ty: int
 ) -> None: ...
+def textured_triangles(
+    surface: Surface,
+    texture: Surface,
+    vertices: Union[Sequence[Sequence[float]], Any],
+    uvs: Union[Sequence[Sequence[float]], Any],
+    colors: Optional[Sequence[ColorValue]] = None,
+    indices: Optional[Sequence[int]] = None,
+    smooth: bool = False,
+) -> None: ...
 def bezier(
     surface: Surface, points: Sequence[Coordinate], steps: int, color: ColorValue
 ) -> None: ...
@@ -1,5 +1,6 @@
 from typing import Any, List, Optional, Sequence, Tuple, Union
 
+from pygame.bufferproxy import BufferProxy
 from pygame.rect import Rect
 from pygame.surface import Surface
 
@@ -31,18 +32,27 @@ class Mask:
     def clear(self) -> None: ...
     def invert(self) -> None: ...
     def scale(self, scale: Coordinate) -> Mask: ...
+    def rotate(self, angle: float) -> Mask: ...
     def draw(self, other: Mask, offset: Coordinate) -> None: ...
     def erase(self, other: Mask, offset: Coordinate) -> None: ...
+    def compose(
+        self,
+        operations: Sequence[
+            Union[Tuple[Mask, Coordinate], Tuple[Mask, Coordinate, str]]
+        ],
+    ) -> None: ...
     def count(self) -> int: ...
     def centroid(self) -> Tuple[int, int]: ...
     def angle(self) -> float: ...
     def outline(self, every: int = 1) -> List[Tuple[int, int]]: ...
+    def contours(self, epsilon: float = 0) -> List[Tuple[BufferProxy, bool]]: ...
     def convolve(
         self,
         other: Mask,
         output: Optional[Mask] = None,
         offset: Coordinate = (0, 0),
     ) -> Mask: ...
+    def distance_field(self, format: str = "f") -> BufferProxy: ...
     def connected_component(
         self, pos: Union[Sequence[int], Tuple[int, int]] = ...
     ) -> Mask: ...
@@ -58,4 +68,14 @@ class Mask:
         dest: Union[RectValue, Coordinate] = (0, 0),
     ) -> Surface: ...
 
+class RotationCache:
+    steps: int
+    nbytes: int
+    def __init__(
+        self, mask: Mask, steps: int = 360, max_bytes: Optional[int] = 67108864
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def get(self, angle: float) -> Mask: ...
+    def quantize(self, angle: float) -> float: ...
+
 MaskType = Mask
@@ -1,4 +1,5 @@
 import sys
+from array import array
 from typing import (
     Any,
     Generic,
@@ -357,6 +358,184 @@ class Vector3(Collection[float]):
     @overload
     def update(self, x: int, y: int, z: int) -> None: ...
 
+_Vector2ArrayArg = Union[Vector2Array, _SupportsVector2]
+
+@final
+class Vector2Array:
+    @overload
+    def __init__(self, vectors: int = 0) -> None: ...
+    @overload
+    def __init__(self, vectors: Union[Sequence[_SupportsVector2], Any]) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, i: int) -> Vector2: ...
+    def __setitem__(self, i: int, value: _SupportsVector2) -> None: ...
+    def __iter__(self) -> Iterator[Vector2]: ...
+    def __add__(self, other: _Vector2ArrayArg) -> Vector2Array: ...
+    def __radd__(self, other: _SupportsVector2) -> Vector2Array: ...
+    def __sub__(self, other: _Vector2ArrayArg) -> Vector2Array: ...
+    def __rsub__(self, other: _SupportsVector2) -> Vector2Array: ...
+    def __mul__(self, other: float) -> Vector2Array: ...
+    def __rmul__(self, other: float) -> Vector2Array: ...
+    def __truediv__(self, other: float) -> Vector2Array: ...
+    def __iadd__(self, other: _Vector2ArrayArg) -> Vector2Array: ...
+    def __isub__(self, other: _Vector2ArrayArg) -> Vector2Array: ...
+    def __imul__(self, other: float) -> Vector2Array: ...
+    def __itruediv__(self, other: float) -> Vector2Array: ...
+    def __neg__(self) -> Vector2Array: ...
+    def __pos__(self) -> Vector2Array: ...
+    def __copy__(self) -> Vector2Array: ...
+    copy = __copy__
+    def length(self) -> array[float]: ...
+    def length_squared(self) -> array[float]: ...
+    def dot(self, other: _Vector2ArrayArg) -> array[float]: ...
+    def cross(self, other: _Vector2ArrayArg) -> array[float]: ...
+    def distance_to(self, other: _Vector2ArrayArg) -> array[float]: ...
+    def distance_squared_to(self, other: _Vector2ArrayArg) -> array[float]: ...
+    def normalize(self) -> Vector2Array: ...
+    def normalize_ip(self) -> None: ...
+    def rotate(self, angle: float) -> Vector2Array: ...
+    def rotate_ip(self, angle: float) -> None: ...
+    def reflect(self, normal: _Vector2ArrayArg) -> Vector2Array: ...
+    def reflect_ip(self, normal: _Vector2ArrayArg) -> None: ...
+    def lerp(self, other: _Vector2ArrayArg, value: float) -> Vector2Array: ...
+    def slerp(self, other: _Vector2ArrayArg, value: float) -> Vector2Array: ...
+    def move_towards(
+        self, target: _Vector2ArrayArg, max_distance: float
+    ) -> Vector2Array: ...
+    def move_towards_ip(
+        self, target: _Vector2ArrayArg, max_distance: float
+    ) -> None: ...
+    @overload
+    def clamp_magnitude(self, max_length: float) -> Vector2Array: ...
+    @overload
+    def clamp_magnitude(self, min_length: float, max_length: float) -> Vector2Array: ...
+    @overload
+    def clamp_magnitude_ip(self, max_length: float) -> None: ...
+    @overload
+    def clamp_magnitude_ip(self, min_length: float, max_length: float) -> None: ...
+
+_Vector3ArrayArg = Union[Vector3Array, _SupportsVector3]
+
+@final
+class Vector3Array:
+    @overload
+    def __init__(self, vectors: int = 0) -> None: ...
+    @overload
+    def __init__(self, vectors: Union[Sequence[_SupportsVector3], Any]) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, i: int) -> Vector3: ...
+    def __setitem__(self, i: int, value: _SupportsVector3) -> None: ...
+    def __iter__(self) -> Iterator[Vector3]: ...
+    def __add__(self, other: _Vector3ArrayArg) -> Vector3Array: ...
+    def __radd__(self, other: _SupportsVector3) -> Vector3Array: ...
+    def __sub__(self, other: _Vector3ArrayArg) -> Vector3Array: ...
+    def __rsub__(self, other: _SupportsVector3) -> Vector3Array: ...
+    def __mul__(self, other: float) -> Vector3Array: ...
+    def __rmul__(self, other: float) -> Vector3Array: ...
+    def __truediv__(self, other: float) -> Vector3Array: ...
+    def __iadd__(self, other: _Vector3ArrayArg) -> Vector3Array: ...
+    def __isub__(self, other: _Vector3ArrayArg) -> Vector3Array: ...
+    def __imul__(self, other: float) -> Vector3Array: ...
+    def __itruediv__(self, other: float) -> Vector3Array: ...
+    def __neg__(self) -> Vector3Array: ...
+    def __pos__(self) -> Vector3Array: ...
+    def __copy__(self) -> Vector3Array: ...
+    copy = __copy__
+    def length(self) -> array[float]: ...
+    def length_squared(self) -> array[float]: ...
+    def dot(self, other: _Vector3ArrayArg) -> array[float]: ...
+    def cross(self, other: _Vector3ArrayArg) -> Vector3Array: ...
+    def distance_to(self, other: _Vector3ArrayArg) -> array[float]: ...
+    def distance_squared_to(self, other: _Vector3ArrayArg) -> array[float]: ...
+    def normalize(self) -> Vector3Array: ...
+    def normalize_ip(self) -> None: ...
+    def rotate(self, angle: float, axis: _SupportsVector3) -> Vector3Array: ...
+    def rotate_ip(self, angle: float, axis: _SupportsVector3) -> None: ...
+    def reflect(self, normal: _Vector3ArrayArg) -> Vector3Array: ...
+    def reflect_ip(self, normal: _Vector3ArrayArg) -> None: ...
+    def lerp(self, other: _Vector3ArrayArg, value: float) -> Vector3Array: ...
+    def slerp(self, other: _Vector3ArrayArg, value: float) -> Vector3Array: ...
+    def move_towards(
+        self, target: _Vector3ArrayArg, max_distance: float
+    ) -> Vector3Array: ...
+    def move_towards_ip(
+        self, target: _Vector3ArrayArg, max_distance: float
+    ) -> None: ...
+    @overload
+    def clamp_magnitude(self, max_length: float) -> Vector3Array: ...
+    @overload
+    def clamp_magnitude(self, min_length: float, max_length: float) -> Vector3Array: ...
+    @overload
+    def clamp_magnitude_ip(self, max_length: float) -> None: ...
+    @overload
+    def clamp_magnitude_ip(self, min_length: float, max_length: float) -> None: ...
+
+@final
+class Matrix3:
+    def __init__(
+        self, rows: Union[Matrix3, Sequence[float], Sequence[Sequence[float]]] = ...
+    ) -> None: ...
+    @classmethod
+    def from_translation(cls, offset: _SupportsVector2) -> Matrix3: ...
+    @classmethod
+    def from_rotation(cls, angle: float) -> Matrix3: ...
+    @classmethod
+    def from_scale(cls, scale: Union[float, _SupportsVector2]) -> Matrix3: ...
+    def __getitem__(self, i: Tuple[int, int]) -> float: ...
+    def __setitem__(self, i: Tuple[int, int], value: float) -> None: ...
+    @overload
+    def __matmul__(self, other: Matrix3) -> Matrix3: ...
+    @overload
+    def __matmul__(self, other: Vector2Array) -> Vector2Array: ...
+    @overload
+    def __matmul__(self, other: _SupportsVector2) -> Vector2: ...
+    def __imatmul__(self, other: Matrix3) -> Matrix3: ...
+    def __copy__(self) -> Matrix3: ...
+    copy = __copy__
+    def determinant(self) -> float: ...
+    def inverse(self) -> Matrix3: ...
+    def transpose(self) -> Matrix3: ...
+    def decompose(self) -> Tuple[Vector2, float, Vector2]: ...
+    def transform_point(self, point: _SupportsVector2) -> Vector2: ...
+    def transform_vector(self, vector: _SupportsVector2) -> Vector2: ...
+    def transform_points(
+        self, points: Union[Sequence[_SupportsVector2], Any]
+    ) -> Vector2Array: ...
+    def transform_points_ip(self, points: Any) -> None: ...
+
+@final
+class Matrix4:
+    def __init__(
+        self, rows: Union[Matrix4, Sequence[float], Sequence[Sequence[float]]] = ...
+    ) -> None: ...
+    @classmethod
+    def from_translation(cls, offset: _SupportsVector3) -> Matrix4: ...
+    @classmethod
+    def from_rotation(cls, angle: float, axis: _SupportsVector3) -> Matrix4: ...
+    @classmethod
+    def from_scale(cls, scale: Union[float, _SupportsVector3]) -> Matrix4: ...
+    def __getitem__(self, i: Tuple[int, int]) -> float: ...
+    def __setitem__(self, i: Tuple[int, int], value: float) -> None: ...
+    @overload
+    def __matmul__(self, other: Matrix4) -> Matrix4: ...
+    @overload
+    def __matmul__(self, other: Vector3Array) -> Vector3Array: ...
+    @overload
+    def __matmul__(self, other: _SupportsVector3) -> Vector3: ...
+    def __imatmul__(self, other: Matrix4) -> Matrix4: ...
+    def __copy__(self) -> Matrix4: ...
+    copy = __copy__
+    def determinant(self) -> float: ...
+    def inverse(self) -> Matrix4: ...
+    def transpose(self) -> Matrix4: ...
+    def decompose(self) -> Tuple[Vector3, float, Vector3, Vector3]: ...
+    def transform_point(self, point: _SupportsVector3) -> Vector3: ...
+    def transform_vector(self, vector: _SupportsVector3) -> Vector3: ...
+    def transform_points(
+        self, points: Union[Sequence[_SupportsVector3], Any]
+    ) -> Vector3Array: ...
+    def transform_points_ip(self, points: Any) -> None: ...
+
 # typehints for deprecated functions, to be removed in a future version
 def enable_swizzling() -> None: ...
 def disable_swizzling() -> None: ...
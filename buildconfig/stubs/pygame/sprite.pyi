@@ -78,6 +78,10 @@ class RenderPlain(Group):
 class RenderClear(Group):
     def copy(self) -> RenderClear: ...
 
+class FastGroup(AbstractGroup):
+    def __init__(self, *sprites: Union[Sprite, Sequence[Sprite]]) -> None: ...
+    def copy(self) -> FastGroup: ...
+
 class RenderUpdates(Group):
     def copy(self) -> RenderUpdates: ...
     def draw(self, surface: Surface) -> List[Rect]: ...
@@ -109,6 +113,7 @@ class LayeredUpdates(AbstractGroup):
     def get_top_sprite(self) -> Sprite: ...
     def get_sprites_from_layer(self, layer: int) -> List[Sprite]: ...
     def switch_layer(self, layer1_nr: int, layer2_nr: int) -> None: ...
+    def sort_layers(self, key: Callable[[Sprite], float]) -> None: ...
 
 class LayeredDirty(LayeredUpdates):
     def __init__(self, *sprites: DirtySprite, **kwargs: Any) -> None: ...
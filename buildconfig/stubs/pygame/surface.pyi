@@ -89,6 +89,11 @@ class Surface:
         special_flags: int = 0,
     ) -> Rect: ...
     def scroll(self, dx: int = 0, dy: int = 0) -> None: ...
+    def set_damage_tracking(
+        self, enable: bool = True, max_rects: int = 16
+    ) -> None: ...
+    def get_damage(self) -> List[Rect]: ...
+    def clear_damage(self) -> None: ...
     @overload
     def set_colorkey(self, color: ColorValue, flags: int = 0) -> None: ...
     @overload
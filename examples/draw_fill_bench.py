@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+""" pygame.examples.draw_fill_bench
+
+Times drawing large filled polygons and circles.
+
+Filled shapes are drawn as horizontal spans. This times polygons with a
+growing number of vertices, where the cost of finding each span dominates,
+and circles of growing radius, where the cost of filling the spans does, on
+surfaces of every pixel depth.
+
+Run with an optional surface size, e.g.:
+
+    python -m pygame.examples.draw_fill_bench 1920 1080
+"""
+import math
+import sys
+import time
+
+import pygame as pg
+
+
+def star(center, radius, points):
+    """vertices of a star with the given number of points"""
+    cx, cy = center
+    vertices = []
+    for i in range(points * 2):
+        angle = math.pi * i / points
+        r = radius if i % 2 == 0 else radius // 2
+        vertices.append((cx + r * math.cos(angle), cy + r * math.sin(angle)))
+    return vertices
+
+
+def time_call(func, repeat=5):
+    """best time of a few calls, in milliseconds"""
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        elapsed = (time.perf_counter() - start) * 1000.0
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def main(size=(1920, 1080)):
+    center = (size[0] // 2, size[1] // 2)
+    radius = min(size) // 2
+
+    print("surface size: {}x{}".format(*size))
+    print("{:>6} {:>10} {:>10} {:>12}".format("depth", "shape", "size", "time"))
+
+    for depth in (8, 16, 24, 32):
+        surf = pg.Surface(size, 0, depth)
+
+        for points in (5, 50, 500, 5000):
+            vertices = star(center, radius, points)
+            elapsed = time_call(lambda: pg.draw.polygon(surf, "white", vertices))
+            print(
+                "{:>6} {:>10} {:>10} {:>10.2f}ms".format(
+                    depth, "polygon", points * 2, elapsed
+                )
+            )
+
+        for r in (radius // 8, radius // 2, radius):
+            elapsed = time_call(lambda: pg.draw.circle(surf, "white", center, r))
+            print("{:>6} {:>10} {:>10} {:>10.2f}ms".format(depth, "circle", r, elapsed))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 2:
+        main((int(sys.argv[1]), int(sys.argv[2])))
+    else:
+        main()
@@ -0,0 +1,105 @@
+#!/usr/bin/env python
+""" pygame.examples.gfxdraw_bench
+
+Times pygame.gfxdraw for small and large shapes.
+
+Small shapes show the fixed cost of each call: a few thousand single pixels
+and 4x4 boxes are drawn one call at a time, then all at once with
+gfxdraw.pixels and gfxdraw.boxes. Large shapes show fill throughput, with
+opaque and translucent boxes and filled circles covering most of the
+surface. Both are run on surfaces of every pixel depth.
+
+Run with an optional surface size, e.g.:
+
+    python -m pygame.examples.gfxdraw_bench 1920 1080
+"""
+import random
+import sys
+import time
+
+import pygame as pg
+import pygame.gfxdraw
+
+
+def time_call(func, repeat=5):
+    """best time of a few calls, in milliseconds"""
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        elapsed = (time.perf_counter() - start) * 1000.0
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def report(depth, name, count, elapsed):
+    print("{:>6} {:>24} {:>8} {:>10.2f}ms".format(depth, name, count, elapsed))
+
+
+def main(size=(1920, 1080), count=5000):
+    random.seed(0)
+    points = [
+        (random.randrange(size[0]), random.randrange(size[1])) for _ in range(count)
+    ]
+    rects = [pg.Rect(x, y, 4, 4) for x, y in points]
+    center = (size[0] // 2, size[1] // 2)
+    radius = min(size) // 2
+    big = pg.Rect(0, 0, size[0], size[1]).inflate(-8, -8)
+
+    print("surface size: {}x{}".format(*size))
+    print("{:>6} {:>24} {:>8} {:>12}".format("depth", "shape", "count", "time"))
+
+    for depth in (8, 16, 24, 32):
+        flags = pg.SRCALPHA if depth in (16, 32) else 0
+        surf = pg.Surface(size, flags, depth)
+
+        for name, color in (
+            ("opaque", (255, 200, 0)),
+            ("blend", (255, 200, 0, 128)),
+        ):
+
+            def pixel_loop():
+                for x, y in points:
+                    pygame.gfxdraw.pixel(surf, x, y, color)
+
+            def box_loop():
+                for rect in rects:
+                    pygame.gfxdraw.box(surf, rect, color)
+
+            report(depth, "pixel() " + name, count, time_call(pixel_loop))
+            report(
+                depth,
+                "pixels() " + name,
+                count,
+                time_call(lambda: pygame.gfxdraw.pixels(surf, points, color)),
+            )
+            report(depth, "box() 4x4 " + name, count, time_call(box_loop))
+            report(
+                depth,
+                "boxes() 4x4 " + name,
+                count,
+                time_call(lambda: pygame.gfxdraw.boxes(surf, rects, color)),
+            )
+            report(
+                depth,
+                "box() large " + name,
+                1,
+                time_call(lambda: pygame.gfxdraw.box(surf, big, color)),
+            )
+            report(
+                depth,
+                "filled_circle() " + name,
+                1,
+                time_call(
+                    lambda: pygame.gfxdraw.filled_circle(
+                        surf, center[0], center[1], radius, color
+                    )
+                ),
+            )
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 2:
+        main((int(sys.argv[1]), int(sys.argv[2])))
+    else:
+        main()
@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+""" pygame.examples.mask_convolve_bench
+
+Times Mask.convolve against drawing the mask once per kernel bit.
+
+Mask.convolve draws kernels made of long runs of set bits (solid shapes) a
+run at a time, and falls back to drawing bit by bit for noisy kernels where
+that is cheaper. This prints both timings for growing kernels, showing where
+the run based path starts to pay off.
+
+Run with an optional mask size, e.g.:
+
+    python -m pygame.examples.mask_convolve_bench 1024
+"""
+import random
+import sys
+import time
+
+import pygame as pg
+
+
+def solid_kernel(size):
+    """a filled circle, the typical 'where does this shape fit' kernel"""
+    surf = pg.Surface((size, size), pg.SRCALPHA)
+    pg.draw.circle(surf, (255, 255, 255), (size // 2, size // 2), size // 2)
+    return pg.mask.from_surface(surf)
+
+
+def noisy_kernel(size, density=0.5):
+    """random bits, with short runs"""
+    kernel = pg.mask.Mask((size, size))
+    for x in range(size):
+        for y in range(size):
+            if random.random() < density:
+                kernel.set_at((x, y))
+    return kernel
+
+
+def time_call(func, repeat=3):
+    """best time of a few calls, in milliseconds"""
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        elapsed = (time.perf_counter() - start) * 1000.0
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def bit_by_bit(mask, kernel):
+    """convolution done by drawing the mask once per set kernel bit"""
+    width, height = kernel.get_size()
+    output = pg.mask.Mask(
+        (mask.get_width() + width - 1, mask.get_height() + height - 1)
+    )
+    operations = [
+        (mask, (width - 1 - x, height - 1 - y))
+        for x in range(width)
+        for y in range(height)
+        if kernel.get_at((x, y))
+    ]
+    output.compose(operations)
+    return output
+
+
+def main(mask_size=512):
+    random.seed(1)
+    mask = noisy_kernel(mask_size, 0.3)
+
+    print("mask size: {0}x{0}".format(mask_size))
+    print(
+        "{:>8} {:>8} {:>12} {:>12} {:>8}".format(
+            "kernel", "shape", "convolve", "bit by bit", "speedup"
+        )
+    )
+
+    for size in (4, 8, 16, 32, 64, 128, 256):
+        for name, kernel in (
+            ("solid", solid_kernel(size)),
+            ("noisy", noisy_kernel(size)),
+        ):
+            fast = time_call(lambda: mask.convolve(kernel))
+            slow = time_call(lambda: bit_by_bit(mask, kernel))
+            print(
+                "{:>8} {:>8} {:>10.2f}ms {:>10.2f}ms {:>7.1f}x".format(
+                    size, name, fast, slow, slow / fast if fast else 0.0
+                )
+            )
+
+
+if __name__ == "__main__":
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 512)
@@ -0,0 +1,243 @@
+#!/usr/bin/env python
+""" pygame.examples.sprite_bench
+
+Times the common sprite group operations with many sprites.
+
+Each group type gets the same sprites: small images moving over a large
+surface, the way testsprite.py uses them. For 1k, 10k and 100k sprites
+this times filling the group, update(), clear() and draw(), and removing
+and re-adding a tenth of the sprites, for Group and FastGroup.
+
+Then the sprites are depth sorted in a LayeredUpdates group, by giving
+every sprite the layer of its rect.bottom after it moves, once with a
+change_layer() call per sprite and once with sort_layers().
+
+Last, LayeredDirty.draw() is timed in dirty rect mode and in full screen
+mode on the testsprite.py scene: half the sprites move and the others
+stand still. The panels scene adds two large opaque sprites on top of
+everything, which hide whatever is under them.
+
+Run with optional sprite counts, e.g.:
+
+    python -m pygame.examples.sprite_bench 1000 10000 100000
+"""
+import os
+import random
+import sys
+import time
+
+import pygame
+from pygame import sprite
+
+main_dir = os.path.split(os.path.abspath(__file__))[0]
+data_dir = os.path.join(main_dir, "data")
+
+
+class Thingy(sprite.Sprite):
+    """a sprite moving around inside an area"""
+
+    def __init__(self, image, area):
+        sprite.Sprite.__init__(self)
+        self.image = image
+        self.rect = image.get_rect(
+            topleft=(random.randrange(area.w), random.randrange(area.h))
+        )
+        self.velocity = [random.choice((-2, -1, 1, 2)) for _ in range(2)]
+        self.area = area
+
+    def update(self):
+        self.rect.move_ip(self.velocity)
+        if not self.area.contains(self.rect):
+            self.velocity[0] = -self.velocity[0]
+            self.velocity[1] = -self.velocity[1]
+
+
+class DirtyThingy(sprite.DirtySprite):
+    """a sprite moving around inside an area, as in testsprite.py"""
+
+    def __init__(self, image, area, moving=True):
+        sprite.DirtySprite.__init__(self)
+        self.image = image
+        self.rect = image.get_rect(
+            topleft=(random.randrange(area.w), random.randrange(area.h))
+        )
+        self.velocity = [random.choice((-1, 1)) for _ in range(2)]
+        self.area = area
+        if moving:
+            self.dirty = 2
+        else:
+            self.update = lambda: None
+
+    def update(self):
+        self.rect.move_ip(self.velocity)
+        if not self.area.contains(self.rect):
+            self.velocity[0] = -self.velocity[0]
+            self.velocity[1] = -self.velocity[1]
+
+
+def time_call(func, repeat=5):
+    """best time of a few calls, in milliseconds"""
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        elapsed = (time.perf_counter() - start) * 1000.0
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def churn(group, sprites):
+    """remove a tenth of the sprites and add them back"""
+    group.remove(sprites)
+    group.add(sprites)
+
+
+def depth(spr):
+    """layer of a sprite when sorting by depth"""
+    return spr.rect.bottom
+
+
+def depth_sort(group):
+    """move the sprites and give each the layer of its depth"""
+    group.update()
+    change_layer = group.change_layer
+    for spr in group.sprites():
+        change_layer(spr, spr.rect.bottom)
+
+
+def depth_sort_layers(group):
+    """the same as depth_sort, with a single sort_layers call"""
+    group.update()
+    group.sort_layers(depth)
+
+
+def time_dirty_draw(group, screen, use_update, frames=5):
+    """best time of a few frames of LayeredDirty.draw, in milliseconds"""
+    best = None
+    for _ in range(frames):
+        group.update()
+        group._use_update = use_update
+        start = time.perf_counter()
+        group.draw(screen)
+        elapsed = (time.perf_counter() - start) * 1000.0
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def load_image(name):
+    """load an image into a surface with the same format as the screen
+
+    Without a display, convert() is not available, so blit it instead.
+    """
+    loaded = pygame.image.load(os.path.join(data_dir, name))
+    image = pygame.Surface(loaded.get_size())
+    image.blit(loaded, (0, 0))
+    image.set_colorkey((255, 255, 255))
+    return image
+
+
+def dirty_scene(count, area, panels):
+    """the sprites of testsprite.py, optionally under two opaque panels"""
+    moving = load_image("asprite.bmp")
+    static = load_image("static.png")
+
+    group = sprite.LayeredDirty()
+    for i in range(count):
+        if i % 2:
+            group.add(DirtyThingy(moving, area))
+        else:
+            group.add(DirtyThingy(static, area, moving=False))
+    if panels:
+        image = pygame.Surface((area.w // 2, area.h // 2))
+        image.fill((40, 40, 90))
+        for topleft in (area.topleft, area.center):
+            panel = sprite.DirtySprite()
+            panel.image = image
+            panel.rect = image.get_rect(topleft=topleft)
+            group.add(panel, layer=1)
+    return group
+
+
+def main(counts=(1000, 10000, 100000)):
+    screen = pygame.Surface((1920, 1080))
+    background = pygame.Surface(screen.get_size())
+    image = pygame.Surface((8, 8))
+    image.fill((255, 200, 0))
+    area = screen.get_rect().inflate(-8, -8)
+
+    print(
+        "{:>8} {:>10} {:>9} {:>9} {:>9} {:>9} {:>9}".format(
+            "sprites", "group", "add", "update", "clear", "draw", "churn"
+        )
+    )
+    for count in counts:
+        random.seed(count)
+        sprites = [Thingy(image, area) for _ in range(count)]
+        tenth = sprites[::10]
+        for group_type in (sprite.Group, sprite.FastGroup):
+            group = group_type()
+            add = time_call(lambda: group.add(sprites), repeat=1)
+            group.draw(screen)
+            times = [
+                add,
+                time_call(group.update),
+                time_call(lambda: group.clear(screen, background)),
+                time_call(lambda: group.draw(screen)),
+                time_call(lambda: churn(group, tenth)),
+            ]
+            print(
+                "{:>8} {:>10} {}".format(
+                    count,
+                    group_type.__name__,
+                    " ".join("{:>7.2f}ms".format(elapsed) for elapsed in times),
+                )
+            )
+            group.empty()
+
+    print()
+    print("{:>8} {:>13} {:>13}".format("sprites", "change_layer", "sort_layers"))
+    for count in counts:
+        random.seed(count)
+        group = sprite.LayeredUpdates([Thingy(image, area) for _ in range(count)])
+        group.sort_layers(depth)
+        times = [
+            time_call(lambda: depth_sort(group), repeat=3),
+            time_call(lambda: depth_sort_layers(group), repeat=3),
+        ]
+        print(
+            "{:>8} {}".format(
+                count, " ".join("{:>11.2f}ms".format(elapsed) for elapsed in times)
+            )
+        )
+        group.empty()
+
+    print()
+    print(
+        "{:>8} {:>10} {:>13} {:>13}".format(
+            "sprites", "scene", "dirty rects", "full screen"
+        )
+    )
+    for count in counts:
+        for scene in ("testsprite", "panels"):
+            random.seed(count)
+            group = dirty_scene(count, area, scene == "panels")
+            group.draw(screen, background)
+            times = [
+                time_dirty_draw(group, screen, True),
+                time_dirty_draw(group, screen, False),
+            ]
+            print(
+                "{:>8} {:>10} {}".format(
+                    count,
+                    scene,
+                    " ".join("{:>11.2f}ms".format(elapsed) for elapsed in times),
+                )
+            )
+            group.empty()
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1:
+        main([int(arg) for arg in sys.argv[1:]])
+    else:
+        main()
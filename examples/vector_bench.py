@@ -0,0 +1,111 @@
+#!/usr/bin/env python
+""" pygame.examples.vector_bench
+
+Times arithmetic-heavy loops with Vector2 and Vector3.
+
+Every operator and most methods return a new vector, so loops like the
+particle update below create and free millions of short lived vectors.
+This times such loops, and single operations with vectors, numbers,
+tuples, lists and swizzles, to show what each of them costs including the
+allocation of its result. The same update is then
+timed with Vector2Array, which does each operation on all the particles
+at once.
+
+Run with an optional number of particles, e.g.:
+
+    python -m pygame.examples.vector_bench 100000
+"""
+import sys
+import time
+import timeit
+
+from pygame.math import Matrix3, Vector2, Vector2Array, Vector3
+
+
+def time_call(func, repeat=5):
+    """best time of a few calls, in milliseconds"""
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        elapsed = (time.perf_counter() - start) * 1000.0
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def particles(count):
+    """positions and velocities of particles spread over the screen"""
+    positions = [Vector2(i % 1920, i // 1920) for i in range(count)]
+    velocities = [Vector2(1, 0).rotate(i) * 50 for i in range(count)]
+    return positions, velocities
+
+
+def step(positions, velocities, dt=1 / 60):
+    """one physics step, with gravity and drag"""
+    gravity = Vector2(0, 98)
+    for i, velocity in enumerate(velocities):
+        velocity = (velocity + gravity * dt) * 0.99
+        velocities[i] = velocity
+        positions[i] = positions[i] + velocity * dt
+
+
+def step_array(positions, velocities, dt=1 / 60):
+    """the same step, for Vector2Arrays of all the particles"""
+    velocities += (0, 98 * dt)
+    velocities *= 0.99
+    positions += velocities * dt
+
+
+def main(count=100000):
+    positions, velocities = particles(count)
+    elapsed = time_call(lambda: step(positions, velocities))
+    print("{} particles: {:.2f}ms per step".format(count, elapsed))
+    positions, velocities = (Vector2Array(vectors) for vectors in particles(count))
+    elapsed = time_call(lambda: step_array(positions, velocities))
+    print("{} particles: {:.2f}ms per Vector2Array step".format(count, elapsed))
+    print()
+
+    names = {
+        "a": Vector2(1, 2),
+        "b": Vector2(3.5, -4),
+        "c": Vector3(1, 2, 3),
+        "arr": Vector2Array([(1, 2)] * 1000),
+        "mat": Matrix3.from_rotation(30) @ Matrix3.from_scale(2),
+    }
+    print("{:>28} {:>10}".format("operation", "time"))
+    for stmt in (
+        "a + b",
+        "a * 2.5",
+        "a * 2",
+        "2 * a",
+        "a / 4",
+        "a - (1, 2)",
+        "(1, 2) - a",
+        "a + [1.5, 2]",
+        "c + (1, 2, 3)",
+        "a == (1, 2)",
+        "-a",
+        "a.xy",
+        "a.yx",
+        "c.zyx",
+        "a.xyxy",
+        "a.normalize()",
+        "a.rotate(30)",
+        "a.lerp(b, 0.5)",
+        "c.cross((0, 0, 1))",
+        "a.dot(b)",
+        "Vector2(1, 2)",
+        "arr.rotate(30)",
+        "arr.length()",
+        "mat @ arr",
+    ):
+        number = 200000
+        best = min(timeit.repeat(stmt, globals=dict(globals(), **names), number=number))
+        print("{:>28} {:>8.1f}ns".format(stmt, best / number * 1e9))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1:
+        main(int(sys.argv[1]))
+    else:
+        main()
@@ -19,9 +19,6 @@ LGPL (c) A. Schiffler
 
 /* -===================- */
 
-#define DEFAULT_ALPHA_PIXEL_ROUTINE
-#undef EXPERIMENTAL_ALPHA_PIXEL_ROUTINE
-
 /* ---- Structures */
 
 #if 0  /********** CURRENTLY NOT USED BY pygame.gfxdraw **********/
@@ -55,6 +52,396 @@ typedef struct {
 #define clip_ymin(surface) surface->clip_rect.y
 #define clip_ymax(surface) surface->clip_rect.y+surface->clip_rect.h-1
 
+/* ----- Span drawing core */
+
+/*!
+\brief Internal span drawing state of a primitive.
+
+A primitive sets this up once, so the clipping boundary, its color in the
+destination format and the routine drawing runs of pixels in that format are
+not worked out again for every pixel or line it draws.
+*/
+typedef struct _gfxSpan _gfxSpan;
+
+/*!
+\brief Internal routine drawing n pixels, step bytes apart, from pixel on.
+*/
+typedef void (*_gfxSpanRun)(_gfxSpan *span, Uint8 *pixel, int n, int step);
+
+struct _gfxSpan {
+	SDL_Surface *dst;
+	Sint16 left, right, top, bottom;
+	Uint32 color;		/* in the destination format */
+	Uint32 alpha;
+	_gfxSpanRun run;
+	int locked;
+	Uint32 rb, ag;		/* 8 bit channel pairs of color times alpha */
+	Uint16 blended[256];	/* palette blends, 0xffff until first needed */
+};
+
+/*!
+\brief Internal run - stores the color into 8 bit pixels.
+*/
+static void _gfxRunStore1(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	if (step == 1) {
+		memset(pixel, (Uint8) span->color, n);
+		return;
+	}
+	for (; n > 0; n--, pixel += step) {
+		*pixel = (Uint8) span->color;
+	}
+}
+
+/*!
+\brief Internal run - stores the color into 16 bit pixels.
+*/
+static void _gfxRunStore2(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	Uint16 color = (Uint16) span->color;
+
+	for (; n > 0; n--, pixel += step) {
+		*(Uint16 *) pixel = color;
+	}
+}
+
+/*!
+\brief Internal run - stores the color into 24 bit pixels.
+*/
+static void _gfxRunStore3(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	Uint8 color3[3];
+
+	if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+		color3[0] = (span->color >> 16) & 0xff;
+		color3[1] = (span->color >> 8) & 0xff;
+		color3[2] = span->color & 0xff;
+	} else {
+		color3[0] = span->color & 0xff;
+		color3[1] = (span->color >> 8) & 0xff;
+		color3[2] = (span->color >> 16) & 0xff;
+	}
+	for (; n > 0; n--, pixel += step) {
+		memcpy(pixel, color3, 3);
+	}
+}
+
+/*!
+\brief Internal run - stores the color into 32 bit pixels.
+*/
+static void _gfxRunStore4(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	Uint32 color = span->color;
+
+	for (; n > 0; n--, pixel += step) {
+		*(Uint32 *) pixel = color;
+	}
+}
+
+/*!
+\brief Internal run - blends the color into palette pixels.
+
+Blending with a given palette entry always gives the same entry, so each is
+looked up once for the primitive.
+*/
+static void _gfxRunBlend1(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	SDL_PixelFormat *format = span->dst->format;
+	SDL_Color *colors = format->palette->colors;
+	SDL_Color sColor = colors[(Uint8) span->color];
+	Uint8 dR, dG, dB;
+	int alpha = (int) span->alpha;
+
+	for (; n > 0; n--, pixel += step) {
+		if (span->blended[*pixel] == 0xffff) {
+			dR = colors[*pixel].r;
+			dG = colors[*pixel].g;
+			dB = colors[*pixel].b;
+
+			dR = dR + ((sColor.r - dR) * alpha >> 8);
+			dG = dG + ((sColor.g - dG) * alpha >> 8);
+			dB = dB + ((sColor.b - dB) * alpha >> 8);
+
+			span->blended[*pixel] = SDL_MapRGB(format, dR, dG, dB);
+		}
+		*pixel = (Uint8) span->blended[*pixel];
+	}
+}
+
+/*!
+\brief Internal blend of the color into a pixel value of any other format.
+
+Each channel d becomes d + ((c - d) * alpha >> 8), which is what the 24 bit
+and palette routines have always done.
+*/
+static Uint32 _gfxBlendValue(_gfxSpan *span, Uint32 dc)
+{
+	SDL_PixelFormat *format = span->dst->format;
+	Uint32 masks[4], shifts[4], result = 0;
+	int i, d, c;
+
+	masks[0] = format->Rmask;
+	masks[1] = format->Gmask;
+	masks[2] = format->Bmask;
+	masks[3] = format->Amask;
+	shifts[0] = format->Rshift;
+	shifts[1] = format->Gshift;
+	shifts[2] = format->Bshift;
+	shifts[3] = format->Ashift;
+
+	for (i = 0; i < 4; i++) {
+		if (masks[i] == 0) {
+			continue;
+		}
+		d = (int) ((dc & masks[i]) >> shifts[i]);
+		c = (int) ((span->color & masks[i]) >> shifts[i]);
+		d = d + ((c - d) * (int) span->alpha >> 8);
+		result |= ((Uint32) d << shifts[i]) & masks[i];
+	}
+	return (result);
+}
+
+/*!
+\brief Internal run - blends the color into 16 bit pixels.
+*/
+static void _gfxRunBlend2(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	for (; n > 0; n--, pixel += step) {
+		*(Uint16 *) pixel = (Uint16) _gfxBlendValue(span, *(Uint16 *) pixel);
+	}
+}
+
+/*!
+\brief Internal run - blends the color into 24 bit pixels.
+*/
+static void _gfxRunBlend3(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	Uint32 dc;
+
+	for (; n > 0; n--, pixel += step) {
+		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+			dc = ((Uint32) pixel[0] << 16) | ((Uint32) pixel[1] << 8) | pixel[2];
+			dc = _gfxBlendValue(span, dc);
+			pixel[0] = (dc >> 16) & 0xff;
+			pixel[1] = (dc >> 8) & 0xff;
+			pixel[2] = dc & 0xff;
+		} else {
+			dc = pixel[0] | ((Uint32) pixel[1] << 8) | ((Uint32) pixel[2] << 16);
+			dc = _gfxBlendValue(span, dc);
+			pixel[0] = dc & 0xff;
+			pixel[1] = (dc >> 8) & 0xff;
+			pixel[2] = (dc >> 16) & 0xff;
+		}
+	}
+}
+
+/*!
+\brief Internal run - blends the color into 32 bit pixels.
+*/
+static void _gfxRunBlend4(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	for (; n > 0; n--, pixel += step) {
+		*(Uint32 *) pixel = _gfxBlendValue(span, *(Uint32 *) pixel);
+	}
+}
+
+/*!
+\brief Internal run - blends the color into 32 bit pixels of 8 bit channels.
+
+Two channels are blended at once as (d * (256 - alpha) + c * alpha) >> 8,
+the same as d + ((c - d) * alpha >> 8).
+*/
+static void _gfxRunBlend8888(_gfxSpan *span, Uint8 *pixel, int n, int step)
+{
+	SDL_PixelFormat *format = span->dst->format;
+	Uint32 mask = format->Rmask | format->Gmask | format->Bmask | format->Amask;
+	Uint32 ialpha = 256 - span->alpha;
+	Uint32 dc, rb, ag;
+
+	for (; n > 0; n--, pixel += step) {
+		dc = *(Uint32 *) pixel;
+		rb = (((dc & 0x00ff00ff) * ialpha + span->rb) >> 8) & 0x00ff00ff;
+		ag = (((dc >> 8) & 0x00ff00ff) * ialpha + span->ag) & 0xff00ff00;
+		*(Uint32 *) pixel = (rb | ag) & mask;
+	}
+}
+
+/*!
+\brief Internal setup of the span drawing state of a primitive.
+
+\param span The state to set up.
+\param dst The surface to draw on.
+\param color The color value to draw (0xRRGGBBAA).
+\param lock Set to lock the surface, if it needs locking, until _gfxSpanEnd.
+
+\returns Returns 0 on success, -1 on failure.
+*/
+static int _gfxSpanBegin(_gfxSpan *span, SDL_Surface *dst, Uint32 color, int lock)
+{
+	SDL_PixelFormat *format = dst->format;
+
+	span->dst = dst;
+	span->left = dst->clip_rect.x;
+	span->right = dst->clip_rect.x + dst->clip_rect.w - 1;
+	span->top = dst->clip_rect.y;
+	span->bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
+	span->alpha = color & 0x000000ff;
+	span->color = SDL_MapRGBA(format, (color & 0xff000000) >> 24,
+		(color & 0x00ff0000) >> 16, (color & 0x0000ff00) >> 8, span->alpha);
+
+	if (span->alpha == 255) {
+		switch (format->BytesPerPixel) {
+	case 1:
+		span->run = _gfxRunStore1;
+		break;
+	case 2:
+		span->run = _gfxRunStore2;
+		break;
+	case 3:
+		span->run = _gfxRunStore3;
+		break;
+	default:		/* case 4 */
+		span->run = _gfxRunStore4;
+		break;
+		}
+	} else {
+		switch (format->BytesPerPixel) {
+	case 1:
+		memset(span->blended, 0xff, sizeof(span->blended));
+		span->run = _gfxRunBlend1;
+		break;
+	case 2:
+		span->run = _gfxRunBlend2;
+		break;
+	case 3:
+		span->run = _gfxRunBlend3;
+		break;
+	default:		/* case 4 */
+		if (!format->Rloss && !format->Gloss && !format->Bloss &&
+			(!format->Amask || !format->Aloss) &&
+			!(format->Rshift & 7) && !(format->Gshift & 7) &&
+			!(format->Bshift & 7) && !(format->Ashift & 7)) {
+				span->rb = (span->color & 0x00ff00ff) * span->alpha;
+				span->ag = ((span->color >> 8) & 0x00ff00ff) * span->alpha;
+				span->run = _gfxRunBlend8888;
+		} else {
+			span->run = _gfxRunBlend4;
+		}
+		break;
+		}
+	}
+
+	span->locked = 0;
+	if (lock && SDL_MUSTLOCK(dst)) {
+		if (SDL_LockSurface(dst) < 0) {
+			return (-1);
+		}
+		span->locked = 1;
+	}
+
+	return (0);
+}
+
+/*!
+\brief Internal end of drawing a primitive, unlocking the surface.
+*/
+static void _gfxSpanEnd(_gfxSpan *span)
+{
+	if (span->locked) {
+		SDL_UnlockSurface(span->dst);
+	}
+}
+
+/*!
+\brief Internal clipped horizontal span, x1 and x2 in any order.
+*/
+static void _gfxSpanHLine(_gfxSpan *span, Sint16 x1, Sint16 x2, Sint16 y)
+{
+	SDL_Surface *dst = span->dst;
+	int bpp = dst->format->BytesPerPixel;
+	Sint16 tmp;
+
+	if (x1 > x2) {
+		tmp = x1;
+		x1 = x2;
+		x2 = tmp;
+	}
+	if ((y < span->top) || (y > span->bottom) || (x2 < span->left) || (x1 > span->right)) {
+		return;
+	}
+	if (x1 < span->left) {
+		x1 = span->left;
+	}
+	if (x2 > span->right) {
+		x2 = span->right;
+	}
+
+	span->run(span, (Uint8 *) dst->pixels + (int) y * dst->pitch + (int) x1 * bpp, x2 - x1 + 1, bpp);
+}
+
+/*!
+\brief Internal clipped vertical span, y1 and y2 in any order.
+*/
+static void _gfxSpanVLine(_gfxSpan *span, Sint16 x, Sint16 y1, Sint16 y2)
+{
+	SDL_Surface *dst = span->dst;
+	Sint16 tmp;
+
+	if (y1 > y2) {
+		tmp = y1;
+		y1 = y2;
+		y2 = tmp;
+	}
+	if ((x < span->left) || (x > span->right) || (y2 < span->top) || (y1 > span->bottom)) {
+		return;
+	}
+	if (y1 < span->top) {
+		y1 = span->top;
+	}
+	if (y2 > span->bottom) {
+		y2 = span->bottom;
+	}
+
+	span->run(span, (Uint8 *) dst->pixels + (int) y1 * dst->pitch + (int) x * dst->format->BytesPerPixel, y2 - y1 + 1, dst->pitch);
+}
+
+/*!
+\brief Internal clipped pixel.
+*/
+static void _gfxSpanPixel(_gfxSpan *span, Sint16 x, Sint16 y)
+{
+	SDL_Surface *dst = span->dst;
+	int bpp = dst->format->BytesPerPixel;
+
+	if ((x >= span->left) && (x <= span->right) && (y >= span->top) && (y <= span->bottom)) {
+		span->run(span, (Uint8 *) dst->pixels + (int) y * dst->pitch + (int) x * bpp, 1, bpp);
+	}
+}
+
+/*!
+\brief Internal clipped box, corners in any order.
+*/
+static void _gfxSpanBox(_gfxSpan *span, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2)
+{
+	Sint16 tmp;
+	int y;
+
+	if (y1 > y2) {
+		tmp = y1;
+		y1 = y2;
+		y2 = tmp;
+	}
+	if (y1 < span->top) {
+		y1 = span->top;
+	}
+	if (y2 > span->bottom) {
+		y2 = span->bottom;
+	}
+	for (y = y1; y <= y2; y++) {
+		_gfxSpanHLine(span, x1, x2, (Sint16) y);
+	}
+}
+
 /*!
 \brief Internal pixel drawing - fast, no blending, no locking, clipping.
 
@@ -253,222 +640,6 @@ int fastPixelRGBANolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint8 r, Uint8 g,
 }
 #endif /********** CURRENTLY NOT USED BY pygame.gfxdraw **********/
 
-/*!
-\brief Internal pixel drawing function with alpha blending where input color in in destination format.
-
-Contains two alternative 32 bit alpha blending routines which can be enabled at the source
-level with the defines DEFAULT_ALPHA_PIXEL_ROUTINE or EXPERIMENTAL_ALPHA_PIXEL_ROUTINE.
-Only the bits up to the surface depth are significant in the color value.
-
-\param dst The surface to draw on.
-\param x The horizontal coordinate of the pixel.
-\param y The vertical position of the pixel.
-\param color The color value of the pixel to draw. 
-\param alpha The blend factor to apply while drawing.
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int _putPixelAlpha(SDL_Surface *dst, Sint16 x, Sint16 y, Uint32 color, Uint8 alpha)
-{
-	SDL_PixelFormat *format;
-	Uint32 Rmask, Gmask, Bmask, Amask;
-	Uint32 Rshift, Gshift, Bshift, Ashift;
-	Uint32 R, G, B, A;
-
-	if (dst == NULL)
-	{
-		return (-1);
-	}
-
-	if (x >= clip_xmin(dst) && x <= clip_xmax(dst) && 
-		y >= clip_ymin(dst) && y <= clip_ymax(dst)) 
-	{
-
-		format = dst->format;
-
-		switch (format->BytesPerPixel) {
-	case 1:
-		{		/* Assuming 8-bpp */
-			if (alpha == 255) {
-				*((Uint8 *) dst->pixels + y * dst->pitch + x) = color;
-			} else {
-				Uint8 *pixel = (Uint8 *) dst->pixels + y * dst->pitch + x;
-				SDL_Palette *palette = format->palette;
-				SDL_Color *colors = palette->colors;
-				SDL_Color dColor = colors[*pixel];
-				SDL_Color sColor = colors[color];
-				Uint8 dR = dColor.r;
-				Uint8 dG = dColor.g;
-				Uint8 dB = dColor.b;
-				Uint8 sR = sColor.r;
-				Uint8 sG = sColor.g;
-				Uint8 sB = sColor.b;
-
-				dR = dR + ((sR - dR) * alpha >> 8);
-				dG = dG + ((sG - dG) * alpha >> 8);
-				dB = dB + ((sB - dB) * alpha >> 8);
-
-				*pixel = SDL_MapRGB(format, dR, dG, dB);
-			}
-		}
-		break;
-
-	case 2:
-		{		/* Probably 15-bpp or 16-bpp */
-			if (alpha == 255) {
-				*((Uint16 *) dst->pixels + y * dst->pitch / 2 + x) = color;
-			} else {
-				Uint16 *pixel = (Uint16 *) dst->pixels + y * dst->pitch / 2 + x;
-				Uint32 dc = *pixel;
-
-				Rmask = format->Rmask;
-				Gmask = format->Gmask;
-				Bmask = format->Bmask;
-				Amask = format->Amask;
-				R = ((dc & Rmask) + (((color & Rmask) - (dc & Rmask)) * alpha >> 8)) & Rmask;
-				G = ((dc & Gmask) + (((color & Gmask) - (dc & Gmask)) * alpha >> 8)) & Gmask;
-				B = ((dc & Bmask) + (((color & Bmask) - (dc & Bmask)) * alpha >> 8)) & Bmask;
-				*pixel = R | G | B;
-				if (Amask!=0) {
-					A = ((dc & Amask) + (((color & Amask) - (dc & Amask)) * alpha >> 8)) & Amask;
-					*pixel |= A;
-				}
-			}
-		}
-		break;
-
-	case 3: 
-		{		/* Slow 24-bpp mode, usually not used */
-			Uint8 Rshift8, Gshift8, Bshift8, Ashift8;
-			Uint8 *pixel = (Uint8 *) dst->pixels + y * dst->pitch + x * 3;
-
-			Rshift = format->Rshift;
-			Gshift = format->Gshift;
-			Bshift = format->Bshift;
-			Ashift = format->Ashift;
-
-			Rshift8 = Rshift / 8;
-			Gshift8 = Gshift / 8;
-			Bshift8 = Bshift / 8;
-			Ashift8 = Ashift / 8;
-
-			if (alpha == 255) {
-				*(pixel + Rshift8) = color >> Rshift;
-				*(pixel + Gshift8) = color >> Gshift;
-				*(pixel + Bshift8) = color >> Bshift;
-				*(pixel + Ashift8) = color >> Ashift;
-			} else {
-				Uint8 dR, dG, dB, dA = 0;
-				Uint8 sR, sG, sB, sA = 0;
-
-				dR = *((pixel) + Rshift8);
-				dG = *((pixel) + Gshift8);
-				dB = *((pixel) + Bshift8);
-				dA = *((pixel) + Ashift8);
-
-				sR = (color >> Rshift) & 0xff;
-				sG = (color >> Gshift) & 0xff;
-				sB = (color >> Bshift) & 0xff;
-				sA = (color >> Ashift) & 0xff;
-
-				dR = dR + ((sR - dR) * alpha >> 8);
-				dG = dG + ((sG - dG) * alpha >> 8);
-				dB = dB + ((sB - dB) * alpha >> 8);
-				dA = dA + ((sA - dA) * alpha >> 8);
-
-				*((pixel) + Rshift8) = dR;
-				*((pixel) + Gshift8) = dG;
-				*((pixel) + Bshift8) = dB;
-				*((pixel) + Ashift8) = dA;
-			}
-		}
-		break;
-
-#ifdef DEFAULT_ALPHA_PIXEL_ROUTINE
-
-	case 4:
-		{		/* Probably :-) 32-bpp */
-			if (alpha == 255) {
-				*((Uint32 *) dst->pixels + y * dst->pitch / 4 + x) = color;
-			} else {
-				Uint32 *pixel = (Uint32 *) dst->pixels + y * dst->pitch / 4 + x;
-				Uint32 dc = *pixel;
-
-				Rmask = format->Rmask;
-				Gmask = format->Gmask;
-				Bmask = format->Bmask;
-				Amask = format->Amask;
-
-				Rshift = format->Rshift;
-				Gshift = format->Gshift;
-				Bshift = format->Bshift;
-				Ashift = format->Ashift;
-
-				R = ((dc & Rmask) + (((((color & Rmask) - (dc & Rmask)) >> Rshift) * alpha >> 8) << Rshift)) & Rmask;
-				G = ((dc & Gmask) + (((((color & Gmask) - (dc & Gmask)) >> Gshift) * alpha >> 8) << Gshift)) & Gmask;
-				B = ((dc & Bmask) + (((((color & Bmask) - (dc & Bmask)) >> Bshift) * alpha >> 8) << Bshift)) & Bmask;
-				*pixel = R | G | B;
-				if (Amask!=0) {
-					A = ((dc & Amask) + (((((color & Amask) - (dc & Amask)) >> Ashift) * alpha >> 8) << Ashift)) & Amask;
-					*pixel |= A;
-				}
-			}
-		}
-		break;
-#endif
-
-#ifdef EXPERIMENTAL_ALPHA_PIXEL_ROUTINE
-
-	case 4:{		/* Probably :-) 32-bpp */
-		if (alpha == 255) {
-			*((Uint32 *) dst->pixels + y * dst->pitch / 4 + x) = color;
-		} else {
-			Uint32 *pixel = (Uint32 *) dst->pixels + y * dst->pitch / 4 + x;
-			Uint32 dR, dG, dB, dA;
-			Uint32 dc = *pixel;
-
-			Uint32 surfaceAlpha, preMultR, preMultG, preMultB;
-			Uint32 aTmp;
-
-			Rmask = format->Rmask;
-			Gmask = format->Gmask;
-			Bmask = format->Bmask;
-			Amask = format->Amask;
-
-			dR = (color & Rmask);
-			dG = (color & Gmask);
-			dB = (color & Bmask);
-			dA = (color & Amask);
-
-			Rshift = format->Rshift;
-			Gshift = format->Gshift;
-			Bshift = format->Bshift;
-			Ashift = format->Ashift;
-
-			preMultR = (alpha * (dR >> Rshift));
-			preMultG = (alpha * (dG >> Gshift));
-			preMultB = (alpha * (dB >> Bshift));
-
-			surfaceAlpha = ((dc & Amask) >> Ashift);
-			aTmp = (255 - alpha);
-			if (A = 255 - ((aTmp * (255 - surfaceAlpha)) >> 8 )) {
-				aTmp *= surfaceAlpha;
-				R = (preMultR + ((aTmp * ((dc & Rmask) >> Rshift)) >> 8)) / A << Rshift & Rmask;
-				G = (preMultG + ((aTmp * ((dc & Gmask) >> Gshift)) >> 8)) / A << Gshift & Gmask;
-				B = (preMultB + ((aTmp * ((dc & Bmask) >> Bshift)) >> 8)) / A << Bshift & Bmask;
-			}
-			*pixel = R | G | B | (A << Ashift & Amask);
-
-		}
-		   }
-		   break;
-#endif
-		}
-	}
-
-	return (0);
-}
-
 /*!
 \brief Pixel draw with blending enabled if a<255.
 
@@ -481,383 +652,35 @@ int _putPixelAlpha(SDL_Surface *dst, Sint16 x, Sint16 y, Uint32 color, Uint8 alp
 */
 int pixelColor(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
 {
-	Uint8 alpha;
-	Uint32 mcolor;
-	int result = 0;
-
-	/*
-	* Lock the surface 
-	*/
-	if (SDL_MUSTLOCK(dst)) {
-		if (SDL_LockSurface(dst) < 0) {
-			return (-1);
-		}
-	}
-
-	/*
-	* Setup color 
-	*/
-	alpha = color & 0x000000ff;
-	mcolor =
-		SDL_MapRGBA(dst->format, (color & 0xff000000) >> 24,
-		(color & 0x00ff0000) >> 16, (color & 0x0000ff00) >> 8, alpha);
-
-	/*
-	* Draw 
-	*/
-	result = _putPixelAlpha(dst, x, y, mcolor, alpha);
-
-	/*
-	* Unlock the surface 
-	*/
-	if (SDL_MUSTLOCK(dst)) {
-		SDL_UnlockSurface(dst);
-	}
-
-	return (result);
-}
-
-/*!
-\brief Pixel draw with blending enabled if a<255 - no surface locking.
-
-\param dst The surface to draw on.
-\param x X (horizontal) coordinate of the pixel.
-\param y Y (vertical) coordinate of the pixel.
-\param color The color value of the pixel to draw (0xRRGGBBAA). 
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int pixelColorNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
-{
-	Uint8 alpha;
-	Uint32 mcolor;
-	int result = 0;
-
-	/*
-	* Setup color 
-	*/
-	alpha = color & 0x000000ff;
-	mcolor =
-		SDL_MapRGBA(dst->format, (color & 0xff000000) >> 24,
-		(color & 0x00ff0000) >> 16, (color & 0x0000ff00) >> 8, alpha);
-
-	/*
-	* Draw 
-	*/
-	result = _putPixelAlpha(dst, x, y, mcolor, alpha);
-
-	return (result);
-}
-
-
-/*!
-\brief Internal function to draw filled rectangle with alpha blending.
-
-Assumes color is in destination format.
-
-\param dst The surface to draw on.
-\param x1 X coordinate of the first corner (upper left) of the rectangle.
-\param y1 Y coordinate of the first corner (upper left) of the rectangle.
-\param x2 X coordinate of the second corner (lower right) of the rectangle.
-\param y2 Y coordinate of the second corner (lower right) of the rectangle.
-\param color The color value of the rectangle to draw (0xRRGGBBAA). 
-\param alpha Alpha blending amount for pixels.
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int _filledRectAlpha(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint32 color, Uint8 alpha)
-{
-	SDL_PixelFormat *format;
-	Uint32 Rmask, Bmask, Gmask, Amask;
-	Uint32 Rshift, Bshift, Gshift, Ashift;
-	Uint8 sR, sG, sB, sA;
-	Uint32 R, G, B, A;
-	Sint16 x, y;
-
-	format = dst->format;
-	switch (format->BytesPerPixel) {
-	case 1:
-		{			/* Assuming 8-bpp */
-			Uint8 *row, *pixel;
-			Uint8 dR, dG, dB;
-			SDL_Palette *palette = format->palette;
-			SDL_Color *colors = palette->colors;
-			sR = colors[color].r;
-			sG = colors[color].g;
-			sB = colors[color].b;
-
-			for (y = y1; y <= y2; y++) {
-				row = (Uint8 *) dst->pixels + y * dst->pitch;
-				for (x = x1; x <= x2; x++) {
-					pixel = row + x;
-
-					dR = colors[*pixel].r;
-					dG = colors[*pixel].g;
-					dB = colors[*pixel].b;
-
-					dR = dR + ((sR - dR) * alpha >> 8);
-					dG = dG + ((sG - dG) * alpha >> 8);
-					dB = dB + ((sB - dB) * alpha >> 8);
-
-					*pixel = SDL_MapRGB(format, dR, dG, dB);
-				}
-			}
-		}
-		break;
-
-	case 2:
-		{			/* Probably 15-bpp or 16-bpp */
-			Uint16 *row, *pixel;
-			Uint32 dR, dG, dB, dA;
-			Rmask = format->Rmask;
-			Gmask = format->Gmask;
-			Bmask = format->Bmask;
-			Amask = format->Amask;
-
-			dR = (color & Rmask); 
-			dG = (color & Gmask);
-			dB = (color & Bmask);
-			dA = (color & Amask);
-
-			for (y = y1; y <= y2; y++) {
-				row = (Uint16 *) dst->pixels + y * dst->pitch / 2;
-				for (x = x1; x <= x2; x++) {
-					pixel = row + x;
-
-					R = ((*pixel & Rmask) + ((dR - (*pixel & Rmask)) * alpha >> 8)) & Rmask;
-					G = ((*pixel & Gmask) + ((dG - (*pixel & Gmask)) * alpha >> 8)) & Gmask;
-					B = ((*pixel & Bmask) + ((dB - (*pixel & Bmask)) * alpha >> 8)) & Bmask;
-					*pixel = R | G | B;
-					if (Amask!=0)
-					{
-						A = ((*pixel & Amask) + ((dA - (*pixel & Amask)) * alpha >> 8)) & Amask;
-						*pixel |= A;
-					} 
-				}
-			}
-		}
-		break;
-
-	case 3:
-		{			/* Slow 24-bpp mode, usually not used */
-			Uint8 *row, *pix;
-			Uint8 dR, dG, dB, dA;
-			Uint8 Rshift8, Gshift8, Bshift8, Ashift8;
-
-			Rshift = format->Rshift;
-			Gshift = format->Gshift;
-			Bshift = format->Bshift;
-			Ashift = format->Ashift;
-
-			Rshift8 = Rshift / 8;
-			Gshift8 = Gshift / 8;
-			Bshift8 = Bshift / 8;
-			Ashift8 = Ashift / 8;
-
-			sR = (color >> Rshift) & 0xff;
-			sG = (color >> Gshift) & 0xff;
-			sB = (color >> Bshift) & 0xff;
-			sA = (color >> Ashift) & 0xff;
-
-			for (y = y1; y <= y2; y++) {
-				row = (Uint8 *) dst->pixels + y * dst->pitch;
-				for (x = x1; x <= x2; x++) {
-					pix = row + x * 3;
-
-					dR = *((pix) + Rshift8);
-					dG = *((pix) + Gshift8);
-					dB = *((pix) + Bshift8);
-					dA = *((pix) + Ashift8);
-
-					dR = dR + ((sR - dR) * alpha >> 8);
-					dG = dG + ((sG - dG) * alpha >> 8);
-					dB = dB + ((sB - dB) * alpha >> 8);
-					dA = dA + ((sA - dA) * alpha >> 8);
-
-					*((pix) + Rshift8) = dR;
-					*((pix) + Gshift8) = dG;
-					*((pix) + Bshift8) = dB;
-					*((pix) + Ashift8) = dA;
-				}
-			}
-		}
-		break;
-
-#ifdef DEFAULT_ALPHA_PIXEL_ROUTINE
-	case 4:
-		{			/* Probably :-) 32-bpp */
-			Uint32 *row, *pixel;
-			Uint32 dR, dG, dB, dA;
-
-			Rmask = format->Rmask;
-			Gmask = format->Gmask;
-			Bmask = format->Bmask;
-			Amask = format->Amask;
-
-			Rshift = format->Rshift;
-			Gshift = format->Gshift;
-			Bshift = format->Bshift;
-			Ashift = format->Ashift;
-
-			dR = (color & Rmask);
-			dG = (color & Gmask);
-			dB = (color & Bmask);
-			dA = (color & Amask);
-
-			for (y = y1; y <= y2; y++) {
-				row = (Uint32 *) dst->pixels + y * dst->pitch / 4;
-				for (x = x1; x <= x2; x++) {
-					pixel = row + x;
-
-					R = ((*pixel & Rmask) + ((((dR - (*pixel & Rmask)) >> Rshift) * alpha >> 8) << Rshift)) & Rmask;
-					G = ((*pixel & Gmask) + ((((dG - (*pixel & Gmask)) >> Gshift) * alpha >> 8) << Gshift)) & Gmask;
-					B = ((*pixel & Bmask) + ((((dB - (*pixel & Bmask)) >> Bshift) * alpha >> 8) << Bshift)) & Bmask;
-					*pixel = R | G | B;
-					if (Amask!=0)
-					{
-						A = ((*pixel & Amask) + ((((dA - (*pixel & Amask)) >> Ashift) * alpha >> 8) << Ashift)) & Amask;
-						*pixel |= A;
-					}					
-				}
-			}
-		}
-		break;
-#endif
-
-#ifdef EXPERIMENTAL_ALPHA_PIXEL_ROUTINE
-	case 4:{			/* Probably :-) 32-bpp */
-		Uint32 *row, *pixel;
-		Uint32 dR, dG, dB, dA;
-		Uint32 dc;
-		Uint32 surfaceAlpha, preMultR, preMultG, preMultB;
-		Uint32 aTmp;
-
-		Rmask = format->Rmask;
-		Gmask = format->Gmask;
-		Bmask = format->Bmask;
-		Amask = format->Amask;
-
-		dR = (color & Rmask);
-		dG = (color & Gmask);
-		dB = (color & Bmask);
-		dA = (color & Amask);
-
-		Rshift = format->Rshift;
-		Gshift = format->Gshift;
-		Bshift = format->Bshift;
-		Ashift = format->Ashift;
-
-		preMultR = (alpha * (dR >> Rshift));
-		preMultG = (alpha * (dG >> Gshift));
-		preMultB = (alpha * (dB >> Bshift));
-
-		for (y = y1; y <= y2; y++) {
-			row = (Uint32 *) dst->pixels + y * dst->pitch / 4;
-			for (x = x1; x <= x2; x++) {
-				pixel = row + x;
-				dc = *pixel;
-
-				surfaceAlpha = ((dc & Amask) >> Ashift);
-				aTmp = (255 - alpha);
-				if (A = 255 - ((aTmp * (255 - surfaceAlpha)) >> 8 )) {
-					aTmp *= surfaceAlpha;
-					R = (preMultR + ((aTmp * ((dc & Rmask) >> Rshift)) >> 8)) / A << Rshift & Rmask;
-					G = (preMultG + ((aTmp * ((dc & Gmask) >> Gshift)) >> 8)) / A << Gshift & Gmask;
-					B = (preMultB + ((aTmp * ((dc & Bmask) >> Bshift)) >> 8)) / A << Bshift & Bmask;
-				}
-				*pixel = R | G | B | (A << Ashift & Amask);
-
-			}
-		}
-		   }
-		   break;
-#endif
+	_gfxSpan span;
 
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
 	}
+	_gfxSpanPixel(&span, x, y);
+	_gfxSpanEnd(&span);
 
 	return (0);
 }
 
 /*!
-\brief Draw filled rectangle of RGBA color with alpha blending.
-
-\param dst The surface to draw on.
-\param x1 X coordinate of the first corner (upper left) of the rectangle.
-\param y1 Y coordinate of the first corner (upper left) of the rectangle.
-\param x2 X coordinate of the second corner (lower right) of the rectangle.
-\param y2 Y coordinate of the second corner (lower right) of the rectangle.
-\param color The color value of the rectangle to draw (0xRRGGBBAA). 
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int filledRectAlpha(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint32 color)
-{
-	Uint8 alpha;
-	Uint32 mcolor;
-	int result = 0;
-
-	/*
-	* Lock the surface 
-	*/
-	if (SDL_MUSTLOCK(dst)) {
-		if (SDL_LockSurface(dst) < 0) {
-			return (-1);
-		}
-	}
-
-	/*
-	* Setup color 
-	*/
-	alpha = color & 0x000000ff;
-	mcolor =
-		SDL_MapRGBA(dst->format, (color & 0xff000000) >> 24,
-		(color & 0x00ff0000) >> 16, (color & 0x0000ff00) >> 8, alpha);
-
-	/*
-	* Draw 
-	*/
-	result = _filledRectAlpha(dst, x1, y1, x2, y2, mcolor, alpha);
-
-	/*
-	* Unlock the surface 
-	*/
-	if (SDL_MUSTLOCK(dst)) {
-		SDL_UnlockSurface(dst);
-	}
-
-	return (result);
-}
-
-/*!
-\brief Internal function to draw horizontal line of RGBA color with alpha blending.
-
-\param dst The surface to draw on.
-\param x1 X coordinate of the first point (i.e. left) of the line.
-\param x2 X coordinate of the second point (i.e. right) of the line.
-\param y Y coordinate of the points of the line.
-\param color The color value of the line to draw (0xRRGGBBAA). 
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int _HLineAlpha(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
-{
-	return (filledRectAlpha(dst, x1, y, x2, y, color));
-}
-
-/*!
-\brief Internal function to draw vertical line of RGBA color with alpha blending.
+\brief Pixel draw with blending enabled if a<255 - no surface locking.
 
 \param dst The surface to draw on.
-\param x X coordinate of the points of the line.
-\param y1 Y coordinate of the first point (top) of the line.
-\param y2 Y coordinate of the second point (bottom) of the line.
-\param color The color value of the line to draw (0xRRGGBBAA). 
+\param x X (horizontal) coordinate of the pixel.
+\param y Y (vertical) coordinate of the pixel.
+\param color The color value of the pixel to draw (0xRRGGBBAA). 
 
 \returns Returns 0 on success, -1 on failure.
 */
-int _VLineAlpha(SDL_Surface * dst, Sint16 x, Sint16 y1, Sint16 y2, Uint32 color)
+int pixelColorNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
 {
-	return (filledRectAlpha(dst, x, y1, x, y2, color));
+	_gfxSpan span;
+
+	_gfxSpanBegin(&span, dst, color, 0);
+	_gfxSpanPixel(&span, x, y);
+
+	return (0);
 }
 
 /*!
@@ -960,6 +783,39 @@ int pixelRGBA(SDL_Surface * dst, Sint16 x, Sint16 y, Uint8 r, Uint8 g, Uint8 b,
 }
 
 
+/*!
+\brief Draw many pixels of one color with blending enabled if a<255.
+
+The color is set up and the surface locked once for all of the pixels.
+
+\param dst The surface to draw on.
+\param vx Array of the X (horizontal) coordinates of the pixels.
+\param vy Array of the Y (vertical) coordinates of the pixels.
+\param n Number of pixels in the arrays.
+\param color The color value of the pixels to draw (0xRRGGBBAA). 
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int pixelsColor(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, Uint32 color)
+{
+	_gfxSpan span;
+	int i;
+
+	if ((vx == NULL) || (vy == NULL)) {
+		return (-1);
+	}
+
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
+	}
+	for (i = 0; i < n; i++) {
+		_gfxSpanPixel(&span, vx[i], vy[i]);
+	}
+	_gfxSpanEnd(&span);
+
+	return (0);
+}
+
 /*!
 \brief Draw horizontal line without blending;
 
@@ -1127,357 +983,74 @@ int hlineRGBAStore(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint8 r, U
 	return (hlineColorStore(dst, x1, x2, y, ((Uint32) r << 24) | ((Uint32) g << 16) | ((Uint32) b << 8) | (Uint32) a));
 }
 
-/*!
-\brief Draw horizontal line with blending.
-
-\param dst The surface to draw on.
-\param x1 X coordinate of the first point (i.e. left) of the line.
-\param x2 X coordinate of the second point (i.e. right) of the line.
-\param y Y coordinate of the points of the line.
-\param color The color value of the line to draw (0xRRGGBBAA). 
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int hlineColor(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
-{
-	Sint16 left, right, top, bottom;
-	Uint8 *pixel, *pixellast;
-	int dx;
-	int pixx, pixy;
-	Sint16 xtmp;
-	int result = -1;
-	Uint8 *colorptr;
-	Uint8 color3[3];
-
-	/*
-	* Check visibility of clipping rectangle
-	*/
-	if ((dst->clip_rect.w==0) || (dst->clip_rect.h==0)) {
-		return(0);
-	}
-
-	/*
-	* Swap x1, x2 if required to ensure x1<=x2
-	*/
-	if (x1 > x2) {
-		xtmp = x1;
-		x1 = x2;
-		x2 = xtmp;
-	}
-
-	/*
-	* Get clipping boundary and
-	* check visibility of hline 
-	*/
-	left = dst->clip_rect.x;
-	if (x2<left) {
-		return(0);
-	}
-	right = dst->clip_rect.x + dst->clip_rect.w - 1;
-	if (x1>right) {
-		return(0);
-	}
-	top = dst->clip_rect.y;
-	bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
-	if ((y<top) || (y>bottom)) {
-		return (0);
-	}
-
-	/*
-	* Clip x 
-	*/
-	if (x1 < left) {
-		x1 = left;
-	}
-	if (x2 > right) {
-		x2 = right;
-	}
-
-	/*
-	* Calculate width difference
-	*/
-	dx = x2 - x1;
-
-	/*
-	* Alpha check 
-	*/
-	if ((color & 255) == 255) {
-
-		/*
-		* No alpha-blending required 
-		*/
-
-		/*
-		* Setup color 
-		*/
-		colorptr = (Uint8 *) & color;
-		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-			color = SDL_MapRGBA(dst->format, colorptr[0], colorptr[1], colorptr[2], colorptr[3]);
-		} else {
-			color = SDL_MapRGBA(dst->format, colorptr[3], colorptr[2], colorptr[1], colorptr[0]);
-		}
-
-		/*
-		* Lock the surface 
-		*/
-		if (SDL_MUSTLOCK(dst)) {
-			if (SDL_LockSurface(dst) < 0) {
-				return (-1);
-			}
-		}
-
-		/*
-		* More variable setup 
-		*/
-		pixx = dst->format->BytesPerPixel;
-		pixy = dst->pitch;
-		pixel = ((Uint8 *) dst->pixels) + pixx * (int) x1 + pixy * (int) y;
-
-		/*
-		* Draw 
-		*/
-		switch (dst->format->BytesPerPixel) {
-	case 1:
-		memset(pixel, color, dx + 1);
-		break;
-	case 2:
-		pixellast = pixel + dx + dx;
-		for (; pixel <= pixellast; pixel += pixx) {
-			*(Uint16 *) pixel = color;
-		}
-		break;
-	case 3:
-		pixellast = pixel + dx + dx + dx;
-		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-			color3[0] = (color >> 16) & 0xff;
-			color3[1] = (color >> 8) & 0xff;
-			color3[2] = color & 0xff;
-		} else {
-			color3[0] = color & 0xff;
-			color3[1] = (color >> 8) & 0xff;
-			color3[2] = (color >> 16) & 0xff;
-		}
-		for (; pixel <= pixellast; pixel += pixx) {
-			memcpy(pixel, color3, 3);
-		}
-		break;
-	default:		/* case 4 */
-		dx = dx + dx;
-		pixellast = pixel + dx + dx;
-		for (; pixel <= pixellast; pixel += pixx) {
-			*(Uint32 *) pixel = color;
-		}
-		break;
-		}
-
-		/* 
-		* Unlock surface 
-		*/
-		if (SDL_MUSTLOCK(dst)) {
-			SDL_UnlockSurface(dst);
-		}
-
-		/*
-		* Set result code 
-		*/
-		result = 0;
-
-	} else {
-
-		/*
-		* Alpha blending blit 
-		*/
-		result = _HLineAlpha(dst, x1, x1 + dx, y, color);
-	}
-
-	return (result);
-}
-
-/*!
-\brief Draw horizontal line with blending.
-
-\param dst The surface to draw on.
-\param x1 X coordinate of the first point (i.e. left) of the line.
-\param x2 X coordinate of the second point (i.e. right) of the line.
-\param y Y coordinate of the points of the line.
-\param r The red value of the line to draw. 
-\param g The green value of the line to draw. 
-\param b The blue value of the line to draw. 
-\param a The alpha value of the line to draw. 
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int hlineRGBA(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
-{
-	/*
-	* Draw 
-	*/
-	return (hlineColor(dst, x1, x2, y, ((Uint32) r << 24) | ((Uint32) g << 16) | ((Uint32) b << 8) | (Uint32) a));
-}
-
-/*!
-\brief Draw vertical line with blending.
-
-\param dst The surface to draw on.
-\param x X coordinate of the points of the line.
-\param y1 Y coordinate of the first point (i.e. top) of the line.
-\param y2 Y coordinate of the second point (i.e. bottom) of the line.
-\param color The color value of the line to draw (0xRRGGBBAA). 
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int vlineColor(SDL_Surface * dst, Sint16 x, Sint16 y1, Sint16 y2, Uint32 color)
-{
-	Sint16 left, right, top, bottom;
-	Uint8 *pixel, *pixellast;
-	int dy;
-	int pixx, pixy;
-	Sint16 h;
-	Sint16 ytmp;
-	int result = -1;
-	Uint8 *colorptr;
-
-	/*
-	* Check visibility of clipping rectangle
-	*/
-	if ((dst->clip_rect.w==0) || (dst->clip_rect.h==0)) {
-		return(0);
-	}
-
-	/*
-	* Swap y1, y2 if required to ensure y1<=y2
-	*/
-	if (y1 > y2) {
-		ytmp = y1;
-		y1 = y2;
-		y2 = ytmp;
-	}
-
-	/*
-	* Get clipping boundary and
-	* check visibility of vline 
-	*/
-	left = dst->clip_rect.x;
-	right = dst->clip_rect.x + dst->clip_rect.w - 1;
-	if ((x<left) || (x>right)) {
-		return (0);
-	}    
-	top = dst->clip_rect.y;
-	if (y2<top) {
-		return(0);
-	}
-	bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
-	if (y1>bottom) {
-		return(0);
-	}
-
-	/*
-	* Clip x 
-	*/
-	if (y1 < top) {
-		y1 = top;
-	}
-	if (y2 > bottom) {
-		y2 = bottom;
-	}
-
-	/*
-	* Calculate height
-	*/
-	h = y2 - y1;
-
-	/*
-	* Alpha check 
-	*/
-	if ((color & 255) == 255) {
-
-		/*
-		* No alpha-blending required 
-		*/
+/*!
+\brief Draw horizontal line with blending.
 
-		/*
-		* Setup color 
-		*/
-		colorptr = (Uint8 *) & color;
-		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-			color = SDL_MapRGBA(dst->format, colorptr[0], colorptr[1], colorptr[2], colorptr[3]);
-		} else {
-			color = SDL_MapRGBA(dst->format, colorptr[3], colorptr[2], colorptr[1], colorptr[0]);
-		}
+\param dst The surface to draw on.
+\param x1 X coordinate of the first point (i.e. left) of the line.
+\param x2 X coordinate of the second point (i.e. right) of the line.
+\param y Y coordinate of the points of the line.
+\param color The color value of the line to draw (0xRRGGBBAA). 
 
-		/*
-		* Lock the surface 
-		*/
-		if (SDL_MUSTLOCK(dst)) {
-			if (SDL_LockSurface(dst) < 0) {
-				return (-1);
-			}
-		}
+\returns Returns 0 on success, -1 on failure.
+*/
+int hlineColor(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
+{
+	_gfxSpan span;
 
-		/*
-		* More variable setup 
-		*/
-		dy = h;
-		pixx = dst->format->BytesPerPixel;
-		pixy = dst->pitch;
-		pixel = ((Uint8 *) dst->pixels) + pixx * (int) x + pixy * (int) y1;
-		pixellast = pixel + pixy * dy;
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
+	}
+	_gfxSpanHLine(&span, x1, x2, y);
+	_gfxSpanEnd(&span);
 
-		/*
-		* Draw 
-		*/
-		switch (dst->format->BytesPerPixel) {
-	case 1:
-		for (; pixel <= pixellast; pixel += pixy) {
-			*(Uint8 *) pixel = color;
-		}
-		break;
-	case 2:
-		for (; pixel <= pixellast; pixel += pixy) {
-			*(Uint16 *) pixel = color;
-		}
-		break;
-	case 3:
-		for (; pixel <= pixellast; pixel += pixy) {
-			if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-				pixel[0] = (color >> 16) & 0xff;
-				pixel[1] = (color >> 8) & 0xff;
-				pixel[2] = color & 0xff;
-			} else {
-				pixel[0] = color & 0xff;
-				pixel[1] = (color >> 8) & 0xff;
-				pixel[2] = (color >> 16) & 0xff;
-			}
-		}
-		break;
-	default:		/* case 4 */
-		for (; pixel <= pixellast; pixel += pixy) {
-			*(Uint32 *) pixel = color;
-		}
-		break;
-		}
+	return (0);
+}
 
-		/* Unlock surface */
-		if (SDL_MUSTLOCK(dst)) {
-			SDL_UnlockSurface(dst);
-		}
+/*!
+\brief Draw horizontal line with blending.
 
-		/*
-		* Set result code 
-		*/
-		result = 0;
+\param dst The surface to draw on.
+\param x1 X coordinate of the first point (i.e. left) of the line.
+\param x2 X coordinate of the second point (i.e. right) of the line.
+\param y Y coordinate of the points of the line.
+\param r The red value of the line to draw. 
+\param g The green value of the line to draw. 
+\param b The blue value of the line to draw. 
+\param a The alpha value of the line to draw. 
 
-	} else {
+\returns Returns 0 on success, -1 on failure.
+*/
+int hlineRGBA(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+	/*
+	* Draw 
+	*/
+	return (hlineColor(dst, x1, x2, y, ((Uint32) r << 24) | ((Uint32) g << 16) | ((Uint32) b << 8) | (Uint32) a));
+}
 
-		/*
-		* Alpha blending blit 
-		*/
+/*!
+\brief Draw vertical line with blending.
+
+\param dst The surface to draw on.
+\param x X coordinate of the points of the line.
+\param y1 Y coordinate of the first point (i.e. top) of the line.
+\param y2 Y coordinate of the second point (i.e. bottom) of the line.
+\param color The color value of the line to draw (0xRRGGBBAA). 
 
-		result = _VLineAlpha(dst, x, y1, y1 + h, color);
+\returns Returns 0 on success, -1 on failure.
+*/
+int vlineColor(SDL_Surface * dst, Sint16 x, Sint16 y1, Sint16 y2, Uint32 color)
+{
+	_gfxSpan span;
 
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
 	}
+	_gfxSpanVLine(&span, x, y1, y2);
+	_gfxSpanEnd(&span);
 
-	return (result);
+	return (0);
 }
 
 /*!
@@ -1997,247 +1570,63 @@ static int _clipLine(SDL_Surface * dst, Sint16 * x1, Sint16 * y1, Sint16 * x2, S
 				*x2 = *x1;
 				*x1 = swaptmp;
 				swaptmp = *y2;
-				*y2 = *y1;
-				*y1 = swaptmp;
-				swaptmp = code2;
-				code2 = code1;
-				code1 = swaptmp;
-			}
-			if (*x2 != *x1) {
-				m = (float)(*y2 - *y1) / (float)(*x2 - *x1);
-			} else {
-				m = 1.0f;
-			}
-			if (code1 & CLIP_LEFT_EDGE) {
-				*y1 += (Sint16) ((left - *x1) * m);
-				*x1 = left;
-			} else if (code1 & CLIP_RIGHT_EDGE) {
-				*y1 += (Sint16) ((right - *x1) * m);
-				*x1 = right;
-			} else if (code1 & CLIP_BOTTOM_EDGE) {
-				if (*x2 != *x1) {
-					*x1 += (Sint16) ((bottom - *y1) / m);
-				}
-				*y1 = bottom;
-			} else if (code1 & CLIP_TOP_EDGE) {
-				if (*x2 != *x1) {
-					*x1 += (Sint16) ((top - *y1) / m);
-				}
-				*y1 = top;
-			}
-		}
-	}
-
-	return draw;
-}
-
-/*!
-\brief Draw box (filled rectangle) with blending.
-
-\param dst The surface to draw on.
-\param x1 X coordinate of the first point (i.e. top right) of the box.
-\param y1 Y coordinate of the first point (i.e. top right) of the box.
-\param x2 X coordinate of the second point (i.e. bottom left) of the box.
-\param y2 Y coordinate of the second point (i.e. bottom left) of the box.
-\param color The color value of the box to draw (0xRRGGBBAA). 
-
-\returns Returns 0 on success, -1 on failure.
-*/
-int boxColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint32 color)
-{
-	Sint16 left, right, top, bottom;
-	Uint8 *pixel, *pixellast;
-	int x, dx;
-	int dy;
-	int pixx, pixy;
-	Sint16 w, h, tmp;
-	int result;
-	Uint8 *colorptr;
-
-	/*
-	* Check visibility of clipping rectangle
-	*/
-	if ((dst->clip_rect.w==0) || (dst->clip_rect.h==0)) {
-		return(0);
-	}
-
-	/*
-	* Order coordinates to ensure that
-	* x1<=x2 and y1<=y2 
-	*/
-	if (x1 > x2) {
-		tmp = x1;
-		x1 = x2;
-		x2 = tmp;
-	}
-	if (y1 > y2) {
-		tmp = y1;
-		y1 = y2;
-		y2 = tmp;
-	}
-
-	/* 
-	* Get clipping boundary and 
-	* check visibility 
-	*/
-	left = dst->clip_rect.x;
-	if (x2<left) {
-		return(0);
-	}
-	right = dst->clip_rect.x + dst->clip_rect.w - 1;
-	if (x1>right) {
-		return(0);
-	}
-	top = dst->clip_rect.y;
-	if (y2<top) {
-		return(0);
-	}
-	bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
-	if (y1>bottom) {
-		return(0);
-	}
-
-	/* Clip all points */
-	if (x1<left) { 
-		x1=left; 
-	} else if (x1>right) {
-		x1=right;
-	}
-	if (x2<left) { 
-		x2=left; 
-	} else if (x2>right) {
-		x2=right;
-	}
-	if (y1<top) { 
-		y1=top; 
-	} else if (y1>bottom) {
-		y1=bottom;
-	}
-	if (y2<top) { 
-		y2=top; 
-	} else if (y2>bottom) {
-		y2=bottom;
-	}
-
-	/*
-	* Test for special cases of straight line or single point 
-	*/
-	if (x1 == x2) {
-		if (y1 == y2) {
-			return (pixelColor(dst, x1, y1, color));
-		} else { 
-			return (vlineColor(dst, x1, y1, y2, color));
-		}
-	}
-	if (y1 == y2) {
-		return (hlineColor(dst, x1, x2, y1, color));
-	}
-
-	/*
-	* Calculate width&height 
-	*/
-	w = x2 - x1;
-	h = y2 - y1;
-
-	/*
-	* Alpha check 
-	*/
-	if ((color & 255) == 255) {
-
-		/*
-		* No alpha-blending required 
-		*/
-
-		/*
-		* Setup color 
-		*/
-		colorptr = (Uint8 *) & color;
-		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-			color = SDL_MapRGBA(dst->format, colorptr[0], colorptr[1], colorptr[2], colorptr[3]);
-		} else {
-			color = SDL_MapRGBA(dst->format, colorptr[3], colorptr[2], colorptr[1], colorptr[0]);
-		}
-
-		/*
-		* Lock the surface 
-		*/
-		if (SDL_MUSTLOCK(dst)) {
-			if (SDL_LockSurface(dst) < 0) {
-				return (-1);
-			}
-		}
-
-		/*
-		* More variable setup 
-		*/
-		dx = w;
-		dy = h;
-		pixx = dst->format->BytesPerPixel;
-		pixy = dst->pitch;
-		pixel = ((Uint8 *) dst->pixels) + pixx * (int) x1 + pixy * (int) y1;
-		pixellast = pixel + pixx * dx + pixy * dy;
-		dx++;
-
-		/*
-		* Draw 
-		*/
-		switch (dst->format->BytesPerPixel) {
-	case 1:
-		for (; pixel <= pixellast; pixel += pixy) {
-			memset(pixel, (Uint8) color, dx);
-		}
-		break;
-	case 2:
-		pixy -= (pixx * dx);
-		for (; pixel <= pixellast; pixel += pixy) {
-			for (x = 0; x < dx; x++) {
-				*(Uint16*) pixel = color;
-				pixel += pixx;
+				*y2 = *y1;
+				*y1 = swaptmp;
+				swaptmp = code2;
+				code2 = code1;
+				code1 = swaptmp;
 			}
-		}
-		break;
-	case 3:
-		pixy -= (pixx * dx);
-		for (; pixel <= pixellast; pixel += pixy) {
-			for (x = 0; x < dx; x++) {
-				if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-					pixel[0] = (color >> 16) & 0xff;
-					pixel[1] = (color >> 8) & 0xff;
-					pixel[2] = color & 0xff;
-				} else {
-					pixel[0] = color & 0xff;
-					pixel[1] = (color >> 8) & 0xff;
-					pixel[2] = (color >> 16) & 0xff;
-				}
-				pixel += pixx;
+			if (*x2 != *x1) {
+				m = (float)(*y2 - *y1) / (float)(*x2 - *x1);
+			} else {
+				m = 1.0f;
 			}
-		}
-		break;
-	default:		/* case 4 */
-		pixy -= (pixx * dx);
-		for (; pixel <= pixellast; pixel += pixy) {
-			for (x = 0; x < dx; x++) {
-				*(Uint32 *) pixel = color;
-				pixel += pixx;
+			if (code1 & CLIP_LEFT_EDGE) {
+				*y1 += (Sint16) ((left - *x1) * m);
+				*x1 = left;
+			} else if (code1 & CLIP_RIGHT_EDGE) {
+				*y1 += (Sint16) ((right - *x1) * m);
+				*x1 = right;
+			} else if (code1 & CLIP_BOTTOM_EDGE) {
+				if (*x2 != *x1) {
+					*x1 += (Sint16) ((bottom - *y1) / m);
+				}
+				*y1 = bottom;
+			} else if (code1 & CLIP_TOP_EDGE) {
+				if (*x2 != *x1) {
+					*x1 += (Sint16) ((top - *y1) / m);
+				}
+				*y1 = top;
 			}
 		}
-		break;
-		}
+	}
 
-		/* Unlock surface */
-		if (SDL_MUSTLOCK(dst)) {
-			SDL_UnlockSurface(dst);
-		}
+	return draw;
+}
 
-		result = 0;
+/*!
+\brief Draw box (filled rectangle) with blending.
 
-	} else {
+\param dst The surface to draw on.
+\param x1 X coordinate of the first point (i.e. top right) of the box.
+\param y1 Y coordinate of the first point (i.e. top right) of the box.
+\param x2 X coordinate of the second point (i.e. bottom left) of the box.
+\param y2 Y coordinate of the second point (i.e. bottom left) of the box.
+\param color The color value of the box to draw (0xRRGGBBAA). 
 
-		result = filledRectAlpha(dst, x1, y1, x1 + w, y1 + h, color);
+\returns Returns 0 on success, -1 on failure.
+*/
+int boxColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint32 color)
+{
+	_gfxSpan span;
 
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
 	}
+	_gfxSpanBox(&span, x1, y1, x2, y2);
+	_gfxSpanEnd(&span);
 
-	return (result);
+	return (0);
 }
 
 /*!
@@ -2263,6 +1652,41 @@ int boxRGBA(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint8
 	return (boxColor(dst, x1, y1, x2, y2, ((Uint32) r << 24) | ((Uint32) g << 16) | ((Uint32) b << 8) | (Uint32) a));
 }
 
+/*!
+\brief Draw many boxes (filled rectangles) of one color with blending.
+
+The color is set up and the surface locked once for all of the boxes.
+
+\param dst The surface to draw on.
+\param rects Array of the boxes to draw. Boxes with no width or height are skipped.
+\param n Number of boxes in the array.
+\param color The color value of the boxes to draw (0xRRGGBBAA). 
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int boxesColor(SDL_Surface * dst, const SDL_Rect * rects, int n, Uint32 color)
+{
+	_gfxSpan span;
+	int i;
+
+	if (rects == NULL) {
+		return (-1);
+	}
+
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
+	}
+	for (i = 0; i < n; i++) {
+		if ((rects[i].w > 0) && (rects[i].h > 0)) {
+			_gfxSpanBox(&span, rects[i].x, rects[i].y,
+				rects[i].x + rects[i].w - 1, rects[i].y + rects[i].h - 1);
+		}
+	}
+	_gfxSpanEnd(&span);
+
+	return (0);
+}
+
 /* ----- Line */
 
 /* Non-alpha line drawing code adapted from routine          */
@@ -2285,6 +1709,7 @@ int boxRGBA(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint8
 */
 int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint32 color)
 {
+	_gfxSpan span;
 	int pixx, pixy;
 	int x, y;
 	int dx, dy;
@@ -2436,6 +1861,7 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 		* Alpha blending required - use single-pixel blits 
 		*/
 
+		_gfxSpanBegin(&span, dst, color, 0);
 		ax = ABS(dx) << 1;
 		ay = ABS(dy) << 1;
 		x = x1;
@@ -2444,7 +1870,7 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 			int d = ay - (ax >> 1);
 
 			while (x != x2) {
-				pixelColorNolock (dst, x, y, color);
+				_gfxSpanPixel(&span, x, y);
 				if (d > 0 || (d == 0 && sx == 1)) {
 					y += sy;
 					d -= ax;
@@ -2456,7 +1882,7 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 			int d = ax - (ay >> 1);
 
 			while (y != y2) {
-				pixelColorNolock (dst, x, y, color);
+				_gfxSpanPixel(&span, x, y);
 				if (d > 0 || ((d == 0) && (sy == 1))) {
 					x += sx;
 					d -= ay;
@@ -2465,7 +1891,7 @@ int lineColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uin
 				d += ax;
 			}
 		}
-		pixelColorNolock (dst, x, y, color);
+		_gfxSpanPixel(&span, x, y);
 
 	}
 
@@ -2812,6 +2238,7 @@ minor speedup changes.
 */
 int circleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32 color)
 {
+	_gfxSpan span;
 	Sint16 left, right, top, bottom;
 	int result;
 	Sint16 x1, y1, x2, y2;
@@ -2882,6 +2309,11 @@ int circleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32 color)
 		}
 	}
 
+	/*
+	* Setup color for blended pixels 
+	*/
+	_gfxSpanBegin(&span, dst, color, 0);
+
 	/*
 	* Alpha Check 
 	*/
@@ -2967,26 +2399,26 @@ int circleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32 color)
 			if (cx > 0) {
 				xpcx = x + cx;
 				xmcx = x - cx;
-				result |= pixelColorNolock (dst, xmcx, ypcy, color);
-				result |= pixelColorNolock (dst, xpcx, ypcy, color);
-				result |= pixelColorNolock (dst, xmcx, ymcy, color);
-				result |= pixelColorNolock (dst, xpcx, ymcy, color);
+				_gfxSpanPixel(&span, xmcx, ypcy);
+				_gfxSpanPixel(&span, xpcx, ypcy);
+				_gfxSpanPixel(&span, xmcx, ymcy);
+				_gfxSpanPixel(&span, xpcx, ymcy);
 			} else {
-				result |= pixelColorNolock (dst, x, ymcy, color);
-				result |= pixelColorNolock (dst, x, ypcy, color);
+				_gfxSpanPixel(&span, x, ymcy);
+				_gfxSpanPixel(&span, x, ypcy);
 			}
 			xpcy = x + cy;
 			xmcy = x - cy;
 			if ((cx > 0) && (cx != cy)) {
 				ypcx = y + cx;
 				ymcx = y - cx;
-				result |= pixelColorNolock (dst, xmcy, ypcx, color);
-				result |= pixelColorNolock (dst, xpcy, ypcx, color);
-				result |= pixelColorNolock (dst, xmcy, ymcx, color);
-				result |= pixelColorNolock (dst, xpcy, ymcx, color);
+				_gfxSpanPixel(&span, xmcy, ypcx);
+				_gfxSpanPixel(&span, xpcy, ypcx);
+				_gfxSpanPixel(&span, xmcy, ymcx);
+				_gfxSpanPixel(&span, xpcy, ymcx);
 			} else if (cx == 0) {
-				result |= pixelColorNolock (dst, xmcy, y, color);
-				result |= pixelColorNolock (dst, xpcy, y, color);
+				_gfxSpanPixel(&span, xmcy, y);
+				_gfxSpanPixel(&span, xpcy, y);
 			}
 			/*
 			* Update 
@@ -3057,6 +2489,7 @@ renders pixels accordingly.
 */
 int arcColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Sint16 start, Sint16 end, Uint32 color)
 {
+	_gfxSpan span;
 	Sint16 left, right, top, bottom;
 	int result;
 	Sint16 x1, y1, x2, y2;
@@ -3242,6 +2675,11 @@ int arcColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Sint16 start, Si
 		}
 	}
 
+	/*
+	* Setup color for blended pixels 
+	*/
+	_gfxSpanBegin(&span, dst, color, 0);
+
 	/*
 	* Draw arc 
 	*/
@@ -3347,13 +2785,13 @@ int arcColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Sint16 start, Si
 				xmcx = x - cx;
 
 				// always check if we're drawing a certain octant before adding a pixel to that octant.
-				if (drawoct & 4)  result |= pixelColorNolock(dst, xmcx, ypcy, color);
-				if (drawoct & 2)  result |= pixelColorNolock(dst, xpcx, ypcy, color);
-				if (drawoct & 32) result |= pixelColorNolock(dst, xmcx, ymcy, color);
-				if (drawoct & 64) result |= pixelColorNolock(dst, xpcx, ymcy, color);
+				if (drawoct & 4)  _gfxSpanPixel(&span, xmcx, ypcy);
+				if (drawoct & 2)  _gfxSpanPixel(&span, xpcx, ypcy);
+				if (drawoct & 32) _gfxSpanPixel(&span, xmcx, ymcy);
+				if (drawoct & 64) _gfxSpanPixel(&span, xpcx, ymcy);
 			} else {
-				if (drawoct & 96) result |= pixelColorNolock(dst, x, ymcy, color);
-				if (drawoct & 6)  result |= pixelColorNolock(dst, x, ypcy, color);
+				if (drawoct & 96) _gfxSpanPixel(&span, x, ymcy);
+				if (drawoct & 6)  _gfxSpanPixel(&span, x, ypcy);
 			}
 
 			xpcy = x + cy;
@@ -3361,13 +2799,13 @@ int arcColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Sint16 start, Si
 			if (cx > 0 && cx != cy) {
 				ypcx = y + cx;
 				ymcx = y - cx;
-				if (drawoct & 8)   result |= pixelColorNolock(dst, xmcy, ypcx, color);
-				if (drawoct & 1)   result |= pixelColorNolock(dst, xpcy, ypcx, color);
-				if (drawoct & 16)  result |= pixelColorNolock(dst, xmcy, ymcx, color);
-				if (drawoct & 128) result |= pixelColorNolock(dst, xpcy, ymcx, color);
+				if (drawoct & 8)   _gfxSpanPixel(&span, xmcy, ypcx);
+				if (drawoct & 1)   _gfxSpanPixel(&span, xpcy, ypcx);
+				if (drawoct & 16)  _gfxSpanPixel(&span, xmcy, ymcx);
+				if (drawoct & 128) _gfxSpanPixel(&span, xpcy, ymcx);
 			} else if (cx == 0) {
-				if (drawoct & 24)  result |= pixelColorNolock(dst, xmcy, y, color);
-				if (drawoct & 129) result |= pixelColorNolock(dst, xpcy, y, color);
+				if (drawoct & 24)  _gfxSpanPixel(&span, xmcy, y);
+				if (drawoct & 129) _gfxSpanPixel(&span, xpcy, y);
 			}
 
 			/*
@@ -3496,6 +2934,7 @@ multiple-hline draw removal and other minor speedup changes.
 */
 int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32 color)
 {
+	_gfxSpan span;
 	Sint16 left, right, top, bottom;
 	int result;
 	Sint16 x1, y1, x2, y2;
@@ -3555,6 +2994,13 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 		return(0);
 	} 
 
+	/*
+	* Setup color and lock the surface once for all spans
+	*/
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
+	}
+
 	/*
 	* Draw 
 	*/
@@ -3568,10 +3014,10 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 			if (cy > 0) {
 				ypcy = y + cy;
 				ymcy = y - cy;
-				result |= hlineColor(dst, xmcx, xpcx, ypcy, color);
-				result |= hlineColor(dst, xmcx, xpcx, ymcy, color);
+				_gfxSpanHLine(&span, xmcx, xpcx, ypcy);
+				_gfxSpanHLine(&span, xmcx, xpcx, ymcy);
 			} else {
-				result |= hlineColor(dst, xmcx, xpcx, y, color);
+				_gfxSpanHLine(&span, xmcx, xpcx, y);
 			}
 			ocy = cy;
 		}
@@ -3580,10 +3026,10 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 				if (cx > 0) {
 					ypcx = y + cx;
 					ymcx = y - cx;
-					result |= hlineColor(dst, xmcy, xpcy, ymcx, color);
-					result |= hlineColor(dst, xmcy, xpcy, ypcx, color);
+					_gfxSpanHLine(&span, xmcy, xpcy, ymcx);
+					_gfxSpanHLine(&span, xmcy, xpcy, ypcx);
 				} else {
-					result |= hlineColor(dst, xmcy, xpcy, y, color);
+					_gfxSpanHLine(&span, xmcy, xpcy, y);
 				}
 			}
 			ocx = cx;
@@ -3604,6 +3050,8 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 		cx++;
 	} while (cx <= cy);
 
+	_gfxSpanEnd(&span);
+
 	return (result);
 }
 
@@ -3649,6 +3097,7 @@ multiple-pixel draw removal and other minor speedup changes.
 */
 int ellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint32 color)
 {
+	_gfxSpan span;
 	Sint16 left, right, top, bottom;
 	int result;
 	Sint16 x1, y1, x2, y2;
@@ -3730,6 +3179,11 @@ int ellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Ui
 		}
 	}
 
+	/*
+	* Setup color for blended pixels 
+	*/
+	_gfxSpanBegin(&span, dst, color, 0);
+
 	/*
 	* Check alpha 
 	*/
@@ -3860,13 +3314,13 @@ int ellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Ui
 					if (k > 0) {
 						ypk = y + k;
 						ymk = y - k;
-						result |= pixelColorNolock (dst, xmh, ypk, color);
-						result |= pixelColorNolock (dst, xph, ypk, color);
-						result |= pixelColorNolock (dst, xmh, ymk, color);
-						result |= pixelColorNolock (dst, xph, ymk, color);
+						_gfxSpanPixel(&span, xmh, ypk);
+						_gfxSpanPixel(&span, xph, ypk);
+						_gfxSpanPixel(&span, xmh, ymk);
+						_gfxSpanPixel(&span, xph, ymk);
 					} else {
-						result |= pixelColorNolock (dst, xmh, y, color);
-						result |= pixelColorNolock (dst, xph, y, color);
+						_gfxSpanPixel(&span, xmh, y);
+						_gfxSpanPixel(&span, xph, y);
 					}
 					ok = k;
 					xpi = x + i;
@@ -3874,13 +3328,13 @@ int ellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Ui
 					if (j > 0) {
 						ypj = y + j;
 						ymj = y - j;
-						result |= pixelColorNolock (dst, xmi, ypj, color);
-						result |= pixelColorNolock (dst, xpi, ypj, color);
-						result |= pixelColorNolock (dst, xmi, ymj, color);
-						result |= pixelColor(dst, xpi, ymj, color);
+						_gfxSpanPixel(&span, xmi, ypj);
+						_gfxSpanPixel(&span, xpi, ypj);
+						_gfxSpanPixel(&span, xmi, ymj);
+						_gfxSpanPixel(&span, xpi, ymj);
 					} else {
-						result |= pixelColorNolock (dst, xmi, y, color);
-						result |= pixelColorNolock (dst, xpi, y, color);
+						_gfxSpanPixel(&span, xmi, y);
+						_gfxSpanPixel(&span, xpi, y);
 					}
 					oj = j;
 				}
@@ -3905,13 +3359,13 @@ int ellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Ui
 					if (i > 0) {
 						ypi = y + i;
 						ymi = y - i;
-						result |= pixelColorNolock (dst, xmj, ypi, color);
-						result |= pixelColorNolock (dst, xpj, ypi, color);
-						result |= pixelColorNolock (dst, xmj, ymi, color);
-						result |= pixelColorNolock (dst, xpj, ymi, color);
+						_gfxSpanPixel(&span, xmj, ypi);
+						_gfxSpanPixel(&span, xpj, ypi);
+						_gfxSpanPixel(&span, xmj, ymi);
+						_gfxSpanPixel(&span, xpj, ymi);
 					} else {
-						result |= pixelColorNolock (dst, xmj, y, color);
-						result |= pixelColorNolock (dst, xpj, y, color);
+						_gfxSpanPixel(&span, xmj, y);
+						_gfxSpanPixel(&span, xpj, y);
 					}
 					oi = i;
 					xmk = x - k;
@@ -3919,13 +3373,13 @@ int ellipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Ui
 					if (h > 0) {
 						yph = y + h;
 						ymh = y - h;
-						result |= pixelColorNolock (dst, xmk, yph, color);
-						result |= pixelColorNolock (dst, xpk, yph, color);
-						result |= pixelColorNolock (dst, xmk, ymh, color);
-						result |= pixelColorNolock (dst, xpk, ymh, color);
+						_gfxSpanPixel(&span, xmk, yph);
+						_gfxSpanPixel(&span, xpk, yph);
+						_gfxSpanPixel(&span, xmk, ymh);
+						_gfxSpanPixel(&span, xpk, ymh);
 					} else {
-						result |= pixelColorNolock (dst, xmk, y, color);
-						result |= pixelColorNolock (dst, xpk, y, color);
+						_gfxSpanPixel(&span, xmk, y);
+						_gfxSpanPixel(&span, xpk, y);
 					}
 					oh = h;
 				}
@@ -4301,6 +3755,7 @@ and other speedup changes.
 */
 int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint32 color)
 {
+	_gfxSpan span;
 	Sint16 left, right, top, bottom;
 	int result;
 	Sint16 x1, y1, x2, y2;
@@ -4364,6 +3819,13 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 		return(0);
 	} 
 
+	/*
+	* Setup color and lock the surface once for all spans
+	*/
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
+	}
+
 	/*
 	* Init vars 
 	*/
@@ -4387,10 +3849,10 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 				xph = x + h;
 				xmh = x - h;
 				if (k > 0) {
-					result |= hlineColor(dst, xmh, xph, y + k, color);
-					result |= hlineColor(dst, xmh, xph, y - k, color);
+					_gfxSpanHLine(&span, xmh, xph, y + k);
+					_gfxSpanHLine(&span, xmh, xph, y - k);
 				} else {
-					result |= hlineColor(dst, xmh, xph, y, color);
+					_gfxSpanHLine(&span, xmh, xph, y);
 				}
 				ok = k;
 			}
@@ -4398,10 +3860,10 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 				xmi = x - i;
 				xpi = x + i;
 				if (j > 0) {
-					result |= hlineColor(dst, xmi, xpi, y + j, color);
-					result |= hlineColor(dst, xmi, xpi, y - j, color);
+					_gfxSpanHLine(&span, xmi, xpi, y + j);
+					_gfxSpanHLine(&span, xmi, xpi, y - j);
 				} else {
-					result |= hlineColor(dst, xmi, xpi, y, color);
+					_gfxSpanHLine(&span, xmi, xpi, y);
 				}
 				oj = j;
 			}
@@ -4424,10 +3886,10 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 				xmj = x - j;
 				xpj = x + j;
 				if (i > 0) {
-					result |= hlineColor(dst, xmj, xpj, y + i, color);
-					result |= hlineColor(dst, xmj, xpj, y - i, color);
+					_gfxSpanHLine(&span, xmj, xpj, y + i);
+					_gfxSpanHLine(&span, xmj, xpj, y - i);
 				} else {
-					result |= hlineColor(dst, xmj, xpj, y, color);
+					_gfxSpanHLine(&span, xmj, xpj, y);
 				}
 				oi = i;
 			}
@@ -4435,10 +3897,10 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 				xmk = x - k;
 				xpk = x + k;
 				if (h > 0) {
-					result |= hlineColor(dst, xmk, xpk, y + h, color);
-					result |= hlineColor(dst, xmk, xpk, y - h, color);
+					_gfxSpanHLine(&span, xmk, xpk, y + h);
+					_gfxSpanHLine(&span, xmk, xpk, y - h);
 				} else {
-					result |= hlineColor(dst, xmk, xpk, y, color);
+					_gfxSpanHLine(&span, xmk, xpk, y);
 				}
 				oh = h;
 			}
@@ -4449,6 +3911,8 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 		} while (i > h);
 	}
 
+	_gfxSpanEnd(&span);
+
 	return (result);
 }
 
@@ -5126,22 +4590,26 @@ Note: Used for non-multithreaded (default) operation of filledPolygonMT.
 static int gfxPrimitivesPolyAllocatedGlobal = 0;
 
 /*!
-\brief Draw filled polygon with alpha blending (multi-threaded capable).
+\brief Draw the rows ystart to yend of a filled polygon with alpha blending (multi-threaded capable).
 
-Note: The last two parameters are optional; but are required for multithreaded operation.  
+Draws the same pixels on these rows as filledPolygonColor. Calls drawing
+different rows of the same surface may run at the same time, each with its
+own polyInts array, as long as the surface does not need locking.
 
 \param dst The surface to draw on.
 \param vx Vertex array containing X coordinates of the points of the filled polygon.
 \param vy Vertex array containing Y coordinates of the points of the filled polygon.
 \param n Number of points in the vertex array. Minimum number is 3.
 \param color The color value of the filled polygon to draw (0xRRGGBBAA). 
-\param polyInts Preallocated, temporary vertex array used for sorting vertices. Required for multithreaded operation; set to NULL otherwise.
-\param polyAllocated Flag indicating if temporary vertex array was allocated. Required for multithreaded operation; set to NULL otherwise.
+\param polyInts Temporary array of at least n ints used for sorting the intersections of a row.
+\param ystart The first row to draw.
+\param yend The last row to draw.
 
 \returns Returns 0 on success, -1 on failure.
 */
-int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, Uint32 color, int **polyInts, int *polyAllocated)
+int filledPolygonRowsColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, Uint32 color, int *polyInts, int ystart, int yend)
 {
+	_gfxSpan span;
 	int result;
 	int i;
 	int y, xa, xb;
@@ -5150,6 +4618,119 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 	int x2, y2;
 	int ind1, ind2;
 	int ints;
+
+	/*
+	* Check visibility of clipping rectangle
+	*/
+	if ((dst->clip_rect.w==0) || (dst->clip_rect.h==0)) {
+		return(0);
+	}
+
+	/*
+	* Vertex and temp array NULL check 
+	*/
+	if ((vx == NULL) || (vy == NULL) || (polyInts == NULL)) {
+		return (-1);
+	}
+
+	/*
+	* Sanity check number of edges
+	*/
+	if (n < 3) {
+		return -1;
+	}
+
+	/*
+	* Determine Y maxima 
+	*/
+	miny = vy[0];
+	maxy = vy[0];
+	for (i = 1; (i < n); i++) {
+		if (vy[i] < miny) {
+			miny = vy[i];
+		} else if (vy[i] > maxy) {
+			maxy = vy[i];
+		}
+	}
+
+	/*
+	* Setup color and lock the surface once for all spans
+	*/
+	if (_gfxSpanBegin(&span, dst, color, 1) < 0) {
+		return (-1);
+	}
+
+	/*
+	* Draw, scanning y 
+	*/
+	result = 0;
+	if (ystart < miny) {
+		ystart = miny;
+	}
+	if (yend > maxy) {
+		yend = maxy;
+	}
+	for (y = ystart; (y <= yend); y++) {
+		ints = 0;
+		for (i = 0; (i < n); i++) {
+			if (!i) {
+				ind1 = n - 1;
+				ind2 = 0;
+			} else {
+				ind1 = i - 1;
+				ind2 = i;
+			}
+			y1 = vy[ind1];
+			y2 = vy[ind2];
+			if (y1 < y2) {
+				x1 = vx[ind1];
+				x2 = vx[ind2];
+			} else if (y1 > y2) {
+				y2 = vy[ind1];
+				y1 = vy[ind2];
+				x2 = vx[ind1];
+				x1 = vx[ind2];
+			} else {
+				continue;
+			}
+			if ( ((y >= y1) && (y < y2)) || ((y == maxy) && (y > y1) && (y <= y2)) ) {
+				polyInts[ints++] = ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) + (65536 * x1);
+			} 	    
+		}
+
+		qsort(polyInts, ints, sizeof(int), _gfxPrimitivesCompareInt);
+
+		for (i = 0; (i < ints); i += 2) {
+			xa = polyInts[i] + 1;
+			xa = (xa >> 16) + ((xa & 32768) >> 15);
+			xb = polyInts[i+1] - 1;
+			xb = (xb >> 16) + ((xb & 32768) >> 15);
+			_gfxSpanHLine(&span, xa, xb, y);
+		}
+	}
+
+	_gfxSpanEnd(&span);
+
+	return (result);
+}
+
+/*!
+\brief Draw filled polygon with alpha blending (multi-threaded capable).
+
+Note: The last two parameters are optional; but are required for multithreaded operation.  
+
+\param dst The surface to draw on.
+\param vx Vertex array containing X coordinates of the points of the filled polygon.
+\param vy Vertex array containing Y coordinates of the points of the filled polygon.
+\param n Number of points in the vertex array. Minimum number is 3.
+\param color The color value of the filled polygon to draw (0xRRGGBBAA). 
+\param polyInts Preallocated, temporary vertex array used for sorting vertices. Required for multithreaded operation; set to NULL otherwise.
+\param polyAllocated Flag indicating if temporary vertex array was allocated. Required for multithreaded operation; set to NULL otherwise.
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, Uint32 color, int **polyInts, int *polyAllocated)
+{
 	int *gfxPrimitivesPolyInts = NULL;
 	int *gfxPrimitivesPolyIntsNew = NULL;
 	int gfxPrimitivesPolyAllocated = 0;
@@ -5238,63 +4819,7 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 		return(-1);
 	}
 
-	/*
-	* Determine Y maxima 
-	*/
-	miny = vy[0];
-	maxy = vy[0];
-	for (i = 1; (i < n); i++) {
-		if (vy[i] < miny) {
-			miny = vy[i];
-		} else if (vy[i] > maxy) {
-			maxy = vy[i];
-		}
-	}
-
-	/*
-	* Draw, scanning y 
-	*/
-	result = 0;
-	for (y = miny; (y <= maxy); y++) {
-		ints = 0;
-		for (i = 0; (i < n); i++) {
-			if (!i) {
-				ind1 = n - 1;
-				ind2 = 0;
-			} else {
-				ind1 = i - 1;
-				ind2 = i;
-			}
-			y1 = vy[ind1];
-			y2 = vy[ind2];
-			if (y1 < y2) {
-				x1 = vx[ind1];
-				x2 = vx[ind2];
-			} else if (y1 > y2) {
-				y2 = vy[ind1];
-				y1 = vy[ind2];
-				x2 = vx[ind1];
-				x1 = vx[ind2];
-			} else {
-				continue;
-			}
-			if ( ((y >= y1) && (y < y2)) || ((y == maxy) && (y > y1) && (y <= y2)) ) {
-				gfxPrimitivesPolyInts[ints++] = ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) + (65536 * x1);
-			} 	    
-		}
-
-		qsort(gfxPrimitivesPolyInts, ints, sizeof(int), _gfxPrimitivesCompareInt);
-
-		for (i = 0; (i < ints); i += 2) {
-			xa = gfxPrimitivesPolyInts[i] + 1;
-			xa = (xa >> 16) + ((xa & 32768) >> 15);
-			xb = gfxPrimitivesPolyInts[i+1] - 1;
-			xb = (xb >> 16) + ((xb & 32768) >> 15);
-			result |= hlineColor(dst, xa, xb, y, color);
-		}
-	}
-
-	return (result);
+	return (filledPolygonRowsColorMT(dst, vx, vy, n, color, gfxPrimitivesPolyInts, -32768, 32767));
 }
 
 /*!
@@ -49,6 +49,7 @@ extern "C" {
 
 	SDL_GFXPRIMITIVES_SCOPE int pixelColor(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color);
 	SDL_GFXPRIMITIVES_SCOPE int pixelRGBA(SDL_Surface * dst, Sint16 x, Sint16 y, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+	SDL_GFXPRIMITIVES_SCOPE int pixelsColor(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, Uint32 color);
 
 	/* Horizontal line */
 
@@ -79,6 +80,7 @@ extern "C" {
 	SDL_GFXPRIMITIVES_SCOPE int boxColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint32 color);
 	SDL_GFXPRIMITIVES_SCOPE int boxRGBA(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2,
 		Sint16 y2, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+	SDL_GFXPRIMITIVES_SCOPE int boxesColor(SDL_Surface * dst, const SDL_Rect * rects, int n, Uint32 color);
 
 #if 0  /********** CURRENTLY NOT USED BY pygame.gfxdraw **********/
 	/* Rounded-Corner Filled rectangle (Box) */
@@ -208,6 +210,7 @@ extern "C" {
 	SDL_GFXPRIMITIVES_SCOPE int filledPolygonRGBAMT(SDL_Surface * dst, const Sint16 * vx,
 		const Sint16 * vy, int n, Uint8 r, Uint8 g, Uint8 b, Uint8 a,
 		int **polyInts, int *polyAllocated);
+	SDL_GFXPRIMITIVES_SCOPE int filledPolygonRowsColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, Uint32 color, int *polyInts, int ystart, int yend);
 	SDL_GFXPRIMITIVES_SCOPE int texturedPolygonMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, SDL_Surface * texture,int texture_dx,int texture_dy, int **polyInts, int *polyAllocated);
 
 	/* Bezier */
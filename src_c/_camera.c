@@ -141,6 +141,7 @@ surf_colorspace(PyObject *self, PyObject *arg)
     SDL_UnlockSurface(newsurf);
 
     if (surfobj2) {
+        pgSurface_AddDamage(surfobj2, NULL);
         Py_INCREF(surfobj2);
         return (PyObject *)surfobj2;
     }
@@ -406,6 +407,7 @@ camera_get_image(pgCameraObject *self, PyObject *arg)
     }
 
     if (surfobj) {
+        pgSurface_AddDamage(surfobj, NULL);
         Py_INCREF(surfobj);
         return (PyObject *)surfobj;
     }
@@ -442,6 +444,7 @@ camera_get_image(pgCameraObject *self, PyObject *arg)
         return NULL;
 
     if (surfobj) {
+        pgSurface_AddDamage(surfobj, NULL);
         Py_INCREF(surfobj);
         return (PyObject *)surfobj;
     }
@@ -1914,6 +1914,7 @@ _ftfont_render_to(pgFontObject *self, PyObject *args, PyObject *kwds)
             &r))
         goto error;
     free_string(text);
+    pgSurface_AddDamage((pgSurfaceObject *)surface_obj, &r);
 
     return pgRect_New(&r);
 
@@ -307,6 +307,19 @@ struct pgSubSurface_Data {
     int offsetx, offsety;
 };
 
+/* Regions written to a surface since its damage was last cleared, see
+ * Surface.set_damage_tracking(). rects has room for one rect over the limit
+ * while a new one is being merged in. The records of all the surfaces
+ * tracking damage are linked together in surface.c. */
+#define PG_DAMAGE_MAX_RECTS 64
+struct pgDamage_Data {
+    PyObject *surfobj; /* not a reference, removed on dealloc */
+    struct pgDamage_Data *next;
+    int count;
+    int max_rects;
+    SDL_Rect rects[PG_DAMAGE_MAX_RECTS + 1];
+};
+
 /*
  * color module internals
  */
@@ -327,13 +340,13 @@ struct pgColorObject {
 #define PYGAMEAPI_RECT_NUMSLOTS 5
 #define PYGAMEAPI_JOYSTICK_NUMSLOTS 2
 #define PYGAMEAPI_DISPLAY_NUMSLOTS 2
-#define PYGAMEAPI_SURFACE_NUMSLOTS 4
+#define PYGAMEAPI_SURFACE_NUMSLOTS 7
 #define PYGAMEAPI_SURFLOCK_NUMSLOTS 8
 #define PYGAMEAPI_RWOBJECT_NUMSLOTS 7
 #define PYGAMEAPI_PIXELARRAY_NUMSLOTS 2
 #define PYGAMEAPI_COLOR_NUMSLOTS 5
 #define PYGAMEAPI_MATH_NUMSLOTS 2
-#define PYGAMEAPI_BASE_NUMSLOTS 24
-#define PYGAMEAPI_EVENT_NUMSLOTS 6
+#define PYGAMEAPI_BASE_NUMSLOTS 25
+#define PYGAMEAPI_EVENT_NUMSLOTS 7
 
 #endif /* _PYGAME_INTERNAL_H */
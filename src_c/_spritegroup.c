@@ -0,0 +1,2226 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * Native storage for pygame.sprite groups.
+ *
+ * GroupCore keeps its sprites in a dense array, together with the area
+ * each one covered the last time it was drawn. A dict maps every sprite
+ * to its slot, so membership tests, adds and removes are O(1): a removed
+ * sprite's slot is filled with the last sprite in the array. Drawing walks
+ * the array and blits straight through the surface C api, so no blit
+ * list or result list is built on the Python side.
+ */
+
+#include "pygame.h"
+
+#include "pgcompat.h"
+
+#include <stddef.h>
+
+#define GROUPCORE_MIN_CAPACITY 16
+
+typedef struct {
+    PyObject_HEAD PyObject **sprites;
+    SDL_Rect *rects;   /* area covered when last drawn, empty if never */
+    Py_ssize_t length; /* number of sprites */
+    Py_ssize_t capacity;
+    PyObject *index; /* dict: sprite -> slot */
+    SDL_Rect *lost;  /* areas of sprites removed since the last draw */
+    Py_ssize_t lost_length;
+    Py_ssize_t lost_capacity;
+} pgGroupCoreObject;
+
+static PyTypeObject pgGroupCore_Type;
+
+static PyObject *str_image = NULL;
+static PyObject *str_rect = NULL;
+static PyObject *str_update = NULL;
+static PyObject *str_dirty = NULL;
+static PyObject *str_visible = NULL;
+static PyObject *str_blendmode = NULL;
+static PyObject *str_source_rect = NULL;
+
+#define _rect_is_empty(r) ((r)->w == 0 || (r)->h == 0)
+
+static int
+_groupcore_reserve(pgGroupCoreObject *self, Py_ssize_t length)
+{
+    Py_ssize_t capacity = self->capacity;
+    PyObject **sprites;
+    SDL_Rect *rects;
+
+    if (length <= capacity) {
+        return 0;
+    }
+    if (capacity < GROUPCORE_MIN_CAPACITY) {
+        capacity = GROUPCORE_MIN_CAPACITY;
+    }
+    while (capacity < length) {
+        capacity *= 2;
+    }
+    sprites = PyMem_Realloc(self->sprites, sizeof(PyObject *) * capacity);
+    if (!sprites) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->sprites = sprites;
+    rects = PyMem_Realloc(self->rects, sizeof(SDL_Rect) * capacity);
+    if (!rects) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->rects = rects;
+    self->capacity = capacity;
+    return 0;
+}
+
+static int
+_groupcore_lose(pgGroupCoreObject *self, const SDL_Rect *rect)
+{
+    SDL_Rect *lost;
+    Py_ssize_t capacity;
+
+    if (_rect_is_empty(rect)) {
+        return 0;
+    }
+    if (self->lost_length == self->lost_capacity) {
+        capacity = self->lost_capacity ? self->lost_capacity * 2
+                                       : GROUPCORE_MIN_CAPACITY;
+        lost = PyMem_Realloc(self->lost, sizeof(SDL_Rect) * capacity);
+        if (!lost) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->lost = lost;
+        self->lost_capacity = capacity;
+    }
+    self->lost[self->lost_length++] = *rect;
+    return 0;
+}
+
+/* Return the slot of sprite, or -1 if it is not in the group or on error */
+static Py_ssize_t
+_groupcore_slot(pgGroupCoreObject *self, PyObject *sprite)
+{
+    PyObject *slot = PyDict_GetItemWithError(self->index, sprite);
+
+    if (!slot) {
+        return -1;
+    }
+    return PyLong_AsSsize_t(slot);
+}
+
+static int
+_groupcore_set_slot(pgGroupCoreObject *self, PyObject *sprite,
+                    Py_ssize_t slot)
+{
+    PyObject *value = PyLong_FromSsize_t(slot);
+    int result;
+
+    if (!value) {
+        return -1;
+    }
+    result = PyDict_SetItem(self->index, sprite, value);
+    Py_DECREF(value);
+    return result;
+}
+
+/* Return a new reference to each sprite, so the caller can run Python
+ * code that adds or removes sprites while it walks the group.
+ */
+static PyObject **
+_groupcore_snapshot(pgGroupCoreObject *self, Py_ssize_t *length)
+{
+    PyObject **sprites;
+    Py_ssize_t i;
+
+    *length = self->length;
+    sprites = PyMem_New(PyObject *, self->length ? self->length : 1);
+    if (!sprites) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (i = 0; i < self->length; ++i) {
+        sprites[i] = self->sprites[i];
+        Py_INCREF(sprites[i]);
+    }
+    return sprites;
+}
+
+static void
+_groupcore_release(PyObject **sprites, Py_ssize_t length)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < length; ++i) {
+        Py_DECREF(sprites[i]);
+    }
+    PyMem_Free(sprites);
+}
+
+static PyObject *
+_groupcore_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    pgGroupCoreObject *self = (pgGroupCoreObject *)type->tp_alloc(type, 0);
+
+    if (!self) {
+        return NULL;
+    }
+    self->index = PyDict_New();
+    if (!self->index) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+static int
+_groupcore_clear(pgGroupCoreObject *self)
+{
+    PyObject **sprites = self->sprites;
+    Py_ssize_t length = self->length;
+
+    self->sprites = NULL;
+    self->length = 0;
+    self->capacity = 0;
+    Py_CLEAR(self->index);
+    if (sprites) {
+        _groupcore_release(sprites, length);
+    }
+    return 0;
+}
+
+static int
+_groupcore_traverse(pgGroupCoreObject *self, visitproc visit, void *arg)
+{
+    Py_ssize_t i;
+
+    Py_VISIT(self->index);
+    for (i = 0; i < self->length; ++i) {
+        Py_VISIT(self->sprites[i]);
+    }
+    return 0;
+}
+
+static void
+_groupcore_dealloc(pgGroupCoreObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    _groupcore_clear(self);
+    PyMem_Free(self->rects);
+    PyMem_Free(self->lost);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+groupcore_add(pgGroupCoreObject *self, PyObject *sprite)
+{
+    int contains = PyDict_Contains(self->index, sprite);
+
+    if (contains) {
+        return contains < 0 ? NULL : PyBool_FromLong(0);
+    }
+    if (_groupcore_reserve(self, self->length + 1) ||
+        _groupcore_set_slot(self, sprite, self->length)) {
+        return NULL;
+    }
+    Py_INCREF(sprite);
+    self->sprites[self->length] = sprite;
+    memset(self->rects + self->length, 0, sizeof(SDL_Rect));
+    ++self->length;
+    Py_RETURN_TRUE;
+}
+
+static PyObject *
+groupcore_remove(pgGroupCoreObject *self, PyObject *sprite)
+{
+    Py_ssize_t slot = _groupcore_slot(self, sprite);
+    Py_ssize_t last;
+    PyObject *removed;
+
+    if (slot < 0) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetObject(PyExc_KeyError, sprite);
+        }
+        return NULL;
+    }
+    if (_groupcore_lose(self, self->rects + slot)) {
+        return NULL;
+    }
+    if (PyDict_DelItem(self->index, sprite)) {
+        return NULL;
+    }
+    last = self->length - 1;
+    removed = self->sprites[slot];
+    if (slot != last &&
+        _groupcore_set_slot(self, self->sprites[last], slot)) {
+        return NULL;
+    }
+    self->sprites[slot] = self->sprites[last];
+    self->rects[slot] = self->rects[last];
+    self->length = last;
+    Py_DECREF(removed);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+groupcore_sprites(pgGroupCoreObject *self, PyObject *_null)
+{
+    PyObject *list = PyList_New(self->length);
+    Py_ssize_t i;
+
+    if (!list) {
+        return NULL;
+    }
+    for (i = 0; i < self->length; ++i) {
+        Py_INCREF(self->sprites[i]);
+        PyList_SET_ITEM(list, i, self->sprites[i]);
+    }
+    return list;
+}
+
+static PyObject *
+groupcore_spritedict(pgGroupCoreObject *self, PyObject *_null)
+{
+    PyObject *dict = PyDict_New();
+    PyObject *rect;
+    Py_ssize_t i;
+
+    if (!dict) {
+        return NULL;
+    }
+    for (i = 0; i < self->length; ++i) {
+        if (_rect_is_empty(self->rects + i)) {
+            rect = Py_None;
+            Py_INCREF(rect);
+        }
+        else if (!(rect = pgRect_New(self->rects + i))) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+        if (PyDict_SetItem(dict, self->sprites[i], rect)) {
+            Py_DECREF(rect);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(rect);
+    }
+    return dict;
+}
+
+static PyObject *
+groupcore_lostsprites(pgGroupCoreObject *self, PyObject *_null)
+{
+    PyObject *list = PyList_New(self->lost_length);
+    PyObject *rect;
+    Py_ssize_t i;
+
+    if (!list) {
+        return NULL;
+    }
+    for (i = 0; i < self->lost_length; ++i) {
+        if (!(rect = pgRect_New(self->lost + i))) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, rect);
+    }
+    return list;
+}
+
+static PyObject *
+groupcore_update(pgGroupCoreObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject **sprites;
+    PyObject *method, *result;
+    Py_ssize_t length, i;
+
+    if (!(sprites = _groupcore_snapshot(self, &length))) {
+        return NULL;
+    }
+    for (i = 0; i < length; ++i) {
+        if (!(method = PyObject_GetAttr(sprites[i], str_update))) {
+            _groupcore_release(sprites, length);
+            return NULL;
+        }
+        result = PyObject_Call(method, args, kwargs);
+        Py_DECREF(method);
+        if (!result) {
+            _groupcore_release(sprites, length);
+            return NULL;
+        }
+        Py_DECREF(result);
+    }
+    _groupcore_release(sprites, length);
+    Py_RETURN_NONE;
+}
+
+/* Blit the image of sprite onto surfobj at its rect, and store the area that
+ * was drawn in dest.
+ */
+static int
+_groupcore_blit_sprite(pgSurfaceObject *surfobj, PyObject *sprite,
+                       SDL_Rect *dest, int flags)
+{
+    PyObject *image, *pos;
+    SDL_Surface *src;
+    SDL_Rect temp, area, *rect;
+    int x, y, result;
+
+    if (!(image = PyObject_GetAttr(sprite, str_image))) {
+        return -1;
+    }
+    if (!pgSurface_Check(image)) {
+        Py_DECREF(image);
+        PyErr_SetString(PyExc_TypeError, "sprite image must be a Surface");
+        return -1;
+    }
+    if (!(src = pgSurface_AsSurface(image))) {
+        Py_DECREF(image);
+        PyErr_SetString(pgExc_SDLError, "display Surface quit");
+        return -1;
+    }
+    if (!(pos = PyObject_GetAttr(sprite, str_rect))) {
+        Py_DECREF(image);
+        return -1;
+    }
+    if ((rect = pgRect_FromObject(pos, &temp))) {
+        x = rect->x;
+        y = rect->y;
+    }
+    else if (!pg_TwoIntsFromObj(pos, &x, &y)) {
+        Py_DECREF(image);
+        Py_DECREF(pos);
+        PyErr_SetString(PyExc_TypeError,
+                        "invalid destination position for blit");
+        return -1;
+    }
+    Py_DECREF(pos);
+
+    area.x = area.y = 0;
+    area.w = src->w;
+    area.h = src->h;
+    dest->x = x;
+    dest->y = y;
+    dest->w = src->w;
+    dest->h = src->h;
+    result = pgSurface_Blit(surfobj, (pgSurfaceObject *)image, dest, &area,
+                            flags);
+    Py_DECREF(image);
+    return result ? -1 : 0;
+}
+
+static PyObject *
+groupcore_draw(pgGroupCoreObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *sprite;
+    SDL_Rect dest;
+    Py_ssize_t i;
+    int flags = 0;
+    static char *keywords[] = {"surface", "special_flags", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|i", keywords,
+                                     &pgSurface_Type, &surfobj, &flags)) {
+        return NULL;
+    }
+    if (!pgSurface_AsSurface(surfobj)) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+
+    for (i = 0; i < self->length; ++i) {
+        /* Fetching image and rect may run Python code (properties), which
+         * could remove sprites; only store the rect if the slot still
+         * holds the same sprite afterwards.
+         */
+        sprite = self->sprites[i];
+        Py_INCREF(sprite);
+        if (_groupcore_blit_sprite(surfobj, sprite, &dest, flags)) {
+            Py_DECREF(sprite);
+            return NULL;
+        }
+        if (i < self->length && self->sprites[i] == sprite) {
+            self->rects[i] = dest;
+        }
+        Py_DECREF(sprite);
+    }
+    self->lost_length = 0;
+    Py_RETURN_NONE;
+}
+
+static int
+_groupcore_clear_rect(PyObject *surface, PyObject *bgd, SDL_Rect rect)
+{
+    PyObject *rectobj, *result;
+    SDL_Rect dest = rect;
+
+    if (pgSurface_Check(bgd)) {
+        if (!pgSurface_AsSurface(bgd)) {
+            PyErr_SetString(pgExc_SDLError, "display Surface quit");
+            return -1;
+        }
+        return pgSurface_Blit((pgSurfaceObject *)surface,
+                              (pgSurfaceObject *)bgd, &dest, &rect, 0)
+                   ? -1
+                   : 0;
+    }
+    if (!(rectobj = pgRect_New(&rect))) {
+        return -1;
+    }
+    result = PyObject_CallFunctionObjArgs(bgd, surface, rectobj, NULL);
+    Py_DECREF(rectobj);
+    Py_XDECREF(result);
+    return result ? 0 : -1;
+}
+
+static PyObject *
+groupcore_clear(pgGroupCoreObject *self, PyObject *args)
+{
+    PyObject *surface, *bgd;
+    Py_ssize_t i;
+
+    if (!PyArg_ParseTuple(args, "O!O", &pgSurface_Type, &surface, &bgd)) {
+        return NULL;
+    }
+    if (!pgSurface_AsSurface(surface)) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+    if (!pgSurface_Check(bgd) && !PyCallable_Check(bgd)) {
+        return RAISE(PyExc_TypeError,
+                     "background must be a Surface or a callable");
+    }
+
+    /* A callable background may change the group, so recheck the bounds
+     * on every step.
+     */
+    for (i = 0; i < self->lost_length; ++i) {
+        if (_groupcore_clear_rect(surface, bgd, self->lost[i])) {
+            return NULL;
+        }
+    }
+    for (i = 0; i < self->length; ++i) {
+        if (!_rect_is_empty(self->rects + i) &&
+            _groupcore_clear_rect(surface, bgd, self->rects[i])) {
+            return NULL;
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+static Py_ssize_t
+groupcore_len(pgGroupCoreObject *self)
+{
+    return self->length;
+}
+
+static int
+groupcore_contains(pgGroupCoreObject *self, PyObject *sprite)
+{
+    return PyDict_Contains(self->index, sprite);
+}
+
+static PyMethodDef groupcore_methods[] = {
+    {"add", (PyCFunction)groupcore_add, METH_O,
+     "add(sprite) -> bool\nadd a sprite, returning False if it was already "
+     "a member"},
+    {"remove", (PyCFunction)groupcore_remove, METH_O,
+     "remove(sprite) -> None\nremove a sprite, raising KeyError if it is "
+     "not a member"},
+    {"sprites", (PyCFunction)groupcore_sprites, METH_NOARGS,
+     "sprites() -> list\nlist of the sprites in storage order"},
+    {"spritedict", (PyCFunction)groupcore_spritedict, METH_NOARGS,
+     "spritedict() -> dict\nmap each sprite to the Rect it was last drawn "
+     "at, or None"},
+    {"lostsprites", (PyCFunction)groupcore_lostsprites, METH_NOARGS,
+     "lostsprites() -> list\nareas of sprites removed since the last draw"},
+    {"update", (PyCFunction)groupcore_update, METH_VARARGS | METH_KEYWORDS,
+     "update(*args, **kwargs) -> None\ncall update() on every sprite"},
+    {"draw", (PyCFunction)groupcore_draw, METH_VARARGS | METH_KEYWORDS,
+     "draw(surface, special_flags=0) -> None\nblit every sprite image at its "
+     "rect"},
+    {"clear", (PyCFunction)groupcore_clear, METH_VARARGS,
+     "clear(surface, bgd) -> None\ndraw the background over lost and drawn "
+     "areas"},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods groupcore_as_sequence = {
+    .sq_length = (lenfunc)groupcore_len,
+    .sq_contains = (objobjproc)groupcore_contains,
+};
+
+static PyTypeObject pgGroupCore_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame._spritegroup.GroupCore",
+    .tp_basicsize = sizeof(pgGroupCoreObject),
+    .tp_dealloc = (destructor)_groupcore_dealloc,
+    .tp_as_sequence = &groupcore_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = "GroupCore() -> GroupCore\nsprite storage with O(1) add and "
+              "remove",
+    .tp_traverse = (traverseproc)_groupcore_traverse,
+    .tp_clear = (inquiry)_groupcore_clear,
+    .tp_methods = groupcore_methods,
+    .tp_new = _groupcore_new,
+};
+
+/*
+ * LayerOrder keeps sprites sorted by layer, and by insertion order within
+ * a layer, like the list LayeredUpdates used to maintain by hand. The
+ * entries live in a two level B-tree: an array of sorted blocks of up to
+ * LAYER_BLOCK_MAX entries each. Finding an entry is a binary search over
+ * the last entries of the blocks and then within one block, and adding or
+ * removing one only moves entries inside its block, so changing a layer
+ * no longer shifts the whole list.
+ */
+
+#define LAYER_BLOCK_MAX 256
+#define LAYER_BLOCK_FILL 192 /* entries per block after a rebuild */
+
+typedef struct {
+    double key;       /* layer, as a number to order by */
+    Uint64 seq;       /* orders the sprites within a layer */
+    PyObject *sprite; /* owned reference */
+    Py_ssize_t id;    /* record of the sprite */
+} pgLayerEntry;
+
+typedef struct {
+    Py_ssize_t length;
+    pgLayerEntry items[LAYER_BLOCK_MAX];
+} pgLayerBlock;
+
+typedef struct {
+    PyObject *layer; /* the layer as it was given, NULL if unused */
+    double key;
+    Uint64 seq;
+    Py_ssize_t next_free;
+} pgLayerRecord;
+
+typedef struct {
+    PyObject_HEAD pgLayerBlock **blocks;
+    Py_ssize_t nblocks;
+    Py_ssize_t blocks_capacity;
+    pgLayerBlock *spare; /* so a block can always be split */
+    Py_ssize_t length;
+    pgLayerRecord *records;
+    Py_ssize_t records_length;
+    Py_ssize_t records_capacity;
+    Py_ssize_t free_record; /* head of the unused records, or -1 */
+    Uint64 seq;
+    PyObject *index; /* dict: sprite -> record id */
+    int sorting;     /* set while resort() calls back into Python */
+} pgLayerOrderObject;
+
+static PyTypeObject pgLayerOrder_Type;
+
+#define _entry_less(e, k, s) \
+    ((e)->key < (k) || ((e)->key == (k) && (e)->seq < (s)))
+
+static int
+_layer_key(PyObject *layer, double *key)
+{
+    *key = PyFloat_AsDouble(layer);
+    if (*key == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (Py_IS_NAN(*key)) {
+        PyErr_SetString(PyExc_ValueError, "layer must not be NaN");
+        return -1;
+    }
+    return 0;
+}
+
+/* Make sure one more block can be added without failing */
+static int
+_layerorder_reserve(pgLayerOrderObject *self)
+{
+    pgLayerBlock **blocks;
+    Py_ssize_t capacity;
+
+    if (self->nblocks == self->blocks_capacity) {
+        capacity = self->blocks_capacity ? self->blocks_capacity * 2 : 4;
+        blocks =
+            PyMem_Realloc(self->blocks, sizeof(pgLayerBlock *) * capacity);
+        if (!blocks) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->blocks = blocks;
+        self->blocks_capacity = capacity;
+    }
+    if (!self->spare && !(self->spare = PyMem_Malloc(sizeof(pgLayerBlock)))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+/* Index of the first block whose last entry is not before (key, seq),
+ * or of the last block if there is none.
+ */
+static Py_ssize_t
+_layerorder_find_block(pgLayerOrderObject *self, double key, Uint64 seq)
+{
+    Py_ssize_t low = 0, high = self->nblocks - 1, mid;
+    pgLayerBlock *block;
+
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        block = self->blocks[mid];
+        if (_entry_less(block->items + block->length - 1, key, seq)) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static Py_ssize_t
+_layerblock_find(pgLayerBlock *block, double key, Uint64 seq)
+{
+    Py_ssize_t low = 0, high = block->length, mid;
+
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (_entry_less(block->items + mid, key, seq)) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Add an entry; _layerorder_reserve() must have succeeded first */
+static void
+_layerorder_insert(pgLayerOrderObject *self, const pgLayerEntry *entry)
+{
+    const Py_ssize_t half = LAYER_BLOCK_MAX / 2;
+    pgLayerBlock *block, *upper;
+    Py_ssize_t b, pos;
+
+    if (!self->nblocks) {
+        block = self->spare;
+        self->spare = NULL;
+        block->length = 0;
+        self->blocks[self->nblocks++] = block;
+    }
+    b = _layerorder_find_block(self, entry->key, entry->seq);
+    block = self->blocks[b];
+    pos = _layerblock_find(block, entry->key, entry->seq);
+    if (block->length == LAYER_BLOCK_MAX) {
+        upper = self->spare;
+        self->spare = NULL;
+        memcpy(upper->items, block->items + half,
+               sizeof(pgLayerEntry) * (LAYER_BLOCK_MAX - half));
+        upper->length = LAYER_BLOCK_MAX - half;
+        block->length = half;
+        memmove(self->blocks + b + 2, self->blocks + b + 1,
+                sizeof(pgLayerBlock *) * (self->nblocks - b - 1));
+        self->blocks[b + 1] = upper;
+        ++self->nblocks;
+        if (pos > half) {
+            block = upper;
+            pos -= half;
+        }
+    }
+    memmove(block->items + pos + 1, block->items + pos,
+            sizeof(pgLayerEntry) * (block->length - pos));
+    block->items[pos] = *entry;
+    ++block->length;
+    ++self->length;
+}
+
+/* Remove the entry for (key, seq) and return its sprite reference */
+static PyObject *
+_layerorder_take(pgLayerOrderObject *self, double key, Uint64 seq)
+{
+    Py_ssize_t b = _layerorder_find_block(self, key, seq);
+    pgLayerBlock *block = self->blocks[b];
+    Py_ssize_t pos = _layerblock_find(block, key, seq);
+    PyObject *sprite = block->items[pos].sprite;
+
+    --block->length;
+    memmove(block->items + pos, block->items + pos + 1,
+            sizeof(pgLayerEntry) * (block->length - pos));
+    --self->length;
+    if (!block->length) {
+        --self->nblocks;
+        memmove(self->blocks + b, self->blocks + b + 1,
+                sizeof(pgLayerBlock *) * (self->nblocks - b));
+        if (self->spare) {
+            PyMem_Free(block);
+        }
+        else {
+            self->spare = block;
+        }
+    }
+    return sprite;
+}
+
+static pgLayerEntry *
+_layerorder_at(pgLayerOrderObject *self, Py_ssize_t i)
+{
+    Py_ssize_t b;
+
+    if (i < self->length / 2) {
+        for (b = 0; i >= self->blocks[b]->length; ++b) {
+            i -= self->blocks[b]->length;
+        }
+    }
+    else {
+        i = self->length - i;
+        for (b = self->nblocks - 1; i > self->blocks[b]->length; --b) {
+            i -= self->blocks[b]->length;
+        }
+        i = self->blocks[b]->length - i;
+    }
+    return self->blocks[b]->items + i;
+}
+
+static Py_ssize_t
+_layerorder_record(pgLayerOrderObject *self, PyObject *sprite)
+{
+    PyObject *id = PyDict_GetItemWithError(self->index, sprite);
+
+    if (!id) {
+        return -1;
+    }
+    return PyLong_AsSsize_t(id);
+}
+
+static Py_ssize_t
+_layerorder_new_record(pgLayerOrderObject *self)
+{
+    pgLayerRecord *records;
+    Py_ssize_t id, capacity;
+
+    if (self->free_record >= 0) {
+        id = self->free_record;
+        self->free_record = self->records[id].next_free;
+        return id;
+    }
+    if (self->records_length == self->records_capacity) {
+        capacity = self->records_capacity ? self->records_capacity * 2 : 16;
+        records =
+            PyMem_Realloc(self->records, sizeof(pgLayerRecord) * capacity);
+        if (!records) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->records = records;
+        self->records_capacity = capacity;
+    }
+    self->records[self->records_length].layer = NULL;
+    return self->records_length++;
+}
+
+static void
+_layerorder_free_record(pgLayerOrderObject *self, Py_ssize_t id)
+{
+    Py_CLEAR(self->records[id].layer);
+    self->records[id].next_free = self->free_record;
+    self->free_record = id;
+}
+
+static int
+_layerorder_check_sorting(pgLayerOrderObject *self)
+{
+    if (self->sorting) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "sprite layers changed during resort()");
+        return -1;
+    }
+    return 0;
+}
+
+/* Put sprite at the top of layer, adding it if add is set */
+static int
+_layerorder_place(pgLayerOrderObject *self, PyObject *sprite,
+                  PyObject *layer, int add)
+{
+    pgLayerEntry entry;
+    pgLayerRecord *record;
+    PyObject *id;
+    double key;
+
+    if (_layerorder_check_sorting(self) || _layer_key(layer, &key) ||
+        _layerorder_reserve(self)) {
+        return -1;
+    }
+    entry.id = _layerorder_record(self, sprite);
+    if (entry.id >= 0) {
+        record = self->records + entry.id;
+        entry.sprite = _layerorder_take(self, record->key, record->seq);
+    }
+    else if (PyErr_Occurred()) {
+        return -1;
+    }
+    else if (!add) {
+        PyErr_SetObject(PyExc_KeyError, sprite);
+        return -1;
+    }
+    else {
+        if ((entry.id = _layerorder_new_record(self)) < 0) {
+            return -1;
+        }
+        if (!(id = PyLong_FromSsize_t(entry.id)) ||
+            PyDict_SetItem(self->index, sprite, id)) {
+            Py_XDECREF(id);
+            _layerorder_free_record(self, entry.id);
+            return -1;
+        }
+        Py_DECREF(id);
+        Py_INCREF(sprite);
+        entry.sprite = sprite;
+        record = self->records + entry.id;
+    }
+    Py_INCREF(layer);
+    Py_XSETREF(record->layer, layer);
+    record->key = entry.key = key;
+    record->seq = entry.seq = ++self->seq;
+    /* the reserve covers this insert, even if taking freed a block */
+    _layerorder_insert(self, &entry);
+    return 0;
+}
+
+/* Stable sort by key. Runs that are already in order are found and merged
+ * pairwise, so nearly sorted input costs about one pass per doubling of
+ * the runs. Returns whichever of entries and buffer holds the result.
+ */
+static pgLayerEntry *
+_layer_sort(pgLayerEntry *entries, pgLayerEntry *buffer, Py_ssize_t length)
+{
+    pgLayerEntry *src = entries, *dst = buffer, *swap;
+    Py_ssize_t low, mid, high, i, j, k;
+
+    if (length < 2) {
+        return entries;
+    }
+    for (;;) {
+        low = 0;
+        while (low < length) {
+            mid = low + 1;
+            while (mid < length && src[mid - 1].key <= src[mid].key) {
+                ++mid;
+            }
+            if (mid == length) {
+                if (!low) {
+                    return src;
+                }
+                memcpy(dst + low, src + low,
+                       sizeof(pgLayerEntry) * (length - low));
+                break;
+            }
+            high = mid + 1;
+            while (high < length && src[high - 1].key <= src[high].key) {
+                ++high;
+            }
+            i = low;
+            j = mid;
+            k = low;
+            while (i < mid && j < high) {
+                dst[k++] = src[j].key < src[i].key ? src[j++] : src[i++];
+            }
+            while (i < mid) {
+                dst[k++] = src[i++];
+            }
+            while (j < high) {
+                dst[k++] = src[j++];
+            }
+            low = high;
+        }
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+}
+
+static PyObject *
+_layerorder_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    pgLayerOrderObject *self = (pgLayerOrderObject *)type->tp_alloc(type, 0);
+
+    if (!self) {
+        return NULL;
+    }
+    self->free_record = -1;
+    self->index = PyDict_New();
+    if (!self->index) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+static int
+_layerorder_clear(pgLayerOrderObject *self)
+{
+    pgLayerBlock **blocks = self->blocks;
+    pgLayerRecord *records = self->records;
+    Py_ssize_t nblocks = self->nblocks;
+    Py_ssize_t records_length = self->records_length;
+    Py_ssize_t b, i;
+
+    self->blocks = NULL;
+    self->nblocks = self->blocks_capacity = self->length = 0;
+    self->records = NULL;
+    self->records_length = self->records_capacity = 0;
+    self->free_record = -1;
+    Py_CLEAR(self->index);
+    for (b = 0; b < nblocks; ++b) {
+        for (i = 0; i < blocks[b]->length; ++i) {
+            Py_DECREF(blocks[b]->items[i].sprite);
+        }
+        PyMem_Free(blocks[b]);
+    }
+    PyMem_Free(blocks);
+    for (i = 0; i < records_length; ++i) {
+        Py_XDECREF(records[i].layer);
+    }
+    PyMem_Free(records);
+    return 0;
+}
+
+static int
+_layerorder_traverse(pgLayerOrderObject *self, visitproc visit, void *arg)
+{
+    Py_ssize_t b, i;
+
+    Py_VISIT(self->index);
+    for (b = 0; b < self->nblocks; ++b) {
+        for (i = 0; i < self->blocks[b]->length; ++i) {
+            Py_VISIT(self->blocks[b]->items[i].sprite);
+        }
+    }
+    for (i = 0; i < self->records_length; ++i) {
+        Py_VISIT(self->records[i].layer);
+    }
+    return 0;
+}
+
+static void
+_layerorder_dealloc(pgLayerOrderObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    _layerorder_clear(self);
+    PyMem_Free(self->spare);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+layerorder_add(pgLayerOrderObject *self, PyObject *args)
+{
+    PyObject *sprite, *layer;
+
+    if (!PyArg_ParseTuple(args, "OO", &sprite, &layer) ||
+        _layerorder_place(self, sprite, layer, 1)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+layerorder_move(pgLayerOrderObject *self, PyObject *args)
+{
+    PyObject *sprite, *layer;
+
+    if (!PyArg_ParseTuple(args, "OO", &sprite, &layer) ||
+        _layerorder_place(self, sprite, layer, 0)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+layerorder_remove(pgLayerOrderObject *self, PyObject *sprite)
+{
+    Py_ssize_t id;
+    PyObject *taken;
+
+    if (_layerorder_check_sorting(self)) {
+        return NULL;
+    }
+    if ((id = _layerorder_record(self, sprite)) < 0) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetObject(PyExc_KeyError, sprite);
+        }
+        return NULL;
+    }
+    if (PyDict_DelItem(self->index, sprite)) {
+        return NULL;
+    }
+    taken = _layerorder_take(self, self->records[id].key,
+                             self->records[id].seq);
+    _layerorder_free_record(self, id);
+    Py_DECREF(taken);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+layerorder_sprites(pgLayerOrderObject *self, PyObject *_null)
+{
+    PyObject *list = PyList_New(self->length);
+    Py_ssize_t b, i, k = 0;
+
+    if (!list) {
+        return NULL;
+    }
+    for (b = 0; b < self->nblocks; ++b) {
+        for (i = 0; i < self->blocks[b]->length; ++i) {
+            Py_INCREF(self->blocks[b]->items[i].sprite);
+            PyList_SET_ITEM(list, k++, self->blocks[b]->items[i].sprite);
+        }
+    }
+    return list;
+}
+
+static PyObject *
+layerorder_layer_of(pgLayerOrderObject *self, PyObject *args)
+{
+    PyObject *sprite, *dflt = NULL;
+    Py_ssize_t id;
+
+    if (!PyArg_ParseTuple(args, "O|O", &sprite, &dflt)) {
+        return NULL;
+    }
+    if ((id = _layerorder_record(self, sprite)) >= 0) {
+        Py_INCREF(self->records[id].layer);
+        return self->records[id].layer;
+    }
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    if (!dflt) {
+        PyErr_SetObject(PyExc_KeyError, sprite);
+        return NULL;
+    }
+    Py_INCREF(dflt);
+    return dflt;
+}
+
+static PyObject *
+layerorder_layers(pgLayerOrderObject *self, PyObject *_null)
+{
+    PyObject *list = PyList_New(0);
+    pgLayerEntry *entry;
+    Py_ssize_t b, i;
+    double last = 0.0;
+
+    if (!list) {
+        return NULL;
+    }
+    for (b = 0; b < self->nblocks; ++b) {
+        for (i = 0; i < self->blocks[b]->length; ++i) {
+            entry = self->blocks[b]->items + i;
+            if ((b || i) && entry->key == last) {
+                continue;
+            }
+            last = entry->key;
+            if (PyList_Append(list, self->records[entry->id].layer)) {
+                Py_DECREF(list);
+                return NULL;
+            }
+        }
+    }
+    return list;
+}
+
+static PyObject *
+layerorder_layer_dict(pgLayerOrderObject *self, PyObject *_null)
+{
+    PyObject *dict = PyDict_New();
+    pgLayerEntry *entry;
+    Py_ssize_t b, i;
+
+    if (!dict) {
+        return NULL;
+    }
+    for (b = 0; b < self->nblocks; ++b) {
+        for (i = 0; i < self->blocks[b]->length; ++i) {
+            entry = self->blocks[b]->items + i;
+            if (PyDict_SetItem(dict, entry->sprite,
+                               self->records[entry->id].layer)) {
+                Py_DECREF(dict);
+                return NULL;
+            }
+        }
+    }
+    return dict;
+}
+
+static PyObject *
+layerorder_from_layer(pgLayerOrderObject *self, PyObject *layer)
+{
+    PyObject *list;
+    pgLayerBlock *block;
+    Py_ssize_t b, i;
+    double key;
+
+    if (_layer_key(layer, &key) || !(list = PyList_New(0))) {
+        return NULL;
+    }
+    if (!self->nblocks) {
+        return list;
+    }
+    b = _layerorder_find_block(self, key, 0);
+    i = _layerblock_find(self->blocks[b], key, 0);
+    for (; b < self->nblocks; ++b, i = 0) {
+        block = self->blocks[b];
+        for (; i < block->length && block->items[i].key == key; ++i) {
+            if (PyList_Append(list, block->items[i].sprite)) {
+                Py_DECREF(list);
+                return NULL;
+            }
+        }
+        if (i < block->length) {
+            break;
+        }
+    }
+    return list;
+}
+
+/* Set attr of every sprite that has it to its new layer. If that fails,
+ * put back the values set so far, so that no sprite is left changed.
+ */
+static int
+_layerorder_set_attrs(pgLayerEntry *entries, PyObject **layers,
+                      Py_ssize_t length, PyObject *attr)
+{
+    PyObject **old = PyMem_New(PyObject *, length + 1);
+    PyObject *type, *value, *traceback;
+    Py_ssize_t k, i, set;
+
+    if (!old) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (k = 0; k < length; ++k) {
+        if (!PyObject_HasAttr(entries[k].sprite, attr)) {
+            old[k] = NULL;
+            continue;
+        }
+        old[k] = PyObject_GetAttr(entries[k].sprite, attr);
+        if (!old[k] ||
+            PyObject_SetAttr(entries[k].sprite, attr, layers[k])) {
+            break;
+        }
+    }
+    set = k;
+    if (set < length) {
+        PyErr_Fetch(&type, &value, &traceback);
+        for (i = set - 1; i >= 0; --i) {
+            if (old[i] && PyObject_SetAttr(entries[i].sprite, attr, old[i])) {
+                PyErr_Clear();
+            }
+        }
+        PyErr_Restore(type, value, traceback);
+        Py_XDECREF(old[set]);
+    }
+    for (i = 0; i < set; ++i) {
+        Py_XDECREF(old[i]);
+    }
+    PyMem_Free(old);
+    return set < length ? -1 : 0;
+}
+
+static PyObject *
+layerorder_resort(pgLayerOrderObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *key, *attr = Py_None, **layers = NULL;
+    pgLayerEntry *entries = NULL, *sorted;
+    pgLayerBlock **blocks = NULL;
+    pgLayerRecord *record;
+    Py_ssize_t length = self->length, nblocks, b, i, k = 0;
+    static char *keywords[] = {"key", "attr", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", keywords, &key,
+                                     &attr)) {
+        return NULL;
+    }
+    if (_layerorder_check_sorting(self)) {
+        return NULL;
+    }
+    if (attr != Py_None && !PyUnicode_Check(attr)) {
+        return RAISE(PyExc_TypeError, "attr must be a string or None");
+    }
+
+    nblocks = (length + LAYER_BLOCK_FILL - 1) / LAYER_BLOCK_FILL;
+    entries = PyMem_New(pgLayerEntry, 2 * length + 1);
+    layers = PyMem_New(PyObject *, length + 1);
+    blocks = PyMem_New(pgLayerBlock *, nblocks + 1);
+    if (!entries || !layers || !blocks) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    for (b = 0; b < nblocks; ++b) {
+        blocks[b] = NULL;
+    }
+    for (b = 0; b < nblocks; ++b) {
+        blocks[b] = b < self->nblocks ? self->blocks[b]
+                                      : PyMem_Malloc(sizeof(pgLayerBlock));
+        if (!blocks[b]) {
+            PyErr_NoMemory();
+            goto error;
+        }
+    }
+    for (b = 0; b < self->nblocks; ++b) {
+        memcpy(entries + k, self->blocks[b]->items,
+               sizeof(pgLayerEntry) * self->blocks[b]->length);
+        k += self->blocks[b]->length;
+    }
+
+    /* Calling key or setting attr may run any Python code, so hold
+     * references and refuse changes to the order until the new layers are
+     * all known and set. Every key is called before any attr is set, and
+     * the attrs already set are put back if one of them fails.
+     */
+    self->sorting = 1;
+    for (k = 0; k < length; ++k) {
+        Py_INCREF(entries[k].sprite);
+    }
+    for (k = 0; k < length; ++k) {
+        layers[k] =
+            PyObject_CallFunctionObjArgs(key, entries[k].sprite, NULL);
+        if (!layers[k] || _layer_key(layers[k], &entries[k].key)) {
+            Py_XDECREF(layers[k]);
+            break;
+        }
+    }
+    if (k == length && attr != Py_None &&
+        _layerorder_set_attrs(entries, layers, length, attr)) {
+        k = -1;
+    }
+    self->sorting = 0;
+    for (i = 0; i < length; ++i) {
+        Py_DECREF(entries[i].sprite);
+    }
+    if (k < length) {
+        if (k < 0) {
+            k = length;
+        }
+        while (k--) {
+            Py_DECREF(layers[k]);
+        }
+        goto error;
+    }
+
+    for (k = 0; k < length; ++k) {
+        record = self->records + entries[k].id;
+        Py_XSETREF(record->layer, layers[k]);
+    }
+    sorted = _layer_sort(entries, entries + length, length);
+    for (k = 0; k < length; ++k) {
+        record = self->records + sorted[k].id;
+        record->key = sorted[k].key;
+        record->seq = sorted[k].seq = ++self->seq;
+    }
+    for (b = nblocks; b < self->nblocks; ++b) {
+        PyMem_Free(self->blocks[b]);
+    }
+    for (b = 0, k = 0; b < nblocks; ++b, k += LAYER_BLOCK_FILL) {
+        blocks[b]->length = Py_MIN(LAYER_BLOCK_FILL, length - k);
+        memcpy(blocks[b]->items, sorted + k,
+               sizeof(pgLayerEntry) * blocks[b]->length);
+    }
+    PyMem_Free(self->blocks);
+    self->blocks = blocks;
+    self->nblocks = nblocks;
+    self->blocks_capacity = nblocks + 1;
+    PyMem_Free(entries);
+    PyMem_Free(layers);
+    Py_RETURN_NONE;
+
+error:
+    if (blocks) {
+        for (b = self->nblocks; b < nblocks; ++b) {
+            PyMem_Free(blocks[b]);
+        }
+    }
+    PyMem_Free(blocks);
+    PyMem_Free(entries);
+    PyMem_Free(layers);
+    return NULL;
+}
+
+static PyObject *
+layerorder_iter(pgLayerOrderObject *self)
+{
+    PyObject *list = layerorder_sprites(self, NULL);
+    PyObject *iter;
+
+    if (!list) {
+        return NULL;
+    }
+    iter = PyObject_GetIter(list);
+    Py_DECREF(list);
+    return iter;
+}
+
+static Py_ssize_t
+layerorder_len(pgLayerOrderObject *self)
+{
+    return self->length;
+}
+
+static PyObject *
+layerorder_item(pgLayerOrderObject *self, Py_ssize_t i)
+{
+    pgLayerEntry *entry;
+
+    if (i < 0 || i >= self->length) {
+        return RAISE(PyExc_IndexError, "sprite index out of range");
+    }
+    entry = _layerorder_at(self, i);
+    Py_INCREF(entry->sprite);
+    return entry->sprite;
+}
+
+static PyObject *
+layerorder_subscript(pgLayerOrderObject *self, PyObject *item)
+{
+    PyObject *list, *result;
+    Py_ssize_t i;
+
+    if (PyIndex_Check(item)) {
+        i = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (i == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        return layerorder_item(self, i < 0 ? i + self->length : i);
+    }
+    /* Slices copy the sprites, as slicing the list they used to be in did */
+    list = layerorder_sprites(self, NULL);
+    if (!list) {
+        return NULL;
+    }
+    result = PyObject_GetItem(list, item);
+    Py_DECREF(list);
+    return result;
+}
+
+static int
+layerorder_contains(pgLayerOrderObject *self, PyObject *sprite)
+{
+    return PyDict_Contains(self->index, sprite);
+}
+
+static PyMethodDef layerorder_methods[] = {
+    {"add", (PyCFunction)layerorder_add, METH_VARARGS,
+     "add(sprite, layer) -> None\nput a sprite on top of a layer, adding it "
+     "if needed"},
+    {"move", (PyCFunction)layerorder_move, METH_VARARGS,
+     "move(sprite, layer) -> None\nput a sprite that is already here on top "
+     "of a layer"},
+    {"remove", (PyCFunction)layerorder_remove, METH_O,
+     "remove(sprite) -> None\nremove a sprite, raising KeyError if it is "
+     "not here"},
+    {"sprites", (PyCFunction)layerorder_sprites, METH_NOARGS,
+     "sprites() -> list\nthe sprites from the bottom to the top"},
+    {"layer_of", (PyCFunction)layerorder_layer_of, METH_VARARGS,
+     "layer_of(sprite[, default]) -> layer\nthe layer of a sprite"},
+    {"layers", (PyCFunction)layerorder_layers, METH_NOARGS,
+     "layers() -> list\nthe layers in use, from the bottom up"},
+    {"layer_dict", (PyCFunction)layerorder_layer_dict, METH_NOARGS,
+     "layer_dict() -> dict\nmap each sprite to its layer"},
+    {"from_layer", (PyCFunction)layerorder_from_layer, METH_O,
+     "from_layer(layer) -> list\nthe sprites of one layer, in order"},
+    {"resort", (PyCFunction)layerorder_resort, METH_VARARGS | METH_KEYWORDS,
+     "resort(key, attr=None) -> None\nset every layer to key(sprite) and "
+     "reorder, keeping the order of equal layers"},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods layerorder_as_sequence = {
+    .sq_length = (lenfunc)layerorder_len,
+    .sq_item = (ssizeargfunc)layerorder_item,
+    .sq_contains = (objobjproc)layerorder_contains,
+};
+
+static PyMappingMethods layerorder_as_mapping = {
+    .mp_length = (lenfunc)layerorder_len,
+    .mp_subscript = (binaryfunc)layerorder_subscript,
+};
+
+static PyTypeObject pgLayerOrder_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame._spritegroup.LayerOrder",
+    .tp_basicsize = sizeof(pgLayerOrderObject),
+    .tp_dealloc = (destructor)_layerorder_dealloc,
+    .tp_as_sequence = &layerorder_as_sequence,
+    .tp_as_mapping = &layerorder_as_mapping,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = "LayerOrder() -> LayerOrder\nsprites ordered by layer and by "
+              "insertion within a layer",
+    .tp_traverse = (traverseproc)_layerorder_traverse,
+    .tp_clear = (inquiry)_layerorder_clear,
+    .tp_iter = (getiterfunc)layerorder_iter,
+    .tp_methods = layerorder_methods,
+    .tp_new = _layerorder_new,
+};
+
+/*
+ * draw_dirty() does the drawing of LayeredDirty. It reads the attributes
+ * of every sprite once, and then works out the area to repaint, the
+ * sprites that cannot be seen and every blit without going back to
+ * Python.
+ *
+ * The area to repaint is kept as a region: rects that do not overlap,
+ * where rects that overlap are merged into their bounding box. The rects
+ * are merged in one sort and sweep over all of them instead of comparing
+ * every new rect against the list.
+ *
+ * A sprite with an opaque image, blitted without special flags, replaces
+ * everything under it. A sprite, or part of the background, that lies
+ * entirely under one of the OCCLUDER_MAX largest such sprites above it is
+ * not drawn at all.
+ */
+
+#define OCCLUDER_MAX 16
+
+typedef struct {
+    SDL_Rect *rects;
+    Py_ssize_t length;
+    Py_ssize_t capacity;
+} pgRegion;
+
+typedef struct {
+    SDL_Rect rect;
+    Sint64 size;
+    int covers; /* paints all of rect, not only the part in the region */
+} pgOccluder;
+
+typedef struct {
+    PyObject *sprite;
+    PyObject *image;  /* NULL when the sprite is not drawn */
+    SDL_Rect rect;    /* rect.topleft with the source_rect size */
+    SDL_Rect area;    /* source_rect, or all of the image */
+    SDL_Rect paint;   /* part of the surface the sprite paints */
+    SDL_Rect drawn;   /* area drawn, as the blit returned it */
+    long dirty;
+    int flags;
+    int opaque;
+    int covers; /* paints all of paint, not only the part in the region */
+    int inside; /* paint lies inside the region */
+    int hidden;
+} pgDirtyEntry;
+
+static int
+_rect_intersect(const SDL_Rect *a, const SDL_Rect *b, SDL_Rect *result)
+{
+    int x = MAX(a->x, b->x);
+    int y = MAX(a->y, b->y);
+    int w = MIN(a->x + a->w, b->x + b->w) - x;
+    int h = MIN(a->y + a->h, b->y + b->h) - y;
+
+    if (w <= 0 || h <= 0) {
+        result->x = a->x;
+        result->y = a->y;
+        result->w = result->h = 0;
+        return 0;
+    }
+    result->x = x;
+    result->y = y;
+    result->w = w;
+    result->h = h;
+    return 1;
+}
+
+static int
+_rect_contains(const SDL_Rect *outer, const SDL_Rect *inner)
+{
+    return inner->x >= outer->x && inner->y >= outer->y &&
+           inner->x + inner->w <= outer->x + outer->w &&
+           inner->y + inner->h <= outer->y + outer->h;
+}
+
+static void
+_rect_union(SDL_Rect *a, const SDL_Rect *b)
+{
+    int x = MIN(a->x, b->x);
+    int y = MIN(a->y, b->y);
+
+    a->w = MAX(a->x + a->w, b->x + b->w) - x;
+    a->h = MAX(a->y + a->h, b->y + b->h) - y;
+    a->x = x;
+    a->y = y;
+}
+
+static int
+_region_add(pgRegion *region, const SDL_Rect *rect, const SDL_Rect *clip)
+{
+    SDL_Rect *rects;
+    Py_ssize_t capacity;
+
+    if (region->length == region->capacity) {
+        capacity = region->capacity ? region->capacity * 2 : 64;
+        rects = PyMem_Resize(region->rects, SDL_Rect, capacity);
+        if (!rects) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        region->rects = rects;
+        region->capacity = capacity;
+    }
+    if (_rect_intersect(rect, clip, region->rects + region->length)) {
+        ++region->length;
+    }
+    return 0;
+}
+
+static int
+_region_compare_x(const void *a, const void *b)
+{
+    int xa = ((const SDL_Rect *)a)->x, xb = ((const SDL_Rect *)b)->x;
+
+    return (xa > xb) - (xa < xb);
+}
+
+static int
+_rects_overlap(const SDL_Rect *a, const SDL_Rect *b)
+{
+    return a->x < b->x + b->w && b->x < a->x + a->w && a->y < b->y + b->h &&
+           b->y < a->y + a->h;
+}
+
+/* Merge every group of overlapping rects into its bounding box, until no
+ * two rects overlap. The rects end up sorted by x.
+ */
+static int
+_region_coalesce(pgRegion *region)
+{
+    SDL_Rect *rects = region->rects, box;
+    Py_ssize_t *active;
+    Py_ssize_t i, j, a, length, nactive, nboxes;
+    int merged = 1, grew;
+
+    if (region->length < 2) {
+        return 0;
+    }
+    if (!(active = PyMem_New(Py_ssize_t, region->length))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    while (merged) {
+        merged = 0;
+        length = region->length;
+        qsort(rects, length, sizeof(SDL_Rect), _region_compare_x);
+
+        /* Sweep from left to right, growing a box from every rect. The
+         * active boxes are the ones that reach past the left edge of the
+         * current rect; a box that overlaps them swallows them. When many
+         * rects overlap there are only a few large active boxes, so this
+         * stays close to linear. Growing to the left can make a box
+         * overlap one that is no longer active, so sweep again until
+         * nothing merges.
+         */
+        nactive = nboxes = 0;
+        for (i = 0; i < length; ++i) {
+            box = rects[i];
+            for (j = 0; j < nactive;) {
+                a = active[j];
+                if (rects[a].x + rects[a].w <= box.x) {
+                    active[j] = active[--nactive];
+                }
+                else {
+                    ++j;
+                }
+            }
+            do {
+                grew = 0;
+                for (j = 0; j < nactive;) {
+                    a = active[j];
+                    if (_rects_overlap(rects + a, &box)) {
+                        _rect_union(&box, rects + a);
+                        rects[a].w = 0;
+                        active[j] = active[--nactive];
+                        grew = merged = 1;
+                    }
+                    else {
+                        ++j;
+                    }
+                }
+            } while (grew);
+            /* rects[i] has been read, and nboxes <= i */
+            rects[nboxes] = box;
+            active[nactive++] = nboxes++;
+        }
+
+        /* drop the boxes that were swallowed */
+        for (i = j = 0; i < nboxes; ++i) {
+            if (rects[i].w) {
+                rects[j++] = rects[i];
+            }
+        }
+        region->length = j;
+    }
+    PyMem_Free(active);
+    return 0;
+}
+
+static int
+_occluders_hide(const pgOccluder *occluders, int count, const SDL_Rect *rect,
+                int inside)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        if ((inside || occluders[i].covers) &&
+            _rect_contains(&occluders[i].rect, rect)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Keep the OCCLUDER_MAX largest occluders. */
+static void
+_occluders_add(pgOccluder *occluders, int *count, const SDL_Rect *rect,
+               int covers)
+{
+    Sint64 size = (Sint64)rect->w * rect->h;
+    int i, smallest = 0;
+
+    if (*count < OCCLUDER_MAX) {
+        smallest = (*count)++;
+    }
+    else {
+        for (i = 1; i < OCCLUDER_MAX; ++i) {
+            if (occluders[i].size < occluders[smallest].size) {
+                smallest = i;
+            }
+        }
+        if (occluders[smallest].size >= size) {
+            return;
+        }
+    }
+    occluders[smallest].rect = *rect;
+    occluders[smallest].size = size;
+    occluders[smallest].covers = covers;
+}
+
+/* Whether blitting surf without special flags replaces the pixels under
+ * it.
+ */
+static int
+_surface_is_opaque(SDL_Surface *surf)
+{
+    Uint32 colorkey;
+    Uint8 alpha;
+    SDL_BlendMode mode;
+
+    if (SDL_GetColorKey(surf, &colorkey) == 0 ||
+        SDL_GetSurfaceBlendMode(surf, &mode) != 0) {
+        return 0;
+    }
+    if (mode == SDL_BLENDMODE_NONE) {
+        return 1;
+    }
+    if (mode != SDL_BLENDMODE_BLEND || surf->format->Amask ||
+        SDL_GetSurfaceAlphaMod(surf, &alpha) != 0) {
+        return 0;
+    }
+    return alpha == 255;
+}
+
+static long
+_sprite_long_attr(PyObject *sprite, PyObject *name)
+{
+    PyObject *value;
+    long result;
+
+    if (!(value = PyObject_GetAttr(sprite, name))) {
+        return -1;
+    }
+    result = PyLong_AsLong(value);
+    Py_DECREF(value);
+    return result;
+}
+
+/* Read what draw_dirty needs to know about a sprite into entry. The image
+ * is only fetched when the sprite is visible.
+ */
+static int
+_dirty_read_sprite(pgDirtyEntry *entry, int update)
+{
+    PyObject *sprite = entry->sprite, *obj;
+    SDL_Surface *src = NULL;
+    SDL_Rect temp, *rect;
+    int visible;
+
+    entry->dirty = 1;
+    if (update) {
+        entry->dirty = _sprite_long_attr(sprite, str_dirty);
+        if (entry->dirty == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+    }
+    if (!(obj = PyObject_GetAttr(sprite, str_visible))) {
+        return -1;
+    }
+    visible = PyObject_IsTrue(obj);
+    Py_DECREF(obj);
+    if (visible < 0) {
+        return -1;
+    }
+    if (!visible && entry->dirty < 1) {
+        /* Not drawn, and it does not change the dirty area either. */
+        return 0;
+    }
+
+    if (visible) {
+        if (!(obj = PyObject_GetAttr(sprite, str_image))) {
+            return -1;
+        }
+        entry->image = obj;
+        if (!pgSurface_Check(obj)) {
+            PyErr_SetString(PyExc_TypeError, "sprite image must be a Surface");
+            return -1;
+        }
+        if (!(src = pgSurface_AsSurface(obj))) {
+            PyErr_SetString(pgExc_SDLError, "display Surface quit");
+            return -1;
+        }
+        entry->flags = (int)_sprite_long_attr(sprite, str_blendmode);
+        if (entry->flags == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        entry->opaque = !entry->flags && _surface_is_opaque(src);
+    }
+
+    if (!(obj = PyObject_GetAttr(sprite, str_rect))) {
+        return -1;
+    }
+    if ((rect = pgRect_FromObject(obj, &temp))) {
+        entry->rect = *rect;
+    }
+    else if (pg_TwoIntsFromObj(obj, &entry->rect.x, &entry->rect.y)) {
+        entry->rect.w = src ? src->w : 0;
+        entry->rect.h = src ? src->h : 0;
+    }
+    else {
+        Py_DECREF(obj);
+        PyErr_SetString(PyExc_TypeError, "sprite rect must be a Rect");
+        return -1;
+    }
+    Py_DECREF(obj);
+
+    if (!(obj = PyObject_GetAttr(sprite, str_source_rect))) {
+        return -1;
+    }
+    if (obj != Py_None) {
+        if (!(rect = pgRect_FromObject(obj, &temp))) {
+            Py_DECREF(obj);
+            PyErr_SetString(PyExc_TypeError,
+                            "sprite source_rect must be a Rect or None");
+            return -1;
+        }
+        entry->area = *rect;
+        entry->rect.w = rect->w;
+        entry->rect.h = rect->h;
+    }
+    else {
+        entry->area.x = entry->area.y = 0;
+        entry->area.w = src ? src->w : 0;
+        entry->area.h = src ? src->h : 0;
+    }
+    Py_DECREF(obj);
+    return 0;
+}
+
+/* Work out the part of the surface a visible sprite paints. A sprite that
+ * is not dirty only repaints the part of its rect inside the region.
+ */
+static void
+_dirty_paint_area(pgDirtyEntry *entry, const SDL_Rect *clip, int update)
+{
+    SDL_Surface *src = pgSurface_AsSurface(entry->image);
+    SDL_Rect image, blit;
+
+    image.x = entry->rect.x - entry->area.x;
+    image.y = entry->rect.y - entry->area.y;
+    image.w = src->w;
+    image.h = src->h;
+
+    if (update && entry->dirty < 1) {
+        blit = entry->rect;
+    }
+    else {
+        blit.x = entry->rect.x;
+        blit.y = entry->rect.y;
+        blit.w = entry->area.w;
+        blit.h = entry->area.h;
+    }
+    _rect_intersect(&blit, &image, &blit);
+    _rect_intersect(&blit, clip, &entry->paint);
+
+    entry->covers = !update || entry->dirty > 0;
+    entry->inside = !entry->covers || _rect_contains(&entry->rect, &blit);
+}
+
+static PyObject *
+_dirty_rect_list(const SDL_Rect *rects, Py_ssize_t length)
+{
+    PyObject *list, *rect;
+    Py_ssize_t i;
+
+    if (!(list = PyList_New(length))) {
+        return NULL;
+    }
+    for (i = 0; i < length; ++i) {
+        if (!(rect = pgRect_New((SDL_Rect *)rects + i))) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, rect);
+    }
+    return list;
+}
+
+static int
+_dirty_blit(PyObject *surface, PyObject *image, SDL_Rect *dest,
+            SDL_Rect *area, int flags)
+{
+    return pgSurface_Blit((pgSurfaceObject *)surface, (pgSurfaceObject *)image,
+                          dest, area, flags)
+               ? -1
+               : 0;
+}
+
+static int
+_dirty_draw_entries(PyObject *surface, pgDirtyEntry *entries, Py_ssize_t n,
+                    const pgRegion *region, int update)
+{
+    pgDirtyEntry *entry;
+    SDL_Rect dest, area, part;
+    const SDL_Rect *r, *end = region->rects + region->length;
+    Py_ssize_t i;
+
+    for (i = 0; i < n; ++i) {
+        entry = entries + i;
+        if (!entry->image) {
+            continue;
+        }
+        if (!update || entry->dirty > 0) {
+            if (entry->hidden) {
+                entry->drawn = entry->paint;
+                continue;
+            }
+            entry->drawn.x = entry->rect.x;
+            entry->drawn.y = entry->rect.y;
+            area = entry->area;
+            if (_dirty_blit(surface, entry->image, &entry->drawn, &area,
+                            entry->flags)) {
+                return -1;
+            }
+            continue;
+        }
+        if (entry->hidden) {
+            continue;
+        }
+        /* The region is sorted by x, so stop at the first rect that starts
+         * right of the sprite.
+         */
+        for (r = region->rects;
+             r < end && r->x < entry->rect.x + entry->rect.w; ++r) {
+            if (!_rect_intersect(&entry->rect, r, &part)) {
+                continue;
+            }
+            dest = part;
+            area.x = part.x + entry->area.x - entry->rect.x;
+            area.y = part.y + entry->area.y - entry->rect.y;
+            area.w = part.w;
+            area.h = part.h;
+            if (_dirty_blit(surface, entry->image, &dest, &area,
+                            entry->flags)) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static PyObject *
+_spritegroup_draw_dirty(PyObject *self, PyObject *args)
+{
+    PyObject *surface, *sprites, *spritedict, *lost, *bgd, *init_rect;
+    PyObject *seq, *lostseq = NULL, *old, *rectobj, *zero, *result = NULL;
+    pgDirtyEntry *entries = NULL, *entry;
+    pgRegion region = {NULL, 0, 0};
+    pgOccluder occluders[OCCLUDER_MAX];
+    SDL_Surface *surf, *bgdsurf;
+    SDL_Rect clip, temp, *rect, dest, area;
+    Py_ssize_t i, n = 0;
+    int update, noccluders = 0;
+
+    if (!PyArg_ParseTuple(args, "O!OO!OOOp", &pgSurface_Type, &surface,
+                          &sprites, &PyDict_Type, &spritedict, &lost, &bgd,
+                          &init_rect, &update)) {
+        return NULL;
+    }
+    if (!(surf = pgSurface_AsSurface(surface))) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+    if (bgd != Py_None && !pgSurface_Check(bgd)) {
+        return RAISE(PyExc_TypeError, "background must be a Surface or None");
+    }
+    SDL_GetClipRect(surf, &clip);
+
+    if (!(zero = PyLong_FromLong(0))) {
+        return NULL;
+    }
+    if (!(seq = PySequence_Fast(sprites, "sprites must be a sequence"))) {
+        Py_DECREF(zero);
+        return NULL;
+    }
+    n = PySequence_Fast_GET_SIZE(seq);
+    if (n && !(entries = PyMem_New(pgDirtyEntry, n))) {
+        PyErr_NoMemory();
+        goto end;
+    }
+    for (i = 0; i < n; ++i) {
+        memset(entries + i, 0, sizeof(pgDirtyEntry));
+        entries[i].sprite = PySequence_Fast_GET_ITEM(seq, i);
+        Py_INCREF(entries[i].sprite);
+    }
+
+    /* 1. read the sprites, and collect the dirty area */
+    if (update) {
+        if (!(lostseq = PySequence_Fast(lost, "lost must be a sequence"))) {
+            goto end;
+        }
+        for (i = 0; i < PySequence_Fast_GET_SIZE(lostseq); ++i) {
+            rect = pgRect_FromObject(PySequence_Fast_GET_ITEM(lostseq, i),
+                                     &temp);
+            if (!rect) {
+                PyErr_SetString(PyExc_TypeError, "lost area must be a Rect");
+                goto end;
+            }
+            if (_region_add(&region, rect, &clip)) {
+                goto end;
+            }
+        }
+    }
+    for (i = 0; i < n; ++i) {
+        entry = entries + i;
+        if (_dirty_read_sprite(entry, update)) {
+            goto end;
+        }
+        if (entry->image) {
+            _dirty_paint_area(entry, &clip, update);
+        }
+        if (!update || entry->dirty < 1) {
+            continue;
+        }
+        if (_region_add(&region, &entry->rect, &clip)) {
+            goto end;
+        }
+        old = PyDict_GetItemWithError(spritedict, entry->sprite);
+        if (!old && PyErr_Occurred()) {
+            goto end;
+        }
+        if (old && old != init_rect) {
+            if (!(rect = pgRect_FromObject(old, &temp))) {
+                PyErr_SetString(PyExc_TypeError, "sprite area must be a Rect");
+                goto end;
+            }
+            temp = *rect;
+            if (_region_add(&region, &temp, &clip)) {
+                goto end;
+            }
+        }
+    }
+    if (_region_coalesce(&region)) {
+        goto end;
+    }
+
+    /* 2. find the sprites hidden by opaque sprites above them */
+    for (i = n - 1; i >= 0; --i) {
+        entry = entries + i;
+        if (!entry->image || _rect_is_empty(&entry->paint)) {
+            continue;
+        }
+        entry->hidden = _occluders_hide(occluders, noccluders, &entry->paint,
+                                        entry->inside);
+        if (entry->opaque && !entry->hidden) {
+            _occluders_add(occluders, &noccluders, &entry->paint,
+                           entry->covers);
+        }
+    }
+
+    /* 3. blit the background and the sprites */
+    if (bgd != Py_None) {
+        if (!(bgdsurf = pgSurface_AsSurface(bgd))) {
+            PyErr_SetString(pgExc_SDLError, "display Surface quit");
+            goto end;
+        }
+        if (update) {
+            for (i = 0; i < region.length; ++i) {
+                if (_occluders_hide(occluders, noccluders, region.rects + i,
+                                    1)) {
+                    continue;
+                }
+                dest = area = region.rects[i];
+                if (_dirty_blit(surface, bgd, &dest, &area, 0)) {
+                    goto end;
+                }
+            }
+        }
+        else {
+            area.x = area.y = 0;
+            area.w = bgdsurf->w;
+            area.h = bgdsurf->h;
+            _rect_intersect(&area, &clip, &dest);
+            if (!_occluders_hide(occluders, noccluders, &dest, 1)) {
+                dest.x = dest.y = 0;
+                if (_dirty_blit(surface, bgd, &dest, &area, 0)) {
+                    goto end;
+                }
+            }
+        }
+    }
+    if (_dirty_draw_entries(surface, entries, n, &region, update)) {
+        goto end;
+    }
+
+    /* 4. remember where the sprites were drawn */
+    for (i = 0; i < n; ++i) {
+        entry = entries + i;
+        if (entry->image && (!update || entry->dirty > 0)) {
+            if (!(rectobj = pgRect_New(&entry->drawn))) {
+                goto end;
+            }
+            if (PyDict_SetItem(spritedict, entry->sprite, rectobj)) {
+                Py_DECREF(rectobj);
+                goto end;
+            }
+            Py_DECREF(rectobj);
+        }
+        if (update && entry->dirty == 1 &&
+            PyObject_SetAttr(entry->sprite, str_dirty, zero)) {
+            goto end;
+        }
+    }
+
+    if (update) {
+        result = _dirty_rect_list(region.rects, region.length);
+    }
+    else {
+        result = _dirty_rect_list(&clip, 1);
+    }
+
+end:
+    for (i = 0; entries && i < n; ++i) {
+        Py_DECREF(entries[i].sprite);
+        Py_XDECREF(entries[i].image);
+    }
+    PyMem_Free(entries);
+    PyMem_Free(region.rects);
+    Py_XDECREF(lostseq);
+    Py_DECREF(seq);
+    Py_DECREF(zero);
+    return result;
+}
+
+static PyMethodDef _spritegroup_methods[] = {
+    {"draw_dirty", _spritegroup_draw_dirty, METH_VARARGS,
+     "draw_dirty(surface, sprites, spritedict, lost, bgd, init_rect, update) "
+     "-> Rect_list\ndraw the sprites of a LayeredDirty group"},
+    {NULL, NULL, 0, NULL}};
+
+MODINIT_DEFINE(_spritegroup)
+{
+    PyObject *module;
+
+    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
+                                         "_spritegroup",
+                                         "native storage for sprite groups",
+                                         -1,
+                                         _spritegroup_methods,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL};
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_rect();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_surface();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (!str_image && !(str_image = PyUnicode_InternFromString("image"))) {
+        return NULL;
+    }
+    if (!str_rect && !(str_rect = PyUnicode_InternFromString("rect"))) {
+        return NULL;
+    }
+    if (!str_update && !(str_update = PyUnicode_InternFromString("update"))) {
+        return NULL;
+    }
+    if (!str_dirty && !(str_dirty = PyUnicode_InternFromString("dirty"))) {
+        return NULL;
+    }
+    if (!str_visible &&
+        !(str_visible = PyUnicode_InternFromString("visible"))) {
+        return NULL;
+    }
+    if (!str_blendmode &&
+        !(str_blendmode = PyUnicode_InternFromString("blendmode"))) {
+        return NULL;
+    }
+    if (!str_source_rect &&
+        !(str_source_rect = PyUnicode_InternFromString("source_rect"))) {
+        return NULL;
+    }
+
+    if (PyType_Ready(&pgGroupCore_Type) < 0 ||
+        PyType_Ready(&pgLayerOrder_Type) < 0) {
+        return NULL;
+    }
+
+    module = PyModule_Create(&_module);
+    if (module == NULL) {
+        return NULL;
+    }
+    Py_INCREF(&pgGroupCore_Type);
+    if (PyModule_AddObject(module, "GroupCore",
+                           (PyObject *)&pgGroupCore_Type)) {
+        Py_DECREF(&pgGroupCore_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgLayerOrder_Type);
+    if (PyModule_AddObject(module, "LayerOrder",
+                           (PyObject *)&pgLayerOrder_Type)) {
+        Py_DECREF(&pgLayerOrder_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
+}
@@ -399,6 +399,276 @@ pg_get_sdl_byteorder(PyObject *self, PyObject *_null)
     return PyLong_FromLong(SDL_BYTEORDER);
 }
 
+/* Splitting loops over native threads, see pg_parallel_for().
+ *
+ * The loops are run by one pool of worker threads for all the modules, one
+ * less than the number of CPUs. It is started the first time a loop is split
+ * and stopped again by pygame.quit().
+ */
+
+/* One pg_parallel_for() call, split into ntasks ranges. Jobs wait in the
+ * pool's queue until every range has been handed out. */
+typedef struct pg_parallel_job {
+    pg_parallel_func func;
+    void *data;
+    int n, ntasks;
+    int next;      /* the next range to hand out */
+    int remaining; /* the ranges not done yet */
+    struct pg_parallel_job *link;
+} pg_parallel_job;
+
+static struct {
+    SDL_mutex *state_lock; /* held while starting or stopping the pool */
+    SDL_mutex *lock;       /* guards the fields below */
+    SDL_cond *wake;        /* a job was queued, or the pool is stopping */
+    SDL_cond *done;        /* a range of some job is done */
+    pg_parallel_job *head, *tail;
+    int started;
+    int stopping;
+    int nthreads;
+    SDL_Thread *threads[PG_PARALLEL_MAX_THREADS];
+} pg_parallel_pool;
+
+/* Runs the index'th range of the job. The remainder of n / ntasks is spread
+ * over the first ranges. */
+static void
+_pg_parallel_run(pg_parallel_job *job, int index)
+{
+    int len = job->n / job->ntasks, extra = job->n % job->ntasks;
+    int start = index * len + (index < extra ? index : extra);
+
+    job->func(job->data, start, start + len + (index < extra));
+}
+
+/* Hands out the next range of the job, which must be queued. Called with the
+ * pool locked. */
+static int
+_pg_parallel_take(pg_parallel_job *job)
+{
+    pg_parallel_job **link;
+    int index = job->next++;
+
+    if (job->next == job->ntasks) {
+        /* Nothing left to hand out, take the job off the queue. */
+        for (link = &pg_parallel_pool.head; *link != job;
+             link = &(*link)->link)
+            ;
+        *link = job->link;
+        if (pg_parallel_pool.tail == job) {
+            pg_parallel_pool.tail = NULL;
+            for (job = pg_parallel_pool.head; job; job = job->link) {
+                pg_parallel_pool.tail = job;
+            }
+        }
+    }
+    return index;
+}
+
+/* Marks a range of the job as done. Called with the pool locked. */
+static void
+_pg_parallel_finish(pg_parallel_job *job)
+{
+    if (!--job->remaining) {
+        SDL_CondBroadcast(pg_parallel_pool.done);
+    }
+}
+
+static int SDLCALL
+_pg_parallel_worker(void *arg)
+{
+    pg_parallel_job *job;
+    int index;
+
+    SDL_LockMutex(pg_parallel_pool.lock);
+    for (;;) {
+        job = pg_parallel_pool.head;
+        if (!job) {
+            if (pg_parallel_pool.stopping) {
+                break;
+            }
+            SDL_CondWait(pg_parallel_pool.wake, pg_parallel_pool.lock);
+            continue;
+        }
+
+        index = _pg_parallel_take(job);
+        SDL_UnlockMutex(pg_parallel_pool.lock);
+        _pg_parallel_run(job, index);
+        SDL_LockMutex(pg_parallel_pool.lock);
+        _pg_parallel_finish(job);
+    }
+    SDL_UnlockMutex(pg_parallel_pool.lock);
+    return 0;
+}
+
+/* Creates the pool's locks, without starting any thread. If that fails the
+ * loops are not split. The locks are kept if the base module is loaded
+ * again, as threads may be using them. */
+static void
+pg_parallel_init(void)
+{
+    if (pg_parallel_pool.state_lock) {
+        return;
+    }
+    pg_parallel_pool.state_lock = SDL_CreateMutex();
+    pg_parallel_pool.lock = SDL_CreateMutex();
+    pg_parallel_pool.wake = SDL_CreateCond();
+    pg_parallel_pool.done = SDL_CreateCond();
+}
+
+/* Starts the worker threads if they aren't running yet. Returns the number
+ * of workers, 0 if none could be started.
+ *
+ * While the pool is stopping no workers are started, and 0 is returned, so
+ * that a loop split from a work function doesn't wait for the stop, which
+ * waits for the work function in turn.
+ */
+static int
+_pg_parallel_start(void)
+{
+    SDL_Thread *thread;
+    int nthreads, started;
+
+    if (!pg_parallel_pool.state_lock || !pg_parallel_pool.lock ||
+        !pg_parallel_pool.wake || !pg_parallel_pool.done) {
+        return 0;
+    }
+
+    SDL_LockMutex(pg_parallel_pool.lock);
+    started = pg_parallel_pool.started || pg_parallel_pool.stopping;
+    nthreads = pg_parallel_pool.stopping ? 0 : pg_parallel_pool.nthreads;
+    SDL_UnlockMutex(pg_parallel_pool.lock);
+    if (started) {
+        return nthreads;
+    }
+
+    SDL_LockMutex(pg_parallel_pool.state_lock);
+    if (!pg_parallel_pool.started) {
+        int max_threads = SDL_GetCPUCount() - 1;
+
+        if (max_threads > PG_PARALLEL_MAX_THREADS - 1) {
+            max_threads = PG_PARALLEL_MAX_THREADS - 1;
+        }
+        for (nthreads = 0; nthreads < max_threads; nthreads++) {
+            thread =
+                SDL_CreateThread(_pg_parallel_worker, "pg_parallel", NULL);
+            if (!thread) {
+                break;
+            }
+            pg_parallel_pool.threads[nthreads] = thread;
+        }
+
+        SDL_LockMutex(pg_parallel_pool.lock);
+        pg_parallel_pool.nthreads = nthreads;
+        pg_parallel_pool.started = 1;
+        SDL_UnlockMutex(pg_parallel_pool.lock);
+    }
+    else {
+        nthreads = pg_parallel_pool.nthreads;
+    }
+    SDL_UnlockMutex(pg_parallel_pool.state_lock);
+
+    return nthreads;
+}
+
+/* Stops the worker threads once the queued jobs have been handed out. The
+ * pool starts again on the next pg_parallel_for() that needs it. Called by
+ * pygame.quit(), without the GIL.
+ */
+static void
+pg_parallel_quit(void)
+{
+    int i;
+
+    if (!pg_parallel_pool.state_lock || !pg_parallel_pool.lock) {
+        return;
+    }
+
+    SDL_LockMutex(pg_parallel_pool.state_lock);
+    SDL_LockMutex(pg_parallel_pool.lock);
+    pg_parallel_pool.stopping = 1;
+    SDL_CondBroadcast(pg_parallel_pool.wake);
+    SDL_UnlockMutex(pg_parallel_pool.lock);
+
+    for (i = 0; i < pg_parallel_pool.nthreads; i++) {
+        SDL_WaitThread(pg_parallel_pool.threads[i], NULL);
+    }
+
+    SDL_LockMutex(pg_parallel_pool.lock);
+    pg_parallel_pool.nthreads = 0;
+    pg_parallel_pool.stopping = 0;
+    pg_parallel_pool.started = 0;
+    SDL_UnlockMutex(pg_parallel_pool.lock);
+    SDL_UnlockMutex(pg_parallel_pool.state_lock);
+}
+
+/* Calls func on disjoint ranges covering the items [0, n), spread over up to
+ * one thread per CPU. No range is given fewer than min_chunk items, so small
+ * loops stay on the calling thread. Returns once every range is done.
+ *
+ * The calling thread runs ranges of its own loop too, so the work is always
+ * completed even if no worker thread could be started, and loops may be
+ * split from inside a work function. Accessible through the C api.
+ */
+static void
+pg_parallel_for(int n, int min_chunk, pg_parallel_func func, void *data)
+{
+    pg_parallel_job job;
+    int ntasks = SDL_GetCPUCount();
+    int index;
+
+    if (n <= 0) {
+        return;
+    }
+
+    if (min_chunk < 1) {
+        min_chunk = 1;
+    }
+
+    if (ntasks > n / min_chunk) {
+        ntasks = n / min_chunk;
+    }
+
+    if (ntasks > PG_PARALLEL_MAX_THREADS) {
+        ntasks = PG_PARALLEL_MAX_THREADS;
+    }
+
+    if (ntasks <= 1 || !_pg_parallel_start()) {
+        func(data, 0, n);
+        return;
+    }
+
+    job.func = func;
+    job.data = data;
+    job.n = n;
+    job.ntasks = ntasks;
+    job.next = 0;
+    job.remaining = ntasks;
+    job.link = NULL;
+
+    SDL_LockMutex(pg_parallel_pool.lock);
+    if (pg_parallel_pool.tail) {
+        pg_parallel_pool.tail->link = &job;
+    }
+    else {
+        pg_parallel_pool.head = &job;
+    }
+    pg_parallel_pool.tail = &job;
+    SDL_CondBroadcast(pg_parallel_pool.wake);
+
+    while (job.next < job.ntasks) {
+        index = _pg_parallel_take(&job);
+        SDL_UnlockMutex(pg_parallel_pool.lock);
+        _pg_parallel_run(&job, index);
+        SDL_LockMutex(pg_parallel_pool.lock);
+        _pg_parallel_finish(&job);
+    }
+
+    while (job.remaining) {
+        SDL_CondWait(pg_parallel_pool.done, pg_parallel_pool.lock);
+    }
+    SDL_UnlockMutex(pg_parallel_pool.lock);
+}
+
 static void
 _pg_quit(void)
 {
@@ -460,6 +730,7 @@ _pg_quit(void)
     /* Release the GIL here, because the timer thread cleanups should happen
      * without deadlocking. */
     Py_BEGIN_ALLOW_THREADS;
+    pg_parallel_quit();
     pg_atexit_quit();
     Py_END_ALLOW_THREADS;
 }
@@ -2139,6 +2410,8 @@ MODINIT_DEFINE(base)
         goto error;
     }
 
+    pg_parallel_init();
+
     /* export the c api */
     c_api[0] = pgExc_SDLError;
     c_api[1] = pg_RegisterQuit;
@@ -2164,7 +2437,8 @@ MODINIT_DEFINE(base)
     c_api[21] = pg_GetDefaultWindowSurface;
     c_api[22] = pg_SetDefaultWindowSurface;
     c_api[23] = pg_EnvShouldBlendAlphaSDL2;
-#define FILLED_SLOTS 24
+    c_api[24] = pg_parallel_for;
+#define FILLED_SLOTS 25
 
 #if PYGAMEAPI_BASE_NUMSLOTS != FILLED_SLOTS
 #error export slot count mismatch
@@ -21,6 +21,7 @@
  */
 
 #include "include/bitmask.h"
+#include <math.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,6 +30,35 @@
 #warning No INLINE definition in bitmask.h, performance may suffer.
 #endif
 
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+/* arm64 has neon optimisations enabled by default, even when fpu=neon is not
+ * passed */
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define BITMASK_SIMD
+#elif defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define BITMASK_SIMD
+#endif
+
+#ifdef BITMASK_SIMD
+/* Number of BITMASK_W words in one 128 bit register and the shifts to use
+ * on them. */
+#if ULONG_MAX > 0xffffffffUL
+#define BITMASK_SIMD_WORDS 2
+#define BITMASK_SIMD_SLL _mm_sll_epi64
+#define BITMASK_SIMD_SRL _mm_srl_epi64
+#else
+#define BITMASK_SIMD_WORDS 4
+#define BITMASK_SIMD_SLL _mm_sll_epi32
+#define BITMASK_SIMD_SRL _mm_srl_epi32
+#endif
+#endif /* BITMASK_SIMD */
+
 #define MIN(a, b) ((a) <= (b) ? (a) : (b))
 #define MAX(a, b) ((a) >= (b) ? (a) : (b))
 
@@ -106,6 +136,105 @@ positive_modulo(int dividend, int divisor)
     return (result >= 0) ? result : result + divisor;
 }
 
+/* Stripe kernels shared by the draw, erase and overlap_mask routines.
+ *
+ * Each one walks n consecutive words of a stripe, shifting the words of src
+ * by (word << lshift) >> rshift. At most one of the shifts is nonzero and
+ * both are less than BITMASK_W_LEN.
+ *
+ * When dst and src are parts of the same mask and the two runs overlap the
+ * words are handled one at a time, so the result is the same as it always
+ * was for a mask drawn onto itself.
+ */
+
+/* dst |= shifted src */
+static INLINE void
+stripe_draw(BITMASK_W *dst, const BITMASK_W *src, int n, int lshift,
+            int rshift)
+{
+    int i = 0;
+
+#ifdef BITMASK_SIMD
+    if (dst + n <= src || src + n <= dst) {
+        __m128i lcount = _mm_cvtsi32_si128(lshift);
+        __m128i rcount = _mm_cvtsi32_si128(rshift);
+
+        for (; i + BITMASK_SIMD_WORDS <= n; i += BITMASK_SIMD_WORDS) {
+            __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+
+            s = BITMASK_SIMD_SRL(BITMASK_SIMD_SLL(s, lcount), rcount);
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(d, s));
+        }
+    }
+#endif /* BITMASK_SIMD */
+
+    for (; i < n; i++)
+        dst[i] |= (src[i] << lshift) >> rshift;
+}
+
+/* dst &= ~(shifted src) */
+static INLINE void
+stripe_erase(BITMASK_W *dst, const BITMASK_W *src, int n, int lshift,
+             int rshift)
+{
+    int i = 0;
+
+#ifdef BITMASK_SIMD
+    if (dst + n <= src || src + n <= dst) {
+        __m128i lcount = _mm_cvtsi32_si128(lshift);
+        __m128i rcount = _mm_cvtsi32_si128(rshift);
+
+        for (; i + BITMASK_SIMD_WORDS <= n; i += BITMASK_SIMD_WORDS) {
+            __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+
+            s = BITMASK_SIMD_SRL(BITMASK_SIMD_SLL(s, lcount), rcount);
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_andnot_si128(s, d));
+        }
+    }
+#endif /* BITMASK_SIMD */
+
+    for (; i < n; i++)
+        dst[i] &= ~((src[i] << lshift) >> rshift);
+}
+
+/* dst = a & shifted b, or dst |= a & shifted b if accumulate is set. dst is
+ * never one of the inputs. */
+static INLINE void
+stripe_and(BITMASK_W *dst, const BITMASK_W *a, const BITMASK_W *b, int n,
+           int lshift, int rshift, int accumulate)
+{
+    int i = 0;
+
+#ifdef BITMASK_SIMD
+    __m128i lcount = _mm_cvtsi32_si128(lshift);
+    __m128i rcount = _mm_cvtsi32_si128(rshift);
+
+    for (; i + BITMASK_SIMD_WORDS <= n; i += BITMASK_SIMD_WORDS) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(b + i));
+
+        s = BITMASK_SIMD_SRL(BITMASK_SIMD_SLL(s, lcount), rcount);
+        s = _mm_and_si128(s, _mm_loadu_si128((const __m128i *)(a + i)));
+
+        if (accumulate) {
+            s = _mm_or_si128(s, _mm_loadu_si128((const __m128i *)(dst + i)));
+        }
+
+        _mm_storeu_si128((__m128i *)(dst + i), s);
+    }
+#endif /* BITMASK_SIMD */
+
+    if (accumulate) {
+        for (; i < n; i++)
+            dst[i] |= a[i] & ((b[i] << lshift) >> rshift);
+    }
+    else {
+        for (; i < n; i++)
+            dst[i] = a[i] & ((b[i] << lshift) >> rshift);
+    }
+}
+
 bitmask_t *
 bitmask_create(int w, int h)
 {
@@ -566,8 +695,8 @@ void
 bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
                      int xoffset, int yoffset)
 {
-    const BITMASK_W *a_entry, *ap;
-    const BITMASK_W *b_entry, *bp;
+    const BITMASK_W *a_entry;
+    const BITMASK_W *b_entry;
     BITMASK_W *c_entry, *cp;
     int shift, rshift, i, astripes, bstripes;
 
@@ -601,42 +730,37 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                         ap++, bp++, cp++)
-                        *cp |= *ap & (*bp << shift);
+                    stripe_and(c_entry, a_entry, b_entry,
+                               (int)(a_end - a_entry), shift, 0, 1);
 
                     /* The c_entry (output mask) must advance with a_entry. */
                     a_entry += a->h;
                     a_end += a->h;
                     c_entry += c->h;
 
-                    for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                         ap++, bp++, cp++)
-                        *cp |= *ap & (*bp >> rshift);
+                    stripe_and(c_entry, a_entry, b_entry,
+                               (int)(a_end - a_entry), 0, rshift, 1);
 
                     b_entry += b->h;
                 }
 
                 /* This is the '.. zig' to handle the remaining bits. */
-                for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                     ap++, bp++, cp++)
-                    *cp |= *ap & (*bp << shift);
+                stripe_and(c_entry, a_entry, b_entry, (int)(a_end - a_entry),
+                           shift, 0, 1);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                         ap++, bp++, cp++)
-                        *cp |= *ap & (*bp << shift);
+                    stripe_and(c_entry, a_entry, b_entry,
+                               (int)(a_end - a_entry), shift, 0, 1);
 
                     /* The c_entry (output mask) must advance with a_entry. */
                     a_entry += a->h;
                     a_end += a->h;
                     c_entry += c->h;
 
-                    for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                         ap++, bp++, cp++)
-                        *cp |= *ap & (*bp >> rshift);
+                    stripe_and(c_entry, a_entry, b_entry,
+                               (int)(a_end - a_entry), 0, rshift, 1);
 
                     b_entry += b->h;
                 }
@@ -647,10 +771,8 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                     ap++, bp++, cp++) {
-                    *cp = *ap & *bp;
-                }
+                stripe_and(c_entry, a_entry, b_entry, (int)(a_end - a_entry),
+                           0, 0, 0);
                 a_entry += a->h;
                 c_entry += c->h;
                 a_end += a->h;
@@ -684,32 +806,27 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                         bp++, ap++, cp++)
-                        *cp = *ap & (*bp >> shift);
+                    stripe_and(c_entry, a_entry, b_entry,
+                               (int)(b_end - b_entry), 0, shift, 0);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                         bp++, ap++, cp++)
-                        *cp |= *ap & (*bp << rshift);
+                    stripe_and(c_entry, a_entry, b_entry,
+                               (int)(b_end - b_entry), rshift, 0, 1);
                     a_entry += a->h;
                     c_entry += c->h;
                 }
-                for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                     bp++, ap++, cp++)
-                    *cp = *ap & (*bp >> shift);
+                stripe_and(c_entry, a_entry, b_entry, (int)(b_end - b_entry),
+                           0, shift, 0);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                         bp++, ap++, cp++)
-                        *cp = *ap & (*bp >> shift);
+                    stripe_and(c_entry, a_entry, b_entry,
+                               (int)(b_end - b_entry), 0, shift, 0);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                         bp++, ap++, cp++)
-                        *cp |= *ap & (*bp << rshift);
+                    stripe_and(c_entry, a_entry, b_entry,
+                               (int)(b_end - b_entry), rshift, 0, 1);
                     a_entry += a->h;
                     c_entry += c->h;
                 }
@@ -720,10 +837,8 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
         {
             astripes = (MIN(a->w, b->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                     bp++, ap++, cp++) {
-                    *cp = *ap & *bp;
-                }
+                stripe_and(c_entry, a_entry, b_entry, (int)(b_end - b_entry),
+                           0, 0, 0);
                 b_entry += b->h;
                 b_end += b->h;
                 a_entry += a->h;
@@ -753,7 +868,7 @@ void
 bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
 {
     BITMASK_W *a_entry, *a_end, *ap;
-    const BITMASK_W *b_entry, *bp;
+    const BITMASK_W *b_entry;
     int shift, rshift, i, astripes, bstripes;
 
     /* Return if no overlap or one mask has a width/height of 0. */
@@ -781,26 +896,26 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap |= (*bp << shift);
+                    stripe_draw(a_entry, b_entry, (int)(a_end - a_entry),
+                                shift, 0);
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap |= (*bp >> rshift);
+                    stripe_draw(a_entry, b_entry, (int)(a_end - a_entry), 0,
+                                rshift);
                     b_entry += b->h;
                 }
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                    *ap |= (*bp << shift);
+                stripe_draw(a_entry, b_entry, (int)(a_end - a_entry), shift,
+                            0);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap |= (*bp << shift);
+                    stripe_draw(a_entry, b_entry, (int)(a_end - a_entry),
+                                shift, 0);
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap |= (*bp >> rshift);
+                    stripe_draw(a_entry, b_entry, (int)(a_end - a_entry), 0,
+                                rshift);
                     b_entry += b->h;
                 }
             }
@@ -810,9 +925,7 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++) {
-                    *ap |= *bp;
-                }
+                stripe_draw(a_entry, b_entry, (int)(a_end - a_entry), 0, 0);
                 a_entry += a->h;
                 a_end += a->h;
                 b_entry += b->h;
@@ -843,26 +956,26 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap |= (*bp >> shift);
+                    stripe_draw(a_entry, b_entry, (int)(b_end - b_entry), 0,
+                                shift);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap |= (*bp << rshift);
+                    stripe_draw(a_entry, b_entry, (int)(b_end - b_entry),
+                                rshift, 0);
                     a_entry += a->h;
                 }
-                for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                    *ap |= (*bp >> shift);
+                stripe_draw(a_entry, b_entry, (int)(b_end - b_entry), 0,
+                            shift);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap |= (*bp >> shift);
+                    stripe_draw(a_entry, b_entry, (int)(b_end - b_entry), 0,
+                                shift);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap |= (*bp << rshift);
+                    stripe_draw(a_entry, b_entry, (int)(b_end - b_entry),
+                                rshift, 0);
                     a_entry += a->h;
                 }
             }
@@ -872,9 +985,7 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         {
             astripes = (MIN(a->w, b->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++) {
-                    *ap |= *bp;
-                }
+                stripe_draw(a_entry, b_entry, (int)(b_end - b_entry), 0, 0);
                 b_entry += b->h;
                 b_end += b->h;
                 a_entry += a->h;
@@ -902,8 +1013,8 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
 void
 bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
 {
-    BITMASK_W *a_entry, *ap;
-    const BITMASK_W *b_entry, *bp;
+    BITMASK_W *a_entry;
+    const BITMASK_W *b_entry;
     int shift, rshift, i, astripes, bstripes;
 
     /* Return if no overlap or one mask has a width/height of 0. */
@@ -933,26 +1044,26 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap &= ~(*bp << shift);
+                    stripe_erase(a_entry, b_entry, (int)(a_end - a_entry),
+                                 shift, 0);
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap &= ~(*bp >> rshift);
+                    stripe_erase(a_entry, b_entry, (int)(a_end - a_entry), 0,
+                                 rshift);
                     b_entry += b->h;
                 }
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                    *ap &= ~(*bp << shift);
+                stripe_erase(a_entry, b_entry, (int)(a_end - a_entry), shift,
+                             0);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap &= ~(*bp << shift);
+                    stripe_erase(a_entry, b_entry, (int)(a_end - a_entry),
+                                 shift, 0);
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap &= ~(*bp >> rshift);
+                    stripe_erase(a_entry, b_entry, (int)(a_end - a_entry), 0,
+                                 rshift);
                     b_entry += b->h;
                 }
             }
@@ -962,9 +1073,7 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++) {
-                    *ap &= ~*bp;
-                }
+                stripe_erase(a_entry, b_entry, (int)(a_end - a_entry), 0, 0);
                 a_entry += a->h;
                 a_end += a->h;
                 b_entry += b->h;
@@ -995,26 +1104,26 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap &= ~(*bp >> shift);
+                    stripe_erase(a_entry, b_entry, (int)(b_end - b_entry), 0,
+                                 shift);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap &= ~(*bp << rshift);
+                    stripe_erase(a_entry, b_entry, (int)(b_end - b_entry),
+                                 rshift, 0);
                     a_entry += a->h;
                 }
-                for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                    *ap &= ~(*bp >> shift);
+                stripe_erase(a_entry, b_entry, (int)(b_end - b_entry), 0,
+                             shift);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap &= ~(*bp >> shift);
+                    stripe_erase(a_entry, b_entry, (int)(b_end - b_entry), 0,
+                                 shift);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap &= ~(*bp << rshift);
+                    stripe_erase(a_entry, b_entry, (int)(b_end - b_entry),
+                                 rshift, 0);
                     a_entry += a->h;
                 }
             }
@@ -1024,8 +1133,7 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         {
             astripes = (MIN(a->w, b->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                    *ap &= ~*bp;
+                stripe_erase(a_entry, b_entry, (int)(b_end - b_entry), 0, 0);
                 b_entry += b->h;
                 b_end += b->h;
                 a_entry += a->h;
@@ -1034,6 +1142,182 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
     }
 }
 
+/* Applies one bitmask_compose() operation to the words of stripe s of a. */
+static INLINE void
+compose_stripe(bitmask_t *a, int s, const bitmask_op_t *op)
+{
+    const int len = BITMASK_W_LEN;
+    const bitmask_t *b = op->mask;
+    const BITMASK_W *b_entry;
+    BITMASK_W *a_entry;
+    int bx, bstripe, bstripes, shift, rows;
+
+    /* bx is the column of b landing on the first bit of the stripe, it is
+       bit shift of the b stripe bstripe. */
+    bx = s * len - op->xoffset;
+
+    if (bx >= b->w || bx <= -len) {
+        return;
+    }
+
+    bstripe = (bx >= 0) ? bx / len : -1;
+    shift = bx - bstripe * len;
+    bstripes = (b->w - 1) / BITMASK_W_LEN + 1;
+
+    a_entry = a->bits + s * a->h + MAX(op->yoffset, 0);
+    b_entry = b->bits + MAX(-op->yoffset, 0);
+    rows = MIN(a->h, op->yoffset + b->h) - MAX(op->yoffset, 0);
+
+    if (op->op == BITMASK_OP_ERASE) {
+        if (bstripe >= 0) {
+            stripe_erase(a_entry, b_entry + bstripe * b->h, rows, 0, shift);
+        }
+        if (shift && bstripe + 1 < bstripes) {
+            stripe_erase(a_entry, b_entry + (bstripe + 1) * b->h, rows,
+                         len - shift, 0);
+        }
+    }
+    else {
+        if (bstripe >= 0) {
+            stripe_draw(a_entry, b_entry + bstripe * b->h, rows, 0, shift);
+        }
+        if (shift && bstripe + 1 < bstripes) {
+            stripe_draw(a_entry, b_entry + (bstripe + 1) * b->h, rows,
+                        len - shift, 0);
+        }
+    }
+}
+
+void
+bitmask_compose(bitmask_t *a, const bitmask_op_t *ops, int n, int start,
+                int end)
+{
+    int nstripes, nbuckets, s, k, total;
+    int *first = NULL, *bucket = NULL, *index = NULL;
+
+    if (!a->w || !a->h) {
+        return;
+    }
+
+    nstripes = (a->w - 1) / BITMASK_W_LEN + 1;
+    start = MAX(start, 0);
+    end = MIN(end, nstripes);
+
+    if (start >= end) {
+        return;
+    }
+
+    nbuckets = end - start;
+    first = (int *)malloc(sizeof(int) * n);
+    bucket = (int *)calloc(nbuckets + 1, sizeof(int));
+
+    if (!first || !bucket) {
+        goto fallback;
+    }
+
+    /* Bucket the operations by the stripes they touch, keeping them in
+       order, so each stripe only looks at its own operations. first[k] is
+       the first stripe of operation k, or -1 if it misses [start, end). */
+    for (k = 0, total = 0; k < n; k++) {
+        const bitmask_t *b = ops[k].mask;
+        int x = ops[k].xoffset, y = ops[k].yoffset, last;
+
+        first[k] = -1;
+
+        if ((x >= a->w) || (y >= a->h) || (y <= -b->h) || (x <= -b->w) ||
+            (!b->h) || (!b->w)) {
+            continue;
+        }
+
+        s = MAX(MAX(x, 0) / (int)BITMASK_W_LEN, start);
+        last = MIN((MIN(x + b->w, a->w) - 1) / (int)BITMASK_W_LEN, end - 1);
+
+        if (s > last) {
+            continue;
+        }
+
+        first[k] = s;
+
+        for (; s <= last; s++) {
+            bucket[s - start + 1]++;
+        }
+
+        total += last - first[k] + 1;
+    }
+
+    for (s = 0; s < nbuckets; s++) {
+        bucket[s + 1] += bucket[s];
+    }
+
+    index = (int *)malloc(sizeof(int) * MAX(total, 1));
+
+    if (!index) {
+        goto fallback;
+    }
+
+    /* Fill the buckets, using bucket[i] as the fill position of bucket i
+       until it ends up at the start of bucket i + 1. */
+    for (k = 0; k < n; k++) {
+        const bitmask_t *b = ops[k].mask;
+        int last;
+
+        if (first[k] < 0) {
+            continue;
+        }
+
+        last = MIN((MIN(ops[k].xoffset + b->w, a->w) - 1) / (int)BITMASK_W_LEN,
+                   end - 1);
+
+        for (s = first[k]; s <= last; s++) {
+            index[bucket[s - start]++] = k;
+        }
+    }
+
+    for (s = start; s < end; s++) {
+        int i, i_end = bucket[s - start];
+
+        for (i = (s > start) ? bucket[s - start - 1] : 0; i < i_end; i++) {
+            compose_stripe(a, s, &ops[index[i]]);
+        }
+    }
+
+    goto done;
+
+fallback:
+    /* Out of memory for the buckets, so check every operation against
+       every stripe. */
+    for (s = start; s < end; s++) {
+        for (k = 0; k < n; k++) {
+            const bitmask_t *b = ops[k].mask;
+
+            if ((ops[k].xoffset >= a->w) || (ops[k].yoffset >= a->h) ||
+                (ops[k].yoffset <= -b->h) || (ops[k].xoffset <= -b->w) ||
+                (!b->h) || (!b->w)) {
+                continue;
+            }
+
+            compose_stripe(a, s, &ops[k]);
+        }
+    }
+
+done:
+    free(first);
+    free(bucket);
+    free(index);
+
+    /* Zero out bits drawn outside the mask rectangle (to the right). */
+    if (end == nstripes && (a->w & BITMASK_W_MASK)) {
+        BITMASK_W edgemask, *ap, *a_end;
+
+        edgemask =
+            (~(BITMASK_W)0) >> (BITMASK_W_LEN - (a->w & BITMASK_W_MASK));
+        ap = a->bits + (nstripes - 1) * a->h;
+
+        for (a_end = ap + a->h; ap < a_end; ap++)
+            *ap &= edgemask;
+    }
+}
+
 bitmask_t *
 bitmask_scale(const bitmask_t *m, int w, int h)
 {
@@ -1075,16 +1359,191 @@ bitmask_scale(const bitmask_t *m, int w, int h)
     return nm;
 }
 
+void
+bitmask_rotated_size(int w, int h, double angle, int *rw, int *rh)
+{
+    double radangle, sangle, cangle, cx, cy, sx, sy;
+
+    if (w < 1 || h < 1) {
+        *rw = w;
+        *rh = h;
+        return;
+    }
+
+    /* Multiples of 90 degrees are a straight transposition. */
+    if (!fmod(angle, 90.0)) {
+        if (((int)fmod(angle, 360.0) / 90) % 2) {
+            *rw = h;
+            *rh = w;
+        }
+        else {
+            *rw = w;
+            *rh = h;
+        }
+        return;
+    }
+
+    radangle = angle * .01745329251994329;
+    sangle = sin(radangle);
+    cangle = cos(radangle);
+
+    cx = cangle * w;
+    cy = cangle * h;
+    sx = sangle * w;
+    sy = sangle * h;
+    *rw = (int)(MAX(MAX(MAX(fabs(cx + sy), fabs(cx - sy)), fabs(-cx + sy)),
+                    fabs(-cx - sy)));
+    *rh = (int)(MAX(MAX(MAX(fabs(sx + cy), fabs(sx - cy)), fabs(-sx + cy)),
+                    fabs(-sx - cy)));
+}
+
+/* Rotates the mask one output word at a time. Every output bit is sampled
+ * from its source position, so each output word is written exactly once.
+ * The source coordinates are stepped in 16.16 fixed point exactly like
+ * rotate() in transform.c.
+ */
+bitmask_t *
+bitmask_rotate(const bitmask_t *m, double angle)
+{
+    bitmask_t *o;
+    BITMASK_W word, *op;
+    int x, y, i, n, w, h;
+
+    if (m->w < 0 || m->h < 0) {
+        return NULL;
+    }
+
+    bitmask_rotated_size(m->w, m->h, angle, &w, &h);
+
+    o = bitmask_create(w, h);
+
+    if (!o || !w || !h) {
+        return o;
+    }
+
+    if (!fmod(angle, 90.0)) {
+        /* Source position of output bit (0, 0) and how it moves when the
+           output x or y is incremented, see rotate90() in transform.c. */
+        int numturns = (int)fmod(angle, 360.0) / 90;
+        int sx0 = 0, sy0 = 0, sxx = 1, syx = 0, sxy = 0, syy = 1;
+
+        if (numturns < 0) {
+            numturns += 4;
+        }
+
+        switch (numturns) {
+            case 1:
+                sx0 = m->w - 1;
+                sxx = 0;
+                syx = 1;
+                sxy = -1;
+                syy = 0;
+                break;
+            case 2:
+                sx0 = m->w - 1;
+                sy0 = m->h - 1;
+                sxx = -1;
+                syy = -1;
+                break;
+            case 3:
+                sy0 = m->h - 1;
+                sxx = 0;
+                syx = -1;
+                sxy = 1;
+                syy = 0;
+                break;
+        }
+
+        for (y = 0; y < h; y++) {
+            int sx = sx0 + y * sxy;
+            int sy = sy0 + y * syy;
+
+            for (x = 0, op = o->bits + y; x < w;
+                 x += BITMASK_W_LEN, op += h) {
+                word = 0;
+                n = MIN((int)BITMASK_W_LEN, w - x);
+                for (i = 0; i < n; i++) {
+                    if (bitmask_getbit(m, sx, sy)) {
+                        word |= BITMASK_N(i);
+                    }
+                    sx += sxx;
+                    sy += syx;
+                }
+                *op = word;
+            }
+        }
+    }
+    else {
+        double radangle = angle * .01745329251994329;
+        double sangle = sin(radangle);
+        double cangle = cos(radangle);
+        /* 16.16 fixed point overflows an int for masks over 32767 bits
+           wide, so the coordinates are kept in long long. */
+        long long cy = h / 2;
+        long long xd = ((long long)m->w - w) * 32768;
+        long long yd = ((long long)m->h - h) * 32768;
+        long long isin = (long long)(sangle * 65536);
+        long long icos = (long long)(cangle * 65536);
+        long long ax = ((long long)w << 15) -
+                       (long long)(cangle * (((long long)w - 1) << 15));
+        long long ay = ((long long)h << 15) -
+                       (long long)(sangle * (((long long)w - 1) << 15));
+        long long xmaxval = ((long long)m->w << 16) - 1;
+        long long ymaxval = ((long long)m->h << 16) - 1;
+
+        for (y = 0; y < h; y++) {
+            long long dx = (ax + (isin * (cy - y))) + xd;
+            long long dy = (ay - (icos * (cy - y))) + yd;
+
+            for (x = 0, op = o->bits + y; x < w;
+                 x += BITMASK_W_LEN, op += h) {
+                word = 0;
+                n = MIN((int)BITMASK_W_LEN, w - x);
+                for (i = 0; i < n; i++) {
+                    if (dx >= 0 && dy >= 0 && dx <= xmaxval &&
+                        dy <= ymaxval &&
+                        bitmask_getbit(m, (int)(dx >> 16), (int)(dy >> 16))) {
+                        word |= BITMASK_N(i);
+                    }
+                    dx += icos;
+                    dy += isin;
+                }
+                *op = word;
+            }
+        }
+    }
+
+    return o;
+}
+
 void
 bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *output,
                  int xoffset, int yoffset)
 {
-    int x, y;
-
     if (!a->h || !a->w || !b->h || !b->w || !output->h || !output->w) {
         return;
     }
 
+    /* The run based operations can't read from the output mask. */
+    if (output != a && output != b) {
+        bitmask_convolution_t conv;
+
+        if (bitmask_convolution_init(&conv, a, b, xoffset, yoffset) > 0) {
+            bitmask_compose(output, conv.ops, conv.nops, 0, INT_MAX);
+            bitmask_convolution_free(&conv);
+            return;
+        }
+    }
+
+    bitmask_convolve_bits(a, b, output, xoffset, yoffset);
+}
+
+void
+bitmask_convolve_bits(const bitmask_t *a, const bitmask_t *b,
+                      bitmask_t *output, int xoffset, int yoffset)
+{
+    int x, y;
+
     xoffset += b->w - 1;
     yoffset += b->h - 1;
 
@@ -1093,3 +1552,121 @@ bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *output,
             if (bitmask_getbit(b, x, y))
                 bitmask_draw(output, a, xoffset - x, yoffset - y);
 }
+
+int
+bitmask_convolution_init(bitmask_convolution_t *conv, const bitmask_t *a,
+                         const bitmask_t *b, int xoffset, int yoffset)
+{
+    int x, y, k, run, maxrun = 0, nruns = 0, nbits = 0, nops = 0;
+
+    memset(conv, 0, sizeof(bitmask_convolution_t));
+
+    if (!a->h || !a->w || !b->h || !b->w) {
+        return 0;
+    }
+
+    /* Count the runs to estimate the cost in draws of both methods. */
+    for (y = 0; y < b->h; y++) {
+        for (x = 0, run = 0; x <= b->w; x++) {
+            if (x < b->w && bitmask_getbit(b, x, y)) {
+                run++;
+                continue;
+            }
+
+            if (run) {
+                nruns++;
+                nbits += run;
+                maxrun = MAX(maxrun, run);
+                run = 0;
+            }
+        }
+    }
+
+    for (k = 1; ((long)1 << k) <= maxrun; k++)
+        ;
+
+    /* Each run takes up to 2 draws, plus one draw per dilated copy. */
+    if (nbits <= 2 * nruns + k - 1) {
+        return 0;
+    }
+
+    conv->ops = (bitmask_op_t *)malloc(sizeof(bitmask_op_t) * 2 * nruns);
+
+    if (!conv->ops) {
+        return -1;
+    }
+
+    conv->dilated[0] = (bitmask_t *)a;
+    conv->ndilated = k;
+
+    for (k = 1; k < conv->ndilated; k++) {
+        int step = 1 << (k - 1);
+
+        conv->dilated[k] = bitmask_create(a->w + 2 * step - 1, a->h);
+
+        if (!conv->dilated[k]) {
+            conv->ndilated = k;
+            bitmask_convolution_free(conv);
+            return -1;
+        }
+
+        bitmask_draw(conv->dilated[k], conv->dilated[k - 1], 0, 0);
+        bitmask_draw(conv->dilated[k], conv->dilated[k - 1], step, 0);
+    }
+
+    xoffset += b->w - 1;
+    yoffset += b->h - 1;
+
+    /* The bits x0 ... x0 + run - 1 of a row draw a at
+       xoffset - x0 - run + 1 ... xoffset - x0. */
+    for (y = 0; y < b->h; y++) {
+        for (x = 0, run = 0; x <= b->w; x++) {
+            int x0;
+
+            if (x < b->w && bitmask_getbit(b, x, y)) {
+                run++;
+                continue;
+            }
+
+            if (!run) {
+                continue;
+            }
+
+            x0 = xoffset - x + 1;
+
+            for (k = 0; (2 << k) <= run; k++)
+                ;
+
+            conv->ops[nops].mask = conv->dilated[k];
+            conv->ops[nops].xoffset = x0;
+            conv->ops[nops].yoffset = yoffset - y;
+            conv->ops[nops].op = BITMASK_OP_DRAW;
+            nops++;
+
+            if (run > (1 << k)) {
+                conv->ops[nops] = conv->ops[nops - 1];
+                conv->ops[nops].xoffset = x0 + run - (1 << k);
+                nops++;
+            }
+
+            run = 0;
+        }
+    }
+
+    conv->nops = nops;
+    return 1;
+}
+
+void
+bitmask_convolution_free(bitmask_convolution_t *conv)
+{
+    int k;
+
+    /* dilated[0] is borrowed. */
+    for (k = 1; k < conv->ndilated; k++) {
+        bitmask_free(conv->dilated[k]);
+    }
+
+    free(conv->ops);
+    memset(conv, 0, sizeof(bitmask_convolution_t));
+}
@@ -1512,6 +1512,7 @@ static int
 pg_flip_internal(_DisplayState *state)
 {
     SDL_Window *win = pg_GetDefaultWindow();
+    pgSurfaceObject *screen;
     int status = 0;
 
     /* Same check as VIDEO_INIT_CHECK() but returns -1 instead of NULL on
@@ -1560,6 +1561,11 @@ pg_flip_internal(_DisplayState *state)
         return -1;
     }
 
+    /* All of the surface is on the screen now */
+    screen = pg_GetDefaultWindowSurface();
+    if (screen)
+        pgSurface_TakeDamage(screen, NULL);
+
     return 0;
 }
 
@@ -1598,6 +1604,38 @@ pg_screencroprect(SDL_Rect *r, int w, int h, SDL_Rect *cur)
     return cur;
 }
 
+/* Updates the areas recorded on a display surface tracking damage, see
+ * Surface.set_damage_tracking(), then clears them. Flips all of the display
+ * when they are not known. */
+static PyObject *
+pg_update_damage(PyObject *self, SDL_Window *win, pgSurfaceObject *screen,
+                 int wide, int high)
+{
+    SDL_Rect damage[PG_DAMAGE_MAX_RECTS], rects[PG_DAMAGE_MAX_RECTS];
+    int i, damage_count, count = 0;
+
+    damage_count = pgSurface_TakeDamage(screen, damage);
+    if (damage_count < 0)
+        return pg_flip(self, NULL);
+
+    for (i = 0; i < damage_count; i++) {
+        if (pg_screencroprect(damage + i, wide, high, rects + count))
+            ++count;
+    }
+
+    if (count) {
+        int status;
+
+        Py_BEGIN_ALLOW_THREADS;
+        status = SDL_UpdateWindowSurfaceRects(win, rects, count);
+        Py_END_ALLOW_THREADS;
+
+        if (status < 0)
+            return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 pg_update(PyObject *self, PyObject *arg)
 {
@@ -1621,6 +1659,12 @@ pg_update(PyObject *self, PyObject *arg)
 
     /*determine type of argument we got*/
     if (PyTuple_Size(arg) == 0) {
+        pgSurfaceObject *screen = pg_GetDefaultWindowSurface();
+
+        /* A resized window needs the full flip to get its new surface */
+        if (screen && screen->surf == SDL_GetWindowSurface(win)) {
+            return pg_update_damage(self, win, screen, wide, high);
+        }
         return pg_flip(self, NULL);
     }
 
@@ -9,7 +9,36 @@
 #define DOC_PYGAMEDRAWLINES "lines(surface, color, closed, points) -> Rect\nlines(surface, color, closed, points, width=1) -> Rect\ndraw multiple contiguous straight line segments"
 #define DOC_PYGAMEDRAWAALINE "aaline(surface, color, start_pos, end_pos) -> Rect\naaline(surface, color, start_pos, end_pos, blend=1) -> Rect\ndraw a straight antialiased line"
 #define DOC_PYGAMEDRAWAALINES "aalines(surface, color, closed, points) -> Rect\naalines(surface, color, closed, points, blend=1) -> Rect\ndraw multiple contiguous straight antialiased line segments"
-
+#define DOC_PYGAMEDRAWLINESBATCH "lines_batch(surface, color, lines) -> Rect\nlines_batch(surface, color, lines, width=1) -> Rect\ndraw many separate straight lines"
+#define DOC_PYGAMEDRAWCIRCLES "circles(surface, color, centers, radius) -> Rect\ncircles(surface, color, centers, radius, width=0) -> Rect\ndraw many circles"
+#define DOC_PYGAMEDRAWRECTS "rects(surface, color, rects) -> Rect\nrects(surface, color, rects, width=0) -> Rect\ndraw many rectangles"
+#define DOC_PYGAMEDRAWAAPOLYGON "aapolygon(surface, color, points) -> Rect\naapolygon(surface, color, points, width=0) -> Rect\ndraw an antialiased polygon"
+#define DOC_PYGAMEDRAWAACIRCLE "aacircle(surface, color, center, radius) -> Rect\naacircle(surface, color, center, radius, width=0) -> Rect\ndraw an antialiased circle"
+#define DOC_PYGAMEDRAWAASTROKE "aastroke(surface, color, closed, points) -> Rect\naastroke(surface, color, closed, points, width=1) -> Rect\ndraw antialiased line segments of any width"
+#define DOC_PYGAMEDRAWFLOODFILL "flood_fill(surface, color, pos) -> Rect\nflood_fill(surface, color, pos, tolerance=0, mask=None) -> Rect\nfill a connected area of about the same color"
+#define DOC_PYGAMEDRAWPATH "Path() -> Path\npygame object for drawing the same outlines many times"
+#define DOC_PATHMOVETO "move_to(pos) -> None\nstart a new subpath"
+#define DOC_PATHLINETO "line_to(pos) -> None\nadd a straight line to the subpath"
+#define DOC_PATHQUADTO "quad_to(control, pos) -> None\nadd a quadratic bezier curve to the subpath"
+#define DOC_PATHCUBICTO "cubic_to(control1, control2, pos) -> None\nadd a cubic bezier curve to the subpath"
+#define DOC_PATHARC "arc(center, radius, start_angle, stop_angle) -> None\nadd a circular arc to the subpath"
+#define DOC_PATHCLOSE "close() -> None\nclose the subpath"
+#define DOC_PATHADDPOLYGON "add_polygon(points) -> None\nadd a polygon as a closed subpath"
+#define DOC_PATHADDRECT "add_rect(rect, border_radius=0) -> None\nadd a rectangle as a closed subpath"
+#define DOC_PATHADDCIRCLE "add_circle(center, radius) -> None\nadd a circle as a closed subpath"
+#define DOC_PATHCLEAR "clear() -> None\nremove all subpaths"
+#define DOC_PATHDRAW "draw(surface, color, pos=(0, 0), width=0) -> Rect\ndraw the path, filled or outlined"
+#define DOC_PYGAMEDRAWRENDERQUEUE "RenderQueue() -> RenderQueue\npygame object for recording drawing and running it in parallel"
+#define DOC_RENDERQUEUEFILL "fill(color, rect=None) -> None\nrecord filling the surface with a solid color"
+#define DOC_RENDERQUEUEBLIT "blit(source, dest, area=None, special_flags=0) -> None\nrecord drawing an image onto the surface"
+#define DOC_RENDERQUEUERECT "rect(color, rect, width=0) -> None\nrecord drawing a rectangle"
+#define DOC_RENDERQUEUELINE "line(color, start_pos, end_pos, width=1) -> None\nrecord drawing a straight line"
+#define DOC_RENDERQUEUELINES "lines(color, closed, points, width=1) -> None\nrecord drawing contiguous straight line segments"
+#define DOC_RENDERQUEUECIRCLE "circle(color, center, radius, width=0) -> None\nrecord drawing a circle"
+#define DOC_RENDERQUEUEPOLYGON "polygon(color, points, width=0) -> None\nrecord drawing a polygon"
+#define DOC_RENDERQUEUEPATH "path(path, color, pos=(0, 0), width=0) -> None\nrecord drawing a Path"
+#define DOC_RENDERQUEUECLEAR "clear() -> None\nremove all recorded commands"
+#define DOC_RENDERQUEUEEXECUTE "execute(surface) -> Rect\ndraw the recorded commands onto a surface"
 
 /* Docs in a comment... slightly easier to read. */
 
@@ -63,4 +92,131 @@ pygame.draw.aalines
  aalines(surface, color, closed, points, blend=1) -> Rect
 draw multiple contiguous straight antialiased line segments
 
-*/
\ No newline at end of file
+pygame.draw.lines_batch
+ lines_batch(surface, color, lines) -> Rect
+ lines_batch(surface, color, lines, width=1) -> Rect
+draw many separate straight lines
+
+pygame.draw.circles
+ circles(surface, color, centers, radius) -> Rect
+ circles(surface, color, centers, radius, width=0) -> Rect
+draw many circles
+
+pygame.draw.rects
+ rects(surface, color, rects) -> Rect
+ rects(surface, color, rects, width=0) -> Rect
+draw many rectangles
+
+pygame.draw.aapolygon
+ aapolygon(surface, color, points) -> Rect
+ aapolygon(surface, color, points, width=0) -> Rect
+draw an antialiased polygon
+
+pygame.draw.aacircle
+ aacircle(surface, color, center, radius) -> Rect
+ aacircle(surface, color, center, radius, width=0) -> Rect
+draw an antialiased circle
+
+pygame.draw.aastroke
+ aastroke(surface, color, closed, points) -> Rect
+ aastroke(surface, color, closed, points, width=1) -> Rect
+draw antialiased line segments of any width
+
+pygame.draw.flood_fill
+ flood_fill(surface, color, pos) -> Rect
+ flood_fill(surface, color, pos, tolerance=0, mask=None) -> Rect
+fill a connected area of about the same color
+
+pygame.draw.Path
+ Path() -> Path
+pygame object for drawing the same outlines many times
+
+pygame.draw.Path.move_to
+ move_to(pos) -> None
+start a new subpath
+
+pygame.draw.Path.line_to
+ line_to(pos) -> None
+add a straight line to the subpath
+
+pygame.draw.Path.quad_to
+ quad_to(control, pos) -> None
+add a quadratic bezier curve to the subpath
+
+pygame.draw.Path.cubic_to
+ cubic_to(control1, control2, pos) -> None
+add a cubic bezier curve to the subpath
+
+pygame.draw.Path.arc
+ arc(center, radius, start_angle, stop_angle) -> None
+add a circular arc to the subpath
+
+pygame.draw.Path.close
+ close() -> None
+close the subpath
+
+pygame.draw.Path.add_polygon
+ add_polygon(points) -> None
+add a polygon as a closed subpath
+
+pygame.draw.Path.add_rect
+ add_rect(rect, border_radius=0) -> None
+add a rectangle as a closed subpath
+
+pygame.draw.Path.add_circle
+ add_circle(center, radius) -> None
+add a circle as a closed subpath
+
+pygame.draw.Path.clear
+ clear() -> None
+remove all subpaths
+
+pygame.draw.Path.draw
+ draw(surface, color, pos=(0, 0), width=0) -> Rect
+draw the path, filled or outlined
+
+pygame.draw.RenderQueue
+ RenderQueue() -> RenderQueue
+pygame object for recording drawing and running it in parallel
+
+pygame.draw.RenderQueue.fill
+ fill(color, rect=None) -> None
+record filling the surface with a solid color
+
+pygame.draw.RenderQueue.blit
+ blit(source, dest, area=None, special_flags=0) -> None
+record drawing an image onto the surface
+
+pygame.draw.RenderQueue.rect
+ rect(color, rect, width=0) -> None
+record drawing a rectangle
+
+pygame.draw.RenderQueue.line
+ line(color, start_pos, end_pos, width=1) -> None
+record drawing a straight line
+
+pygame.draw.RenderQueue.lines
+ lines(color, closed, points, width=1) -> None
+record drawing contiguous straight line segments
+
+pygame.draw.RenderQueue.circle
+ circle(color, center, radius, width=0) -> None
+record drawing a circle
+
+pygame.draw.RenderQueue.polygon
+ polygon(color, points, width=0) -> None
+record drawing a polygon
+
+pygame.draw.RenderQueue.path
+ path(path, color, pos=(0, 0), width=0) -> None
+record drawing a Path
+
+pygame.draw.RenderQueue.clear
+ clear() -> None
+remove all recorded commands
+
+pygame.draw.RenderQueue.execute
+ execute(surface) -> Rect
+draw the recorded commands onto a surface
+
+*/
@@ -2,6 +2,7 @@
 #define DOC_PYGAMEEVENT "pygame module for interacting with events and queues"
 #define DOC_PYGAMEEVENTPUMP "pump() -> None\ninternally process pygame event handlers"
 #define DOC_PYGAMEEVENTGET "get(eventtype=None) -> Eventlist\nget(eventtype=None, pump=True) -> Eventlist\nget(eventtype=None, pump=True, exclude=None) -> Eventlist\nget events from the queue"
+#define DOC_PYGAMEEVENTGETINTO "get_into(buffer, pump=True, coalesce=False) -> int\nget events from the queue as records in a buffer"
 #define DOC_PYGAMEEVENTPOLL "poll() -> Event instance\nget a single event from the queue"
 #define DOC_PYGAMEEVENTWAIT "wait() -> Event instance\nwait(timeout) -> Event instance\nwait for a single event from the queue"
 #define DOC_PYGAMEEVENTPEEK "peek(eventtype=None) -> bool\npeek(eventtype=None, pump=True) -> bool\ntest if event types are waiting on the queue"
@@ -10,9 +11,13 @@
 #define DOC_PYGAMEEVENTSETBLOCKED "set_blocked(type) -> None\nset_blocked(typelist) -> None\nset_blocked(None) -> None\ncontrol which events are allowed on the queue"
 #define DOC_PYGAMEEVENTSETALLOWED "set_allowed(type) -> None\nset_allowed(typelist) -> None\nset_allowed(None) -> None\ncontrol which events are allowed on the queue"
 #define DOC_PYGAMEEVENTGETBLOCKED "get_blocked(type) -> bool\nget_blocked(typelist) -> bool\ntest if a type of event is blocked from the queue"
+#define DOC_PYGAMEEVENTSETCOALESCE "set_coalesce(type, coalesce=True) -> None\nset_coalesce(typelist, coalesce=True) -> None\nmerge consecutive motion events on the queue"
+#define DOC_PYGAMEEVENTSETRATELIMIT "set_rate_limit(type, rate=0) -> None\nset_rate_limit(typelist, rate=0) -> None\nlimit how many events of a type are queued per second"
+#define DOC_PYGAMEEVENTGETFILTERSTATS "get_filter_stats() -> (merged, dropped)\nget the number of events merged and dropped by the queue filters"
 #define DOC_PYGAMEEVENTSETGRAB "set_grab(bool) -> None\ncontrol the sharing of input devices with other applications"
 #define DOC_PYGAMEEVENTGETGRAB "get_grab() -> bool\ntest if the program is sharing input devices"
 #define DOC_PYGAMEEVENTPOST "post(Event) -> bool\nplace a new event on the queue"
+#define DOC_PYGAMEEVENTPOSTPAYLOAD "post_payload(type, payload=b'') -> bool\nplace an event with a few bytes of payload on the queue, from any thread"
 #define DOC_PYGAMEEVENTCUSTOMTYPE "custom_type() -> int\nmake custom user event type"
 #define DOC_PYGAMEEVENTEVENT "Event(type, dict) -> Event\nEvent(type, **attributes) -> Event\npygame object for representing events"
 #define DOC_EVENTTYPE "type -> int\nevent type identifier."
@@ -36,6 +41,10 @@ pygame.event.get
  get(eventtype=None, pump=True, exclude=None) -> Eventlist
 get events from the queue
 
+pygame.event.get_into
+ get_into(buffer, pump=True, coalesce=False) -> int
+get events from the queue as records in a buffer
+
 pygame.event.poll
  poll() -> Event instance
 get a single event from the queue
@@ -76,6 +85,20 @@ pygame.event.get_blocked
  get_blocked(typelist) -> bool
 test if a type of event is blocked from the queue
 
+pygame.event.set_coalesce
+ set_coalesce(type, coalesce=True) -> None
+ set_coalesce(typelist, coalesce=True) -> None
+merge consecutive motion events on the queue
+
+pygame.event.set_rate_limit
+ set_rate_limit(type, rate=0) -> None
+ set_rate_limit(typelist, rate=0) -> None
+limit how many events of a type are queued per second
+
+pygame.event.get_filter_stats
+ get_filter_stats() -> (merged, dropped)
+get the number of events merged and dropped by the queue filters
+
 pygame.event.set_grab
  set_grab(bool) -> None
 control the sharing of input devices with other applications
@@ -88,6 +111,10 @@ pygame.event.post
  post(Event) -> bool
 place a new event on the queue
 
+pygame.event.post_payload
+ post_payload(type, payload=b'') -> bool
+place an event with a few bytes of payload on the queue, from any thread
+
 pygame.event.custom_type
  custom_type() -> int
 make custom user event type
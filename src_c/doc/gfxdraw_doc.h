@@ -1,11 +1,13 @@
 /* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
 #define DOC_PYGAMEGFXDRAW "pygame module for drawing shapes"
 #define DOC_PYGAMEGFXDRAWPIXEL "pixel(surface, x, y, color) -> None\ndraw a pixel"
+#define DOC_PYGAMEGFXDRAWPIXELS "pixels(surface, points, color) -> None\ndraw many pixels of one color"
 #define DOC_PYGAMEGFXDRAWHLINE "hline(surface, x1, x2, y, color) -> None\ndraw a horizontal line"
 #define DOC_PYGAMEGFXDRAWVLINE "vline(surface, x, y1, y2, color) -> None\ndraw a vertical line"
 #define DOC_PYGAMEGFXDRAWLINE "line(surface, x1, y1, x2, y2, color) -> None\ndraw a line"
 #define DOC_PYGAMEGFXDRAWRECTANGLE "rectangle(surface, rect, color) -> None\ndraw a rectangle"
 #define DOC_PYGAMEGFXDRAWBOX "box(surface, rect, color) -> None\ndraw a filled rectangle"
+#define DOC_PYGAMEGFXDRAWBOXES "boxes(surface, rects, color) -> None\ndraw many filled rectangles of one color"
 #define DOC_PYGAMEGFXDRAWCIRCLE "circle(surface, x, y, r, color) -> None\ndraw a circle"
 #define DOC_PYGAMEGFXDRAWAACIRCLE "aacircle(surface, x, y, r, color) -> None\ndraw an antialiased circle"
 #define DOC_PYGAMEGFXDRAWFILLEDCIRCLE "filled_circle(surface, x, y, r, color) -> None\ndraw a filled circle"
@@ -21,6 +23,7 @@
 #define DOC_PYGAMEGFXDRAWAAPOLYGON "aapolygon(surface, points, color) -> None\ndraw an antialiased polygon"
 #define DOC_PYGAMEGFXDRAWFILLEDPOLYGON "filled_polygon(surface, points, color) -> None\ndraw a filled polygon"
 #define DOC_PYGAMEGFXDRAWTEXTUREDPOLYGON "textured_polygon(surface, points, texture, tx, ty) -> None\ndraw a textured polygon"
+#define DOC_PYGAMEGFXDRAWTEXTUREDTRIANGLES "textured_triangles(surface, texture, vertices, uvs, colors=None, indices=None, smooth=False) -> None\ndraw a mesh of textured triangles"
 #define DOC_PYGAMEGFXDRAWBEZIER "bezier(surface, points, steps, color) -> None\ndraw a Bezier curve"
 
 
@@ -35,6 +38,10 @@ pygame.gfxdraw.pixel
  pixel(surface, x, y, color) -> None
 draw a pixel
 
+pygame.gfxdraw.pixels
+ pixels(surface, points, color) -> None
+draw many pixels of one color
+
 pygame.gfxdraw.hline
  hline(surface, x1, x2, y, color) -> None
 draw a horizontal line
@@ -55,6 +62,10 @@ pygame.gfxdraw.box
  box(surface, rect, color) -> None
 draw a filled rectangle
 
+pygame.gfxdraw.boxes
+ boxes(surface, rects, color) -> None
+draw many filled rectangles of one color
+
 pygame.gfxdraw.circle
  circle(surface, x, y, r, color) -> None
 draw a circle
@@ -115,6 +126,10 @@ pygame.gfxdraw.textured_polygon
  textured_polygon(surface, points, texture, tx, ty) -> None
 draw a textured polygon
 
+pygame.gfxdraw.textured_triangles
+ textured_triangles(surface, texture, vertices, uvs, colors=None, indices=None, smooth=False) -> None
+draw a mesh of textured triangles
+
 pygame.gfxdraw.bezier
  bezier(surface, points, steps, color) -> None
 draw a Bezier curve
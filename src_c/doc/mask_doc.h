@@ -15,17 +15,26 @@
 #define DOC_MASKCLEAR "clear() -> None\nSets all bits to 0"
 #define DOC_MASKINVERT "invert() -> None\nFlips all the bits"
 #define DOC_MASKSCALE "scale((width, height)) -> Mask\nResizes a mask"
+#define DOC_MASKROTATE "rotate(angle) -> Mask\nRotates a mask"
 #define DOC_MASKDRAW "draw(other, offset) -> None\nDraws a mask onto another"
 #define DOC_MASKERASE "erase(other, offset) -> None\nErases a mask from another"
+#define DOC_MASKCOMPOSE "compose(operations) -> None\nDraws and erases many masks in one call"
 #define DOC_MASKCOUNT "count() -> bits\nReturns the number of set bits"
 #define DOC_MASKCENTROID "centroid() -> (x, y)\nReturns the centroid of the set bits"
 #define DOC_MASKANGLE "angle() -> theta\nReturns the orientation of the set bits"
 #define DOC_MASKOUTLINE "outline() -> [(x, y), ...]\noutline(every=1) -> [(x, y), ...]\nReturns a list of points outlining an object"
+#define DOC_MASKCONTOURS "contours() -> [(points, is_hole), ...]\ncontours(epsilon=0) -> [(points, is_hole), ...]\nReturns the outer and hole borders of all the objects"
 #define DOC_MASKCONVOLVE "convolve(other) -> Mask\nconvolve(other, output=None, offset=(0, 0)) -> Mask\nReturns the convolution of this mask with another mask"
+#define DOC_MASKDISTANCEFIELD "distance_field() -> BufferProxy\ndistance_field(format='f') -> BufferProxy\nReturns the distance from each bit to the nearest set bit"
 #define DOC_MASKCONNECTEDCOMPONENT "connected_component() -> Mask\nconnected_component(pos) -> Mask\nReturns a mask containing a connected component"
 #define DOC_MASKCONNECTEDCOMPONENTS "connected_components() -> [Mask, ...]\nconnected_components(minimum=0) -> [Mask, ...]\nReturns a list of masks of connected components"
 #define DOC_MASKGETBOUNDINGRECTS "get_bounding_rects() -> [Rect, ...]\nReturns a list of bounding rects of connected components"
 #define DOC_MASKTOSURFACE "to_surface() -> Surface\nto_surface(surface=None, setsurface=None, unsetsurface=None, setcolor=(255, 255, 255, 255), unsetcolor=(0, 0, 0, 255), dest=(0, 0)) -> Surface\nReturns a surface with the mask drawn on it"
+#define DOC_PYGAMEMASKROTATIONCACHE "RotationCache(mask, steps=360, max_bytes=67108864) -> RotationCache\npygame object holding precomputed rotations of a mask"
+#define DOC_ROTATIONCACHEGET "get(angle) -> Mask\nReturns the mask rotated to the nearest stored angle"
+#define DOC_ROTATIONCACHEQUANTIZE "quantize(angle) -> float\nReturns the stored angle nearest to the given angle"
+#define DOC_ROTATIONCACHESTEPS "steps -> int\nThe number of stored angles"
+#define DOC_ROTATIONCACHENBYTES "nbytes -> int\nThe number of bytes used by the stored masks"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -100,6 +109,10 @@ pygame.mask.Mask.scale
  scale((width, height)) -> Mask
 Resizes a mask
 
+pygame.mask.Mask.rotate
+ rotate(angle) -> Mask
+Rotates a mask
+
 pygame.mask.Mask.draw
  draw(other, offset) -> None
 Draws a mask onto another
@@ -108,6 +121,10 @@ pygame.mask.Mask.erase
  erase(other, offset) -> None
 Erases a mask from another
 
+pygame.mask.Mask.compose
+ compose(operations) -> None
+Draws and erases many masks in one call
+
 pygame.mask.Mask.count
  count() -> bits
 Returns the number of set bits
@@ -125,11 +142,21 @@ pygame.mask.Mask.outline
  outline(every=1) -> [(x, y), ...]
 Returns a list of points outlining an object
 
+pygame.mask.Mask.contours
+ contours() -> [(points, is_hole), ...]
+ contours(epsilon=0) -> [(points, is_hole), ...]
+Returns the outer and hole borders of all the objects
+
 pygame.mask.Mask.convolve
  convolve(other) -> Mask
  convolve(other, output=None, offset=(0, 0)) -> Mask
 Returns the convolution of this mask with another mask
 
+pygame.mask.Mask.distance_field
+ distance_field() -> BufferProxy
+ distance_field(format='f') -> BufferProxy
+Returns the distance from each bit to the nearest set bit
+
 pygame.mask.Mask.connected_component
  connected_component() -> Mask
  connected_component(pos) -> Mask
@@ -149,4 +176,24 @@ pygame.mask.Mask.to_surface
  to_surface(surface=None, setsurface=None, unsetsurface=None, setcolor=(255, 255, 255, 255), unsetcolor=(0, 0, 0, 255), dest=(0, 0)) -> Surface
 Returns a surface with the mask drawn on it
 
+pygame.mask.RotationCache
+ RotationCache(mask, steps=360, max_bytes=67108864) -> RotationCache
+pygame object holding precomputed rotations of a mask
+
+pygame.mask.RotationCache.get
+ get(angle) -> Mask
+Returns the mask rotated to the nearest stored angle
+
+pygame.mask.RotationCache.quantize
+ quantize(angle) -> float
+Returns the stored angle nearest to the given angle
+
+pygame.mask.RotationCache.steps
+ steps -> int
+The number of stored angles
+
+pygame.mask.RotationCache.nbytes
+ nbytes -> int
+The number of bytes used by the stored masks
+
 */
\ No newline at end of file
@@ -81,6 +81,72 @@
 #define DOC_VECTOR3CLAMPMAGNITUDE "clamp_magnitude(max_length) -> Vector3\nclamp_magnitude(min_length, max_length) -> Vector3\nReturns a copy of a vector with the magnitude clamped between max_length and min_length."
 #define DOC_VECTOR3CLAMPMAGNITUDEIP "clamp_magnitude_ip(max_length) -> None\nclamp_magnitude_ip(min_length, max_length) -> None\nClamps the vector's magnitude between max_length and min_length"
 #define DOC_VECTOR3UPDATE "update() -> None\nupdate(int) -> None\nupdate(float) -> None\nupdate(Vector3) -> None\nupdate(x, y, z) -> None\nupdate((x, y, z)) -> None\nSets the coordinates of the vector."
+#define DOC_PYGAMEMATHVECTOR2ARRAY "Vector2Array() -> Vector2Array\nVector2Array(int) -> Vector2Array\nVector2Array(vectors) -> Vector2Array\nVector2Array(buffer) -> Vector2Array\nan array of 2-Dimensional Vectors"
+#define DOC_VECTOR2ARRAYCOPY "copy() -> Vector2Array\nReturns a copy of the array."
+#define DOC_VECTOR2ARRAYLENGTH "length() -> array\nreturns the Euclidean length of each vector."
+#define DOC_VECTOR2ARRAYLENGTHSQUARED "length_squared() -> array\nreturns the squared Euclidean length of each vector."
+#define DOC_VECTOR2ARRAYDOT "dot(Vector2 or Vector2Array) -> array\ncalculates the dot- or scalar-product of each vector"
+#define DOC_VECTOR2ARRAYCROSS "cross(Vector2 or Vector2Array) -> array\ncalculates the cross- or vector-product of each vector"
+#define DOC_VECTOR2ARRAYDISTANCETO "distance_to(Vector2 or Vector2Array) -> array\ncalculates the Euclidean distance from each vector."
+#define DOC_VECTOR2ARRAYDISTANCESQUAREDTO "distance_squared_to(Vector2 or Vector2Array) -> array\ncalculates the squared Euclidean distance from each vector."
+#define DOC_VECTOR2ARRAYNORMALIZE "normalize() -> Vector2Array\nreturns an array of the vectors with length 1."
+#define DOC_VECTOR2ARRAYNORMALIZEIP "normalize_ip() -> None\nnormalizes each vector in place."
+#define DOC_VECTOR2ARRAYROTATE "rotate(angle) -> Vector2Array\nrotates each vector by the angle in degrees."
+#define DOC_VECTOR2ARRAYROTATEIP "rotate_ip(angle) -> None\nrotates each vector by the angle in degrees in place."
+#define DOC_VECTOR2ARRAYREFLECT "reflect(Vector2 or Vector2Array) -> Vector2Array\nreturns an array of the vectors reflected off the given normals."
+#define DOC_VECTOR2ARRAYREFLECTIP "reflect_ip(Vector2 or Vector2Array) -> None\nreflects each vector off the given normals in place."
+#define DOC_VECTOR2ARRAYLERP "lerp(Vector2 or Vector2Array, float) -> Vector2Array\nreturns a linear interpolation of each vector."
+#define DOC_VECTOR2ARRAYSLERP "slerp(Vector2 or Vector2Array, float) -> Vector2Array\nreturns a spherical interpolation of each vector."
+#define DOC_VECTOR2ARRAYMOVETOWARDS "move_towards(Vector2 or Vector2Array, float) -> Vector2Array\nreturns an array of the vectors moved towards the targets."
+#define DOC_VECTOR2ARRAYMOVETOWARDSIP "move_towards_ip(Vector2 or Vector2Array, float) -> None\nmoves each vector towards the targets in place."
+#define DOC_VECTOR2ARRAYCLAMPMAGNITUDE "clamp_magnitude(max_length) -> Vector2Array\nclamp_magnitude(min_length, max_length) -> Vector2Array\nReturns an array of the vectors with their magnitude clamped between max_length and min_length."
+#define DOC_VECTOR2ARRAYCLAMPMAGNITUDEIP "clamp_magnitude_ip(max_length) -> None\nclamp_magnitude_ip(min_length, max_length) -> None\nClamps the magnitude of each vector between max_length and min_length"
+#define DOC_PYGAMEMATHVECTOR3ARRAY "Vector3Array() -> Vector3Array\nVector3Array(int) -> Vector3Array\nVector3Array(vectors) -> Vector3Array\nVector3Array(buffer) -> Vector3Array\nan array of 3-Dimensional Vectors"
+#define DOC_VECTOR3ARRAYCOPY "copy() -> Vector3Array\nReturns a copy of the array."
+#define DOC_VECTOR3ARRAYLENGTH "length() -> array\nreturns the Euclidean length of each vector."
+#define DOC_VECTOR3ARRAYLENGTHSQUARED "length_squared() -> array\nreturns the squared Euclidean length of each vector."
+#define DOC_VECTOR3ARRAYDOT "dot(Vector3 or Vector3Array) -> array\ncalculates the dot- or scalar-product of each vector"
+#define DOC_VECTOR3ARRAYCROSS "cross(Vector3 or Vector3Array) -> Vector3Array\ncalculates the cross- or vector-product of each vector"
+#define DOC_VECTOR3ARRAYDISTANCETO "distance_to(Vector3 or Vector3Array) -> array\ncalculates the Euclidean distance from each vector."
+#define DOC_VECTOR3ARRAYDISTANCESQUAREDTO "distance_squared_to(Vector3 or Vector3Array) -> array\ncalculates the squared Euclidean distance from each vector."
+#define DOC_VECTOR3ARRAYNORMALIZE "normalize() -> Vector3Array\nreturns an array of the vectors with length 1."
+#define DOC_VECTOR3ARRAYNORMALIZEIP "normalize_ip() -> None\nnormalizes each vector in place."
+#define DOC_VECTOR3ARRAYROTATE "rotate(angle, Vector3) -> Vector3Array\nrotates each vector by the angle in degrees."
+#define DOC_VECTOR3ARRAYROTATEIP "rotate_ip(angle, Vector3) -> None\nrotates each vector by the angle in degrees in place."
+#define DOC_VECTOR3ARRAYREFLECT "reflect(Vector3 or Vector3Array) -> Vector3Array\nreturns an array of the vectors reflected off the given normals."
+#define DOC_VECTOR3ARRAYREFLECTIP "reflect_ip(Vector3 or Vector3Array) -> None\nreflects each vector off the given normals in place."
+#define DOC_VECTOR3ARRAYLERP "lerp(Vector3 or Vector3Array, float) -> Vector3Array\nreturns a linear interpolation of each vector."
+#define DOC_VECTOR3ARRAYSLERP "slerp(Vector3 or Vector3Array, float) -> Vector3Array\nreturns a spherical interpolation of each vector."
+#define DOC_VECTOR3ARRAYMOVETOWARDS "move_towards(Vector3 or Vector3Array, float) -> Vector3Array\nreturns an array of the vectors moved towards the targets."
+#define DOC_VECTOR3ARRAYMOVETOWARDSIP "move_towards_ip(Vector3 or Vector3Array, float) -> None\nmoves each vector towards the targets in place."
+#define DOC_VECTOR3ARRAYCLAMPMAGNITUDE "clamp_magnitude(max_length) -> Vector3Array\nclamp_magnitude(min_length, max_length) -> Vector3Array\nReturns an array of the vectors with their magnitude clamped between max_length and min_length."
+#define DOC_VECTOR3ARRAYCLAMPMAGNITUDEIP "clamp_magnitude_ip(max_length) -> None\nclamp_magnitude_ip(min_length, max_length) -> None\nClamps the magnitude of each vector between max_length and min_length"
+#define DOC_PYGAMEMATHMATRIX3 "Matrix3() -> Matrix3\nMatrix3(rows) -> Matrix3\na 3x3 transformation matrix for Vector2 points"
+#define DOC_MATRIX3FROMTRANSLATION "from_translation(Vector2) -> Matrix3\nreturns a matrix moving points by the given offset."
+#define DOC_MATRIX3FROMROTATION "from_rotation(angle) -> Matrix3\nreturns a matrix rotating points by the angle in degrees."
+#define DOC_MATRIX3FROMSCALE "from_scale(float) -> Matrix3\nfrom_scale(Vector2) -> Matrix3\nreturns a matrix scaling points by the given factors."
+#define DOC_MATRIX3COPY "copy() -> Matrix3\nReturns a copy of itself."
+#define DOC_MATRIX3DETERMINANT "determinant() -> float\nreturns the determinant of the matrix."
+#define DOC_MATRIX3INVERSE "inverse() -> Matrix3\nreturns the inverse of the matrix."
+#define DOC_MATRIX3TRANSPOSE "transpose() -> Matrix3\nreturns the transpose of the matrix."
+#define DOC_MATRIX3DECOMPOSE "decompose() -> (Vector2, float, Vector2)\nsplits the matrix into translation, rotation and scale."
+#define DOC_MATRIX3TRANSFORMPOINT "transform_point(Vector2) -> Vector2\nreturns the point transformed by the matrix."
+#define DOC_MATRIX3TRANSFORMVECTOR "transform_vector(Vector2) -> Vector2\nreturns the direction transformed by the matrix, without translation."
+#define DOC_MATRIX3TRANSFORMPOINTS "transform_points(points) -> Vector2Array\nreturns an array of the points transformed by the matrix."
+#define DOC_MATRIX3TRANSFORMPOINTSIP "transform_points_ip(buffer) -> None\ntransforms the points of an array or buffer in place."
+#define DOC_PYGAMEMATHMATRIX4 "Matrix4() -> Matrix4\nMatrix4(rows) -> Matrix4\na 4x4 transformation matrix for Vector3 points"
+#define DOC_MATRIX4FROMTRANSLATION "from_translation(Vector3) -> Matrix4\nreturns a matrix moving points by the given offset."
+#define DOC_MATRIX4FROMROTATION "from_rotation(angle, Vector3) -> Matrix4\nreturns a matrix rotating points by the angle in degrees."
+#define DOC_MATRIX4FROMSCALE "from_scale(float) -> Matrix4\nfrom_scale(Vector3) -> Matrix4\nreturns a matrix scaling points by the given factors."
+#define DOC_MATRIX4COPY "copy() -> Matrix4\nReturns a copy of itself."
+#define DOC_MATRIX4DETERMINANT "determinant() -> float\nreturns the determinant of the matrix."
+#define DOC_MATRIX4INVERSE "inverse() -> Matrix4\nreturns the inverse of the matrix."
+#define DOC_MATRIX4TRANSPOSE "transpose() -> Matrix4\nreturns the transpose of the matrix."
+#define DOC_MATRIX4DECOMPOSE "decompose() -> (Vector3, float, Vector3, Vector3)\nsplits the matrix into translation, rotation and scale."
+#define DOC_MATRIX4TRANSFORMPOINT "transform_point(Vector3) -> Vector3\nreturns the point transformed by the matrix."
+#define DOC_MATRIX4TRANSFORMVECTOR "transform_vector(Vector3) -> Vector3\nreturns the direction transformed by the matrix, without translation."
+#define DOC_MATRIX4TRANSFORMPOINTS "transform_points(points) -> Vector3Array\nreturns an array of the points transformed by the matrix."
+#define DOC_MATRIX4TRANSFORMPOINTSIP "transform_points_ip(buffer) -> None\ntransforms the points of an array or buffer in place."
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -438,4 +504,282 @@ pygame.math.Vector3.update
  update((x, y, z)) -> None
 Sets the coordinates of the vector.
 
-*/
\ No newline at end of file
+pygame.math.Vector2Array
+ Vector2Array() -> Vector2Array
+ Vector2Array(int) -> Vector2Array
+ Vector2Array(vectors) -> Vector2Array
+ Vector2Array(buffer) -> Vector2Array
+an array of 2-Dimensional Vectors
+
+pygame.math.Vector2Array.copy
+ copy() -> Vector2Array
+Returns a copy of the array.
+
+pygame.math.Vector2Array.length
+ length() -> array
+returns the Euclidean length of each vector.
+
+pygame.math.Vector2Array.length_squared
+ length_squared() -> array
+returns the squared Euclidean length of each vector.
+
+pygame.math.Vector2Array.dot
+ dot(Vector2 or Vector2Array) -> array
+calculates the dot- or scalar-product of each vector
+
+pygame.math.Vector2Array.cross
+ cross(Vector2 or Vector2Array) -> array
+calculates the cross- or vector-product of each vector
+
+pygame.math.Vector2Array.distance_to
+ distance_to(Vector2 or Vector2Array) -> array
+calculates the Euclidean distance from each vector.
+
+pygame.math.Vector2Array.distance_squared_to
+ distance_squared_to(Vector2 or Vector2Array) -> array
+calculates the squared Euclidean distance from each vector.
+
+pygame.math.Vector2Array.normalize
+ normalize() -> Vector2Array
+returns an array of the vectors with length 1.
+
+pygame.math.Vector2Array.normalize_ip
+ normalize_ip() -> None
+normalizes each vector in place.
+
+pygame.math.Vector2Array.rotate
+ rotate(angle) -> Vector2Array
+rotates each vector by the angle in degrees.
+
+pygame.math.Vector2Array.rotate_ip
+ rotate_ip(angle) -> None
+rotates each vector by the angle in degrees in place.
+
+pygame.math.Vector2Array.reflect
+ reflect(Vector2 or Vector2Array) -> Vector2Array
+returns an array of the vectors reflected off the given normals.
+
+pygame.math.Vector2Array.reflect_ip
+ reflect_ip(Vector2 or Vector2Array) -> None
+reflects each vector off the given normals in place.
+
+pygame.math.Vector2Array.lerp
+ lerp(Vector2 or Vector2Array, float) -> Vector2Array
+returns a linear interpolation of each vector.
+
+pygame.math.Vector2Array.slerp
+ slerp(Vector2 or Vector2Array, float) -> Vector2Array
+returns a spherical interpolation of each vector.
+
+pygame.math.Vector2Array.move_towards
+ move_towards(Vector2 or Vector2Array, float) -> Vector2Array
+returns an array of the vectors moved towards the targets.
+
+pygame.math.Vector2Array.move_towards_ip
+ move_towards_ip(Vector2 or Vector2Array, float) -> None
+moves each vector towards the targets in place.
+
+pygame.math.Vector2Array.clamp_magnitude
+ clamp_magnitude(max_length) -> Vector2Array
+ clamp_magnitude(min_length, max_length) -> Vector2Array
+Returns an array of the vectors with their magnitude clamped between max_length and min_length.
+
+pygame.math.Vector2Array.clamp_magnitude_ip
+ clamp_magnitude_ip(max_length) -> None
+ clamp_magnitude_ip(min_length, max_length) -> None
+Clamps the magnitude of each vector between max_length and min_length
+
+pygame.math.Vector3Array
+ Vector3Array() -> Vector3Array
+ Vector3Array(int) -> Vector3Array
+ Vector3Array(vectors) -> Vector3Array
+ Vector3Array(buffer) -> Vector3Array
+an array of 3-Dimensional Vectors
+
+pygame.math.Vector3Array.copy
+ copy() -> Vector3Array
+Returns a copy of the array.
+
+pygame.math.Vector3Array.length
+ length() -> array
+returns the Euclidean length of each vector.
+
+pygame.math.Vector3Array.length_squared
+ length_squared() -> array
+returns the squared Euclidean length of each vector.
+
+pygame.math.Vector3Array.dot
+ dot(Vector3 or Vector3Array) -> array
+calculates the dot- or scalar-product of each vector
+
+pygame.math.Vector3Array.cross
+ cross(Vector3 or Vector3Array) -> Vector3Array
+calculates the cross- or vector-product of each vector
+
+pygame.math.Vector3Array.distance_to
+ distance_to(Vector3 or Vector3Array) -> array
+calculates the Euclidean distance from each vector.
+
+pygame.math.Vector3Array.distance_squared_to
+ distance_squared_to(Vector3 or Vector3Array) -> array
+calculates the squared Euclidean distance from each vector.
+
+pygame.math.Vector3Array.normalize
+ normalize() -> Vector3Array
+returns an array of the vectors with length 1.
+
+pygame.math.Vector3Array.normalize_ip
+ normalize_ip() -> None
+normalizes each vector in place.
+
+pygame.math.Vector3Array.rotate
+ rotate(angle, Vector3) -> Vector3Array
+rotates each vector by the angle in degrees.
+
+pygame.math.Vector3Array.rotate_ip
+ rotate_ip(angle, Vector3) -> None
+rotates each vector by the angle in degrees in place.
+
+pygame.math.Vector3Array.reflect
+ reflect(Vector3 or Vector3Array) -> Vector3Array
+returns an array of the vectors reflected off the given normals.
+
+pygame.math.Vector3Array.reflect_ip
+ reflect_ip(Vector3 or Vector3Array) -> None
+reflects each vector off the given normals in place.
+
+pygame.math.Vector3Array.lerp
+ lerp(Vector3 or Vector3Array, float) -> Vector3Array
+returns a linear interpolation of each vector.
+
+pygame.math.Vector3Array.slerp
+ slerp(Vector3 or Vector3Array, float) -> Vector3Array
+returns a spherical interpolation of each vector.
+
+pygame.math.Vector3Array.move_towards
+ move_towards(Vector3 or Vector3Array, float) -> Vector3Array
+returns an array of the vectors moved towards the targets.
+
+pygame.math.Vector3Array.move_towards_ip
+ move_towards_ip(Vector3 or Vector3Array, float) -> None
+moves each vector towards the targets in place.
+
+pygame.math.Vector3Array.clamp_magnitude
+ clamp_magnitude(max_length) -> Vector3Array
+ clamp_magnitude(min_length, max_length) -> Vector3Array
+Returns an array of the vectors with their magnitude clamped between max_length and min_length.
+
+pygame.math.Vector3Array.clamp_magnitude_ip
+ clamp_magnitude_ip(max_length) -> None
+ clamp_magnitude_ip(min_length, max_length) -> None
+Clamps the magnitude of each vector between max_length and min_length
+
+pygame.math.Matrix3
+ Matrix3() -> Matrix3
+ Matrix3(rows) -> Matrix3
+a 3x3 transformation matrix for Vector2 points
+
+pygame.math.Matrix3.from_translation
+ from_translation(Vector2) -> Matrix3
+returns a matrix moving points by the given offset.
+
+pygame.math.Matrix3.from_rotation
+ from_rotation(angle) -> Matrix3
+returns a matrix rotating points by the angle in degrees.
+
+pygame.math.Matrix3.from_scale
+ from_scale(float) -> Matrix3
+ from_scale(Vector2) -> Matrix3
+returns a matrix scaling points by the given factors.
+
+pygame.math.Matrix3.copy
+ copy() -> Matrix3
+Returns a copy of itself.
+
+pygame.math.Matrix3.determinant
+ determinant() -> float
+returns the determinant of the matrix.
+
+pygame.math.Matrix3.inverse
+ inverse() -> Matrix3
+returns the inverse of the matrix.
+
+pygame.math.Matrix3.transpose
+ transpose() -> Matrix3
+returns the transpose of the matrix.
+
+pygame.math.Matrix3.decompose
+ decompose() -> (Vector2, float, Vector2)
+splits the matrix into translation, rotation and scale.
+
+pygame.math.Matrix3.transform_point
+ transform_point(Vector2) -> Vector2
+returns the point transformed by the matrix.
+
+pygame.math.Matrix3.transform_vector
+ transform_vector(Vector2) -> Vector2
+returns the direction transformed by the matrix, without translation.
+
+pygame.math.Matrix3.transform_points
+ transform_points(points) -> Vector2Array
+returns an array of the points transformed by the matrix.
+
+pygame.math.Matrix3.transform_points_ip
+ transform_points_ip(buffer) -> None
+transforms the points of an array or buffer in place.
+
+pygame.math.Matrix4
+ Matrix4() -> Matrix4
+ Matrix4(rows) -> Matrix4
+a 4x4 transformation matrix for Vector3 points
+
+pygame.math.Matrix4.from_translation
+ from_translation(Vector3) -> Matrix4
+returns a matrix moving points by the given offset.
+
+pygame.math.Matrix4.from_rotation
+ from_rotation(angle, Vector3) -> Matrix4
+returns a matrix rotating points by the angle in degrees.
+
+pygame.math.Matrix4.from_scale
+ from_scale(float) -> Matrix4
+ from_scale(Vector3) -> Matrix4
+returns a matrix scaling points by the given factors.
+
+pygame.math.Matrix4.copy
+ copy() -> Matrix4
+Returns a copy of itself.
+
+pygame.math.Matrix4.determinant
+ determinant() -> float
+returns the determinant of the matrix.
+
+pygame.math.Matrix4.inverse
+ inverse() -> Matrix4
+returns the inverse of the matrix.
+
+pygame.math.Matrix4.transpose
+ transpose() -> Matrix4
+returns the transpose of the matrix.
+
+pygame.math.Matrix4.decompose
+ decompose() -> (Vector3, float, Vector3, Vector3)
+splits the matrix into translation, rotation and scale.
+
+pygame.math.Matrix4.transform_point
+ transform_point(Vector3) -> Vector3
+returns the point transformed by the matrix.
+
+pygame.math.Matrix4.transform_vector
+ transform_vector(Vector3) -> Vector3
+returns the direction transformed by the matrix, without translation.
+
+pygame.math.Matrix4.transform_points
+ transform_points(points) -> Vector3Array
+returns an array of the points transformed by the matrix.
+
+pygame.math.Matrix4.transform_points_ip
+ transform_points_ip(buffer) -> None
+transforms the points of an array or buffer in place.
+
+*/
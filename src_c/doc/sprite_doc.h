@@ -20,6 +20,7 @@
 #define DOC_GROUPEMPTY "empty() -> None\nremove all Sprites"
 #define DOC_PYGAMESPRITERENDERPLAIN "Same as pygame.sprite.Group"
 #define DOC_PYGAMESPRITERENDERCLEAR "Same as pygame.sprite.Group"
+#define DOC_PYGAMESPRITEFASTGROUP "FastGroup(*sprites) -> FastGroup\nGroup that keeps its Sprites in native arrays."
 #define DOC_PYGAMESPRITERENDERUPDATES "RenderUpdates(*sprites) -> RenderUpdates\nGroup sub-class that tracks dirty updates."
 #define DOC_RENDERUPDATESDRAW "draw(surface) -> Rect_list\nblit the Sprite images and track changed areas"
 #define DOC_PYGAMESPRITEORDEREDUPDATES "OrderedUpdates(*spites) -> OrderedUpdates\nRenderUpdates sub-class that draws Sprites in order of addition."
@@ -40,6 +41,7 @@
 #define DOC_LAYEREDUPDATESGETTOPSPRITE "get_top_sprite() -> Sprite\nreturns the topmost sprite"
 #define DOC_LAYEREDUPDATESGETSPRITESFROMLAYER "get_sprites_from_layer(layer) -> sprites\nreturns all sprites from a layer, ordered by how they where added"
 #define DOC_LAYEREDUPDATESSWITCHLAYER "switch_layer(layer1_nr, layer2_nr) -> None\nswitches the sprites from layer1 to layer2"
+#define DOC_LAYEREDUPDATESSORTLAYERS "sort_layers(key) -> None\ngives every sprite the layer returned by key"
 #define DOC_PYGAMESPRITELAYEREDDIRTY "LayeredDirty(*spites, **kwargs) -> LayeredDirty\nLayeredDirty group is for DirtySprite objects.  Subclasses LayeredUpdates."
 #define DOC_LAYEREDDIRTYDRAW "draw(surface, bgd=None) -> Rect_list\ndraw all sprites in the right order onto the passed surface."
 #define DOC_LAYEREDDIRTYCLEAR "clear(surface, bgd) -> None\nused to set background"
@@ -145,6 +147,10 @@ Same as pygame.sprite.Group
 pygame.sprite.RenderClear
 Same as pygame.sprite.Group
 
+pygame.sprite.FastGroup
+ FastGroup(*sprites) -> FastGroup
+Group that keeps its Sprites in native arrays.
+
 pygame.sprite.RenderUpdates
  RenderUpdates(*sprites) -> RenderUpdates
 Group sub-class that tracks dirty updates.
@@ -225,6 +231,10 @@ pygame.sprite.LayeredUpdates.switch_layer
  switch_layer(layer1_nr, layer2_nr) -> None
 switches the sprites from layer1 to layer2
 
+pygame.sprite.LayeredUpdates.sort_layers
+ sort_layers(key) -> None
+gives every sprite the layer returned by key
+
 pygame.sprite.LayeredDirty
  LayeredDirty(*spites, **kwargs) -> LayeredDirty
 LayeredDirty group is for DirtySprite objects.  Subclasses LayeredUpdates.
@@ -7,6 +7,9 @@
 #define DOC_SURFACECOPY "copy() -> Surface\ncreate a new copy of a Surface"
 #define DOC_SURFACEFILL "fill(color, rect=None, special_flags=0) -> Rect\nfill Surface with a solid color"
 #define DOC_SURFACESCROLL "scroll(dx=0, dy=0) -> None\nShift the surface image in place"
+#define DOC_SURFACESETDAMAGETRACKING "set_damage_tracking(enable=True, max_rects=16) -> None\nRecord the areas drawn to on the Surface"
+#define DOC_SURFACEGETDAMAGE "get_damage() -> list\nGet the areas drawn to on the Surface"
+#define DOC_SURFACECLEARDAMAGE "clear_damage() -> None\nForget the areas drawn to on the Surface"
 #define DOC_SURFACESETCOLORKEY "set_colorkey(Color, flags=0) -> None\nset_colorkey(None) -> None\nSet the transparent colorkey"
 #define DOC_SURFACEGETCOLORKEY "get_colorkey() -> RGB or None\nGet the current transparent colorkey"
 #define DOC_SURFACESETALPHA "set_alpha(value, flags=0) -> None\nset_alpha(None) -> None\nset the alpha value for the full Surface image"
@@ -93,6 +96,18 @@ pygame.Surface.scroll
  scroll(dx=0, dy=0) -> None
 Shift the surface image in place
 
+pygame.Surface.set_damage_tracking
+ set_damage_tracking(enable=True, max_rects=16) -> None
+Record the areas drawn to on the Surface
+
+pygame.Surface.get_damage
+ get_damage() -> list
+Get the areas drawn to on the Surface
+
+pygame.Surface.clear_damage
+ clear_damage() -> None
+Forget the areas drawn to on the Surface
+
 pygame.Surface.set_colorkey
  set_colorkey(Color, flags=0) -> None
  set_colorkey(None) -> None
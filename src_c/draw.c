@@ -25,26 +25,118 @@
  */
 #include "pygame.h"
 
+#include "surface.h"
+
 #include "pgcompat.h"
 
+
+#include "include/pygame_mask.h"
+
 #include "doc/draw_doc.h"
 
 #include <math.h>
 
 #include <float.h>
 
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+/* arm64 has neon optimisations enabled by default, even when fpu=neon is not
+ * passed */
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define DRAW_SIMD
+#elif defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define DRAW_SIMD
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+/* Filled shapes covering more than DRAW_PARALLEL_MIN_PIXELS pixels of the
+ * clip area are drawn in bands of rows, one thread per band, with the GIL
+ * released. No band is given fewer than DRAW_BAND_MIN_PIXELS pixels. */
+#define DRAW_PARALLEL_MIN_PIXELS 0x40000
+#define DRAW_BAND_MIN_PIXELS 0x10000
+
+/* The outline of an antialiased shape: one or more closed contours. */
+typedef struct {
+    float *points;    /* x, y pairs of the points of every contour */
+    Py_ssize_t *ends; /* index in points of the end of each contour */
+    Py_ssize_t len, size;
+    Py_ssize_t n_contours, contours_size;
+    int failed;   /* set when out of memory */
+    int even_odd; /* filled with the even-odd rule, not the nonzero rule */
+} aa_path;
+
+/* Accumulation buffer for rasterizing an aa_path over an area of a
+ * surface. */
+typedef struct {
+    float *cells; /* h rows of w + 2 cells */
+    int x, y, w, h;
+} aa_raster;
+
+/* A run of len pixels of a rasterized aa_path, starting at (x, y). */
+typedef struct {
+    int x, y, len;
+    Py_ssize_t coverage; /* index of the coverage of each pixel in the run,
+                            or -1 when they are all fully covered */
+} aa_span;
+
+/* Paths are only rasterized within this distance of the origin. */
+#define AA_MAX_COORD 16777216.0f
+
+/* A rasterized aa_path, as the runs of pixels it covers. */
+typedef struct {
+    aa_span *spans;
+    Py_ssize_t n_spans, spans_size;
+    Uint8 *coverage; /* coverage, 1 to 255, of the pixels of some runs */
+    Py_ssize_t n_coverage, coverage_size;
+} aa_spans;
+
+/* A flood fill in progress: which pixels of the area match the color of
+ * the seed pixel, and which have been filled already. */
+typedef struct {
+    SDL_Surface *surf;
+    SDL_Rect area; /* the clip rect, no pixel outside of it is filled */
+    int bpp;
+    int n_channels;
+    Uint32 masks[4];
+    Uint8 shifts[4];
+    Uint8 *tables[4]; /* whether each value of a channel matches */
+    int bytewise;     /* 32 bit pixels of 8 bit channels: a pixel matches
+                         when each of its bytes is within low and high */
+    Uint32 low, high;
+    Uint32 *filled; /* one bit per pixel of the area, row by row */
+    int filled_pitch;
+    int *stack; /* x, y pairs of the seeds of the runs left to fill */
+    Py_ssize_t stack_len, stack_size;
+} flood_state;
+
+/* A non horizontal polygon edge, going down from (x1, y1) to (x2, y2). */
+typedef struct {
+    int x1, y1, x2, y2;
+} poly_edge;
+
 /* Declaration of drawing algorithms */
 static void
 draw_line_width(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2,
                 int y2, int width, int *drawn_area);
 static void
+draw_line_width_within(SDL_Surface *surf, const SDL_Rect *bounds,
+                       Uint32 color, int x1, int y1, int x2, int y2,
+                       int width, int *drawn_area);
+static void
 draw_line(SDL_Surface *surf, int x1, int y1, int x2, int y2, Uint32 color,
           int *drawn_area);
 static void
+draw_lines_thin(SDL_Surface *surf, const int *lines, Py_ssize_t n,
+                Uint32 color, const Uint32 *colors, int *drawn_area);
+static void
 draw_aaline(SDL_Surface *surf, Uint32 color, float startx, float starty,
             float endx, float endy, int blend, int *drawn_area);
 static void
@@ -73,13 +165,78 @@ draw_ellipse_thickness(SDL_Surface *surf, int x0, int y0, int width,
 static void
 draw_fillpoly(SDL_Surface *surf, int *vx, int *vy, Py_ssize_t n, Uint32 color,
               int *drawn_area);
+static Py_ssize_t
+draw_fillpoly_edges(const int *point_x, const int *point_y,
+                    Py_ssize_t num_points, poly_edge *edges);
+static void
+draw_fillpoly_rows(SDL_Surface *surf, Uint32 color, const poly_edge *edges,
+                   Py_ssize_t n_edges, int maxy, int ystart, int yend,
+                   const poly_edge **active, int *x_intersect,
+                   int *drawn_area);
+static void
+draw_fillpoly_borders(SDL_Surface *surf, Uint32 color, const int *point_x,
+                      const int *point_y, Py_ssize_t num_points, int miny,
+                      int maxy, int *drawn_area);
 static void
 draw_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int width,
           Uint32 color);
 static void
+draw_filled_rect(SDL_Surface *surf, const SDL_Rect *rect, Uint32 color);
+static void
 draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
                 int width, Uint32 color, int top_left, int top_right,
                 int bottom_left, int bottom_right, int *drawn_area);
+static void
+add_pixel_to_drawn_list(int x, int y, int *pts);
+static void
+drawhorzlineclipbounding(SDL_Surface *surf, Uint32 color, int x1, int y1,
+                         int x2, int *pts);
+static void
+draw_merge_bands(int (*band_areas)[4], int bands, int *drawn_area);
+static int
+sign(int x, int y);
+static int
+clip_line(const SDL_Rect *clip, int *x1, int *y1, int *x2, int *y2);
+static void
+set_and_check_rect(SDL_Surface *surf, int x, int y, Uint32 color,
+                   int *drawn_area);
+static int
+inside_clip(const SDL_Rect *clip, int x, int y);
+static void
+aa_path_add(aa_path *path, float x, float y);
+static void
+aa_path_close(aa_path *path);
+static void
+aa_path_circle(aa_path *path, float cx, float cy, float radius, int reverse);
+static void
+aa_path_stroke(aa_path *path, const float *xs, const float *ys,
+               Py_ssize_t n, int closed, float width);
+static void
+aa_path_arc(aa_path *path, float cx, float cy, float radius, double angle,
+            double sweep);
+static void
+aa_path_quad(aa_path *path, float x0, float y0, float x1, float y1, float x2,
+             float y2);
+static void
+aa_path_cubic(aa_path *path, float x0, float y0, float x1, float y1,
+              float x2, float y2, float x3, float y3);
+static void
+aa_path_free(aa_path *path);
+static void
+aa_path_bounds(const aa_path *path, SDL_Rect *bounds);
+static int
+aa_path_spans(aa_path *path, const SDL_Rect *area, aa_spans *spans);
+static void
+aa_spans_draw(const aa_spans *spans, SDL_Surface *surf, const Uint8 *rgba,
+              Uint32 color, int dx, int dy, int *drawn_area);
+static void
+aa_spans_free(aa_spans *spans);
+static int
+aa_path_draw(aa_path *path, SDL_Surface *surf, const Uint8 *rgba,
+             Uint32 color, int *drawn_area);
+static int
+draw_flood_fill(SDL_Surface *surf, int x, int y, Uint32 color, int paint,
+                int tolerance, bitmask_t *mask, int *drawn_area);
 
 // validation of a draw color
 #define CHECK_LOAD_COLOR(colorobj)                                         \
@@ -93,6 +250,27 @@ draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
 
 /* Definition of functions that get called in Python */
 
+/* Returns the Rect bounding drawn_area, or an empty Rect at (x, y) if nothing
+ * was drawn. The drawn area is recorded on surfaces tracking damage.
+ */
+static PyObject *
+drawn_rect(pgSurfaceObject *surfobj, int *drawn_area, int x, int y)
+{
+    SDL_Rect rect;
+
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN) {
+        rect.x = drawn_area[0];
+        rect.y = drawn_area[1];
+        rect.w = drawn_area[2] - drawn_area[0] + 1;
+        rect.h = drawn_area[3] - drawn_area[1] + 1;
+        pgSurface_AddDamage(surfobj, &rect);
+        return pgRect_New(&rect);
+    }
+    else
+        return pgRect_New4(x, y, 0, 0);
+}
+
 /* Draws an antialiased line on the given surface.
  *
  * Returns a Rect bounding the drawn area.
@@ -162,13 +340,7 @@ aaline(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4((int)startx, (int)starty, 0, 0);
+    return drawn_rect(surfobj, drawn_area, (int)startx, (int)starty);
 }
 
 /* Draws a line on the given surface.
@@ -230,13 +402,7 @@ line(PyObject *self, PyObject *arg, PyObject *kwargs)
     }
 
     /* Compute return rect. */
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(startx, starty, 0, 0);
+    return drawn_rect(surfobj, drawn_area, startx, starty);
 }
 
 /* Draws a series of antialiased lines on the given surface.
@@ -373,13 +539,7 @@ aalines(PyObject *self, PyObject *arg, PyObject *kwargs)
     }
 
     /* Compute return rect. */
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(l, t, 0, 0);
+    return drawn_rect(surfobj, drawn_area, l, t);
 }
 
 /* Draws a series of lines on the given surface.
@@ -500,13 +660,7 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
     }
 
     /* Compute return rect. */
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(x, y, 0, 0);
+    return drawn_rect(surfobj, drawn_area, x, y);
 }
 
 static PyObject *
@@ -578,13 +732,7 @@ arc(PyObject *self, PyObject *arg, PyObject *kwargs)
     }
 
     /* Compute return rect. */
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(rect->x, rect->y, 0, 0);
+    return drawn_rect(surfobj, drawn_area, rect->x, rect->y);
 }
 
 static PyObject *
@@ -645,13 +793,7 @@ ellipse(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(rect->x, rect->y, 0, 0);
+    return drawn_rect(surfobj, drawn_area, rect->x, rect->y);
 }
 
 static PyObject *
@@ -740,13 +882,7 @@ circle(PyObject *self, PyObject *args, PyObject *kwargs)
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(posx, posy, 0, 0);
+    return drawn_rect(surfobj, drawn_area, posx, posy);
 }
 
 static PyObject *
@@ -854,13 +990,7 @@ polygon(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(l, t, 0, 0);
+    return drawn_rect(surfobj, drawn_area, l, t);
 }
 
 static PyObject *
@@ -946,6 +1076,7 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
             if (result != 0)
                 return RAISE(pgExc_SDLError, SDL_GetError());
         }
+        pgSurface_AddDamage(surfobj, &clipped);
         return pgRect_New(&clipped);
     }
     else {
@@ -977,1491 +1108,6588 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
         }
     }
 
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(rect->x, rect->y, 0, 0);
+    return drawn_rect(surfobj, drawn_area, rect->x, rect->y);
 }
 
-/* Functions used in drawing algorithms */
+/* Loading the arguments of the batch drawing functions. */
 
-static void
-swap(float *a, float *b)
+/* Returns 'i', 'u' or 'f' for a buffer format holding signed integers,
+ * unsigned integers or floating point numbers in native byte order, or 0 for
+ * any other format.
+ */
+static char
+batch_format_kind(const char *format, Py_ssize_t itemsize)
 {
-    float temp = *a;
-    *a = *b;
-    *b = temp;
+    if (!format) {
+        return itemsize == 1 ? 'u' : 0; /* NULL means "B" */
+    }
+
+    switch (*format) {
+        case '@':
+        case '=':
+            ++format;
+            break;
+        case '<':
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            if (itemsize > 1) {
+                return 0;
+            }
+#endif
+            ++format;
+            break;
+        case '>':
+        case '!':
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            if (itemsize > 1) {
+                return 0;
+            }
+#endif
+            ++format;
+            break;
+    }
+
+    if (format[0] == '\0' || format[1] != '\0') {
+        return 0;
+    }
+
+    switch (format[0]) {
+        case 'b':
+        case 'h':
+        case 'i':
+        case 'l':
+        case 'q':
+        case 'n':
+            return (itemsize == 1 || itemsize == 2 || itemsize == 4 ||
+                    itemsize == 8)
+                       ? 'i'
+                       : 0;
+        case 'B':
+        case 'H':
+        case 'I':
+        case 'L':
+        case 'Q':
+        case 'N':
+            return (itemsize == 1 || itemsize == 2 || itemsize == 4 ||
+                    itemsize == 8)
+                       ? 'u'
+                       : 0;
+        case 'f':
+        case 'd':
+            return (itemsize == 4 || itemsize == 8) ? 'f' : 0;
+    }
+    return 0;
 }
 
-static int
-compare_int(const void *a, const void *b)
+/* Reads one buffer item of the given kind and size as a double. 8 byte
+ * integers beyond 2**53 lose precision, which doesn't matter once they are
+ * clamped to a smaller range.
+ */
+static double
+batch_buffer_double(const char *ptr, char kind, Py_ssize_t itemsize)
 {
-    return (*(const int *)a) - (*(const int *)b);
+    if (kind == 'f') {
+        if (itemsize == 4) {
+            float f;
+            memcpy(&f, ptr, sizeof(f));
+            return f;
+        }
+        else {
+            double d;
+            memcpy(&d, ptr, sizeof(d));
+            return d;
+        }
+    }
+
+    switch (itemsize) {
+        case 1:
+            return kind == 'i' ? (double)*(Sint8 *)ptr : (double)*(Uint8 *)ptr;
+        case 2: {
+            Uint16 u;
+            memcpy(&u, ptr, sizeof(u));
+            return kind == 'i' ? (double)(Sint16)u : (double)u;
+        }
+        case 4: {
+            Uint32 u;
+            memcpy(&u, ptr, sizeof(u));
+            return kind == 'i' ? (double)(Sint32)u : (double)u;
+        }
+        default: /* case 8: */ {
+            Uint64 u;
+            memcpy(&u, ptr, sizeof(u));
+            return kind == 'i' ? (double)(Sint64)u : (double)u;
+        }
+    }
 }
 
+/* Reads one buffer item of the given kind and size as an int. Floating point
+ * values are truncated, as pg_IntFromObj() does, and values outside the int
+ * range are clamped to it.
+ */
 static int
-sign(int x, int y)
+batch_buffer_int(const char *ptr, char kind, Py_ssize_t itemsize)
 {
-    return (x > 0) ? 1 : ((x < 0) ? -1 : y);
+    double d = batch_buffer_double(ptr, kind, itemsize);
+
+    if (!(d > INT_MIN)) { /* Also catches NaN. */
+        return INT_MIN;
+    }
+    return d < INT_MAX ? (int)d : INT_MAX;
 }
 
+/* Reads one buffer item of the given kind and size as a mapped color, the
+ * way batch_buffer_int() reads ints, but clamped to the Uint32 range.
+ */
 static Uint32
-get_antialiased_color(SDL_Surface *surf, int x, int y, Uint32 original_color,
-                      float brightness, int blend)
+batch_buffer_color(const char *ptr, char kind, Py_ssize_t itemsize)
 {
-    Uint8 color_part[4], background_color[4];
-    Uint32 *pixels = (Uint32 *)surf->pixels;
-    SDL_GetRGBA(original_color, surf->format, &color_part[0], &color_part[1],
-                &color_part[2], &color_part[3]);
-    if (blend) {
-        if (x < surf->clip_rect.x ||
-            x >= surf->clip_rect.x + surf->clip_rect.w ||
-            y < surf->clip_rect.y ||
-            y >= surf->clip_rect.y + surf->clip_rect.h)
-            return original_color;
-        SDL_GetRGBA(pixels[(y * surf->w) + x], surf->format,
-                    &background_color[0], &background_color[1],
-                    &background_color[2], &background_color[3]);
-        color_part[0] = (Uint8)(brightness * color_part[0] +
-                                (1 - brightness) * background_color[0]);
-        color_part[1] = (Uint8)(brightness * color_part[1] +
-                                (1 - brightness) * background_color[1]);
-        color_part[2] = (Uint8)(brightness * color_part[2] +
-                                (1 - brightness) * background_color[2]);
-        color_part[3] = (Uint8)(brightness * color_part[3] +
-                                (1 - brightness) * background_color[3]);
-    }
-    else {
-        color_part[0] = (Uint8)(brightness * color_part[0]);
-        color_part[1] = (Uint8)(brightness * color_part[1]);
-        color_part[2] = (Uint8)(brightness * color_part[2]);
-        color_part[3] = (Uint8)(brightness * color_part[3]);
+    double d = batch_buffer_double(ptr, kind, itemsize);
+
+    if (!(d > 0)) { /* Also catches NaN. */
+        return 0;
     }
-    original_color = SDL_MapRGBA(surf->format, color_part[0], color_part[1],
-                                 color_part[2], color_part[3]);
-    return original_color;
+    return d < 0xFFFFFFFF ? (Uint32)d : 0xFFFFFFFF;
 }
 
-static void
-add_pixel_to_drawn_list(int x, int y, int *pts)
+/* Reads a buffer of shape (n, columns), or (n,) when columns is 1, into a new
+ * int array of n * columns values. When *columns is 0 any shape of one or two
+ * dimensions is read, and *columns is set to the number of columns found.
+ * If mapped_colors is set, the values of a buffer of one column are mapped
+ * colors, read with batch_buffer_color() and stored as the bits of a Uint32.
+ *
+ * Returns n, or -1 with an exception set. The array is freed with
+ * PyMem_Free().
+ */
+static Py_ssize_t
+batch_ints_from_buffer(PyObject *obj, int *columns, int **values,
+                       const char *name, int mapped_colors)
 {
-    if (x < pts[0]) {
-        pts[0] = x;
+    Py_buffer view;
+    Py_ssize_t n, i, j, cols, stride;
+    char kind;
+    int *out;
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_RECORDS_RO) == -1) {
+        return -1;
     }
-    if (y < pts[1]) {
-        pts[1] = y;
+
+    cols = view.ndim == 2 ? view.shape[1] : 1;
+    if ((view.ndim != 1 && view.ndim != 2) ||
+        (*columns && cols != *columns) || cols > INT_MAX) {
+        if (*columns == 1) {
+            PyErr_Format(PyExc_ValueError,
+                         "%s buffer must have shape (n,)", name);
+        }
+        else if (*columns) {
+            PyErr_Format(PyExc_ValueError,
+                         "%s buffer must have shape (n, %d)", name, *columns);
+        }
+        else {
+            PyErr_Format(PyExc_ValueError,
+                         "%s buffer must have one or two dimensions", name);
+        }
+        PyBuffer_Release(&view);
+        return -1;
     }
-    if (x > pts[2]) {
-        pts[2] = x;
+
+    kind = batch_format_kind(view.format, view.itemsize);
+    if (!kind) {
+        PyErr_Format(PyExc_ValueError, "unsupported %s buffer format '%s'",
+                     name, view.format ? view.format : "B");
+        PyBuffer_Release(&view);
+        return -1;
     }
-    if (y > pts[3]) {
-        pts[3] = y;
+
+    n = view.shape[0];
+    stride = view.ndim == 2 ? view.strides[1] : 0;
+    out = PyMem_New(int, n * cols > 0 ? n * cols : 1);
+    if (!out) {
+        PyBuffer_Release(&view);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (i = 0; i < n; i++) {
+        const char *row = (const char *)view.buf + i * view.strides[0];
+
+        if (mapped_colors && cols == 1) {
+            Uint32 color = batch_buffer_color(row, kind, view.itemsize);
+            memcpy(out + i, &color, sizeof(color));
+            continue;
+        }
+        for (j = 0; j < cols; j++) {
+            out[i * cols + j] =
+                batch_buffer_int(row + j * stride, kind, view.itemsize);
+        }
     }
+
+    PyBuffer_Release(&view);
+    *columns = (int)cols;
+    *values = out;
+    return n;
 }
 
-static int
-clip_line(SDL_Surface *surf, int *x1, int *y1, int *x2, int *y2)
+/* Reads the items of a batch call into a new int array of n * columns
+ * values. obj is either an object exporting a buffer of shape (n, columns),
+ * like a numpy array, or a sequence of n items. Sequence items are numbers
+ * when columns is 1, pairs of numbers when it is 2 and anything
+ * pgRect_FromObject() takes when it is 4.
+ *
+ * Returns n, or -1 with an exception set. The array is freed with
+ * PyMem_Free().
+ */
+static Py_ssize_t
+batch_ints_from_obj(PyObject *obj, int columns, int **values,
+                    const char *name)
 {
-    int p1 = *x1 - *x2;
-    int p2 = -p1;
-    int p3 = *y1 - *y2;
-    int p4 = -p3;
-    int q1 = *x1 - surf->clip_rect.x;
-    int q2 = surf->clip_rect.w + surf->clip_rect.x - *x1;
-    int q3 = *y1 - surf->clip_rect.y;
-    int q4 = surf->clip_rect.h + surf->clip_rect.y - *y1;
-    int old_x1 = *x1;
-    int old_y1 = *y1;
-    double nmax = 0;
-    double pmin = 1;
-    double r1, r2;
-    if ((p1 == 0 && q1 < 0) || (p2 == 0 && q2 < 0) || (p3 == 0 && q3 < 0) ||
-        (p4 == 0 && q4 < 0))
-        return 0;
-    if (p1) {
-        r1 = (double)q1 / p1;
-        r2 = (double)q2 / p2;
-        if (p1 < 0) {
-            if (r1 > nmax)
-                nmax = r1;
-            if (r2 < pmin)
-                pmin = r2;
+    PyObject *seq, *item;
+    SDL_Rect *rect, temp;
+    Py_ssize_t n, i;
+    int *out, *value;
+    int ok;
+
+    if (PyObject_CheckBuffer(obj)) {
+        return batch_ints_from_buffer(obj, &columns, values, name, 0);
+    }
+
+    if (!PySequence_Check(obj) || !(seq = PySequence_Fast(obj, ""))) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s argument must be a sequence or a buffer", name);
+        return -1;
+    }
+
+    n = PySequence_Fast_GET_SIZE(seq);
+    out = PyMem_New(int, n * columns > 0 ? n * columns : 1);
+    if (!out) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (i = 0; i < n; i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        value = out + i * columns;
+
+        if (columns == 1) {
+            ok = pg_IntFromObj(item, value);
         }
-        else {
-            if (r2 > nmax)
-                nmax = r2;
-            if (r1 < pmin)
-                pmin = r1;
+        else if (columns == 2) {
+            ok = pg_TwoIntsFromObj(item, value, value + 1);
         }
-    }
-    if (p3) {
-        r1 = (double)q3 / p3;
-        r2 = (double)q4 / p4;
-        if (p3 < 0) {
-            if (r1 > nmax)
-                nmax = r1;
-            if (r2 < pmin)
-                pmin = r2;
+        else if ((ok = (rect = pgRect_FromObject(item, &temp)) != NULL)) {
+            value[0] = rect->x;
+            value[1] = rect->y;
+            value[2] = rect->w;
+            value[3] = rect->h;
         }
-        else {
-            if (r2 > nmax)
-                nmax = r2;
-            if (r1 < pmin)
-                pmin = r1;
+
+        if (!ok) {
+            PyErr_Format(PyExc_TypeError,
+                         "%s argument has an invalid item at index %zd", name,
+                         i);
+            PyMem_Free(out);
+            Py_DECREF(seq);
+            return -1;
         }
     }
-    if (nmax > pmin)
-        return 0;
-    *x1 =
-        old_x1 + (int)(p2 * nmax < 0 ? (p2 * nmax - 0.5) : (p2 * nmax + 0.5));
-    *y1 =
-        old_y1 + (int)(p4 * nmax < 0 ? (p4 * nmax - 0.5) : (p4 * nmax + 0.5));
-    *x2 =
-        old_x1 + (int)(p2 * pmin < 0 ? (p2 * pmin - 0.5) : (p2 * pmin + 0.5));
-    *y2 =
-        old_y1 + (int)(p4 * pmin < 0 ? (p4 * pmin - 0.5) : (p4 * pmin + 0.5));
-    return 1;
+
+    Py_DECREF(seq);
+    *values = out;
+    return n;
 }
 
+/* Loads the color argument of a batch call drawing n items. This is either
+ * one color for all items, or a color per item given as a buffer of shape
+ * (n, 3) or (n, 4) holding RGB(A) values, a buffer of shape (n,) holding
+ * mapped colors or a sequence of n colors.
+ *
+ * On success *colors is NULL when a single color was given, which is stored
+ * in *color, or else a new array of n mapped colors, to be freed with
+ * PyMem_Free(). Returns 0, or -1 with an exception set.
+ */
 static int
-set_at(SDL_Surface *surf, int x, int y, Uint32 color)
+batch_colors_from_obj(PyObject *obj, SDL_Surface *surf, Py_ssize_t n,
+                      Uint32 *color, Uint32 **colors)
 {
-    SDL_PixelFormat *format = surf->format;
-    Uint8 *pixels = (Uint8 *)surf->pixels;
-    Uint8 *byte_buf, rgb[4];
+    PyObject *seq, *item;
+    Py_ssize_t count, i;
+    Uint32 *out;
+    Uint8 rgba[4];
+    int *values, columns = 0;
 
-    if (x < surf->clip_rect.x || x >= surf->clip_rect.x + surf->clip_rect.w ||
-        y < surf->clip_rect.y || y >= surf->clip_rect.y + surf->clip_rect.h)
+    *colors = NULL;
+
+    /* A single color. A tuple or list holding numbers is an RGB(A) value,
+     * not a sequence of mapped colors. */
+    if (PyLong_Check(obj)) {
+        *color = (Uint32)PyLong_AsLong(obj);
+        if (*color == (Uint32)-1 && PyErr_Occurred()) {
+            return -1;
+        }
         return 0;
+    }
+    if (PyObject_TypeCheck(obj, (PyTypeObject *)&pgColor_Type) ||
+        PyUnicode_Check(obj) ||
+        ((PyTuple_Check(obj) || PyList_Check(obj)) &&
+         PySequence_Fast_GET_SIZE(obj) > 0 &&
+         (PyLong_Check(PySequence_Fast_GET_ITEM(obj, 0)) ||
+          PyFloat_Check(PySequence_Fast_GET_ITEM(obj, 0))))) {
+        if (!pg_RGBAFromFuzzyColorObj(obj, rgba)) {
+            return -1; /* Exception already set. */
+        }
+        *color = SDL_MapRGBA(surf->format, rgba[0], rgba[1], rgba[2], rgba[3]);
+        return 0;
+    }
 
-    switch (format->BytesPerPixel) {
-        case 1:
-            *((Uint8 *)pixels + y * surf->pitch + x) = (Uint8)color;
-            break;
-        case 2:
-            *((Uint16 *)(pixels + y * surf->pitch) + x) = (Uint16)color;
-            break;
-        case 4:
-            *((Uint32 *)(pixels + y * surf->pitch) + x) = color;
-            break;
-        default: /*case 3:*/
-            SDL_GetRGB(color, format, rgb, rgb + 1, rgb + 2);
-            byte_buf = (Uint8 *)(pixels + y * surf->pitch) + x * 3;
-#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-            *(byte_buf + (format->Rshift >> 3)) = rgb[0];
-            *(byte_buf + (format->Gshift >> 3)) = rgb[1];
-            *(byte_buf + (format->Bshift >> 3)) = rgb[2];
-#else
-            *(byte_buf + 2 - (format->Rshift >> 3)) = rgb[0];
-            *(byte_buf + 2 - (format->Gshift >> 3)) = rgb[1];
-            *(byte_buf + 2 - (format->Bshift >> 3)) = rgb[2];
-#endif
-            break;
+    if (PyObject_CheckBuffer(obj)) {
+        count = batch_ints_from_buffer(obj, &columns, &values, "color", 1);
+        if (count == -1) {
+            return -1;
+        }
+        if (count != n || (columns != 1 && columns != 3 && columns != 4)) {
+            PyErr_Format(PyExc_ValueError,
+                         "color buffer must have shape (%zd,), (%zd, 3) or "
+                         "(%zd, 4)",
+                         n, n, n);
+            PyMem_Free(values);
+            return -1;
+        }
+
+        out = PyMem_New(Uint32, n ? n : 1);
+        if (!out) {
+            PyMem_Free(values);
+            PyErr_NoMemory();
+            return -1;
+        }
+
+        for (i = 0; i < n; i++) {
+            int *value = values + i * columns;
+
+            if (columns == 1) {
+                memcpy(out + i, value, sizeof(Uint32));
+                continue;
+            }
+            if (value[0] < 0 || value[0] > 255 || value[1] < 0 ||
+                value[1] > 255 || value[2] < 0 || value[2] > 255 ||
+                (columns == 4 && (value[3] < 0 || value[3] > 255))) {
+                PyErr_Format(PyExc_ValueError,
+                             "invalid color value at index %zd", i);
+                PyMem_Free(values);
+                PyMem_Free(out);
+                return -1;
+            }
+            out[i] = SDL_MapRGBA(surf->format, (Uint8)value[0],
+                                 (Uint8)value[1], (Uint8)value[2],
+                                 columns == 4 ? (Uint8)value[3] : 255);
+        }
+
+        PyMem_Free(values);
+        *colors = out;
+        return 0;
     }
-    return 1;
-}
 
-static void
-set_and_check_rect(SDL_Surface *surf, int x, int y, Uint32 color,
-                   int *drawn_area)
-{
-    if (set_at(surf, x, y, color))
-        add_pixel_to_drawn_list(x, y, drawn_area);
+    if (!PySequence_Check(obj) || !(seq = PySequence_Fast(obj, ""))) {
+        PyErr_SetString(PyExc_TypeError,
+                        "color argument must be a color, a sequence of "
+                        "colors or a buffer");
+        return -1;
+    }
+
+    if (PySequence_Fast_GET_SIZE(seq) != n) {
+        PyErr_Format(PyExc_ValueError, "expected %zd colors, got %zd", n,
+                     PySequence_Fast_GET_SIZE(seq));
+        Py_DECREF(seq);
+        return -1;
+    }
+
+    out = PyMem_New(Uint32, n ? n : 1);
+    if (!out) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (i = 0; i < n; i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+
+        if (PyLong_Check(item)) {
+            out[i] = (Uint32)PyLong_AsLong(item);
+            if (out[i] == (Uint32)-1 && PyErr_Occurred()) {
+                PyMem_Free(out);
+                Py_DECREF(seq);
+                return -1;
+            }
+        }
+        else if (pg_RGBAFromFuzzyColorObj(item, rgba)) {
+            out[i] =
+                SDL_MapRGBA(surf->format, rgba[0], rgba[1], rgba[2], rgba[3]);
+        }
+        else {
+            PyMem_Free(out);
+            Py_DECREF(seq);
+            return -1; /* pg_RGBAFromFuzzyColorObj sets the exception */
+        }
+    }
+
+    Py_DECREF(seq);
+    *colors = out;
+    return 0;
 }
 
-static void
-draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
-            float to_x, float to_y, int blend, int *drawn_area)
+/* Draws many lines on the given surface, locking it only once.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+lines_batch(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    float gradient, dx, dy, intersect_y, brightness;
-    int x, x_pixel_start, x_pixel_end;
-    Uint32 pixel_color;
-    float x_gap, y_endpoint, clip_left, clip_right, clip_top, clip_bottom;
-    int steep, y;
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *linesobj, *ret;
+    SDL_Surface *surf = NULL;
+    Uint32 color, *colors = NULL;
+    int *values = NULL;
+    Py_ssize_t n, i;
+    int width = 1; /* Default width. */
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    static char *keywords[] = {"surface", "color", "lines", "width", NULL};
 
-    dx = to_x - from_x;
-    dy = to_y - from_y;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &linesobj, &width)) {
+        return NULL; /* Exception already set. */
+    }
 
-    /* Single point.
-     * A line with length 0 is drawn as a single pixel at full brightness. */
-    if (fabs(dx) < 0.0001 && fabs(dy) < 0.0001) {
-        pixel_color =
-            get_antialiased_color(surf, (int)floor(from_x + 0.5),
-                                  (int)floor(from_y + 0.5), color, 1, blend);
-        set_and_check_rect(surf, (int)floor(from_x + 0.5),
-                           (int)floor(from_y + 0.5), pixel_color, drawn_area);
-        return;
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
     }
 
-    /* To draw correctly the pixels at the border of the clipping area when
-     * the line crosses it, we need to clip it one pixel wider in all four
-     * directions: */
-    clip_left = (float)surf->clip_rect.x - 1.0f;
-    clip_right = (float)clip_left + surf->clip_rect.w + 1.0f;
-    clip_top = (float)surf->clip_rect.y - 1.0f;
-    clip_bottom = (float)clip_top + surf->clip_rect.h + 1.0f;
+    n = batch_ints_from_obj(linesobj, 4, &values, "lines");
+    if (n == -1) {
+        return NULL;
+    }
 
-    steep = fabs(dx) < fabs(dy);
-    if (steep) {
-        swap(&from_x, &from_y);
-        swap(&to_x, &to_y);
-        swap(&dx, &dy);
-        swap(&clip_left, &clip_top);
-        swap(&clip_right, &clip_bottom);
+    if (batch_colors_from_obj(colorobj, surf, n, &color, &colors) == -1) {
+        PyMem_Free(values);
+        return NULL;
     }
-    if (dx < 0) {
-        swap(&from_x, &to_x);
-        swap(&from_y, &to_y);
-        dx = -dx;
-        dy = -dy;
+
+    if (n && width >= 1) {
+        if (!pgSurface_Lock(surfobj)) {
+            PyMem_Free(values);
+            PyMem_Free(colors);
+            return RAISE(PyExc_RuntimeError, "error locking surface");
+        }
+
+        if (width == 1) {
+            draw_lines_thin(surf, values, n, color, colors, drawn_area);
+        }
+        else {
+            for (i = 0; i < n; i++) {
+                draw_line_width(surf, colors ? colors[i] : color,
+                                values[4 * i], values[4 * i + 1],
+                                values[4 * i + 2], values[4 * i + 3], width,
+                                drawn_area);
+            }
+        }
+
+        if (!pgSurface_Unlock(surfobj)) {
+            PyMem_Free(values);
+            PyMem_Free(colors);
+            return RAISE(PyExc_RuntimeError, "error unlocking surface");
+        }
     }
 
-    if (to_x <= clip_left || from_x >= clip_right) {
-        /* The line is completly to the side of the surface */
-        return;
+    ret = drawn_rect(surfobj, drawn_area, n ? values[0] : 0,
+                     n ? values[1] : 0);
+    PyMem_Free(values);
+    PyMem_Free(colors);
+    return ret;
+}
+
+/* Draws many circles on the given surface, locking it only once.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+circles(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *centersobj, *radiusobj, *ret;
+    SDL_Surface *surf = NULL;
+    Uint32 color, *colors = NULL;
+    int *centers = NULL, *radii = NULL;
+    int radius = 0;
+    Py_ssize_t n, nradii, i;
+    int width = 0; /* Default width. */
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    static char *keywords[] = {"surface", "color", "centers",
+                               "radius",  "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &centersobj, &radiusobj, &width)) {
+        return NULL; /* Exception already set. */
     }
 
-    /* Note. There is no need to guard against a division by zero here. If dx
-     * was zero then either we had a single point (and we've returned) or it
-     * has been swapped with a non-zero dy. */
-    gradient = dy / dx;
+    surf = pgSurface_AsSurface(surfobj);
 
-    /* No need to waste CPU cycles on pixels not on the surface. */
-    if (from_x < clip_left) {
-        from_y += gradient * (clip_left - from_x);
-        from_x = clip_left;
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
     }
-    if (to_x > clip_right) {
-        to_y += gradient * (clip_right - to_x);
-        to_x = clip_right;
+
+    n = batch_ints_from_obj(centersobj, 2, &centers, "centers");
+    if (n == -1) {
+        return NULL;
     }
 
-    if (gradient > 0.0f) {
-        /* from_ is the topmost endpoint */
-        if (to_y <= clip_top || from_y >= clip_bottom) {
-            /* The line does not enter the surface */
-            return;
-        }
-        if (from_y < clip_top) {
-            from_x += (clip_top - from_y) / gradient;
-            from_y = clip_top;
-        }
-        if (to_y > clip_bottom) {
-            to_x += (clip_bottom - to_y) / gradient;
-            to_y = clip_bottom;
+    if (PyLong_Check(radiusobj) || PyFloat_Check(radiusobj)) {
+        if (!pg_IntFromObj(radiusobj, &radius)) {
+            PyMem_Free(centers);
+            return RAISE(PyExc_TypeError, "radius argument must be a number");
         }
     }
     else {
-        /* to_ is the topmost endpoint */
-        if (from_y <= clip_top || to_y >= clip_bottom) {
-            /* The line does not enter the surface */
-            return;
-        }
-        if (to_y < clip_top) {
-            to_x += (clip_top - to_y) / gradient;
-            to_y = clip_top;
-        }
-        if (from_y > clip_bottom) {
-            from_x += (clip_bottom - from_y) / gradient;
-            from_y = clip_bottom;
+        nradii = batch_ints_from_obj(radiusobj, 1, &radii, "radius");
+        if (nradii != n) {
+            if (nradii != -1) {
+                PyErr_Format(PyExc_ValueError, "expected %zd radii, got %zd",
+                             n, nradii);
+                PyMem_Free(radii);
+            }
+            PyMem_Free(centers);
+            return NULL;
         }
     }
-    /* By moving the points one pixel down, we can assume y is never negative.
-     * That permit us to use (int)y to round down intead of having to use
-     * floor(y). We then draw the pixels one higher.*/
-    from_y += 1.0f;
-    to_y += 1.0f;
 
-    /* Handle endpoints separatly.
-     * The line is not a mathematical line of thickness zero. The same
-     * goes for the endpoints. The have a height and width of one pixel. */
-    /* First endpoint */
-    x_pixel_start = (int)from_x;
-    y_endpoint = intersect_y = from_y + gradient * (x_pixel_start - from_x);
-    if (to_x > clip_left + 1.0f) {
-        x_gap = 1 + x_pixel_start - from_x;
-        brightness = y_endpoint - (int)y_endpoint;
-        if (steep) {
-            x = (int)y_endpoint;
-            y = x_pixel_start;
-        }
-        else {
-            x = x_pixel_start;
-            y = (int)y_endpoint;
-        }
-        if ((int)y_endpoint < y_endpoint) {
-            pixel_color = get_antialiased_color(surf, x, y, color,
-                                                brightness * x_gap, blend);
-            set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+    if (batch_colors_from_obj(colorobj, surf, n, &color, &colors) == -1) {
+        PyMem_Free(centers);
+        PyMem_Free(radii);
+        return NULL;
+    }
+
+    if (n && width >= 0) {
+        if (!pgSurface_Lock(surfobj)) {
+            PyMem_Free(centers);
+            PyMem_Free(radii);
+            PyMem_Free(colors);
+            return RAISE(PyExc_RuntimeError, "error locking surface");
         }
-        if (steep) {
-            x--;
+
+        for (i = 0; i < n; i++) {
+            int r = radii ? radii[i] : radius;
+            int w = MIN(width, r);
+            Uint32 c = colors ? colors[i] : color;
+
+            if (r < 1) {
+                continue;
+            }
+            if (!w || w == r) {
+                draw_circle_filled(surf, centers[2 * i], centers[2 * i + 1],
+                                   r, c, drawn_area);
+            }
+            else if (w == 1) {
+                draw_circle_bresenham_thin(surf, centers[2 * i],
+                                           centers[2 * i + 1], r, c,
+                                           drawn_area);
+            }
+            else {
+                draw_circle_bresenham(surf, centers[2 * i],
+                                      centers[2 * i + 1], r, w, c,
+                                      drawn_area);
+            }
         }
-        else {
-            y--;
+
+        if (!pgSurface_Unlock(surfobj)) {
+            PyMem_Free(centers);
+            PyMem_Free(radii);
+            PyMem_Free(colors);
+            return RAISE(PyExc_RuntimeError, "error unlocking surface");
         }
-        brightness = 1 - brightness;
-        pixel_color = get_antialiased_color(surf, x, y, color,
-                                            brightness * x_gap, blend);
-        set_and_check_rect(surf, x, y, pixel_color, drawn_area);
-        intersect_y += gradient;
-        x_pixel_start++;
     }
-    /* Second endpoint */
-    x_pixel_end = (int)ceil(to_x);
-    if (from_x < clip_right - 1.0f) {
-        y_endpoint = to_y + gradient * (x_pixel_end - to_x);
-        x_gap = 1 - x_pixel_end + to_x;
-        brightness = y_endpoint - (int)y_endpoint;
-        if (steep) {
-            x = (int)y_endpoint;
-            y = x_pixel_end;
-        }
-        else {
-            x = x_pixel_end;
-            y = (int)y_endpoint;
-        }
-        if ((int)y_endpoint < y_endpoint) {
-            pixel_color = get_antialiased_color(surf, x, y, color,
-                                                brightness * x_gap, blend);
-            set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+
+    ret = drawn_rect(surfobj, drawn_area, n ? centers[0] : 0,
+                     n ? centers[1] : 0);
+    PyMem_Free(centers);
+    PyMem_Free(radii);
+    PyMem_Free(colors);
+    return ret;
+}
+
+/* Draws many rectangles on the given surface, locking it only once.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+rects(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *rectsobj, *ret;
+    SDL_Surface *surf = NULL;
+    SDL_Rect sdlrect, clipped;
+    Uint32 color, *colors = NULL;
+    int *values = NULL;
+    Py_ssize_t n, i;
+    int width = 0; /* Default width. */
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    static char *keywords[] = {"surface", "color", "rects", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &rectsobj, &width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    n = batch_ints_from_obj(rectsobj, 4, &values, "rects");
+    if (n == -1) {
+        return NULL;
+    }
+
+    if (batch_colors_from_obj(colorobj, surf, n, &color, &colors) == -1) {
+        PyMem_Free(values);
+        return NULL;
+    }
+
+    if (n && width >= 0) {
+        if (!pgSurface_Lock(surfobj)) {
+            PyMem_Free(values);
+            PyMem_Free(colors);
+            return RAISE(PyExc_RuntimeError, "error locking surface");
         }
-        if (steep) {
-            x--;
+
+        for (i = 0; i < n; i++) {
+            Uint32 c = colors ? colors[i] : color;
+
+            sdlrect.x = values[4 * i];
+            sdlrect.y = values[4 * i + 1];
+            sdlrect.w = values[4 * i + 2];
+            sdlrect.h = values[4 * i + 3];
+
+            /* Same as rect(): only the clipped area is drawn and returned. */
+            if (!SDL_IntersectRect(&sdlrect, &surf->clip_rect, &clipped)) {
+                continue;
+            }
+            if (width > 0 && (width * 2) < clipped.w &&
+                (width * 2) < clipped.h) {
+                draw_rect(surf, sdlrect.x, sdlrect.y,
+                          sdlrect.x + sdlrect.w - 1, sdlrect.y + sdlrect.h - 1,
+                          width, c);
+            }
+            else {
+                draw_filled_rect(surf, &clipped, c);
+            }
+            add_pixel_to_drawn_list(clipped.x, clipped.y, drawn_area);
+            add_pixel_to_drawn_list(clipped.x + clipped.w - 1,
+                                    clipped.y + clipped.h - 1, drawn_area);
         }
-        else {
-            y--;
+
+        if (!pgSurface_Unlock(surfobj)) {
+            PyMem_Free(values);
+            PyMem_Free(colors);
+            return RAISE(PyExc_RuntimeError, "error unlocking surface");
         }
-        brightness = 1 - brightness;
-        pixel_color = get_antialiased_color(surf, x, y, color,
-                                            brightness * x_gap, blend);
-        set_and_check_rect(surf, x, y, pixel_color, drawn_area);
     }
 
-    /* main line drawing loop */
-    for (x = x_pixel_start; x < x_pixel_end; x++) {
-        y = (int)intersect_y;
-        if (steep) {
-            brightness = 1 - intersect_y + y;
-            pixel_color = get_antialiased_color(surf, y - 1, x, color,
-                                                brightness, blend);
-            set_and_check_rect(surf, y - 1, x, pixel_color, drawn_area);
-            if (y < intersect_y) {
-                brightness = 1 - brightness;
-                pixel_color = get_antialiased_color(surf, y, x, color,
-                                                    brightness, blend);
-                set_and_check_rect(surf, y, x, pixel_color, drawn_area);
-            }
-        }
-        else {
-            brightness = 1 - intersect_y + y;
-            pixel_color = get_antialiased_color(surf, x, y - 1, color,
-                                                brightness, blend);
-            set_and_check_rect(surf, x, y - 1, pixel_color, drawn_area);
-            if (y < intersect_y) {
-                brightness = 1 - brightness;
-                pixel_color = get_antialiased_color(surf, x, y, color,
-                                                    brightness, blend);
-                set_and_check_rect(surf, x, y, pixel_color, drawn_area);
-            }
+    ret = drawn_rect(surfobj, drawn_area, n ? values[0] : 0,
+                     n ? values[1] : 0);
+    PyMem_Free(values);
+    PyMem_Free(colors);
+    return ret;
+}
+
+/* Loading the arguments of the antialiased shape functions. */
+
+/* Loads color, returning its mapped value in *color and its RGBA value in
+ * rgba.
+ *
+ * Returns 1, or 0 with an exception set.
+ */
+static int
+aa_color_from_obj(PyObject *colorobj, SDL_Surface *surf, Uint8 *rgba,
+                  Uint32 *color)
+{
+    if (PyLong_Check(colorobj)) {
+        *color = (Uint32)PyLong_AsLong(colorobj);
+        if (*color == (Uint32)-1 && PyErr_Occurred()) {
+            return 0;
         }
-        intersect_y += gradient;
+        SDL_GetRGBA(*color, surf->format, rgba, rgba + 1, rgba + 2,
+                    rgba + 3);
+    }
+    else if (pg_RGBAFromFuzzyColorObj(colorobj, rgba)) {
+        *color =
+            SDL_MapRGBA(surf->format, rgba[0], rgba[1], rgba[2], rgba[3]);
     }
+    else {
+        return 0; /* pg_RGBAFromFuzzyColorObj sets the exception for us */
+    }
+    return 1;
 }
 
-static void
-drawhorzline(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
+/* Loads a sequence of at least min_points number pairs into a new array of
+ * the x values followed by the y values, to be freed with PyMem_Free(). The
+ * points are moved to the pixel centers: the point (x, y) is the center of
+ * the pixel covering (x, y) to (x + 1, y + 1).
+ *
+ * Returns the number of points, or -1 with an exception set.
+ */
+static Py_ssize_t
+aa_points_from_obj(PyObject *points, Py_ssize_t min_points, float **xs,
+                   const char *too_few)
 {
-    Uint8 *pixel, *end;
+    PyObject *item;
+    Py_ssize_t length, i;
+    float *values, x, y;
+    int result;
 
-    if (x1 == x2) {
-        return;
+    if (!PySequence_Check(points)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "points argument must be a sequence of number pairs");
+        return -1;
     }
 
-    pixel = ((Uint8 *)surf->pixels) + surf->pitch * y1;
-    if (x1 < x2) {
-        end = pixel + x2 * surf->format->BytesPerPixel;
-        pixel += x1 * surf->format->BytesPerPixel;
+    length = PySequence_Length(points);
+    if (length < min_points) {
+        PyErr_SetString(PyExc_ValueError, too_few);
+        return -1;
     }
-    else {
-        end = pixel + x1 * surf->format->BytesPerPixel;
-        pixel += x2 * surf->format->BytesPerPixel;
+
+    values = PyMem_New(float, 2 * length);
+    if (!values) {
+        PyErr_NoMemory();
+        return -1;
     }
-    switch (surf->format->BytesPerPixel) {
-        case 1:
-            for (; pixel <= end; ++pixel) {
-                *pixel = (Uint8)color;
-            }
-            break;
-        case 2:
-            for (; pixel <= end; pixel += 2) {
-                *(Uint16 *)pixel = (Uint16)color;
-            }
-            break;
-        case 3:
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-            color <<= 8;
-#endif
-            for (; pixel <= end; pixel += 3) {
-                memcpy(pixel, &color, 3 * sizeof(Uint8));
-            }
-            break;
-        default: /*case 4*/
-            for (; pixel <= end; pixel += 4) {
-                *(Uint32 *)pixel = color;
-            }
-            break;
+
+    for (i = 0; i < length; i++) {
+        item = PySequence_GetItem(points, i);
+        result = item && pg_TwoFloatsFromObj(item, &x, &y);
+        Py_XDECREF(item);
+
+        if (!result) {
+            PyMem_Free(values);
+            PyErr_SetString(PyExc_TypeError, "points must be number pairs");
+            return -1;
+        }
+        if (!isfinite(x) || !isfinite(y)) {
+            PyMem_Free(values);
+            PyErr_SetString(PyExc_ValueError, "points must be finite");
+            return -1;
+        }
+        values[i] = x + 0.5f;
+        values[length + i] = y + 0.5f;
     }
+
+    *xs = values;
+    return length;
 }
 
-static void
-drawhorzlineclip(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
+/* Draws the contours of path with an antialiased edge, and frees it.
+ *
+ * Returns a Rect bounding the drawn area, or an empty Rect at (x, y) if
+ * nothing was drawn.
+ */
+static PyObject *
+aa_draw_and_free_path(pgSurfaceObject *surfobj, aa_path *path,
+                      const Uint8 *rgba, Uint32 color, int x, int y)
 {
-    if (y1 < surf->clip_rect.y || y1 >= surf->clip_rect.y + surf->clip_rect.h)
-        return;
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    int result;
 
-    if (x2 < x1) {
-        int temp = x1;
-        x1 = x2;
-        x2 = temp;
+    if (!pgSurface_Lock(surfobj)) {
+        aa_path_free(path);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
-    x1 = MAX(x1, surf->clip_rect.x);
-    x2 = MIN(x2, surf->clip_rect.x + surf->clip_rect.w - 1);
+    result = aa_path_draw(path, surf, rgba, color, drawn_area);
+    aa_path_free(path);
 
-    if (x2 < surf->clip_rect.x || x1 >= surf->clip_rect.x + surf->clip_rect.w)
-        return;
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
 
-    if (x1 == x2) {
-        set_at(surf, x1, y1, color);
-        return;
+    if (result == -1) {
+        return PyErr_NoMemory();
     }
-    drawhorzline(surf, color, x1, y1, x2);
+
+    return drawn_rect(surfobj, drawn_area, x, y);
 }
 
-static void
-drawhorzlineclipbounding(SDL_Surface *surf, Uint32 color, int x1, int y1,
-                         int x2, int *pts)
+/* Draws an antialiased polygon, filled or outlined, on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+aapolygon(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    if (y1 < surf->clip_rect.y || y1 >= surf->clip_rect.y + surf->clip_rect.h)
-        return;
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *points;
+    SDL_Surface *surf = NULL;
+    aa_path path = {NULL, NULL, 0, 0, 0, 0, 0, 0};
+    Uint8 rgba[4];
+    Uint32 color;
+    float *xs, width = 0.0f; /* Default width. */
+    Py_ssize_t length, i;
+    int x, y;
+    static char *keywords[] = {"surface", "color", "points", "width", NULL};
 
-    if (x2 < x1) {
-        int temp = x1;
-        x1 = x2;
-        x2 = temp;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|f", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &points, &width)) {
+        return NULL; /* Exception already set. */
     }
 
-    x1 = MAX(x1, surf->clip_rect.x);
-    x2 = MIN(x2, surf->clip_rect.x + surf->clip_rect.w - 1);
+    surf = pgSurface_AsSurface(surfobj);
 
-    if (x2 < surf->clip_rect.x || x1 >= surf->clip_rect.x + surf->clip_rect.w)
-        return;
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
 
-    if (x1 == x2) {
-        set_and_check_rect(surf, x1, y1, color, pts);
-        return;
+    if (!aa_color_from_obj(colorobj, surf, rgba, &color)) {
+        return NULL;
     }
 
-    add_pixel_to_drawn_list(x1, y1, pts);
-    add_pixel_to_drawn_list(x2, y1, pts);
+    if (!isfinite(width)) {
+        return RAISE(PyExc_ValueError, "width argument must be finite");
+    }
 
-    drawhorzline(surf, color, x1, y1, x2);
+    length = aa_points_from_obj(points, 3, &xs,
+                                "points argument must contain more than 2 "
+                                "points");
+    if (length == -1) {
+        return NULL;
+    }
+    x = (int)(xs[0] - 0.5f);
+    y = (int)(xs[length] - 0.5f);
+
+    if (width < 0) {
+        PyMem_Free(xs);
+        return pgRect_New4(x, y, 0, 0);
+    }
+
+    if (width > 0) {
+        aa_path_stroke(&path, xs, xs + length, length, 1, width);
+    }
+    else {
+        /* Same fill rule as polygon(). */
+        path.even_odd = 1;
+        for (i = 0; i < length; i++) {
+            aa_path_add(&path, xs[i], xs[length + i]);
+        }
+        aa_path_close(&path);
+    }
+    PyMem_Free(xs);
+
+    return aa_draw_and_free_path(surfobj, &path, rgba, color, x, y);
 }
 
-int
-inside_clip(SDL_Surface *surf, int x, int y)
+/* Draws an antialiased circle, filled or outlined, on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+aacircle(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    if (x < surf->clip_rect.x || x >= surf->clip_rect.x + surf->clip_rect.w ||
-        y < surf->clip_rect.y || y >= surf->clip_rect.y + surf->clip_rect.h)
-        return 0;
-    return 1;
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *posobj, *radiusobj;
+    SDL_Surface *surf = NULL;
+    aa_path path = {NULL, NULL, 0, 0, 0, 0, 0, 0};
+    Uint8 rgba[4];
+    Uint32 color;
+    float posx, posy, radius, width = 0.0f; /* Default width. */
+    static char *keywords[] = {"surface", "color", "center",
+                               "radius",  "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO|f", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &posobj, &radiusobj, &width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!pg_TwoFloatsFromObj(posobj, &posx, &posy)) {
+        return RAISE(PyExc_TypeError,
+                     "center argument must be a pair of numbers");
+    }
+
+    if (!pg_FloatFromObj(radiusobj, &radius)) {
+        return RAISE(PyExc_TypeError, "radius argument must be a number");
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    if (!aa_color_from_obj(colorobj, surf, rgba, &color)) {
+        return NULL;
+    }
+
+    if (!isfinite(posx) || !isfinite(posy) || !isfinite(radius) ||
+        !isfinite(width)) {
+        return RAISE(PyExc_ValueError,
+                     "center, radius and width arguments must be finite");
+    }
+
+    if (radius <= 0 || width < 0) {
+        return pgRect_New4((int)posx, (int)posy, 0, 0);
+    }
+
+    /* Same as circle(): the width grows inwards from the radius. */
+    aa_path_circle(&path, posx + 0.5f, posy + 0.5f, radius, 0);
+    if (width > 0 && width < radius) {
+        aa_path_circle(&path, posx + 0.5f, posy + 0.5f, radius - width, 1);
+    }
+
+    return aa_draw_and_free_path(surfobj, &path, rgba, color,
+                                 (int)posx, (int)posy);
 }
 
-static void
-draw_line_width(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2,
-                int y2, int width, int *drawn_area)
+/* Draws an antialiased line of any width through a series of points on the
+ * given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+aastroke(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    int dx, dy, err, e2, sx, sy, y;
-    int left_top, right_bottom;
-    int end_x = x2;
-    int end_y = y2;
-    int xinc = 0;
-    /* Decide which direction to grow (width/thickness). */
-    if (abs(x1 - x2) <= abs(y1 - y2)) {
-        /* The line's thickness will be in the x direction. The top/bottom
-         * ends of the line will be flat. */
-        xinc = 1;
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *closedobj, *points;
+    SDL_Surface *surf = NULL;
+    aa_path path = {NULL, NULL, 0, 0, 0, 0, 0, 0};
+    Uint8 rgba[4];
+    Uint32 color;
+    float *xs, width = 1.0f; /* Default width. */
+    Py_ssize_t length;
+    int closed, x, y;
+    static char *keywords[] = {"surface", "color", "closed",
+                               "points",  "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO|f", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &closedobj, &points, &width)) {
+        return NULL; /* Exception already set. */
     }
-    dx = abs(x2 - x1);
-    sx = x1 < x2 ? 1 : -1;
-    dy = abs(y2 - y1);
-    sy = y1 < y2 ? 1 : -1;
-    err = (dx > dy ? dx : -dy) / 2;
-    if (clip_line(surf, &x1, &y1, &x2, &y2)) {
-        if (width == 1)
-            draw_line(surf, x1, y1, x2, y2, color, drawn_area);
-        else {
-            if (xinc) {
-                left_top = x1 - (width - 1) / 2;
-                right_bottom = x1 + width / 2;
-            }
-            else {
-                left_top = y1 - (width - 1) / 2;
-                right_bottom = y1 + width / 2;
-            }
-            while ((sign(x1 - x2, sx) != sx) || (sign(y1 - y2, sy) != sy)) {
-                if (xinc)
-                    drawhorzlineclipbounding(surf, color, left_top, y1,
-                                             right_bottom, drawn_area);
-                else {
-                    for (y = left_top; y <= right_bottom; y++)
-                        set_and_check_rect(surf, x1, y, color, drawn_area);
-                }
-                e2 = err;
-                if (e2 > -dx) {
-                    err -= dy;
-                    x1 += sx;
-                    if (xinc) {
-                        left_top += sx;
-                        right_bottom += sx;
-                    }
-                }
-                if (e2 < dy) {
-                    err += dx;
-                    y1 += sy;
-                    if (!xinc) {
-                        left_top += sy;
-                        right_bottom += sy;
-                    }
-                }
-            }
-            if (xinc) {
-                while (y1 != end_y && (inside_clip(surf, left_top, y1) ||
-                                       inside_clip(surf, right_bottom, y1))) {
-                    drawhorzlineclipbounding(surf, color, left_top, y1,
-                                             right_bottom, drawn_area);
-                    e2 = err;
-                    if (e2 > -dx) {
-                        err -= dy;
-                        x1 += sx;
-                        left_top += sx;
-                        right_bottom += sx;
-                    }
-                    if (e2 < dy) {
-                        err += dx;
-                        y1 += sy;
-                    }
-                }
-                drawhorzlineclipbounding(surf, color, left_top, y1,
-                                         right_bottom, drawn_area);
-            }
-            else {
-                while (x1 != end_x && (inside_clip(surf, x1, left_top) ||
-                                       inside_clip(surf, x1, right_bottom))) {
-                    for (y = left_top; y <= right_bottom; y++)
-                        set_and_check_rect(surf, x1, y, color, drawn_area);
-                    e2 = err;
-                    if (e2 > -dx) {
-                        err -= dy;
-                        x1 += sx;
-                    }
-                    if (e2 < dy) {
-                        err += dx;
-                        y1 += sy;
-                        left_top += sy;
-                        right_bottom += sy;
-                    }
-                }
-                for (y = left_top; y <= right_bottom; y++)
-                    set_and_check_rect(surf, x1, y, color, drawn_area);
-            }
-        }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    if (!aa_color_from_obj(colorobj, surf, rgba, &color)) {
+        return NULL;
+    }
+
+    closed = PyObject_IsTrue(closedobj);
+
+    if (-1 == closed) {
+        return RAISE(PyExc_TypeError, "closed argument is invalid");
+    }
+
+    if (!isfinite(width)) {
+        return RAISE(PyExc_ValueError, "width argument must be finite");
+    }
+
+    length = aa_points_from_obj(points, 2, &xs,
+                                "points argument must contain 2 or more "
+                                "points");
+    if (length == -1) {
+        return NULL;
+    }
+    x = (int)(xs[0] - 0.5f);
+    y = (int)(xs[length] - 0.5f);
+
+    if (width <= 0) {
+        PyMem_Free(xs);
+        return pgRect_New4(x, y, 0, 0);
     }
+
+    aa_path_stroke(&path, xs, xs + length, length, closed, width);
+    PyMem_Free(xs);
+
+    return aa_draw_and_free_path(surfobj, &path, rgba, color, x, y);
 }
 
-/* Algorithm modified from
- * https://rosettacode.org/wiki/Bitmap/Bresenham%27s_line_algorithm
+/* Fills the area of pixels connected to pos with about the color of the
+ * pixel at pos.
+ *
+ * Returns a Rect bounding the filled area.
  */
-static void
-draw_line(SDL_Surface *surf, int x1, int y1, int x2, int y2, Uint32 color,
-          int *drawn_area)
+static PyObject *
+flood_fill(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    int dx, dy, err, e2, sx, sy;
-    if (x1 == x2 && y1 == y2) { /* Single point */
-        set_and_check_rect(surf, x1, y1, color, drawn_area);
-        return;
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *posobj, *maskobj = Py_None;
+    SDL_Surface *surf = NULL;
+    bitmask_t *mask = NULL;
+    Uint8 rgba[4];
+    Uint32 color = 0;
+    int posx, posy, tolerance = 0; /* Default values. */
+    int result;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    static char *keywords[] = {"surface",   "color", "pos",
+                               "tolerance", "mask",  NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|iO", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &posobj, &tolerance, &maskobj)) {
+        return NULL; /* Exception already set. */
     }
-    if (y1 == y2) { /* Horizontal line */
-        dx = (x1 < x2) ? 1 : -1;
-        for (sx = 0; sx <= abs(x1 - x2); sx++) {
-            set_and_check_rect(surf, x1 + dx * sx, y1, color, drawn_area);
-        }
 
-        return;
+    if (!pg_TwoIntsFromObj(posobj, &posx, &posy)) {
+        return RAISE(PyExc_TypeError,
+                     "pos argument must be a pair of numbers");
     }
-    if (x1 == x2) { /* Vertical line */
-        dy = (y1 < y2) ? 1 : -1;
-        for (sy = 0; sy <= abs(y1 - y2); sy++)
-            set_and_check_rect(surf, x1, y1 + dy * sy, color, drawn_area);
-        return;
+
+    if (tolerance < 0 || tolerance > 255) {
+        return RAISE(PyExc_ValueError,
+                     "tolerance argument must be between 0 and 255");
     }
-    dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
-    dy = abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
-    err = (dx > dy ? dx : -dy) / 2;
-    while (x1 != x2 || y1 != y2) {
-        set_and_check_rect(surf, x1, y1, color, drawn_area);
-        e2 = err;
-        if (e2 > -dx) {
-            err -= dy;
-            x1 += sx;
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    if (maskobj != Py_None) {
+        if (!pgMask_Check(maskobj)) {
+            return RAISE(PyExc_TypeError,
+                         "mask argument must be a Mask or None");
         }
-        if (e2 < dy) {
-            err += dx;
-            y1 += sy;
+        mask = pgMask_AsBitmap(maskobj);
+        if (mask->w != surf->w || mask->h != surf->h) {
+            return RAISE(PyExc_ValueError,
+                         "mask argument must be the size of the surface");
         }
     }
-    set_and_check_rect(surf, x2, y2, color, drawn_area);
-}
 
-static void
-draw_arc(SDL_Surface *surf, int x, int y, int radius1, int radius2,
-         double angle_start, double angle_stop, Uint32 color, int *drawn_area)
-{
-    double aStep;  // Angle Step (rad)
-    double a;      // Current Angle (rad)
-    int x_last, x_next, y_last, y_next;
+    if (colorobj != Py_None) {
+        CHECK_LOAD_COLOR(colorobj)
+    }
 
-    // Angle step in rad
-    if (radius1 < radius2) {
-        if (radius1 < 1.0e-4) {
-            aStep = 1.0;
-        }
-        else {
-            aStep = asin(2.0 / radius1);
-        }
+    if (posx < surf->clip_rect.x || posy < surf->clip_rect.y ||
+        posx >= surf->clip_rect.x + surf->clip_rect.w ||
+        posy >= surf->clip_rect.y + surf->clip_rect.h) {
+        return pgRect_New4(posx, posy, 0, 0);
     }
-    else {
-        if (radius2 < 1.0e-4) {
-            aStep = 1.0;
-        }
-        else {
-            aStep = asin(2.0 / radius2);
-        }
+
+    if (!pgSurface_Lock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
-    if (aStep < 0.05) {
-        aStep = 0.05;
+    result = draw_flood_fill(surf, posx, posy, color, colorobj != Py_None,
+                             tolerance, mask, drawn_area);
+
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
-    x_last = (int)(x + cos(angle_start) * radius1);
-    y_last = (int)(y - sin(angle_start) * radius2);
-    for (a = angle_start + aStep; a < aStep + angle_stop; a += aStep) {
-        int points[4];
-        x_next = (int)(x + cos(MIN(a, angle_stop)) * radius1);
-        y_next = (int)(y - sin(MIN(a, angle_stop)) * radius2);
-        points[0] = x_last;
-        points[1] = y_last;
-        points[2] = x_next;
-        points[3] = y_next;
-        draw_line(surf, points[0], points[1], points[2], points[3], color,
-                  drawn_area);
-        x_last = x_next;
-        y_last = y_next;
+    if (result == -1) {
+        return PyErr_NoMemory();
     }
+
+    return drawn_rect(surfobj, drawn_area, posx, posy);
 }
 
-/* Bresenham Circle Algorithm
- * adapted from: https://de.wikipedia.org/wiki/Bresenham-Algorithmus
- * with additional line width parameter
+/********** path object **********/
+
+/* The rasterization of a path, filled when width is 0 or else stroked,
+ * kept for drawing it again at positions with the same fractional part
+ * (fx, fy). Only the part of the path within area is rasterized, so a path
+ * much larger than the surfaces it is drawn on stays cheap. */
+typedef struct {
+    int valid;
+    float width, fx, fy;
+    SDL_Rect bounds; /* the pixels touched by the outline */
+    SDL_Rect area;   /* the part of bounds rasterized into spans */
+    aa_spans spans;
+} pgPathRaster;
+
+/* Outlines made of straight edges, the curves being flattened as they are
+ * added. The points are moved to the pixel centers, as aa_points_from_obj()
+ * does. The finished subpaths end at path.ends, closed[i] telling whether
+ * the i'th one is closed, and the current subpath holds the points after
+ * them.
  */
+typedef struct {
+    PyObject_HEAD aa_path path;
+    char *closed;
+    Py_ssize_t closed_size;
+    int has_point; /* Set when there is a current point. */
+    float x, y;    /* The current point. */
+    pgPathRaster fill, stroke;
+} pgPathObject;
+
+/* Positions to draw at are rounded to 1 / PATH_SUBPIXELS of a pixel, so
+ * the rasterizations are reused across close positions. */
+#define PATH_SUBPIXELS 64
+
 static void
-draw_circle_bresenham(SDL_Surface *surf, int x0, int y0, int radius,
-                      int thickness, Uint32 color, int *drawn_area)
+path_raster_clear(pgPathRaster *raster)
 {
-    int f = 1 - radius;
-    int ddF_x = 0;
-    int ddF_y = -2 * radius;
-    int x = 0;
-    int y = radius;
-    int y1;
-    int i_y = radius - thickness;
-    int thickness_inner = thickness;
-    int i_f = 1 - i_y;
-    int i_ddF_x = 0;
-    int i_ddF_y = -2 * i_y;
-    int i;
+    aa_spans_free(&raster->spans);
+    raster->valid = 0;
+}
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        /* inner circle*/
-        if (i_f >= 0) {
-            i_y--;
-            i_ddF_y += 2;
-            i_f += i_ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x + 1;
-
-        /* inner circle*/
-        i_ddF_x += 2;
-        i_f += i_ddF_x + 1;
+/* Drops the rasterizations, which no longer match the path. */
+static void
+path_changed(pgPathObject *self)
+{
+    path_raster_clear(&self->fill);
+    path_raster_clear(&self->stroke);
+}
 
-        if (x > i_y) {
-            /* Distance between outer circle and 45-degree angle */
-            /* plus one pixel so there's no gap */
-            thickness_inner = y - x + 1;
-        }
-        else {
-            /* Distance between outer and inner circle */
-            thickness_inner = y - i_y;
-        }
+static void
+path_clear(pgPathObject *self)
+{
+    aa_path_free(&self->path);
+    memset(&self->path, 0, sizeof(self->path));
+    PyMem_Free(self->closed);
+    self->closed = NULL;
+    self->closed_size = 0;
+    self->has_point = 0;
+    path_changed(self);
+}
 
-        /* Numbers represent parts of circle function draw in radians
-           interval: [number - 1 * pi / 4, number * pi / 4] */
-        for (i = 0; i < thickness_inner; i++) {
-            y1 = y - i;
-            set_and_check_rect(surf, x0 + x - 1, y0 + y1 - 1, color,
-                               drawn_area); /* 7 */
-            set_and_check_rect(surf, x0 - x, y0 + y1 - 1, color,
-                               drawn_area); /* 6 */
-            set_and_check_rect(surf, x0 + x - 1, y0 - y1, color,
-                               drawn_area); /* 2 */
-            set_and_check_rect(surf, x0 - x, y0 - y1, color,
-                               drawn_area); /* 3 */
-            set_and_check_rect(surf, x0 + y1 - 1, y0 + x - 1, color,
-                               drawn_area); /* 8 */
-            set_and_check_rect(surf, x0 + y1 - 1, y0 - x, color,
-                               drawn_area); /* 1 */
-            set_and_check_rect(surf, x0 - y1, y0 + x - 1, color,
-                               drawn_area); /* 5 */
-            set_and_check_rect(surf, x0 - y1, y0 - x, color,
-                               drawn_area); /* 4 */
-        }
-    }
+/* The index of the first point of the current subpath. */
+static Py_ssize_t
+path_subpath_start(pgPathObject *self)
+{
+    return self->path.n_contours ? self->path.ends[self->path.n_contours - 1]
+                                 : 0;
 }
 
+/* Records whether the last subpath of self->path is closed. */
 static void
-draw_circle_bresenham_thin(SDL_Surface *surf, int x0, int y0, int radius,
-                           Uint32 color, int *drawn_area)
+path_record_subpath(pgPathObject *self, int closed)
 {
-    int f = 1 - radius;
-    int ddF_x = 0;
-    int ddF_y = -2 * radius;
-    int x = 0;
-    int y = radius;
+    char *new_closed;
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
+    if (self->path.failed) {
+        return;
+    }
+    if (self->path.n_contours > self->closed_size) {
+        new_closed =
+            PyMem_Resize(self->closed, char, self->path.contours_size);
+        if (!new_closed) {
+            self->path.failed = 1;
+            return;
         }
-        x++;
-        ddF_x += 2;
-        f += ddF_x + 1;
-
-        set_and_check_rect(surf, x0 + x - 1, y0 + y - 1, color,
-                           drawn_area); /* 7 */
-        set_and_check_rect(surf, x0 - x, y0 + y - 1, color,
-                           drawn_area); /* 6 */
-        set_and_check_rect(surf, x0 + x - 1, y0 - y, color,
-                           drawn_area);                              /* 2 */
-        set_and_check_rect(surf, x0 - x, y0 - y, color, drawn_area); /* 3 */
-        set_and_check_rect(surf, x0 + y - 1, y0 + x - 1, color,
-                           drawn_area); /* 8 */
-        set_and_check_rect(surf, x0 + y - 1, y0 - x, color,
-                           drawn_area); /* 1 */
-        set_and_check_rect(surf, x0 - y, y0 + x - 1, color,
-                           drawn_area);                              /* 5 */
-        set_and_check_rect(surf, x0 - y, y0 - x, color, drawn_area); /* 4 */
+        self->closed = new_closed;
+        self->closed_size = self->path.contours_size;
     }
+    self->closed[self->path.n_contours - 1] = (char)closed;
 }
 
+/* Ends the current subpath, if it has any points. */
 static void
-draw_circle_quadrant(SDL_Surface *surf, int x0, int y0, int radius,
-                     int thickness, Uint32 color, int top_right, int top_left,
-                     int bottom_left, int bottom_right, int *drawn_area)
+path_end_subpath(pgPathObject *self, int closed)
 {
-    int f = 1 - radius;
-    int ddF_x = 0;
-    int ddF_y = -2 * radius;
-    int x = 0;
-    int y = radius;
-    int y1;
-    int i_y = radius - thickness;
-    int i_f = 1 - i_y;
-    int i_ddF_x = 0;
-    int i_ddF_y = -2 * i_y;
-    int i;
-    if (radius == 1) {
-        if (top_right > 0)
-            set_and_check_rect(surf, x0, y0 - 1, color, drawn_area);
-        if (top_left > 0)
-            set_and_check_rect(surf, x0 - 1, y0 - 1, color, drawn_area);
-        if (bottom_left > 0)
-            set_and_check_rect(surf, x0 - 1, y0, color, drawn_area);
-        if (bottom_right > 0)
-            set_and_check_rect(surf, x0, y0, color, drawn_area);
+    if (self->path.failed || self->path.len == path_subpath_start(self)) {
         return;
     }
 
-    if (thickness != 0) {
-        while (x < y) {
-            if (f >= 0) {
-                y--;
-                ddF_y += 2;
-                f += ddF_y;
-            }
-            if (i_f >= 0) {
-                i_y--;
-                i_ddF_y += 2;
-                i_f += i_ddF_y;
-            }
-            x++;
-            ddF_x += 2;
-            f += ddF_x + 1;
+    aa_path_close(&self->path);
+    path_record_subpath(self, closed);
+}
 
-            i_ddF_x += 2;
-            i_f += i_ddF_x + 1;
+/* Starts the current subpath at the current point, if it is empty. */
+static void
+path_begin_segment(pgPathObject *self)
+{
+    if (self->has_point && self->path.len == path_subpath_start(self)) {
+        aa_path_add(&self->path, self->x, self->y);
+    }
+}
 
-            if (thickness > 1)
-                thickness = y - i_y;
+/* Returns the method's result: None, or NULL with a MemoryError set if the
+ * path could not grow. */
+static PyObject *
+path_result(pgPathObject *self)
+{
+    path_changed(self);
+    if (self->path.failed) {
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
 
-            /* Numbers represent parts of circle function draw in radians
-            interval: [number - 1 * pi / 4, number * pi / 4] */
-            if (top_right > 0) {
-                for (i = 0; i < thickness; i++) {
-                    y1 = y - i;
-                    if ((y0 - y1) < (y0 - x))
-                        set_and_check_rect(surf, x0 + x - 1, y0 - y1, color,
-                                           drawn_area); /* 2 */
-                    if ((x0 + y1 - 1) >= (x0 + x - 1))
-                        set_and_check_rect(surf, x0 + y1 - 1, y0 - x, color,
-                                           drawn_area); /* 1 */
-                }
-            }
-            if (top_left > 0) {
-                for (i = 0; i < thickness; i++) {
-                    y1 = y - i;
-                    if ((y0 - y1) <= (y0 - x))
-                        set_and_check_rect(surf, x0 - x, y0 - y1, color,
-                                           drawn_area); /* 3 */
-                    if ((x0 - y1) < (x0 - x))
-                        set_and_check_rect(surf, x0 - y1, y0 - x, color,
-                                           drawn_area); /* 4 */
-                }
-            }
-            if (bottom_left > 0) {
-                for (i = 0; i < thickness; i++) {
-                    y1 = y - i;
-                    if ((x0 - y1) <= (x0 - x))
-                        set_and_check_rect(surf, x0 - y1, y0 + x - 1, color,
-                                           drawn_area); /* 5 */
-                    if ((y0 + y1 - 1) > (y0 + x - 1))
-                        set_and_check_rect(surf, x0 - x, y0 + y1 - 1, color,
-                                           drawn_area); /* 6 */
-                }
-            }
-            if (bottom_right > 0) {
-                for (i = 0; i < thickness; i++) {
-                    y1 = y - i;
-                    if ((y0 + y1 - 1) >= (y0 + x - 1))
-                        set_and_check_rect(surf, x0 + x - 1, y0 + y1 - 1,
-                                           color, drawn_area); /* 7 */
-                    if ((x0 + y1 - 1) > (x0 + x - 1))
-                        set_and_check_rect(surf, x0 + y1 - 1, y0 + x - 1,
-                                           color, drawn_area); /* 8 */
-                }
-            }
+/* Loads a point argument, moved to the pixel center.
+ *
+ * Returns 1, or 0 with an exception set.
+ */
+static int
+path_point_from_obj(PyObject *obj, const char *name, float *x, float *y)
+{
+    if (!pg_TwoFloatsFromObj(obj, x, y)) {
+        PyErr_Format(PyExc_TypeError, "%s argument must be a pair of numbers",
+                     name);
+        return 0;
+    }
+    if (!isfinite(*x) || !isfinite(*y)) {
+        PyErr_Format(PyExc_ValueError, "%s argument must be finite", name);
+        return 0;
+    }
+    *x += 0.5f;
+    *y += 0.5f;
+    return 1;
+}
+
+/* Adds the outline of the path at the fractional position (fx, fy) to
+ * outline, filled when width is 0 or else stroked.
+ *
+ * Returns 0, or -1 if out of memory.
+ */
+static int
+path_outline(pgPathObject *self, aa_path *outline, float width, float fx,
+             float fy)
+{
+    const float *points = self->path.points;
+    float *xs = NULL;
+    Py_ssize_t c, i, n, start = 0, end;
+    int closed;
+
+    if (self->path.failed) {
+        return -1;
+    }
+    if (width > 0 && self->path.len) {
+        xs = PyMem_New(float, 2 * self->path.len);
+        if (!xs) {
+            return -1;
         }
     }
-    else {
-        while (x < y) {
-            if (f >= 0) {
-                y--;
-                ddF_y += 2;
-                f += ddF_y;
-            }
-            x++;
-            ddF_x += 2;
-            f += ddF_x + 1;
-            if (top_right > 0) {
-                for (y1 = y0 - x; y1 <= y0; y1++) {
-                    set_and_check_rect(surf, x0 + y - 1, y1, color,
-                                       drawn_area); /* 1 */
-                }
-                for (y1 = y0 - y; y1 <= y0; y1++) {
-                    set_and_check_rect(surf, x0 + x - 1, y1, color,
-                                       drawn_area); /* 2 */
-                }
-            }
-            if (top_left > 0) {
-                for (y1 = y0 - x; y1 <= y0; y1++) {
-                    set_and_check_rect(surf, x0 - y, y1, color,
-                                       drawn_area); /* 4 */
-                }
-                for (y1 = y0 - y; y1 <= y0; y1++) {
-                    set_and_check_rect(surf, x0 - x, y1, color,
-                                       drawn_area); /* 3 */
-                }
+
+    /* The subpaths, the current one last and open. */
+    for (c = 0; c <= self->path.n_contours; c++, start = end) {
+        end = c < self->path.n_contours ? self->path.ends[c] : self->path.len;
+        closed = c < self->path.n_contours && self->closed[c];
+        n = end - start;
+
+        if (width > 0) {
+            if (n < 2) {
+                continue;
             }
-            if (bottom_left > 0) {
-                for (y1 = y0; y1 < y0 + x; y1++) {
-                    set_and_check_rect(surf, x0 - y, y1, color,
-                                       drawn_area); /* 4 */
-                }
-                for (y1 = y0; y1 < y0 + y; y1++) {
-                    set_and_check_rect(surf, x0 - x, y1, color,
-                                       drawn_area); /* 3 */
-                }
+            for (i = 0; i < n; i++) {
+                xs[i] = points[2 * (start + i)] + fx;
+                xs[n + i] = points[2 * (start + i) + 1] + fy;
             }
-            if (bottom_right > 0) {
-                for (y1 = y0; y1 < y0 + x; y1++) {
-                    set_and_check_rect(surf, x0 + y - 1, y1, color,
-                                       drawn_area); /* 1 */
-                }
-                for (y1 = y0; y1 < y0 + y; y1++) {
-                    set_and_check_rect(surf, x0 + x - 1, y1, color,
-                                       drawn_area); /* 2 */
-                }
+            aa_path_stroke(outline, xs, xs + n, n, closed, width);
+        }
+        else if (n >= 3) {
+            for (i = start; i < end; i++) {
+                aa_path_add(outline, points[2 * i] + fx,
+                            points[2 * i + 1] + fy);
             }
+            aa_path_close(outline);
         }
     }
+    PyMem_Free(xs);
+
+    return outline->failed ? -1 : 0;
 }
 
-static void
-draw_circle_filled(SDL_Surface *surf, int x0, int y0, int radius, Uint32 color,
-                   int *drawn_area)
+/* Returns whether area, a rasterized part of the path's bounds, holds
+ * every pixel of the bounds within need. */
+static int
+path_area_covers(const SDL_Rect *bounds, const SDL_Rect *area,
+                 const SDL_Rect *need)
 {
-    int f = 1 - radius;
-    int ddF_x = 0;
-    int ddF_y = -2 * radius;
-    int x = 0;
-    int y = radius;
+    SDL_Rect r;
 
-    while (x < y) {
-        if (f >= 0) {
+    if (!SDL_IntersectRect(bounds, need, &r)) {
+        return 1;
+    }
+    return r.x >= area->x && r.y >= area->y &&
+           r.x + r.w <= area->x + area->w && r.y + r.h <= area->y + area->h;
+}
+
+/* Rasterizes the part of outline within area into spans, which must be
+ * empty. Sets *rasterized to the part of bounds, the pixels touched by the
+ * outline, that was rasterized.
+ *
+ * Returns 0, or -1 if out of memory.
+ */
+static int
+path_rasterize_area(aa_path *outline, const SDL_Rect *bounds,
+                    const SDL_Rect *area, SDL_Rect *rasterized,
+                    aa_spans *spans)
+{
+    if (!SDL_IntersectRect(bounds, area, rasterized)) {
+        rasterized->w = rasterized->h = 0;
+        return 0;
+    }
+    return aa_path_spans(outline, rasterized, spans);
+}
+
+/* Rasterizes the part within area of the path at the fractional position
+ * (fx, fy) into raster, filled when width is 0 or else stroked.
+ *
+ * Returns 0, or -1 if out of memory.
+ */
+static int
+path_rasterize(pgPathObject *self, pgPathRaster *raster, float width,
+               float fx, float fy, const SDL_Rect *area)
+{
+    aa_path outline = {NULL, NULL, 0, 0, 0, 0, 0, 0};
+    int result;
+
+    path_raster_clear(raster);
+
+    result = path_outline(self, &outline, width, fx, fy);
+    if (!result) {
+        aa_path_bounds(&outline, &raster->bounds);
+        result = path_rasterize_area(&outline, &raster->bounds, area,
+                                     &raster->area, &raster->spans);
+    }
+    aa_path_free(&outline);
+
+    if (result) {
+        path_raster_clear(raster);
+        return -1;
+    }
+
+    raster->valid = 1;
+    raster->width = width;
+    raster->fx = fx;
+    raster->fy = fy;
+    return 0;
+}
+
+/* Splits the position (posx, posy) into a whole number of pixels (*x, *y),
+ * for moving the rasterized path, and the fraction (*fx, *fy) it is
+ * rasterized at. */
+static void
+path_split_pos(float posx, float posy, int *x, int *y, float *fx, float *fy)
+{
+    posx = MIN(MAX(posx, -AA_MAX_COORD), AA_MAX_COORD) * PATH_SUBPIXELS;
+    posy = MIN(MAX(posy, -AA_MAX_COORD), AA_MAX_COORD) * PATH_SUBPIXELS;
+    posx = floorf(posx + 0.5f);
+    posy = floorf(posy + 0.5f);
+    *x = (int)floorf(posx / PATH_SUBPIXELS);
+    *y = (int)floorf(posy / PATH_SUBPIXELS);
+    *fx = (posx - (float)*x * PATH_SUBPIXELS) / PATH_SUBPIXELS;
+    *fy = (posy - (float)*y * PATH_SUBPIXELS) / PATH_SUBPIXELS;
+}
+
+/* Returns the rasterization of the path at the fractional position
+ * (fx, fy), filled when width is 0 or else stroked, holding at least its
+ * pixels within area. It is rasterized again unless the cached one holds
+ * them already.
+ *
+ * Returns NULL if out of memory.
+ */
+static pgPathRaster *
+path_raster(pgPathObject *self, float width, float fx, float fy,
+            const SDL_Rect *area)
+{
+    pgPathRaster *raster = (width > 0) ? &self->stroke : &self->fill;
+
+    if (!raster->valid || raster->width != width || raster->fx != fx ||
+        raster->fy != fy ||
+        !path_area_covers(&raster->bounds, &raster->area, area)) {
+        if (path_rasterize(self, raster, width, fx, fy, area)) {
+            return NULL;
+        }
+    }
+    return raster;
+}
+
+static void
+path_dealloc(PyObject *self)
+{
+    path_clear((pgPathObject *)self);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int
+path_init(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *keywords[] = {NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, ":Path", keywords)) {
+        return -1;
+    }
+
+    path_clear(self);
+    return 0;
+}
+
+static PyObject *
+path_move_to(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *posobj;
+    float x, y;
+    static char *keywords[] = {"pos", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", keywords, &posobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!path_point_from_obj(posobj, "pos", &x, &y)) {
+        return NULL;
+    }
+
+    path_end_subpath(self, 0);
+    self->has_point = 1;
+    self->x = x;
+    self->y = y;
+
+    return path_result(self);
+}
+
+static PyObject *
+path_line_to(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *posobj;
+    float x, y;
+    static char *keywords[] = {"pos", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", keywords, &posobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!path_point_from_obj(posobj, "pos", &x, &y)) {
+        return NULL;
+    }
+
+    /* Without a current point this only moves to pos. */
+    if (self->has_point) {
+        path_begin_segment(self);
+        aa_path_add(&self->path, x, y);
+    }
+    self->has_point = 1;
+    self->x = x;
+    self->y = y;
+
+    return path_result(self);
+}
+
+static PyObject *
+path_quad_to(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *controlobj, *posobj;
+    float cx, cy, x, y;
+    static char *keywords[] = {"control", "pos", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO", keywords,
+                                     &controlobj, &posobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!path_point_from_obj(controlobj, "control", &cx, &cy) ||
+        !path_point_from_obj(posobj, "pos", &x, &y)) {
+        return NULL;
+    }
+
+    /* Without a current point the curve starts at the control point. */
+    if (!self->has_point) {
+        self->has_point = 1;
+        self->x = cx;
+        self->y = cy;
+    }
+    path_begin_segment(self);
+    aa_path_quad(&self->path, self->x, self->y, cx, cy, x, y);
+    self->x = x;
+    self->y = y;
+
+    return path_result(self);
+}
+
+static PyObject *
+path_cubic_to(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *control1obj, *control2obj, *posobj;
+    float c1x, c1y, c2x, c2y, x, y;
+    static char *keywords[] = {"control1", "control2", "pos", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO", keywords,
+                                     &control1obj, &control2obj, &posobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!path_point_from_obj(control1obj, "control1", &c1x, &c1y) ||
+        !path_point_from_obj(control2obj, "control2", &c2x, &c2y) ||
+        !path_point_from_obj(posobj, "pos", &x, &y)) {
+        return NULL;
+    }
+
+    /* Without a current point the curve starts at the first control
+     * point. */
+    if (!self->has_point) {
+        self->has_point = 1;
+        self->x = c1x;
+        self->y = c1y;
+    }
+    path_begin_segment(self);
+    aa_path_cubic(&self->path, self->x, self->y, c1x, c1y, c2x, c2y, x, y);
+    self->x = x;
+    self->y = y;
+
+    return path_result(self);
+}
+
+static PyObject *
+path_arc(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *centerobj;
+    float cx, cy, radius;
+    double start_angle, stop_angle;
+    static char *keywords[] = {"center", "radius", "start_angle",
+                               "stop_angle", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Ofdd", keywords,
+                                     &centerobj, &radius, &start_angle,
+                                     &stop_angle)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!path_point_from_obj(centerobj, "center", &cx, &cy)) {
+        return NULL;
+    }
+
+    if (!isfinite(radius) || !isfinite(start_angle) ||
+        !isfinite(stop_angle)) {
+        return RAISE(PyExc_ValueError,
+                     "radius and angle arguments must be finite");
+    }
+
+    if (radius < 0) {
+        return RAISE(PyExc_ValueError, "radius argument must be positive");
+    }
+
+    /* Same as arc(): the angles go counterclockwise on the screen. */
+    if (stop_angle < start_angle) {
+        stop_angle += 2 * M_PI;
+    }
+
+    /* A line joins the current point to the start of the arc. */
+    path_begin_segment(self);
+    aa_path_arc(&self->path, cx, cy, radius, -start_angle,
+                start_angle - stop_angle);
+    self->has_point = 1;
+    self->x = cx + radius * (float)cos(stop_angle);
+    self->y = cy - radius * (float)sin(stop_angle);
+
+    return path_result(self);
+}
+
+static PyObject *
+path_close(pgPathObject *self, PyObject *_null)
+{
+    Py_ssize_t start = path_subpath_start(self);
+
+    /* The next subpath starts at the first point of the closed one. */
+    if (self->path.len > start) {
+        path_end_subpath(self, 1);
+        self->x = self->path.points[2 * start];
+        self->y = self->path.points[2 * start + 1];
+    }
+
+    return path_result(self);
+}
+
+static PyObject *
+path_add_polygon(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *points;
+    float *xs;
+    Py_ssize_t length, i;
+    static char *keywords[] = {"points", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", keywords, &points)) {
+        return NULL; /* Exception already set. */
+    }
+
+    length = aa_points_from_obj(points, 3, &xs,
+                                "points argument must contain more than 2 "
+                                "points");
+    if (length == -1) {
+        return NULL;
+    }
+
+    path_end_subpath(self, 0);
+    for (i = 0; i < length; i++) {
+        aa_path_add(&self->path, xs[i], xs[length + i]);
+    }
+    path_end_subpath(self, 1);
+    self->has_point = 0;
+    PyMem_Free(xs);
+
+    return path_result(self);
+}
+
+static PyObject *
+path_add_rect(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *rectobj;
+    SDL_Rect *rect, temp;
+    float left, top, right, bottom, radius = 0.0f; /* Default radius. */
+    static char *keywords[] = {"rect", "border_radius", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|f", keywords, &rectobj,
+                                     &radius)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+        return RAISE(PyExc_TypeError, "rect argument is invalid");
+    }
+
+    if (!isfinite(radius)) {
+        return RAISE(PyExc_ValueError, "border_radius argument must be finite");
+    }
+
+    path_end_subpath(self, 0);
+    self->has_point = 0;
+
+    if (rect->w <= 0 || rect->h <= 0) {
+        return path_result(self);
+    }
+
+    /* The outline runs along the pixel edges, so the rect's pixels are
+     * exactly covered. */
+    left = (float)rect->x;
+    top = (float)rect->y;
+    right = left + rect->w;
+    bottom = top + rect->h;
+    radius = MIN(radius, MIN(rect->w, rect->h) / 2.0f);
+
+    if (radius > 0) {
+        aa_path_arc(&self->path, left + radius, top + radius, radius, M_PI,
+                    M_PI / 2);
+        aa_path_arc(&self->path, right - radius, top + radius, radius,
+                    -M_PI / 2, M_PI / 2);
+        aa_path_arc(&self->path, right - radius, bottom - radius, radius, 0,
+                    M_PI / 2);
+        aa_path_arc(&self->path, left + radius, bottom - radius, radius,
+                    M_PI / 2, M_PI / 2);
+    }
+    else {
+        aa_path_add(&self->path, left, top);
+        aa_path_add(&self->path, right, top);
+        aa_path_add(&self->path, right, bottom);
+        aa_path_add(&self->path, left, bottom);
+    }
+    path_end_subpath(self, 1);
+
+    return path_result(self);
+}
+
+static PyObject *
+path_add_circle(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *centerobj;
+    float cx, cy, radius;
+    static char *keywords[] = {"center", "radius", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Of", keywords,
+                                     &centerobj, &radius)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!path_point_from_obj(centerobj, "center", &cx, &cy)) {
+        return NULL;
+    }
+
+    if (!isfinite(radius)) {
+        return RAISE(PyExc_ValueError, "radius argument must be finite");
+    }
+
+    path_end_subpath(self, 0);
+    self->has_point = 0;
+
+    if (radius > 0) {
+        aa_path_circle(&self->path, cx, cy, radius, 0);
+        path_record_subpath(self, 1);
+    }
+
+    return path_result(self);
+}
+
+static PyObject *
+path_clear_method(pgPathObject *self, PyObject *_null)
+{
+    path_clear(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+path_draw(pgPathObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *posobj = NULL;
+    SDL_Surface *surf = NULL;
+    pgPathRaster *raster;
+    SDL_Rect area;
+    Uint8 rgba[4];
+    Uint32 color;
+    float posx = 0.0f, posy = 0.0f, width = 0.0f; /* Default width. */
+    float fx, fy;
+    int x, y;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    static char *keywords[] = {"surface", "color", "pos", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|Of", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &posobj, &width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (posobj && !pg_TwoFloatsFromObj(posobj, &posx, &posy)) {
+        return RAISE(PyExc_TypeError, "pos argument must be a pair of numbers");
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    if (!aa_color_from_obj(colorobj, surf, rgba, &color)) {
+        return NULL;
+    }
+
+    if (!isfinite(posx) || !isfinite(posy) || !isfinite(width)) {
+        return RAISE(PyExc_ValueError,
+                     "pos and width arguments must be finite");
+    }
+
+    path_split_pos(posx, posy, &x, &y, &fx, &fy);
+
+    if (width < 0) {
+        return pgRect_New4(x, y, 0, 0);
+    }
+
+    /* The clip area, in the coordinates of the path. */
+    area = surf->clip_rect;
+    area.x -= x;
+    area.y -= y;
+
+    raster = path_raster(self, width, fx, fy, &area);
+    if (!raster) {
+        return PyErr_NoMemory();
+    }
+
+    if (!pgSurface_Lock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    aa_spans_draw(&raster->spans, surf, rgba, color, x, y, drawn_area);
+
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+
+    return drawn_rect(surfobj, drawn_area, x, y);
+}
+
+static PyMethodDef path_methods[] = {
+    {"move_to", (PyCFunction)path_move_to, METH_VARARGS | METH_KEYWORDS,
+     DOC_PATHMOVETO},
+    {"line_to", (PyCFunction)path_line_to, METH_VARARGS | METH_KEYWORDS,
+     DOC_PATHLINETO},
+    {"quad_to", (PyCFunction)path_quad_to, METH_VARARGS | METH_KEYWORDS,
+     DOC_PATHQUADTO},
+    {"cubic_to", (PyCFunction)path_cubic_to, METH_VARARGS | METH_KEYWORDS,
+     DOC_PATHCUBICTO},
+    {"arc", (PyCFunction)path_arc, METH_VARARGS | METH_KEYWORDS,
+     DOC_PATHARC},
+    {"close", (PyCFunction)path_close, METH_NOARGS, DOC_PATHCLOSE},
+    {"add_polygon", (PyCFunction)path_add_polygon,
+     METH_VARARGS | METH_KEYWORDS, DOC_PATHADDPOLYGON},
+    {"add_rect", (PyCFunction)path_add_rect, METH_VARARGS | METH_KEYWORDS,
+     DOC_PATHADDRECT},
+    {"add_circle", (PyCFunction)path_add_circle,
+     METH_VARARGS | METH_KEYWORDS, DOC_PATHADDCIRCLE},
+    {"clear", (PyCFunction)path_clear_method, METH_NOARGS, DOC_PATHCLEAR},
+    {"draw", (PyCFunction)path_draw, METH_VARARGS | METH_KEYWORDS,
+     DOC_PATHDRAW},
+    {NULL, NULL, 0, NULL}};
+
+static PyTypeObject pgPath_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.draw.Path",
+    .tp_basicsize = sizeof(pgPathObject),
+    .tp_dealloc = path_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEDRAWPATH,
+    .tp_methods = path_methods,
+    .tp_init = (initproc)path_init,
+    .tp_new = PyType_GenericNew,
+};
+
+/********** render queue **********/
+
+/* The commands are drawn in tiles of at most QUEUE_TILE_SIZE pixels
+ * across, several tiles at once. Tiles are small enough for the shapes
+ * drawn into them never to be split into bands by draw_band_count(), which
+ * only works with the GIL held.
+ */
+#define QUEUE_TILE_SIZE 64
+
+enum {
+    QUEUE_FILL,
+    QUEUE_RECT,
+    QUEUE_LINES,
+    QUEUE_CIRCLE,
+    QUEUE_POLYGON,
+    QUEUE_PATH,
+    QUEUE_BLIT
+};
+
+/* A recorded drawing command. Some of the fields are only set while the
+ * queue is executed, for the surface it is executed on. */
+typedef struct {
+    int type;
+    int mapped;   /* color was given as a mapped color rather than rgba */
+    Uint32 color; /* mapped to the surface, while executing */
+    Uint8 rgba[4];
+    int width;            /* of lines and outlines, 0 for filled shapes */
+    int closed;           /* QUEUE_LINES: the last point joins the first */
+    SDL_Rect rect;        /* QUEUE_FILL, QUEUE_RECT: the rect; QUEUE_BLIT:
+                             the area of the source blitted */
+    int has_rect;         /* rect is set, for QUEUE_FILL and QUEUE_BLIT */
+    int x, y;             /* QUEUE_CIRCLE: the center; QUEUE_PATH,
+                             QUEUE_BLIT: the position */
+    int radius;           /* QUEUE_CIRCLE */
+    int *points;          /* QUEUE_LINES, QUEUE_POLYGON: the x coordinates
+                             of the points followed by the y coordinates */
+    Py_ssize_t n_points;
+    poly_edge *edges;     /* QUEUE_POLYGON: the edge table */
+    Py_ssize_t n_edges;
+    aa_path path;         /* QUEUE_PATH: the outline of the path, */
+    SDL_Rect path_bounds; /* the pixels it touches, */
+    SDL_Rect path_area;   /* the part of them rasterized, and */
+    aa_spans spans;       /* the runs of pixels rasterized */
+    PyObject *source;     /* QUEUE_BLIT: the Surface blitted */
+    int flags;            /* QUEUE_BLIT: special_flags */
+    SDL_Rect extent;      /* the area drawn to, unless set while executing */
+    SDL_Rect bounds;      /* the part of extent in the clip area, while
+                             executing */
+    int outline;          /* QUEUE_RECT: drawn as an outline, while
+                             executing */
+    SDL_Surface *src;     /* QUEUE_BLIT: the surface of source, and */
+    SDL_Rect src_rect;    /* the area of it blitted to bounds, clipped to
+                             the source, while executing */
+    int copy;             /* QUEUE_BLIT: the pixels are copied as they are */
+    int split;            /* QUEUE_LINES, thin QUEUE_CIRCLE: drawn as the
+                             parts run->parts[part_start:part_end], while
+                             executing */
+    Py_ssize_t part_start, part_end;
+} queue_command;
+
+typedef struct {
+    PyObject_HEAD queue_command *commands;
+    Py_ssize_t n_commands, commands_size;
+    int executing; /* Set while the commands are drawn. */
+} pgRenderQueueObject;
+
+/* The steps of Bresenham's algorithm drawing into one tile, for a segment
+ * of a QUEUE_LINES command or an octant of a thin QUEUE_CIRCLE: a line
+ * draws a span of pixels at (x, y) at each step, while a circle takes a
+ * step and then draws a pixel. Lines and circles are split into parts so
+ * that each tile only steps through the pixels it holds, starting from the
+ * state the whole line or circle would be in there. */
+typedef struct {
+    int index;     /* the segment, from point index, or the octant */
+    int tile;
+    int x, y, err; /* the state before the first step */
+    int count;     /* the number of steps */
+} queue_part;
+
+/* A command drawn to a tile, or only a part of it when part is not -1. */
+typedef struct {
+    Py_ssize_t command, part;
+} queue_item;
+
+/* The part of each tile for the line or circle being split, when walk is
+ * the one in progress. */
+typedef struct {
+    Py_ssize_t walk, part;
+    int first; /* the first step of the part */
+} queue_tile_walk;
+
+/* A queue being executed on a surface: its commands, binned into the tiles
+ * of the clip area they draw to. The tiles are shared between the workers
+ * in turn, each worker drawing every n_workers'th tile. */
+typedef struct {
+    SDL_Surface *surf;
+    SDL_Rect clip;
+    const queue_command *commands;
+    int tiles_x, n_tiles, n_workers;
+    Py_ssize_t *tile_starts; /* index in tile_commands of each tile's first
+                                command, and the end of the last tile's */
+    queue_item *tile_commands;
+    queue_part *parts;
+    Py_ssize_t n_parts, parts_size;
+    queue_tile_walk *tile_walks; /* n_tiles, while splitting */
+    Py_ssize_t walk;
+    Py_ssize_t max_edges;
+    const poly_edge **active; /* max_edges for each worker */
+    int *x_intersect;         /* max_edges for each worker */
+    int worker_areas[PG_PARALLEL_MAX_THREADS][4];
+    char errors[PG_PARALLEL_MAX_THREADS][128]; /* a failed blit's error */
+} queue_run;
+
+static void
+queue_command_free(queue_command *cmd)
+{
+    PyMem_Free(cmd->points);
+    PyMem_Free(cmd->edges);
+    aa_path_free(&cmd->path);
+    aa_spans_free(&cmd->spans);
+    Py_XDECREF(cmd->source);
+}
+
+static void
+queue_clear(pgRenderQueueObject *self)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < self->n_commands; i++) {
+        queue_command_free(&self->commands[i]);
+    }
+    PyMem_Free(self->commands);
+    self->commands = NULL;
+    self->n_commands = self->commands_size = 0;
+}
+
+/* Returns 1, or 0 with a RuntimeError set if the queue is being executed. */
+static int
+queue_check_idle(pgRenderQueueObject *self)
+{
+    if (self->executing) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "cannot change a RenderQueue while it is executed");
+        return 0;
+    }
+    return 1;
+}
+
+/* Loads a color as CHECK_LOAD_COLOR does, leaving the mapping of RGBA
+ * colors to the surface for queue_execute().
+ *
+ * Returns 1, or 0 with an exception set.
+ */
+static int
+queue_color_from_obj(PyObject *colorobj, queue_command *cmd)
+{
+    if (PyLong_Check(colorobj)) {
+        cmd->mapped = 1;
+        cmd->color = (Uint32)PyLong_AsLong(colorobj);
+        if (cmd->color == (Uint32)-1 && PyErr_Occurred()) {
+            return 0;
+        }
+    }
+    else if (!pg_RGBAFromFuzzyColorObj(colorobj, cmd->rgba)) {
+        return 0; /* pg_RGBAFromFuzzyColorObj sets the exception for us */
+    }
+    return 1;
+}
+
+/* Loads a sequence of at least min_points number pairs into cmd->points.
+ *
+ * Returns 1, or 0 with an exception set.
+ */
+static int
+queue_points_from_obj(PyObject *points, Py_ssize_t min_points,
+                      const char *too_few, queue_command *cmd)
+{
+    PyObject *item;
+    Py_ssize_t length, i;
+    int x, y, result;
+
+    if (!PySequence_Check(points)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "points argument must be a sequence of number pairs");
+        return 0;
+    }
+
+    length = PySequence_Length(points);
+    if (length < min_points) {
+        PyErr_SetString(PyExc_ValueError, too_few);
+        return 0;
+    }
+
+    cmd->points = PyMem_New(int, 2 * length);
+    if (!cmd->points) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    cmd->n_points = length;
+
+    for (i = 0; i < length; i++) {
+        item = PySequence_GetItem(points, i);
+        result = item && pg_TwoIntsFromObj(item, &x, &y);
+        Py_XDECREF(item);
+
+        if (!result) {
+            PyErr_SetString(PyExc_TypeError, "points must be number pairs");
+            return 0;
+        }
+        cmd->points[i] = x;
+        cmd->points[length + i] = y;
+    }
+    return 1;
+}
+
+/* Sets cmd->extent to the bounds of its points, grown by margin. */
+static void
+queue_points_extent(queue_command *cmd, int margin)
+{
+    const int *xs = cmd->points, *ys = cmd->points + cmd->n_points;
+    int minx = xs[0], maxx = xs[0], miny = ys[0], maxy = ys[0];
+    Py_ssize_t i;
+
+    for (i = 1; i < cmd->n_points; i++) {
+        minx = MIN(minx, xs[i]);
+        maxx = MAX(maxx, xs[i]);
+        miny = MIN(miny, ys[i]);
+        maxy = MAX(maxy, ys[i]);
+    }
+    cmd->extent.x = minx - margin;
+    cmd->extent.y = miny - margin;
+    cmd->extent.w = maxx - minx + 2 * margin + 1;
+    cmd->extent.h = maxy - miny + 2 * margin + 1;
+}
+
+/* Appends cmd to the queue, which takes over its contents.
+ *
+ * Returns None, or NULL with a MemoryError set, cmd being freed.
+ */
+static PyObject *
+queue_push(pgRenderQueueObject *self, queue_command *cmd)
+{
+    queue_command *commands;
+    Py_ssize_t size;
+
+    if (self->n_commands == self->commands_size) {
+        size = self->commands_size ? 2 * self->commands_size : 16;
+        commands = PyMem_Resize(self->commands, queue_command, size);
+        if (!commands) {
+            queue_command_free(cmd);
+            return PyErr_NoMemory();
+        }
+        self->commands = commands;
+        self->commands_size = size;
+    }
+
+    self->commands[self->n_commands++] = *cmd;
+    Py_RETURN_NONE;
+}
+
+/* Returns whether the pixels of a and b overlap in memory. */
+static int
+queue_shares_pixels(SDL_Surface *a, SDL_Surface *b)
+{
+    Uint8 *a_pixels = (Uint8 *)a->pixels, *b_pixels = (Uint8 *)b->pixels;
+
+    return a_pixels < b_pixels + (size_t)b->pitch * b->h &&
+           b_pixels < a_pixels + (size_t)a->pitch * a->h;
+}
+
+/* Prepares a blit for executing on surf: clips the area of the source to
+ * it as pygame_Blit() does, finding the area drawn to.
+ *
+ * Returns 1, or 0 with an exception set.
+ */
+static int
+queue_setup_blit(queue_command *cmd, SDL_Surface *surf)
+{
+    SDL_Surface *src = pgSurface_AsSurface(cmd->source);
+    SDL_Rect area = {0, 0, 0, 0};
+    Uint8 alpha;
+    SDL_BlendMode blend;
+    int x = cmd->x, y = cmd->y;
+
+    if (!src) {
+        PyErr_SetString(pgExc_SDLError, "display Surface quit");
+        return 0;
+    }
+    if (queue_shares_pixels(src, surf)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "cannot blit a surface sharing pixels with the "
+                        "surface the RenderQueue is executed on");
+        return 0;
+    }
+
+    area.w = src->w;
+    area.h = src->h;
+    if (cmd->has_rect) {
+        area = cmd->rect;
+        if (area.x < 0) {
+            area.w += area.x;
+            x -= area.x;
+            area.x = 0;
+        }
+        if (area.y < 0) {
+            area.h += area.y;
+            y -= area.y;
+            area.y = 0;
+        }
+        area.w = MIN(area.w, src->w - area.x);
+        area.h = MIN(area.h, src->h - area.y);
+    }
+
+    cmd->src = src;
+    cmd->src_rect = area;
+    cmd->extent.x = x;
+    cmd->extent.y = y;
+    cmd->extent.w = area.w;
+    cmd->extent.h = area.h;
+
+    /* Opaque blits between surfaces of the same format copy the rows, as
+     * SDL does, rather than blending each pixel. */
+    SDL_GetSurfaceAlphaMod(src, &alpha);
+    SDL_GetSurfaceBlendMode(src, &blend);
+    cmd->copy = cmd->flags == 0 && alpha == 255 &&
+                (blend == SDL_BLENDMODE_NONE || !src->format->Amask) &&
+                SDL_GetColorKey(src, NULL) != 0 &&
+                src->format->format == surf->format->format &&
+                src->format->BytesPerPixel > 1;
+    return 1;
+}
+
+/* Rasterizes the outline of a path within cmd->bounds, unless the spans
+ * rasterized by an earlier execute hold those pixels already.
+ *
+ * Returns 1, or 0 with a MemoryError set.
+ */
+static int
+queue_setup_path(queue_command *cmd)
+{
+    SDL_Rect area = cmd->bounds;
+
+    area.x -= cmd->x;
+    area.y -= cmd->y;
+    if (path_area_covers(&cmd->path_bounds, &cmd->path_area, &area)) {
+        return 1;
+    }
+
+    aa_spans_free(&cmd->spans);
+    if (path_rasterize_area(&cmd->path, &cmd->path_bounds, &area,
+                            &cmd->path_area, &cmd->spans)) {
+        aa_spans_free(&cmd->spans);
+        cmd->path_area.w = cmd->path_area.h = 0;
+        PyErr_NoMemory();
+        return 0;
+    }
+    return 1;
+}
+
+/* Copies the part of a blit's source in the clip area of surf. */
+static void
+queue_copy_rows(SDL_Surface *surf, const queue_command *cmd, int *drawn_area)
+{
+    SDL_Surface *src = cmd->src;
+    int bpp = surf->format->BytesPerPixel;
+    SDL_Rect r;
+    Uint8 *src_row, *dst_row;
+    int y;
+
+    if (!SDL_IntersectRect(&cmd->bounds, &surf->clip_rect, &r)) {
+        return;
+    }
+
+    src_row = (Uint8 *)src->pixels +
+              (cmd->src_rect.y + r.y - cmd->extent.y) * src->pitch +
+              (cmd->src_rect.x + r.x - cmd->extent.x) * bpp;
+    dst_row = (Uint8 *)surf->pixels + r.y * surf->pitch + r.x * bpp;
+    for (y = 0; y < r.h; y++) {
+        memcpy(dst_row, src_row, (size_t)r.w * bpp);
+        src_row += src->pitch;
+        dst_row += surf->pitch;
+    }
+    add_pixel_to_drawn_list(r.x, r.y, drawn_area);
+    add_pixel_to_drawn_list(r.x + r.w - 1, r.y + r.h - 1, drawn_area);
+}
+
+/* A line segment as draw_line_width_within() draws it within the clip
+ * area, stepping from (x, y) with the error term err. */
+typedef struct {
+    int x, y, err;
+    int x2, y2;         /* the end of the part in the clip area */
+    int end_x, end_y;   /* the end of the whole segment */
+    int dx, dy, sx, sy;
+    int xinc; /* the spans across the line are rows, or else columns */
+    int width;
+} queue_segment;
+
+/* Sets up segment i of cmd, from point i to the next one, to be stepped
+ * through.
+ *
+ * Returns 0 if none of it is in clip.
+ */
+static int
+queue_line_setup(queue_segment *line, const queue_command *cmd, int i,
+                 const SDL_Rect *clip)
+{
+    const int *xs = cmd->points, *ys = cmd->points + cmd->n_points;
+    int j = i + 1 < cmd->n_points ? i + 1 : 0;
+
+    line->x = xs[i];
+    line->y = ys[i];
+    line->x2 = line->end_x = xs[j];
+    line->y2 = line->end_y = ys[j];
+    line->width = cmd->width;
+    line->xinc = abs(line->x - line->x2) <= abs(line->y - line->y2);
+    line->dx = abs(line->x2 - line->x);
+    line->sx = line->x < line->x2 ? 1 : -1;
+    line->dy = abs(line->y2 - line->y);
+    line->sy = line->y < line->y2 ? 1 : -1;
+    line->err = (line->dx > line->dy ? line->dx : -line->dy) / 2;
+    if (!clip_line(clip, &line->x, &line->y, &line->x2, &line->y2)) {
+        return 0;
+    }
+
+    if (line->width == 1) {
+        /* draw_line() steps from the clipped ends. */
+        line->dx = abs(line->x2 - line->x);
+        line->sx = line->x < line->x2 ? 1 : -1;
+        line->dy = abs(line->y2 - line->y);
+        line->sy = line->y < line->y2 ? 1 : -1;
+        line->err = (line->dx > line->dy ? line->dx : -line->dy) / 2;
+    }
+    return 1;
+}
+
+static void
+queue_line_step(queue_segment *line)
+{
+    int e2 = line->err;
+
+    if (e2 > -line->dx) {
+        line->err -= line->dy;
+        line->x += line->sx;
+    }
+    if (e2 < line->dy) {
+        line->err += line->dx;
+        line->y += line->sy;
+    }
+}
+
+/* Sets span to the pixels drawn at the current step of the line. */
+static void
+queue_line_span(const queue_segment *line, SDL_Rect *span)
+{
+    span->x = line->x;
+    span->y = line->y;
+    span->w = span->h = 1;
+    if (line->width > 1 && line->xinc) {
+        span->x -= (line->width - 1) / 2;
+        span->w = line->width;
+    }
+    else if (line->width > 1) {
+        span->y -= (line->width - 1) / 2;
+        span->h = line->width;
+    }
+}
+
+/* Draws the pixels of the current step of the line, as
+ * draw_line_width_within() does. */
+static void
+queue_line_draw_span(SDL_Surface *surf, const queue_segment *line,
+                     Uint32 color, int *drawn_area)
+{
+    SDL_Rect span;
+    int y;
+
+    queue_line_span(line, &span);
+    if (line->width > 1 && line->xinc) {
+        drawhorzlineclipbounding(surf, color, span.x, span.y,
+                                 span.x + span.w - 1, drawn_area);
+    }
+    else {
+        for (y = span.y; y < span.y + span.h; y++) {
+            set_and_check_rect(surf, span.x, y, color, drawn_area);
+        }
+    }
+}
+
+/* Returns whether draw_line_width_within() draws another step of the line
+ * after the one it is at: until it passes the end of the part in the clip
+ * area, and then while either end of a span is in the clip area. */
+static int
+queue_line_continues(const queue_segment *line, const SDL_Rect *clip)
+{
+    SDL_Rect span;
+
+    if (line->width == 1) {
+        return line->x != line->x2 || line->y != line->y2;
+    }
+    if (sign(line->x - line->x2, line->sx) != line->sx ||
+        sign(line->y - line->y2, line->sy) != line->sy) {
+        return 1;
+    }
+
+    queue_line_span(line, &span);
+    if (line->xinc) {
+        return line->y != line->end_y &&
+               (inside_clip(clip, span.x, span.y) ||
+                inside_clip(clip, span.x + span.w - 1, span.y));
+    }
+    return line->x != line->end_x &&
+           (inside_clip(clip, span.x, span.y) ||
+            inside_clip(clip, span.x, span.y + span.h - 1));
+}
+
+/* Takes a step of the thin circle drawn by draw_circle_bresenham_thin(),
+ * with the error term err, and finds the pixel it draws in octant. */
+static void
+queue_circle_step(const queue_command *cmd, int octant, int *x, int *y,
+                  int *err, int *px, int *py)
+{
+    if (*err >= 0) {
+        (*y)--;
+        *err -= 2 * *y;
+    }
+    (*x)++;
+    *err += 2 * *x + 1;
+
+    switch (octant) {
+        case 0:
+            *px = cmd->x + *x - 1;
+            *py = cmd->y + *y - 1;
+            break;
+        case 1:
+            *px = cmd->x - *x;
+            *py = cmd->y + *y - 1;
+            break;
+        case 2:
+            *px = cmd->x + *x - 1;
+            *py = cmd->y - *y;
+            break;
+        case 3:
+            *px = cmd->x - *x;
+            *py = cmd->y - *y;
+            break;
+        case 4:
+            *px = cmd->x + *y - 1;
+            *py = cmd->y + *x - 1;
+            break;
+        case 5:
+            *px = cmd->x + *y - 1;
+            *py = cmd->y - *x;
+            break;
+        case 6:
+            *px = cmd->x - *y;
+            *py = cmd->y + *x - 1;
+            break;
+        default:
+            *px = cmd->x - *y;
+            *py = cmd->y - *x;
+            break;
+    }
+}
+
+/* Adds step number step of a line or circle, drawing the pixels in
+ * pixels, to the parts of the tiles it draws to. A part is started in
+ * each tile the line or circle enters, with the state (x, y, err) before
+ * the step, and grows to the last step drawing to the tile.
+ *
+ * Returns 1, or 0 with a MemoryError set.
+ */
+static int
+queue_split_step(queue_run *run, int index, const SDL_Rect *pixels, int x,
+                 int y, int err, int step)
+{
+    queue_tile_walk *tile_walk;
+    queue_part *part, *parts;
+    SDL_Rect r;
+    Py_ssize_t size;
+    int tx, ty, tile;
+
+    if (!SDL_IntersectRect(pixels, &run->clip, &r)) {
+        return 1;
+    }
+
+    for (ty = (r.y - run->clip.y) / QUEUE_TILE_SIZE;
+         ty <= (r.y + r.h - 1 - run->clip.y) / QUEUE_TILE_SIZE; ty++) {
+        for (tx = (r.x - run->clip.x) / QUEUE_TILE_SIZE;
+             tx <= (r.x + r.w - 1 - run->clip.x) / QUEUE_TILE_SIZE; tx++) {
+            tile = ty * run->tiles_x + tx;
+            tile_walk = &run->tile_walks[tile];
+            if (tile_walk->walk == run->walk) {
+                run->parts[tile_walk->part].count =
+                    step - tile_walk->first + 1;
+                continue;
+            }
+
+            if (run->n_parts == run->parts_size) {
+                size = run->parts_size ? 2 * run->parts_size : 64;
+                parts = PyMem_Resize(run->parts, queue_part, size);
+                if (!parts) {
+                    PyErr_NoMemory();
+                    return 0;
+                }
+                run->parts = parts;
+                run->parts_size = size;
+            }
+
+            tile_walk->walk = run->walk;
+            tile_walk->part = run->n_parts;
+            tile_walk->first = step;
+            part = &run->parts[run->n_parts++];
+            part->index = index;
+            part->tile = tile;
+            part->x = x;
+            part->y = y;
+            part->err = err;
+            part->count = 1;
+            run->tile_starts[tile]++;
+        }
+    }
+    return 1;
+}
+
+/* Splits a QUEUE_LINES or thin QUEUE_CIRCLE command into the parts drawn
+ * to each tile, walking through its steps once.
+ *
+ * Returns 1, or 0 with a MemoryError set.
+ */
+static int
+queue_split(queue_run *run, queue_command *cmd)
+{
+    queue_segment line;
+    SDL_Rect pixels;
+    int i, n, step, x, y, err;
+
+    cmd->part_start = run->n_parts;
+
+    if (cmd->type == QUEUE_LINES) {
+        n = (int)cmd->n_points - (cmd->closed && cmd->n_points > 2 ? 0 : 1);
+        for (i = 0; i < n; i++) {
+            run->walk++;
+            if (!queue_line_setup(&line, cmd, i, &run->clip)) {
+                continue;
+            }
+            for (step = 0;; step++) {
+                queue_line_span(&line, &pixels);
+                if (!queue_split_step(run, i, &pixels, line.x, line.y,
+                                      line.err, step)) {
+                    return 0;
+                }
+                if (!queue_line_continues(&line, &run->clip)) {
+                    break;
+                }
+                queue_line_step(&line);
+            }
+        }
+    }
+    else {
+        pixels.w = pixels.h = 1;
+        for (i = 0; i < 8; i++) {
+            run->walk++;
+            x = 0;
+            y = cmd->radius;
+            err = 1 - cmd->radius;
+            for (step = 0; x < y; step++) {
+                int before_x = x, before_y = y, before_err = err;
+
+                queue_circle_step(cmd, i, &x, &y, &err, &pixels.x,
+                                  &pixels.y);
+                if (!queue_split_step(run, i, &pixels, before_x, before_y,
+                                      before_err, step)) {
+                    return 0;
+                }
+            }
+        }
+    }
+
+    cmd->part_end = run->n_parts;
+    return 1;
+}
+
+/* Draws a part of a QUEUE_LINES or thin QUEUE_CIRCLE command into surf, a
+ * tile of the surface the queue is executed on. */
+static void
+queue_draw_part(queue_run *run, SDL_Surface *surf, const queue_command *cmd,
+                const queue_part *part, int *drawn_area)
+{
+    queue_segment line;
+    int i, x = part->x, y = part->y, err = part->err, px, py;
+
+    if (cmd->type == QUEUE_LINES) {
+        queue_line_setup(&line, cmd, part->index, &run->clip);
+        line.x = x;
+        line.y = y;
+        line.err = err;
+        for (i = 0; i < part->count; i++) {
+            queue_line_draw_span(surf, &line, cmd->color, drawn_area);
+            queue_line_step(&line);
+        }
+    }
+    else {
+        for (i = 0; i < part->count; i++) {
+            queue_circle_step(cmd, part->index, &x, &y, &err, &px, &py);
+            set_and_check_rect(surf, px, py, cmd->color, drawn_area);
+        }
+    }
+}
+
+/* Draws cmd into surf, a tile of the surface the queue is executed on.
+ * Commands that are split into parts are drawn by queue_draw_part().
+ *
+ * Returns 0, or -1 if a blit failed.
+ */
+static int
+queue_draw_command(queue_run *run, SDL_Surface *surf, const queue_command *cmd,
+                   int worker, int *drawn_area)
+{
+    const int *xs = cmd->points, *ys = cmd->points + cmd->n_points;
+    SDL_Rect r;
+
+    switch (cmd->type) {
+        case QUEUE_FILL:
+        case QUEUE_RECT:
+            if (!SDL_IntersectRect(&cmd->bounds, &surf->clip_rect, &r)) {
+                break;
+            }
+            if (cmd->outline) {
+                draw_rect(surf, cmd->rect.x, cmd->rect.y,
+                          cmd->rect.x + cmd->rect.w - 1,
+                          cmd->rect.y + cmd->rect.h - 1, cmd->width,
+                          cmd->color);
+            }
+            else {
+                draw_filled_rect(surf, &r, cmd->color);
+            }
+            add_pixel_to_drawn_list(r.x, r.y, drawn_area);
+            add_pixel_to_drawn_list(r.x + r.w - 1, r.y + r.h - 1,
+                                    drawn_area);
+            break;
+        case QUEUE_CIRCLE:
+            if (!cmd->width || cmd->width == cmd->radius) {
+                draw_circle_filled(surf, cmd->x, cmd->y, cmd->radius,
+                                   cmd->color, drawn_area);
+            }
+            else {
+                draw_circle_bresenham(surf, cmd->x, cmd->y, cmd->radius,
+                                      cmd->width, cmd->color, drawn_area);
+            }
+            break;
+        case QUEUE_POLYGON: {
+            int miny = cmd->extent.y, maxy = miny + cmd->extent.h - 1;
+
+            if (miny == maxy) {
+                /* Special case: polygon only 1 pixel high. */
+                drawhorzlineclipbounding(
+                    surf, cmd->color, cmd->extent.x, miny,
+                    cmd->extent.x + cmd->extent.w - 1, drawn_area);
+                break;
+            }
+            draw_fillpoly_rows(
+                surf, cmd->color, cmd->edges, cmd->n_edges, maxy,
+                MAX(miny, surf->clip_rect.y),
+                MIN(maxy, surf->clip_rect.y + surf->clip_rect.h - 1),
+                run->active + worker * run->max_edges,
+                run->x_intersect + worker * run->max_edges, drawn_area);
+            draw_fillpoly_borders(surf, cmd->color, xs, ys, cmd->n_points,
+                                  miny, maxy, drawn_area);
+            break;
+        }
+        case QUEUE_PATH:
+            aa_spans_draw(&cmd->spans, surf, cmd->rgba, cmd->color, cmd->x,
+                          cmd->y, drawn_area);
+            break;
+        case QUEUE_BLIT: {
+            SDL_Surface src = *cmd->src;
+            SDL_Rect src_rect = cmd->src_rect;
+
+            if (cmd->copy) {
+                queue_copy_rows(surf, cmd, drawn_area);
+                break;
+            }
+
+            /* The source is locked by queue_execute(), which decodes
+             * RLE surfaces, so its pixels can be read as they are. */
+            src.locked = 0;
+            src.flags &= ~SDL_RLEACCEL;
+            r.x = cmd->extent.x;
+            r.y = cmd->extent.y;
+            if (pgSurface_SoftBlit(&src, &src_rect, surf, &r, cmd->flags)) {
+                return -1;
+            }
+            if (r.w > 0 && r.h > 0) {
+                add_pixel_to_drawn_list(r.x, r.y, drawn_area);
+                add_pixel_to_drawn_list(r.x + r.w - 1, r.y + r.h - 1,
+                                        drawn_area);
+            }
+            break;
+        }
+    }
+    return 0;
+}
+
+/* Draws the commands of one tile, on a copy of the surface clipped to
+ * it. */
+static void
+queue_draw_tile(queue_run *run, int tile, int worker, int *drawn_area)
+{
+    SDL_Surface surf = *run->surf;
+    const queue_command *cmd;
+    const queue_item *item;
+    Py_ssize_t i;
+
+    /* The surface is locked by queue_execute(): the copy must not be, for
+     * pygame_Blit(). */
+    surf.locked = 0;
+    surf.flags &= ~SDL_RLEACCEL;
+    surf.clip_rect.x = run->clip.x + tile % run->tiles_x * QUEUE_TILE_SIZE;
+    surf.clip_rect.y = run->clip.y + tile / run->tiles_x * QUEUE_TILE_SIZE;
+    surf.clip_rect.w =
+        MIN(QUEUE_TILE_SIZE, run->clip.x + run->clip.w - surf.clip_rect.x);
+    surf.clip_rect.h =
+        MIN(QUEUE_TILE_SIZE, run->clip.y + run->clip.h - surf.clip_rect.y);
+
+    for (i = run->tile_starts[tile]; i < run->tile_starts[tile + 1]; i++) {
+        item = &run->tile_commands[i];
+        cmd = &run->commands[item->command];
+        if (item->part >= 0) {
+            queue_draw_part(run, &surf, cmd, &run->parts[item->part],
+                            drawn_area);
+        }
+        else if (queue_draw_command(run, &surf, cmd, worker, drawn_area) &&
+                 !run->errors[worker][0]) {
+            SDL_strlcpy(run->errors[worker], SDL_GetError(),
+                        sizeof(run->errors[worker]));
+        }
+    }
+}
+
+static void
+queue_run_workers(void *data, int start, int end)
+{
+    queue_run *run = (queue_run *)data;
+    int worker, tile;
+
+    for (worker = start; worker < end; worker++) {
+        int *drawn_area = run->worker_areas[worker];
+
+        drawn_area[0] = drawn_area[1] = INT_MAX;
+        drawn_area[2] = drawn_area[3] = INT_MIN;
+        run->errors[worker][0] = '\0';
+
+        for (tile = worker; tile < run->n_tiles; tile += run->n_workers) {
+            queue_draw_tile(run, tile, worker, drawn_area);
+        }
+    }
+}
+
+/* Maps the colors of the commands to surf and finds the parts of the clip
+ * area they draw to. Lines and thin circles are split into the parts drawn
+ * to each tile they cross. Counts the commands and parts drawn to each
+ * tile into run->tile_starts, and their sum into *total, and sums the area
+ * they cover into *area.
+ *
+ * Returns 1, or 0 with an exception set.
+ */
+static int
+queue_setup(pgRenderQueueObject *self, queue_run *run, Py_ssize_t *total,
+            Sint64 *area)
+{
+    SDL_Surface *surf = run->surf;
+    queue_command *cmd;
+    Py_ssize_t i;
+    int tx, ty;
+
+    *total = 0;
+    *area = 0;
+    for (i = 0; i < self->n_commands; i++) {
+        cmd = &self->commands[i];
+
+        if (cmd->mapped) {
+            SDL_GetRGBA(cmd->color, surf->format, cmd->rgba, cmd->rgba + 1,
+                        cmd->rgba + 2, cmd->rgba + 3);
+        }
+        else {
+            cmd->color = SDL_MapRGBA(surf->format, cmd->rgba[0], cmd->rgba[1],
+                                     cmd->rgba[2], cmd->rgba[3]);
+        }
+
+        if (cmd->type == QUEUE_BLIT && !queue_setup_blit(cmd, surf)) {
+            return 0;
+        }
+        if (cmd->type == QUEUE_FILL && !cmd->has_rect) {
+            cmd->extent = run->clip;
+        }
+
+        if (!SDL_IntersectRect(&cmd->extent, &run->clip, &cmd->bounds)) {
+            cmd->bounds.w = cmd->bounds.h = 0;
+            continue;
+        }
+
+        if (cmd->type == QUEUE_PATH && !queue_setup_path(cmd)) {
+            return 0;
+        }
+
+        /* draw.rect() outlines rects only when the border leaves a hole in
+         * the part in the clip area. */
+        cmd->outline = cmd->type == QUEUE_RECT && cmd->width > 0 &&
+                       cmd->width * 2 < cmd->bounds.w &&
+                       cmd->width * 2 < cmd->bounds.h;
+
+        *area += (Sint64)cmd->bounds.w * cmd->bounds.h;
+        cmd->split = cmd->type == QUEUE_LINES ||
+                     (cmd->type == QUEUE_CIRCLE && cmd->width == 1 &&
+                      cmd->radius != 1);
+        if (cmd->split) {
+            if (!queue_split(run, cmd)) {
+                return 0;
+            }
+            *total += cmd->part_end - cmd->part_start;
+            continue;
+        }
+        for (ty = (cmd->bounds.y - run->clip.y) / QUEUE_TILE_SIZE;
+             ty <= (cmd->bounds.y + cmd->bounds.h - 1 - run->clip.y) /
+                       QUEUE_TILE_SIZE;
+             ty++) {
+            for (tx = (cmd->bounds.x - run->clip.x) / QUEUE_TILE_SIZE;
+                 tx <= (cmd->bounds.x + cmd->bounds.w - 1 - run->clip.x) /
+                           QUEUE_TILE_SIZE;
+                 tx++) {
+                run->tile_starts[ty * run->tiles_x + tx]++;
+                (*total)++;
+            }
+        }
+        if (cmd->type == QUEUE_POLYGON) {
+            run->max_edges = MAX(run->max_edges, cmd->n_edges);
+        }
+    }
+    return 1;
+}
+
+/* Lists the commands of each tile in tile_commands, in the order they were
+ * recorded, from the counts left in tile_starts by queue_setup(). */
+static void
+queue_bin(pgRenderQueueObject *self, queue_run *run)
+{
+    const queue_command *cmd;
+    queue_item *item;
+    Py_ssize_t i, p, total = 0;
+    int tile, tx, ty;
+
+    /* The end of each tile's commands, which become their start as the
+     * commands are put in from the last one. */
+    for (tile = 0; tile < run->n_tiles; tile++) {
+        total += run->tile_starts[tile];
+        run->tile_starts[tile] = total;
+    }
+    run->tile_starts[run->n_tiles] = total;
+
+    for (i = self->n_commands - 1; i >= 0; i--) {
+        cmd = &self->commands[i];
+        if (cmd->bounds.w <= 0 || cmd->bounds.h <= 0) {
+            continue;
+        }
+        if (cmd->split) {
+            for (p = cmd->part_end - 1; p >= cmd->part_start; p--) {
+                tile = run->parts[p].tile;
+                item = &run->tile_commands[--run->tile_starts[tile]];
+                item->command = i;
+                item->part = p;
+            }
+            continue;
+        }
+        for (ty = (cmd->bounds.y - run->clip.y) / QUEUE_TILE_SIZE;
+             ty <= (cmd->bounds.y + cmd->bounds.h - 1 - run->clip.y) /
+                       QUEUE_TILE_SIZE;
+             ty++) {
+            for (tx = (cmd->bounds.x - run->clip.x) / QUEUE_TILE_SIZE;
+                 tx <= (cmd->bounds.x + cmd->bounds.w - 1 - run->clip.x) /
+                           QUEUE_TILE_SIZE;
+                 tx++) {
+                tile = ty * run->tiles_x + tx;
+                item = &run->tile_commands[--run->tile_starts[tile]];
+                item->command = i;
+                item->part = -1;
+            }
+        }
+    }
+}
+
+/* Locks the surface and the sources of the blits, or unlocks them.
+ *
+ * Returns 1, or 0 with a RuntimeError set if one could not be locked or
+ * unlocked, undoing the locks already made when locking.
+ */
+static int
+queue_lock(pgRenderQueueObject *self, pgSurfaceObject *surfobj, int lock)
+{
+    Py_ssize_t i;
+    int result = 1;
+
+    if (lock && !pgSurface_Lock(surfobj)) {
+        PyErr_SetString(PyExc_RuntimeError, "error locking surface");
+        return 0;
+    }
+
+    for (i = 0; i < self->n_commands; i++) {
+        pgSurfaceObject *source =
+            (pgSurfaceObject *)self->commands[i].source;
+
+        if (!source) {
+            continue;
+        }
+        if (!lock) {
+            result = pgSurface_Unlock(source) && result;
+        }
+        else if (!pgSurface_Lock(source)) {
+            while (--i >= 0) {
+                if (self->commands[i].source) {
+                    pgSurface_Unlock(
+                        (pgSurfaceObject *)self->commands[i].source);
+                }
+            }
+            pgSurface_Unlock(surfobj);
+            PyErr_SetString(PyExc_RuntimeError, "error locking surface");
+            return 0;
+        }
+    }
+
+    if (!lock && !(pgSurface_Unlock(surfobj) && result)) {
+        PyErr_SetString(PyExc_RuntimeError, "error unlocking surface");
+        return 0;
+    }
+    return 1;
+}
+
+static void
+queue_dealloc(PyObject *self)
+{
+    queue_clear((pgRenderQueueObject *)self);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int
+queue_init(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *keywords[] = {NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, ":RenderQueue",
+                                     keywords)) {
+        return -1;
+    }
+
+    if (!queue_check_idle(self)) {
+        return -1;
+    }
+    queue_clear(self);
+    return 0;
+}
+
+static Py_ssize_t
+queue_length(pgRenderQueueObject *self)
+{
+    return self->n_commands;
+}
+
+static PyObject *
+queue_fill(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *colorobj, *rectobj = Py_None;
+    SDL_Rect *rect, temp;
+    queue_command cmd = {0};
+    static char *keywords[] = {"color", "rect", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", keywords,
+                                     &colorobj, &rectobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!queue_check_idle(self) || !queue_color_from_obj(colorobj, &cmd)) {
+        return NULL;
+    }
+
+    if (rectobj != Py_None) {
+        if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+            return RAISE(PyExc_TypeError, "rect argument is invalid");
+        }
+        cmd.rect = cmd.extent = *rect;
+        cmd.has_rect = 1;
+    }
+
+    cmd.type = QUEUE_FILL;
+    return queue_push(self, &cmd);
+}
+
+static PyObject *
+queue_rect(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *colorobj, *rectobj;
+    SDL_Rect *rect, temp;
+    queue_command cmd = {0};
+    static char *keywords[] = {"color", "rect", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i", keywords,
+                                     &colorobj, &rectobj, &cmd.width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+        return RAISE(PyExc_TypeError, "rect argument is invalid");
+    }
+
+    if (!queue_check_idle(self) || !queue_color_from_obj(colorobj, &cmd)) {
+        return NULL;
+    }
+
+    if (cmd.width < 0) {
+        Py_RETURN_NONE; /* Nothing is drawn. */
+    }
+
+    cmd.type = QUEUE_RECT;
+    cmd.rect = cmd.extent = *rect;
+    return queue_push(self, &cmd);
+}
+
+static PyObject *
+queue_line(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *colorobj, *start, *end;
+    int startx, starty, endx, endy;
+    queue_command cmd = {0};
+    static char *keywords[] = {"color", "start_pos", "end_pos", "width",
+                               NULL};
+
+    cmd.width = 1; /* Default width. */
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|i", keywords,
+                                     &colorobj, &start, &end, &cmd.width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!pg_TwoIntsFromObj(start, &startx, &starty)) {
+        return RAISE(PyExc_TypeError, "invalid start_pos argument");
+    }
+
+    if (!pg_TwoIntsFromObj(end, &endx, &endy)) {
+        return RAISE(PyExc_TypeError, "invalid end_pos argument");
+    }
+
+    if (!queue_check_idle(self) || !queue_color_from_obj(colorobj, &cmd)) {
+        return NULL;
+    }
+
+    if (cmd.width < 1) {
+        Py_RETURN_NONE; /* Nothing is drawn. */
+    }
+
+    cmd.points = PyMem_New(int, 4);
+    if (!cmd.points) {
+        return PyErr_NoMemory();
+    }
+    cmd.type = QUEUE_LINES;
+    cmd.n_points = 2;
+    cmd.points[0] = startx;
+    cmd.points[1] = endx;
+    cmd.points[2] = starty;
+    cmd.points[3] = endy;
+    queue_points_extent(&cmd, cmd.width);
+    return queue_push(self, &cmd);
+}
+
+static PyObject *
+queue_lines(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *colorobj, *closedobj, *points;
+    queue_command cmd = {0};
+    static char *keywords[] = {"color", "closed", "points", "width", NULL};
+
+    cmd.width = 1; /* Default width. */
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|i", keywords,
+                                     &colorobj, &closedobj, &points,
+                                     &cmd.width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!queue_check_idle(self) || !queue_color_from_obj(colorobj, &cmd)) {
+        return NULL;
+    }
+
+    cmd.closed = PyObject_IsTrue(closedobj);
+    if (-1 == cmd.closed) {
+        return RAISE(PyExc_TypeError, "closed argument is invalid");
+    }
+
+    if (!queue_points_from_obj(points, 2,
+                               "points argument must contain 2 or more "
+                               "points",
+                               &cmd)) {
+        queue_command_free(&cmd);
+        return NULL;
+    }
+
+    if (cmd.width < 1) {
+        queue_command_free(&cmd);
+        Py_RETURN_NONE; /* Nothing is drawn. */
+    }
+
+    cmd.type = QUEUE_LINES;
+    queue_points_extent(&cmd, cmd.width);
+    return queue_push(self, &cmd);
+}
+
+static PyObject *
+queue_circle(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *colorobj, *posobj, *radiusobj;
+    queue_command cmd = {0};
+    static char *keywords[] = {"color", "center", "radius", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|i", keywords,
+                                     &colorobj, &posobj, &radiusobj,
+                                     &cmd.width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!pg_TwoIntsFromObj(posobj, &cmd.x, &cmd.y)) {
+        return RAISE(PyExc_TypeError,
+                     "center argument must be a pair of numbers");
+    }
+
+    if (!pg_IntFromObj(radiusobj, &cmd.radius)) {
+        return RAISE(PyExc_TypeError, "radius argument must be a number");
+    }
+
+    if (!queue_check_idle(self) || !queue_color_from_obj(colorobj, &cmd)) {
+        return NULL;
+    }
+
+    if (cmd.radius < 1 || cmd.width < 0) {
+        Py_RETURN_NONE; /* Nothing is drawn. */
+    }
+
+    cmd.type = QUEUE_CIRCLE;
+    cmd.width = MIN(cmd.width, cmd.radius);
+    cmd.extent.x = cmd.x - cmd.radius - 1;
+    cmd.extent.y = cmd.y - cmd.radius - 1;
+    cmd.extent.w = cmd.extent.h = 2 * cmd.radius + 3;
+    return queue_push(self, &cmd);
+}
+
+static PyObject *
+queue_polygon(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *colorobj, *points;
+    queue_command cmd = {0};
+    static char *keywords[] = {"color", "points", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i", keywords,
+                                     &colorobj, &points, &cmd.width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!queue_check_idle(self) || !queue_color_from_obj(colorobj, &cmd)) {
+        return NULL;
+    }
+
+    if (cmd.width) {
+        /* Outlined as draw.polygon() does, with draw.lines(). */
+        if (!queue_points_from_obj(points, 2,
+                                   "points argument must contain 2 or more "
+                                   "points",
+                                   &cmd)) {
+            queue_command_free(&cmd);
+            return NULL;
+        }
+        if (cmd.width < 1) {
+            queue_command_free(&cmd);
+            Py_RETURN_NONE; /* Nothing is drawn. */
+        }
+        cmd.type = QUEUE_LINES;
+        cmd.closed = 1;
+        queue_points_extent(&cmd, cmd.width);
+        return queue_push(self, &cmd);
+    }
+
+    if (!queue_points_from_obj(points, 3,
+                               "points argument must contain more than 2 "
+                               "points",
+                               &cmd)) {
+        queue_command_free(&cmd);
+        return NULL;
+    }
+
+    cmd.edges = PyMem_New(poly_edge, cmd.n_points);
+    if (!cmd.edges) {
+        queue_command_free(&cmd);
+        return PyErr_NoMemory();
+    }
+    cmd.n_edges = draw_fillpoly_edges(cmd.points, cmd.points + cmd.n_points,
+                                      cmd.n_points, cmd.edges);
+    cmd.type = QUEUE_POLYGON;
+    queue_points_extent(&cmd, 0);
+    return queue_push(self, &cmd);
+}
+
+static PyObject *
+queue_path(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgPathObject *path;
+    PyObject *colorobj, *posobj = NULL;
+    queue_command cmd = {0};
+    float posx = 0.0f, posy = 0.0f, width = 0.0f; /* Default width. */
+    float fx, fy;
+    static char *keywords[] = {"path", "color", "pos", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|Of", keywords,
+                                     &pgPath_Type, &path, &colorobj, &posobj,
+                                     &width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (posobj && !pg_TwoFloatsFromObj(posobj, &posx, &posy)) {
+        return RAISE(PyExc_TypeError, "pos argument must be a pair of numbers");
+    }
+
+    if (!queue_check_idle(self) || !queue_color_from_obj(colorobj, &cmd)) {
+        return NULL;
+    }
+
+    if (!isfinite(posx) || !isfinite(posy) || !isfinite(width)) {
+        return RAISE(PyExc_ValueError,
+                     "pos and width arguments must be finite");
+    }
+
+    if (width < 0) {
+        Py_RETURN_NONE; /* Nothing is drawn. */
+    }
+
+    /* The outline is kept, to be rasterized within the clip area of the
+     * surface the queue is executed on. */
+    path_split_pos(posx, posy, &cmd.x, &cmd.y, &fx, &fy);
+    if (path_outline(path, &cmd.path, width, fx, fy)) {
+        aa_path_free(&cmd.path);
+        return PyErr_NoMemory();
+    }
+
+    aa_path_bounds(&cmd.path, &cmd.path_bounds);
+    if (cmd.path_bounds.w > 0 && cmd.path_bounds.h > 0) {
+        cmd.extent = cmd.path_bounds;
+        cmd.extent.x += cmd.x;
+        cmd.extent.y += cmd.y;
+    }
+
+    cmd.type = QUEUE_PATH;
+    return queue_push(self, &cmd);
+}
+
+static PyObject *
+queue_blit(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *source, *destobj, *areaobj = Py_None;
+    SDL_Rect *rect, temp;
+    queue_command cmd = {0};
+    static char *keywords[] = {"source", "dest", "area", "special_flags",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|Oi", keywords,
+                                     &pgSurface_Type, &source, &destobj,
+                                     &areaobj, &cmd.flags)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!pg_TwoIntsFromObj(destobj, &cmd.x, &cmd.y)) {
+        if (!(rect = pgRect_FromObject(destobj, &temp))) {
+            return RAISE(PyExc_TypeError, "invalid destination position");
+        }
+        cmd.x = rect->x;
+        cmd.y = rect->y;
+    }
+
+    if (areaobj != Py_None) {
+        if (!(rect = pgRect_FromObject(areaobj, &temp))) {
+            return RAISE(PyExc_TypeError, "invalid area argument");
+        }
+        cmd.rect = *rect;
+        cmd.has_rect = 1;
+    }
+
+    if (cmd.flags < 0 || cmd.flags > PYGAME_BLEND_PREMULTIPLIED) {
+        return RAISE(PyExc_ValueError,
+                     "special_flags must be 0 or a BLEND_ flag other than "
+                     "BLEND_ALPHA_SDL2");
+    }
+
+    if (!queue_check_idle(self)) {
+        return NULL;
+    }
+
+    Py_INCREF(source);
+    cmd.source = source;
+    cmd.type = QUEUE_BLIT;
+    return queue_push(self, &cmd);
+}
+
+static PyObject *
+queue_clear_method(pgRenderQueueObject *self, PyObject *_null)
+{
+    if (!queue_check_idle(self)) {
+        return NULL;
+    }
+    queue_clear(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+queue_execute(pgRenderQueueObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    SDL_Surface *surf;
+    queue_run run;
+    PyObject *ret = NULL;
+    Py_ssize_t total;
+    Sint64 area;
+    int worker, cpus;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    static char *keywords[] = {"surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!", keywords,
+                                     &pgSurface_Type, &surfobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    if (!queue_check_idle(self)) {
+        return NULL;
+    }
+
+    memset(&run, 0, sizeof(run));
+    run.surf = surf;
+    run.clip = surf->clip_rect;
+    run.commands = self->commands;
+    if (!self->n_commands || run.clip.w <= 0 || run.clip.h <= 0) {
+        return pgRect_New4(run.clip.x, run.clip.y, 0, 0);
+    }
+
+    run.tiles_x = (run.clip.w + QUEUE_TILE_SIZE - 1) / QUEUE_TILE_SIZE;
+    run.n_tiles = run.tiles_x *
+                  ((run.clip.h + QUEUE_TILE_SIZE - 1) / QUEUE_TILE_SIZE);
+    run.tile_starts = PyMem_New(Py_ssize_t, run.n_tiles + 1);
+    if (!run.tile_starts) {
+        return PyErr_NoMemory();
+    }
+    memset(run.tile_starts, 0, sizeof(Py_ssize_t) * (run.n_tiles + 1));
+    run.tile_walks = PyMem_New(queue_tile_walk, run.n_tiles);
+    if (!run.tile_walks) {
+        PyMem_Free(run.tile_starts);
+        return PyErr_NoMemory();
+    }
+    memset(run.tile_walks, 0, sizeof(queue_tile_walk) * run.n_tiles);
+
+    self->executing = 1;
+    if (!queue_setup(self, &run, &total, &area)) {
+        goto end;
+    }
+    run.tile_commands = PyMem_New(queue_item, MAX(total, 1));
+
+    /* Small queues are drawn by the calling thread. */
+    cpus = MIN(SDL_GetCPUCount(), PG_PARALLEL_MAX_THREADS);
+    run.n_workers =
+        area < DRAW_PARALLEL_MIN_PIXELS ? 1 : MIN(cpus, run.n_tiles);
+    if (run.max_edges) {
+        run.active =
+            PyMem_New(const poly_edge *, run.n_workers * run.max_edges);
+        run.x_intersect = PyMem_New(int, run.n_workers * run.max_edges);
+    }
+    if (!run.tile_commands ||
+        (run.max_edges && (!run.active || !run.x_intersect))) {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    queue_bin(self, &run);
+
+    if (!queue_lock(self, surfobj, 1)) {
+        goto end;
+    }
+
+    if (run.n_workers > 1) {
+        Py_BEGIN_ALLOW_THREADS;
+        pg_parallel_for(run.n_workers, 1, queue_run_workers, &run);
+        Py_END_ALLOW_THREADS;
+    }
+    else {
+        queue_run_workers(&run, 0, 1);
+    }
+
+    draw_merge_bands(run.worker_areas, run.n_workers, drawn_area);
+    if (!queue_lock(self, surfobj, 0)) {
+        goto end;
+    }
+
+    /* Anything drawn before a blit failed is kept, and recorded. */
+    ret = drawn_rect(surfobj, drawn_area, run.clip.x, run.clip.y);
+    for (worker = 0; worker < run.n_workers; worker++) {
+        if (run.errors[worker][0]) {
+            Py_XDECREF(ret);
+            ret = RAISE(pgExc_SDLError, run.errors[worker]);
+            break;
+        }
+    }
+
+end:
+    self->executing = 0;
+    PyMem_Free(run.tile_starts);
+    PyMem_Free(run.tile_commands);
+    PyMem_Free(run.parts);
+    PyMem_Free(run.tile_walks);
+    PyMem_Free(run.active);
+    PyMem_Free(run.x_intersect);
+    return ret;
+}
+
+static PyMethodDef queue_methods[] = {
+    {"fill", (PyCFunction)queue_fill, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUEFILL},
+    {"blit", (PyCFunction)queue_blit, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUEBLIT},
+    {"rect", (PyCFunction)queue_rect, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUERECT},
+    {"line", (PyCFunction)queue_line, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUELINE},
+    {"lines", (PyCFunction)queue_lines, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUELINES},
+    {"circle", (PyCFunction)queue_circle, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUECIRCLE},
+    {"polygon", (PyCFunction)queue_polygon, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUEPOLYGON},
+    {"path", (PyCFunction)queue_path, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUEPATH},
+    {"clear", (PyCFunction)queue_clear_method, METH_NOARGS,
+     DOC_RENDERQUEUECLEAR},
+    {"execute", (PyCFunction)queue_execute, METH_VARARGS | METH_KEYWORDS,
+     DOC_RENDERQUEUEEXECUTE},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods queue_as_sequence = {
+    .sq_length = (lenfunc)queue_length,
+};
+
+static PyTypeObject pgRenderQueue_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.draw.RenderQueue",
+    .tp_basicsize = sizeof(pgRenderQueueObject),
+    .tp_dealloc = queue_dealloc,
+    .tp_as_sequence = &queue_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEDRAWRENDERQUEUE,
+    .tp_methods = queue_methods,
+    .tp_init = (initproc)queue_init,
+    .tp_new = PyType_GenericNew,
+};
+
+/* Functions used in drawing algorithms */
+
+static void
+swap(float *a, float *b)
+{
+    float temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+static int
+compare_edge_y1(const void *a, const void *b)
+{
+    return ((const poly_edge *)a)->y1 - ((const poly_edge *)b)->y1;
+}
+
+static int
+sign(int x, int y)
+{
+    return (x > 0) ? 1 : ((x < 0) ? -1 : y);
+}
+
+static Uint32
+get_antialiased_color(SDL_Surface *surf, int x, int y, Uint32 original_color,
+                      float brightness, int blend)
+{
+    Uint8 color_part[4], background_color[4];
+    Uint32 *pixels = (Uint32 *)surf->pixels;
+    SDL_GetRGBA(original_color, surf->format, &color_part[0], &color_part[1],
+                &color_part[2], &color_part[3]);
+    if (blend) {
+        if (x < surf->clip_rect.x ||
+            x >= surf->clip_rect.x + surf->clip_rect.w ||
+            y < surf->clip_rect.y ||
+            y >= surf->clip_rect.y + surf->clip_rect.h)
+            return original_color;
+        SDL_GetRGBA(pixels[(y * surf->w) + x], surf->format,
+                    &background_color[0], &background_color[1],
+                    &background_color[2], &background_color[3]);
+        color_part[0] = (Uint8)(brightness * color_part[0] +
+                                (1 - brightness) * background_color[0]);
+        color_part[1] = (Uint8)(brightness * color_part[1] +
+                                (1 - brightness) * background_color[1]);
+        color_part[2] = (Uint8)(brightness * color_part[2] +
+                                (1 - brightness) * background_color[2]);
+        color_part[3] = (Uint8)(brightness * color_part[3] +
+                                (1 - brightness) * background_color[3]);
+    }
+    else {
+        color_part[0] = (Uint8)(brightness * color_part[0]);
+        color_part[1] = (Uint8)(brightness * color_part[1]);
+        color_part[2] = (Uint8)(brightness * color_part[2]);
+        color_part[3] = (Uint8)(brightness * color_part[3]);
+    }
+    original_color = SDL_MapRGBA(surf->format, color_part[0], color_part[1],
+                                 color_part[2], color_part[3]);
+    return original_color;
+}
+
+static void
+add_pixel_to_drawn_list(int x, int y, int *pts)
+{
+    if (x < pts[0]) {
+        pts[0] = x;
+    }
+    if (y < pts[1]) {
+        pts[1] = y;
+    }
+    if (x > pts[2]) {
+        pts[2] = x;
+    }
+    if (y > pts[3]) {
+        pts[3] = y;
+    }
+}
+
+static int
+clip_line(const SDL_Rect *clip, int *x1, int *y1, int *x2, int *y2)
+{
+    int p1 = *x1 - *x2;
+    int p2 = -p1;
+    int p3 = *y1 - *y2;
+    int p4 = -p3;
+    int q1 = *x1 - clip->x;
+    int q2 = clip->w + clip->x - *x1;
+    int q3 = *y1 - clip->y;
+    int q4 = clip->h + clip->y - *y1;
+    int old_x1 = *x1;
+    int old_y1 = *y1;
+    double nmax = 0;
+    double pmin = 1;
+    double r1, r2;
+    if ((p1 == 0 && q1 < 0) || (p2 == 0 && q2 < 0) || (p3 == 0 && q3 < 0) ||
+        (p4 == 0 && q4 < 0))
+        return 0;
+    if (p1) {
+        r1 = (double)q1 / p1;
+        r2 = (double)q2 / p2;
+        if (p1 < 0) {
+            if (r1 > nmax)
+                nmax = r1;
+            if (r2 < pmin)
+                pmin = r2;
+        }
+        else {
+            if (r2 > nmax)
+                nmax = r2;
+            if (r1 < pmin)
+                pmin = r1;
+        }
+    }
+    if (p3) {
+        r1 = (double)q3 / p3;
+        r2 = (double)q4 / p4;
+        if (p3 < 0) {
+            if (r1 > nmax)
+                nmax = r1;
+            if (r2 < pmin)
+                pmin = r2;
+        }
+        else {
+            if (r2 > nmax)
+                nmax = r2;
+            if (r1 < pmin)
+                pmin = r1;
+        }
+    }
+    if (nmax > pmin)
+        return 0;
+    *x1 =
+        old_x1 + (int)(p2 * nmax < 0 ? (p2 * nmax - 0.5) : (p2 * nmax + 0.5));
+    *y1 =
+        old_y1 + (int)(p4 * nmax < 0 ? (p4 * nmax - 0.5) : (p4 * nmax + 0.5));
+    *x2 =
+        old_x1 + (int)(p2 * pmin < 0 ? (p2 * pmin - 0.5) : (p2 * pmin + 0.5));
+    *y2 =
+        old_y1 + (int)(p4 * pmin < 0 ? (p4 * pmin - 0.5) : (p4 * pmin + 0.5));
+    return 1;
+}
+
+static int
+set_at(SDL_Surface *surf, int x, int y, Uint32 color)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    Uint8 *byte_buf, rgb[4];
+
+    if (x < surf->clip_rect.x || x >= surf->clip_rect.x + surf->clip_rect.w ||
+        y < surf->clip_rect.y || y >= surf->clip_rect.y + surf->clip_rect.h)
+        return 0;
+
+    switch (format->BytesPerPixel) {
+        case 1:
+            *((Uint8 *)pixels + y * surf->pitch + x) = (Uint8)color;
+            break;
+        case 2:
+            *((Uint16 *)(pixels + y * surf->pitch) + x) = (Uint16)color;
+            break;
+        case 4:
+            *((Uint32 *)(pixels + y * surf->pitch) + x) = color;
+            break;
+        default: /*case 3:*/
+            SDL_GetRGB(color, format, rgb, rgb + 1, rgb + 2);
+            byte_buf = (Uint8 *)(pixels + y * surf->pitch) + x * 3;
+#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+            *(byte_buf + (format->Rshift >> 3)) = rgb[0];
+            *(byte_buf + (format->Gshift >> 3)) = rgb[1];
+            *(byte_buf + (format->Bshift >> 3)) = rgb[2];
+#else
+            *(byte_buf + 2 - (format->Rshift >> 3)) = rgb[0];
+            *(byte_buf + 2 - (format->Gshift >> 3)) = rgb[1];
+            *(byte_buf + 2 - (format->Bshift >> 3)) = rgb[2];
+#endif
+            break;
+    }
+    return 1;
+}
+
+static void
+set_and_check_rect(SDL_Surface *surf, int x, int y, Uint32 color,
+                   int *drawn_area)
+{
+    if (set_at(surf, x, y, color))
+        add_pixel_to_drawn_list(x, y, drawn_area);
+}
+
+static void
+draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
+            float to_x, float to_y, int blend, int *drawn_area)
+{
+    float gradient, dx, dy, intersect_y, brightness;
+    int x, x_pixel_start, x_pixel_end;
+    Uint32 pixel_color;
+    float x_gap, y_endpoint, clip_left, clip_right, clip_top, clip_bottom;
+    int steep, y;
+
+    dx = to_x - from_x;
+    dy = to_y - from_y;
+
+    /* Single point.
+     * A line with length 0 is drawn as a single pixel at full brightness. */
+    if (fabs(dx) < 0.0001 && fabs(dy) < 0.0001) {
+        pixel_color =
+            get_antialiased_color(surf, (int)floor(from_x + 0.5),
+                                  (int)floor(from_y + 0.5), color, 1, blend);
+        set_and_check_rect(surf, (int)floor(from_x + 0.5),
+                           (int)floor(from_y + 0.5), pixel_color, drawn_area);
+        return;
+    }
+
+    /* To draw correctly the pixels at the border of the clipping area when
+     * the line crosses it, we need to clip it one pixel wider in all four
+     * directions: */
+    clip_left = (float)surf->clip_rect.x - 1.0f;
+    clip_right = (float)clip_left + surf->clip_rect.w + 1.0f;
+    clip_top = (float)surf->clip_rect.y - 1.0f;
+    clip_bottom = (float)clip_top + surf->clip_rect.h + 1.0f;
+
+    steep = fabs(dx) < fabs(dy);
+    if (steep) {
+        swap(&from_x, &from_y);
+        swap(&to_x, &to_y);
+        swap(&dx, &dy);
+        swap(&clip_left, &clip_top);
+        swap(&clip_right, &clip_bottom);
+    }
+    if (dx < 0) {
+        swap(&from_x, &to_x);
+        swap(&from_y, &to_y);
+        dx = -dx;
+        dy = -dy;
+    }
+
+    if (to_x <= clip_left || from_x >= clip_right) {
+        /* The line is completly to the side of the surface */
+        return;
+    }
+
+    /* Note. There is no need to guard against a division by zero here. If dx
+     * was zero then either we had a single point (and we've returned) or it
+     * has been swapped with a non-zero dy. */
+    gradient = dy / dx;
+
+    /* No need to waste CPU cycles on pixels not on the surface. */
+    if (from_x < clip_left) {
+        from_y += gradient * (clip_left - from_x);
+        from_x = clip_left;
+    }
+    if (to_x > clip_right) {
+        to_y += gradient * (clip_right - to_x);
+        to_x = clip_right;
+    }
+
+    if (gradient > 0.0f) {
+        /* from_ is the topmost endpoint */
+        if (to_y <= clip_top || from_y >= clip_bottom) {
+            /* The line does not enter the surface */
+            return;
+        }
+        if (from_y < clip_top) {
+            from_x += (clip_top - from_y) / gradient;
+            from_y = clip_top;
+        }
+        if (to_y > clip_bottom) {
+            to_x += (clip_bottom - to_y) / gradient;
+            to_y = clip_bottom;
+        }
+    }
+    else {
+        /* to_ is the topmost endpoint */
+        if (from_y <= clip_top || to_y >= clip_bottom) {
+            /* The line does not enter the surface */
+            return;
+        }
+        if (to_y < clip_top) {
+            to_x += (clip_top - to_y) / gradient;
+            to_y = clip_top;
+        }
+        if (from_y > clip_bottom) {
+            from_x += (clip_bottom - from_y) / gradient;
+            from_y = clip_bottom;
+        }
+    }
+    /* By moving the points one pixel down, we can assume y is never negative.
+     * That permit us to use (int)y to round down intead of having to use
+     * floor(y). We then draw the pixels one higher.*/
+    from_y += 1.0f;
+    to_y += 1.0f;
+
+    /* Handle endpoints separatly.
+     * The line is not a mathematical line of thickness zero. The same
+     * goes for the endpoints. The have a height and width of one pixel. */
+    /* First endpoint */
+    x_pixel_start = (int)from_x;
+    y_endpoint = intersect_y = from_y + gradient * (x_pixel_start - from_x);
+    if (to_x > clip_left + 1.0f) {
+        x_gap = 1 + x_pixel_start - from_x;
+        brightness = y_endpoint - (int)y_endpoint;
+        if (steep) {
+            x = (int)y_endpoint;
+            y = x_pixel_start;
+        }
+        else {
+            x = x_pixel_start;
+            y = (int)y_endpoint;
+        }
+        if ((int)y_endpoint < y_endpoint) {
+            pixel_color = get_antialiased_color(surf, x, y, color,
+                                                brightness * x_gap, blend);
+            set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+        }
+        if (steep) {
+            x--;
+        }
+        else {
+            y--;
+        }
+        brightness = 1 - brightness;
+        pixel_color = get_antialiased_color(surf, x, y, color,
+                                            brightness * x_gap, blend);
+        set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+        intersect_y += gradient;
+        x_pixel_start++;
+    }
+    /* Second endpoint */
+    x_pixel_end = (int)ceil(to_x);
+    if (from_x < clip_right - 1.0f) {
+        y_endpoint = to_y + gradient * (x_pixel_end - to_x);
+        x_gap = 1 - x_pixel_end + to_x;
+        brightness = y_endpoint - (int)y_endpoint;
+        if (steep) {
+            x = (int)y_endpoint;
+            y = x_pixel_end;
+        }
+        else {
+            x = x_pixel_end;
+            y = (int)y_endpoint;
+        }
+        if ((int)y_endpoint < y_endpoint) {
+            pixel_color = get_antialiased_color(surf, x, y, color,
+                                                brightness * x_gap, blend);
+            set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+        }
+        if (steep) {
+            x--;
+        }
+        else {
+            y--;
+        }
+        brightness = 1 - brightness;
+        pixel_color = get_antialiased_color(surf, x, y, color,
+                                            brightness * x_gap, blend);
+        set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+    }
+
+    /* main line drawing loop */
+    for (x = x_pixel_start; x < x_pixel_end; x++) {
+        y = (int)intersect_y;
+        if (steep) {
+            brightness = 1 - intersect_y + y;
+            pixel_color = get_antialiased_color(surf, y - 1, x, color,
+                                                brightness, blend);
+            set_and_check_rect(surf, y - 1, x, pixel_color, drawn_area);
+            if (y < intersect_y) {
+                brightness = 1 - brightness;
+                pixel_color = get_antialiased_color(surf, y, x, color,
+                                                    brightness, blend);
+                set_and_check_rect(surf, y, x, pixel_color, drawn_area);
+            }
+        }
+        else {
+            brightness = 1 - intersect_y + y;
+            pixel_color = get_antialiased_color(surf, x, y - 1, color,
+                                                brightness, blend);
+            set_and_check_rect(surf, x, y - 1, pixel_color, drawn_area);
+            if (y < intersect_y) {
+                brightness = 1 - brightness;
+                pixel_color = get_antialiased_color(surf, x, y, color,
+                                                    brightness, blend);
+                set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+            }
+        }
+        intersect_y += gradient;
+    }
+}
+
+/* Bytes in a fill_span() block, a whole number of pixels for every pixel
+ * format. */
+#define SPAN_BLOCK_BYTES 48
+
+/* Sets count pixels of bpp bytes, starting at pixel, to color.
+ *
+ * Long spans are written a 48 byte block at a time from a block pre-filled
+ * with the color, which compilers turn into wide vector stores for any pixel
+ * format, including 24 bit pixels.
+ */
+static void
+fill_span(Uint8 *pixel, int count, Uint32 color, int bpp)
+{
+    Uint8 block[SPAN_BLOCK_BYTES];
+    int block_pixels = SPAN_BLOCK_BYTES / bpp;
+    int i;
+
+    if (bpp == 1) {
+        memset(pixel, (Uint8)color, count);
+        return;
+    }
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    if (bpp == 3) {
+        color <<= 8;
+    }
+    else if (bpp == 2) {
+        color <<= 16;
+    }
+#endif
+
+    if (count < block_pixels) {
+        for (i = 0; i < count; i++, pixel += bpp) {
+            memcpy(pixel, &color, bpp);
+        }
+        return;
+    }
+
+    for (i = 0; i < SPAN_BLOCK_BYTES; i += bpp) {
+        memcpy(block + i, &color, bpp);
+    }
+    for (; count >= block_pixels; count -= block_pixels) {
+        memcpy(pixel, block, SPAN_BLOCK_BYTES);
+        pixel += SPAN_BLOCK_BYTES;
+    }
+    memcpy(pixel, block, count * bpp);
+}
+
+static void
+drawhorzline(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
+{
+    int bpp = surf->format->BytesPerPixel;
+
+    if (x1 == x2) {
+        return;
+    }
+
+    if (x1 > x2) {
+        int temp = x1;
+        x1 = x2;
+        x2 = temp;
+    }
+    fill_span((Uint8 *)surf->pixels + surf->pitch * y1 + x1 * bpp,
+              x2 - x1 + 1, color, bpp);
+}
+
+static void
+drawhorzlineclip(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
+{
+    if (y1 < surf->clip_rect.y || y1 >= surf->clip_rect.y + surf->clip_rect.h)
+        return;
+
+    if (x2 < x1) {
+        int temp = x1;
+        x1 = x2;
+        x2 = temp;
+    }
+
+    x1 = MAX(x1, surf->clip_rect.x);
+    x2 = MIN(x2, surf->clip_rect.x + surf->clip_rect.w - 1);
+
+    if (x2 < surf->clip_rect.x || x1 >= surf->clip_rect.x + surf->clip_rect.w)
+        return;
+
+    if (x1 == x2) {
+        set_at(surf, x1, y1, color);
+        return;
+    }
+    drawhorzline(surf, color, x1, y1, x2);
+}
+
+static void
+drawhorzlineclipbounding(SDL_Surface *surf, Uint32 color, int x1, int y1,
+                         int x2, int *pts)
+{
+    if (y1 < surf->clip_rect.y || y1 >= surf->clip_rect.y + surf->clip_rect.h)
+        return;
+
+    if (x2 < x1) {
+        int temp = x1;
+        x1 = x2;
+        x2 = temp;
+    }
+
+    x1 = MAX(x1, surf->clip_rect.x);
+    x2 = MIN(x2, surf->clip_rect.x + surf->clip_rect.w - 1);
+
+    if (x2 < surf->clip_rect.x || x1 >= surf->clip_rect.x + surf->clip_rect.w)
+        return;
+
+    if (x1 == x2) {
+        set_and_check_rect(surf, x1, y1, color, pts);
+        return;
+    }
+
+    add_pixel_to_drawn_list(x1, y1, pts);
+    add_pixel_to_drawn_list(x2, y1, pts);
+
+    drawhorzline(surf, color, x1, y1, x2);
+}
+
+static int
+inside_clip(const SDL_Rect *clip, int x, int y)
+{
+    if (x < clip->x || x >= clip->x + clip->w || y < clip->y ||
+        y >= clip->y + clip->h)
+        return 0;
+    return 1;
+}
+
+static void
+draw_line_width(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2,
+                int y2, int width, int *drawn_area)
+{
+    draw_line_width_within(surf, &surf->clip_rect, color, x1, y1, x2, y2,
+                           width, drawn_area);
+}
+
+/* Draws a line as draw_line_width() would on a surface clipped to bounds,
+ * writing only the pixels inside the clip rect of surf, which must lie within
+ * bounds. So the line is the same whatever part of it is drawn.
+ */
+static void
+draw_line_width_within(SDL_Surface *surf, const SDL_Rect *bounds,
+                       Uint32 color, int x1, int y1, int x2, int y2,
+                       int width, int *drawn_area)
+{
+    int dx, dy, err, e2, sx, sy, y;
+    int left_top, right_bottom;
+    int end_x = x2;
+    int end_y = y2;
+    int xinc = 0;
+    /* Decide which direction to grow (width/thickness). */
+    if (abs(x1 - x2) <= abs(y1 - y2)) {
+        /* The line's thickness will be in the x direction. The top/bottom
+         * ends of the line will be flat. */
+        xinc = 1;
+    }
+    dx = abs(x2 - x1);
+    sx = x1 < x2 ? 1 : -1;
+    dy = abs(y2 - y1);
+    sy = y1 < y2 ? 1 : -1;
+    err = (dx > dy ? dx : -dy) / 2;
+    if (clip_line(bounds, &x1, &y1, &x2, &y2)) {
+        if (width == 1)
+            draw_line(surf, x1, y1, x2, y2, color, drawn_area);
+        else {
+            if (xinc) {
+                left_top = x1 - (width - 1) / 2;
+                right_bottom = x1 + width / 2;
+            }
+            else {
+                left_top = y1 - (width - 1) / 2;
+                right_bottom = y1 + width / 2;
+            }
+            while ((sign(x1 - x2, sx) != sx) || (sign(y1 - y2, sy) != sy)) {
+                if (xinc)
+                    drawhorzlineclipbounding(surf, color, left_top, y1,
+                                             right_bottom, drawn_area);
+                else {
+                    for (y = left_top; y <= right_bottom; y++)
+                        set_and_check_rect(surf, x1, y, color, drawn_area);
+                }
+                e2 = err;
+                if (e2 > -dx) {
+                    err -= dy;
+                    x1 += sx;
+                    if (xinc) {
+                        left_top += sx;
+                        right_bottom += sx;
+                    }
+                }
+                if (e2 < dy) {
+                    err += dx;
+                    y1 += sy;
+                    if (!xinc) {
+                        left_top += sy;
+                        right_bottom += sy;
+                    }
+                }
+            }
+            if (xinc) {
+                while (y1 != end_y &&
+                       (inside_clip(bounds, left_top, y1) ||
+                        inside_clip(bounds, right_bottom, y1))) {
+                    drawhorzlineclipbounding(surf, color, left_top, y1,
+                                             right_bottom, drawn_area);
+                    e2 = err;
+                    if (e2 > -dx) {
+                        err -= dy;
+                        x1 += sx;
+                        left_top += sx;
+                        right_bottom += sx;
+                    }
+                    if (e2 < dy) {
+                        err += dx;
+                        y1 += sy;
+                    }
+                }
+                drawhorzlineclipbounding(surf, color, left_top, y1,
+                                         right_bottom, drawn_area);
+            }
+            else {
+                while (x1 != end_x &&
+                       (inside_clip(bounds, x1, left_top) ||
+                        inside_clip(bounds, x1, right_bottom))) {
+                    for (y = left_top; y <= right_bottom; y++)
+                        set_and_check_rect(surf, x1, y, color, drawn_area);
+                    e2 = err;
+                    if (e2 > -dx) {
+                        err -= dy;
+                        x1 += sx;
+                    }
+                    if (e2 < dy) {
+                        err += dx;
+                        y1 += sy;
+                        left_top += sy;
+                        right_bottom += sy;
+                    }
+                }
+                for (y = left_top; y <= right_bottom; y++)
+                    set_and_check_rect(surf, x1, y, color, drawn_area);
+            }
+        }
+    }
+}
+
+/* Algorithm modified from
+ * https://rosettacode.org/wiki/Bitmap/Bresenham%27s_line_algorithm
+ */
+static void
+draw_line(SDL_Surface *surf, int x1, int y1, int x2, int y2, Uint32 color,
+          int *drawn_area)
+{
+    int dx, dy, err, e2, sx, sy;
+    if (x1 == x2 && y1 == y2) { /* Single point */
+        set_and_check_rect(surf, x1, y1, color, drawn_area);
+        return;
+    }
+    if (y1 == y2) { /* Horizontal line */
+        dx = (x1 < x2) ? 1 : -1;
+        for (sx = 0; sx <= abs(x1 - x2); sx++) {
+            set_and_check_rect(surf, x1 + dx * sx, y1, color, drawn_area);
+        }
+
+        return;
+    }
+    if (x1 == x2) { /* Vertical line */
+        dy = (y1 < y2) ? 1 : -1;
+        for (sy = 0; sy <= abs(y1 - y2); sy++)
+            set_and_check_rect(surf, x1, y1 + dy * sy, color, drawn_area);
+        return;
+    }
+    dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+    dy = abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+    err = (dx > dy ? dx : -dy) / 2;
+    while (x1 != x2 || y1 != y2) {
+        set_and_check_rect(surf, x1, y1, color, drawn_area);
+        e2 = err;
+        if (e2 > -dx) {
+            err -= dy;
+            x1 += sx;
+        }
+        if (e2 < dy) {
+            err += dx;
+            y1 += sy;
+        }
+    }
+    set_and_check_rect(surf, x2, y2, color, drawn_area);
+}
+
+/* Bresenham's line from (x1, y1) to (x2, y2), stepping exactly as draw_line()
+ * does. PUT_PIXEL stores the color at the Uint8 *pixel of each point inside
+ * the clip rect. The first and last points drawn are kept in first_x/y and
+ * last_x/y, which bound all of the points drawn as the line is monotone.
+ */
+#define DRAW_LINE_PIXELS(bpp, PUT_PIXEL)                                    \
+    do {                                                                    \
+        int dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;                       \
+        int dy = abs(y2 - y1), sy = y1 < y2 ? 1 : -1;                       \
+        int err = (dx > dy ? dx : -dy) / 2, e2;                             \
+        for (;;) {                                                          \
+            if (x1 >= clip_left && x1 < clip_right && y1 >= clip_top &&     \
+                y1 < clip_bottom) {                                         \
+                Uint8 *pixel = pixels + y1 * pitch + x1 * (bpp);            \
+                PUT_PIXEL;                                                  \
+                if (!drawn) {                                               \
+                    first_x = x1;                                           \
+                    first_y = y1;                                           \
+                    drawn = 1;                                              \
+                }                                                           \
+                last_x = x1;                                                \
+                last_y = y1;                                                \
+            }                                                               \
+            if (x1 == x2 && y1 == y2) {                                     \
+                break;                                                      \
+            }                                                               \
+            e2 = err;                                                       \
+            if (e2 > -dx) {                                                 \
+                err -= dy;                                                  \
+                x1 += sx;                                                   \
+            }                                                               \
+            if (e2 < dy) {                                                  \
+                err += dx;                                                  \
+                y1 += sy;                                                   \
+            }                                                               \
+        }                                                                   \
+    } while (0)
+
+/* Draws n one pixel wide lines, line i going from (lines[4 * i],
+ * lines[4 * i + 1]) to (lines[4 * i + 2], lines[4 * i + 3]) in colors[i], or
+ * in color when colors is NULL. Draws the same pixels as draw_line_width()
+ * with a width of 1, but picks the pixel format once per line instead of
+ * once per pixel.
+ */
+static void
+draw_lines_thin(SDL_Surface *surf, const int *lines, Py_ssize_t n,
+                Uint32 color, const Uint32 *colors, int *drawn_area)
+{
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    int pitch = surf->pitch;
+    int clip_left = surf->clip_rect.x;
+    int clip_top = surf->clip_rect.y;
+    int clip_right = surf->clip_rect.x + surf->clip_rect.w;
+    int clip_bottom = surf->clip_rect.y + surf->clip_rect.h;
+    int x1, y1, x2, y2, first_x, first_y, last_x, last_y, drawn;
+    Uint32 c;
+    Py_ssize_t i;
+
+    for (i = 0; i < n; i++) {
+        x1 = lines[4 * i];
+        y1 = lines[4 * i + 1];
+        x2 = lines[4 * i + 2];
+        y2 = lines[4 * i + 3];
+        c = colors ? colors[i] : color;
+        first_x = first_y = last_x = last_y = drawn = 0;
+
+        if (!clip_line(&surf->clip_rect, &x1, &y1, &x2, &y2)) {
+            continue;
+        }
+
+        switch (surf->format->BytesPerPixel) {
+            case 1:
+                DRAW_LINE_PIXELS(1, *pixel = (Uint8)c);
+                break;
+            case 2:
+                DRAW_LINE_PIXELS(2, *(Uint16 *)pixel = (Uint16)c);
+                break;
+            case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+                c <<= 8;
+#endif
+                DRAW_LINE_PIXELS(3, memcpy(pixel, &c, 3 * sizeof(Uint8)));
+                break;
+            default: /*case 4*/
+                DRAW_LINE_PIXELS(4, *(Uint32 *)pixel = c);
+                break;
+        }
+
+        if (drawn) {
+            add_pixel_to_drawn_list(first_x, first_y, drawn_area);
+            add_pixel_to_drawn_list(last_x, last_y, drawn_area);
+        }
+    }
+}
+
+#undef DRAW_LINE_PIXELS
+
+/* Fills rect, which must lie inside the surface. */
+static void
+draw_filled_rect(SDL_Surface *surf, const SDL_Rect *rect, Uint32 color)
+{
+    int bpp = surf->format->BytesPerPixel;
+    Uint8 *row =
+        (Uint8 *)surf->pixels + rect->y * surf->pitch + rect->x * bpp;
+    int y;
+
+    for (y = 0; y < rect->h; y++, row += surf->pitch) {
+        fill_span(row, rect->w, color, bpp);
+    }
+}
+
+static void
+draw_arc(SDL_Surface *surf, int x, int y, int radius1, int radius2,
+         double angle_start, double angle_stop, Uint32 color, int *drawn_area)
+{
+    double aStep;  // Angle Step (rad)
+    double a;      // Current Angle (rad)
+    int x_last, x_next, y_last, y_next;
+
+    // Angle step in rad
+    if (radius1 < radius2) {
+        if (radius1 < 1.0e-4) {
+            aStep = 1.0;
+        }
+        else {
+            aStep = asin(2.0 / radius1);
+        }
+    }
+    else {
+        if (radius2 < 1.0e-4) {
+            aStep = 1.0;
+        }
+        else {
+            aStep = asin(2.0 / radius2);
+        }
+    }
+
+    if (aStep < 0.05) {
+        aStep = 0.05;
+    }
+
+    x_last = (int)(x + cos(angle_start) * radius1);
+    y_last = (int)(y - sin(angle_start) * radius2);
+    for (a = angle_start + aStep; a < aStep + angle_stop; a += aStep) {
+        int points[4];
+        x_next = (int)(x + cos(MIN(a, angle_stop)) * radius1);
+        y_next = (int)(y - sin(MIN(a, angle_stop)) * radius2);
+        points[0] = x_last;
+        points[1] = y_last;
+        points[2] = x_next;
+        points[3] = y_next;
+        draw_line(surf, points[0], points[1], points[2], points[3], color,
+                  drawn_area);
+        x_last = x_next;
+        y_last = y_next;
+    }
+}
+
+/* Bresenham Circle Algorithm
+ * adapted from: https://de.wikipedia.org/wiki/Bresenham-Algorithmus
+ * with additional line width parameter
+ */
+static void
+draw_circle_bresenham(SDL_Surface *surf, int x0, int y0, int radius,
+                      int thickness, Uint32 color, int *drawn_area)
+{
+    int f = 1 - radius;
+    int ddF_x = 0;
+    int ddF_y = -2 * radius;
+    int x = 0;
+    int y = radius;
+    int y1;
+    int i_y = radius - thickness;
+    int thickness_inner = thickness;
+    int i_f = 1 - i_y;
+    int i_ddF_x = 0;
+    int i_ddF_y = -2 * i_y;
+    int i;
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        /* inner circle*/
+        if (i_f >= 0) {
+            i_y--;
+            i_ddF_y += 2;
+            i_f += i_ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x + 1;
+
+        /* inner circle*/
+        i_ddF_x += 2;
+        i_f += i_ddF_x + 1;
+
+        if (x > i_y) {
+            /* Distance between outer circle and 45-degree angle */
+            /* plus one pixel so there's no gap */
+            thickness_inner = y - x + 1;
+        }
+        else {
+            /* Distance between outer and inner circle */
+            thickness_inner = y - i_y;
+        }
+
+        /* Numbers represent parts of circle function draw in radians
+           interval: [number - 1 * pi / 4, number * pi / 4] */
+        for (i = 0; i < thickness_inner; i++) {
+            y1 = y - i;
+            set_and_check_rect(surf, x0 + x - 1, y0 + y1 - 1, color,
+                               drawn_area); /* 7 */
+            set_and_check_rect(surf, x0 - x, y0 + y1 - 1, color,
+                               drawn_area); /* 6 */
+            set_and_check_rect(surf, x0 + x - 1, y0 - y1, color,
+                               drawn_area); /* 2 */
+            set_and_check_rect(surf, x0 - x, y0 - y1, color,
+                               drawn_area); /* 3 */
+            set_and_check_rect(surf, x0 + y1 - 1, y0 + x - 1, color,
+                               drawn_area); /* 8 */
+            set_and_check_rect(surf, x0 + y1 - 1, y0 - x, color,
+                               drawn_area); /* 1 */
+            set_and_check_rect(surf, x0 - y1, y0 + x - 1, color,
+                               drawn_area); /* 5 */
+            set_and_check_rect(surf, x0 - y1, y0 - x, color,
+                               drawn_area); /* 4 */
+        }
+    }
+}
+
+static void
+draw_circle_bresenham_thin(SDL_Surface *surf, int x0, int y0, int radius,
+                           Uint32 color, int *drawn_area)
+{
+    int f = 1 - radius;
+    int ddF_x = 0;
+    int ddF_y = -2 * radius;
+    int x = 0;
+    int y = radius;
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x + 1;
+
+        set_and_check_rect(surf, x0 + x - 1, y0 + y - 1, color,
+                           drawn_area); /* 7 */
+        set_and_check_rect(surf, x0 - x, y0 + y - 1, color,
+                           drawn_area); /* 6 */
+        set_and_check_rect(surf, x0 + x - 1, y0 - y, color,
+                           drawn_area);                              /* 2 */
+        set_and_check_rect(surf, x0 - x, y0 - y, color, drawn_area); /* 3 */
+        set_and_check_rect(surf, x0 + y - 1, y0 + x - 1, color,
+                           drawn_area); /* 8 */
+        set_and_check_rect(surf, x0 + y - 1, y0 - x, color,
+                           drawn_area); /* 1 */
+        set_and_check_rect(surf, x0 - y, y0 + x - 1, color,
+                           drawn_area);                              /* 5 */
+        set_and_check_rect(surf, x0 - y, y0 - x, color, drawn_area); /* 4 */
+    }
+}
+
+static void
+draw_circle_quadrant(SDL_Surface *surf, int x0, int y0, int radius,
+                     int thickness, Uint32 color, int top_right, int top_left,
+                     int bottom_left, int bottom_right, int *drawn_area)
+{
+    int f = 1 - radius;
+    int ddF_x = 0;
+    int ddF_y = -2 * radius;
+    int x = 0;
+    int y = radius;
+    int y1;
+    int i_y = radius - thickness;
+    int i_f = 1 - i_y;
+    int i_ddF_x = 0;
+    int i_ddF_y = -2 * i_y;
+    int i;
+    if (radius == 1) {
+        if (top_right > 0)
+            set_and_check_rect(surf, x0, y0 - 1, color, drawn_area);
+        if (top_left > 0)
+            set_and_check_rect(surf, x0 - 1, y0 - 1, color, drawn_area);
+        if (bottom_left > 0)
+            set_and_check_rect(surf, x0 - 1, y0, color, drawn_area);
+        if (bottom_right > 0)
+            set_and_check_rect(surf, x0, y0, color, drawn_area);
+        return;
+    }
+
+    if (thickness != 0) {
+        while (x < y) {
+            if (f >= 0) {
+                y--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            if (i_f >= 0) {
+                i_y--;
+                i_ddF_y += 2;
+                i_f += i_ddF_y;
+            }
+            x++;
+            ddF_x += 2;
+            f += ddF_x + 1;
+
+            i_ddF_x += 2;
+            i_f += i_ddF_x + 1;
+
+            if (thickness > 1)
+                thickness = y - i_y;
+
+            /* Numbers represent parts of circle function draw in radians
+            interval: [number - 1 * pi / 4, number * pi / 4] */
+            if (top_right > 0) {
+                for (i = 0; i < thickness; i++) {
+                    y1 = y - i;
+                    if ((y0 - y1) < (y0 - x))
+                        set_and_check_rect(surf, x0 + x - 1, y0 - y1, color,
+                                           drawn_area); /* 2 */
+                    if ((x0 + y1 - 1) >= (x0 + x - 1))
+                        set_and_check_rect(surf, x0 + y1 - 1, y0 - x, color,
+                                           drawn_area); /* 1 */
+                }
+            }
+            if (top_left > 0) {
+                for (i = 0; i < thickness; i++) {
+                    y1 = y - i;
+                    if ((y0 - y1) <= (y0 - x))
+                        set_and_check_rect(surf, x0 - x, y0 - y1, color,
+                                           drawn_area); /* 3 */
+                    if ((x0 - y1) < (x0 - x))
+                        set_and_check_rect(surf, x0 - y1, y0 - x, color,
+                                           drawn_area); /* 4 */
+                }
+            }
+            if (bottom_left > 0) {
+                for (i = 0; i < thickness; i++) {
+                    y1 = y - i;
+                    if ((x0 - y1) <= (x0 - x))
+                        set_and_check_rect(surf, x0 - y1, y0 + x - 1, color,
+                                           drawn_area); /* 5 */
+                    if ((y0 + y1 - 1) > (y0 + x - 1))
+                        set_and_check_rect(surf, x0 - x, y0 + y1 - 1, color,
+                                           drawn_area); /* 6 */
+                }
+            }
+            if (bottom_right > 0) {
+                for (i = 0; i < thickness; i++) {
+                    y1 = y - i;
+                    if ((y0 + y1 - 1) >= (y0 + x - 1))
+                        set_and_check_rect(surf, x0 + x - 1, y0 + y1 - 1,
+                                           color, drawn_area); /* 7 */
+                    if ((x0 + y1 - 1) > (x0 + x - 1))
+                        set_and_check_rect(surf, x0 + y1 - 1, y0 + x - 1,
+                                           color, drawn_area); /* 8 */
+                }
+            }
+        }
+    }
+    else {
+        while (x < y) {
+            if (f >= 0) {
+                y--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            x++;
+            ddF_x += 2;
+            f += ddF_x + 1;
+            if (top_right > 0) {
+                for (y1 = y0 - x; y1 <= y0; y1++) {
+                    set_and_check_rect(surf, x0 + y - 1, y1, color,
+                                       drawn_area); /* 1 */
+                }
+                for (y1 = y0 - y; y1 <= y0; y1++) {
+                    set_and_check_rect(surf, x0 + x - 1, y1, color,
+                                       drawn_area); /* 2 */
+                }
+            }
+            if (top_left > 0) {
+                for (y1 = y0 - x; y1 <= y0; y1++) {
+                    set_and_check_rect(surf, x0 - y, y1, color,
+                                       drawn_area); /* 4 */
+                }
+                for (y1 = y0 - y; y1 <= y0; y1++) {
+                    set_and_check_rect(surf, x0 - x, y1, color,
+                                       drawn_area); /* 3 */
+                }
+            }
+            if (bottom_left > 0) {
+                for (y1 = y0; y1 < y0 + x; y1++) {
+                    set_and_check_rect(surf, x0 - y, y1, color,
+                                       drawn_area); /* 4 */
+                }
+                for (y1 = y0; y1 < y0 + y; y1++) {
+                    set_and_check_rect(surf, x0 - x, y1, color,
+                                       drawn_area); /* 3 */
+                }
+            }
+            if (bottom_right > 0) {
+                for (y1 = y0; y1 < y0 + x; y1++) {
+                    set_and_check_rect(surf, x0 + y - 1, y1, color,
+                                       drawn_area); /* 1 */
+                }
+                for (y1 = y0; y1 < y0 + y; y1++) {
+                    set_and_check_rect(surf, x0 + x - 1, y1, color,
+                                       drawn_area); /* 2 */
+                }
+            }
+        }
+    }
+}
+
+/* Clips the rows *top to *bottom of a shape spanning the columns left to
+ * right to the clip area, and returns the number of bands to draw them in.
+ * Returns 1 when the shape should be drawn by the calling thread, and 0
+ * when it is clipped away.
+ */
+static int
+draw_band_count(SDL_Surface *surf, int *top, int *bottom, int left, int right)
+{
+    SDL_Rect *clip = &surf->clip_rect;
+    Sint64 area;
+    int rows, cpus;
+
+    *top = MAX(*top, clip->y);
+    *bottom = MIN(*bottom, clip->y + clip->h - 1);
+    left = MAX(left, clip->x);
+    right = MIN(right, clip->x + clip->w - 1);
+
+    if (*bottom < *top || right < left) {
+        return 0;
+    }
+
+    rows = *bottom - *top + 1;
+    area = (Sint64)rows * (right - left + 1);
+    if (area < DRAW_PARALLEL_MIN_PIXELS) {
+        return 1;
+    }
+
+    cpus = MIN(SDL_GetCPUCount(), PG_PARALLEL_MAX_THREADS);
+    return (int)MIN(MIN(area / DRAW_BAND_MIN_PIXELS, rows), cpus);
+}
+
+/* Returns the first row of the given band, counted from the top row. */
+static int
+draw_band_start(int rows, int band, int bands)
+{
+    return (int)((Sint64)rows * band / bands);
+}
+
+/* Adds the bounds drawn by each band to drawn_area. */
+static void
+draw_merge_bands(int (*band_areas)[4], int bands, int *drawn_area)
+{
+    int band;
+
+    for (band = 0; band < bands; band++) {
+        if (band_areas[band][0] != INT_MAX) {
+            add_pixel_to_drawn_list(band_areas[band][0], band_areas[band][1],
+                                    drawn_area);
+            add_pixel_to_drawn_list(band_areas[band][2], band_areas[band][3],
+                                    drawn_area);
+        }
+    }
+}
+
+/* The rows of a filled shape with at most one span on each row, such as a
+ * circle or an ellipse. Small shapes are drawn span by span as they are
+ * added. For large ones the widest span of each row is kept, and the rows
+ * are drawn in parallel bands by draw_spans_finish().
+ *
+ * Keeping the widest span draws the same pixels and bounds as drawing all
+ * of them, as the spans on a row are nested around the shape's center.
+ */
+typedef struct {
+    SDL_Surface *surf;
+    Uint32 color;
+    int top, bottom; /* the rows kept, the others are clipped away */
+    int bands;
+    int *x1, *x2; /* the span on each row, x1 > x2 when there is none */
+    int band_areas[PG_PARALLEL_MAX_THREADS][4];
+} draw_spans;
+
+static void
+draw_spans_start(draw_spans *spans, SDL_Surface *surf, Uint32 color,
+                 int top, int bottom, int left, int right)
+{
+    int i, rows;
+
+    spans->surf = surf;
+    spans->color = color;
+    spans->top = top;
+    spans->bottom = bottom;
+    spans->x1 = spans->x2 = NULL;
+    spans->bands =
+        draw_band_count(surf, &spans->top, &spans->bottom, left, right);
+
+    if (spans->bands < 2) {
+        return;
+    }
+
+    rows = spans->bottom - spans->top + 1;
+    spans->x1 = PyMem_New(int, 2 * (size_t)rows);
+    if (!spans->x1) {
+        return; /* Draw span by span instead. */
+    }
+
+    spans->x2 = spans->x1 + rows;
+    for (i = 0; i < rows; i++) {
+        spans->x1[i] = INT_MAX;
+        spans->x2[i] = INT_MIN;
+    }
+}
+
+static void
+draw_spans_add(draw_spans *spans, int x1, int y, int x2, int *drawn_area)
+{
+    if (!spans->x1) {
+        drawhorzlineclipbounding(spans->surf, spans->color, x1, y, x2,
+                                 drawn_area);
+        return;
+    }
+
+    if (y < spans->top || y > spans->bottom) {
+        return;
+    }
+
+    y -= spans->top;
+    spans->x1[y] = MIN(spans->x1[y], MIN(x1, x2));
+    spans->x2[y] = MAX(spans->x2[y], MAX(x1, x2));
+}
+
+static void
+draw_spans_bands(void *data, int start, int end)
+{
+    draw_spans *spans = (draw_spans *)data;
+    int rows = spans->bottom - spans->top + 1;
+    int band, y, y_end;
+
+    for (band = start; band < end; band++) {
+        int *band_area = spans->band_areas[band];
+
+        band_area[0] = band_area[1] = INT_MAX;
+        band_area[2] = band_area[3] = INT_MIN;
+
+        y_end = draw_band_start(rows, band + 1, spans->bands);
+        for (y = draw_band_start(rows, band, spans->bands); y < y_end; y++) {
+            if (spans->x1[y] <= spans->x2[y]) {
+                drawhorzlineclipbounding(spans->surf, spans->color,
+                                         spans->x1[y], spans->top + y,
+                                         spans->x2[y], band_area);
+            }
+        }
+    }
+}
+
+/* Draws the kept spans, if any. Must be called with the GIL held. */
+static void
+draw_spans_finish(draw_spans *spans, int *drawn_area)
+{
+    if (!spans->x1) {
+        return;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    pg_parallel_for(spans->bands, 1, draw_spans_bands, spans);
+    Py_END_ALLOW_THREADS;
+
+    draw_merge_bands(spans->band_areas, spans->bands, drawn_area);
+    PyMem_Free(spans->x1);
+}
+
+static void
+draw_circle_filled(SDL_Surface *surf, int x0, int y0, int radius, Uint32 color,
+                   int *drawn_area)
+{
+    int f = 1 - radius;
+    int ddF_x = 0;
+    int ddF_y = -2 * radius;
+    int x = 0;
+    int y = radius;
+    draw_spans spans;
+
+    draw_spans_start(&spans, surf, color, y0 - radius, y0 + radius - 1,
+                     x0 - radius, x0 + radius - 1);
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x + 1;
+
+        /* optimisation to avoid overdrawing and repeated return rect checks:
+           only draw a line if y-step is about to be decreased. */
+        if (f >= 0) {
+            draw_spans_add(&spans, x0 - x, y0 + y - 1, x0 + x - 1,
+                           drawn_area);
+            draw_spans_add(&spans, x0 - x, y0 - y, x0 + x - 1, drawn_area);
+        }
+        draw_spans_add(&spans, x0 - y, y0 + x - 1, x0 + y - 1, drawn_area);
+        draw_spans_add(&spans, x0 - y, y0 - x, x0 + y - 1, drawn_area);
+    }
+
+    draw_spans_finish(&spans, drawn_area);
+}
+
+static void
+draw_ellipse_filled(SDL_Surface *surf, int x0, int y0, int width, int height,
+                    Uint32 color, int *drawn_area)
+{
+    long long dx, dy, x, y;
+    int x_offset, y_offset;
+    double d1, d2;
+    draw_spans spans;
+    if (width == 1) {
+        draw_line(surf, x0, y0, x0, y0 + height - 1, color, drawn_area);
+        return;
+    }
+    if (height == 1) {
+        drawhorzlineclipbounding(surf, color, x0, y0, x0 + width - 1,
+                                 drawn_area);
+        return;
+    }
+    x0 = x0 + width / 2;
+    y0 = y0 + height / 2;
+    x_offset = (width + 1) % 2;
+    y_offset = (height + 1) % 2;
+    width = width / 2;
+    height = height / 2;
+    draw_spans_start(&spans, surf, color, y0 - height, y0 + height - y_offset,
+                     x0 - width, x0 + width - x_offset);
+    x = 0;
+    y = height;
+    d1 = (height * height) - (width * width * height) + (0.25 * width * width);
+    dx = 2 * height * height * x;
+    dy = 2 * width * width * y;
+    while (dx < dy) {
+        draw_spans_add(&spans, x0 - (int)x, y0 - (int)y,
+                       x0 + (int)x - x_offset, drawn_area);
+        draw_spans_add(&spans, x0 - (int)x, y0 + (int)y - y_offset,
+                       x0 + (int)x - x_offset, drawn_area);
+        if (d1 < 0) {
+            x++;
+            dx = dx + (2 * height * height);
+            d1 = d1 + dx + (height * height);
+        }
+        else {
+            x++;
+            y--;
+            dx = dx + (2 * height * height);
+            dy = dy - (2 * width * width);
+            d1 = d1 + dx - dy + (height * height);
+        }
+    }
+    d2 = (((double)height * height) * ((x + 0.5) * (x + 0.5))) +
+         (((double)width * width) * ((y - 1) * (y - 1))) -
+         ((double)width * width * height * height);
+    while (y >= 0) {
+        draw_spans_add(&spans, x0 - (int)x, y0 - (int)y,
+                       x0 + (int)x - x_offset, drawn_area);
+        draw_spans_add(&spans, x0 - (int)x, y0 + (int)y - y_offset,
+                       x0 + (int)x - x_offset, drawn_area);
+        if (d2 > 0) {
+            y--;
+            dy = dy - (2 * width * width);
+            d2 = d2 + (width * width) - dy;
+        }
+        else {
+            y--;
+            x++;
+            dx = dx + (2 * height * height);
+            dy = dy - (2 * width * width);
+            d2 = d2 + dx - dy + (width * width);
+        }
+    }
+
+    draw_spans_finish(&spans, drawn_area);
+}
+
+static void
+draw_ellipse_thickness(SDL_Surface *surf, int x0, int y0, int width,
+                       int height, int thickness, Uint32 color,
+                       int *drawn_area)
+{
+    long long dx, dy, dx_inner, dy_inner, x, y, x_inner, y_inner;
+    int line, x_offset, y_offset;
+    double d1, d2, d1_inner, d2_inner = 0;
+    x0 = x0 + width / 2;
+    y0 = y0 + height / 2;
+    x_offset = (width + 1) % 2;
+    y_offset = (height + 1) % 2;
+    width = width / 2;
+    height = height / 2;
+    line = 1;
+    x = 0;
+    y = height;
+    x_inner = 0;
+    y_inner = height - thickness;
+    d1 = (height * height) - (width * width * height) + (0.25 * width * width);
+    d1_inner =
+        ((height - thickness) * (height - thickness)) -
+        ((width - thickness) * (width - thickness) * (height - thickness)) +
+        (0.25 * (width - thickness) * (width - thickness));
+    dx = 2 * height * height * x;
+    dy = 2 * width * width * y;
+    dx_inner = 2 * (height - thickness) * (height - thickness) * x_inner;
+    dy_inner = 2 * (width - thickness) * (width - thickness) * y_inner;
+    while (dx < dy) {
+        if (line) {
+            drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
+                                     x0 + (int)x - x_offset, drawn_area);
+            drawhorzlineclipbounding(surf, color, x0 - (int)x,
+                                     y0 + (int)y - y_offset,
+                                     x0 + (int)x - x_offset, drawn_area);
+        }
+        else {
+            drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
+                                     x0 - (int)x_inner, drawn_area);
+            drawhorzlineclipbounding(surf, color, x0 - (int)x,
+                                     y0 + (int)y - y_offset, x0 - (int)x_inner,
+                                     drawn_area);
+            drawhorzlineclipbounding(surf, color, x0 + (int)x - x_offset,
+                                     y0 - (int)y, x0 + (int)x_inner - x_offset,
+                                     drawn_area);
+            drawhorzlineclipbounding(surf, color, x0 + (int)x - x_offset,
+                                     y0 + (int)y - y_offset,
+                                     x0 + (int)x_inner - x_offset, drawn_area);
+        }
+        if (d1 < 0) {
+            x++;
+            dx = dx + (2 * height * height);
+            d1 = d1 + dx + (height * height);
+        }
+        else {
+            x++;
+            y--;
+            dx = dx + (2 * height * height);
+            dy = dy - (2 * width * width);
+            d1 = d1 + dx - dy + (height * height);
+            if (line && y < height - thickness) {
+                line = 0;
+            }
+            if (!line) {
+                if (dx_inner < dy_inner) {
+                    while (d1_inner < 0) {
+                        x_inner++;
+                        dx_inner = dx_inner + (2 * (height - thickness) *
+                                               (height - thickness));
+                        d1_inner =
+                            d1_inner + dx_inner +
+                            ((height - thickness) * (height - thickness));
+                    }
+                    x_inner++;
+                    y_inner--;
+                    dx_inner = dx_inner + (2 * (height - thickness) *
+                                           (height - thickness));
+                    dy_inner = dy_inner -
+                               (2 * (width - thickness) * (width - thickness));
+                    d1_inner = d1_inner + dx_inner - dy_inner +
+                               ((height - thickness) * (height - thickness));
+                }
+            }
+        }
+    }
+    d2 = (((double)height * height) * ((x + 0.5) * (x + 0.5))) +
+         (((double)width * width) * ((y - 1) * (y - 1))) -
+         ((double)width * width * height * height);
+    while (y >= 0) {
+        if (line) {
+            drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
+                                     x0 + (int)x - x_offset, drawn_area);
+            drawhorzlineclipbounding(surf, color, x0 - (int)x,
+                                     y0 + (int)y - y_offset,
+                                     x0 + (int)x - x_offset, drawn_area);
+        }
+        else {
+            drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
+                                     x0 - (int)x_inner, drawn_area);
+            drawhorzlineclipbounding(surf, color, x0 - (int)x,
+                                     y0 + (int)y - y_offset, x0 - (int)x_inner,
+                                     drawn_area);
+            drawhorzlineclipbounding(surf, color, x0 + (int)x - x_offset,
+                                     y0 - (int)y, x0 + (int)x_inner - x_offset,
+                                     drawn_area);
+            drawhorzlineclipbounding(surf, color, x0 + (int)x - x_offset,
+                                     y0 + (int)y - y_offset,
+                                     x0 + (int)x_inner - x_offset, drawn_area);
+        }
+        if (d2 > 0) {
             y--;
-            ddF_y += 2;
-            f += ddF_y;
+            dy = dy - (2 * width * width);
+            d2 = d2 + (width * width) - dy;
+        }
+        else {
+            y--;
+            x++;
+            dx = dx + (2 * height * height);
+            dy = dy - (2 * width * width);
+            d2 = d2 + dx - dy + (width * width);
+        }
+        if (line && y < height - thickness) {
+            line = 0;
+        }
+        if (!line) {
+            if (dx_inner < dy_inner) {
+                while (d1_inner < 0) {
+                    x_inner++;
+                    dx_inner = dx_inner + (2 * (height - thickness) *
+                                           (height - thickness));
+                    d1_inner = d1_inner + dx_inner +
+                               ((height - thickness) * (height - thickness));
+                }
+                x_inner++;
+                y_inner--;
+                dx_inner = dx_inner +
+                           (2 * (height - thickness) * (height - thickness));
+                dy_inner =
+                    dy_inner - (2 * (width - thickness) * (width - thickness));
+                d1_inner = d1_inner + dx_inner - dy_inner +
+                           ((height - thickness) * (height - thickness));
+            }
+            else if (y_inner >= 0) {
+                if (d2_inner == 0) {
+                    d2_inner =
+                        ((((double)height - thickness) *
+                          (height - thickness)) *
+                         ((x_inner + 0.5) * (x_inner + 0.5))) +
+                        ((((double)width - thickness) * (width - thickness)) *
+                         ((y_inner - 1) * (y_inner - 1))) -
+                        (((double)width - thickness) * (width - thickness) *
+                         (height - thickness) * (height - thickness));
+                }
+                if (d2_inner > 0) {
+                    y_inner--;
+                    dy_inner = dy_inner -
+                               (2 * (width - thickness) * (width - thickness));
+                    d2_inner = d2_inner +
+                               ((width - thickness) * (width - thickness)) -
+                               dy_inner;
+                }
+                else {
+                    y_inner--;
+                    x_inner++;
+                    dx_inner = dx_inner + (2 * (height - thickness) *
+                                           (height - thickness));
+                    dy_inner = dy_inner -
+                               (2 * (width - thickness) * (width - thickness));
+                    d2_inner = d2_inner + dx_inner - dy_inner +
+                               ((width - thickness) * (width - thickness));
+                }
+            }
+        }
+    }
+}
+
+/* Builds the edge table of a polygon: its non horizontal edges, pointing
+ * down and sorted by their top end. edges must have room for num_points
+ * edges.
+ *
+ * Returns the number of edges.
+ */
+static Py_ssize_t
+draw_fillpoly_edges(const int *point_x, const int *point_y,
+                    Py_ssize_t num_points, poly_edge *edges)
+{
+    Py_ssize_t i;
+    Py_ssize_t i_previous; // i_previous is the index of the point before i
+    Py_ssize_t n_edges = 0;
+
+    for (i = 0; (i < num_points); i++) {
+        i_previous = ((i) ? (i - 1) : (num_points - 1));
+
+        if (point_y[i_previous] < point_y[i]) {
+            edges[n_edges].x1 = point_x[i_previous];
+            edges[n_edges].y1 = point_y[i_previous];
+            edges[n_edges].x2 = point_x[i];
+            edges[n_edges].y2 = point_y[i];
+            n_edges++;
+        }
+        else if (point_y[i_previous] > point_y[i]) {
+            edges[n_edges].x1 = point_x[i];
+            edges[n_edges].y1 = point_y[i];
+            edges[n_edges].x2 = point_x[i_previous];
+            edges[n_edges].y2 = point_y[i_previous];
+            n_edges++;
+        }
+    }
+    qsort(edges, n_edges, sizeof(poly_edge), compare_edge_y1);
+    return n_edges;
+}
+
+/* A special case not handled by draw_fillpoly_rows():
+ *
+ * For two border points with same height miny < y < maxy,
+ * sometimes the line between them is not colored:
+ * this happens when the line will be a lower border line of the polygon
+ * (eg we are inside the polygon with a smaller y, and outside with a
+ * bigger y),
+ * So we loop for border lines that are horizontal.
+ */
+static void
+draw_fillpoly_borders(SDL_Surface *surf, Uint32 color, const int *point_x,
+                      const int *point_y, Py_ssize_t num_points, int miny,
+                      int maxy, int *drawn_area)
+{
+    Py_ssize_t i;
+    Py_ssize_t i_previous;
+    int y;
+
+    for (i = 0; (i < num_points); i++) {
+        i_previous = ((i) ? (i - 1) : (num_points - 1));
+        y = point_y[i];
+
+        if ((miny < y) && (point_y[i_previous] == y) && (y < maxy)) {
+            drawhorzlineclipbounding(surf, color, point_x[i], y,
+                                     point_x[i_previous], drawn_area);
+        }
+    }
+}
+
+/* Fills the rows ystart to yend of a polygon, given the non horizontal
+ * edges sorted by their top end and the polygon's lowest row, maxy. active
+ * and x_intersect must have room for every edge.
+ *
+ * The algorithm uses a horizontal line (y) that moves from top to the
+ * bottom of the polygon, keeping the list of edges it crosses:
+ *
+ * 1. add the edges starting at y (or above it, on the first line drawn)
+ *    and drop the edges that ended above y (excluding the lower end of each
+ *    edge, except on the lowest line)
+ * 2. find the intersections with these edges, sorting them along with
+ *    the edges (x_intersect); an insertion sort is enough, as the order
+ *    of the edges barely changes from one line to the next
+ * 3. each two x-coordinates in x_intersect are then inside the polygon
+ *    (draw line for a pair of two such points)
+ *
+ * Each line only depends on y, so any range of rows can be drawn on its own.
+ */
+static void
+draw_fillpoly_rows(SDL_Surface *surf, Uint32 color, const poly_edge *edges,
+                   Py_ssize_t n_edges, int maxy, int ystart, int yend,
+                   const poly_edge **active, int *x_intersect,
+                   int *drawn_area)
+{
+    Py_ssize_t i, j, next_edge = 0, n_active = 0;
+    const poly_edge *edge;
+    int y, x;
+
+    for (y = ystart; (y <= yend); y++) {
+        while (next_edge < n_edges && edges[next_edge].y1 <= y) {
+            active[n_active++] = &edges[next_edge++];
+        }
+
+        for (i = 0, j = 0; (i < n_active); i++) {
+            if (active[i]->y2 > y || active[i]->y2 == maxy) {
+                active[j++] = active[i];
+            }
+        }
+        n_active = j;
+
+        for (i = 0; (i < n_active); i++) {
+            edge = active[i];
+            x = (y - edge->y1) * (edge->x2 - edge->x1) /
+                    (edge->y2 - edge->y1) +
+                edge->x1;
+            for (j = i; j > 0 && x_intersect[j - 1] > x; j--) {
+                x_intersect[j] = x_intersect[j - 1];
+                active[j] = active[j - 1];
+            }
+            x_intersect[j] = x;
+            active[j] = edge;
+        }
+
+        for (i = 0; (i + 1 < n_active); i += 2) {
+            drawhorzlineclipbounding(surf, color, x_intersect[i], y,
+                                     x_intersect[i + 1], drawn_area);
+        }
+    }
+}
+
+/* A large polygon being filled in parallel bands of rows. */
+typedef struct {
+    SDL_Surface *surf;
+    Uint32 color;
+    const poly_edge *edges;
+    Py_ssize_t n_edges;
+    int maxy, top, bottom, bands;
+    const poly_edge **active; /* n_edges for each band */
+    int *x_intersect;         /* n_edges for each band */
+    int band_areas[PG_PARALLEL_MAX_THREADS][4];
+} fillpoly_bands;
+
+static void
+draw_fillpoly_bands(void *data, int start, int end)
+{
+    fillpoly_bands *poly = (fillpoly_bands *)data;
+    int rows = poly->bottom - poly->top + 1;
+    int band;
+
+    for (band = start; band < end; band++) {
+        int *band_area = poly->band_areas[band];
+
+        band_area[0] = band_area[1] = INT_MAX;
+        band_area[2] = band_area[3] = INT_MIN;
+
+        draw_fillpoly_rows(
+            poly->surf, poly->color, poly->edges, poly->n_edges, poly->maxy,
+            poly->top + draw_band_start(rows, band, poly->bands),
+            poly->top + draw_band_start(rows, band + 1, poly->bands) - 1,
+            poly->active + band * poly->n_edges,
+            poly->x_intersect + band * poly->n_edges, band_area);
+    }
+}
+
+/* Fills the rows top to bottom of a polygon in bands, one thread each, with
+ * the GIL released. Must be called with the GIL held.
+ *
+ * Returns 0 if out of memory, having drawn nothing.
+ */
+static int
+draw_fillpoly_parallel(SDL_Surface *surf, Uint32 color,
+                       const poly_edge *edges, Py_ssize_t n_edges, int maxy,
+                       int top, int bottom, int bands, int *drawn_area)
+{
+    fillpoly_bands poly;
+
+    poly.active = PyMem_New(const poly_edge *, bands * n_edges);
+    poly.x_intersect = PyMem_New(int, bands * n_edges);
+    if (poly.active == NULL || poly.x_intersect == NULL) {
+        PyMem_Free(poly.active);
+        PyMem_Free(poly.x_intersect);
+        return 0;
+    }
+
+    poly.surf = surf;
+    poly.color = color;
+    poly.edges = edges;
+    poly.n_edges = n_edges;
+    poly.maxy = maxy;
+    poly.top = top;
+    poly.bottom = bottom;
+    poly.bands = bands;
+
+    Py_BEGIN_ALLOW_THREADS;
+    pg_parallel_for(bands, 1, draw_fillpoly_bands, &poly);
+    Py_END_ALLOW_THREADS;
+
+    draw_merge_bands(poly.band_areas, bands, drawn_area);
+    PyMem_Free(poly.active);
+    PyMem_Free(poly.x_intersect);
+    return 1;
+}
+
+static void
+draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
+              Py_ssize_t num_points, Uint32 color, int *drawn_area)
+{
+    /* point_x : x coordinates of the points
+     * point-y : the y coordinates of the points
+     * num_points : the number of points
+     */
+    Py_ssize_t i, n_edges;
+    int miny, maxy, minx, maxx, top, bottom, bands;
+    poly_edge *edges;
+    /* active holds the edges crossing the current horizontal line */
+    const poly_edge **active;
+    /* x_intersect are the x-coordinates of intersections of the polygon
+     * with some horizontal line */
+    int *x_intersect = PyMem_New(int, num_points);
+    edges = PyMem_New(poly_edge, num_points);
+    active = PyMem_New(const poly_edge *, num_points);
+    if (x_intersect == NULL || edges == NULL || active == NULL) {
+        PyMem_Free(x_intersect);
+        PyMem_Free(edges);
+        PyMem_Free(active);
+        PyErr_NoMemory();
+        return;
+    }
+
+    /* Determine X and Y maxima */
+    minx = maxx = point_x[0];
+    miny = maxy = point_y[0];
+    for (i = 1; (i < num_points); i++) {
+        minx = MIN(minx, point_x[i]);
+        maxx = MAX(maxx, point_x[i]);
+        miny = MIN(miny, point_y[i]);
+        maxy = MAX(maxy, point_y[i]);
+    }
+
+    if (miny == maxy) {
+        /* Special case: polygon only 1 pixel high. */
+        drawhorzlineclipbounding(surf, color, minx, miny, maxx, drawn_area);
+        PyMem_Free(x_intersect);
+        PyMem_Free(edges);
+        PyMem_Free(active);
+        return;
+    }
+
+    /* Horizontal edges are handled as a special case, below. */
+    n_edges = draw_fillpoly_edges(point_x, point_y, num_points, edges);
+
+    /* Draw, scanning y. Large polygons are split into bands of the rows
+     * inside the clip area, drawn in parallel. */
+    top = miny;
+    bottom = maxy;
+    bands = draw_band_count(surf, &top, &bottom, minx, maxx);
+    if (bands < 2 ||
+        !draw_fillpoly_parallel(surf, color, edges, n_edges, maxy, top,
+                                bottom, bands, drawn_area)) {
+        draw_fillpoly_rows(surf, color, edges, n_edges, maxy, miny, maxy,
+                           active, x_intersect, drawn_area);
+    }
+
+    draw_fillpoly_borders(surf, color, point_x, point_y, num_points, miny,
+                          maxy, drawn_area);
+    PyMem_Free(x_intersect);
+    PyMem_Free(edges);
+    PyMem_Free(active);
+}
+
+static void
+draw_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int width,
+          Uint32 color)
+{
+    int i;
+    for (i = 0; i < width; i++) {
+        drawhorzlineclip(surf, color, x1, y1 + i, x2);
+        drawhorzlineclip(surf, color, x1, y2 - i, x2);
+    }
+    for (i = 0; i < (y2 - y1) - 2 * width + 1; i++) {
+        drawhorzlineclip(surf, color, x1, y1 + width + i, x1 + width - 1);
+        drawhorzlineclip(surf, color, x2 - width + 1, y1 + width + i, x2);
+    }
+}
+
+static void
+draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
+                int width, Uint32 color, int top_left, int top_right,
+                int bottom_left, int bottom_right, int *drawn_area)
+{
+    int pts[16], i;
+    float q_top, q_left, q_bottom, q_right, f;
+    if (top_left < 0)
+        top_left = radius;
+    if (top_right < 0)
+        top_right = radius;
+    if (bottom_left < 0)
+        bottom_left = radius;
+    if (bottom_right < 0)
+        bottom_right = radius;
+    if ((top_left + top_right) > (x2 - x1 + 1) ||
+        (bottom_left + bottom_right) > (x2 - x1 + 1) ||
+        (top_left + bottom_left) > (y2 - y1 + 1) ||
+        (top_right + bottom_right) > (y2 - y1 + 1)) {
+        q_top = (x2 - x1 + 1) / (float)(top_left + top_right);
+        q_left = (y2 - y1 + 1) / (float)(top_left + bottom_left);
+        q_bottom = (x2 - x1 + 1) / (float)(bottom_left + bottom_right);
+        q_right = (y2 - y1 + 1) / (float)(top_right + bottom_right);
+        f = MIN(MIN(MIN(q_top, q_left), q_bottom), q_right);
+        top_left = (int)(top_left * f);
+        top_right = (int)(top_right * f);
+        bottom_left = (int)(bottom_left * f);
+        bottom_right = (int)(bottom_right * f);
+    }
+    if (width == 0) { /* Filled rect */
+        pts[0] = x1;
+        pts[1] = x1 + top_left;
+        pts[2] = x2 - top_right;
+        pts[3] = x2;
+        pts[4] = x2;
+        pts[5] = x2 - bottom_right;
+        pts[6] = x1 + bottom_left;
+        pts[7] = x1;
+        pts[8] = y1 + top_left;
+        pts[9] = y1;
+        pts[10] = y1;
+        pts[11] = y1 + top_right;
+        pts[12] = y2 - bottom_right;
+        pts[13] = y2;
+        pts[14] = y2;
+        pts[15] = y2 - bottom_left;
+        draw_fillpoly(surf, pts, pts + 8, 8, color, drawn_area);
+        draw_circle_quadrant(surf, x2 - top_right + 1, y1 + top_right,
+                             top_right, 0, color, 1, 0, 0, 0, drawn_area);
+        draw_circle_quadrant(surf, x1 + top_left, y1 + top_left, top_left, 0,
+                             color, 0, 1, 0, 0, drawn_area);
+        draw_circle_quadrant(surf, x1 + bottom_left, y2 - bottom_left + 1,
+                             bottom_left, 0, color, 0, 0, 1, 0, drawn_area);
+        draw_circle_quadrant(surf, x2 - bottom_right + 1,
+                             y2 - bottom_right + 1, bottom_right, 0, color, 0,
+                             0, 0, 1, drawn_area);
+    }
+    else {
+        if (x2 - top_right == x1 + top_left) {
+            for (i = 0; i < width; i++) {
+                set_and_check_rect(
+                    surf, x1 + top_left, y1 + i, color,
+                    drawn_area); /* Fill gap if reduced radius */
+            }
         }
-        x++;
-        ddF_x += 2;
-        f += ddF_x + 1;
-
-        /* optimisation to avoid overdrawing and repeated return rect checks:
-           only draw a line if y-step is about to be decreased. */
-        if (f >= 0) {
-            drawhorzlineclipbounding(surf, color, x0 - x, y0 + y - 1,
-                                     x0 + x - 1, drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 - x, y0 - y, x0 + x - 1,
-                                     drawn_area);
+        else
+            draw_line_width(surf, color, x1 + top_left,
+                            y1 + (int)(width / 2) - 1 + width % 2,
+                            x2 - top_right,
+                            y1 + (int)(width / 2) - 1 + width % 2, width,
+                            drawn_area); /* Top line */
+        if (y2 - bottom_left == y1 + top_left) {
+            for (i = 0; i < width; i++) {
+                set_and_check_rect(
+                    surf, x1 + i, y1 + top_left, color,
+                    drawn_area); /* Fill gap if reduced radius */
+            }
         }
-        drawhorzlineclipbounding(surf, color, x0 - y, y0 + x - 1, x0 + y - 1,
-                                 drawn_area);
-        drawhorzlineclipbounding(surf, color, x0 - y, y0 - x, x0 + y - 1,
-                                 drawn_area);
+        else
+            draw_line_width(
+                surf, color, x1 + (int)(width / 2) - 1 + width % 2,
+                y1 + top_left, x1 + (int)(width / 2) - 1 + width % 2,
+                y2 - bottom_left, width, drawn_area); /* Left line */
+        if (x2 - bottom_right == x1 + bottom_left) {
+            for (i = 0; i < width; i++) {
+                set_and_check_rect(
+                    surf, x1 + bottom_left, y2 - i, color,
+                    drawn_area); /* Fill gap if reduced radius */
+            }
+        }
+        else
+            draw_line_width(surf, color, x1 + bottom_left,
+                            y2 - (int)(width / 2), x2 - bottom_right,
+                            y2 - (int)(width / 2), width,
+                            drawn_area); /* Bottom line */
+        if (y2 - bottom_right == y1 + top_right) {
+            for (i = 0; i < width; i++) {
+                set_and_check_rect(
+                    surf, x2 - i, y1 + top_right, color,
+                    drawn_area); /* Fill gap if reduced radius */
+            }
+        }
+        else
+            draw_line_width(surf, color, x2 - (int)(width / 2), y1 + top_right,
+                            x2 - (int)(width / 2), y2 - bottom_right, width,
+                            drawn_area); /* Right line */
+
+        draw_circle_quadrant(surf, x2 - top_right + 1, y1 + top_right,
+                             top_right, width, color, 1, 0, 0, 0, drawn_area);
+        draw_circle_quadrant(surf, x1 + top_left, y1 + top_left, top_left,
+                             width, color, 0, 1, 0, 0, drawn_area);
+        draw_circle_quadrant(surf, x1 + bottom_left, y2 - bottom_left + 1,
+                             bottom_left, width, color, 0, 0, 1, 0,
+                             drawn_area);
+        draw_circle_quadrant(surf, x2 - bottom_right + 1,
+                             y2 - bottom_right + 1, bottom_right, width, color,
+                             0, 0, 0, 1, drawn_area);
     }
 }
 
+/* Antialiased shapes
+ * ------------------
+ * The antialiased shapes are drawn as outlines of straight edges, which can
+ * be made of several contours. Each edge adds its signed area to the cells
+ * of an accumulation buffer, row by row, and a running sum along each row
+ * then gives the coverage of every pixel (the "accumulation" rasterizer used
+ * by font renderers like font-rs). Overlapping contours of the same
+ * direction add up and are clamped to full coverage, while a contour going
+ * the other way cuts a hole.
+ *
+ * Points are in pixel units with pixel (x, y) covering the square from
+ * (x, y) to (x + 1, y + 1).
+ */
+
+/* Largest distance, in pixels, between a curve and the edges standing in
+ * for it. */
+#define AA_CURVE_TOLERANCE 0.1f
+
 static void
-draw_ellipse_filled(SDL_Surface *surf, int x0, int y0, int width, int height,
-                    Uint32 color, int *drawn_area)
+aa_path_grow(aa_path *path, Py_ssize_t points)
 {
-    long long dx, dy, x, y;
-    int x_offset, y_offset;
-    double d1, d2;
-    if (width == 1) {
-        draw_line(surf, x0, y0, x0, y0 + height - 1, color, drawn_area);
+    float *new_points;
+    Py_ssize_t size;
+
+    if (path->failed || path->len + points <= path->size) {
         return;
     }
-    if (height == 1) {
-        drawhorzlineclipbounding(surf, color, x0, y0, x0 + width - 1,
-                                 drawn_area);
+
+    size = MAX(path->size * 2, path->len + points);
+    size = MAX(size, 64);
+    new_points = PyMem_Resize(path->points, float, 2 * size);
+    if (!new_points) {
+        path->failed = 1;
         return;
     }
-    x0 = x0 + width / 2;
-    y0 = y0 + height / 2;
-    x_offset = (width + 1) % 2;
-    y_offset = (height + 1) % 2;
-    width = width / 2;
-    height = height / 2;
-    x = 0;
-    y = height;
-    d1 = (height * height) - (width * width * height) + (0.25 * width * width);
-    dx = 2 * height * height * x;
-    dy = 2 * width * width * y;
-    while (dx < dy) {
-        drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
-                                 x0 + (int)x - x_offset, drawn_area);
-        drawhorzlineclipbounding(surf, color, x0 - (int)x,
-                                 y0 + (int)y - y_offset,
-                                 x0 + (int)x - x_offset, drawn_area);
-        if (d1 < 0) {
-            x++;
-            dx = dx + (2 * height * height);
-            d1 = d1 + dx + (height * height);
+    path->points = new_points;
+    path->size = size;
+}
+
+static void
+aa_path_add(aa_path *path, float x, float y)
+{
+    aa_path_grow(path, 1);
+    if (path->failed) {
+        return;
+    }
+    path->points[2 * path->len] = x;
+    path->points[2 * path->len + 1] = y;
+    path->len++;
+}
+
+/* Ends the current contour, which is closed by an edge going back to its
+ * first point. */
+static void
+aa_path_close(aa_path *path)
+{
+    Py_ssize_t *new_ends;
+
+    if (path->failed) {
+        return;
+    }
+    if (path->n_contours == path->contours_size) {
+        path->contours_size = MAX(path->contours_size * 2, 8);
+        new_ends =
+            PyMem_Resize(path->ends, Py_ssize_t, path->contours_size);
+        if (!new_ends) {
+            path->failed = 1;
+            return;
+        }
+        path->ends = new_ends;
+    }
+    path->ends[path->n_contours++] = path->len;
+}
+
+static void
+aa_path_free(aa_path *path)
+{
+    PyMem_Free(path->points);
+    PyMem_Free(path->ends);
+}
+
+/* Returns how many edges stand in for an arc of the given radius and
+ * sweep, in radians. */
+static int
+aa_arc_edges(float radius, double sweep)
+{
+    double step;
+
+    if (radius <= AA_CURVE_TOLERANCE) {
+        step = M_PI / 2;
+    }
+    else {
+        step = 2 * acos(1 - AA_CURVE_TOLERANCE / radius);
+    }
+    return MAX(1, (int)MIN(ceil(fabs(sweep) / step), 100000.0));
+}
+
+/* Adds the points of an arc around (cx, cy), from angle to angle + sweep
+ * (in radians, positive going clockwise on the screen), both included. */
+static void
+aa_path_arc(aa_path *path, float cx, float cy, float radius, double angle,
+            double sweep)
+{
+    int i, n = aa_arc_edges(radius, sweep);
+
+    for (i = 0; i <= n; i++) {
+        double a = angle + sweep * i / n;
+        aa_path_add(path, cx + radius * (float)cos(a),
+                    cy + radius * (float)sin(a));
+    }
+}
+
+/* Returns how many edges stand in for a curve whose largest second
+ * difference of control points is dd, scale being 1/4 for quadratic and 3/4
+ * for cubic curves. */
+static int
+aa_curve_edges(float dd, float scale)
+{
+    return MAX(1, (int)MIN(ceil(sqrt(scale * dd / AA_CURVE_TOLERANCE)),
+                           10000.0));
+}
+
+/* Adds the points of a quadratic bezier curve from (x0, y0), excluded, to
+ * (x2, y2), included, with the control point (x1, y1). */
+static void
+aa_path_quad(aa_path *path, float x0, float y0, float x1, float y1, float x2,
+             float y2)
+{
+    float dd = hypotf(x0 - 2 * x1 + x2, y0 - 2 * y1 + y2);
+    int i, n = aa_curve_edges(dd, 0.25f);
+
+    for (i = 1; i < n; i++) {
+        float t = (float)i / n, u = 1 - t;
+        aa_path_add(path, u * u * x0 + 2 * u * t * x1 + t * t * x2,
+                    u * u * y0 + 2 * u * t * y1 + t * t * y2);
+    }
+    aa_path_add(path, x2, y2);
+}
+
+/* Adds the points of a cubic bezier curve from (x0, y0), excluded, to
+ * (x3, y3), included, with the control points (x1, y1) and (x2, y2). */
+static void
+aa_path_cubic(aa_path *path, float x0, float y0, float x1, float y1,
+              float x2, float y2, float x3, float y3)
+{
+    float dd = MAX(hypotf(x0 - 2 * x1 + x2, y0 - 2 * y1 + y2),
+                   hypotf(x1 - 2 * x2 + x3, y1 - 2 * y2 + y3));
+    int i, n = aa_curve_edges(dd, 0.75f);
+
+    for (i = 1; i < n; i++) {
+        float t = (float)i / n, u = 1 - t;
+        aa_path_add(path,
+                    u * u * u * x0 + 3 * u * u * t * x1 +
+                        3 * u * t * t * x2 + t * t * t * x3,
+                    u * u * u * y0 + 3 * u * u * t * y1 +
+                        3 * u * t * t * y2 + t * t * t * y3);
+    }
+    aa_path_add(path, x3, y3);
+}
+
+/* Adds a circle as a contour, going the other way when reverse is set.
+ * The polygon's radius is grown so its area matches the circle's. */
+static void
+aa_path_circle(aa_path *path, float cx, float cy, float radius, int reverse)
+{
+    int i, n = aa_arc_edges(radius, 2 * M_PI);
+
+    n = MAX(n, 8);
+    radius *= (float)sqrt(2 * M_PI / (n * sin(2 * M_PI / n)));
+    for (i = 0; i < n; i++) {
+        double a = 2 * M_PI * (reverse ? n - i : i) / n;
+        aa_path_add(path, cx + radius * (float)cos(a),
+                    cy + radius * (float)sin(a));
+    }
+    aa_path_close(path);
+}
+
+/* Adds the points of one side of a stroke along the n points (n >= 2, no two
+ * consecutive points equal), offset by width / 2 to the right of the
+ * direction of travel. The side is followed round the joins: round on the
+ * outside of a turn, and through the point itself on the inside, which
+ * leaves overlaps inside the stroke that the rasterizer clamps away.
+ *
+ * When closed the join at the first point is added too and the side is a
+ * whole contour, else it is left open at both ends.
+ */
+static void
+aa_path_stroke_side(aa_path *path, const float *xs, const float *ys,
+                    Py_ssize_t n, int closed, float width)
+{
+    float hw = width / 2;
+    Py_ssize_t segments = closed ? n : n - 1;
+    Py_ssize_t i, j, k;
+    double ux, uy, vx, vy, len, cross, dot, turn;
+
+    for (i = 0; i < segments; i++) {
+        j = (i + 1) % n;
+        ux = xs[j] - xs[i];
+        uy = ys[j] - ys[i];
+        len = sqrt(ux * ux + uy * uy);
+        ux /= len;
+        uy /= len;
+
+        /* The offset segment, with the normal (-uy, ux). */
+        aa_path_add(path, xs[i] - hw * (float)uy, ys[i] + hw * (float)ux);
+        aa_path_add(path, xs[j] - hw * (float)uy, ys[j] + hw * (float)ux);
+
+        if (!closed && i == segments - 1) {
+            break;
+        }
+
+        /* The join with the next segment. */
+        k = (j + 1) % n;
+        vx = xs[k] - xs[j];
+        vy = ys[k] - ys[j];
+        len = sqrt(vx * vx + vy * vy);
+        vx /= len;
+        vy /= len;
+        cross = ux * vy - uy * vx;
+        dot = ux * vx + uy * vy;
+        turn = cross == 0 && dot < 0 ? -M_PI : atan2(cross, dot);
+
+        if (turn < 0) {
+            /* Outside of the turn: round join from one normal to the
+             * next. */
+            aa_path_arc(path, xs[j], ys[j], hw, atan2(ux, -uy), turn);
+        }
+        else if (turn > 0) {
+            aa_path_add(path, xs[j], ys[j]);
+        }
+    }
+}
+
+/* Adds the outline of a stroke of the given width along n points, with
+ * round joins, and round caps when it isn't closed. */
+static void
+aa_path_stroke(aa_path *path, const float *xs, const float *ys,
+               Py_ssize_t n, int closed, float width)
+{
+    float *rxs, *rys;
+    Py_ssize_t i, m = 0;
+    double angle;
+
+    /* Drop repeated points, and the closing one, which make no edges. */
+    rxs = PyMem_New(float, 2 * n);
+    if (!rxs) {
+        path->failed = 1;
+        return;
+    }
+    rys = rxs + n;
+    for (i = 0; i < n; i++) {
+        if (!m || xs[i] != rxs[m - 1] || ys[i] != rys[m - 1]) {
+            rxs[m] = xs[i];
+            rys[m] = ys[i];
+            m++;
+        }
+    }
+    if (closed && m > 1 && rxs[0] == rxs[m - 1] && rys[0] == rys[m - 1]) {
+        m--;
+    }
+
+    if (m == 1) {
+        /* A dot. */
+        aa_path_circle(path, rxs[0], rys[0], width / 2, 0);
+    }
+    else if (closed && m > 2) {
+        /* The two sides are separate contours going opposite ways. */
+        aa_path_stroke_side(path, rxs, rys, m, 1, width);
+        aa_path_close(path);
+        for (i = 0; i < m / 2; i++) {
+            float tx = rxs[i], ty = rys[i];
+            rxs[i] = rxs[m - 1 - i];
+            rys[i] = rys[m - 1 - i];
+            rxs[m - 1 - i] = tx;
+            rys[m - 1 - i] = ty;
+        }
+        aa_path_stroke_side(path, rxs, rys, m, 1, width);
+        aa_path_close(path);
+    }
+    else {
+        /* One contour: the right side, the end cap, the left side going
+         * back and the start cap. Two closed points are just a segment. */
+        for (i = 0; i < 2; i++) {
+            aa_path_stroke_side(path, rxs, rys, m, 0, width);
+            angle = atan2(rxs[m - 1] - rxs[m - 2], -(rys[m - 1] - rys[m - 2]));
+            aa_path_arc(path, rxs[m - 1], rys[m - 1], width / 2, angle,
+                        -M_PI);
+            if (!i) {
+                Py_ssize_t a;
+                for (a = 0; a < m / 2; a++) {
+                    float tx = rxs[a], ty = rys[a];
+                    rxs[a] = rxs[m - 1 - a];
+                    rys[a] = rys[m - 1 - a];
+                    rxs[m - 1 - a] = tx;
+                    rys[m - 1 - a] = ty;
+                }
+            }
+        }
+        aa_path_close(path);
+    }
+
+    PyMem_Free(rxs);
+}
+
+/* Adds the signed area of an edge from (x0, y0) to (x1, y1), with
+ * y0 < y1 and 0 <= x0, x1 <= w, to the cells of the rows it crosses. dir is
+ * 1 for an edge going down, -1 going up.
+ */
+static void
+aa_raster_segment(aa_raster *raster, float x0, float y0, float x1, float y1,
+                  float dir)
+{
+    float dxdy = (x1 - x0) / (y1 - y0);
+    float x = x0, xnext, dy, d, xa, xb, xa_floor, xb_ceil, xmf;
+    float s, xa_frac, xb_frac, a0, a1, a2, am;
+    int y, xai, xbi, xi;
+    int yend = MIN(raster->h, (int)ceilf(y1));
+    float *row;
+
+    for (y = (int)y0; y < yend; y++) {
+        row = raster->cells + (size_t)y * (raster->w + 2);
+        dy = MIN((float)(y + 1), y1) - MAX((float)y, y0);
+        xnext = x + dxdy * dy;
+        d = dy * dir;
+        xa = MIN(x, xnext);
+        xb = MAX(x, xnext);
+        xa_floor = floorf(xa);
+        xb_ceil = ceilf(xb);
+        xai = (int)xa_floor;
+        xbi = (int)xb_ceil;
+
+        if (xbi <= xai + 1) {
+            /* Within one cell: split d between it and the next by the
+             * area left of the edge. */
+            xmf = 0.5f * (x + xnext) - xa_floor;
+            row[xai] += d - d * xmf;
+            row[xai + 1] += d * xmf;
         }
         else {
-            x++;
-            y--;
-            dx = dx + (2 * height * height);
-            dy = dy - (2 * width * width);
-            d1 = d1 + dx - dy + (height * height);
+            /* Across several cells: the edge covers a growing part of
+             * each. */
+            s = 1.0f / (xb - xa);
+            xa_frac = xa - xa_floor;
+            a0 = 0.5f * s * (1.0f - xa_frac) * (1.0f - xa_frac);
+            xb_frac = xb - xb_ceil + 1.0f;
+            am = 0.5f * s * xb_frac * xb_frac;
+            row[xai] += d * a0;
+            if (xbi == xai + 2) {
+                row[xai + 1] += d * (1.0f - a0 - am);
+            }
+            else {
+                a1 = s * (1.5f - xa_frac);
+                row[xai + 1] += d * (a1 - a0);
+                for (xi = xai + 2; xi < xbi - 1; xi++) {
+                    row[xi] += d * s;
+                }
+                a2 = a1 + (xbi - xai - 3) * s;
+                row[xbi - 1] += d * (1.0f - a2 - am);
+            }
+            row[xbi] += d * am;
+        }
+        x = xnext;
+    }
+}
+
+/* Adds an edge of a contour, in surface coordinates, to the raster. */
+static void
+aa_raster_line(aa_raster *raster, float x0, float y0, float x1, float y1)
+{
+    float w = (float)raster->w, dir = 1.0f, t, dxdy;
+    float ys[4], xa, xb, ya, yb;
+    int n = 0, i, j;
+
+    x0 -= raster->x;
+    x1 -= raster->x;
+    y0 -= raster->y;
+    y1 -= raster->y;
+
+    if (y0 == y1) {
+        return;
+    }
+    if (y0 > y1) {
+        t = x0, x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+        dir = -1.0f;
+    }
+    if (y1 <= 0 || y0 >= raster->h) {
+        return;
+    }
+
+    /* Rows outside of the raster don't change the ones inside it. */
+    dxdy = (x1 - x0) / (y1 - y0);
+    if (y0 < 0) {
+        x0 -= y0 * dxdy;
+        y0 = 0;
+    }
+    if (y1 > raster->h) {
+        x1 -= (y1 - raster->h) * dxdy;
+        y1 = (float)raster->h;
+    }
+
+    /* Split the edge where it crosses x = 0 and x = w. The parts on the
+     * left cover every cell of the rows they cross, just as if they were
+     * on x = 0, while the parts on the right change no visible cell. */
+    ys[n++] = y0;
+    if ((x0 < 0) != (x1 < 0)) {
+        ys[n++] = y0 + (0 - x0) / (x1 - x0) * (y1 - y0);
+    }
+    if ((x0 < w) != (x1 < w)) {
+        ys[n++] = y0 + (w - x0) / (x1 - x0) * (y1 - y0);
+    }
+    ys[n++] = y1;
+    for (i = 1; i < n; i++) {
+        for (j = i; j > 0 && ys[j - 1] > ys[j]; j--) {
+            t = ys[j], ys[j] = ys[j - 1], ys[j - 1] = t;
+        }
+    }
+
+    for (i = 0; i + 1 < n; i++) {
+        ya = MAX(ys[i], y0);
+        yb = MIN(ys[i + 1], y1);
+        if (yb <= ya) {
+            continue;
         }
+        xa = x0 + (ya - y0) * dxdy;
+        xb = x0 + (yb - y0) * dxdy;
+        if (xa + xb >= 2 * w) {
+            continue;
+        }
+        if (xa + xb <= 0) {
+            xa = xb = 0;
+        }
+        xa = MIN(MAX(xa, 0), w);
+        xb = MIN(MAX(xb, 0), w);
+        aa_raster_segment(raster, xa, ya, xb, yb, dir);
     }
-    d2 = (((double)height * height) * ((x + 0.5) * (x + 0.5))) +
-         (((double)width * width) * ((y - 1) * (y - 1))) -
-         ((double)width * width * height * height);
-    while (y >= 0) {
-        drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
-                                 x0 + (int)x - x_offset, drawn_area);
-        drawhorzlineclipbounding(surf, color, x0 - (int)x,
-                                 y0 + (int)y - y_offset,
-                                 x0 + (int)x - x_offset, drawn_area);
-        if (d2 > 0) {
-            y--;
-            dy = dy - (2 * width * width);
-            d2 = d2 + (width * width) - dy;
+}
+
+/* Sums up a row of raster cells into the coverage, 0 to 255, of its w
+ * pixels. The summed winding is clamped to 1 for the nonzero rule, or
+ * folded into [0, 1] for the even-odd rule. Both paths round half to even,
+ * like _mm_cvtps_epi32() does, so SIMD and scalar builds agree.
+ */
+static void
+aa_raster_coverage(const float *cells, Uint8 *coverage, int w, int even_odd)
+{
+    float acc = 0.0f, a;
+    int x = 0;
+
+#ifdef DRAW_SIMD
+    /* Four prefix sums at a time. */
+    __m128 offset = _mm_setzero_ps();
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 two = _mm_set1_ps(2.0f);
+    __m128 scale = _mm_set1_ps(255.0f);
+    __m128 v;
+    __m128i c;
+    int packed;
+
+    for (; x + 4 <= w; x += 4) {
+        v = _mm_loadu_ps(cells + x);
+        v = _mm_add_ps(v, _mm_castsi128_ps(
+                              _mm_slli_si128(_mm_castps_si128(v), 4)));
+        v = _mm_add_ps(v, _mm_shuffle_ps(_mm_setzero_ps(), v, 0x40));
+        v = _mm_add_ps(v, offset);
+        offset = _mm_shuffle_ps(v, v, 0xff);
+        v = _mm_andnot_ps(sign, v);
+        if (even_odd) {
+            c = _mm_cvttps_epi32(_mm_mul_ps(v, half));
+            v = _mm_sub_ps(v, _mm_mul_ps(_mm_cvtepi32_ps(c), two));
+            v = _mm_min_ps(v, _mm_sub_ps(two, v));
         }
-        else {
-            y--;
-            x++;
-            dx = dx + (2 * height * height);
-            dy = dy - (2 * width * width);
-            d2 = d2 + dx - dy + (width * width);
+        v = _mm_min_ps(v, one);
+        c = _mm_cvtps_epi32(_mm_mul_ps(v, scale));
+        c = _mm_packs_epi32(c, c);
+        c = _mm_packus_epi16(c, c);
+        packed = _mm_cvtsi128_si32(c);
+        memcpy(coverage + x, &packed, 4);
+    }
+    acc = _mm_cvtss_f32(offset);
+#endif /* DRAW_SIMD */
+
+    for (; x < w; x++) {
+        acc += cells[x];
+        a = fabsf(acc);
+        if (even_odd) {
+            a -= (float)(int)(a * 0.5f) * 2.0f;
+            a = MIN(a, 2.0f - a);
         }
+        coverage[x] = (Uint8)lrintf(MIN(a, 1.0f) * 255.0f);
     }
 }
 
+/* Blends color over a pixel with the given opacity, 1 to 254, keeping
+ * the "over" result in the pixel's alpha if it has any. */
 static void
-draw_ellipse_thickness(SDL_Surface *surf, int x0, int y0, int width,
-                       int height, int thickness, Uint32 color,
-                       int *drawn_area)
+aa_blend_pixel(SDL_Surface *surf, Uint8 *pixel, const Uint8 *rgba,
+               Uint32 opacity)
 {
-    long long dx, dy, dx_inner, dy_inner, x, y, x_inner, y_inner;
-    int line, x_offset, y_offset;
-    double d1, d2, d1_inner, d2_inner = 0;
-    x0 = x0 + width / 2;
-    y0 = y0 + height / 2;
-    x_offset = (width + 1) % 2;
-    y_offset = (height + 1) % 2;
-    width = width / 2;
-    height = height / 2;
-    line = 1;
-    x = 0;
-    y = height;
-    x_inner = 0;
-    y_inner = height - thickness;
-    d1 = (height * height) - (width * width * height) + (0.25 * width * width);
-    d1_inner =
-        ((height - thickness) * (height - thickness)) -
-        ((width - thickness) * (width - thickness) * (height - thickness)) +
-        (0.25 * (width - thickness) * (width - thickness));
-    dx = 2 * height * height * x;
-    dy = 2 * width * width * y;
-    dx_inner = 2 * (height - thickness) * (height - thickness) * x_inner;
-    dy_inner = 2 * (width - thickness) * (width - thickness) * y_inner;
-    while (dx < dy) {
-        if (line) {
-            drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
-                                     x0 + (int)x - x_offset, drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 - (int)x,
-                                     y0 + (int)y - y_offset,
-                                     x0 + (int)x - x_offset, drawn_area);
+    SDL_PixelFormat *format = surf->format;
+    Uint32 value = 0, inverse = 255 - opacity;
+    Uint8 r, g, b, a;
+
+    if (format->BytesPerPixel == 4 && !format->Rloss && !format->Gloss &&
+        !format->Bloss) {
+        /* 8 bits per channel: blend without mapping. */
+        value = *(Uint32 *)pixel;
+        r = (Uint8)(value >> format->Rshift);
+        g = (Uint8)(value >> format->Gshift);
+        b = (Uint8)(value >> format->Bshift);
+        value = (Uint32)((rgba[0] * opacity + r * inverse + 127) / 255)
+                    << format->Rshift |
+                (Uint32)((rgba[1] * opacity + g * inverse + 127) / 255)
+                    << format->Gshift |
+                (Uint32)((rgba[2] * opacity + b * inverse + 127) / 255)
+                    << format->Bshift;
+        if (format->Amask) {
+            a = (Uint8)(*(Uint32 *)pixel >> format->Ashift);
+            value |= (Uint32)(opacity + (a * inverse + 127) / 255)
+                     << format->Ashift;
         }
-        else {
-            drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
-                                     x0 - (int)x_inner, drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 - (int)x,
-                                     y0 + (int)y - y_offset, x0 - (int)x_inner,
-                                     drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 + (int)x - x_offset,
-                                     y0 - (int)y, x0 + (int)x_inner - x_offset,
-                                     drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 + (int)x - x_offset,
-                                     y0 + (int)y - y_offset,
-                                     x0 + (int)x_inner - x_offset, drawn_area);
+        *(Uint32 *)pixel = value;
+        return;
+    }
+
+    switch (format->BytesPerPixel) {
+        case 1:
+            value = *pixel;
+            break;
+        case 2:
+            value = *(Uint16 *)pixel;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            value = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16);
+#else
+            value = (pixel[0] << 16) | (pixel[1] << 8) | pixel[2];
+#endif
+            break;
+        default: /*case 4*/
+            value = *(Uint32 *)pixel;
+            break;
+    }
+
+    SDL_GetRGBA(value, format, &r, &g, &b, &a);
+    r = (Uint8)((rgba[0] * opacity + r * inverse + 127) / 255);
+    g = (Uint8)((rgba[1] * opacity + g * inverse + 127) / 255);
+    b = (Uint8)((rgba[2] * opacity + b * inverse + 127) / 255);
+    a = (Uint8)(opacity + (a * inverse + 127) / 255);
+    value = SDL_MapRGBA(format, r, g, b, a);
+
+    switch (format->BytesPerPixel) {
+        case 1:
+            *pixel = (Uint8)value;
+            break;
+        case 2:
+            *(Uint16 *)pixel = (Uint16)value;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            value <<= 8;
+#endif
+            memcpy(pixel, &value, 3 * sizeof(Uint8));
+            break;
+        default: /*case 4*/
+            *(Uint32 *)pixel = value;
+            break;
+    }
+}
+
+/* Rasterized rows are worked on in chunks of about this many cells, to
+ * bound the memory used for large paths. */
+#define AA_CHUNK_CELLS 0x100000
+
+static int
+aa_spans_add(aa_spans *spans, int x, int y, int len, const Uint8 *coverage)
+{
+    aa_span *new_spans;
+    Uint8 *new_coverage;
+
+    if (spans->n_spans == spans->spans_size) {
+        spans->spans_size = MAX(spans->spans_size * 2, 64);
+        new_spans = PyMem_Resize(spans->spans, aa_span, spans->spans_size);
+        if (!new_spans) {
+            return -1;
         }
-        if (d1 < 0) {
+        spans->spans = new_spans;
+    }
+
+    spans->spans[spans->n_spans].x = x;
+    spans->spans[spans->n_spans].y = y;
+    spans->spans[spans->n_spans].len = len;
+    spans->spans[spans->n_spans].coverage = -1;
+
+    if (coverage) {
+        if (spans->n_coverage + len > spans->coverage_size) {
+            spans->coverage_size =
+                MAX(spans->coverage_size * 2, spans->n_coverage + len);
+            new_coverage =
+                PyMem_Resize(spans->coverage, Uint8, spans->coverage_size);
+            if (!new_coverage) {
+                return -1;
+            }
+            spans->coverage = new_coverage;
+        }
+        memcpy(spans->coverage + spans->n_coverage, coverage, len);
+        spans->spans[spans->n_spans].coverage = spans->n_coverage;
+        spans->n_coverage += len;
+    }
+
+    spans->n_spans++;
+    return 0;
+}
+
+/* Adds the runs of fully and of partly covered pixels of a row. */
+static int
+aa_spans_add_row(aa_spans *spans, const Uint8 *coverage, int w, int x0,
+                 int y)
+{
+    int x = 0, start;
+
+    while (x < w) {
+        if (!coverage[x]) {
             x++;
-            dx = dx + (2 * height * height);
-            d1 = d1 + dx + (height * height);
+            continue;
+        }
+
+        start = x;
+        if (coverage[x] == 255) {
+            while (x < w && coverage[x] == 255) {
+                x++;
+            }
+            if (aa_spans_add(spans, x0 + start, y, x - start, NULL)) {
+                return -1;
+            }
         }
         else {
-            x++;
-            y--;
-            dx = dx + (2 * height * height);
-            dy = dy - (2 * width * width);
-            d1 = d1 + dx - dy + (height * height);
-            if (line && y < height - thickness) {
-                line = 0;
+            while (x < w && coverage[x] && coverage[x] != 255) {
+                x++;
             }
-            if (!line) {
-                if (dx_inner < dy_inner) {
-                    while (d1_inner < 0) {
-                        x_inner++;
-                        dx_inner = dx_inner + (2 * (height - thickness) *
-                                               (height - thickness));
-                        d1_inner =
-                            d1_inner + dx_inner +
-                            ((height - thickness) * (height - thickness));
-                    }
-                    x_inner++;
-                    y_inner--;
-                    dx_inner = dx_inner + (2 * (height - thickness) *
-                                           (height - thickness));
-                    dy_inner = dy_inner -
-                               (2 * (width - thickness) * (width - thickness));
-                    d1_inner = d1_inner + dx_inner - dy_inner +
-                               ((height - thickness) * (height - thickness));
-                }
+            if (aa_spans_add(spans, x0 + start, y, x - start,
+                             coverage + start)) {
+                return -1;
             }
         }
     }
-    d2 = (((double)height * height) * ((x + 0.5) * (x + 0.5))) +
-         (((double)width * width) * ((y - 1) * (y - 1))) -
-         ((double)width * width * height * height);
-    while (y >= 0) {
-        if (line) {
-            drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
-                                     x0 + (int)x - x_offset, drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 - (int)x,
-                                     y0 + (int)y - y_offset,
-                                     x0 + (int)x - x_offset, drawn_area);
+    return 0;
+}
+
+static void
+aa_spans_free(aa_spans *spans)
+{
+    PyMem_Free(spans->spans);
+    PyMem_Free(spans->coverage);
+    spans->spans = NULL;
+    spans->coverage = NULL;
+    spans->n_spans = spans->spans_size = 0;
+    spans->n_coverage = spans->coverage_size = 0;
+}
+
+/* Sets bounds to the pixels touched by the contours of path, within
+ * AA_MAX_COORD of the origin. */
+static void
+aa_path_bounds(const aa_path *path, SDL_Rect *bounds)
+{
+    float minx = FLT_MAX, miny = FLT_MAX, maxx = -FLT_MAX, maxy = -FLT_MAX;
+    Py_ssize_t i;
+
+    for (i = 0; i < path->len; i++) {
+        minx = MIN(minx, path->points[2 * i]);
+        maxx = MAX(maxx, path->points[2 * i]);
+        miny = MIN(miny, path->points[2 * i + 1]);
+        maxy = MAX(maxy, path->points[2 * i + 1]);
+    }
+
+    bounds->w = bounds->h = 0;
+    if (!path->len || !(minx < AA_MAX_COORD) || !(maxx > -AA_MAX_COORD) ||
+        !(miny < AA_MAX_COORD) || !(maxy > -AA_MAX_COORD)) {
+        bounds->x = bounds->y = 0;
+        return;
+    }
+    bounds->x = (int)MAX(-AA_MAX_COORD, floorf(minx));
+    bounds->y = (int)MAX(-AA_MAX_COORD, floorf(miny));
+    bounds->w = (int)MIN(AA_MAX_COORD, ceilf(maxx)) - bounds->x;
+    bounds->h = (int)MIN(AA_MAX_COORD, ceilf(maxy)) - bounds->y;
+}
+
+/* An edge of a contour, from point a to point b, spanning the rows from
+ * top to bottom. */
+typedef struct {
+    Py_ssize_t a, b;
+    float top, bottom;
+} aa_edge;
+
+static int
+aa_edge_compare(const void *a, const void *b)
+{
+    float ta = ((const aa_edge *)a)->top, tb = ((const aa_edge *)b)->top;
+
+    return (ta > tb) - (ta < tb);
+}
+
+/* Rasterizes the contours of path into runs of covered pixels, appended
+ * to spans. Only the pixels inside area are kept, when it is not NULL.
+ *
+ * Returns 0, or -1 if out of memory.
+ */
+static int
+aa_path_spans(aa_path *path, const SDL_Rect *area, aa_spans *spans)
+{
+    aa_raster raster;
+    SDL_Rect bounds;
+    aa_edge *edges = NULL, *active = NULL, *edge;
+    Uint8 *coverage;
+    Py_ssize_t i, start, c, n_edges = 0, n_active = 0, next_edge = 0;
+    int y, chunk, chunk_rows, result = 0;
+    float y0, y1;
+
+    if (path->failed) {
+        return -1;
+    }
+
+    /* The raster covers the pixels touched by the path, within the area. */
+    aa_path_bounds(path, &bounds);
+    if (area && !SDL_IntersectRect(&bounds, area, &bounds)) {
+        return 0;
+    }
+    raster.x = bounds.x;
+    raster.y = bounds.y;
+    raster.w = bounds.w;
+    raster.h = bounds.h;
+    if (raster.w <= 0 || raster.h <= 0) {
+        return 0;
+    }
+
+    chunk_rows = MAX(1, MIN(raster.h, AA_CHUNK_CELLS / (raster.w + 2)));
+    raster.cells =
+        PyMem_Malloc((size_t)(raster.w + 2) * chunk_rows * sizeof(float));
+    coverage = PyMem_Malloc(raster.w);
+    edges = PyMem_New(aa_edge, path->len);
+    active = PyMem_New(aa_edge, path->len);
+    if (!raster.cells || !coverage || !edges || !active) {
+        result = -1;
+        goto end;
+    }
+
+    /* The edges crossing the rows of the raster, by their top row when it
+     * is rasterized in several chunks. */
+    for (c = 0, start = 0; c < path->n_contours; c++) {
+        Py_ssize_t end = path->ends[c];
+        for (i = start; i < end; i++) {
+            edge = edges + n_edges;
+            edge->a = i;
+            edge->b = i + 1 < end ? i + 1 : start;
+            y0 = path->points[2 * edge->a + 1];
+            y1 = path->points[2 * edge->b + 1];
+            edge->top = MIN(y0, y1);
+            edge->bottom = MAX(y0, y1);
+            if (edge->top < edge->bottom &&
+                edge->top < (float)(raster.y + raster.h) &&
+                edge->bottom > (float)raster.y) {
+                n_edges++;
+            }
         }
-        else {
-            drawhorzlineclipbounding(surf, color, x0 - (int)x, y0 - (int)y,
-                                     x0 - (int)x_inner, drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 - (int)x,
-                                     y0 + (int)y - y_offset, x0 - (int)x_inner,
-                                     drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 + (int)x - x_offset,
-                                     y0 - (int)y, x0 + (int)x_inner - x_offset,
-                                     drawn_area);
-            drawhorzlineclipbounding(surf, color, x0 + (int)x - x_offset,
-                                     y0 + (int)y - y_offset,
-                                     x0 + (int)x_inner - x_offset, drawn_area);
+        start = end;
+    }
+    if (chunk_rows < raster.h) {
+        qsort(edges, n_edges, sizeof(aa_edge), aa_edge_compare);
+    }
+
+    /* Rasterize a chunk of rows at a time, with the edges crossing it:
+     * aa_raster_line() skips their rows outside of it. */
+    for (chunk = 0; chunk < raster.h && !result; chunk += chunk_rows) {
+        aa_raster part = raster;
+
+        part.y = raster.y + chunk;
+        part.h = MIN(chunk_rows, raster.h - chunk);
+        memset(part.cells, 0,
+               (size_t)(part.w + 2) * part.h * sizeof(float));
+
+        for (i = 0, c = 0; i < n_active; i++) {
+            if (active[i].bottom > (float)part.y) {
+                active[c++] = active[i];
+            }
         }
-        if (d2 > 0) {
-            y--;
-            dy = dy - (2 * width * width);
-            d2 = d2 + (width * width) - dy;
+        n_active = c;
+        while (next_edge < n_edges &&
+               edges[next_edge].top < (float)(part.y + part.h)) {
+            active[n_active++] = edges[next_edge++];
         }
-        else {
-            y--;
-            x++;
-            dx = dx + (2 * height * height);
-            dy = dy - (2 * width * width);
-            d2 = d2 + dx - dy + (width * width);
+
+        for (i = 0; i < n_active; i++) {
+            aa_raster_line(&part, path->points[2 * active[i].a],
+                           path->points[2 * active[i].a + 1],
+                           path->points[2 * active[i].b],
+                           path->points[2 * active[i].b + 1]);
         }
-        if (line && y < height - thickness) {
-            line = 0;
+
+        for (y = 0; y < part.h && !result; y++) {
+            aa_raster_coverage(part.cells + (size_t)y * (part.w + 2),
+                               coverage, part.w, path->even_odd);
+            result = aa_spans_add_row(spans, coverage, part.w, part.x,
+                                      part.y + y);
         }
-        if (!line) {
-            if (dx_inner < dy_inner) {
-                while (d1_inner < 0) {
-                    x_inner++;
-                    dx_inner = dx_inner + (2 * (height - thickness) *
-                                           (height - thickness));
-                    d1_inner = d1_inner + dx_inner +
-                               ((height - thickness) * (height - thickness));
-                }
-                x_inner++;
-                y_inner--;
-                dx_inner = dx_inner +
-                           (2 * (height - thickness) * (height - thickness));
-                dy_inner =
-                    dy_inner - (2 * (width - thickness) * (width - thickness));
-                d1_inner = d1_inner + dx_inner - dy_inner +
-                           ((height - thickness) * (height - thickness));
-            }
-            else if (y_inner >= 0) {
-                if (d2_inner == 0) {
-                    d2_inner =
-                        ((((double)height - thickness) *
-                          (height - thickness)) *
-                         ((x_inner + 0.5) * (x_inner + 0.5))) +
-                        ((((double)width - thickness) * (width - thickness)) *
-                         ((y_inner - 1) * (y_inner - 1))) -
-                        (((double)width - thickness) * (width - thickness) *
-                         (height - thickness) * (height - thickness));
+    }
+
+end:
+    PyMem_Free(raster.cells);
+    PyMem_Free(coverage);
+    PyMem_Free(edges);
+    PyMem_Free(active);
+    return result;
+}
+
+/* Blends the runs of spans, moved by (dx, dy), onto the surface with
+ * color, rgba being its RGBA value. Runs of opaque pixels are filled
+ * directly with fill_span().
+ */
+static void
+aa_spans_draw(const aa_spans *spans, SDL_Surface *surf, const Uint8 *rgba,
+              Uint32 color, int dx, int dy, int *drawn_area)
+{
+    SDL_Rect *clip = &surf->clip_rect;
+    const aa_span *span;
+    const Uint8 *coverage;
+    Uint8 *pixel;
+    Py_ssize_t i;
+    int x, x1, x2, y, bpp = surf->format->BytesPerPixel;
+    Uint32 opacity;
+
+    for (i = 0; i < spans->n_spans; i++) {
+        span = spans->spans + i;
+        y = span->y + dy;
+        x1 = MAX(span->x + dx, clip->x);
+        x2 = MIN(span->x + dx + span->len, clip->x + clip->w) - 1;
+        if (y < clip->y || y >= clip->y + clip->h || x2 < x1) {
+            continue;
+        }
+
+        pixel = (Uint8 *)surf->pixels + y * surf->pitch + x1 * bpp;
+
+        if (span->coverage < 0) {
+            if (rgba[3] == 255) {
+                fill_span(pixel, x2 - x1 + 1, color, bpp);
+            }
+            else if (rgba[3]) {
+                for (x = x1; x <= x2; x++, pixel += bpp) {
+                    aa_blend_pixel(surf, pixel, rgba, rgba[3]);
                 }
-                if (d2_inner > 0) {
-                    y_inner--;
-                    dy_inner = dy_inner -
-                               (2 * (width - thickness) * (width - thickness));
-                    d2_inner = d2_inner +
-                               ((width - thickness) * (width - thickness)) -
-                               dy_inner;
+            }
+        }
+        else {
+            coverage = spans->coverage + span->coverage +
+                       (x1 - (span->x + dx));
+            for (x = x1; x <= x2; x++, pixel += bpp, coverage++) {
+                opacity = (*coverage * rgba[3] + 127) / 255;
+                if (opacity == 255) {
+                    fill_span(pixel, 1, color, bpp);
                 }
-                else {
-                    y_inner--;
-                    x_inner++;
-                    dx_inner = dx_inner + (2 * (height - thickness) *
-                                           (height - thickness));
-                    dy_inner = dy_inner -
-                               (2 * (width - thickness) * (width - thickness));
-                    d2_inner = d2_inner + dx_inner - dy_inner +
-                               ((width - thickness) * (width - thickness));
+                else if (opacity) {
+                    aa_blend_pixel(surf, pixel, rgba, opacity);
                 }
             }
         }
+
+        add_pixel_to_drawn_list(x1, y, drawn_area);
+        add_pixel_to_drawn_list(x2, y, drawn_area);
     }
 }
 
-static void
-draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
-              Py_ssize_t num_points, Uint32 color, int *drawn_area)
+/* Rasterizes the contours of path within the clip area and blends them
+ * onto the surface with color, rgba being its RGBA value.
+ *
+ * Returns 0, or -1 if out of memory.
+ */
+static int
+aa_path_draw(aa_path *path, SDL_Surface *surf, const Uint8 *rgba,
+             Uint32 color, int *drawn_area)
 {
-    /* point_x : x coordinates of the points
-     * point-y : the y coordinates of the points
-     * num_points : the number of points
-     */
-    Py_ssize_t i, i_previous;  // i_previous is the index of the point before i
-    int y, miny, maxy;
-    int x1, y1;
-    int x2, y2;
-    /* x_intersect are the x-coordinates of intersections of the polygon
-     * with some horizontal line */
-    int *x_intersect = PyMem_New(int, num_points);
-    if (x_intersect == NULL) {
-        PyErr_NoMemory();
-        return;
+    aa_spans spans = {NULL, 0, 0, NULL, 0, 0};
+
+    if (aa_path_spans(path, &surf->clip_rect, &spans)) {
+        aa_spans_free(&spans);
+        return -1;
     }
 
-    /* Determine Y maxima */
-    miny = point_y[0];
-    maxy = point_y[0];
-    for (i = 1; (i < num_points); i++) {
-        miny = MIN(miny, point_y[i]);
-        maxy = MAX(maxy, point_y[i]);
+    aa_spans_draw(&spans, surf, rgba, color, 0, 0, drawn_area);
+    aa_spans_free(&spans);
+    return 0;
+}
+
+/* Flood fill.
+ *
+ * Runs of matching pixels are filled one row at a time from a stack of
+ * seeds, the rows above and below each run being searched for the runs to
+ * fill next. A bitmap of the filled pixels keeps any pixel from being
+ * filled twice, which also lets the fill color match the seed color.
+ */
+
+/* Returns the value of the pixel of bpp bytes at pixel. */
+static Uint32
+flood_pixel(const Uint8 *pixel, int bpp)
+{
+    switch (bpp) {
+        case 1:
+            return *pixel;
+        case 2:
+            return *(const Uint16 *)pixel;
+        case 4:
+            return *(const Uint32 *)pixel;
+        default:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            return pixel[0] | pixel[1] << 8 | (Uint32)pixel[2] << 16;
+#else
+            return pixel[2] | pixel[1] << 8 | (Uint32)pixel[0] << 16;
+#endif
     }
+}
 
-    if (miny == maxy) {
-        /* Special case: polygon only 1 pixel high. */
+/* Returns 1 if the pixel value matches the seed color, else 0. */
+static int
+flood_matches(const flood_state *state, Uint32 value)
+{
+    int i;
 
-        /* Determine X bounds */
-        int minx = point_x[0];
-        int maxx = point_x[0];
-        for (i = 1; (i < num_points); i++) {
-            minx = MIN(minx, point_x[i]);
-            maxx = MAX(maxx, point_x[i]);
+    for (i = 0; i < state->n_channels; i++) {
+        if (!state->tables[i][(value & state->masks[i]) >>
+                              state->shifts[i]]) {
+            return 0;
         }
-        drawhorzlineclipbounding(surf, color, minx, miny, maxx, drawn_area);
-        PyMem_Free(x_intersect);
-        return;
     }
+    return 1;
+}
 
-    /* Draw, scanning y
-     * ----------------
-     * The algorithm uses a horizontal line (y) that moves from top to the
-     * bottom of the polygon:
-     *
-     * 1. search intersections with the border lines
-     * 2. sort intersections (x_intersect)
-     * 3. each two x-coordinates in x_intersect are then inside the polygon
-     *    (draw line for a pair of two such points)
-     */
-    for (y = miny; (y <= maxy); y++) {
-        // n_intersections is the number of intersections with the polygon
-        int n_intersections = 0;
-        for (i = 0; (i < num_points); i++) {
-            i_previous = ((i) ? (i - 1) : (num_points - 1));
-
-            y1 = point_y[i_previous];
-            y2 = point_y[i];
-            if (y1 < y2) {
-                x1 = point_x[i_previous];
-                x2 = point_x[i];
-            }
-            else if (y1 > y2) {
-                y2 = point_y[i_previous];
-                y1 = point_y[i];
-                x2 = point_x[i_previous];
-                x1 = point_x[i];
-            }
-            else {  // y1 == y2 : has to be handled as special case (below)
-                continue;
-            }
-            if (((y >= y1) && (y < y2)) || ((y == maxy) && (y2 == maxy))) {
-                // add intersection if y crosses the edge (excluding the lower
-                // end), or when we are on the lowest line (maxy)
-                x_intersect[n_intersections++] =
-                    (y - y1) * (x2 - x1) / (y2 - y1) + x1;
+static int
+flood_is_filled(const flood_state *state, int x, int y)
+{
+    x -= state->area.x;
+    y -= state->area.y;
+    return (state->filled[y * state->filled_pitch + (x >> 5)] >> (x & 31)) &
+           1;
+}
+
+/* Returns the first of x to end - 1 that has been filled on row y if
+ * filled is set, or that has not been if it is 0, else end. */
+static int
+flood_find(const flood_state *state, int x, int y, int end, int filled)
+{
+    const Uint32 *row;
+    Uint32 word, flip = filled ? 0 : 0xffffffff;
+
+    x -= state->area.x;
+    end -= state->area.x;
+    row = state->filled + (y - state->area.y) * state->filled_pitch;
+    while (x < end) {
+        word = (row[x >> 5] ^ flip) >> (x & 31);
+        if (word) {
+            while (!(word & 1)) {
+                word >>= 1;
+                x++;
             }
+            return MIN(x, end) + state->area.x;
         }
-        qsort(x_intersect, n_intersections, sizeof(int), compare_int);
+        x = (x | 31) + 1;
+    }
+    return end + state->area.x;
+}
 
-        for (i = 0; (i < n_intersections); i += 2) {
-            drawhorzlineclipbounding(surf, color, x_intersect[i], y,
-                                     x_intersect[i + 1], drawn_area);
+/* Returns the first of x to xmax that does not match or has been filled on
+ * row y, or xmax + 1 if they all match and none has been filled. */
+static int
+flood_run_end(const flood_state *state, int x, int y, int xmax)
+{
+    const Uint8 *row =
+        (const Uint8 *)state->surf->pixels + y * state->surf->pitch;
+    int end = x;
+
+#ifdef DRAW_SIMD
+    if (state->bytewise) {
+        /* Four pixels at a time, each matching when all of its bytes do. */
+        __m128i low = _mm_set1_epi32((int)state->low);
+        __m128i high = _mm_set1_epi32((int)state->high);
+        __m128i all = _mm_set1_epi32(-1);
+        __m128i v, in;
+        int matched;
+
+        for (; end + 3 <= xmax; end += 4) {
+            v = _mm_loadu_si128((const __m128i *)(row + end * 4));
+            in = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, low), v),
+                               _mm_cmpeq_epi8(_mm_min_epu8(v, high), v));
+            matched = _mm_movemask_ps(
+                _mm_castsi128_ps(_mm_cmpeq_epi32(in, all)));
+            if (matched != 0xf) {
+                while (matched & 1) {
+                    matched >>= 1;
+                    end++;
+                }
+                return flood_find(state, x, y, end, 1);
+            }
         }
     }
+#endif /* DRAW_SIMD */
 
-    /* Finally, a special case is not handled by above algorithm:
-     *
-     * For two border points with same height miny < y < maxy,
-     * sometimes the line between them is not colored:
-     * this happens when the line will be a lower border line of the polygon
-     * (eg we are inside the polygon with a smaller y, and outside with a
-     * bigger y),
-     * So we loop for border lines that are horizontal.
-     */
-    for (i = 0; (i < num_points); i++) {
-        i_previous = ((i) ? (i - 1) : (num_points - 1));
-        y = point_y[i];
+    while (end <= xmax &&
+           flood_matches(state, flood_pixel(row + end * state->bpp,
+                                            state->bpp))) {
+        end++;
+    }
+    return flood_find(state, x, y, end, 1);
+}
 
-        if ((miny < y) && (point_y[i_previous] == y) && (y < maxy)) {
-            drawhorzlineclipbounding(surf, color, point_x[i], y,
-                                     point_x[i_previous], drawn_area);
+static int
+flood_push(flood_state *state, int x, int y)
+{
+    int *stack;
+
+    if (state->stack_len == state->stack_size) {
+        state->stack_size = state->stack_size ? state->stack_size * 2 : 256;
+        stack = PyMem_Realloc(state->stack,
+                              state->stack_size * 2 * sizeof(int));
+        if (!stack) {
+            return -1;
         }
+        state->stack = stack;
     }
-    PyMem_Free(x_intersect);
+    state->stack[state->stack_len * 2] = x;
+    state->stack[state->stack_len * 2 + 1] = y;
+    state->stack_len++;
+    return 0;
 }
 
+/* Sets the bits of x1 to x2 on row y of words of bits, bits 0 to bits - 1
+ * of a word being the pixels of the word in order. */
+#define FLOOD_SET_RUN(type, bits, first_word, stride, x1, x2)          \
+    {                                                                  \
+        int _x = (x1), _start, _n;                                     \
+        while (_x <= (x2)) {                                           \
+            _start = _x % (bits);                                      \
+            _n = MIN((x2)-_x + 1, (bits)-_start);                      \
+            (first_word)[_x / (bits) * (stride)] |=                    \
+                _n == (bits) ? ~(type)0                                \
+                             : (((type)1 << _n) - 1) << _start;        \
+            _x += _n;                                                  \
+        }                                                              \
+    }
+
+/* Fills the pixels of x1 to x2 on row y and marks them filled. */
 static void
-draw_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int width,
-          Uint32 color)
+flood_fill_run(flood_state *state, int x1, int x2, int y, Uint32 color,
+               int paint, bitmask_t *mask)
 {
-    int i;
-    for (i = 0; i < width; i++) {
-        drawhorzlineclip(surf, color, x1, y1 + i, x2);
-        drawhorzlineclip(surf, color, x1, y2 - i, x2);
+    Uint32 *row = state->filled + (y - state->area.y) * state->filled_pitch;
+
+    FLOOD_SET_RUN(Uint32, 32, row, 1, x1 - state->area.x,
+                  x2 - state->area.x);
+    if (paint) {
+        fill_span((Uint8 *)state->surf->pixels + y * state->surf->pitch +
+                      x1 * state->bpp,
+                  x2 - x1 + 1, color, state->bpp);
     }
-    for (i = 0; i < (y2 - y1) - 2 * width + 1; i++) {
-        drawhorzlineclip(surf, color, x1, y1 + width + i, x1 + width - 1);
-        drawhorzlineclip(surf, color, x2 - width + 1, y1 + width + i, x2);
+    if (mask) {
+        FLOOD_SET_RUN(BITMASK_W, (int)BITMASK_W_LEN, mask->bits + y, mask->h,
+                      x1, x2);
     }
 }
 
-static void
-draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
-                int width, Uint32 color, int top_left, int top_right,
-                int bottom_left, int bottom_right, int *drawn_area)
+/* Sets up the tables telling which pixel values are within tolerance of
+ * the color of the seed pixel.
+ *
+ * Returns 0, or -1 if out of memory.
+ */
+static int
+flood_setup(flood_state *state, Uint32 seed, int tolerance)
 {
-    int pts[16], i;
-    float q_top, q_left, q_bottom, q_right, f;
-    if (top_left < 0)
-        top_left = radius;
-    if (top_right < 0)
-        top_right = radius;
-    if (bottom_left < 0)
-        bottom_left = radius;
-    if (bottom_right < 0)
-        bottom_right = radius;
-    if ((top_left + top_right) > (x2 - x1 + 1) ||
-        (bottom_left + bottom_right) > (x2 - x1 + 1) ||
-        (top_left + bottom_left) > (y2 - y1 + 1) ||
-        (top_right + bottom_right) > (y2 - y1 + 1)) {
-        q_top = (x2 - x1 + 1) / (float)(top_left + top_right);
-        q_left = (y2 - y1 + 1) / (float)(top_left + bottom_left);
-        q_bottom = (x2 - x1 + 1) / (float)(bottom_left + bottom_right);
-        q_right = (y2 - y1 + 1) / (float)(top_right + bottom_right);
-        f = MIN(MIN(MIN(q_top, q_left), q_bottom), q_right);
-        top_left = (int)(top_left * f);
-        top_right = (int)(top_right * f);
-        bottom_left = (int)(bottom_left * f);
-        bottom_right = (int)(bottom_right * f);
-    }
-    if (width == 0) { /* Filled rect */
-        pts[0] = x1;
-        pts[1] = x1 + top_left;
-        pts[2] = x2 - top_right;
-        pts[3] = x2;
-        pts[4] = x2;
-        pts[5] = x2 - bottom_right;
-        pts[6] = x1 + bottom_left;
-        pts[7] = x1;
-        pts[8] = y1 + top_left;
-        pts[9] = y1;
-        pts[10] = y1;
-        pts[11] = y1 + top_right;
-        pts[12] = y2 - bottom_right;
-        pts[13] = y2;
-        pts[14] = y2;
-        pts[15] = y2 - bottom_left;
-        draw_fillpoly(surf, pts, pts + 8, 8, color, drawn_area);
-        draw_circle_quadrant(surf, x2 - top_right + 1, y1 + top_right,
-                             top_right, 0, color, 1, 0, 0, 0, drawn_area);
-        draw_circle_quadrant(surf, x1 + top_left, y1 + top_left, top_left, 0,
-                             color, 0, 1, 0, 0, drawn_area);
-        draw_circle_quadrant(surf, x1 + bottom_left, y2 - bottom_left + 1,
-                             bottom_left, 0, color, 0, 0, 1, 0, drawn_area);
-        draw_circle_quadrant(surf, x2 - bottom_right + 1,
-                             y2 - bottom_right + 1, bottom_right, 0, color, 0,
-                             0, 0, 1, drawn_area);
+    SDL_PixelFormat *format = state->surf->format;
+    Uint32 masks[4] = {format->Rmask, format->Gmask, format->Bmask,
+                       format->Amask};
+    Uint32 size, v;
+    Uint8 seed_rgba[4], rgba[4];
+    int i, c, matches;
+
+    SDL_GetRGBA(seed, format, seed_rgba, seed_rgba + 1, seed_rgba + 2,
+                seed_rgba + 3);
+
+    state->bytewise = state->bpp == 4;
+    state->low = 0;
+    state->high = 0xffffffff;
+
+    /* A palette index is one channel of 256 values, compared by the color
+     * it stands for. */
+    if (state->bpp == 1) {
+        state->masks[0] = 0xff;
+        state->n_channels = 1;
+    }
+    for (i = 0; i < 4 && state->bpp > 1; i++) {
+        if (masks[i]) {
+            state->masks[state->n_channels++] = masks[i];
+        }
     }
-    else {
-        if (x2 - top_right == x1 + top_left) {
-            for (i = 0; i < width; i++) {
-                set_and_check_rect(
-                    surf, x1 + top_left, y1 + i, color,
-                    drawn_area); /* Fill gap if reduced radius */
-            }
+
+    for (c = 0; c < state->n_channels; c++) {
+        while (!((state->masks[c] >> state->shifts[c]) & 1)) {
+            state->shifts[c]++;
         }
-        else
-            draw_line_width(surf, color, x1 + top_left,
-                            y1 + (int)(width / 2) - 1 + width % 2,
-                            x2 - top_right,
-                            y1 + (int)(width / 2) - 1 + width % 2, width,
-                            drawn_area); /* Top line */
-        if (y2 - bottom_left == y1 + top_left) {
-            for (i = 0; i < width; i++) {
-                set_and_check_rect(
-                    surf, x1 + i, y1 + top_left, color,
-                    drawn_area); /* Fill gap if reduced radius */
-            }
+        size = (state->masks[c] >> state->shifts[c]) + 1;
+        state->tables[c] = PyMem_Malloc(size);
+        if (!state->tables[c]) {
+            return -1;
         }
-        else
-            draw_line_width(
-                surf, color, x1 + (int)(width / 2) - 1 + width % 2,
-                y1 + top_left, x1 + (int)(width / 2) - 1 + width % 2,
-                y2 - bottom_left, width, drawn_area); /* Left line */
-        if (x2 - bottom_right == x1 + bottom_left) {
-            for (i = 0; i < width; i++) {
-                set_and_check_rect(
-                    surf, x1 + bottom_left, y2 - i, color,
-                    drawn_area); /* Fill gap if reduced radius */
+
+        /* The 8 bit values of the channels a value sets must each be
+         * within tolerance of the seed's. */
+        for (v = 0; v < size; v++) {
+            SDL_GetRGBA(v << state->shifts[c], format, rgba, rgba + 1,
+                        rgba + 2, rgba + 3);
+            matches = 1;
+            for (i = 0; i < 4; i++) {
+                if ((state->bpp == 1 || masks[i] == state->masks[c]) &&
+                    abs(rgba[i] - seed_rgba[i]) > tolerance) {
+                    matches = 0;
+                }
             }
+            state->tables[c][v] = (Uint8)matches;
         }
-        else
-            draw_line_width(surf, color, x1 + bottom_left,
-                            y2 - (int)(width / 2), x2 - bottom_right,
-                            y2 - (int)(width / 2), width,
-                            drawn_area); /* Bottom line */
-        if (y2 - bottom_right == y1 + top_right) {
-            for (i = 0; i < width; i++) {
-                set_and_check_rect(
-                    surf, x2 - i, y1 + top_right, color,
-                    drawn_area); /* Fill gap if reduced radius */
+
+        if (size != 256 || state->shifts[c] % 8) {
+            state->bytewise = 0;
+            continue;
+        }
+        v = (seed & state->masks[c]) >> state->shifts[c];
+        state->low &= ~state->masks[c];
+        state->low |= (Uint32)MAX((int)v - tolerance, 0) << state->shifts[c];
+        state->high &= ~state->masks[c];
+        state->high |= (Uint32)MIN((int)v + tolerance, 255)
+                       << state->shifts[c];
+    }
+    return 0;
+}
+
+/* Fills the pixels connected to (x, y), which must be in the clip area,
+ * whose color is within tolerance of the color of that pixel. The pixels
+ * are set to color if paint is set, and their bits set in mask if not
+ * NULL.
+ *
+ * Returns 0, or -1 if out of memory.
+ */
+static int
+draw_flood_fill(SDL_Surface *surf, int x, int y, Uint32 color, int paint,
+                int tolerance, bitmask_t *mask, int *drawn_area)
+{
+    flood_state state;
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    Uint32 seed;
+    int x1, x2, ny, left, right, top, bottom, i, result = -1;
+
+    memset(&state, 0, sizeof(state));
+    state.surf = surf;
+    state.area = surf->clip_rect;
+    state.bpp = surf->format->BytesPerPixel;
+    seed = flood_pixel(pixels + y * surf->pitch + x * state.bpp, state.bpp);
+    state.filled_pitch = (state.area.w + 31) / 32;
+    state.filled = PyMem_Calloc((size_t)state.filled_pitch * state.area.h,
+                                sizeof(Uint32));
+    if (!state.filled || flood_setup(&state, seed, tolerance) ||
+        flood_push(&state, x, y)) {
+        goto end;
+    }
+
+    left = state.area.x;
+    right = state.area.x + state.area.w - 1;
+    top = state.area.y;
+    bottom = state.area.y + state.area.h - 1;
+
+    while (state.stack_len) {
+        state.stack_len--;
+        x = state.stack[state.stack_len * 2];
+        y = state.stack[state.stack_len * 2 + 1];
+        if (flood_is_filled(&state, x, y)) {
+            continue;
+        }
+
+        x1 = x;
+        while (x1 > left && !flood_is_filled(&state, x1 - 1, y) &&
+               flood_matches(&state,
+                             flood_pixel(pixels + y * surf->pitch +
+                                             (x1 - 1) * state.bpp,
+                                         state.bpp))) {
+            x1--;
+        }
+        x2 = flood_run_end(&state, x, y, right) - 1;
+
+        flood_fill_run(&state, x1, x2, y, color, paint, mask);
+        add_pixel_to_drawn_list(x1, y, drawn_area);
+        add_pixel_to_drawn_list(x2, y, drawn_area);
+
+        /* Seed each run of matching pixels above and below the run. */
+        for (ny = y - 1; ny <= y + 1; ny += 2) {
+            if (ny < top || ny > bottom) {
+                continue;
+            }
+            x = x1;
+            while ((x = flood_find(&state, x, ny, x2 + 1, 0)) <= x2) {
+                if (flood_matches(&state,
+                                  flood_pixel(pixels + ny * surf->pitch +
+                                                  x * state.bpp,
+                                              state.bpp))) {
+                    if (flood_push(&state, x, ny)) {
+                        goto end;
+                    }
+                    x = flood_run_end(&state, x, ny, x2);
+                }
+                x++;
             }
         }
-        else
-            draw_line_width(surf, color, x2 - (int)(width / 2), y1 + top_right,
-                            x2 - (int)(width / 2), y2 - bottom_right, width,
-                            drawn_area); /* Right line */
+    }
+    result = 0;
 
-        draw_circle_quadrant(surf, x2 - top_right + 1, y1 + top_right,
-                             top_right, width, color, 1, 0, 0, 0, drawn_area);
-        draw_circle_quadrant(surf, x1 + top_left, y1 + top_left, top_left,
-                             width, color, 0, 1, 0, 0, drawn_area);
-        draw_circle_quadrant(surf, x1 + bottom_left, y2 - bottom_left + 1,
-                             bottom_left, width, color, 0, 0, 1, 0,
-                             drawn_area);
-        draw_circle_quadrant(surf, x2 - bottom_right + 1,
-                             y2 - bottom_right + 1, bottom_right, width, color,
-                             0, 0, 0, 1, drawn_area);
+end:
+    PyMem_Free(state.filled);
+    PyMem_Free(state.stack);
+    for (i = 0; i < 4; i++) {
+        PyMem_Free(state.tables[i]);
     }
+    return result;
 }
 
 /* List of python functions */
@@ -2483,11 +7711,26 @@ static PyMethodDef _draw_methods[] = {
      DOC_PYGAMEDRAWPOLYGON},
     {"rect", (PyCFunction)rect, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEDRAWRECT},
+    {"lines_batch", (PyCFunction)lines_batch, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWLINESBATCH},
+    {"circles", (PyCFunction)circles, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWCIRCLES},
+    {"rects", (PyCFunction)rects, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWRECTS},
+    {"aapolygon", (PyCFunction)aapolygon, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWAAPOLYGON},
+    {"aacircle", (PyCFunction)aacircle, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWAACIRCLE},
+    {"aastroke", (PyCFunction)aastroke, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWAASTROKE},
+    {"flood_fill", (PyCFunction)flood_fill, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWFLOODFILL},
 
     {NULL, NULL, 0, NULL}};
 
 MODINIT_DEFINE(draw)
 {
+    PyObject *module;
     static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
                                          "draw",
                                          DOC_PYGAMEDRAW,
@@ -2517,7 +7760,38 @@ MODINIT_DEFINE(draw)
     if (PyErr_Occurred()) {
         return NULL;
     }
+    import_pygame_mask();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (PyType_Ready(&pgPath_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgRenderQueue_Type) < 0) {
+        return NULL;
+    }
 
     /* create the module */
-    return PyModule_Create(&_module);
+    module = PyModule_Create(&_module);
+    if (module == NULL) {
+        return NULL;
+    }
+
+    Py_INCREF(&pgPath_Type);
+    if (PyModule_AddObject(module, "Path", (PyObject *)&pgPath_Type)) {
+        Py_DECREF(&pgPath_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgRenderQueue_Type);
+    if (PyModule_AddObject(module, "RenderQueue",
+                           (PyObject *)&pgRenderQueue_Type)) {
+        Py_DECREF(&pgRenderQueue_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    return module;
 }
@@ -51,6 +51,40 @@
 
 #define MAX_UINT32 0xFFFFFFFF
 
+/* Events posted with pgEvent_PostPayload carry this in user.code, and
+ * their payload bytes inline, instead of a dict in user.data1 */
+#define PAYLOAD_CHECK (Sint32)0xFEEDF00E
+#define PAYLOAD_NONE MAX_UINT32
+#define PAYLOAD_MAX_SIZE 40
+
+typedef struct {
+    Uint32 type;
+    Uint32 timestamp;
+    Uint32 size; /* PAYLOAD_NONE for an event without payload */
+    Sint32 code; /* same place as user.code */
+    Uint8 data[PAYLOAD_MAX_SIZE];
+} pgPayloadEvent;
+
+SDL_COMPILE_TIME_ASSERT(payload_event, sizeof(pgPayloadEvent) <=
+                                           sizeof(SDL_Event));
+SDL_COMPILE_TIME_ASSERT(payload_code, offsetof(pgPayloadEvent, code) ==
+                                          offsetof(SDL_UserEvent, code));
+
+/* Bounded lock-free queue of payload events, one slot per event. Any
+ * thread can post to it without the GIL, and it is drained into the SDL
+ * queue on every pump. The slot of position pos is free for the producer
+ * that reserves pos when its seq is pos, and holds an event for the
+ * consumer when its seq is pos + 1 */
+#define PAYLOAD_QUEUE_LEN 4096
+
+static struct {
+    SDL_atomic_t seq;
+    SDL_Event event;
+} _pg_payload_queue[PAYLOAD_QUEUE_LEN];
+static SDL_atomic_t _pg_payload_tail;
+static unsigned int _pg_payload_head = 0;
+static SDL_SpinLock _pg_payload_lock = 0;
+
 #define PG_GET_LIST_LEN 128
 
 // Map joystick instance IDs to device ids for partial backwards compatibility
@@ -85,6 +119,43 @@ static int pg_key_repeat_delay = 0;
 static int pg_key_repeat_interval = 0;
 
 static SDL_TimerID _pg_repeat_timer = 0;
+
+/* Per type rate limits applied to the queue on each pump. Times are the
+ * event timestamps in microseconds. The events of a type are split in
+ * windows of period, each starting at the first event from next on, and
+ * only the newest event of a window is kept, a copy of which is last. The
+ * table and the dicts of dropped posted events are only changed and used
+ * under _pg_rate_lock, as pump() can run without the GIL */
+#define PG_MAX_RATE_LIMITS 32
+/* event timestamps are milliseconds in a Uint32 */
+#define PG_RATE_PERIOD_MAX ((Uint64)MAX_UINT32 * 1000)
+
+typedef struct {
+    Uint32 type;
+    Uint64 period;
+    Uint64 next;
+    SDL_Event last;
+} pgRateLimit;
+
+static pgRateLimit _pg_rate_limits[PG_MAX_RATE_LIMITS];
+static int _pg_rate_limit_count = 0;
+static SDL_SpinLock _pg_rate_lock = 0;
+
+/* dicts of posted events dropped without the GIL, released by the next
+ * pump that holds it */
+static PyObject **_pg_rate_unreleased = NULL;
+static int _pg_rate_unreleased_len = 0;
+static int _pg_rate_unreleased_capacity = 0;
+
+/* Motion event types merged with the event before them on each pump */
+static int _pg_coalesce_mouse = 0;
+static int _pg_coalesce_finger = 0;
+static int _pg_coalesce_joyaxis = 0;
+static int _pg_coalesce_controlleraxis = 0;
+
+/* The events merged and dropped by the two above, since init */
+static SDL_atomic_t _pg_filter_merged;
+static SDL_atomic_t _pg_filter_dropped;
 static SDL_Event _pg_repeat_event;
 
 static Uint32
@@ -566,6 +637,36 @@ pg_GetKeyRepeat(int *delay, int *interval)
     *interval = pg_key_repeat_interval;
 }
 
+/* The seq of a slot is stored minus the slot index, so the zeroed queue
+ * starts with each slot free for the first round */
+static unsigned int
+_pg_payload_seq(unsigned int pos)
+{
+    unsigned int slot = pos % PAYLOAD_QUEUE_LEN;
+    return (unsigned int)SDL_AtomicGet(&_pg_payload_queue[slot].seq) + slot;
+}
+
+static void
+_pg_payload_set_seq(unsigned int pos, unsigned int seq)
+{
+    unsigned int slot = pos % PAYLOAD_QUEUE_LEN;
+    SDL_AtomicSet(&_pg_payload_queue[slot].seq, (int)(seq - slot));
+}
+
+/* Drop the posted payload events, freeing their slots. An event that is
+ * still being written by its producer is left for the next drain */
+static void
+_pg_event_discard_payloads(void)
+{
+    SDL_AtomicLock(&_pg_payload_lock);
+    while (_pg_payload_seq(_pg_payload_head) == _pg_payload_head + 1) {
+        _pg_payload_set_seq(_pg_payload_head,
+                            _pg_payload_head + PAYLOAD_QUEUE_LEN);
+        _pg_payload_head++;
+    }
+    SDL_AtomicUnlock(&_pg_payload_lock);
+}
+
 static PyObject *
 pgEvent_AutoQuit(PyObject *self, PyObject *_null)
 {
@@ -579,6 +680,22 @@ pgEvent_AutoQuit(PyObject *self, PyObject *_null)
          * stops returning new types when they are finished, without that
          * test preventing further tests from getting a custom event type.*/
         _custom_event = _PGE_CUSTOM_EVENT_INIT;
+
+        SDL_AtomicLock(&_pg_rate_lock);
+        _pg_rate_limit_count = 0;
+        while (_pg_rate_unreleased_len)
+            Py_DECREF(_pg_rate_unreleased[--_pg_rate_unreleased_len]);
+        SDL_free(_pg_rate_unreleased);
+        _pg_rate_unreleased = NULL;
+        _pg_rate_unreleased_capacity = 0;
+        SDL_AtomicUnlock(&_pg_rate_lock);
+        _pg_coalesce_mouse = _pg_coalesce_finger = 0;
+        _pg_coalesce_joyaxis = _pg_coalesce_controlleraxis = 0;
+        SDL_AtomicSet(&_pg_filter_merged, 0);
+        SDL_AtomicSet(&_pg_filter_dropped, 0);
+
+        /* like the SDL queue, payload events don't outlive the module */
+        _pg_event_discard_payloads();
     }
     _pg_event_is_init = 0;
     Py_RETURN_NONE;
@@ -611,6 +728,106 @@ pgEvent_FillUserEvent(pgEventObject *e, SDL_Event *event)
     return 0;
 }
 
+/* Post an event with up to PAYLOAD_MAX_SIZE bytes of payload, or without
+ * a payload when payload is NULL. This is safe to call from any thread,
+ * without the GIL. Returns 1 when the event is queued, 0 when the event
+ * type is blocked or the queue is full, and -1 with an SDL error set on
+ * bad arguments */
+static int
+pgEvent_PostPayload(int type, const void *payload, Py_ssize_t size)
+{
+    pgPayloadEvent event;
+    unsigned int pos;
+    int dif;
+
+    if (type < 0 || type >= PG_NUMEVENTS) {
+        SDL_SetError("event type out of range");
+        return -1;
+    }
+    if (size < 0 || size > PAYLOAD_MAX_SIZE || (!payload && size)) {
+        SDL_SetError("event payload must be at most %d bytes",
+                     PAYLOAD_MAX_SIZE);
+        return -1;
+    }
+
+    type = _pg_pgevent_proxify(type);
+    if (SDL_EventState(type, SDL_QUERY) == SDL_IGNORE)
+        return 0;
+
+    memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.timestamp = SDL_GetTicks();
+    event.code = PAYLOAD_CHECK;
+    if (payload) {
+        event.size = (Uint32)size;
+        memcpy(event.data, payload, size);
+    }
+    else {
+        event.size = PAYLOAD_NONE;
+    }
+
+    /* reserve a position. Its slot is free when the consumer released it
+     * for this round, and the queue is full when it is a round behind */
+    pos = (unsigned int)SDL_AtomicGet(&_pg_payload_tail);
+    while (1) {
+        dif = (int)(_pg_payload_seq(pos) - pos);
+        if (!dif) {
+            if (SDL_AtomicCAS(&_pg_payload_tail, (int)pos, (int)(pos + 1)))
+                break;
+        }
+        else if (dif < 0) {
+            return 0;
+        }
+        pos = (unsigned int)SDL_AtomicGet(&_pg_payload_tail);
+    }
+
+    memcpy(&_pg_payload_queue[pos % PAYLOAD_QUEUE_LEN].event, &event,
+           sizeof(event));
+    _pg_payload_set_seq(pos, pos + 1);
+    return 1;
+}
+
+/* Move the posted payload events into the SDL queue, in the order they
+ * were posted. pump() can run without the GIL from wait(), so only one
+ * caller drains at a time, and the others leave it to that one */
+static void
+_pg_event_drain_payloads(void)
+{
+    SDL_Event events[PG_GET_LIST_LEN];
+    unsigned int pos;
+    int count, allowed, i;
+
+    if (!SDL_AtomicTryLock(&_pg_payload_lock))
+        return;
+
+    do {
+        pos = _pg_payload_head;
+        for (count = 0; count < PG_GET_LIST_LEN; count++, pos++) {
+            if (_pg_payload_seq(pos) != pos + 1)
+                break;
+            events[count] = _pg_payload_queue[pos % PAYLOAD_QUEUE_LEN].event;
+        }
+
+        /* events blocked after they were posted are dropped here, as the
+         * event filter does for SDL events. Like SDL_PushEvent, this
+         * drops the events that do not fit in a full SDL queue */
+        for (i = allowed = 0; i < count; i++) {
+            if (SDL_EventState(events[i].type, SDL_QUERY) != SDL_IGNORE)
+                events[allowed++] = events[i];
+        }
+        if (allowed)
+            PG_PEEP_EVENT_ALL(events, allowed, SDL_ADDEVENT);
+
+        /* free the slots for the next round of producers */
+        for (i = 0; i < count; i++, _pg_payload_head++) {
+            _pg_payload_set_seq(_pg_payload_head,
+                                _pg_payload_head + PAYLOAD_QUEUE_LEN);
+        }
+    } while (count == PG_GET_LIST_LEN);
+
+    SDL_AtomicUnlock(&_pg_payload_lock);
+}
+
 static char *
 _pg_name_from_eventtype(int type)
 {
@@ -849,6 +1066,38 @@ _joy_map_discard(int instance_id)
     }
 }
 
+/* the SDL1 gain and state attributes of an ACTIVEEVENT */
+static void
+_pg_active_gain_state(SDL_Event *event, long *gain, long *state)
+{
+    switch (event->window.event) {
+        case SDL_WINDOWEVENT_ENTER:
+            *gain = 1;
+            *state = SDL_APPMOUSEFOCUS;
+            break;
+        case SDL_WINDOWEVENT_LEAVE:
+            *gain = 0;
+            *state = SDL_APPMOUSEFOCUS;
+            break;
+        case SDL_WINDOWEVENT_FOCUS_GAINED:
+            *gain = 1;
+            *state = SDL_APPINPUTFOCUS;
+            break;
+        case SDL_WINDOWEVENT_FOCUS_LOST:
+            *gain = 0;
+            *state = SDL_APPINPUTFOCUS;
+            break;
+        case SDL_WINDOWEVENT_MINIMIZED:
+            *gain = 0;
+            *state = SDL_APPACTIVE;
+            break;
+        default:
+            assert(event->window.event == SDL_WINDOWEVENT_RESTORED);
+            *gain = 1;
+            *state = SDL_APPACTIVE;
+    }
+}
+
 static PyObject *
 dict_from_event(SDL_Event *event)
 {
@@ -861,6 +1110,18 @@ dict_from_event(SDL_Event *event)
     if (event->type >= PGPOST_EVENTBEGIN && event->user.code == USEROBJ_CHECK)
         return (PyObject *)event->user.data1;
 
+    if (event->type >= PGPOST_EVENTBEGIN &&
+        event->user.code == PAYLOAD_CHECK) {
+        pgPayloadEvent *posted = (pgPayloadEvent *)event;
+        dict = PyDict_New();
+        if (!dict || posted->size == PAYLOAD_NONE)
+            return dict;
+        _pg_insobj(dict, "payload",
+                   PyBytes_FromStringAndSize((char *)posted->data,
+                                             posted->size));
+        return dict;
+    }
+
     dict = PyDict_New();
     if (!dict)
         return NULL;
@@ -874,32 +1135,7 @@ dict_from_event(SDL_Event *event)
             _pg_insobj(dict, "h", PyLong_FromLong(event->window.data2));
             break;
         case SDL_ACTIVEEVENT:
-            switch (event->window.event) {
-                case SDL_WINDOWEVENT_ENTER:
-                    gain = 1;
-                    state = SDL_APPMOUSEFOCUS;
-                    break;
-                case SDL_WINDOWEVENT_LEAVE:
-                    gain = 0;
-                    state = SDL_APPMOUSEFOCUS;
-                    break;
-                case SDL_WINDOWEVENT_FOCUS_GAINED:
-                    gain = 1;
-                    state = SDL_APPINPUTFOCUS;
-                    break;
-                case SDL_WINDOWEVENT_FOCUS_LOST:
-                    gain = 0;
-                    state = SDL_APPINPUTFOCUS;
-                    break;
-                case SDL_WINDOWEVENT_MINIMIZED:
-                    gain = 0;
-                    state = SDL_APPACTIVE;
-                    break;
-                default:
-                    assert(event->window.event == SDL_WINDOWEVENT_RESTORED);
-                    gain = 1;
-                    state = SDL_APPACTIVE;
-            }
+            _pg_active_gain_state(event, &gain, &state);
             _pg_insobj(dict, "gain", PyLong_FromLong(gain));
             _pg_insobj(dict, "state", PyLong_FromLong(state));
             break;
@@ -1217,6 +1453,247 @@ dict_from_event(SDL_Event *event)
     return dict;
 }
 
+/* A fixed size record of an event, written by get_into() instead of an
+ * Event object. The meaning of data depends on the event type, see the
+ * docs of get_into() */
+typedef struct {
+    Uint32 type;
+    Uint32 timestamp;
+    Uint32 window; /* SDL window id, or 0 */
+    Sint32 which;  /* device, finger or payload size */
+    union {
+        Sint32 i[4];
+        float f[4];
+        Uint8 bytes[16];
+    } data;
+} pgEventRecord;
+
+/* Merge event into the motion event last that came just before it, when
+ * both are the same kind of motion of the same thing. The position or
+ * value of event replaces the one of last, and relative motion adds up.
+ * Returns 1 if event was merged into last */
+static int
+_pg_coalesce_motion(SDL_Event *last, SDL_Event *event)
+{
+    if (last->type != event->type)
+        return 0;
+
+    switch (event->type) {
+        case SDL_MOUSEMOTION:
+            if (last->motion.which != event->motion.which ||
+                last->motion.windowID != event->motion.windowID ||
+                last->motion.state != event->motion.state)
+                return 0;
+            event->motion.xrel += last->motion.xrel;
+            event->motion.yrel += last->motion.yrel;
+            break;
+        case SDL_FINGERMOTION:
+            if (last->tfinger.touchId != event->tfinger.touchId ||
+                last->tfinger.fingerId != event->tfinger.fingerId)
+                return 0;
+            event->tfinger.dx += last->tfinger.dx;
+            event->tfinger.dy += last->tfinger.dy;
+            break;
+        case SDL_JOYAXISMOTION:
+            if (last->jaxis.which != event->jaxis.which ||
+                last->jaxis.axis != event->jaxis.axis)
+                return 0;
+            break;
+        case SDL_CONTROLLERAXISMOTION:
+            if (last->caxis.which != event->caxis.which ||
+                last->caxis.axis != event->caxis.axis)
+                return 0;
+            break;
+        default:
+            return 0;
+    }
+    *last = *event;
+    return 1;
+}
+
+/* Fill record from event without making python objects. This has the
+ * same side effects as dict_from_event, which the event does not reach */
+static void
+_pg_record_from_event(SDL_Event *event, pgEventRecord *record)
+{
+    long gain, state;
+    int i;
+
+    memset(record, 0, sizeof(pgEventRecord));
+    record->type = _pg_pgevent_deproxify(event->type);
+    record->timestamp = event->common.timestamp;
+
+    if (event->type >= PGPOST_EVENTBEGIN &&
+        event->user.code == USEROBJ_CHECK) {
+        /* the attributes of posted events are not kept */
+        Py_DECREF((PyObject *)event->user.data1);
+        return;
+    }
+    if (event->type >= PGPOST_EVENTBEGIN &&
+        event->user.code == PAYLOAD_CHECK) {
+        pgPayloadEvent *posted = (pgPayloadEvent *)event;
+        if (posted->size == PAYLOAD_NONE) {
+            record->which = -1;
+        }
+        else {
+            record->which = posted->size;
+            memcpy(record->data.bytes, posted->data,
+                   SDL_min(posted->size, sizeof(record->data.bytes)));
+        }
+        return;
+    }
+
+    switch (event->type) {
+        case SDL_VIDEORESIZE:
+        case PGE_WINDOWMOVED:
+        case PGE_WINDOWRESIZED:
+        case PGE_WINDOWSIZECHANGED:
+        case PGE_WINDOWDISPLAYCHANGED:
+            record->data.i[0] = event->window.data1;
+            record->data.i[1] = event->window.data2;
+            break;
+        case SDL_ACTIVEEVENT:
+            _pg_active_gain_state(event, &gain, &state);
+            record->data.i[0] = gain;
+            record->data.i[1] = state;
+            break;
+        case SDL_KEYUP:
+            /* forget the unicode of the key, as _pg_get_event_unicode */
+            for (i = 0; i < MAX_SCAN_UNICODE; i++) {
+                if (scanunicode[i].key == event->key.keysym.scancode)
+                    scanunicode[i].key = 0;
+            }
+            /* fallthrough */
+        case SDL_KEYDOWN:
+            record->data.i[0] = event->key.keysym.sym;
+            record->data.i[1] = event->key.keysym.scancode;
+            record->data.i[2] = event->key.keysym.mod;
+            break;
+        case SDL_MOUSEMOTION:
+            record->which = event->motion.which;
+            record->data.i[0] = event->motion.x;
+            record->data.i[1] = event->motion.y;
+            record->data.i[2] = event->motion.xrel;
+            record->data.i[3] = event->motion.yrel;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            record->which = event->button.which;
+            record->data.i[0] = event->button.x;
+            record->data.i[1] = event->button.y;
+            record->data.i[2] = event->button.button;
+            break;
+        case SDL_MOUSEWHEEL:
+            record->which = event->wheel.which;
+            record->data.i[0] = event->wheel.x;
+            record->data.i[1] = event->wheel.y;
+#ifndef NO_SDL_MOUSEWHEEL_FLIPPED
+            record->data.i[2] =
+                event->wheel.direction == SDL_MOUSEWHEEL_FLIPPED;
+#endif
+            break;
+        case SDL_FINGERMOTION:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERUP:
+            record->which = (Sint32)event->tfinger.fingerId;
+            record->data.f[0] = event->tfinger.x;
+            record->data.f[1] = event->tfinger.y;
+            record->data.f[2] = event->tfinger.dx;
+            record->data.f[3] = event->tfinger.dy;
+            break;
+        case SDL_JOYAXISMOTION:
+            record->which = event->jaxis.which;
+            record->data.i[0] = event->jaxis.axis;
+            record->data.i[1] = event->jaxis.value;
+            break;
+        case SDL_JOYBALLMOTION:
+            record->which = event->jball.which;
+            record->data.i[0] = event->jball.ball;
+            record->data.i[1] = event->jball.xrel;
+            record->data.i[2] = event->jball.yrel;
+            break;
+        case SDL_JOYHATMOTION:
+            record->which = event->jhat.which;
+            record->data.i[0] = event->jhat.hat;
+            if (event->jhat.value & SDL_HAT_RIGHT)
+                record->data.i[1] = 1;
+            else if (event->jhat.value & SDL_HAT_LEFT)
+                record->data.i[1] = -1;
+            if (event->jhat.value & SDL_HAT_UP)
+                record->data.i[2] = 1;
+            else if (event->jhat.value & SDL_HAT_DOWN)
+                record->data.i[2] = -1;
+            break;
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+            record->which = event->jbutton.which;
+            record->data.i[0] = event->jbutton.button;
+            break;
+        case SDL_CONTROLLERAXISMOTION:
+            record->which = event->caxis.which;
+            record->data.i[0] = event->caxis.axis;
+            record->data.i[1] = event->caxis.value;
+            break;
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+            record->which = event->cbutton.which;
+            record->data.i[0] = event->cbutton.button;
+            break;
+        case SDL_JOYDEVICEADDED:
+            _joy_map_add(event->jdevice.which);
+            record->which = event->jdevice.which;
+            break;
+        case SDL_JOYDEVICEREMOVED:
+            _joy_map_discard(event->jdevice.which);
+            record->which = event->jdevice.which;
+            break;
+        case SDL_CONTROLLERDEVICEADDED:
+        case SDL_CONTROLLERDEVICEREMOVED:
+        case SDL_CONTROLLERDEVICEREMAPPED:
+            record->which = event->cdevice.which;
+            break;
+        case SDL_DROPFILE:
+#if SDL_VERSION_ATLEAST(2, 0, 5)
+        case SDL_DROPTEXT:
+#endif /* SDL_VERSION_ATLEAST(2, 0, 5) */
+            SDL_free(event->drop.file);
+            break;
+    }
+
+    switch (event->type) {
+        case SDL_VIDEORESIZE:
+        case SDL_ACTIVEEVENT:
+        case PGE_WINDOWSHOWN:
+        case PGE_WINDOWHIDDEN:
+        case PGE_WINDOWEXPOSED:
+        case PGE_WINDOWMOVED:
+        case PGE_WINDOWRESIZED:
+        case PGE_WINDOWSIZECHANGED:
+        case PGE_WINDOWMINIMIZED:
+        case PGE_WINDOWMAXIMIZED:
+        case PGE_WINDOWRESTORED:
+        case PGE_WINDOWENTER:
+        case PGE_WINDOWLEAVE:
+        case PGE_WINDOWFOCUSGAINED:
+        case PGE_WINDOWFOCUSLOST:
+        case PGE_WINDOWCLOSE:
+        case PGE_WINDOWTAKEFOCUS:
+        case PGE_WINDOWHITTEST:
+        case PGE_WINDOWICCPROFCHANGED:
+        case PGE_WINDOWDISPLAYCHANGED:
+        case SDL_TEXTEDITING:
+        case SDL_TEXTINPUT:
+        case SDL_MOUSEWHEEL:
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            record->window = event->window.windowID;
+            break;
+    }
+}
+
 /* event object internals */
 
 static void
@@ -1511,9 +1988,162 @@ get_grab(PyObject *self, PyObject *_null)
     return PyBool_FromLong(mode);
 }
 
+/* The coalesce setting of a motion event type, NULL for other types */
+static int *
+_pg_coalesce_setting(Uint32 type)
+{
+    switch (type) {
+        case SDL_MOUSEMOTION:
+            return &_pg_coalesce_mouse;
+        case SDL_FINGERMOTION:
+            return &_pg_coalesce_finger;
+        case SDL_JOYAXISMOTION:
+            return &_pg_coalesce_joyaxis;
+        case SDL_CONTROLLERAXISMOTION:
+            return &_pg_coalesce_controlleraxis;
+    }
+    return NULL;
+}
+
+static int
+_pg_coalesce_enabled(Uint32 type)
+{
+    int *setting = _pg_coalesce_setting(type);
+    return setting && *setting;
+}
+
+/* Merge a motion event of a type set to be coalesced into the event just
+ * before it on the queue. SDL_FilterEvents keeps the queue locked, so the
+ * event before stays in place while the queue is walked */
+static int SDLCALL
+_pg_coalesce_queued(void *userdata, SDL_Event *event)
+{
+    SDL_Event **prev = (SDL_Event **)userdata;
+
+    if (*prev && _pg_coalesce_enabled(event->type) &&
+        _pg_coalesce_motion(*prev, event)) {
+        SDL_AtomicAdd(&_pg_filter_merged, 1);
+        return 0;
+    }
+    *prev = event;
+    return 1;
+}
+
+/* Index in _pg_rate_limits of the limit of type, or -1 */
+static int
+_pg_rate_limit_of(Uint32 type)
+{
+    int i;
+
+    type = _pg_pgevent_deproxify(type);
+    for (i = 0; i < _pg_rate_limit_count; i++) {
+        if (_pg_rate_limits[i].type == type)
+            return i;
+    }
+    return -1;
+}
+
+/* Let go of the dict of a posted event that is dropped. Without the GIL
+ * it is only noted, and it is never released while the queue is locked,
+ * as that could run Python code that posts events */
+static void
+_pg_rate_release(SDL_Event *event)
+{
+    PyObject **unreleased;
+    int capacity;
+
+    if (event->type < PGPOST_EVENTBEGIN || event->user.code != USEROBJ_CHECK)
+        return;
+    if (_pg_rate_unreleased_len == _pg_rate_unreleased_capacity) {
+        capacity = _pg_rate_unreleased_capacity
+                       ? _pg_rate_unreleased_capacity * 2
+                       : 16;
+        unreleased = SDL_realloc(_pg_rate_unreleased,
+                                 capacity * sizeof(PyObject *));
+        if (!unreleased)
+            return; /* leak the dict rather than lose the event queue */
+        _pg_rate_unreleased = unreleased;
+        _pg_rate_unreleased_capacity = capacity;
+    }
+    _pg_rate_unreleased[_pg_rate_unreleased_len++] =
+        (PyObject *)event->user.data1;
+}
+
+/* Keep the first event of a window, and copy each newer event of the
+ * window over it. SDL_FilterEvents keeps the queue locked, so the kept
+ * events stay in place while the queue is walked. userdata holds the
+ * event kept for each limit, which is found again on later pumps while
+ * it is still queued */
+static int SDLCALL
+_pg_rate_filter(void *userdata, SDL_Event *event)
+{
+    SDL_Event **kept = (SDL_Event **)userdata;
+    pgRateLimit *limit;
+    Uint64 time;
+    int l = _pg_rate_limit_of(event->type);
+
+    if (l < 0)
+        return 1;
+    limit = _pg_rate_limits + l;
+    time = (Uint64)event->common.timestamp * 1000;
+
+    if (time >= limit->next) {
+        kept[l] = event;
+        limit->next = time + limit->period;
+        limit->last = *event;
+        return 1;
+    }
+    if (!kept[l] && !SDL_memcmp(event, &limit->last, sizeof(SDL_Event))) {
+        kept[l] = event;
+        return 1;
+    }
+    if (kept[l]) {
+        /* the newest event of the window replaces the kept one */
+        _pg_rate_release(kept[l]);
+        *kept[l] = limit->last = *event;
+    }
+    else {
+        /* the event kept for the window was already taken */
+        _pg_rate_release(event);
+    }
+    SDL_AtomicAdd(&_pg_filter_dropped, 1);
+    return 0;
+}
+
+/* Drop queued events to keep each type under its rate limit, in a single
+ * pass over the queue. Only one caller does this at a time, and the others
+ * leave the events to the next pump */
+static void
+_pg_event_rate_limit(void)
+{
+    SDL_Event *kept[PG_MAX_RATE_LIMITS] = {NULL};
+    PyObject **unreleased = NULL;
+    int len = 0;
+
+    if (!_pg_rate_limit_count || !SDL_AtomicTryLock(&_pg_rate_lock))
+        return;
+
+    SDL_FilterEvents(_pg_rate_filter, kept);
+    if (_pg_rate_unreleased_len && PyGILState_Check()) {
+        unreleased = _pg_rate_unreleased;
+        len = _pg_rate_unreleased_len;
+        _pg_rate_unreleased = NULL;
+        _pg_rate_unreleased_len = _pg_rate_unreleased_capacity = 0;
+    }
+    SDL_AtomicUnlock(&_pg_rate_lock);
+
+    while (len)
+        Py_DECREF(unreleased[--len]);
+    SDL_free(unreleased);
+}
+
 static void
 _pg_event_pump(int dopump)
 {
+    SDL_Event *prev = NULL;
+
+    /* events posted from other threads go before the ones pumped now */
+    _pg_event_drain_payloads();
     if (dopump) {
         SDL_PumpEvents();
     }
@@ -1522,6 +2152,11 @@ _pg_event_pump(int dopump)
      * might break. So after every event pump, we translate events from
      * here */
     SDL_FilterEvents(_pg_translate_windowevent, NULL);
+
+    if (_pg_coalesce_mouse || _pg_coalesce_finger || _pg_coalesce_joyaxis ||
+        _pg_coalesce_controlleraxis)
+        SDL_FilterEvents(_pg_coalesce_queued, &prev);
+    _pg_event_rate_limit();
 }
 
 static int
@@ -1924,6 +2559,94 @@ pg_event_get(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 }
 
+/* Write the events on the queue as records into records, up to capacity,
+ * and return the number of records written */
+static int
+_pg_get_records(pgEventRecord *records, int capacity, int coalesce)
+{
+    SDL_Event eventbuf[PG_GET_LIST_LEN], last;
+    pgEventRecord record;
+    int count = 0, want, len, loop;
+
+    /* the event of the last record, nothing merges into it yet */
+    last.type = SDL_FIRSTEVENT;
+
+    while (1) {
+        /* without room left, only take an event that can be merged */
+        want = SDL_min(capacity - count, PG_GET_LIST_LEN);
+        if (!want) {
+            if (!coalesce ||
+                PG_PEEP_EVENT_ALL(eventbuf, 1, SDL_PEEKEVENT) != 1 ||
+                !_pg_coalesce_motion(&last, eventbuf))
+                break;
+            /* the event was peeked, now take it off the queue */
+            PG_PEEP_EVENT_ALL(eventbuf, 1, SDL_GETEVENT);
+            _pg_record_from_event(&last, &record);
+            memcpy(records + count - 1, &record, sizeof(record));
+            continue;
+        }
+
+        len = PG_PEEP_EVENT_ALL(eventbuf, want, SDL_GETEVENT);
+        if (len == -1) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            return -1;
+        }
+
+        for (loop = 0; loop < len; loop++) {
+            if (coalesce && _pg_coalesce_motion(&last, eventbuf + loop)) {
+                _pg_record_from_event(&last, &record);
+                memcpy(records + count - 1, &record, sizeof(record));
+                continue;
+            }
+            last = eventbuf[loop];
+            _pg_record_from_event(eventbuf + loop, &record);
+            /* the buffer may not be aligned for the records */
+            memcpy(records + count, &record, sizeof(record));
+            count++;
+        }
+        if (len < want)
+            break;
+    }
+    return count;
+}
+
+static PyObject *
+pg_event_get_into(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *obj;
+    Py_buffer view;
+    Py_ssize_t capacity;
+    int dopump = 1, coalesce = 0, count;
+
+    static char *kwids[] = {"buffer", "pump", "coalesce", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|pp", kwids, &obj,
+                                     &dopump, &coalesce))
+        return NULL;
+
+    VIDEO_INIT_CHECK();
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS))
+        return NULL;
+
+    capacity = view.len / (Py_ssize_t)sizeof(pgEventRecord);
+    if (!capacity) {
+        PyBuffer_Release(&view);
+        return PyErr_Format(PyExc_ValueError,
+                            "buffer must hold at least one %d byte record",
+                            (int)sizeof(pgEventRecord));
+    }
+
+    _pg_event_pump(dopump);
+
+    count = _pg_get_records((pgEventRecord *)view.buf,
+                            (int)SDL_min(capacity, INT_MAX), coalesce);
+    PyBuffer_Release(&view);
+    if (count < 0)
+        return NULL;
+    return PyLong_FromLong(count);
+}
+
 static PyObject *
 pg_event_peek(PyObject *self, PyObject *args, PyObject *kwargs)
 {
@@ -2005,6 +2728,8 @@ pg_event_post(PyObject *self, PyObject *obj)
 
     pgEvent_FillUserEvent(e, &event);
 
+    /* keep the order with events posted from other threads */
+    _pg_event_drain_payloads();
     ret = SDL_PushEvent(&event);
     if (ret == 1)
         Py_RETURN_TRUE;
@@ -2017,6 +2742,37 @@ pg_event_post(PyObject *self, PyObject *obj)
     }
 }
 
+static PyObject *
+pg_event_post_payload(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int type, ret;
+    Py_buffer view;
+
+    static char *kwids[] = {"type", "payload", NULL};
+
+    view.buf = NULL;
+    view.len = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|y*", kwids, &type,
+                                     &view))
+        return NULL;
+
+    if (view.len > PAYLOAD_MAX_SIZE) {
+        PyBuffer_Release(&view);
+        return PyErr_Format(PyExc_ValueError,
+                            "payload must be at most %d bytes",
+                            PAYLOAD_MAX_SIZE);
+    }
+
+    /* no payload argument posts the event with an empty payload */
+    ret = pgEvent_PostPayload(type, view.buf ? view.buf : "", view.len);
+    if (view.buf)
+        PyBuffer_Release(&view);
+
+    if (ret < 0)
+        return RAISE(PyExc_ValueError, SDL_GetError());
+    return PyBool_FromLong(ret);
+}
+
 static PyObject *
 pg_event_set_allowed(PyObject *self, PyObject *obj)
 {
@@ -2116,6 +2872,139 @@ pg_event_get_blocked(PyObject *self, PyObject *obj)
     return PyBool_FromLong(isblocked);
 }
 
+static PyObject *
+pg_event_set_coalesce(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    Py_ssize_t len;
+    int loop, type, coalesce = 1, **settings;
+    PyObject *obj, *seq;
+
+    static char *kwids[] = {"eventtype", "coalesce", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p", kwids, &obj,
+                                     &coalesce))
+        return NULL;
+
+    seq = _pg_eventtype_as_seq(obj, &len);
+    if (!seq)
+        return NULL;
+    settings = PyMem_New(int *, len + 1);
+    if (!settings) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+
+    /* check every type before changing any setting */
+    for (loop = 0; loop < len; loop++) {
+        type = _pg_eventtype_from_seq(seq, loop);
+        if (type == -1)
+            break;
+        settings[loop] = _pg_coalesce_setting(type);
+        if (!settings[loop]) {
+            PyErr_SetString(PyExc_ValueError,
+                            "only motion events can be coalesced");
+            break;
+        }
+    }
+    Py_DECREF(seq);
+    if (loop < len) {
+        PyMem_Free(settings);
+        return NULL;
+    }
+
+    for (loop = 0; loop < len; loop++)
+        *settings[loop] = coalesce;
+    PyMem_Free(settings);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_event_set_rate_limit(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    Py_ssize_t len;
+    int loop, i, count, *types;
+    double rate = 0.0, period;
+    PyObject *obj, *seq;
+    pgRateLimit limits[PG_MAX_RATE_LIMITS];
+
+    static char *kwids[] = {"eventtype", "rate", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|d", kwids, &obj,
+                                     &rate))
+        return NULL;
+
+    if (!(rate >= 0.0))
+        return RAISE(PyExc_ValueError, "rate must be 0 or more");
+    /* a period below a microsecond, or longer than timestamps go, is as
+     * good as no limit or one event */
+    period = rate ? 1e6 / rate : 0.0;
+    period = SDL_max(period, 1.0);
+    period = SDL_min(period, (double)PG_RATE_PERIOD_MAX);
+
+    seq = _pg_eventtype_as_seq(obj, &len);
+    if (!seq)
+        return NULL;
+    types = PyMem_New(int, len + 1);
+    if (!types) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (loop = 0; loop < len; loop++) {
+        types[loop] = _pg_eventtype_from_seq(seq, loop);
+        if (types[loop] == -1) {
+            PyMem_Free(types);
+            Py_DECREF(seq);
+            return NULL;
+        }
+    }
+    Py_DECREF(seq);
+
+    /* the limits are changed in a copy, so that none change when there are
+     * too many of them */
+    SDL_AtomicLock(&_pg_rate_lock);
+    count = _pg_rate_limit_count;
+    memcpy(limits, _pg_rate_limits, sizeof(limits));
+    for (loop = 0; loop < len; loop++) {
+        for (i = 0; i < count; i++) {
+            if (limits[i].type == (Uint32)types[loop])
+                break;
+        }
+        if (rate == 0.0) {
+            /* no limit, move the last one in its place */
+            if (i < count)
+                limits[i] = limits[--count];
+        }
+        else if (i < PG_MAX_RATE_LIMITS) {
+            limits[i].type = types[loop];
+            limits[i].period = (Uint64)period;
+            limits[i].next = 0;
+            SDL_memset(&limits[i].last, 0, sizeof(SDL_Event));
+            if (i == count)
+                count++;
+        }
+        else {
+            break;
+        }
+    }
+    if (loop == len) {
+        memcpy(_pg_rate_limits, limits, sizeof(limits));
+        _pg_rate_limit_count = count;
+    }
+    SDL_AtomicUnlock(&_pg_rate_lock);
+    PyMem_Free(types);
+
+    if (loop < len)
+        return RAISE(pgExc_SDLError, "too many event types have a rate limit");
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_event_get_filter_stats(PyObject *self, PyObject *_null)
+{
+    return Py_BuildValue("(ii)", SDL_AtomicGet(&_pg_filter_merged),
+                         SDL_AtomicGet(&_pg_filter_dropped));
+}
+
 static PyObject *
 pg_event_custom_type(PyObject *self, PyObject *_null)
 {
@@ -2145,9 +3034,13 @@ static PyMethodDef _event_methods[] = {
      DOC_PYGAMEEVENTCLEAR},
     {"get", (PyCFunction)pg_event_get, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEEVENTGET},
+    {"get_into", (PyCFunction)pg_event_get_into, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEEVENTGETINTO},
     {"peek", (PyCFunction)pg_event_peek, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEEVENTPEEK},
     {"post", (PyCFunction)pg_event_post, METH_O, DOC_PYGAMEEVENTPOST},
+    {"post_payload", (PyCFunction)pg_event_post_payload,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEEVENTPOSTPAYLOAD},
 
     {"set_allowed", (PyCFunction)pg_event_set_allowed, METH_O,
      DOC_PYGAMEEVENTSETALLOWED},
@@ -2155,6 +3048,12 @@ static PyMethodDef _event_methods[] = {
      DOC_PYGAMEEVENTSETBLOCKED},
     {"get_blocked", (PyCFunction)pg_event_get_blocked, METH_O,
      DOC_PYGAMEEVENTGETBLOCKED},
+    {"set_coalesce", (PyCFunction)pg_event_set_coalesce,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEEVENTSETCOALESCE},
+    {"set_rate_limit", (PyCFunction)pg_event_set_rate_limit,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEEVENTSETRATELIMIT},
+    {"get_filter_stats", (PyCFunction)pg_event_get_filter_stats, METH_NOARGS,
+     DOC_PYGAMEEVENTGETFILTERSTATS},
     {"custom_type", (PyCFunction)pg_event_custom_type, METH_NOARGS,
      DOC_PYGAMEEVENTCUSTOMTYPE},
 
@@ -2217,13 +3116,14 @@ MODINIT_DEFINE(event)
     }
 
     /* export the c api */
-    assert(PYGAMEAPI_EVENT_NUMSLOTS == 6);
+    assert(PYGAMEAPI_EVENT_NUMSLOTS == 7);
     c_api[0] = &pgEvent_Type;
     c_api[1] = pgEvent_New;
     c_api[2] = pgEvent_New2;
     c_api[3] = pgEvent_FillUserEvent;
     c_api[4] = pg_EnableKeyRepeat;
     c_api[5] = pg_GetKeyRepeat;
+    c_api[6] = pgEvent_PostPayload;
 
     apiobj = encapsulate_api(c_api, "event");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
@@ -22,7 +22,6 @@
   from Pygame 2.
 
   TODO:
-  - fix filledPolygonRGBA to use MT versions for threaded use.
   - do a filled pie version using filledPieColor
   - Determine if SDL video must be initiated for all routines to work.
     Add check if required, else remove ASSERT_VIDEO_INIT.
@@ -38,11 +37,29 @@
 
 #include "pgcompat.h"
 
+
 #include "SDL_gfx/SDL_gfxPrimitives.h"
 
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+/* arm64 has neon optimisations enabled by default, even when fpu=neon is not
+ * passed */
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define GFX_SIMD
+#elif defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define GFX_SIMD
+#endif
+
 static PyObject *
 _gfx_pixelcolor(PyObject *self, PyObject *args);
 static PyObject *
+_gfx_pixelscolor(PyObject *self, PyObject *args);
+static PyObject *
 _gfx_hlinecolor(PyObject *self, PyObject *args);
 static PyObject *
 _gfx_vlinecolor(PyObject *self, PyObject *args);
@@ -51,6 +68,8 @@ _gfx_rectanglecolor(PyObject *self, PyObject *args);
 static PyObject *
 _gfx_boxcolor(PyObject *self, PyObject *args);
 static PyObject *
+_gfx_boxescolor(PyObject *self, PyObject *args);
+static PyObject *
 _gfx_linecolor(PyObject *self, PyObject *args);
 static PyObject *
 _gfx_circlecolor(PyObject *self, PyObject *args);
@@ -83,15 +102,19 @@ _gfx_filledpolygoncolor(PyObject *self, PyObject *args);
 static PyObject *
 _gfx_texturedpolygon(PyObject *self, PyObject *args);
 static PyObject *
+_gfx_texturedtriangles(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
 _gfx_beziercolor(PyObject *self, PyObject *args);
 
 static PyMethodDef _gfxdraw_methods[] = {
     {"pixel", _gfx_pixelcolor, METH_VARARGS, DOC_PYGAMEGFXDRAWPIXEL},
+    {"pixels", _gfx_pixelscolor, METH_VARARGS, DOC_PYGAMEGFXDRAWPIXELS},
     {"hline", _gfx_hlinecolor, METH_VARARGS, DOC_PYGAMEGFXDRAWHLINE},
     {"vline", _gfx_vlinecolor, METH_VARARGS, DOC_PYGAMEGFXDRAWVLINE},
     {"rectangle", _gfx_rectanglecolor, METH_VARARGS,
      DOC_PYGAMEGFXDRAWRECTANGLE},
     {"box", _gfx_boxcolor, METH_VARARGS, DOC_PYGAMEGFXDRAWRECTANGLE},
+    {"boxes", _gfx_boxescolor, METH_VARARGS, DOC_PYGAMEGFXDRAWBOXES},
     {"line", _gfx_linecolor, METH_VARARGS, DOC_PYGAMEGFXDRAWLINE},
     {"circle", _gfx_circlecolor, METH_VARARGS, DOC_PYGAMEGFXDRAWCIRCLE},
     {"arc", _gfx_arccolor, METH_VARARGS, DOC_PYGAMEGFXDRAWARC},
@@ -115,6 +138,8 @@ static PyMethodDef _gfxdraw_methods[] = {
      DOC_PYGAMEGFXDRAWFILLEDPOLYGON},
     {"textured_polygon", _gfx_texturedpolygon, METH_VARARGS,
      DOC_PYGAMEGFXDRAWTEXTUREDPOLYGON},
+    {"textured_triangles", (PyCFunction)_gfx_texturedtriangles,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEGFXDRAWTEXTUREDTRIANGLES},
     {"bezier", _gfx_beziercolor, METH_VARARGS, DOC_PYGAMEGFXDRAWBEZIER},
     {NULL, NULL, 0, NULL},
 };
@@ -153,6 +178,44 @@ Sint16FromSeqIndex(PyObject *obj, Py_ssize_t _index, Sint16 *val)
     return result;
 }
 
+/* Records the box from (x1, y1) to (x2, y2), inclusive and in any order, as
+ * drawn to on surfaces tracking damage. The primitives draw inside the
+ * surface's clip area, so the box is clipped to it. */
+static void
+_gfx_damage(PyObject *surface, int x1, int y1, int x2, int y2)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(surface);
+    SDL_Rect box, drawn;
+
+    if (!surf)
+        return;
+    box.x = MIN(x1, x2);
+    box.y = MIN(y1, y2);
+    box.w = MAX(x1, x2) - box.x + 1;
+    box.h = MAX(y1, y2) - box.y + 1;
+    if (SDL_IntersectRect(&box, &surf->clip_rect, &drawn))
+        pgSurface_AddDamage((pgSurfaceObject *)surface, &drawn);
+}
+
+/* Records the bounding box of the points, grown by margin pixels for
+ * antialiased edges, as drawn to on surfaces tracking damage. */
+static void
+_gfx_damage_points(PyObject *surface, const Sint16 *vx, const Sint16 *vy,
+                   Py_ssize_t count, int margin)
+{
+    int minx = vx[0], maxx = vx[0], miny = vy[0], maxy = vy[0];
+    Py_ssize_t i;
+
+    for (i = 1; i < count; i++) {
+        minx = MIN(minx, vx[i]);
+        maxx = MAX(maxx, vx[i]);
+        miny = MIN(miny, vy[i]);
+        maxy = MAX(maxy, vy[i]);
+    }
+    _gfx_damage(surface, minx - margin, miny - margin, maxx + margin,
+                maxy + margin);
+}
+
 static PyObject *
 _gfx_pixelcolor(PyObject *self, PyObject *args)
 {
@@ -179,6 +242,84 @@ _gfx_pixelcolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x, y, x, y);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_gfx_pixelscolor(PyObject *self, PyObject *args)
+{
+    PyObject *surface, *color, *points, *item;
+    Sint16 *vx, *vy, x, y;
+    Py_ssize_t count, i;
+    int ret;
+    Uint8 rgba[4];
+
+    ASSERT_VIDEO_INIT(NULL);
+
+    if (!PyArg_ParseTuple(args, "OOO:pixels", &surface, &points, &color))
+        return NULL;
+
+    if (!pgSurface_Check(surface)) {
+        PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
+        return NULL;
+    }
+    if (!pg_RGBAFromObj(color, rgba)) {
+        PyErr_SetString(PyExc_TypeError, "invalid color argument");
+        return NULL;
+    }
+    if (!PySequence_Check(points)) {
+        PyErr_SetString(PyExc_TypeError, "points must be a sequence");
+        return NULL;
+    }
+
+    count = PySequence_Size(points);
+    if (count < 0)
+        return NULL;
+    if (count == 0)
+        Py_RETURN_NONE;
+
+    vx = PyMem_New(Sint16, (size_t)count);
+    vy = PyMem_New(Sint16, (size_t)count);
+    if (!vx || !vy) {
+        if (vx)
+            PyMem_Free(vx);
+        if (vy)
+            PyMem_Free(vy);
+        return PyErr_NoMemory();
+    }
+
+    for (i = 0; i < count; i++) {
+        item = PySequence_ITEM(points, i);
+        if (!item || !Sint16FromSeqIndex(item, 0, &x) ||
+            !Sint16FromSeqIndex(item, 1, &y)) {
+            PyMem_Free(vx);
+            PyMem_Free(vy);
+            Py_XDECREF(item);
+            PyErr_SetString(PyExc_TypeError,
+                            "points must be a sequence of pairs of numbers");
+            return NULL;
+        }
+        Py_DECREF(item);
+        vx[i] = x;
+        vy[i] = y;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    ret = pixelsColor(pgSurface_AsSurface(surface), vx, vy, (int)count,
+                      ((Uint32)rgba[0] << 24) | ((Uint32)rgba[1] << 16) |
+                          ((Uint32)rgba[2] << 8) | rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret != -1)
+        _gfx_damage_points(surface, vx, vy, count, 0);
+    PyMem_Free(vx);
+    PyMem_Free(vy);
+
+    if (ret == -1) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return NULL;
+    }
     Py_RETURN_NONE;
 }
 
@@ -208,6 +349,7 @@ _gfx_hlinecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x1, y, x2, y);
     Py_RETURN_NONE;
 }
 
@@ -238,6 +380,7 @@ _gfx_vlinecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x, _y1, x, y2);
     Py_RETURN_NONE;
 }
 
@@ -281,6 +424,7 @@ _gfx_rectanglecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x1, _y1, x2, y2);
     Py_RETURN_NONE;
 }
 
@@ -323,6 +467,81 @@ _gfx_boxcolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x1, _y1, x2, y2);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_gfx_boxescolor(PyObject *self, PyObject *args)
+{
+    PyObject *surface, *color, *rects, *item;
+    SDL_Rect temprect, *sdlrect, *boxes;
+    Py_ssize_t count, i;
+    int ret;
+    Uint8 rgba[4];
+
+    ASSERT_VIDEO_INIT(NULL);
+
+    if (!PyArg_ParseTuple(args, "OOO:boxes", &surface, &rects, &color))
+        return NULL;
+
+    if (!pgSurface_Check(surface)) {
+        PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
+        return NULL;
+    }
+    if (!pg_RGBAFromObj(color, rgba)) {
+        PyErr_SetString(PyExc_TypeError, "invalid color argument");
+        return NULL;
+    }
+    if (!PySequence_Check(rects)) {
+        PyErr_SetString(PyExc_TypeError, "rects must be a sequence");
+        return NULL;
+    }
+
+    count = PySequence_Size(rects);
+    if (count < 0)
+        return NULL;
+    if (count == 0)
+        Py_RETURN_NONE;
+
+    boxes = PyMem_New(SDL_Rect, (size_t)count);
+    if (!boxes)
+        return PyErr_NoMemory();
+
+    for (i = 0; i < count; i++) {
+        item = PySequence_ITEM(rects, i);
+        sdlrect = item ? pgRect_FromObject(item, &temprect) : NULL;
+        if (sdlrect == NULL) {
+            PyMem_Free(boxes);
+            Py_XDECREF(item);
+            PyErr_SetString(PyExc_TypeError, "invalid rect style argument");
+            return NULL;
+        }
+        boxes[i] = *sdlrect;
+        Py_DECREF(item);
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    ret = boxesColor(pgSurface_AsSurface(surface), boxes, (int)count,
+                     ((Uint32)rgba[0] << 24) | ((Uint32)rgba[1] << 16) |
+                         ((Uint32)rgba[2] << 8) | rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret != -1) {
+        for (i = 0; i < count; i++) {
+            if (boxes[i].w <= 0 || boxes[i].h <= 0)
+                continue;
+            _gfx_damage(surface, boxes[i].x, boxes[i].y,
+                        boxes[i].x + boxes[i].w - 1,
+                        boxes[i].y + boxes[i].h - 1);
+        }
+    }
+    PyMem_Free(boxes);
+
+    if (ret == -1) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return NULL;
+    }
     Py_RETURN_NONE;
 }
 
@@ -353,6 +572,7 @@ _gfx_linecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x1, _y1, x2, y2);
     Py_RETURN_NONE;
 }
 
@@ -382,6 +602,7 @@ _gfx_circlecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -412,6 +633,7 @@ _gfx_arccolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -442,6 +664,7 @@ _gfx_aacirclecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x - r - 1, y - r - 1, x + r + 1, y + r + 1);
     Py_RETURN_NONE;
 }
 
@@ -472,6 +695,7 @@ _gfx_filledcirclecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -502,6 +726,7 @@ _gfx_ellipsecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x - rx, y - ry, x + rx, y + ry);
     Py_RETURN_NONE;
 }
 
@@ -532,6 +757,7 @@ _gfx_aaellipsecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x - rx - 1, y - ry - 1, x + rx + 1, y + ry + 1);
     Py_RETURN_NONE;
 }
 
@@ -562,6 +788,7 @@ _gfx_filledellipsecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x - rx, y - ry, x + rx, y + ry);
     Py_RETURN_NONE;
 }
 
@@ -592,6 +819,7 @@ _gfx_piecolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, x - r, y - r, x + r, y + r);
     Py_RETURN_NONE;
 }
 
@@ -622,6 +850,8 @@ _gfx_trigoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, MIN(x1, MIN(x2, x3)), MIN(_y1, MIN(y2, y3)),
+                MAX(x1, MAX(x2, x3)), MAX(_y1, MAX(y2, y3)));
     Py_RETURN_NONE;
 }
 
@@ -652,6 +882,9 @@ _gfx_aatrigoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, MIN(x1, MIN(x2, x3)) - 1,
+                MIN(_y1, MIN(y2, y3)) - 1, MAX(x1, MAX(x2, x3)) + 1,
+                MAX(_y1, MAX(y2, y3)) + 1);
     Py_RETURN_NONE;
 }
 
@@ -682,6 +915,8 @@ _gfx_filledtrigoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
+    _gfx_damage(surface, MIN(x1, MIN(x2, x3)), MIN(_y1, MIN(y2, y3)),
+                MAX(x1, MAX(x2, x3)), MAX(_y1, MAX(y2, y3)));
     Py_RETURN_NONE;
 }
 
@@ -753,6 +988,8 @@ _gfx_polygoncolor(PyObject *self, PyObject *args)
                       rgba[0], rgba[1], rgba[2], rgba[3]);
     Py_END_ALLOW_THREADS;
 
+    if (ret != -1)
+        _gfx_damage_points(surface, vx, vy, count, 0);
     PyMem_Free(vx);
     PyMem_Free(vy);
 
@@ -831,6 +1068,8 @@ _gfx_aapolygoncolor(PyObject *self, PyObject *args)
                         rgba[0], rgba[1], rgba[2], rgba[3]);
     Py_END_ALLOW_THREADS;
 
+    if (ret != -1)
+        _gfx_damage_points(surface, vx, vy, count, 1);
     PyMem_Free(vx);
     PyMem_Free(vy);
 
@@ -841,6 +1080,86 @@ _gfx_aapolygoncolor(PyObject *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+/* Filled polygons covering more than GFX_PARALLEL_MIN_PIXELS pixels of the
+ * clip area are drawn in bands of rows, one thread per band. No band is
+ * given fewer than GFX_BAND_MIN_PIXELS pixels. */
+#define GFX_PARALLEL_MIN_PIXELS 0x40000
+#define GFX_BAND_MIN_PIXELS 0x10000
+
+typedef struct {
+    SDL_Surface *surf;
+    const Sint16 *vx, *vy;
+    int n;
+    Uint32 color;
+    int *polyints; /* n ints for each band */
+    int top, rows, bands;
+    int results[PG_PARALLEL_MAX_THREADS];
+} _gfx_polygon_bands;
+
+/* Sets up the bands to fill a polygon in, clipped to the surface's clip
+ * area. Returns 0 when nothing is to be drawn. */
+static int
+_gfx_polygon_bands_init(_gfx_polygon_bands *poly, SDL_Surface *surf,
+                        const Sint16 *vx, const Sint16 *vy, int n)
+{
+    SDL_Rect *clip = &surf->clip_rect;
+    Sint64 area;
+    int i, minx, maxx, miny, maxy;
+
+    minx = maxx = vx[0];
+    miny = maxy = vy[0];
+    for (i = 1; i < n; i++) {
+        minx = MIN(minx, vx[i]);
+        maxx = MAX(maxx, vx[i]);
+        miny = MIN(miny, vy[i]);
+        maxy = MAX(maxy, vy[i]);
+    }
+
+    minx = MAX(minx, clip->x);
+    maxx = MIN(maxx, clip->x + clip->w - 1);
+    miny = MAX(miny, clip->y);
+    maxy = MIN(maxy, clip->y + clip->h - 1);
+    if (maxx < minx || maxy < miny) {
+        return 0;
+    }
+
+    poly->surf = surf;
+    poly->vx = vx;
+    poly->vy = vy;
+    poly->n = n;
+    poly->top = miny;
+    poly->rows = maxy - miny + 1;
+    poly->bands = 1;
+
+    /* hlineColor() locks surfaces that need it once per row, which can't be
+     * done from several threads. */
+    area = (Sint64)poly->rows * (maxx - minx + 1);
+    if (area >= GFX_PARALLEL_MIN_PIXELS && !SDL_MUSTLOCK(surf)) {
+        poly->bands = (int)MIN(MIN(area / GFX_BAND_MIN_PIXELS, poly->rows),
+                               MIN(SDL_GetCPUCount(), PG_PARALLEL_MAX_THREADS));
+        poly->bands = MAX(poly->bands, 1);
+    }
+    return 1;
+}
+
+static void
+_gfx_polygon_bands_fill(void *data, int start, int end)
+{
+    _gfx_polygon_bands *poly = (_gfx_polygon_bands *)data;
+    int band;
+
+    for (band = start; band < end; band++) {
+        int ystart = poly->top +
+                     (int)((Sint64)poly->rows * band / poly->bands);
+        int yend = poly->top +
+                   (int)((Sint64)poly->rows * (band + 1) / poly->bands) - 1;
+
+        poly->results[band] = filledPolygonRowsColorMT(
+            poly->surf, poly->vx, poly->vy, poly->n, poly->color,
+            poly->polyints + (Py_ssize_t)band * poly->n, ystart, yend);
+    }
+}
+
 static PyObject *
 _gfx_filledpolygoncolor(PyObject *self, PyObject *args)
 {
@@ -849,6 +1168,7 @@ _gfx_filledpolygoncolor(PyObject *self, PyObject *args)
     Py_ssize_t count, i;
     int ret;
     Uint8 rgba[4];
+    _gfx_polygon_bands poly;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -905,11 +1225,36 @@ _gfx_filledpolygoncolor(PyObject *self, PyObject *args)
         vy[i] = y;
     }
 
+    if (!_gfx_polygon_bands_init(&poly, pgSurface_AsSurface(surface), vx, vy,
+                                 (int)count)) {
+        PyMem_Free(vx);
+        PyMem_Free(vy);
+        Py_RETURN_NONE;
+    }
+
+    /* Each band gets its own array, rather than the global one
+     * filledPolygonRGBA() uses, so the GIL can be released safely. */
+    poly.polyints = PyMem_New(int, (size_t)poly.bands * count);
+    if (!poly.polyints) {
+        PyMem_Free(vx);
+        PyMem_Free(vy);
+        return PyErr_NoMemory();
+    }
+    poly.color = ((Uint32)rgba[0] << 24) | ((Uint32)rgba[1] << 16) |
+                 ((Uint32)rgba[2] << 8) | (Uint32)rgba[3];
+
     Py_BEGIN_ALLOW_THREADS;
-    ret = filledPolygonRGBA(pgSurface_AsSurface(surface), vx, vy, (int)count,
-                            rgba[0], rgba[1], rgba[2], rgba[3]);
+    pg_parallel_for(poly.bands, 1, _gfx_polygon_bands_fill, &poly);
     Py_END_ALLOW_THREADS;
 
+    ret = 0;
+    for (i = 0; i < poly.bands; i++) {
+        ret |= poly.results[i];
+    }
+
+    PyMem_Free(poly.polyints);
+    if (ret != -1)
+        _gfx_damage_points(surface, vx, vy, count, 0);
     PyMem_Free(vx);
     PyMem_Free(vy);
 
@@ -997,6 +1342,8 @@ _gfx_texturedpolygon(PyObject *self, PyObject *args)
     ret = texturedPolygon(s_surface, vx, vy, (int)count, s_texture, tdx, tdy);
     Py_END_ALLOW_THREADS;
 
+    if (ret != -1)
+        _gfx_damage_points(surface, vx, vy, count, 0);
     PyMem_Free(vx);
     PyMem_Free(vy);
 
@@ -1007,6 +1354,904 @@ _gfx_texturedpolygon(PyObject *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+/* Textured triangles are drawn in bands of rows like filled polygons, each
+ * band drawing its part of every triangle in order. */
+
+/* The values interpolated across a triangle, all multiplied by q = 1 / w so
+ * they are linear in screen space: q, u, v and the color's r, g, b, a. */
+#define GFX_MESH_ATTRS 7
+
+/* Texture coordinates are kept within this distance of 0. */
+#define GFX_MESH_MAX_COORD 16777216.0f
+
+typedef struct {
+    float x, y, q, u, v;
+    float color[4];
+} _gfx_mesh_vertex;
+
+typedef struct {
+    float x[3], y[3]; /* sorted by y, then x */
+    int long_left;    /* Set when the edge from x[0] to x[2] is the left. */
+    int ystart, yend; /* the rows whose centers it covers, clipped */
+    /* The attributes at the first vertex, and how they change along x and
+     * along y. */
+    float attrs[GFX_MESH_ATTRS], dx[GFX_MESH_ATTRS], dy[GFX_MESH_ATTRS];
+} _gfx_mesh_triangle;
+
+typedef struct {
+    SDL_Surface *surf;
+    const Uint8 *texels;
+    int tpitch, tw, th;
+    int tshifts[4]; /* shifts of the texels' r, g, b, a, -1 for no alpha */
+    _gfx_mesh_triangle *triangles;
+    Py_ssize_t n_triangles;
+    int smooth, colored;
+    int top, rows, bands;
+} _gfx_mesh;
+
+/* What is worked out for 4 pixels of a span at once: the texel columns and
+ * rows to sample, the weights of the second ones out of 256 when smooth,
+ * and the color each texel is multiplied by. */
+typedef struct {
+    int u0[4], v0[4], u1[4], v1[4];
+    int wu[4], wv[4];
+    int color[4][4]; /* by channel, then pixel */
+} _gfx_mesh_lanes;
+
+/* Where the edge from (xa, ya) down to (xb, yb) crosses the row center yc.
+ * Triangles sharing an edge work it out the same way, so they neither
+ * overlap nor leave gaps. */
+static PG_INLINE float
+_gfx_mesh_edge_x(float xa, float ya, float xb, float yb, float yc)
+{
+    return xa + (yc - ya) * ((xb - xa) / (yb - ya));
+}
+
+/* Sets up a triangle for drawing within clip. Returns 0 when it covers no
+ * pixel centers there. */
+static int
+_gfx_mesh_setup(_gfx_mesh_triangle *tri, const _gfx_mesh_vertex *a,
+                const _gfx_mesh_vertex *b, const _gfx_mesh_vertex *c,
+                int colored, const SDL_Rect *clip)
+{
+    const _gfx_mesh_vertex *v[3] = {a, b, c}, *t;
+    float attrs[3][GFX_MESH_ATTRS], area, d1, d2;
+    float e1x, e1y, e2x, e2y, top, bottom;
+    int i, j, n = colored ? GFX_MESH_ATTRS : 3;
+
+    /* Sort the vertices by y, then x. */
+    for (i = 1; i < 3; i++) {
+        for (j = i; j > 0; j--) {
+            if (v[j - 1]->y < v[j]->y ||
+                (v[j - 1]->y == v[j]->y && v[j - 1]->x <= v[j]->x)) {
+                break;
+            }
+            t = v[j], v[j] = v[j - 1], v[j - 1] = t;
+        }
+    }
+
+    e1x = v[1]->x - v[0]->x;
+    e1y = v[1]->y - v[0]->y;
+    e2x = v[2]->x - v[0]->x;
+    e2y = v[2]->y - v[0]->y;
+    area = e1x * e2y - e2x * e1y;
+    if (area == 0.0f || !isfinite(area)) {
+        return 0;
+    }
+
+    /* Rows whose centers are within [y0, y2). */
+    top = MAX(ceilf(v[0]->y - 0.5f), (float)clip->y);
+    bottom = MIN(ceilf(v[2]->y - 0.5f), (float)(clip->y + clip->h));
+    if (top >= bottom) {
+        return 0;
+    }
+    tri->ystart = (int)top;
+    tri->yend = (int)bottom - 1;
+    tri->long_left = area > 0;
+
+    for (i = 0; i < 3; i++) {
+        tri->x[i] = v[i]->x;
+        tri->y[i] = v[i]->y;
+        attrs[i][0] = v[i]->q;
+        attrs[i][1] = v[i]->u * v[i]->q;
+        attrs[i][2] = v[i]->v * v[i]->q;
+        for (j = 3; j < n; j++) {
+            attrs[i][j] = v[i]->color[j - 3] * v[i]->q;
+        }
+    }
+
+    for (j = 0; j < n; j++) {
+        d1 = attrs[1][j] - attrs[0][j];
+        d2 = attrs[2][j] - attrs[0][j];
+        tri->attrs[j] = attrs[0][j];
+        tri->dx[j] = (d1 * e2y - d2 * e1y) / area;
+        tri->dy[j] = (d2 * e1x - d1 * e2x) / area;
+    }
+    return 1;
+}
+
+/* Wraps a texture coordinate, already a whole number when smooth, into
+ * 0 to size - 1. */
+static PG_INLINE int
+_gfx_mesh_wrap(float t, float size, float inv_size)
+{
+    t -= size * floorf(t * inv_size);
+    return (int)MIN(MAX(t, 0.0f), size - 1.0f);
+}
+
+/* Works out the lanes for the pixels first to first + 3 of a span, from
+ * the attributes at its first pixel. */
+static void
+_gfx_mesh_lanes_scalar(const _gfx_mesh *mesh, const _gfx_mesh_triangle *tri,
+                       const float *row, int first,
+                       _gfx_mesh_lanes *lanes)
+{
+    float tw = (float)mesh->tw, th = (float)mesh->th;
+    float inv_tw = 1.0f / tw, inv_th = 1.0f / th;
+    float fi, w, u, v, fu, fv, value;
+    int i, j;
+
+    for (i = 0; i < 4; i++) {
+        fi = (float)(first + i);
+        w = 1.0f / (row[0] + tri->dx[0] * fi);
+        u = (row[1] + tri->dx[1] * fi) * w;
+        v = (row[2] + tri->dx[2] * fi) * w;
+        u = MIN(MAX(u, -GFX_MESH_MAX_COORD), GFX_MESH_MAX_COORD);
+        v = MIN(MAX(v, -GFX_MESH_MAX_COORD), GFX_MESH_MAX_COORD);
+
+        if (mesh->smooth) {
+            /* The four texels whose centers surround (u, v). */
+            u -= 0.5f;
+            v -= 0.5f;
+            fu = floorf(u);
+            fv = floorf(v);
+            lanes->wu[i] = (int)((u - fu) * 256.0f + 0.5f);
+            lanes->wv[i] = (int)((v - fv) * 256.0f + 0.5f);
+            lanes->u0[i] = _gfx_mesh_wrap(fu, tw, inv_tw);
+            lanes->v0[i] = _gfx_mesh_wrap(fv, th, inv_th);
+            lanes->u1[i] = _gfx_mesh_wrap(fu + 1.0f, tw, inv_tw);
+            lanes->v1[i] = _gfx_mesh_wrap(fv + 1.0f, th, inv_th);
+        }
+        else {
+            lanes->u0[i] = _gfx_mesh_wrap(u, tw, inv_tw);
+            lanes->v0[i] = _gfx_mesh_wrap(v, th, inv_th);
+        }
+
+        if (mesh->colored) {
+            for (j = 0; j < 4; j++) {
+                value = (row[3 + j] + tri->dx[3 + j] * fi) * w;
+                lanes->color[j][i] =
+                    (int)(MIN(MAX(value, 0.0f), 255.0f) + 0.5f);
+            }
+        }
+    }
+}
+
+#ifdef GFX_SIMD
+/* floorf() of 4 floats within the range of an int. */
+static PG_INLINE __m128
+_gfx_mesh_floor_ps(__m128 x)
+{
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.0f)));
+}
+
+static PG_INLINE __m128i
+_gfx_mesh_wrap_ps(__m128 t, __m128 size, __m128 inv_size)
+{
+    t = _mm_sub_ps(t, _mm_mul_ps(size, _gfx_mesh_floor_ps(
+                                           _mm_mul_ps(t, inv_size))));
+    t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()),
+                   _mm_sub_ps(size, _mm_set1_ps(1.0f)));
+    return _mm_cvttps_epi32(t);
+}
+
+/* The same as _gfx_mesh_lanes_scalar(), 4 pixels at a time, giving the
+ * same results. */
+static void
+_gfx_mesh_lanes_simd(const _gfx_mesh *mesh, const _gfx_mesh_triangle *tri,
+                     const float *row, int first, _gfx_mesh_lanes *lanes)
+{
+    __m128 tw = _mm_set1_ps((float)mesh->tw);
+    __m128 th = _mm_set1_ps((float)mesh->th);
+    __m128 inv_tw = _mm_set1_ps(1.0f / (float)mesh->tw);
+    __m128 inv_th = _mm_set1_ps(1.0f / (float)mesh->th);
+    __m128 lo = _mm_set1_ps(-GFX_MESH_MAX_COORD);
+    __m128 hi = _mm_set1_ps(GFX_MESH_MAX_COORD);
+    __m128 half = _mm_set1_ps(0.5f), one = _mm_set1_ps(1.0f);
+    __m128 fi, w, u, v, fu, fv, value;
+    int j;
+
+    fi = _mm_cvtepi32_ps(
+        _mm_add_epi32(_mm_set1_epi32(first), _mm_set_epi32(3, 2, 1, 0)));
+    w = _mm_div_ps(one, _mm_add_ps(_mm_set1_ps(row[0]),
+                                   _mm_mul_ps(_mm_set1_ps(tri->dx[0]), fi)));
+    u = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(row[1]),
+                              _mm_mul_ps(_mm_set1_ps(tri->dx[1]), fi)),
+                   w);
+    v = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(row[2]),
+                              _mm_mul_ps(_mm_set1_ps(tri->dx[2]), fi)),
+                   w);
+    u = _mm_min_ps(_mm_max_ps(u, lo), hi);
+    v = _mm_min_ps(_mm_max_ps(v, lo), hi);
+
+    if (mesh->smooth) {
+        __m128 scale = _mm_set1_ps(256.0f);
+
+        u = _mm_sub_ps(u, half);
+        v = _mm_sub_ps(v, half);
+        fu = _gfx_mesh_floor_ps(u);
+        fv = _gfx_mesh_floor_ps(v);
+        _mm_storeu_si128((__m128i *)lanes->wu,
+                         _mm_cvttps_epi32(_mm_add_ps(
+                             _mm_mul_ps(_mm_sub_ps(u, fu), scale), half)));
+        _mm_storeu_si128((__m128i *)lanes->wv,
+                         _mm_cvttps_epi32(_mm_add_ps(
+                             _mm_mul_ps(_mm_sub_ps(v, fv), scale), half)));
+        _mm_storeu_si128((__m128i *)lanes->u0,
+                         _gfx_mesh_wrap_ps(fu, tw, inv_tw));
+        _mm_storeu_si128((__m128i *)lanes->v0,
+                         _gfx_mesh_wrap_ps(fv, th, inv_th));
+        _mm_storeu_si128((__m128i *)lanes->u1,
+                         _gfx_mesh_wrap_ps(_mm_add_ps(fu, one), tw, inv_tw));
+        _mm_storeu_si128((__m128i *)lanes->v1,
+                         _gfx_mesh_wrap_ps(_mm_add_ps(fv, one), th, inv_th));
+    }
+    else {
+        _mm_storeu_si128((__m128i *)lanes->u0,
+                         _gfx_mesh_wrap_ps(u, tw, inv_tw));
+        _mm_storeu_si128((__m128i *)lanes->v0,
+                         _gfx_mesh_wrap_ps(v, th, inv_th));
+    }
+
+    if (mesh->colored) {
+        __m128 cmax = _mm_set1_ps(255.0f);
+
+        for (j = 0; j < 4; j++) {
+            value = _mm_mul_ps(
+                _mm_add_ps(_mm_set1_ps(row[3 + j]),
+                           _mm_mul_ps(_mm_set1_ps(tri->dx[3 + j]), fi)),
+                w);
+            value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), cmax);
+            _mm_storeu_si128((__m128i *)lanes->color[j],
+                             _mm_cvttps_epi32(_mm_add_ps(value, half)));
+        }
+    }
+}
+#endif /* GFX_SIMD */
+
+/* The r, g, b, a of a texel. */
+static PG_INLINE void
+_gfx_mesh_texel(const _gfx_mesh *mesh, int u, int v, Uint32 *rgba)
+{
+    Uint32 texel = *(const Uint32 *)(mesh->texels + v * mesh->tpitch + u * 4);
+
+    rgba[0] = (texel >> mesh->tshifts[0]) & 0xff;
+    rgba[1] = (texel >> mesh->tshifts[1]) & 0xff;
+    rgba[2] = (texel >> mesh->tshifts[2]) & 0xff;
+    rgba[3] = mesh->tshifts[3] < 0 ? 255 : (texel >> mesh->tshifts[3]) & 0xff;
+}
+
+/* Blends the color rgba over a pixel of the surface, the same way as
+ * pygame.draw's antialiased functions. */
+static void
+_gfx_mesh_put(SDL_Surface *surf, Uint8 *pixel, const Uint32 *rgba)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint32 value = 0, alpha = rgba[3], inverse = 255 - alpha;
+    Uint8 r, g, b, a;
+
+    if (format->BytesPerPixel == 4 && !format->Rloss && !format->Gloss &&
+        !format->Bloss) {
+        /* 8 bits per channel: blend without mapping. */
+        if (alpha == 255) {
+            value = rgba[0] << format->Rshift | rgba[1] << format->Gshift |
+                    rgba[2] << format->Bshift;
+            if (format->Amask) {
+                value |= (Uint32)255 << format->Ashift;
+            }
+            *(Uint32 *)pixel = value;
+            return;
+        }
+        value = *(Uint32 *)pixel;
+        r = (Uint8)(value >> format->Rshift);
+        g = (Uint8)(value >> format->Gshift);
+        b = (Uint8)(value >> format->Bshift);
+        value = ((rgba[0] * alpha + r * inverse + 127) / 255)
+                    << format->Rshift |
+                ((rgba[1] * alpha + g * inverse + 127) / 255)
+                    << format->Gshift |
+                ((rgba[2] * alpha + b * inverse + 127) / 255)
+                    << format->Bshift;
+        if (format->Amask) {
+            a = (Uint8)(*(Uint32 *)pixel >> format->Ashift);
+            value |= (alpha + (a * inverse + 127) / 255) << format->Ashift;
+        }
+        *(Uint32 *)pixel = value;
+        return;
+    }
+
+    switch (format->BytesPerPixel) {
+        case 1:
+            value = *pixel;
+            break;
+        case 2:
+            value = *(Uint16 *)pixel;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            value = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16);
+#else
+            value = (pixel[0] << 16) | (pixel[1] << 8) | pixel[2];
+#endif
+            break;
+        default: /*case 4*/
+            value = *(Uint32 *)pixel;
+            break;
+    }
+
+    SDL_GetRGBA(value, format, &r, &g, &b, &a);
+    r = (Uint8)((rgba[0] * alpha + r * inverse + 127) / 255);
+    g = (Uint8)((rgba[1] * alpha + g * inverse + 127) / 255);
+    b = (Uint8)((rgba[2] * alpha + b * inverse + 127) / 255);
+    a = (Uint8)(alpha + (a * inverse + 127) / 255);
+    value = SDL_MapRGBA(format, r, g, b, a);
+
+    switch (format->BytesPerPixel) {
+        case 1:
+            *pixel = (Uint8)value;
+            break;
+        case 2:
+            *(Uint16 *)pixel = (Uint16)value;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            value <<= 8;
+#endif
+            memcpy(pixel, &value, 3 * sizeof(Uint8));
+            break;
+        default: /*case 4*/
+            *(Uint32 *)pixel = value;
+            break;
+    }
+}
+
+/* Draws the pixels x1 to x2 of row y of a triangle. */
+static void
+_gfx_mesh_span(const _gfx_mesh *mesh, const _gfx_mesh_triangle *tri, int y,
+               int x1, int x2)
+{
+    SDL_Surface *surf = mesh->surf;
+    int bpp = surf->format->BytesPerPixel;
+    Uint8 *pixel = (Uint8 *)surf->pixels + y * surf->pitch + x1 * bpp;
+    float row[GFX_MESH_ATTRS];
+    float yc = (float)y + 0.5f - tri->y[0], xc = (float)x1 + 0.5f - tri->x[0];
+    int n = mesh->colored ? GFX_MESH_ATTRS : 3;
+    int x, i, j, lanes_n;
+    Uint32 rgba[4], t00[4], t10[4], t01[4], t11[4];
+    _gfx_mesh_lanes lanes;
+
+    for (j = 0; j < n; j++) {
+        row[j] = tri->attrs[j] + tri->dy[j] * yc + tri->dx[j] * xc;
+    }
+
+    for (x = x1; x <= x2; x += 4) {
+        lanes_n = MIN(4, x2 - x + 1);
+#ifdef GFX_SIMD
+        _gfx_mesh_lanes_simd(mesh, tri, row, x - x1, &lanes);
+#else
+        _gfx_mesh_lanes_scalar(mesh, tri, row, x - x1, &lanes);
+#endif
+
+        for (i = 0; i < lanes_n; i++, pixel += bpp) {
+            if (mesh->smooth) {
+                Uint32 wu = lanes.wu[i], wv = lanes.wv[i];
+
+                _gfx_mesh_texel(mesh, lanes.u0[i], lanes.v0[i], t00);
+                _gfx_mesh_texel(mesh, lanes.u1[i], lanes.v0[i], t10);
+                _gfx_mesh_texel(mesh, lanes.u0[i], lanes.v1[i], t01);
+                _gfx_mesh_texel(mesh, lanes.u1[i], lanes.v1[i], t11);
+                for (j = 0; j < 4; j++) {
+                    rgba[j] = (((t00[j] * (256 - wu) + t10[j] * wu) *
+                                    (256 - wv) +
+                                (t01[j] * (256 - wu) + t11[j] * wu) * wv +
+                                32768) >>
+                               16);
+                }
+            }
+            else {
+                _gfx_mesh_texel(mesh, lanes.u0[i], lanes.v0[i], rgba);
+            }
+
+            if (mesh->colored) {
+                for (j = 0; j < 4; j++) {
+                    rgba[j] = (rgba[j] * lanes.color[j][i] + 127) / 255;
+                }
+            }
+
+            if (rgba[3]) {
+                _gfx_mesh_put(surf, pixel, rgba);
+            }
+        }
+    }
+}
+
+/* Draws the rows ystart to yend of every triangle, in order. */
+static void
+_gfx_mesh_rows(const _gfx_mesh *mesh, int ystart, int yend)
+{
+    const _gfx_mesh_triangle *tri;
+    SDL_Rect *clip = &mesh->surf->clip_rect;
+    float yc, xa, xb, xl, xr, left, right;
+    Py_ssize_t t;
+    int y, y1, y2;
+
+    for (t = 0; t < mesh->n_triangles; t++) {
+        tri = mesh->triangles + t;
+        y1 = MAX(tri->ystart, ystart);
+        y2 = MIN(tri->yend, yend);
+
+        for (y = y1; y <= y2; y++) {
+            yc = (float)y + 0.5f;
+            xa = _gfx_mesh_edge_x(tri->x[0], tri->y[0], tri->x[2], tri->y[2],
+                                  yc);
+            if (yc < tri->y[1]) {
+                xb = _gfx_mesh_edge_x(tri->x[0], tri->y[0], tri->x[1],
+                                      tri->y[1], yc);
+            }
+            else {
+                xb = _gfx_mesh_edge_x(tri->x[1], tri->y[1], tri->x[2],
+                                      tri->y[2], yc);
+            }
+            xl = tri->long_left ? xa : xb;
+            xr = tri->long_left ? xb : xa;
+
+            /* Pixels whose centers are within [xl, xr). */
+            left = MAX(ceilf(xl - 0.5f), (float)clip->x);
+            right = MIN(ceilf(xr - 0.5f), (float)(clip->x + clip->w));
+            if (left < right) {
+                _gfx_mesh_span(mesh, tri, y, (int)left, (int)right - 1);
+            }
+        }
+    }
+}
+
+static void
+_gfx_mesh_bands(void *data, int start, int end)
+{
+    _gfx_mesh *mesh = (_gfx_mesh *)data;
+    int band;
+
+    for (band = start; band < end; band++) {
+        _gfx_mesh_rows(
+            mesh,
+            mesh->top + (int)((Sint64)mesh->rows * band / mesh->bands),
+            mesh->top +
+                (int)((Sint64)mesh->rows * (band + 1) / mesh->bands) - 1);
+    }
+}
+
+/* Loads a sequence of items of min_k to max_k numbers, or a buffer of
+ * floats or doubles shaped (n, k) or flat with min_k values an item, into a
+ * new array of max_k floats an item, to be freed with PyMem_Free(). Missing
+ * values are set to fill.
+ *
+ * Returns the number of items, or -1 with an exception set.
+ */
+static Py_ssize_t
+_gfx_mesh_floats_from_obj(PyObject *obj, const char *name, int min_k,
+                          int max_k, float fill, float **values)
+{
+    Py_buffer view;
+    PyObject *seq, *item, *itemseq;
+    Py_ssize_t n, k, i, j;
+    const char *format;
+    float *out;
+    double value;
+
+    if (PyObject_CheckBuffer(obj) &&
+        !PyObject_GetBuffer(obj, &view, PyBUF_FORMAT | PyBUF_STRIDES)) {
+        format = view.format;
+        if (*format == '@' || *format == '=') {
+            format++;
+        }
+        if ((!strcmp(format, "f") || !strcmp(format, "d")) &&
+            (view.ndim == 1 || view.ndim == 2)) {
+            k = (view.ndim == 2) ? view.shape[1] : min_k;
+            n = (view.ndim == 2) ? view.shape[0] : view.shape[0] / min_k;
+            if (k < min_k || k > max_k ||
+                (view.ndim == 1 && view.shape[0] % min_k)) {
+                PyBuffer_Release(&view);
+                PyErr_Format(PyExc_ValueError,
+                             "%s buffer must hold %d to %d values an item",
+                             name, min_k, max_k);
+                return -1;
+            }
+            out = PyMem_New(float, (size_t)MAX(n, 1) * max_k);
+            if (!out) {
+                PyBuffer_Release(&view);
+                PyErr_NoMemory();
+                return -1;
+            }
+            for (i = 0; i < n; i++) {
+                for (j = 0; j < max_k; j++) {
+                    const char *p;
+
+                    if (j >= k) {
+                        out[i * max_k + j] = fill;
+                        continue;
+                    }
+                    if (view.ndim == 2) {
+                        p = (const char *)view.buf + i * view.strides[0] +
+                            j * view.strides[1];
+                    }
+                    else {
+                        p = (const char *)view.buf +
+                            (i * k + j) * view.strides[0];
+                    }
+                    out[i * max_k + j] = (*format == 'f')
+                                             ? *(const float *)p
+                                             : (float)*(const double *)p;
+                }
+            }
+            PyBuffer_Release(&view);
+            *values = out;
+            return n;
+        }
+        PyBuffer_Release(&view);
+    }
+    PyErr_Clear();
+
+    seq = PySequence_Fast(obj, "");
+    if (!seq) {
+        PyErr_Format(PyExc_TypeError, "%s must be a sequence", name);
+        return -1;
+    }
+
+    n = PySequence_Fast_GET_SIZE(seq);
+    out = PyMem_New(float, (size_t)MAX(n, 1) * max_k);
+    if (!out) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (i = 0; i < n; i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        itemseq = PySequence_Fast(item, "");
+        k = itemseq ? PySequence_Fast_GET_SIZE(itemseq) : -1;
+        if (k < min_k || k > max_k) {
+            Py_XDECREF(itemseq);
+            Py_DECREF(seq);
+            PyMem_Free(out);
+            PyErr_Format(PyExc_TypeError,
+                         "%s must contain sequences of %d to %d numbers",
+                         name, min_k, max_k);
+            return -1;
+        }
+        for (j = 0; j < max_k; j++) {
+            if (j >= k) {
+                out[i * max_k + j] = fill;
+                continue;
+            }
+            value = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(itemseq, j));
+            if (value == -1.0 && PyErr_Occurred()) {
+                Py_DECREF(itemseq);
+                Py_DECREF(seq);
+                PyMem_Free(out);
+                PyErr_Format(PyExc_TypeError,
+                             "%s must contain sequences of %d to %d numbers",
+                             name, min_k, max_k);
+                return -1;
+            }
+            out[i * max_k + j] = (float)value;
+        }
+        Py_DECREF(itemseq);
+    }
+
+    Py_DECREF(seq);
+    *values = out;
+    return n;
+}
+
+/* Loads the vertex indices of the triangles, 3 an item, into a new array
+ * to be freed with PyMem_Free(). Without indices the vertices are taken 3
+ * at a time.
+ *
+ * Returns the number of triangles, or -1 with an exception set.
+ */
+static Py_ssize_t
+_gfx_mesh_indices_from_obj(PyObject *obj, Py_ssize_t n_vertices,
+                           Py_ssize_t **indices)
+{
+    PyObject *seq;
+    Py_ssize_t *out, n, i;
+
+    if (obj == Py_None) {
+        if (n_vertices % 3) {
+            PyErr_SetString(PyExc_ValueError,
+                            "the number of vertices must be a multiple of "
+                            "3 without indices");
+            return -1;
+        }
+        n = n_vertices;
+        seq = NULL;
+    }
+    else {
+        seq = PySequence_Fast(obj, "indices must be a sequence of ints");
+        if (!seq) {
+            return -1;
+        }
+        n = PySequence_Fast_GET_SIZE(seq);
+        if (n % 3) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_ValueError,
+                            "the number of indices must be a multiple of 3");
+            return -1;
+        }
+    }
+
+    out = PyMem_New(Py_ssize_t, (size_t)MAX(n, 1));
+    if (!out) {
+        Py_XDECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (!seq) {
+            out[i] = i;
+            continue;
+        }
+        out[i] = PyNumber_AsSsize_t(PySequence_Fast_GET_ITEM(seq, i), NULL);
+        if (out[i] == -1 && PyErr_Occurred()) {
+            Py_DECREF(seq);
+            PyMem_Free(out);
+            PyErr_SetString(PyExc_TypeError,
+                            "indices must be a sequence of ints");
+            return -1;
+        }
+        if (out[i] < 0 || out[i] >= n_vertices) {
+            Py_DECREF(seq);
+            PyMem_Free(out);
+            PyErr_SetString(PyExc_IndexError, "vertex index out of range");
+            return -1;
+        }
+    }
+
+    Py_XDECREF(seq);
+    *indices = out;
+    return n / 3;
+}
+
+static PyObject *
+_gfx_texturedtriangles(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *surface, *texture, *vertobj, *uvobj;
+    PyObject *colorsobj = Py_None, *indicesobj = Py_None, *seq = NULL;
+    SDL_Surface *s_surface, *s_texture, *converted = NULL;
+    SDL_PixelFormat *tformat;
+    float *coords = NULL, *uvs = NULL;
+    Py_ssize_t *indices = NULL, n_vertices, n_uvs, n_triangles, i;
+    _gfx_mesh_vertex *vertices = NULL;
+    _gfx_mesh mesh;
+    Uint8 rgba[4];
+    Sint64 area = 0;
+    float left = GFX_MESH_MAX_COORD, right = -GFX_MESH_MAX_COORD;
+    int smooth = 0, bottom = INT_MIN, failed = 1;
+    static char *keywords[] = {"surface", "texture", "vertices", "uvs",
+                               "colors",  "indices", "smooth",   NULL};
+
+    ASSERT_VIDEO_INIT(NULL);
+
+    mesh.triangles = NULL;
+    if (!PyArg_ParseTupleAndKeywords(
+            args, kwargs, "OOOO|OOp:textured_triangles", keywords, &surface,
+            &texture, &vertobj, &uvobj, &colorsobj, &indicesobj, &smooth))
+        return NULL;
+
+    if (!pgSurface_Check(surface)) {
+        PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
+        return NULL;
+    }
+    s_surface = pgSurface_AsSurface(surface);
+    if (!pgSurface_Check(texture)) {
+        PyErr_SetString(PyExc_TypeError, "texture must be a Surface");
+        return NULL;
+    }
+    s_texture = pgSurface_AsSurface(texture);
+    if (s_texture->w <= 0 || s_texture->h <= 0) {
+        PyErr_SetString(PyExc_ValueError, "texture must not be empty");
+        return NULL;
+    }
+
+    n_vertices = _gfx_mesh_floats_from_obj(vertobj, "vertices", 2, 3, 1.0f,
+                                           &coords);
+    if (n_vertices == -1) {
+        goto end;
+    }
+    n_uvs = _gfx_mesh_floats_from_obj(uvobj, "uvs", 2, 2, 0.0f, &uvs);
+    if (n_uvs == -1) {
+        goto end;
+    }
+    if (n_uvs != n_vertices) {
+        PyErr_SetString(PyExc_ValueError,
+                        "uvs must have as many items as vertices");
+        goto end;
+    }
+
+    vertices = PyMem_New(_gfx_mesh_vertex, (size_t)MAX(n_vertices, 1));
+    if (!vertices) {
+        PyErr_NoMemory();
+        goto end;
+    }
+    for (i = 0; i < n_vertices; i++) {
+        float w = coords[3 * i + 2];
+
+        vertices[i].x = coords[3 * i];
+        vertices[i].y = coords[3 * i + 1];
+        vertices[i].u = uvs[2 * i];
+        vertices[i].v = uvs[2 * i + 1];
+        if (!isfinite(vertices[i].x) || !isfinite(vertices[i].y) ||
+            !isfinite(vertices[i].u) || !isfinite(vertices[i].v)) {
+            PyErr_SetString(PyExc_ValueError,
+                            "vertices and uvs must be finite");
+            goto end;
+        }
+        if (!(w > 0.0f) || !isfinite(w)) {
+            PyErr_SetString(PyExc_ValueError,
+                            "the w of the vertices must be positive");
+            goto end;
+        }
+        vertices[i].q = 1.0f / w;
+    }
+
+    mesh.colored = colorsobj != Py_None;
+    if (mesh.colored) {
+        seq = PySequence_Fast(colorsobj, "colors must be a sequence");
+        if (!seq) {
+            goto end;
+        }
+        if (PySequence_Fast_GET_SIZE(seq) != n_vertices) {
+            PyErr_SetString(PyExc_ValueError,
+                            "colors must have as many items as vertices");
+            goto end;
+        }
+        for (i = 0; i < n_vertices; i++) {
+            if (!pg_RGBAFromFuzzyColorObj(PySequence_Fast_GET_ITEM(seq, i),
+                                          rgba)) {
+                goto end;
+            }
+            vertices[i].color[0] = rgba[0];
+            vertices[i].color[1] = rgba[1];
+            vertices[i].color[2] = rgba[2];
+            vertices[i].color[3] = rgba[3];
+        }
+    }
+
+    n_triangles = _gfx_mesh_indices_from_obj(indicesobj, n_vertices,
+                                             &indices);
+    if (n_triangles == -1) {
+        goto end;
+    }
+
+    mesh.triangles =
+        PyMem_New(_gfx_mesh_triangle, (size_t)MAX(n_triangles, 1));
+    if (!mesh.triangles) {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    /* Set up the triangles in their order, dropping those that draw
+     * nothing. */
+    mesh.surf = s_surface;
+    mesh.smooth = smooth;
+    mesh.n_triangles = 0;
+    mesh.top = INT_MAX;
+    for (i = 0; i < n_triangles; i++) {
+        _gfx_mesh_triangle *tri = mesh.triangles + mesh.n_triangles;
+
+        if (_gfx_mesh_setup(tri, vertices + indices[3 * i],
+                            vertices + indices[3 * i + 1],
+                            vertices + indices[3 * i + 2], mesh.colored,
+                            &s_surface->clip_rect)) {
+            mesh.top = MIN(mesh.top, tri->ystart);
+            bottom = MAX(bottom, tri->yend);
+            left = MIN(left, MIN(tri->x[0], MIN(tri->x[1], tri->x[2])));
+            right = MAX(right, MAX(tri->x[0], MAX(tri->x[1], tri->x[2])));
+            area += (Sint64)(tri->yend - tri->ystart + 1) *
+                    MIN((Sint64)fabsf(MAX(tri->x[0], MAX(tri->x[1],
+                                                           tri->x[2])) -
+                                      MIN(tri->x[0], MIN(tri->x[1],
+                                                           tri->x[2]))) +
+                            1,
+                        (Sint64)s_surface->clip_rect.w) /
+                    2;
+            mesh.n_triangles++;
+        }
+    }
+
+    if (!mesh.n_triangles) {
+        failed = 0;
+        goto end;
+    }
+
+    /* Texels are read as 32 bit values with 8 bit channels, so other
+     * textures are converted first. So is a texture sharing pixels with the
+     * surface, such as a subsurface of it, which would otherwise be read
+     * while it is being drawn on. */
+    tformat = s_texture->format;
+    if (tformat->BytesPerPixel != 4 || tformat->Rloss || tformat->Gloss ||
+        tformat->Bloss || (tformat->Amask && tformat->Aloss) ||
+        ((Uint8 *)s_texture->pixels <
+             (Uint8 *)s_surface->pixels + s_surface->h * s_surface->pitch &&
+         (Uint8 *)s_surface->pixels <
+             (Uint8 *)s_texture->pixels + s_texture->h * s_texture->pitch)) {
+        converted =
+            SDL_ConvertSurfaceFormat(s_texture, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!converted) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            goto end;
+        }
+        s_texture = converted;
+        tformat = s_texture->format;
+    }
+    mesh.texels = s_texture->pixels;
+    mesh.tpitch = s_texture->pitch;
+    mesh.tw = s_texture->w;
+    mesh.th = s_texture->h;
+    mesh.tshifts[0] = tformat->Rshift;
+    mesh.tshifts[1] = tformat->Gshift;
+    mesh.tshifts[2] = tformat->Bshift;
+    mesh.tshifts[3] = tformat->Amask ? tformat->Ashift : -1;
+
+    mesh.rows = bottom - mesh.top + 1;
+    mesh.bands = 1;
+    if (area >= GFX_PARALLEL_MIN_PIXELS) {
+        mesh.bands = (int)MIN(MIN(area / GFX_BAND_MIN_PIXELS, mesh.rows),
+                              MIN(SDL_GetCPUCount(), PG_PARALLEL_MAX_THREADS));
+        mesh.bands = MAX(mesh.bands, 1);
+    }
+
+    if (!pgSurface_Lock((pgSurfaceObject *)surface)) {
+        goto end;
+    }
+    if (!converted && !pgSurface_Lock((pgSurfaceObject *)texture)) {
+        pgSurface_Unlock((pgSurfaceObject *)surface);
+        goto end;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    pg_parallel_for(mesh.bands, 1, _gfx_mesh_bands, &mesh);
+    Py_END_ALLOW_THREADS;
+
+    if (!converted && !pgSurface_Unlock((pgSurfaceObject *)texture)) {
+        pgSurface_Unlock((pgSurfaceObject *)surface);
+        goto end;
+    }
+    if (!pgSurface_Unlock((pgSurfaceObject *)surface)) {
+        goto end;
+    }
+    _gfx_damage(surface, (int)floorf(left), mesh.top, (int)ceilf(right),
+                bottom);
+    failed = 0;
+
+end:
+    if (converted) {
+        SDL_FreeSurface(converted);
+    }
+    Py_XDECREF(seq);
+    PyMem_Free(coords);
+    PyMem_Free(uvs);
+    PyMem_Free(vertices);
+    PyMem_Free(indices);
+    PyMem_Free(mesh.triangles);
+    if (failed) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 _gfx_beziercolor(PyObject *self, PyObject *args)
 {
@@ -1083,6 +2328,8 @@ _gfx_beziercolor(PyObject *self, PyObject *args)
                      rgba[0], rgba[1], rgba[2], rgba[3]);
     Py_END_ALLOW_THREADS;
 
+    if (ret != -1)
+        _gfx_damage_points(surface, vx, vy, count, 0);
     PyMem_Free(vx);
     PyMem_Free(vy);
 
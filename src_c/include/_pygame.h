@@ -91,6 +91,14 @@ typedef struct pg_bufferinfo_s {
 /*
  * BASE module
  */
+
+/* Upper limit on the number of threads pg_parallel_for() splits a loop
+ * over. */
+#define PG_PARALLEL_MAX_THREADS 64
+
+/* Does the work for the items [start, end) of a pg_parallel_for() loop.
+ * Runs without the GIL, so it must not touch any Python objects. */
+typedef void (*pg_parallel_func)(void *data, int start, int end);
 #ifndef PYGAMEAPI_BASE_INTERNAL
 #define pgExc_SDLError ((PyObject *)PYGAMEAPI_GET_SLOT(base, 0))
 
@@ -159,6 +167,10 @@ typedef struct pg_bufferinfo_s {
 #define pg_EnvShouldBlendAlphaSDL2 \
     (*(char *(*)(void))PYGAMEAPI_GET_SLOT(base, 23))
 
+#define pg_parallel_for                                                 \
+    (*(void (*)(int, int, pg_parallel_func, void *))PYGAMEAPI_GET_SLOT( \
+        base, 24))
+
 #define import_pygame_base() IMPORT_PYGAME_MODULE(base)
 #endif /* ~PYGAMEAPI_BASE_INTERNAL */
 
@@ -284,6 +296,18 @@ typedef struct {
     (*(int (*)(pgSurfaceObject *, pgSurfaceObject *, SDL_Rect *, SDL_Rect *, \
                int))PYGAMEAPI_GET_SLOT(surface, 2))
 
+#define pgSurface_AddDamage                                              \
+    (*(void (*)(pgSurfaceObject *, const SDL_Rect *))PYGAMEAPI_GET_SLOT( \
+        surface, 4))
+
+#define pgSurface_SoftBlit                                                 \
+    (*(int (*)(SDL_Surface *, SDL_Rect *, SDL_Surface *, SDL_Rect *, int)) \
+         PYGAMEAPI_GET_SLOT(surface, 5))
+
+#define pgSurface_TakeDamage                                          \
+    (*(int (*)(pgSurfaceObject *, SDL_Rect *))PYGAMEAPI_GET_SLOT( \
+        surface, 6))
+
 #define import_pygame_surface()         \
     do {                                \
         IMPORT_PYGAME_MODULE(surface);  \
@@ -353,6 +377,9 @@ typedef struct pgEventObject pgEventObject;
 
 #define pg_GetKeyRepeat (*(void (*)(int *, int *))PYGAMEAPI_GET_SLOT(event, 5))
 
+#define pgEvent_PostPayload \
+    (*(int (*)(int, const void *, Py_ssize_t))PYGAMEAPI_GET_SLOT(event, 6))
+
 #define import_pygame_event() IMPORT_PYGAME_MODULE(event)
 #endif
 
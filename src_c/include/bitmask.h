@@ -148,12 +148,45 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset);
 void
 bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset);
 
+/* Operations for bitmask_compose(). */
+#define BITMASK_OP_DRAW 0  /* a |= b */
+#define BITMASK_OP_ERASE 1 /* a &= ~b */
+
+typedef struct bitmask_op {
+    const bitmask_t *mask;
+    int xoffset, yoffset;
+    int op;
+} bitmask_op_t;
+
+/* Applies n draw/erase operations to a, with the same result as calling
+   bitmask_draw() or bitmask_erase() for each of them in order. The work is
+   done one stripe of a at a time, so every stripe is only walked once no
+   matter how many operations touch it.
+
+   Only the stripes [start, end) of a are changed, and disjoint stripe ranges
+   can be composed at the same time from different threads. None of the
+   operation masks may be a itself. */
+void
+bitmask_compose(bitmask_t *a, const bitmask_op_t *ops, int n, int start,
+                int end);
+
 /* Return a new scaled bitmask, with dimensions w*h. The quality of the
    scaling may not be perfect for all circumstances, but it should
    be reasonable. If either w or h is 0 a clear 1x1 mask is returned. */
 bitmask_t *
 bitmask_scale(const bitmask_t *m, int w, int h);
 
+/* Computes the size of a w*h bitmask rotated by angle degrees, using the
+   same bounding box as pygame.transform.rotate(). */
+void
+bitmask_rotated_size(int w, int h, double angle, int *rw, int *rh);
+
+/* Return a new bitmask rotated counterclockwise by angle degrees. The
+   sampling matches pygame.transform.rotate(), so rotating a mask gives the
+   same bits as making a mask from a rotated surface. */
+bitmask_t *
+bitmask_rotate(const bitmask_t *m, double angle);
+
 /* Convolve b into a, drawing the output into o, shifted by offset.  If offset
  * is 0, then the (x,y) bit will be set if and only if
  * bitmask_overlap(a, b, x - b->w - 1, y - b->h - 1) returns true.
@@ -164,6 +197,40 @@ void
 bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *o,
                  int xoffset, int yoffset);
 
+/* Like bitmask_convolve(), but always draws a once per set bit of b, for
+   callers that already know bitmask_convolution_init() returns 0. */
+void
+bitmask_convolve_bits(const bitmask_t *a, const bitmask_t *b, bitmask_t *o,
+                      int xoffset, int yoffset);
+
+/* The draw operations of a convolution, built from the horizontal runs of
+   set bits in b instead of its single bits. A run of length n is drawn with
+   at most two copies of a that have been dilated (smeared to the right) by
+   the largest power of two <= n, so a solid 64x64 kernel takes 64 draws
+   instead of 4096. */
+typedef struct bitmask_convolution {
+    bitmask_op_t *ops;
+    int nops;
+    int ndilated;
+    /* dilated[k] is a dilated by 2**k bits, dilated[0] is a itself. */
+    bitmask_t *dilated[sizeof(int) * CHAR_BIT];
+} bitmask_convolution_t;
+
+/* Prepares conv for convolving b into a with the same offset rules as
+   bitmask_convolve(). Applying conv->ops to o with bitmask_compose() then
+   gives the same bits as bitmask_convolve(), and the stripes of o can be
+   composed from several threads.
+
+   Returns 1 if conv was prepared, 0 if convolving bit by bit is estimated
+   to be faster (conv is left empty) or -1 if out of memory. A prepared conv
+   must be freed with bitmask_convolution_free(). */
+int
+bitmask_convolution_init(bitmask_convolution_t *conv, const bitmask_t *a,
+                         const bitmask_t *b, int xoffset, int yoffset);
+
+void
+bitmask_convolution_free(bitmask_convolution_t *conv);
+
 #ifdef __cplusplus
 } /* End of extern "C" { */
 #endif
@@ -33,6 +33,9 @@
 
 #include "pgcompat.h"
 
+#include "pgbufferproxy.h"
+
+
 #include "doc/mask_doc.h"
 
 #include "structmember.h"
@@ -351,6 +354,33 @@ mask_scale(PyObject *self, PyObject *args, PyObject *kwargs)
     return (PyObject *)create_mask_using_bitmask(bitmask);
 }
 
+static PyObject *
+mask_rotate(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    bitmask_t *bitmask = NULL;
+    bitmask_t *mask = pgMask_AsBitmap(self);
+    float angle;
+    static char *keywords[] = {"angle", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "f", keywords, &angle)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!isfinite(angle)) {
+        return RAISE(PyExc_ValueError, "angle must be a finite number");
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    bitmask = bitmask_rotate(mask, angle);
+    Py_END_ALLOW_THREADS;
+
+    if (NULL == bitmask) {
+        return RAISE(PyExc_MemoryError, "cannot allocate memory for bitmask");
+    }
+
+    return (PyObject *)create_mask_using_bitmask(bitmask);
+}
+
 static PyObject *
 mask_draw(PyObject *self, PyObject *args, PyObject *kwargs)
 {
@@ -403,6 +433,202 @@ mask_erase(PyObject *self, PyObject *args, PyObject *kwargs)
     Py_RETURN_NONE;
 }
 
+typedef struct {
+    bitmask_t *mask;
+    const bitmask_op_t *ops;
+    int nops;
+} compose_data;
+
+static void
+compose_stripes(void *arg, int start, int end)
+{
+    compose_data *data = (compose_data *)arg;
+
+    bitmask_compose(data->mask, data->ops, data->nops, start, end);
+}
+
+/* Runs bitmask_compose() over the whole mask, splitting the stripes over
+ * threads. nwords estimates the number of words written by the operations.
+ * Must be called with the GIL released.
+ */
+static void
+compose_parallel(bitmask_t *mask, const bitmask_op_t *ops, int nops,
+                 Py_ssize_t nwords)
+{
+    compose_data data;
+    int nstripes = mask->w ? (int)((mask->w - 1) / BITMASK_W_LEN + 1) : 0;
+    int min_chunk;
+
+    /* Give each thread at least 64K words of work. */
+    min_chunk = nwords ? (int)MIN(nstripes, 0x10000 * (Py_ssize_t)nstripes /
+                                                nwords + 1)
+                       : nstripes;
+
+    data.mask = mask;
+    data.ops = ops;
+    data.nops = nops;
+
+    pg_parallel_for(nstripes, min_chunk, compose_stripes, &data);
+}
+
+/* Draws and erases a sequence of (mask, offset[, op]) operations in one go.
+ * The operations are applied stripe by stripe with the GIL released, each
+ * stripe only being walked once and the stripes being split over threads.
+ */
+static PyObject *
+mask_compose(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    bitmask_t *mask = pgMask_AsBitmap(self);
+    bitmask_t *snapshot = NULL;
+    bitmask_op_t *ops;
+    PyObject **maskobjs;
+    PyObject *operations, *seq;
+    Py_ssize_t i, n, nwords = 0;
+    static char *keywords[] = {"operations", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", keywords,
+                                     &operations)) {
+        return NULL; /* Exception already set. */
+    }
+
+    seq = PySequence_Fast(operations, "operations must be a sequence");
+
+    if (NULL == seq) {
+        return NULL; /* Exception already set. */
+    }
+
+    n = PySequence_Fast_GET_SIZE(seq);
+
+    if (n > INT_MAX) {
+        Py_DECREF(seq);
+        return RAISE(PyExc_ValueError, "too many operations");
+    }
+
+    ops = PyMem_New(bitmask_op_t, MAX(n, 1));
+    maskobjs = PyMem_New(PyObject *, MAX(n, 1));
+
+    if (NULL == ops || NULL == maskobjs) {
+        PyMem_Free(ops);
+        PyMem_Free(maskobjs);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+
+    for (i = 0; i < n; ++i) {
+        PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+        PyObject *maskobj = NULL, *offset = NULL, *opobj = NULL;
+        Py_ssize_t size;
+        bitmask_t *othermask;
+
+        size = PySequence_Check(item) ? PySequence_Size(item) : -1;
+
+        if (size != 2 && size != 3) {
+            PyErr_Clear();
+            PyErr_SetString(PyExc_TypeError,
+                            "operations must be (mask, offset) or "
+                            "(mask, offset, op) sequences");
+            goto error;
+        }
+
+        maskobj = PySequence_GetItem(item, 0);
+        offset = PySequence_GetItem(item, 1);
+
+        if (size == 3) {
+            opobj = PySequence_GetItem(item, 2);
+        }
+
+        if (NULL == maskobj || NULL == offset || (size == 3 && !opobj)) {
+            Py_XDECREF(maskobj);
+            Py_XDECREF(offset);
+            Py_XDECREF(opobj);
+            goto error;
+        }
+
+        if (!PyObject_TypeCheck(maskobj, &pgMask_Type)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "operation mask must be a Mask object");
+        }
+        else if (!pg_TwoIntsFromObj(offset, &ops[i].xoffset,
+                                    &ops[i].yoffset)) {
+            PyErr_SetString(PyExc_TypeError, "offset must be two numbers");
+        }
+        else if (NULL == opobj) {
+            ops[i].op = BITMASK_OP_DRAW;
+        }
+        else if (PyUnicode_Check(opobj) &&
+                 PyUnicode_CompareWithASCIIString(opobj, "draw") == 0) {
+            ops[i].op = BITMASK_OP_DRAW;
+        }
+        else if (PyUnicode_Check(opobj) &&
+                 PyUnicode_CompareWithASCIIString(opobj, "erase") == 0) {
+            ops[i].op = BITMASK_OP_ERASE;
+        }
+        else {
+            PyErr_SetString(PyExc_ValueError, "op must be 'draw' or 'erase'");
+        }
+
+        Py_DECREF(offset);
+        Py_XDECREF(opobj);
+
+        if (PyErr_Occurred()) {
+            Py_DECREF(maskobj);
+            goto error;
+        }
+
+        /* Keep the masks alive while the GIL is released. */
+        maskobjs[i] = maskobj;
+        othermask = pgMask_AsBitmap(maskobj);
+
+        /* A mask composed onto itself is read as it was before the call. */
+        if (othermask == mask) {
+            if (NULL == snapshot && NULL == (snapshot = bitmask_copy(mask))) {
+                Py_DECREF(maskobj);
+                PyErr_NoMemory();
+                goto error;
+            }
+
+            othermask = snapshot;
+        }
+
+        ops[i].mask = othermask;
+        nwords += ((Py_ssize_t)othermask->w / BITMASK_W_LEN + 2) *
+                  MIN(othermask->h, mask->h);
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    compose_parallel(mask, ops, (int)n, nwords);
+    Py_END_ALLOW_THREADS;
+
+    if (snapshot) {
+        bitmask_free(snapshot);
+    }
+
+    while (i--) {
+        Py_DECREF(maskobjs[i]);
+    }
+
+    PyMem_Free(ops);
+    PyMem_Free(maskobjs);
+    Py_DECREF(seq);
+
+    Py_RETURN_NONE;
+
+error:
+    if (snapshot) {
+        bitmask_free(snapshot);
+    }
+
+    while (i--) {
+        Py_DECREF(maskobjs[i]);
+    }
+
+    PyMem_Free(ops);
+    PyMem_Free(maskobjs);
+    Py_DECREF(seq);
+
+    return NULL;
+}
+
 static PyObject *
 mask_count(PyObject *self, PyObject *_null)
 {
@@ -480,6 +706,56 @@ mask_angle(PyObject *self, PyObject *_null)
     }
 }
 
+/* Returns the index of the lowest set bit of a nonzero word. */
+static PG_INLINE int
+lowest_bit_index(BITMASK_W word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzl(word);
+#else
+    int index = 0;
+
+    while (!(word & 1)) {
+        word >>= 1;
+        ++index;
+    }
+
+    return index;
+#endif
+}
+
+/* Finds the first set bit in row major order (top to bottom, then left to
+ * right), a whole word of a row at a time.
+ *
+ * Returns:
+ *     1 if a set bit was found and stored in x, y, otherwise 0
+ */
+static int
+first_set_bit(const bitmask_t *m, int *x, int *y)
+{
+    int row, stripe, nstripes;
+
+    if (!m->w || !m->h) {
+        return 0;
+    }
+
+    nstripes = (m->w - 1) / BITMASK_W_LEN + 1;
+
+    for (row = 0; row < m->h; ++row) {
+        for (stripe = 0; stripe < nstripes; ++stripe) {
+            BITMASK_W word = m->bits[stripe * m->h + row];
+
+            if (word) {
+                *x = stripe * BITMASK_W_LEN + lowest_bit_index(word);
+                *y = row;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
 static PyObject *
 mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
 {
@@ -520,42 +796,32 @@ mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
     bitmask_draw(m, c, 1, 1);
 
     /* find the first set pixel in the mask */
-    for (y = 1; y < m->h - 1; y++) {
-        for (x = 1; x < m->w - 1; x++) {
-            if (bitmask_getbit(m, x, y)) {
-                firstx = x;
-                firsty = y;
-                value = Py_BuildValue("(ii)", x - 1, y - 1);
-
-                if (NULL == value) {
-                    Py_DECREF(plist);
-                    bitmask_free(m);
+    if (!first_set_bit(m, &x, &y)) {
+        bitmask_free(m);
+        return plist;
+    }
 
-                    return NULL; /* Exception already set. */
-                }
+    firstx = x;
+    firsty = y;
+    value = Py_BuildValue("(ii)", x - 1, y - 1);
 
-                if (0 != PyList_Append(plist, value)) {
-                    Py_DECREF(value);
-                    Py_DECREF(plist);
-                    bitmask_free(m);
-
-                    return NULL; /* Exception already set. */
-                }
+    if (NULL == value) {
+        Py_DECREF(plist);
+        bitmask_free(m);
 
-                Py_DECREF(value);
-                break;
-            }
-        }
-        if (bitmask_getbit(m, x, y))
-            break;
+        return NULL; /* Exception already set. */
     }
 
-    /* covers the mask having zero pixels set or only the final pixel */
-    if ((x == m->w - 1) && (y == m->h - 1)) {
+    if (0 != PyList_Append(plist, value)) {
+        Py_DECREF(value);
+        Py_DECREF(plist);
         bitmask_free(m);
-        return plist;
+
+        return NULL; /* Exception already set. */
     }
 
+    Py_DECREF(value);
+
     e = every;
 
     /* check just the first pixel for neighbors */
@@ -616,36 +882,460 @@ mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
                         Py_DECREF(plist);
                         bitmask_free(m);
 
-                        return NULL; /* Exception already set. */
+                        return NULL; /* Exception already set. */
+                    }
+
+                    if (0 != PyList_Append(plist, value)) {
+                        Py_DECREF(value);
+                        Py_DECREF(plist);
+                        bitmask_free(m);
+
+                        return NULL; /* Exception already set. */
+                    }
+
+                    Py_DECREF(value);
+                }
+                break;
+            }
+        }
+        /* if we are back at the first pixel, and the next one will be the
+           second one we visited, we are done */
+        if ((curry == firsty && currx == firstx) &&
+            (secx == nextx && secy == nexty)) {
+            break;
+        }
+
+        curry = nexty;
+        currx = nextx;
+    }
+
+    bitmask_free(m);
+
+    return plist;
+}
+
+/* Neighbor offsets used for contour tracing, counterclockwise (as seen on
+ * the screen) starting from the east. */
+static const int contour_dx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int contour_dy[8] = {0, -1, -1, -1, 0, 1, 1, 1};
+
+#define CONTOUR_EAST 0
+#define CONTOUR_WEST 4
+
+typedef struct {
+    int *points;     /* x, y pairs */
+    Py_ssize_t len;  /* number of points */
+    Py_ssize_t size; /* number of points allocated */
+} contour_points;
+
+static int
+contour_append(contour_points *contour, int x, int y)
+{
+    if (contour->len == contour->size) {
+        Py_ssize_t size = contour->size ? contour->size * 2 : 64;
+        int *points = PyMem_Resize(contour->points, int, size * 2);
+
+        if (NULL == points) {
+            return -1;
+        }
+
+        contour->points = points;
+        contour->size = size;
+    }
+
+    contour->points[contour->len * 2] = x;
+    contour->points[contour->len * 2 + 1] = y;
+    ++contour->len;
+    return 0;
+}
+
+/* Follows one border of the padded mask m, using the border following rules
+ * of Suzuki and Abe. The border is entered at the set bit (x0, y0) from its
+ * clear neighbor in the start_dir direction: CONTOUR_WEST for outer borders
+ * and CONTOUR_EAST for hole borders.
+ *
+ * The visited and negative masks record the traced bits between calls, they
+ * decide which bits start new borders. The points are stored in contour
+ * without the padding offset.
+ *
+ * Returns:
+ *     0 on success, -1 if out of memory
+ */
+static int
+trace_contour(const bitmask_t *m, bitmask_t *visited, bitmask_t *negative,
+              int x0, int y0, int start_dir, contour_points *contour)
+{
+    int s = start_dir, d, k, x1, y1, x3, y3, x4, y4;
+
+    contour->len = 0;
+
+    /* Search clockwise from the clear neighbor for the next border bit. */
+    do {
+        s = (s + 7) & 7;
+    } while (s != start_dir &&
+             !bitmask_getbit(m, x0 + contour_dx[s], y0 + contour_dy[s]));
+
+    if (s == start_dir) {
+        /* A single bit with no neighbors. */
+        bitmask_setbit(visited, x0, y0);
+        bitmask_setbit(negative, x0, y0);
+        return contour_append(contour, x0 - 1, y0 - 1);
+    }
+
+    x1 = x0 + contour_dx[s];
+    y1 = y0 + contour_dy[s];
+    x3 = x0;
+    y3 = y0;
+
+    /* s is always the direction from (x3, y3) back to the previous bit. */
+    for (;;) {
+        int east_clear = 0;
+
+        /* Search counterclockwise, starting after the previous bit. */
+        for (k = 1, d = s; k <= 8; ++k) {
+            d = (s + k) & 7;
+
+            if (bitmask_getbit(m, x3 + contour_dx[d], y3 + contour_dy[d])) {
+                break;
+            }
+
+            if (d == CONTOUR_EAST) {
+                east_clear = 1;
+            }
+        }
+
+        if (east_clear) {
+            bitmask_setbit(negative, x3, y3);
+        }
+
+        bitmask_setbit(visited, x3, y3);
+
+        if (contour_append(contour, x3 - 1, y3 - 1)) {
+            return -1;
+        }
+
+        x4 = x3 + contour_dx[d];
+        y4 = y3 + contour_dy[d];
+
+        /* Back at the start, about to repeat the first step. */
+        if (x4 == x0 && y4 == y0 && x3 == x1 && y3 == y1) {
+            return 0;
+        }
+
+        s = (d + 4) & 7;
+        x3 = x4;
+        y3 = y4;
+    }
+}
+
+/* Simplifies a closed contour in place with the Douglas-Peucker algorithm,
+ * dropping points closer than epsilon to the line between the points kept
+ * around them. The closed contour is split in two at the point furthest from
+ * the first point.
+ *
+ * Returns:
+ *     the new number of points, or -1 if out of memory
+ */
+static Py_ssize_t
+simplify_contour(int *points, Py_ssize_t n, double epsilon)
+{
+    Py_ssize_t *stack, top = 0, i, far = 0, len;
+    char *keep;
+    double dmax = -1.0;
+
+    if (n < 3) {
+        return n;
+    }
+
+    keep = PyMem_New(char, n);
+    stack = PyMem_New(Py_ssize_t, (n + 2) * 2);
+
+    if (NULL == keep || NULL == stack) {
+        PyMem_Free(keep);
+        PyMem_Free(stack);
+        return -1;
+    }
+
+    memset(keep, 0, n);
+
+    for (i = 1; i < n; ++i) {
+        double dx = points[i * 2] - points[0];
+        double dy = points[i * 2 + 1] - points[1];
+
+        if (dx * dx + dy * dy > dmax) {
+            dmax = dx * dx + dy * dy;
+            far = i;
+        }
+    }
+
+    keep[0] = keep[far] = 1;
+
+    /* The ranges are [first, last] with last == n meaning the first point. */
+    stack[top++] = 0;
+    stack[top++] = far;
+    stack[top++] = far;
+    stack[top++] = n;
+
+    while (top) {
+        Py_ssize_t last = stack[--top];
+        Py_ssize_t first = stack[--top];
+        Py_ssize_t lastpt = (last == n) ? 0 : last;
+        double ax = points[first * 2], ay = points[first * 2 + 1];
+        double bx = points[lastpt * 2] - ax, by = points[lastpt * 2 + 1] - ay;
+        double seglen2 = bx * bx + by * by;
+
+        dmax = -1.0;
+        far = first;
+
+        for (i = first + 1; i < last; ++i) {
+            double px = points[i * 2] - ax, py = points[i * 2 + 1] - ay;
+            double dist2;
+
+            if (seglen2 > 0.0) {
+                double cross = px * by - py * bx;
+
+                dist2 = cross * cross / seglen2;
+            }
+            else {
+                dist2 = px * px + py * py;
+            }
+
+            if (dist2 > dmax) {
+                dmax = dist2;
+                far = i;
+            }
+        }
+
+        if (far != first && dmax > epsilon * epsilon) {
+            keep[far] = 1;
+            stack[top++] = first;
+            stack[top++] = far;
+            stack[top++] = far;
+            stack[top++] = last;
+        }
+    }
+
+    for (i = 0, len = 0; i < n; ++i) {
+        if (keep[i]) {
+            points[len * 2] = points[i * 2];
+            points[len * 2 + 1] = points[i * 2 + 1];
+            ++len;
+        }
+    }
+
+    PyMem_Free(keep);
+    PyMem_Free(stack);
+    return len;
+}
+
+/* Creates a BufferProxy exporting the contents of a bytearray as a 2D array
+ * with the given array interface type string. The proxy keeps the bytearray
+ * alive.
+ *
+ * Returns:
+ *     BufferProxy object or NULL to indicate a fail
+ */
+static PyObject *
+array_proxy_from_bytearray(PyObject *bytearray, const char *typestr,
+                           Py_ssize_t dim0, Py_ssize_t dim1)
+{
+    PyObject *dict, *proxy;
+
+    dict = Py_BuildValue(
+        "{s:(nn),s:s,s:(NO),s:O}", "shape", dim0, dim1, "typestr", typestr,
+        "data", PyLong_FromVoidPtr(PyByteArray_AS_STRING(bytearray)),
+        Py_False, "parent", bytearray);
+
+    if (NULL == dict) {
+        return NULL; /* Exception already set. */
+    }
+
+    proxy = PyObject_CallFunctionObjArgs((PyObject *)&pgBufproxy_Type, dict,
+                                         NULL);
+    Py_DECREF(dict);
+    return proxy;
+}
+
+/* Copies n points into a new (n, 2) shaped BufferProxy of int32 values. */
+static PyObject *
+contour_to_array(const int *points, Py_ssize_t n)
+{
+    PyObject *bytearray, *proxy;
+
+    bytearray = PyByteArray_FromStringAndSize((const char *)points,
+                                              n * 2 * sizeof(int));
+
+    if (NULL == bytearray) {
+        return NULL; /* Exception already set. */
+    }
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    proxy = array_proxy_from_bytearray(bytearray, "<i4", n, 2);
+#else
+    proxy = array_proxy_from_bytearray(bytearray, ">i4", n, 2);
+#endif
+    Py_DECREF(bytearray);
+    return proxy;
+}
+
+/* Traces every border of the mask, both the outer borders of the 8-connected
+ * components and the borders of the holes inside them.
+ *
+ * The start bits of the borders are found a word at a time: a bit starts an
+ * outer border when its west neighbor is clear, and a hole border when its
+ * east neighbor is clear, unless an earlier trace has already marked it.
+ */
+static PyObject *
+mask_contours(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    bitmask_t *c = pgMask_AsBitmap(self);
+    bitmask_t *m = NULL, *visited = NULL, *negative = NULL;
+    PyObject *contours = NULL;
+    contour_points contour = {NULL, 0, 0};
+    double epsilon = 0.0;
+    int y, stripe, nstripes;
+    static char *keywords[] = {"epsilon", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|d", keywords,
+                                     &epsilon)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(epsilon >= 0.0) || !isfinite(epsilon)) {
+        return RAISE(PyExc_ValueError,
+                     "epsilon must be a finite number >= 0");
+    }
+
+    contours = PyList_New(0);
+
+    if (NULL == contours || !c->w || !c->h) {
+        return contours;
+    }
+
+    /* Copying to a larger mask to avoid border checking. */
+    m = bitmask_create(c->w + 2, c->h + 2);
+    visited = bitmask_create(c->w + 2, c->h + 2);
+    negative = bitmask_create(c->w + 2, c->h + 2);
+
+    if (NULL == m || NULL == visited || NULL == negative) {
+        PyErr_NoMemory();
+        goto error;
+    }
+
+    bitmask_draw(m, c, 1, 1);
+    nstripes = (m->w - 1) / BITMASK_W_LEN + 1;
+
+    for (y = 1; y < m->h - 1; ++y) {
+        for (stripe = 0; stripe < nstripes; ++stripe) {
+            Py_ssize_t index = (Py_ssize_t)stripe * m->h + y;
+            BITMASK_W word = m->bits[index];
+            BITMASK_W west, east, candidates;
+
+            if (!word) {
+                continue;
+            }
+
+            /* The west and east neighbors of every bit in the word. */
+            west = word << 1;
+            east = word >> 1;
+
+            if (stripe > 0) {
+                west |= m->bits[index - m->h] >> (BITMASK_W_LEN - 1);
+            }
+
+            if (stripe < nstripes - 1) {
+                east |= m->bits[index + m->h] << (BITMASK_W_LEN - 1);
+            }
+
+            candidates = word & ((~west & ~visited->bits[index]) |
+                                 (~east & ~negative->bits[index]));
+
+            while (candidates) {
+                int x = stripe * BITMASK_W_LEN + lowest_bit_index(candidates);
+                int start_dir;
+                PyObject *array, *item;
+                Py_ssize_t len;
+
+                candidates &= candidates - 1;
+
+                /* Earlier traces may have marked this bit since the
+                 * candidates were found. */
+                if (!bitmask_getbit(visited, x, y) &&
+                    !bitmask_getbit(m, x - 1, y)) {
+                    start_dir = CONTOUR_WEST;
+                }
+                else if (!bitmask_getbit(negative, x, y) &&
+                         !bitmask_getbit(m, x + 1, y)) {
+                    start_dir = CONTOUR_EAST;
+                }
+                else {
+                    continue;
+                }
+
+                if (trace_contour(m, visited, negative, x, y, start_dir,
+                                  &contour)) {
+                    PyErr_NoMemory();
+                    goto error;
+                }
+
+                len = contour.len;
+
+                if (epsilon > 0.0) {
+                    len = simplify_contour(contour.points, len, epsilon);
+
+                    if (len < 0) {
+                        PyErr_NoMemory();
+                        goto error;
                     }
+                }
 
-                    if (0 != PyList_Append(plist, value)) {
-                        Py_DECREF(value);
-                        Py_DECREF(plist);
-                        bitmask_free(m);
+                array = contour_to_array(contour.points, len);
 
-                        return NULL; /* Exception already set. */
-                    }
+                if (NULL == array) {
+                    goto error; /* Exception already set. */
+                }
 
-                    Py_DECREF(value);
+                item = Py_BuildValue("(NO)", array,
+                                     (start_dir == CONTOUR_EAST) ? Py_True
+                                                                 : Py_False);
+
+                if (NULL == item) {
+                    goto error; /* Exception already set. */
                 }
-                break;
+
+                if (0 != PyList_Append(contours, item)) {
+                    Py_DECREF(item);
+                    goto error; /* Exception already set. */
+                }
+
+                Py_DECREF(item);
             }
         }
-        /* if we are back at the first pixel, and the next one will be the
-           second one we visited, we are done */
-        if ((curry == firsty && currx == firstx) &&
-            (secx == nextx && secy == nexty)) {
-            break;
-        }
-
-        curry = nexty;
-        currx = nextx;
     }
 
+    PyMem_Free(contour.points);
     bitmask_free(m);
+    bitmask_free(visited);
+    bitmask_free(negative);
+    return contours;
 
-    return plist;
+error:
+    PyMem_Free(contour.points);
+
+    if (m) {
+        bitmask_free(m);
+    }
+
+    if (visited) {
+        bitmask_free(visited);
+    }
+
+    if (negative) {
+        bitmask_free(negative);
+    }
+
+    Py_DECREF(contours);
+    return NULL;
 }
 
 static PyObject *
@@ -653,8 +1343,9 @@ mask_convolve(PyObject *aobj, PyObject *args, PyObject *kwargs)
 {
     PyObject *bobj;
     PyObject *oobj = Py_None;
-    bitmask_t *a = NULL, *b = NULL;
-    int xoffset = 0, yoffset = 0;
+    bitmask_t *a = NULL, *b = NULL, *output;
+    bitmask_convolution_t conv;
+    int xoffset = 0, yoffset = 0, prepared = 0;
     PyObject *offset = NULL;
     static char *keywords[] = {"other", "output", "offset", NULL};
 
@@ -685,11 +1376,236 @@ mask_convolve(PyObject *aobj, PyObject *args, PyObject *kwargs)
         oobj = (PyObject *)maskobj;
     }
 
-    bitmask_convolve(a, b, pgMask_AsBitmap(oobj), xoffset, yoffset);
+    output = pgMask_AsBitmap(oobj);
+
+    Py_BEGIN_ALLOW_THREADS;
+
+    /* Large kernels are drawn a run of bits at a time, split over threads.
+     * The run based operations can't read from the output mask. */
+    if (output != a && output != b) {
+        prepared = bitmask_convolution_init(&conv, a, b, xoffset, yoffset);
+    }
+
+    if (prepared > 0) {
+        compose_parallel(output, conv.ops, conv.nops,
+                         (Py_ssize_t)conv.nops *
+                             (a->w / BITMASK_W_LEN + 2) * a->h);
+        bitmask_convolution_free(&conv);
+    }
+    else if (prepared == 0) {
+        bitmask_convolve_bits(a, b, output, xoffset, yoffset);
+    }
+
+    Py_END_ALLOW_THREADS;
+
+    if (prepared < 0) {
+        Py_DECREF(oobj);
+        return PyErr_NoMemory();
+    }
 
     return oobj;
 }
 
+/* Distances are kept column major (index x * h + y) to match the [x][y]
+ * indexing of the returned array. */
+typedef struct {
+    const bitmask_t *mask;
+    int *coldist; /* distance to the nearest set bit in the column, or -1 */
+    void *out;
+    int as_uint8;
+    int failed;
+} distance_field_data;
+
+/* First pass of the distance transform: the distance from each bit to the
+ * nearest set bit in its own column. */
+static void
+distance_field_columns(void *arg, int start, int end)
+{
+    distance_field_data *data = (distance_field_data *)arg;
+    const bitmask_t *m = data->mask;
+    int x, y, last, h = m->h;
+
+    for (x = start; x < end; x++) {
+        int *col = data->coldist + (Py_ssize_t)x * h;
+
+        /* Nearest set bit above (or at) each position. */
+        for (y = 0, last = -1; y < h; y++) {
+            if (bitmask_getbit(m, x, y)) {
+                last = y;
+            }
+            col[y] = (last < 0) ? -1 : y - last;
+        }
+
+        /* Nearest set bit below each position. */
+        for (y = h - 1, last = -1; y >= 0; y--) {
+            if (0 == col[y]) {
+                last = y;
+            }
+            else if (last >= 0 && (col[y] < 0 || last - y < col[y])) {
+                col[y] = last - y;
+            }
+        }
+    }
+}
+
+static PG_INLINE void
+distance_field_store(distance_field_data *data, Py_ssize_t index, double dist)
+{
+    if (data->as_uint8) {
+        ((Uint8 *)data->out)[index] =
+            (dist >= 254.5) ? 255 : (Uint8)(dist + 0.5);
+    }
+    else {
+        ((float *)data->out)[index] = (float)dist;
+    }
+}
+
+/* Second pass of the distance transform: the lower envelope of the parabolas
+ * (x - q)^2 + coldist(q)^2 along each row, see Felzenszwalb and Huttenlocher,
+ * "Distance Transforms of Sampled Functions". */
+static void
+distance_field_rows(void *arg, int start, int end)
+{
+    distance_field_data *data = (distance_field_data *)arg;
+    int w = data->mask->w, h = data->mask->h;
+    int x, y, k;
+    double s = 0.0, dist;
+    int *v = PyMem_RawMalloc(w * sizeof(int));
+    double *z = PyMem_RawMalloc((w + 1) * sizeof(double));
+    double *f = PyMem_RawMalloc(w * sizeof(double));
+
+    if (NULL == v || NULL == z || NULL == f) {
+        data->failed = 1;
+        goto rows_cleanup;
+    }
+
+    for (y = start; y < end; y++) {
+        /* Build the lower envelope from the columns that have a set bit. */
+        for (x = 0, k = -1; x < w; x++) {
+            int dy = data->coldist[(Py_ssize_t)x * h + y];
+
+            if (dy < 0) {
+                continue;
+            }
+
+            f[x] = (double)dy * dy;
+
+            while (k >= 0) {
+                s = ((f[x] + (double)x * x) -
+                     (f[v[k]] + (double)v[k] * v[k])) /
+                    (2.0 * (x - v[k]));
+
+                if (s > z[k]) {
+                    break;
+                }
+                k--;
+            }
+
+            k++;
+            v[k] = x;
+            z[k] = k ? s : -HUGE_VAL;
+            z[k + 1] = HUGE_VAL;
+        }
+
+        if (k < 0) {
+            /* No set bits anywhere in the mask. */
+            for (x = 0; x < w; x++) {
+                distance_field_store(data, (Py_ssize_t)x * h + y, HUGE_VAL);
+            }
+            continue;
+        }
+
+        for (x = 0, k = 0; x < w; x++) {
+            while (z[k + 1] < x) {
+                k++;
+            }
+            dist = sqrt((double)(x - v[k]) * (x - v[k]) + f[v[k]]);
+            distance_field_store(data, (Py_ssize_t)x * h + y, dist);
+        }
+    }
+
+rows_cleanup:
+    PyMem_RawFree(v);
+    PyMem_RawFree(z);
+    PyMem_RawFree(f);
+}
+
+/* Calculates the exact euclidean distance from every bit to the nearest set
+ * bit in linear time. Both passes are split over threads with the GIL
+ * released.
+ */
+static PyObject *
+mask_distance_field(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    bitmask_t *mask = pgMask_AsBitmap(self);
+    PyObject *bytearray, *proxy;
+    distance_field_data data;
+    const char *format = "f";
+    const char *typestr;
+    Py_ssize_t itemsize, npixels;
+    static char *keywords[] = {"format", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|s", keywords, &format)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (0 == strcmp(format, "f")) {
+        data.as_uint8 = 0;
+        itemsize = sizeof(float);
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        typestr = "<f4";
+#else
+        typestr = ">f4";
+#endif
+    }
+    else if (0 == strcmp(format, "B")) {
+        data.as_uint8 = 1;
+        itemsize = 1;
+        typestr = "|u1";
+    }
+    else {
+        return RAISE(PyExc_ValueError, "format must be 'f' or 'B'");
+    }
+
+    npixels = (Py_ssize_t)mask->w * mask->h;
+    bytearray = PyByteArray_FromStringAndSize(NULL, npixels * itemsize);
+
+    if (NULL == bytearray) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (npixels) {
+        data.mask = mask;
+        data.out = PyByteArray_AS_STRING(bytearray);
+        data.failed = 0;
+        data.coldist = PyMem_New(int, npixels);
+
+        if (NULL == data.coldist) {
+            Py_DECREF(bytearray);
+            return PyErr_NoMemory();
+        }
+
+        /* Give each thread at least 64K bits of work. */
+        Py_BEGIN_ALLOW_THREADS;
+        pg_parallel_for(mask->w, MAX(1, 0x10000 / mask->h),
+                        distance_field_columns, &data);
+        pg_parallel_for(mask->h, MAX(1, 0x10000 / mask->w),
+                        distance_field_rows, &data);
+        Py_END_ALLOW_THREADS;
+
+        PyMem_Free(data.coldist);
+
+        if (data.failed) {
+            Py_DECREF(bytearray);
+            return PyErr_NoMemory();
+        }
+    }
+
+    proxy = array_proxy_from_bytearray(bytearray, typestr, mask->w, mask->h);
+    Py_DECREF(bytearray);
+    return proxy;
+}
+
 /* Gets the color of a given pixel.
  *
  * Params:
@@ -1080,6 +1996,9 @@ mask_from_threshold(PyObject *self, PyObject *args, PyObject *kwargs)
 
     if (PyLong_Check(rgba_obj_color)) {
         color = (Uint32)PyLong_AsLong(rgba_obj_color);
+        if (color == (Uint32)-1 && PyErr_Occurred()) {
+            return NULL; /* Exception already set. */
+        }
     }
     else if (PyLong_Check(rgba_obj_color)) {
         color = (Uint32)PyLong_AsUnsignedLong(rgba_obj_color);
@@ -1093,8 +2012,12 @@ mask_from_threshold(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 
     if (rgba_obj_threshold) {
-        if (PyLong_Check(rgba_obj_threshold))
+        if (PyLong_Check(rgba_obj_threshold)) {
             color_threshold = (Uint32)PyLong_AsLong(rgba_obj_threshold);
+            if (color_threshold == (Uint32)-1 && PyErr_Occurred()) {
+                return NULL; /* Exception already set. */
+            }
+        }
         else if (PyLong_Check(rgba_obj_threshold))
             color_threshold =
                 (Uint32)PyLong_AsUnsignedLong(rgba_obj_threshold);
@@ -2302,6 +3225,9 @@ mask_to_surface(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 
     if (!created_surfobj) {
+        SDL_Rect drawn = {x_dest, y_dest, bitmask->w, bitmask->h};
+
+        pgSurface_AddDamage((pgSurfaceObject *)surfobj, &drawn);
         /* Only increase ref count if this func didn't create the surfobj. */
         Py_INCREF(surfobj);
     }
@@ -2339,17 +3265,25 @@ static PyMethodDef mask_methods[] = {
     {"invert", mask_invert, METH_NOARGS, DOC_MASKINVERT},
     {"scale", (PyCFunction)mask_scale, METH_VARARGS | METH_KEYWORDS,
      DOC_MASKSCALE},
+    {"rotate", (PyCFunction)mask_rotate, METH_VARARGS | METH_KEYWORDS,
+     DOC_MASKROTATE},
     {"draw", (PyCFunction)mask_draw, METH_VARARGS | METH_KEYWORDS,
      DOC_MASKDRAW},
     {"erase", (PyCFunction)mask_erase, METH_VARARGS | METH_KEYWORDS,
      DOC_MASKERASE},
+    {"compose", (PyCFunction)mask_compose, METH_VARARGS | METH_KEYWORDS,
+     DOC_MASKCOMPOSE},
     {"count", mask_count, METH_NOARGS, DOC_MASKCOUNT},
     {"centroid", mask_centroid, METH_NOARGS, DOC_MASKCENTROID},
     {"angle", mask_angle, METH_NOARGS, DOC_MASKANGLE},
     {"outline", (PyCFunction)mask_outline, METH_VARARGS | METH_KEYWORDS,
      DOC_MASKOUTLINE},
+    {"contours", (PyCFunction)mask_contours, METH_VARARGS | METH_KEYWORDS,
+     DOC_MASKCONTOURS},
     {"convolve", (PyCFunction)mask_convolve, METH_VARARGS | METH_KEYWORDS,
      DOC_MASKCONVOLVE},
+    {"distance_field", (PyCFunction)mask_distance_field,
+     METH_VARARGS | METH_KEYWORDS, DOC_MASKDISTANCEFIELD},
     {"connected_component", (PyCFunction)mask_connected_component,
      METH_VARARGS | METH_KEYWORDS, DOC_MASKCONNECTEDCOMPONENT},
     {"connected_components", (PyCFunction)mask_connected_components,
@@ -2562,6 +3496,284 @@ static PyTypeObject pgMask_Type = {
     .tp_new = mask_new,
 };
 
+/********** rotation cache object **********/
+
+/* Holds a mask rotated to evenly spaced angles, so the mask for any angle
+ * can be looked up without rotating anything. masks[i] is the source mask
+ * rotated by rotationcache_angle(steps, i) degrees.
+ */
+typedef struct {
+    PyObject_HEAD int steps;
+    Py_ssize_t nbytes;
+    PyObject **masks;
+} pgRotationCacheObject;
+
+/* Default bound on the memory of a rotation cache, 64 MiB. */
+#define ROTATIONCACHE_MAX_BYTES ((Py_ssize_t)64 * 1024 * 1024)
+
+/* Number of bytes bitmask_create() allocates for a w*h bitmask. */
+static Py_ssize_t
+bitmask_nbytes(int w, int h)
+{
+    Py_ssize_t size = offsetof(bitmask_t, bits);
+
+    if (w && h) {
+        size += (Py_ssize_t)h * ((w - 1) / BITMASK_W_LEN + 1) *
+                sizeof(BITMASK_W);
+    }
+
+    return size;
+}
+
+/* The angle of the index'th step. Stored as a float, the same precision
+ * Mask.rotate() uses, so the cache gives the same result as rotating. */
+static PG_INLINE double
+rotationcache_angle(int steps, int index)
+{
+    return (float)(index * 360.0 / steps);
+}
+
+/* The index of the step nearest to the given angle. */
+static PG_INLINE int
+rotationcache_index(int steps, double angle)
+{
+    int index = (int)floor(fmod(angle, 360.0) * steps / 360.0 + 0.5) % steps;
+
+    return (index < 0) ? index + steps : index;
+}
+
+static void
+rotationcache_clear(pgRotationCacheObject *self)
+{
+    int i;
+
+    if (NULL != self->masks) {
+        for (i = 0; i < self->steps; i++) {
+            Py_XDECREF(self->masks[i]);
+        }
+        PyMem_Free(self->masks);
+    }
+
+    self->masks = NULL;
+    self->steps = 0;
+    self->nbytes = 0;
+}
+
+static void
+rotationcache_dealloc(PyObject *self)
+{
+    rotationcache_clear((pgRotationCacheObject *)self);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int
+rotationcache_init(pgRotationCacheObject *self, PyObject *args,
+                   PyObject *kwargs)
+{
+    PyObject *maskobj;
+    PyObject *max_bytes_obj = NULL;
+    PyObject **masks = NULL;
+    bitmask_t **bitmasks = NULL;
+    bitmask_t *mask;
+    Py_ssize_t max_bytes = ROTATIONCACHE_MAX_BYTES, nbytes = 0;
+    int steps = 360, i, w, h, failed = 0;
+    static char *keywords[] = {"mask", "steps", "max_bytes", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|iO", keywords,
+                                     &pgMask_Type, &maskobj, &steps,
+                                     &max_bytes_obj)) {
+        return -1;
+    }
+
+    if (steps < 1) {
+        PyErr_SetString(PyExc_ValueError, "steps must be a positive integer");
+        return -1;
+    }
+
+    if (max_bytes_obj == Py_None) {
+        max_bytes = -1; /* no limit */
+    }
+    else if (max_bytes_obj != NULL) {
+        max_bytes = PyNumber_AsSsize_t(max_bytes_obj, PyExc_OverflowError);
+
+        if (-1 == max_bytes && PyErr_Occurred()) {
+            return -1;
+        }
+
+        if (max_bytes < 0) {
+            PyErr_SetString(PyExc_ValueError, "max_bytes must be positive");
+            return -1;
+        }
+    }
+
+    mask = pgMask_AsBitmap(maskobj);
+
+    /* Check the memory bound before rotating anything, the size of every
+     * rotated mask is known up front. */
+    for (i = 0; i < steps; i++) {
+        bitmask_rotated_size(mask->w, mask->h, rotationcache_angle(steps, i),
+                             &w, &h);
+        nbytes += bitmask_nbytes(w, h) + pgMask_Type.tp_basicsize;
+
+        if (max_bytes >= 0 && nbytes > max_bytes) {
+            break;
+        }
+    }
+
+    if (max_bytes >= 0 && nbytes > max_bytes) {
+        PyErr_Format(PyExc_ValueError,
+                     "rotation cache needs more than max_bytes (%zd) bytes",
+                     max_bytes);
+        return -1;
+    }
+
+    bitmasks = PyMem_New(bitmask_t *, steps);
+    masks = PyMem_New(PyObject *, steps);
+
+    if (NULL == bitmasks || NULL == masks) {
+        PyMem_Free(bitmasks);
+        PyMem_Free(masks);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < steps; i++) {
+        bitmasks[i] = bitmask_rotate(mask, rotationcache_angle(steps, i));
+
+        if (NULL == bitmasks[i]) {
+            failed = 1;
+            break;
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    if (failed) {
+        while (i--) {
+            bitmask_free(bitmasks[i]);
+        }
+        PyMem_Free(bitmasks);
+        PyMem_Free(masks);
+        PyErr_SetString(PyExc_MemoryError,
+                        "cannot allocate memory for bitmask");
+        return -1;
+    }
+
+    for (i = 0; i < steps; i++) {
+        masks[i] = (PyObject *)create_mask_using_bitmask(bitmasks[i]);
+
+        if (NULL == masks[i]) {
+            int j;
+
+            for (j = 0; j < i; j++) {
+                Py_DECREF(masks[j]);
+            }
+            for (j = i; j < steps; j++) {
+                bitmask_free(bitmasks[j]);
+            }
+            PyMem_Free(bitmasks);
+            PyMem_Free(masks);
+            return -1; /* Exception already set. */
+        }
+    }
+
+    PyMem_Free(bitmasks);
+
+    /* Allow __init__ to be called again. */
+    rotationcache_clear(self);
+
+    self->masks = masks;
+    self->steps = steps;
+    self->nbytes = nbytes;
+    return 0;
+}
+
+static PyObject *
+rotationcache_get(pgRotationCacheObject *self, PyObject *args,
+                  PyObject *kwargs)
+{
+    PyObject *maskobj;
+    double angle;
+    static char *keywords[] = {"angle", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d", keywords, &angle)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (NULL == self->masks) {
+        return RAISE(PyExc_RuntimeError, "RotationCache is not initialized");
+    }
+
+    if (!isfinite(angle)) {
+        return RAISE(PyExc_ValueError, "angle must be a finite number");
+    }
+
+    maskobj = self->masks[rotationcache_index(self->steps, angle)];
+    Py_INCREF(maskobj);
+    return maskobj;
+}
+
+static PyObject *
+rotationcache_quantize(pgRotationCacheObject *self, PyObject *args,
+                       PyObject *kwargs)
+{
+    double angle;
+    static char *keywords[] = {"angle", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d", keywords, &angle)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (NULL == self->masks) {
+        return RAISE(PyExc_RuntimeError, "RotationCache is not initialized");
+    }
+
+    if (!isfinite(angle)) {
+        return RAISE(PyExc_ValueError, "angle must be a finite number");
+    }
+
+    return PyFloat_FromDouble(rotationcache_angle(
+        self->steps, rotationcache_index(self->steps, angle)));
+}
+
+static Py_ssize_t
+rotationcache_len(pgRotationCacheObject *self)
+{
+    return self->steps;
+}
+
+static PyMethodDef rotationcache_methods[] = {
+    {"get", (PyCFunction)rotationcache_get, METH_VARARGS | METH_KEYWORDS,
+     DOC_ROTATIONCACHEGET},
+    {"quantize", (PyCFunction)rotationcache_quantize,
+     METH_VARARGS | METH_KEYWORDS, DOC_ROTATIONCACHEQUANTIZE},
+    {NULL, NULL, 0, NULL}};
+
+static PyMemberDef rotationcache_members[] = {
+    {"steps", T_INT, offsetof(pgRotationCacheObject, steps), READONLY,
+     DOC_ROTATIONCACHESTEPS},
+    {"nbytes", T_PYSSIZET, offsetof(pgRotationCacheObject, nbytes), READONLY,
+     DOC_ROTATIONCACHENBYTES},
+    {NULL} /* Sentinel */
+};
+
+static PySequenceMethods rotationcache_as_sequence = {
+    .sq_length = (lenfunc)rotationcache_len,
+};
+
+static PyTypeObject pgRotationCache_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.mask.RotationCache",
+    .tp_basicsize = sizeof(pgRotationCacheObject),
+    .tp_dealloc = rotationcache_dealloc,
+    .tp_as_sequence = &rotationcache_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEMASKROTATIONCACHE,
+    .tp_methods = rotationcache_methods,
+    .tp_members = rotationcache_members,
+    .tp_init = (initproc)rotationcache_init,
+    .tp_new = PyType_GenericNew,
+};
+
 /*mask module methods*/
 static PyMethodDef _mask_methods[] = {
     {"from_surface", (PyCFunction)mask_from_surface,
@@ -2604,12 +3816,20 @@ MODINIT_DEFINE(mask)
     if (PyErr_Occurred()) {
         return NULL;
     }
+    import_pygame_bufferproxy();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
 
     /* create the mask type */
     if (PyType_Ready(&pgMask_Type) < 0) {
         return NULL;
     }
 
+    if (PyType_Ready(&pgRotationCache_Type) < 0) {
+        return NULL;
+    }
+
     /* create the module */
     module = PyModule_Create(&_module);
     if (module == NULL) {
@@ -2629,6 +3849,14 @@ MODINIT_DEFINE(mask)
         return NULL;
     }
 
+    Py_INCREF(&pgRotationCache_Type);
+    if (PyModule_AddObject(module, "RotationCache",
+                           (PyObject *)&pgRotationCache_Type)) {
+        Py_DECREF(&pgRotationCache_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
     /* export the c api */
     c_api[0] = &pgMask_Type;
     apiobj = encapsulate_api(c_api, "mask");
@@ -27,7 +27,6 @@
 #endif
 
 #define PYGAMEAPI_MATH_INTERNAL
-#define NO_PYGAME_C_API
 #include "doc/math_doc.h"
 
 #include "pygame.h"
@@ -36,6 +35,7 @@
 
 #include "pgcompat.h"
 
+
 #include <float.h>
 #include <math.h>
 #include <stddef.h>
@@ -56,6 +56,7 @@
 #define VECTOR_MAX_SIZE (4)
 #define STRING_BUF_SIZE_REPR (112)
 #define STRING_BUF_SIZE_STR (103)
+#define STRING_BUF_SIZE_MATRIX_REPR (600)
 #define SWIZZLE_ERR_NO_ERR 0
 #define SWIZZLE_ERR_DOUBLE_IDX 1
 #define SWIZZLE_ERR_EXTRACTION_ERR 2
@@ -81,22 +82,59 @@ static PyTypeObject pgVector2_Type;
 static PyTypeObject pgVector3_Type;
 static PyTypeObject pgVectorElementwiseProxy_Type;
 static PyTypeObject pgVectorIter_Type;
+static PyTypeObject pgVector2Array_Type;
+static PyTypeObject pgVector3Array_Type;
+static PyTypeObject pgMatrix3_Type;
+static PyTypeObject pgMatrix4_Type;
 
 #define pgVector2_Check(x) (PyType_IsSubtype(Py_TYPE(x), &pgVector2_Type))
 #define pgVector3_Check(x) (PyType_IsSubtype(Py_TYPE(x), &pgVector3_Type))
 #define pgVector_Check(x) (pgVector2_Check(x) || pgVector3_Check(x))
 #define vector_elementwiseproxy_Check(x) \
     (Py_TYPE(x) == &pgVectorElementwiseProxy_Type)
+#define pgVectorArray_Check(x)             \
+    (Py_TYPE(x) == &pgVector2Array_Type || \
+     Py_TYPE(x) == &pgVector3Array_Type)
+#define pgMatrix_Check(x) \
+    (Py_TYPE(x) == &pgMatrix3_Type || Py_TYPE(x) == &pgMatrix4_Type)
 
 #define DEG2RAD(angle) ((angle)*M_PI / 180.)
 #define RAD2DEG(angle) ((angle)*180. / M_PI)
 
 typedef struct {
-    PyObject_HEAD double *coords; /* Coordinates */
-    Py_ssize_t dim;               /* Dimension of the vector */
-    double epsilon;               /* Small value for comparisons */
+    PyObject_HEAD double coords[VECTOR_MAX_SIZE]; /* Coordinates */
+    Py_ssize_t dim;                               /* Dimension of the vector */
+    double epsilon;                               /* Used in comparisons */
 } pgVector;
 
+typedef struct {
+    PyObject_HEAD double *data; /* Coordinates, one vector after the other */
+    Py_ssize_t length;          /* Number of vectors */
+    Py_ssize_t dim;             /* Dimension of the vectors */
+    Py_ssize_t shape[2];        /* For the buffer */
+    Py_ssize_t strides[2];
+} pgVectorArray;
+
+typedef struct {
+    PyObject_HEAD double m[16]; /* Elements, row after row */
+    Py_ssize_t size;            /* 3 or 4 rows and columns */
+    Py_ssize_t shape[2];        /* For the buffer */
+    Py_ssize_t strides[2];
+} pgMatrix;
+
+/* Deallocated vectors of the exact Vector2 and Vector3 types are kept here
+ * and reused by the next vector of the same type, so the temporaries made
+ * by arithmetic don't each go through the allocator. Subclasses are
+ * allocated as usual.
+ */
+#ifndef PYPY_VERSION
+#define VECTOR_FREELIST_MAX 256
+#define VECTOR_FREELIST_INDEX(type) \
+    ((type) == &pgVector2_Type ? 0 : (type) == &pgVector3_Type ? 1 : -1)
+static pgVector *vector_freelist[2][VECTOR_FREELIST_MAX];
+static int vector_freelist_num[2] = {0, 0};
+#endif
+
 typedef struct {
     PyObject_HEAD long it_index;
     pgVector *vec;
@@ -130,7 +168,7 @@ _vector_coords_from_string(PyObject *str, char **delimiter, double *coords,
                            Py_ssize_t dim);
 static void
 _vector_move_towards_helper(Py_ssize_t dim, double *origin_coords,
-                            double *target_coords, double max_distance);
+                            const double *target_coords, double max_distance);
 
 /* generic vector functions */
 static pgVector *
@@ -223,6 +261,11 @@ vector_slerp(pgVector *self, PyObject *args);
 static PyObject *
 vector_lerp(pgVector *self, PyObject *args);
 static int
+_vector_reflect_normal(double *norm_coords, Py_ssize_t dim, double epsilon);
+static void
+_vector_reflect_coords(double *dst_coords, const double *src_coords,
+                       const double *norm_coords, Py_ssize_t dim);
+static int
 _vector_reflect_helper(double *dst_coords, const double *src_coords,
                        PyObject *normal, Py_ssize_t dim, double epsilon);
 static PyObject *
@@ -379,16 +422,45 @@ PySequence_GetItem_AsDouble(PyObject *seq, Py_ssize_t index)
     return value;
 }
 
+/* Reads an exact float or int, returns 0 for other types. */
+static int
+_vector_fast_number(PyObject *obj, double *value)
+{
+    if (PyFloat_CheckExact(obj)) {
+        *value = PyFloat_AS_DOUBLE(obj);
+        return 1;
+    }
+    if (PyLong_CheckExact(obj)) {
+        *value = PyLong_AsDouble(obj);
+        return 1;
+    }
+    return 0;
+}
+
 static int
 PySequence_AsVectorCoords(PyObject *seq, double *const coords,
                           const Py_ssize_t size)
 {
     Py_ssize_t i;
+    PyObject **items;
 
     if (pgVector_Check(seq)) {
         memcpy(coords, ((pgVector *)seq)->coords, sizeof(double) * size);
         return 1;
     }
+    /* Tuples and lists of floats and ints are read without the sequence
+     * protocol, other numbers in them are left to the loop below. */
+    if ((PyTuple_CheckExact(seq) || PyList_CheckExact(seq)) &&
+        PySequence_Fast_GET_SIZE(seq) == size) {
+        items = PySequence_Fast_ITEMS(seq);
+        for (i = 0; i < size; ++i) {
+            if (!_vector_fast_number(items[i], coords + i))
+                break;
+        }
+        if (i == size) {
+            return !PyErr_Occurred();
+        }
+    }
     if (!PySequence_Check(seq) || PySequence_Length(seq) != size) {
         PyErr_SetString(PyExc_ValueError, "Sequence has the wrong length.");
         return 0;
@@ -434,6 +506,21 @@ pgVectorCompatible_Check(PyObject *obj, Py_ssize_t dim)
             return 0;
     }
 
+    /* Tuples and lists are checked without the sequence protocol. */
+    if (PyTuple_CheckExact(obj) || PyList_CheckExact(obj)) {
+        if (PySequence_Fast_GET_SIZE(obj) != dim) {
+            return 0;
+        }
+        for (i = 0; i < dim; ++i) {
+            tmp = PySequence_Fast_GET_ITEM(obj, i);
+            if (!PyFloat_CheckExact(tmp) && !PyLong_CheckExact(tmp) &&
+                !RealNumber_Check(tmp)) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+
     if (!PySequence_Check(obj) || (PySequence_Length(obj) != dim)) {
         return 0;
     }
@@ -554,6 +641,35 @@ static PyMemberDef vector_members[] = {
     {NULL} /* Sentinel */
 };
 
+/* Allocates a vector of type with zeroed coordinates, from the freelist
+ * when there is one for type.
+ */
+static pgVector *
+_vector_alloc(PyTypeObject *type, Py_ssize_t dim)
+{
+    pgVector *vec;
+#ifndef PYPY_VERSION
+    int list = VECTOR_FREELIST_INDEX(type);
+
+    if (list >= 0 && vector_freelist_num[list] > 0) {
+        vec = vector_freelist[list][--vector_freelist_num[list]];
+        (void)PyObject_Init((PyObject *)vec, type);
+        memset(vec->coords, 0, sizeof(vec->coords));
+    }
+    else {
+        vec = (pgVector *)type->tp_alloc(type, 0);
+    }
+#else
+    vec = (pgVector *)type->tp_alloc(type, 0);
+#endif
+
+    if (vec != NULL) {
+        vec->dim = dim;
+        vec->epsilon = VECTOR_EPSILON;
+    }
+    return vec;
+}
+
 static pgVector *
 _vector_subtype_new(pgVector *base)
 {
@@ -561,17 +677,17 @@ _vector_subtype_new(pgVector *base)
     PyTypeObject *type = Py_TYPE(base);
     Py_ssize_t dim = base->dim;
 
+#ifndef PYPY_VERSION
+    if (VECTOR_FREELIST_INDEX(type) >= 0) {
+        return _vector_alloc(type, dim);
+    }
+#endif
+
     vec = (pgVector *)(type->tp_new(type, NULL, NULL));
 
     if (vec) {
         vec->dim = dim;
         vec->epsilon = VECTOR_EPSILON;
-        vec->coords = PyMem_New(double, dim);
-
-        if (vec->coords == NULL) {
-            Py_DECREF(vec);
-            return (pgVector *)PyErr_NoMemory();
-        }
     }
     return vec;
 }
@@ -579,42 +695,33 @@ _vector_subtype_new(pgVector *base)
 static PyObject *
 pgVector_NEW(Py_ssize_t dim)
 {
-    pgVector *vec;
     switch (dim) {
         case 2:
-            vec = PyObject_New(pgVector, &pgVector2_Type);
-            break;
+            return (PyObject *)_vector_alloc(&pgVector2_Type, dim);
         case 3:
-            vec = PyObject_New(pgVector, &pgVector3_Type);
-            break;
+            return (PyObject *)_vector_alloc(&pgVector3_Type, dim);
             /*
                 case 4:
-                    vec = PyObject_New(pgVector, &pgVector4_Type);
-                    break;
+                    return (PyObject *)_vector_alloc(&pgVector4_Type, dim);
             */
         default:
             PyErr_SetString(PyExc_SystemError,
                             "Wrong internal call to pgVector_NEW.\n");
             return NULL;
     }
-
-    if (vec != NULL) {
-        vec->dim = dim;
-        vec->epsilon = VECTOR_EPSILON;
-        vec->coords = PyMem_New(double, dim);
-        if (vec->coords == NULL) {
-            Py_DECREF(vec);
-            return PyErr_NoMemory();
-        }
-    }
-
-    return (PyObject *)vec;
 }
 
 static void
 vector_dealloc(pgVector *self)
 {
-    PyMem_Free(self->coords);
+#ifndef PYPY_VERSION
+    int list = VECTOR_FREELIST_INDEX(Py_TYPE(self));
+
+    if (list >= 0 && vector_freelist_num[list] < VECTOR_FREELIST_MAX) {
+        vector_freelist[list][vector_freelist_num[list]++] = self;
+        return;
+    }
+#endif
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
@@ -628,7 +735,7 @@ vector_generic_math(PyObject *o1, PyObject *o2, int op)
     Py_ssize_t i, dim;
     double *vec_coords;
     double other_coords[VECTOR_MAX_SIZE] = {0};
-    double tmp;
+    double tmp, number = 0;
     PyObject *other;
     pgVector *vec, *ret = NULL;
     if (pgVector_Check(o1)) {
@@ -649,13 +756,23 @@ vector_generic_math(PyObject *o1, PyObject *o2, int op)
         return NULL;
     }
 
-    if (pgVectorCompatible_Check(other, dim)) {
+    /* Floats and ints are checked first, they are the most common. */
+    if (_vector_fast_number(other, &number)) {
+        if (number == -1.0 && PyErr_Occurred())
+            return NULL;
+        op |= OP_ARG_NUMBER;
+    }
+    else if (pgVectorCompatible_Check(other, dim)) {
         op |= OP_ARG_VECTOR;
         if (!PySequence_AsVectorCoords(other, other_coords, dim))
             return NULL;
     }
-    else if (RealNumber_Check(other))
+    else if (RealNumber_Check(other)) {
         op |= OP_ARG_NUMBER;
+        number = PyFloat_AsDouble(other);
+        if (number == -1.0 && PyErr_Occurred())
+            return NULL;
+    }
     else
         op |= OP_ARG_UNKNOWN;
 
@@ -696,25 +813,24 @@ vector_generic_math(PyObject *o1, PyObject *o2, int op)
         case OP_MUL | OP_ARG_NUMBER:
         case OP_MUL | OP_ARG_NUMBER | OP_ARG_REVERSE:
         case OP_MUL | OP_ARG_NUMBER | OP_INPLACE:
-            tmp = PyFloat_AsDouble(other);
+            tmp = number;
             for (i = 0; i < dim; i++)
                 ret->coords[i] = vec_coords[i] * tmp;
             break;
         case OP_DIV | OP_ARG_NUMBER:
         case OP_DIV | OP_ARG_NUMBER | OP_INPLACE:
-            tmp = PyFloat_AsDouble(other);
+            tmp = number;
             if (tmp == 0.) {
                 PyErr_SetString(PyExc_ZeroDivisionError, "division by zero");
                 Py_DECREF(ret);
                 return NULL;
             }
-            tmp = 1. / tmp;
             for (i = 0; i < dim; i++)
-                ret->coords[i] = vec_coords[i] * tmp;
+                ret->coords[i] = vec_coords[i] / tmp;
             break;
         case OP_FLOOR_DIV | OP_ARG_NUMBER:
         case OP_FLOOR_DIV | OP_ARG_NUMBER | OP_INPLACE:
-            tmp = PyFloat_AsDouble(other);
+            tmp = number;
             if (tmp == 0.) {
                 PyErr_SetString(PyExc_ZeroDivisionError, "division by zero");
                 Py_DECREF(ret);
@@ -1412,7 +1528,7 @@ vector_scale_to_length(pgVector *self, PyObject *length)
 
 static void
 _vector_move_towards_helper(Py_ssize_t dim, double *origin_coords,
-                            double *target_coords, double max_distance)
+                            const double *target_coords, double max_distance)
 {
     Py_ssize_t i;
     double delta[VECTOR_MAX_SIZE];
@@ -1606,23 +1722,16 @@ vector_lerp(pgVector *self, PyObject *args)
     return (PyObject *)ret;
 }
 
+/* Normalizes the normal, returns 0 if it is too short to have a direction.
+ * Doesn't set an exception, so it can be used without the GIL.
+ */
 static int
-_vector_reflect_helper(double *dst_coords, const double *src_coords,
-                       PyObject *normal, Py_ssize_t dim, double epsilon)
+_vector_reflect_normal(double *norm_coords, Py_ssize_t dim, double epsilon)
 {
     Py_ssize_t i;
-    double dot_product, norm_length;
-    double norm_coords[VECTOR_MAX_SIZE];
-
-    /* normalize the normal */
-    if (!PySequence_AsVectorCoords(normal, norm_coords, dim))
-        return 0;
-
-    norm_length = _scalar_product(norm_coords, norm_coords, dim);
+    double norm_length = _scalar_product(norm_coords, norm_coords, dim);
 
     if (norm_length < epsilon) {
-        PyErr_SetString(PyExc_ValueError,
-                        "Normal must not be of length zero.");
         return 0;
     }
     if (norm_length != 1) {
@@ -1630,12 +1739,41 @@ _vector_reflect_helper(double *dst_coords, const double *src_coords,
         for (i = 0; i < dim; ++i)
             norm_coords[i] /= norm_length;
     }
+    return 1;
+}
 
+/* Reflects src_coords off a normal of length 1, dst_coords may be
+ * src_coords.
+ */
+static void
+_vector_reflect_coords(double *dst_coords, const double *src_coords,
+                       const double *norm_coords, Py_ssize_t dim)
+{
+    Py_ssize_t i;
     /* calculate the dot_product for the projection */
-    dot_product = _scalar_product(src_coords, norm_coords, dim);
+    double dot_product = _scalar_product(src_coords, norm_coords, dim);
 
     for (i = 0; i < dim; ++i)
         dst_coords[i] = src_coords[i] - 2 * norm_coords[i] * dot_product;
+}
+
+static int
+_vector_reflect_helper(double *dst_coords, const double *src_coords,
+                       PyObject *normal, Py_ssize_t dim, double epsilon)
+{
+    double norm_coords[VECTOR_MAX_SIZE];
+
+    /* normalize the normal */
+    if (!PySequence_AsVectorCoords(normal, norm_coords, dim))
+        return 0;
+
+    if (!_vector_reflect_normal(norm_coords, dim, epsilon)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Normal must not be of length zero.");
+        return 0;
+    }
+
+    _vector_reflect_coords(dst_coords, src_coords, norm_coords, dim);
     return 1;
 }
 
@@ -1837,24 +1975,31 @@ vector_getAttr_swizzle(pgVector *self, PyObject *attr_name)
     const char *attr = NULL;
     PyObject *res = NULL;
 
-    len = PySequence_Length(attr_name);
-
-    if (len == 1) {
-        return PyObject_GenericGetAttr((PyObject *)self, attr_name);
+    if (PyUnicode_CheckExact(attr_name)) {
+        /* Attribute names are almost always exact ASCII strings, whose
+         * UTF-8 is their data, so read it in place. */
+        attr = PyUnicode_AsUTF8AndSize(attr_name, &len);
+        if (attr == NULL)
+            return NULL;
+    }
+    else {
+        len = PySequence_Length(attr_name);
+        if (len == 1) {
+            return PyObject_GenericGetAttr((PyObject *)self, attr_name);
+        }
+        if (len < 0)
+            goto swizzle_failed;
+        attr_unicode = PyUnicode_FromObject(attr_name);
+        if (attr_unicode == NULL)
+            goto swizzle_failed;
+        attr = PyUnicode_AsUTF8AndSize(attr_unicode, &len);
+        if (attr == NULL)
+            goto internal_error;
     }
-
-    if (len < 0)
-        goto swizzle_failed;
     coords = self->coords;
-    attr_unicode = PyUnicode_FromObject(attr_name);
-    if (attr_unicode == NULL)
-        goto swizzle_failed;
-    attr = PyUnicode_AsUTF8AndSize(attr_unicode, &len);
-    if (attr == NULL)
-        goto internal_error;
     /* If we are not a swizzle, go straight to GenericGetAttr. */
-    if ((attr[0] != 'x') && (attr[0] != 'y') && (attr[0] != 'z') &&
-        (attr[0] != 'w')) {
+    if (len < 2 || ((attr[0] != 'x') && (attr[0] != 'y') &&
+                    (attr[0] != 'z') && (attr[0] != 'w'))) {
         goto swizzle_failed;
     }
 
@@ -1903,7 +2048,7 @@ vector_getAttr_swizzle(pgVector *self, PyObject *attr_name)
         }
     }
     /* swizzling succeeded! */
-    Py_DECREF(attr_unicode);
+    Py_XDECREF(attr_unicode);
     return res;
 
     /* swizzling failed! clean up and return NULL */
@@ -2077,19 +2222,7 @@ static PyBufferProcs vector_as_buffer = {
 static PyObject *
 vector2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    pgVector *vec = (pgVector *)type->tp_alloc(type, 0);
-
-    if (vec != NULL) {
-        vec->dim = 2;
-        vec->epsilon = VECTOR_EPSILON;
-        vec->coords = PyMem_New(double, vec->dim);
-        if (vec->coords == NULL) {
-            Py_TYPE(vec)->tp_free((PyObject *)vec);
-            return NULL;
-        }
-    }
-
-    return (PyObject *)vec;
+    return (PyObject *)_vector_alloc(type, 2);
 }
 
 static int
@@ -2505,19 +2638,7 @@ static PyTypeObject pgVector2_Type = {
 static PyObject *
 vector3_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    pgVector *vec = (pgVector *)type->tp_alloc(type, 0);
-
-    if (vec != NULL) {
-        vec->dim = 3;
-        vec->epsilon = VECTOR_EPSILON;
-        vec->coords = PyMem_New(double, vec->dim);
-        if (vec->coords == NULL) {
-            Py_TYPE(vec)->tp_free((PyObject *)vec);
-            return NULL;
-        }
-    }
-
-    return (PyObject *)vec;
+    return (PyObject *)_vector_alloc(type, 3);
 }
 
 static int
@@ -3175,7 +3296,7 @@ vector3_cross(pgVector *self, PyObject *other)
     pgVector *ret;
     double *ret_coords;
     double *self_coords;
-    double *other_coords;
+    double other_coords[VECTOR_MAX_SIZE];
 
     if (!pgVectorCompatible_Check(other, self->dim)) {
         PyErr_SetString(PyExc_TypeError, "cannot calculate cross Product");
@@ -3183,25 +3304,12 @@ vector3_cross(pgVector *self, PyObject *other)
     }
 
     self_coords = self->coords;
-    if (pgVector_Check(other)) {
-        other_coords = ((pgVector *)other)->coords;
-    }
-    else {
-        other_coords = PyMem_New(double, self->dim);
-        if (!other_coords) {
-            return PyErr_NoMemory();
-        }
-
-        if (!PySequence_AsVectorCoords(other, other_coords, 3)) {
-            PyMem_Free(other_coords);
-            return NULL;
-        }
+    if (!PySequence_AsVectorCoords(other, other_coords, 3)) {
+        return NULL;
     }
 
     ret = _vector_subtype_new(self);
     if (ret == NULL) {
-        if (!pgVector_Check(other))
-            PyMem_Free(other_coords);
         return NULL;
     }
     ret_coords = ret->coords;
@@ -3212,9 +3320,6 @@ vector3_cross(pgVector *self, PyObject *other)
     ret_coords[2] = ((self_coords[0] * other_coords[1]) -
                      (self_coords[1] * other_coords[0]));
 
-    if (!pgVector_Check(other))
-        PyMem_Free(other_coords);
-
     return (PyObject *)ret;
 }
 
@@ -3534,13 +3639,9 @@ vector_elementwiseproxy_richcompare(PyObject *o1, PyObject *o2, int op)
     dim = vec->dim;
 
     if (pgVectorCompatible_Check(other, dim)) {
-        double *other_coords = PyMem_New(double, dim);
+        double other_coords[VECTOR_MAX_SIZE];
 
-        if (other_coords == NULL) {
-            return NULL;
-        }
         if (!PySequence_AsVectorCoords(other, other_coords, dim)) {
-            PyMem_Free(other_coords);
             return NULL;
         }
         /* use diff == diff to check for NaN */
@@ -3597,11 +3698,9 @@ vector_elementwiseproxy_richcompare(PyObject *o1, PyObject *o2, int op)
                 }
                 break;
             default:
-                PyMem_Free(other_coords);
                 PyErr_BadInternalCall();
                 return NULL;
         }
-        PyMem_Free(other_coords);
     }
     else if (RealNumber_Check(other)) {
         /* the following PyFloat_AsDouble call should never fail because
@@ -4085,46 +4184,2198 @@ vector_elementwise(pgVector *vec, PyObject *_null)
     return (PyObject *)proxy;
 }
 
-static PyObject *
-math_enable_swizzling(pgVector *self, PyObject *_null)
-{
-    if (PyErr_WarnEx(PyExc_DeprecationWarning,
-                     "pygame.math.enable_swizzling() is deprecated, "
-                     "and its functionality is removed. This function will be "
-                     "removed in a later version.",
-                     1) == -1) {
-        return NULL;
+/*****************************************
+ * Vector2Array and Vector3Array
+ *****************************************/
+
+/* The coordinates of all vectors are kept one vector after the other, and
+ * every batch operation is one plain loop over them that the compiler can
+ * vectorize. Arrays of at least twice VECTORARRAY_PARALLEL_MIN vectors are
+ * split over several threads, which run without the GIL.
+ */
+#define VECTORARRAY_PARALLEL_MIN 0x4000
+
+/* Batch operations, the ones from VA_CROSS on have one number as the result
+ * for each vector (VA_CROSS only for 2D vectors). */
+enum {
+    VA_ADD,          /* src + other */
+    VA_SUB,          /* src - other */
+    VA_RSUB,         /* other - src */
+    VA_SCALE,        /* src * a */
+    VA_DIV,          /* src / a */
+    VA_TRANSFORM,    /* matrix * src + offset */
+    VA_PROJECT,      /* VA_TRANSFORM divided by projection . (src, 1) */
+    VA_NORMALIZE,    /* src / |src| */
+    VA_REFLECT,      /* src reflected off the normal other */
+    VA_LERP,         /* from src to other by a */
+    VA_SLERP,        /* from src to other by a */
+    VA_MOVE_TOWARDS, /* src moved towards other by at most a */
+    VA_CLAMP,        /* src with its length clamped from a to b */
+    VA_CROSS,        /* src x other */
+    VA_DOT,          /* src . other */
+    VA_LENGTH_SQUARED,
+    VA_LENGTH,
+    VA_DISTANCE_SQUARED, /* from src to other */
+    VA_DISTANCE
+};
+
+/* Errors found by the workers, reported once they are done. */
+#define VA_ERROR_ZERO_LENGTH 1
+#define VA_ERROR_SLERP_180 2
+#define VA_ERROR_PROJECT_ZERO 3
+
+typedef struct {
+    int op;
+    Py_ssize_t dim;
+    double *dst;         /* dim coordinates or 1 number per vector */
+    const double *src;   /* dim coordinates per vector */
+    const double *other; /* dim coordinates per vector, or for all of them
+                            if other_step is 0 */
+    Py_ssize_t other_step;
+    double a, b;
+    double matrix[9]; /* VA_TRANSFORM: dim by dim, row after row */
+    double offset[3];
+    double projection[4]; /* VA_PROJECT: dim + 1 */
+    SDL_atomic_t error;
+} vectorarray_task;
+
+static PyObject *vectorarray_scalar_type = NULL; /* array.array */
+
+static void
+vectorarray_run(void *data, int start, int end)
+{
+    vectorarray_task *task = (vectorarray_task *)data;
+    const Py_ssize_t dim = task->dim, step = task->other_step;
+    const double *src = task->src, *other = task->other, *s, *o;
+    const double *m = task->matrix, *off = task->offset;
+    const double *p = task->projection;
+    double *dst = task->dst, *d;
+    double tmp[VECTOR_MAX_SIZE];
+    double length_sq, length1, length2, angle, t, f0, f1, f2;
+    Py_ssize_t i, j;
+    int error = 0;
+
+    switch (task->op) {
+        case VA_ADD:
+        case VA_SUB:
+        case VA_RSUB:
+            if (step) {
+                /* Both are whole rows of coordinates. */
+                if (task->op == VA_ADD) {
+                    for (i = start * dim; i < end * dim; i++)
+                        dst[i] = src[i] + other[i];
+                }
+                else if (task->op == VA_SUB) {
+                    for (i = start * dim; i < end * dim; i++)
+                        dst[i] = src[i] - other[i];
+                }
+                else {
+                    for (i = start * dim; i < end * dim; i++)
+                        dst[i] = other[i] - src[i];
+                }
+                break;
+            }
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                d = dst + i * dim;
+                for (j = 0; j < dim; j++) {
+                    d[j] = task->op == VA_ADD   ? s[j] + other[j]
+                           : task->op == VA_SUB ? s[j] - other[j]
+                                                : other[j] - s[j];
+                }
+            }
+            break;
+        case VA_SCALE:
+            for (i = start * dim; i < end * dim; i++)
+                dst[i] = src[i] * task->a;
+            break;
+        case VA_DIV:
+            for (i = start * dim; i < end * dim; i++)
+                dst[i] = src[i] / task->a;
+            break;
+        case VA_TRANSFORM:
+        case VA_PROJECT:
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                d = dst + i * dim;
+                if (dim == 2) {
+                    tmp[0] = m[0] * s[0] + m[1] * s[1] + off[0];
+                    tmp[1] = m[2] * s[0] + m[3] * s[1] + off[1];
+                }
+                else {
+                    tmp[0] = s[0] * m[0] + s[1] * m[1] + s[2] * m[2] + off[0];
+                    tmp[1] = s[0] * m[3] + s[1] * m[4] + s[2] * m[5] + off[1];
+                    tmp[2] = s[0] * m[6] + s[1] * m[7] + s[2] * m[8] + off[2];
+                }
+                if (task->op == VA_PROJECT) {
+                    f0 = p[dim];
+                    for (j = 0; j < dim; j++)
+                        f0 += p[j] * s[j];
+                    if (f0 == 0) {
+                        error = VA_ERROR_PROJECT_ZERO;
+                        continue;
+                    }
+                    for (j = 0; j < dim; j++)
+                        tmp[j] /= f0;
+                }
+                for (j = 0; j < dim; j++)
+                    d[j] = tmp[j];
+            }
+            break;
+        case VA_NORMALIZE:
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                d = dst + i * dim;
+                length1 = sqrt(_scalar_product(s, s, dim));
+                if (length1 == 0) {
+                    error = VA_ERROR_ZERO_LENGTH;
+                    continue;
+                }
+                for (j = 0; j < dim; j++)
+                    d[j] = s[j] / length1;
+            }
+            break;
+        case VA_REFLECT:
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                o = other + i * step;
+                if (step) {
+                    /* A normal for each vector, the single normal for all
+                       of them is normalized before. */
+                    memcpy(tmp, o, dim * sizeof(tmp[0]));
+                    if (!_vector_reflect_normal(tmp, dim, VECTOR_EPSILON)) {
+                        error = VA_ERROR_ZERO_LENGTH;
+                        continue;
+                    }
+                    o = tmp;
+                }
+                _vector_reflect_coords(dst + i * dim, s, o, dim);
+            }
+            break;
+        case VA_LERP:
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                o = other + i * step;
+                d = dst + i * dim;
+                for (j = 0; j < dim; j++)
+                    d[j] = s[j] * (1 - task->a) + o[j] * task->a;
+            }
+            break;
+        case VA_SLERP:
+            /* The same as vector_slerp(). */
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                o = other + i * step;
+                d = dst + i * dim;
+                t = task->a;
+                length1 = sqrt(_scalar_product(s, s, dim));
+                length2 = sqrt(_scalar_product(o, o, dim));
+                if ((length1 < VECTOR_EPSILON) ||
+                    (length2 < VECTOR_EPSILON)) {
+                    error = VA_ERROR_ZERO_LENGTH;
+                    continue;
+                }
+                f0 = _scalar_product(s, o, dim) / (length1 * length2);
+                f0 = (f0 < -1 ? -1 : (f0 > 1 ? 1 : f0));
+                angle = acos(f0);
+                if (t < 0) {
+                    angle -= 2 * M_PI;
+                    t = -t;
+                }
+                if (s[0] * o[1] < s[1] * o[0])
+                    angle *= -1;
+
+                if ((fabs(angle) < VECTOR_EPSILON) ||
+                    (fabs(fabs(angle) - 2 * M_PI) < VECTOR_EPSILON)) {
+                    for (j = 0; j < dim; j++)
+                        d[j] = s[j] * (1 - t) + o[j] * t;
+                }
+                else if (fabs(fabs(angle) - M_PI) < VECTOR_EPSILON) {
+                    error = VA_ERROR_SLERP_180;
+                }
+                else {
+                    f0 = ((length2 - length1) * t + length1) / sin(angle);
+                    f1 = sin(angle * (1 - t)) / length1;
+                    f2 = sin(angle * t) / length2;
+                    for (j = 0; j < dim; j++)
+                        d[j] = (s[j] * f1 + o[j] * f2) * f0;
+                }
+            }
+            break;
+        case VA_MOVE_TOWARDS:
+            for (i = start; i < end; i++) {
+                d = dst + i * dim;
+                if (d != src + i * dim)
+                    memcpy(d, src + i * dim, dim * sizeof(d[0]));
+                _vector_move_towards_helper(dim, d, other + i * step,
+                                            task->a);
+            }
+            break;
+        case VA_CLAMP:
+            /* The same as vector_clamp_magnitude_ip(). */
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                d = dst + i * dim;
+                length_sq = _scalar_product(s, s, dim);
+                if (length_sq == 0) {
+                    error = VA_ERROR_ZERO_LENGTH;
+                    continue;
+                }
+                f0 = 1;
+                if (length_sq > task->b * task->b)
+                    f0 = task->b / sqrt(length_sq);
+                if (length_sq < task->a * task->a)
+                    f0 = task->a / sqrt(length_sq);
+                for (j = 0; j < dim; j++)
+                    d[j] = s[j] * f0;
+            }
+            break;
+        case VA_CROSS:
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                o = other + i * step;
+                if (dim == 2) {
+                    dst[i] = (s[0] * o[1]) - (s[1] * o[0]);
+                    continue;
+                }
+                d = dst + i * dim;
+                tmp[0] = (s[1] * o[2]) - (s[2] * o[1]);
+                tmp[1] = (s[2] * o[0]) - (s[0] * o[2]);
+                tmp[2] = (s[0] * o[1]) - (s[1] * o[0]);
+                d[0] = tmp[0];
+                d[1] = tmp[1];
+                d[2] = tmp[2];
+            }
+            break;
+        case VA_DOT:
+            for (i = start; i < end; i++)
+                dst[i] = _scalar_product(src + i * dim, other + i * step, dim);
+            break;
+        case VA_LENGTH_SQUARED:
+        case VA_LENGTH:
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                dst[i] = _scalar_product(s, s, dim);
+            }
+            if (task->op == VA_LENGTH) {
+                for (i = start; i < end; i++)
+                    dst[i] = sqrt(dst[i]);
+            }
+            break;
+        case VA_DISTANCE_SQUARED:
+        case VA_DISTANCE:
+            for (i = start; i < end; i++) {
+                s = src + i * dim;
+                o = other + i * step;
+                length_sq = 0;
+                for (j = 0; j < dim; j++) {
+                    f0 = o[j] - s[j];
+                    length_sq += f0 * f0;
+                }
+                dst[i] = length_sq;
+            }
+            if (task->op == VA_DISTANCE) {
+                for (i = start; i < end; i++)
+                    dst[i] = sqrt(dst[i]);
+            }
+            break;
+    }
+
+    if (error) {
+        SDL_AtomicSet(&task->error, error);
     }
-    Py_RETURN_NONE;
 }
 
-static PyObject *
-math_disable_swizzling(pgVector *self, PyObject *_null)
+/* Runs task over the vectors, on several threads without the GIL when there
+ * are enough of them. Returns 0 with a ValueError set if a worker found an
+ * error, zero_msg being the message for vectors of length zero.
+ */
+static int
+vectorarray_apply(vectorarray_task *task, Py_ssize_t length,
+                  const char *zero_msg)
 {
-    if (PyErr_WarnEx(PyExc_DeprecationWarning,
-                     "pygame.math.disable_swizzling() is deprecated, "
-                     "and its functionality is removed. This function will be "
-                     "removed in a later version.",
-                     1) == -1) {
-        return NULL;
+    if (length >= 2 * VECTORARRAY_PARALLEL_MIN) {
+        Py_BEGIN_ALLOW_THREADS;
+        pg_parallel_for((int)length, VECTORARRAY_PARALLEL_MIN,
+                        vectorarray_run, task);
+        Py_END_ALLOW_THREADS;
+    }
+    else if (length) {
+        vectorarray_run(task, 0, (int)length);
+    }
+
+    switch (SDL_AtomicGet(&task->error)) {
+        case 0:
+            return 1;
+        case VA_ERROR_SLERP_180:
+            PyErr_SetString(PyExc_ValueError,
+                            "SLERP with 180 degrees is undefined.");
+            return 0;
+        case VA_ERROR_PROJECT_ZERO:
+            PyErr_SetString(PyExc_ValueError,
+                            "Can't transform a point the Matrix projects to "
+                            "infinity");
+            return 0;
+        default:
+            PyErr_SetString(PyExc_ValueError, zero_msg);
+            return 0;
     }
-    Py_RETURN_NONE;
 }
 
-static PyMethodDef _math_methods[] = {
-    {"enable_swizzling", (PyCFunction)math_enable_swizzling, METH_NOARGS,
-     "Deprecated, will be removed in a future version"},
-    {"disable_swizzling", (PyCFunction)math_disable_swizzling, METH_NOARGS,
-     "Deprecated, will be removed in a future version."},
-    {NULL, NULL, 0, NULL}};
+static pgVectorArray *
+_vectorarray_new(PyTypeObject *type, Py_ssize_t length)
+{
+    pgVectorArray *self;
+    Py_ssize_t dim = type == &pgVector2Array_Type ? 2 : 3;
 
-/****************************
- * Module init function
- ****************************/
+    /* The threads are given int ranges of vectors. */
+    if (length > INT_MAX ||
+        length > PY_SSIZE_T_MAX / (Py_ssize_t)(dim * sizeof(double))) {
+        return (pgVectorArray *)PyErr_NoMemory();
+    }
 
-MODINIT_DEFINE(math)
+    self = (pgVectorArray *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->data = PyMem_New(double, MAX(length * dim, 1));
+    if (self->data == NULL) {
+        Py_DECREF(self);
+        return (pgVectorArray *)PyErr_NoMemory();
+    }
+    self->length = length;
+    self->dim = dim;
+    self->shape[0] = length;
+    self->shape[1] = dim;
+    self->strides[0] = dim * sizeof(double);
+    self->strides[1] = sizeof(double);
+    return self;
+}
+
+/* Checks for a C contiguous buffer of native doubles, dim of them per
+ * vector. */
+static int
+_vectorarray_buffer_check(Py_buffer *view, Py_ssize_t dim)
+{
+    const char *format = view->format ? view->format : "B";
+
+    if (view->itemsize != sizeof(double)) {
+        return 0;
+    }
+    if (format[0] == '@' || format[0] == '=' ||
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        format[0] == '<'
+#else
+        format[0] == '>' || format[0] == '!'
+#endif
+    ) {
+        format++;
+    }
+    if (strcmp(format, "d") != 0) {
+        return 0;
+    }
+    switch (view->ndim) {
+        case 1:
+            return view->shape[0] % dim == 0;
+        case 2:
+            return view->shape[1] == dim;
+        default:
+            return 0;
+    }
+}
+
+static PyObject *
+vectorarray_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *vectors = NULL, *seq, *item;
+    Py_buffer view;
+    pgVectorArray *self;
+    Py_ssize_t length, dim = type == &pgVector2Array_Type ? 2 : 3, i;
+    int ok;
+    static char *keywords[] = {"vectors", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", keywords, &vectors)) {
+        return NULL;
+    }
+
+    if (vectors == NULL) {
+        return (PyObject *)_vectorarray_new(type, 0);
+    }
+
+    if (PyLong_Check(vectors)) {
+        length = PyLong_AsSsize_t(vectors);
+        if (length == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (length < 0) {
+            return RAISE(PyExc_ValueError,
+                         "the number of vectors must not be negative");
+        }
+        self = _vectorarray_new(type, length);
+        if (self != NULL) {
+            memset(self->data, 0, length * dim * sizeof(double));
+        }
+        return (PyObject *)self;
+    }
+
+    /* Doubles are copied as they are, from other arrays and numpy. */
+    if (PyObject_CheckBuffer(vectors)) {
+        if (PyObject_GetBuffer(vectors, &view,
+                               PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0) {
+            self = NULL;
+            ok = _vectorarray_buffer_check(&view, dim);
+            if (ok) {
+                self = _vectorarray_new(type, view.len / view.itemsize / dim);
+                if (self != NULL) {
+                    memcpy(self->data, view.buf, view.len);
+                }
+            }
+            PyBuffer_Release(&view);
+            if (ok) {
+                return (PyObject *)self;
+            }
+        }
+        else {
+            PyErr_Clear();
+        }
+    }
+
+    seq = PySequence_Fast(vectors,
+                          "vectors must be a number or a sequence of vectors");
+    if (seq == NULL) {
+        return NULL;
+    }
+    length = PySequence_Fast_GET_SIZE(seq);
+    self = _vectorarray_new(type, length);
+    if (self == NULL) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    for (i = 0; i < length; i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        if (!pgVectorCompatible_Check(item, dim) ||
+            !PySequence_AsVectorCoords(item, self->data + i * dim, dim)) {
+            PyErr_Format(PyExc_TypeError,
+                         "vectors must be Vector%zds or sequences of %zd "
+                         "numbers",
+                         dim, dim);
+            Py_DECREF(seq);
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+    Py_DECREF(seq);
+    return (PyObject *)self;
+}
+
+static void
+vectorarray_dealloc(pgVectorArray *self)
+{
+    PyMem_Free(self->data);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+vectorarray_repr(pgVectorArray *self)
+{
+    return PyUnicode_FromFormat("<Vector%zdArray(%zd vectors)>", self->dim,
+                                self->length);
+}
+
+/* Reads the other operand of a batch operation: an array of the same type
+ * and length, whose vectors are used one by one, or a single vector used
+ * for all of them, read into coords. Returns 1 and sets task->other, 0 if
+ * obj is neither, or -1 with an exception set.
+ */
+static int
+_vectorarray_other(pgVectorArray *self, PyObject *obj, double *coords,
+                   vectorarray_task *task)
+{
+    if (Py_TYPE(obj) == Py_TYPE(self)) {
+        if (((pgVectorArray *)obj)->length != self->length) {
+            PyErr_SetString(PyExc_ValueError,
+                            "VectorArrays must have the same length");
+            return -1;
+        }
+        task->other = ((pgVectorArray *)obj)->data;
+        task->other_step = self->dim;
+        return 1;
+    }
+    if (pgVectorCompatible_Check(obj, self->dim)) {
+        if (!PySequence_AsVectorCoords(obj, coords, self->dim)) {
+            return -1;
+        }
+        task->other = coords;
+        task->other_step = 0;
+        return 1;
+    }
+    return 0;
+}
+
+/* _vectorarray_other() for method arguments, which must be one or the
+ * other. */
+static int
+_vectorarray_other_arg(pgVectorArray *self, PyObject *obj, double *coords,
+                       vectorarray_task *task)
+{
+    switch (_vectorarray_other(self, obj, coords, task)) {
+        case 1:
+            return 1;
+        case 0:
+            PyErr_Format(PyExc_TypeError,
+                         "expected a Vector%zdArray of the same length or a "
+                         "Vector%zd",
+                         self->dim, self->dim);
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+/* Runs task from self into a new array, or into self if inplace. Tasks
+ * which can fail on some vector are given zero_msg, and when inplace they
+ * are run into a copy first so self isn't changed by a failure. Returns the
+ * new array or None.
+ */
+static PyObject *
+_vectorarray_result(pgVectorArray *self, vectorarray_task *task, int inplace,
+                    const char *zero_msg)
+{
+    pgVectorArray *ret = NULL;
+    size_t size = self->length * self->dim * sizeof(double);
+
+    task->dim = self->dim;
+    task->src = self->data;
+    if (!inplace) {
+        ret = _vectorarray_new(Py_TYPE(self), self->length);
+        if (ret == NULL) {
+            return NULL;
+        }
+        task->dst = ret->data;
+    }
+    else if (zero_msg) {
+        task->dst = PyMem_New(double, MAX(self->length * self->dim, 1));
+        if (task->dst == NULL) {
+            return PyErr_NoMemory();
+        }
+    }
+    else {
+        task->dst = self->data;
+    }
+
+    if (!vectorarray_apply(task, self->length, zero_msg)) {
+        if (inplace && zero_msg) {
+            PyMem_Free(task->dst);
+        }
+        Py_XDECREF(ret);
+        return NULL;
+    }
+
+    if (!inplace) {
+        return (PyObject *)ret;
+    }
+    if (zero_msg) {
+        memcpy(self->data, task->dst, size);
+        PyMem_Free(task->dst);
+    }
+    Py_RETURN_NONE;
+}
+
+/* Runs task from self into a new array.array of doubles, one per vector. */
+static PyObject *
+_vectorarray_scalars(pgVectorArray *self, vectorarray_task *task)
+{
+    PyObject *one, *ret;
+    Py_buffer view;
+    int ok;
+
+    one = PyObject_CallFunction(vectorarray_scalar_type, "s(d)", "d", 0.0);
+    if (one == NULL) {
+        return NULL;
+    }
+    ret = PySequence_Repeat(one, self->length);
+    Py_DECREF(one);
+    if (ret == NULL) {
+        return NULL;
+    }
+    if (PyObject_GetBuffer(ret, &view, PyBUF_WRITABLE) < 0) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+
+    task->dim = self->dim;
+    task->src = self->data;
+    task->dst = (double *)view.buf;
+    ok = vectorarray_apply(task, self->length, NULL);
+    PyBuffer_Release(&view);
+    if (!ok) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return ret;
+}
+
+static Py_ssize_t
+vectorarray_len(pgVectorArray *self)
+{
+    return self->length;
+}
+
+static PyObject *
+vectorarray_item(pgVectorArray *self, Py_ssize_t index)
+{
+    pgVector *vec;
+
+    if (index < 0 || index >= self->length) {
+        return RAISE(PyExc_IndexError, "VectorArray index out of range");
+    }
+    vec = (pgVector *)pgVector_NEW(self->dim);
+    if (vec != NULL) {
+        memcpy(vec->coords, self->data + index * self->dim,
+               self->dim * sizeof(double));
+    }
+    return (PyObject *)vec;
+}
+
+static int
+vectorarray_ass_item(pgVectorArray *self, Py_ssize_t index, PyObject *value)
+{
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError,
+                        "VectorArray doesn't support item deletion");
+        return -1;
+    }
+    if (index < 0 || index >= self->length) {
+        PyErr_SetString(PyExc_IndexError, "VectorArray index out of range");
+        return -1;
+    }
+    if (!pgVectorCompatible_Check(value, self->dim)) {
+        PyErr_Format(PyExc_TypeError,
+                     "a Vector%zd or a sequence of %zd numbers is required",
+                     self->dim, self->dim);
+        return -1;
+    }
+    if (!PySequence_AsVectorCoords(value, self->data + index * self->dim,
+                                   self->dim)) {
+        return -1;
+    }
+    return 0;
+}
+
+static int
+vectorarray_getbuffer(pgVectorArray *self, Py_buffer *view, int flags)
+{
+    view->obj = (PyObject *)self;
+    Py_INCREF(self);
+    view->buf = self->data;
+    view->len = self->length * self->dim * sizeof(double);
+    view->readonly = 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? "d" : NULL;
+    if ((flags & PyBUF_ND) == PyBUF_ND) {
+        view->ndim = 2;
+        view->shape = self->shape;
+    }
+    else {
+        view->ndim = 1;
+        view->shape = NULL;
+    }
+    view->strides =
+        (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+static PyObject *
+vectorarray_generic_math(PyObject *o1, PyObject *o2, int op)
+{
+    pgVectorArray *self;
+    PyObject *other;
+    vectorarray_task task = {0};
+    double other_coords[VECTOR_MAX_SIZE];
+    double number = 0;
+
+    if (pgVectorArray_Check(o1)) {
+        self = (pgVectorArray *)o1;
+        other = o2;
+    }
+    else {
+        self = (pgVectorArray *)o2;
+        other = o1;
+        op |= OP_ARG_REVERSE;
+    }
+
+    switch (_vectorarray_other(self, other, other_coords, &task)) {
+        case -1:
+            return NULL;
+        case 1:
+            op |= OP_ARG_VECTOR;
+            break;
+        default:
+            if (RealNumber_Check(other)) {
+                op |= OP_ARG_NUMBER;
+                number = PyFloat_AsDouble(other);
+                if (number == -1.0 && PyErr_Occurred()) {
+                    return NULL;
+                }
+            }
+    }
+
+    switch (op & ~OP_INPLACE) {
+        case OP_ADD | OP_ARG_VECTOR:
+        case OP_ADD | OP_ARG_VECTOR | OP_ARG_REVERSE:
+            task.op = VA_ADD;
+            break;
+        case OP_SUB | OP_ARG_VECTOR:
+            task.op = VA_SUB;
+            break;
+        case OP_SUB | OP_ARG_VECTOR | OP_ARG_REVERSE:
+            task.op = VA_RSUB;
+            break;
+        case OP_MUL | OP_ARG_NUMBER:
+        case OP_MUL | OP_ARG_NUMBER | OP_ARG_REVERSE:
+            task.op = VA_SCALE;
+            task.a = number;
+            break;
+        case OP_DIV | OP_ARG_NUMBER:
+            if (number == 0.) {
+                return RAISE(PyExc_ZeroDivisionError, "division by zero");
+            }
+            task.op = VA_DIV;
+            task.a = number;
+            break;
+        default:
+            Py_RETURN_NOTIMPLEMENTED;
+    }
+
+    if (op & OP_INPLACE) {
+        if (!_vectorarray_result(self, &task, 1, NULL)) {
+            return NULL;
+        }
+        Py_DECREF(Py_None);
+        Py_INCREF(self);
+        return (PyObject *)self;
+    }
+    return _vectorarray_result(self, &task, 0, NULL);
+}
+
+static PyObject *
+vectorarray_add(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_ADD);
+}
+static PyObject *
+vectorarray_inplace_add(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_ADD | OP_INPLACE);
+}
+static PyObject *
+vectorarray_sub(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_SUB);
+}
+static PyObject *
+vectorarray_inplace_sub(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_SUB | OP_INPLACE);
+}
+static PyObject *
+vectorarray_mul(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_MUL);
+}
+static PyObject *
+vectorarray_inplace_mul(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_MUL | OP_INPLACE);
+}
+static PyObject *
+vectorarray_div(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_DIV);
+}
+static PyObject *
+vectorarray_inplace_div(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_DIV | OP_INPLACE);
+}
+
+static PyObject *
+vectorarray_neg(pgVectorArray *self)
+{
+    vectorarray_task task = {0};
+
+    task.op = VA_SCALE;
+    task.a = -1;
+    return _vectorarray_result(self, &task, 0, NULL);
+}
+
+static PyObject *
+vectorarray_copy(pgVectorArray *self, PyObject *_null)
+{
+    pgVectorArray *ret = _vectorarray_new(Py_TYPE(self), self->length);
+
+    if (ret != NULL) {
+        memcpy(ret->data, self->data,
+               self->length * self->dim * sizeof(double));
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+vectorarray_length(pgVectorArray *self, PyObject *_null)
+{
+    vectorarray_task task = {0};
+
+    task.op = VA_LENGTH;
+    return _vectorarray_scalars(self, &task);
+}
+
+static PyObject *
+vectorarray_length_squared(pgVectorArray *self, PyObject *_null)
+{
+    vectorarray_task task = {0};
+
+    task.op = VA_LENGTH_SQUARED;
+    return _vectorarray_scalars(self, &task);
+}
+
+static PyObject *
+vectorarray_dot(pgVectorArray *self, PyObject *other)
+{
+    vectorarray_task task = {0};
+    double other_coords[VECTOR_MAX_SIZE];
+
+    if (!_vectorarray_other_arg(self, other, other_coords, &task)) {
+        return NULL;
+    }
+    task.op = VA_DOT;
+    return _vectorarray_scalars(self, &task);
+}
+
+static PyObject *
+vectorarray_cross(pgVectorArray *self, PyObject *other)
+{
+    vectorarray_task task = {0};
+    double other_coords[VECTOR_MAX_SIZE];
+
+    if (!_vectorarray_other_arg(self, other, other_coords, &task)) {
+        return NULL;
+    }
+    task.op = VA_CROSS;
+    if (self->dim == 2) {
+        return _vectorarray_scalars(self, &task);
+    }
+    return _vectorarray_result(self, &task, 0, NULL);
+}
+
+static PyObject *
+vectorarray_distance_to(pgVectorArray *self, PyObject *other)
+{
+    vectorarray_task task = {0};
+    double other_coords[VECTOR_MAX_SIZE];
+
+    if (!_vectorarray_other_arg(self, other, other_coords, &task)) {
+        return NULL;
+    }
+    task.op = VA_DISTANCE;
+    return _vectorarray_scalars(self, &task);
+}
+
+static PyObject *
+vectorarray_distance_squared_to(pgVectorArray *self, PyObject *other)
+{
+    vectorarray_task task = {0};
+    double other_coords[VECTOR_MAX_SIZE];
+
+    if (!_vectorarray_other_arg(self, other, other_coords, &task)) {
+        return NULL;
+    }
+    task.op = VA_DISTANCE_SQUARED;
+    return _vectorarray_scalars(self, &task);
+}
+
+static PyObject *
+_vectorarray_normalize(pgVectorArray *self, int inplace)
+{
+    vectorarray_task task = {0};
+
+    task.op = VA_NORMALIZE;
+    return _vectorarray_result(self, &task, inplace,
+                               "Can't normalize Vector of length Zero");
+}
+
+static PyObject *
+vectorarray_normalize(pgVectorArray *self, PyObject *_null)
+{
+    return _vectorarray_normalize(self, 0);
+}
+
+static PyObject *
+vectorarray_normalize_ip(pgVectorArray *self, PyObject *_null)
+{
+    return _vectorarray_normalize(self, 1);
+}
+
+/* Sets task up to rotate by the rotation the vector helpers do, found by
+ * rotating the axes with them. */
+static int
+_vectorarray_rotation(pgVectorArray *self, PyObject *args,
+                      vectorarray_task *task)
+{
+    PyObject *angle_obj, *axis;
+    double axis_coords[3], unit[3], column[3], angle;
+    Py_ssize_t i, j;
+
+    if (self->dim == 2) {
+        if (!PyArg_ParseTuple(args, "O:rotate", &angle_obj)) {
+            return 0;
+        }
+        angle = PyFloat_AsDouble(angle_obj);
+        if (angle == -1.0 && PyErr_Occurred()) {
+            return 0;
+        }
+    }
+    else {
+        if (!PyArg_ParseTuple(args, "dO:rotate", &angle, &axis)) {
+            return 0;
+        }
+        if (!pgVectorCompatible_Check(axis, 3)) {
+            PyErr_SetString(PyExc_TypeError, "axis must be a 3D Vector");
+            return 0;
+        }
+        if (!PySequence_AsVectorCoords(axis, axis_coords, 3)) {
+            return 0;
+        }
+    }
+    angle = DEG2RAD(angle);
+
+    for (j = 0; j < self->dim; j++) {
+        unit[0] = unit[1] = unit[2] = 0;
+        unit[j] = 1;
+        if (self->dim == 2 ? !_vector2_rotate_helper(column, unit, angle,
+                                                     VECTOR_EPSILON)
+                           : !_vector3_rotate_helper(column, unit,
+                                                     axis_coords, angle,
+                                                     VECTOR_EPSILON)) {
+            return 0;
+        }
+        for (i = 0; i < self->dim; i++)
+            task->matrix[i * self->dim + j] = column[i];
+    }
+    task->op = VA_TRANSFORM;
+    return 1;
+}
+
+static PyObject *
+vectorarray_rotate(pgVectorArray *self, PyObject *args)
+{
+    vectorarray_task task = {0};
+
+    if (!_vectorarray_rotation(self, args, &task)) {
+        return NULL;
+    }
+    return _vectorarray_result(self, &task, 0, NULL);
+}
+
+static PyObject *
+vectorarray_rotate_ip(pgVectorArray *self, PyObject *args)
+{
+    vectorarray_task task = {0};
+
+    if (!_vectorarray_rotation(self, args, &task)) {
+        return NULL;
+    }
+    return _vectorarray_result(self, &task, 1, NULL);
+}
+
+static PyObject *
+_vectorarray_reflect(pgVectorArray *self, PyObject *normal, int inplace)
+{
+    vectorarray_task task = {0};
+    double normal_coords[VECTOR_MAX_SIZE];
+
+    if (!_vectorarray_other_arg(self, normal, normal_coords, &task)) {
+        return NULL;
+    }
+    task.op = VA_REFLECT;
+    if (!task.other_step) {
+        if (!_vector_reflect_normal(normal_coords, self->dim,
+                                    VECTOR_EPSILON)) {
+            return RAISE(PyExc_ValueError,
+                         "Normal must not be of length zero.");
+        }
+        return _vectorarray_result(self, &task, inplace, NULL);
+    }
+    return _vectorarray_result(self, &task, inplace,
+                               "Normal must not be of length zero.");
+}
+
+static PyObject *
+vectorarray_reflect(pgVectorArray *self, PyObject *normal)
+{
+    return _vectorarray_reflect(self, normal, 0);
+}
+
+static PyObject *
+vectorarray_reflect_ip(pgVectorArray *self, PyObject *normal)
+{
+    return _vectorarray_reflect(self, normal, 1);
+}
+
+static PyObject *
+vectorarray_lerp(pgVectorArray *self, PyObject *args)
+{
+    vectorarray_task task = {0};
+    double other_coords[VECTOR_MAX_SIZE];
+    PyObject *other;
+
+    if (!PyArg_ParseTuple(args, "Od:lerp", &other, &task.a)) {
+        return NULL;
+    }
+    if (!_vectorarray_other_arg(self, other, other_coords, &task)) {
+        return NULL;
+    }
+    if (task.a < 0 || task.a > 1) {
+        return RAISE(PyExc_ValueError, "Argument 2 must be in range [0, 1]");
+    }
+    task.op = VA_LERP;
+    return _vectorarray_result(self, &task, 0, NULL);
+}
+
+static PyObject *
+vectorarray_slerp(pgVectorArray *self, PyObject *args)
+{
+    vectorarray_task task = {0};
+    double other_coords[VECTOR_MAX_SIZE];
+    PyObject *other;
+
+    if (!PyArg_ParseTuple(args, "Od:slerp", &other, &task.a)) {
+        return NULL;
+    }
+    if (!_vectorarray_other_arg(self, other, other_coords, &task)) {
+        return NULL;
+    }
+    if (fabs(task.a) > 1) {
+        return RAISE(PyExc_ValueError,
+                     "Argument 2 must be in range [-1, 1].");
+    }
+    task.op = VA_SLERP;
+    return _vectorarray_result(self, &task, 0,
+                               "can't use slerp with Zero-Vector");
+}
+
+static PyObject *
+_vectorarray_move_towards(pgVectorArray *self, PyObject *args, int inplace)
+{
+    vectorarray_task task = {0};
+    double target_coords[VECTOR_MAX_SIZE];
+    PyObject *target;
+
+    if (!PyArg_ParseTuple(args, "Od:move_towards", &target, &task.a)) {
+        return NULL;
+    }
+    if (!_vectorarray_other_arg(self, target, target_coords, &task)) {
+        return NULL;
+    }
+    task.op = VA_MOVE_TOWARDS;
+    return _vectorarray_result(self, &task, inplace, NULL);
+}
+
+static PyObject *
+vectorarray_move_towards(pgVectorArray *self, PyObject *args)
+{
+    return _vectorarray_move_towards(self, args, 0);
+}
+
+static PyObject *
+vectorarray_move_towards_ip(pgVectorArray *self, PyObject *args)
+{
+    return _vectorarray_move_towards(self, args, 1);
+}
+
+static PyObject *
+_vectorarray_clamp_magnitude(pgVectorArray *self, PyObject *args,
+                             PyObject *kwargs, int inplace)
+{
+    vectorarray_task task = {0};
+    double arg0, arg1 = 0;
+    static char *keywords[] = {"arg0", "arg1", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|d", keywords, &arg0,
+                                     &arg1)) {
+        return NULL;
+    }
+
+    /* The same arguments as vector_clamp_magnitude_ip(). */
+    task.op = VA_CLAMP;
+    task.a = arg1 != 0 ? arg0 : 0;
+    task.b = arg1 != 0 ? arg1 : arg0;
+    return _vectorarray_result(self, &task, inplace,
+                               "Cannot clamp a vector with zero length");
+}
+
+static PyObject *
+vectorarray_clamp_magnitude(pgVectorArray *self, PyObject *args,
+                            PyObject *kwargs)
+{
+    return _vectorarray_clamp_magnitude(self, args, kwargs, 0);
+}
+
+static PyObject *
+vectorarray_clamp_magnitude_ip(pgVectorArray *self, PyObject *args,
+                               PyObject *kwargs)
+{
+    return _vectorarray_clamp_magnitude(self, args, kwargs, 1);
+}
+
+static PyNumberMethods vectorarray_as_number = {
+    .nb_add = (binaryfunc)vectorarray_add,
+    .nb_subtract = (binaryfunc)vectorarray_sub,
+    .nb_multiply = (binaryfunc)vectorarray_mul,
+    .nb_negative = (unaryfunc)vectorarray_neg,
+    .nb_positive = (unaryfunc)vectorarray_copy,
+    .nb_inplace_add = (binaryfunc)vectorarray_inplace_add,
+    .nb_inplace_subtract = (binaryfunc)vectorarray_inplace_sub,
+    .nb_inplace_multiply = (binaryfunc)vectorarray_inplace_mul,
+    .nb_true_divide = (binaryfunc)vectorarray_div,
+    .nb_inplace_true_divide = (binaryfunc)vectorarray_inplace_div,
+};
+
+static PySequenceMethods vectorarray_as_sequence = {
+    .sq_length = (lenfunc)vectorarray_len,
+    .sq_item = (ssizeargfunc)vectorarray_item,
+    .sq_ass_item = (ssizeobjargproc)vectorarray_ass_item,
+};
+
+static PyBufferProcs vectorarray_as_buffer = {
+    .bf_getbuffer = (getbufferproc)vectorarray_getbuffer,
+};
+
+static PyMethodDef vector2array_methods[] = {
+    {"copy", (PyCFunction)vectorarray_copy, METH_NOARGS,
+     DOC_VECTOR2ARRAYCOPY},
+    {"__copy__", (PyCFunction)vectorarray_copy, METH_NOARGS, NULL},
+    {"length", (PyCFunction)vectorarray_length, METH_NOARGS,
+     DOC_VECTOR2ARRAYLENGTH},
+    {"length_squared", (PyCFunction)vectorarray_length_squared, METH_NOARGS,
+     DOC_VECTOR2ARRAYLENGTHSQUARED},
+    {"dot", (PyCFunction)vectorarray_dot, METH_O, DOC_VECTOR2ARRAYDOT},
+    {"cross", (PyCFunction)vectorarray_cross, METH_O, DOC_VECTOR2ARRAYCROSS},
+    {"distance_to", (PyCFunction)vectorarray_distance_to, METH_O,
+     DOC_VECTOR2ARRAYDISTANCETO},
+    {"distance_squared_to", (PyCFunction)vectorarray_distance_squared_to,
+     METH_O, DOC_VECTOR2ARRAYDISTANCESQUAREDTO},
+    {"normalize", (PyCFunction)vectorarray_normalize, METH_NOARGS,
+     DOC_VECTOR2ARRAYNORMALIZE},
+    {"normalize_ip", (PyCFunction)vectorarray_normalize_ip, METH_NOARGS,
+     DOC_VECTOR2ARRAYNORMALIZEIP},
+    {"rotate", (PyCFunction)vectorarray_rotate, METH_VARARGS,
+     DOC_VECTOR2ARRAYROTATE},
+    {"rotate_ip", (PyCFunction)vectorarray_rotate_ip, METH_VARARGS,
+     DOC_VECTOR2ARRAYROTATEIP},
+    {"reflect", (PyCFunction)vectorarray_reflect, METH_O,
+     DOC_VECTOR2ARRAYREFLECT},
+    {"reflect_ip", (PyCFunction)vectorarray_reflect_ip, METH_O,
+     DOC_VECTOR2ARRAYREFLECTIP},
+    {"lerp", (PyCFunction)vectorarray_lerp, METH_VARARGS,
+     DOC_VECTOR2ARRAYLERP},
+    {"slerp", (PyCFunction)vectorarray_slerp, METH_VARARGS,
+     DOC_VECTOR2ARRAYSLERP},
+    {"move_towards", (PyCFunction)vectorarray_move_towards, METH_VARARGS,
+     DOC_VECTOR2ARRAYMOVETOWARDS},
+    {"move_towards_ip", (PyCFunction)vectorarray_move_towards_ip,
+     METH_VARARGS, DOC_VECTOR2ARRAYMOVETOWARDSIP},
+    {"clamp_magnitude", (PyCFunction)vectorarray_clamp_magnitude,
+     METH_VARARGS | METH_KEYWORDS, DOC_VECTOR2ARRAYCLAMPMAGNITUDE},
+    {"clamp_magnitude_ip", (PyCFunction)vectorarray_clamp_magnitude_ip,
+     METH_VARARGS | METH_KEYWORDS, DOC_VECTOR2ARRAYCLAMPMAGNITUDEIP},
+
+    {NULL} /* Sentinel */
+};
+
+static PyMethodDef vector3array_methods[] = {
+    {"copy", (PyCFunction)vectorarray_copy, METH_NOARGS,
+     DOC_VECTOR3ARRAYCOPY},
+    {"__copy__", (PyCFunction)vectorarray_copy, METH_NOARGS, NULL},
+    {"length", (PyCFunction)vectorarray_length, METH_NOARGS,
+     DOC_VECTOR3ARRAYLENGTH},
+    {"length_squared", (PyCFunction)vectorarray_length_squared, METH_NOARGS,
+     DOC_VECTOR3ARRAYLENGTHSQUARED},
+    {"dot", (PyCFunction)vectorarray_dot, METH_O, DOC_VECTOR3ARRAYDOT},
+    {"cross", (PyCFunction)vectorarray_cross, METH_O, DOC_VECTOR3ARRAYCROSS},
+    {"distance_to", (PyCFunction)vectorarray_distance_to, METH_O,
+     DOC_VECTOR3ARRAYDISTANCETO},
+    {"distance_squared_to", (PyCFunction)vectorarray_distance_squared_to,
+     METH_O, DOC_VECTOR3ARRAYDISTANCESQUAREDTO},
+    {"normalize", (PyCFunction)vectorarray_normalize, METH_NOARGS,
+     DOC_VECTOR3ARRAYNORMALIZE},
+    {"normalize_ip", (PyCFunction)vectorarray_normalize_ip, METH_NOARGS,
+     DOC_VECTOR3ARRAYNORMALIZEIP},
+    {"rotate", (PyCFunction)vectorarray_rotate, METH_VARARGS,
+     DOC_VECTOR3ARRAYROTATE},
+    {"rotate_ip", (PyCFunction)vectorarray_rotate_ip, METH_VARARGS,
+     DOC_VECTOR3ARRAYROTATEIP},
+    {"reflect", (PyCFunction)vectorarray_reflect, METH_O,
+     DOC_VECTOR3ARRAYREFLECT},
+    {"reflect_ip", (PyCFunction)vectorarray_reflect_ip, METH_O,
+     DOC_VECTOR3ARRAYREFLECTIP},
+    {"lerp", (PyCFunction)vectorarray_lerp, METH_VARARGS,
+     DOC_VECTOR3ARRAYLERP},
+    {"slerp", (PyCFunction)vectorarray_slerp, METH_VARARGS,
+     DOC_VECTOR3ARRAYSLERP},
+    {"move_towards", (PyCFunction)vectorarray_move_towards, METH_VARARGS,
+     DOC_VECTOR3ARRAYMOVETOWARDS},
+    {"move_towards_ip", (PyCFunction)vectorarray_move_towards_ip,
+     METH_VARARGS, DOC_VECTOR3ARRAYMOVETOWARDSIP},
+    {"clamp_magnitude", (PyCFunction)vectorarray_clamp_magnitude,
+     METH_VARARGS | METH_KEYWORDS, DOC_VECTOR3ARRAYCLAMPMAGNITUDE},
+    {"clamp_magnitude_ip", (PyCFunction)vectorarray_clamp_magnitude_ip,
+     METH_VARARGS | METH_KEYWORDS, DOC_VECTOR3ARRAYCLAMPMAGNITUDEIP},
+
+    {NULL} /* Sentinel */
+};
+
+/********************************************
+ * pgVector2Array and pgVector3Array type definitions
+ ********************************************/
+
+static PyTypeObject pgVector2Array_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.math.Vector2Array",
+    .tp_basicsize = sizeof(pgVectorArray),
+    .tp_dealloc = (destructor)vectorarray_dealloc,
+    .tp_repr = (reprfunc)vectorarray_repr,
+    .tp_as_number = &vectorarray_as_number,
+    .tp_as_sequence = &vectorarray_as_sequence,
+    .tp_as_buffer = &vectorarray_as_buffer,
+    /* Not subtypable for now, no Py_TPFLAGS_BASETYPE */
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEMATHVECTOR2ARRAY,
+    .tp_methods = vector2array_methods,
+    .tp_new = (newfunc)vectorarray_new,
+};
+
+static PyTypeObject pgVector3Array_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.math.Vector3Array",
+    .tp_basicsize = sizeof(pgVectorArray),
+    .tp_dealloc = (destructor)vectorarray_dealloc,
+    .tp_repr = (reprfunc)vectorarray_repr,
+    .tp_as_number = &vectorarray_as_number,
+    .tp_as_sequence = &vectorarray_as_sequence,
+    .tp_as_buffer = &vectorarray_as_buffer,
+    /* Not subtypable for now, no Py_TPFLAGS_BASETYPE */
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEMATHVECTOR3ARRAY,
+    .tp_methods = vector3array_methods,
+    .tp_new = (newfunc)vectorarray_new,
+};
+
+/*****************************************
+ * Matrix3 and Matrix4
+ *****************************************/
+
+/* Both transform column vectors in homogeneous coordinates, Matrix3 the
+ * Vector2 points (x, y, 1) and Matrix4 the Vector3 points (x, y, z, 1).
+ * Many points are transformed by the VectorArray tasks.
+ */
+
+static void
+_matrix_identity(double *m, Py_ssize_t n)
+{
+    Py_ssize_t i;
+
+    memset(m, 0, n * n * sizeof(m[0]));
+    for (i = 0; i < n; i++)
+        m[i * n + i] = 1;
+}
+
+/* dst = a * b, dst may be a or b. */
+static void
+_matrix_multiply(double *dst, const double *a, const double *b, Py_ssize_t n)
+{
+    double tmp[16];
+    Py_ssize_t r, c, k;
+
+    for (r = 0; r < n; r++) {
+        for (c = 0; c < n; c++) {
+            tmp[r * n + c] = 0;
+            for (k = 0; k < n; k++)
+                tmp[r * n + c] += a[r * n + k] * b[k * n + c];
+        }
+    }
+    memcpy(dst, tmp, n * n * sizeof(dst[0]));
+}
+
+/* Determinant of m without the given row and column. */
+static double
+_matrix_minor(const double *m, Py_ssize_t n, Py_ssize_t row, Py_ssize_t col)
+{
+    double s[9];
+    Py_ssize_t r, c, k = 0;
+
+    for (r = 0; r < n; r++) {
+        for (c = 0; c < n; c++) {
+            if (r != row && c != col)
+                s[k++] = m[r * n + c];
+        }
+    }
+    if (n == 3) {
+        return s[0] * s[3] - s[1] * s[2];
+    }
+    return (s[0] * (s[4] * s[8] - s[5] * s[7]) -
+            s[1] * (s[3] * s[8] - s[5] * s[6]) +
+            s[2] * (s[3] * s[7] - s[4] * s[6]));
+}
+
+static double
+_matrix_determinant(const double *m, Py_ssize_t n)
+{
+    double det = 0;
+    Py_ssize_t c;
+
+    for (c = 0; c < n; c++)
+        det += (c % 2 ? -1 : 1) * m[c] * _matrix_minor(m, n, 0, c);
+    return det;
+}
+
+/* dst = the inverse of src, dst may be src. Returns 0 if there is none. */
+static int
+_matrix_inverse(double *dst, const double *src, Py_ssize_t n)
+{
+    double tmp[16], det = _matrix_determinant(src, n);
+    Py_ssize_t r, c;
+
+    if (det == 0) {
+        return 0;
+    }
+    for (r = 0; r < n; r++) {
+        for (c = 0; c < n; c++)
+            tmp[c * n + r] = ((r + c) % 2 ? -1 : 1) *
+                             _matrix_minor(src, n, r, c) / det;
+    }
+    memcpy(dst, tmp, n * n * sizeof(dst[0]));
+    return 1;
+}
+
+/* The bottom row of affine transforms is (0, ..., 0, 1). */
+static int
+_matrix_is_affine(pgMatrix *self)
+{
+    Py_ssize_t n = self->size, c;
+
+    for (c = 0; c < n - 1; c++) {
+        if (self->m[(n - 1) * n + c] != 0)
+            return 0;
+    }
+    return self->m[n * n - 1] == 1;
+}
+
+/* A new Vector2 or Vector3 of the given coordinates. */
+static PyObject *
+_matrix_vector(Py_ssize_t dim, const double *coords)
+{
+    pgVector *ret = (pgVector *)pgVector_NEW(dim);
+
+    if (ret != NULL) {
+        memcpy(ret->coords, coords, dim * sizeof(coords[0]));
+    }
+    return (PyObject *)ret;
+}
+
+static pgMatrix *
+_matrix_new(PyTypeObject *type)
+{
+    pgMatrix *self = (pgMatrix *)type->tp_alloc(type, 0);
+
+    if (self == NULL) {
+        return NULL;
+    }
+    self->size = type == &pgMatrix3_Type ? 3 : 4;
+    self->shape[0] = self->shape[1] = self->size;
+    self->strides[0] = self->size * sizeof(double);
+    self->strides[1] = sizeof(double);
+    _matrix_identity(self->m, self->size);
+    return self;
+}
+
+/* Reads n rows of n numbers, or n * n numbers, into m. ok is -1 when the
+ * error of a number that can't be converted is already set. */
+static int
+_matrix_from_object(PyObject *obj, double *m, Py_ssize_t n)
+{
+    PyObject *seq, *row, *item;
+    Py_ssize_t length, i, j;
+    int ok = 0;
+
+    seq = PySequence_Fast(obj, "rows must be a sequence");
+    if (seq == NULL) {
+        goto fail;
+    }
+    length = PySequence_Fast_GET_SIZE(seq);
+    if (length == n * n) {
+        for (i = 0; i < length; i++) {
+            item = PySequence_Fast_GET_ITEM(seq, i);
+            if (!RealNumber_Check(item)) {
+                goto fail;
+            }
+            m[i] = PyFloat_AsDouble(item);
+            if (m[i] == -1.0 && PyErr_Occurred()) {
+                ok = -1;
+                goto fail;
+            }
+        }
+        ok = 1;
+    }
+    else if (length == n) {
+        for (i = 0; i < n; i++) {
+            row = PySequence_Fast_GET_ITEM(seq, i);
+            if (!PySequence_Check(row) || PySequence_Length(row) != n) {
+                goto fail;
+            }
+            for (j = 0; j < n; j++) {
+                item = PySequence_GetItem(row, j);
+                if (item == NULL || !RealNumber_Check(item)) {
+                    Py_XDECREF(item);
+                    goto fail;
+                }
+                m[i * n + j] = PyFloat_AsDouble(item);
+                Py_DECREF(item);
+                if (m[i * n + j] == -1.0 && PyErr_Occurred()) {
+                    ok = -1;
+                    goto fail;
+                }
+            }
+        }
+        ok = 1;
+    }
+
+fail:
+    Py_XDECREF(seq);
+    if (!ok) {
+        PyErr_Format(PyExc_TypeError,
+                     "Matrix%zd needs %zd rows of %zd numbers, or %zd "
+                     "numbers",
+                     n, n, n, n * n);
+    }
+    return ok > 0;
+}
+
+static PyObject *
+matrix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *rows = NULL;
+    pgMatrix *self;
+    static char *keywords[] = {"rows", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", keywords, &rows)) {
+        return NULL;
+    }
+    self = _matrix_new(type);
+    if (self == NULL || rows == NULL) {
+        return (PyObject *)self;
+    }
+    if (Py_TYPE(rows) == type) {
+        memcpy(self->m, ((pgMatrix *)rows)->m, sizeof(self->m));
+    }
+    else if (!_matrix_from_object(rows, self->m, self->size)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+static PyObject *
+matrix_from_translation(PyTypeObject *cls, PyObject *offset)
+{
+    double coords[3];
+    pgMatrix *ret;
+    Py_ssize_t n = cls == &pgMatrix3_Type ? 3 : 4, r;
+
+    if (!pgVectorCompatible_Check(offset, n - 1) ||
+        !PySequence_AsVectorCoords(offset, coords, n - 1)) {
+        return PyErr_Format(PyExc_TypeError, "expected a Vector%zd",
+                            n - 1);
+    }
+    ret = _matrix_new(cls);
+    if (ret != NULL) {
+        for (r = 0; r < n - 1; r++)
+            ret->m[r * n + n - 1] = coords[r];
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+matrix_from_rotation(PyTypeObject *cls, PyObject *args)
+{
+    PyObject *axis;
+    double axis_coords[3], unit[3], column[3], angle;
+    pgMatrix *ret;
+    Py_ssize_t n = cls == &pgMatrix3_Type ? 3 : 4, r, c;
+
+    if (n == 3) {
+        if (!PyArg_ParseTuple(args, "d:from_rotation", &angle)) {
+            return NULL;
+        }
+    }
+    else {
+        if (!PyArg_ParseTuple(args, "dO:from_rotation", &angle, &axis)) {
+            return NULL;
+        }
+        if (!pgVectorCompatible_Check(axis, 3) ||
+            !PySequence_AsVectorCoords(axis, axis_coords, 3)) {
+            return RAISE(PyExc_TypeError, "axis must be a 3D Vector");
+        }
+    }
+    angle = DEG2RAD(angle);
+
+    ret = _matrix_new(cls);
+    if (ret == NULL) {
+        return NULL;
+    }
+    /* The columns are the axes rotated the same way as the vectors are. */
+    for (c = 0; c < n - 1; c++) {
+        unit[0] = unit[1] = unit[2] = 0;
+        unit[c] = 1;
+        if (n == 3 ? !_vector2_rotate_helper(column, unit, angle,
+                                             VECTOR_EPSILON)
+                   : !_vector3_rotate_helper(column, unit, axis_coords,
+                                             angle, VECTOR_EPSILON)) {
+            Py_DECREF(ret);
+            return NULL;
+        }
+        for (r = 0; r < n - 1; r++)
+            ret->m[r * n + c] = column[r];
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+matrix_from_scale(PyTypeObject *cls, PyObject *scale)
+{
+    double coords[3];
+    pgMatrix *ret;
+    Py_ssize_t n = cls == &pgMatrix3_Type ? 3 : 4, i;
+
+    if (RealNumber_Check(scale)) {
+        coords[0] = coords[1] = coords[2] = PyFloat_AsDouble(scale);
+        if (coords[0] == -1.0 && PyErr_Occurred()) {
+            return NULL;
+        }
+    }
+    else if (!pgVectorCompatible_Check(scale, n - 1) ||
+             !PySequence_AsVectorCoords(scale, coords, n - 1)) {
+        return PyErr_Format(PyExc_TypeError, "expected a Vector%zd",
+                            n - 1);
+    }
+    ret = _matrix_new(cls);
+    if (ret != NULL) {
+        for (i = 0; i < n - 1; i++)
+            ret->m[i * n + i] = coords[i];
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+matrix_repr(pgMatrix *self)
+{
+    char buffer[STRING_BUF_SIZE_MATRIX_REPR];
+    const double *m = self->m;
+    int tmp;
+
+    if (self->size == 3) {
+        tmp = PyOS_snprintf(buffer, STRING_BUF_SIZE_MATRIX_REPR,
+                            "<Matrix3((%g, %g, %g), (%g, %g, %g), "
+                            "(%g, %g, %g))>",
+                            m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7],
+                            m[8]);
+    }
+    else {
+        tmp = PyOS_snprintf(
+            buffer, STRING_BUF_SIZE_MATRIX_REPR,
+            "<Matrix4((%g, %g, %g, %g), (%g, %g, %g, %g), "
+            "(%g, %g, %g, %g), (%g, %g, %g, %g))>",
+            m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], m[9], m[10],
+            m[11], m[12], m[13], m[14], m[15]);
+    }
+
+    if (!_vector_check_snprintf_success(tmp, STRING_BUF_SIZE_MATRIX_REPR))
+        return NULL;
+
+    return PyUnicode_FromString(buffer);
+}
+
+/* Reads a (row, column) key, returning the index of the element or -1. */
+static Py_ssize_t
+_matrix_index(pgMatrix *self, PyObject *key)
+{
+    Py_ssize_t row, col;
+
+    if (!PyTuple_Check(key) || PyTuple_GET_SIZE(key) != 2) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Matrix indices must be (row, column) tuples");
+        return -1;
+    }
+    if (!PyArg_ParseTuple(key, "nn", &row, &col)) {
+        return -1;
+    }
+    if (row < 0)
+        row += self->size;
+    if (col < 0)
+        col += self->size;
+    if (row < 0 || row >= self->size || col < 0 || col >= self->size) {
+        PyErr_SetString(PyExc_IndexError, "Matrix index out of range");
+        return -1;
+    }
+    return row * self->size + col;
+}
+
+static PyObject *
+matrix_subscript(pgMatrix *self, PyObject *key)
+{
+    Py_ssize_t i = _matrix_index(self, key);
+
+    if (i < 0) {
+        return NULL;
+    }
+    return PyFloat_FromDouble(self->m[i]);
+}
+
+static int
+matrix_ass_subscript(pgMatrix *self, PyObject *key, PyObject *value)
+{
+    Py_ssize_t i;
+    double number;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Matrix doesn't support item deletion");
+        return -1;
+    }
+    i = _matrix_index(self, key);
+    if (i < 0) {
+        return -1;
+    }
+    number = PyFloat_AsDouble(value);
+    if (number == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+    self->m[i] = number;
+    return 0;
+}
+
+static int
+matrix_getbuffer(pgMatrix *self, Py_buffer *view, int flags)
+{
+    view->obj = (PyObject *)self;
+    Py_INCREF(self);
+    view->buf = self->m;
+    view->len = self->size * self->size * sizeof(double);
+    view->readonly = 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? "d" : NULL;
+    if ((flags & PyBUF_ND) == PyBUF_ND) {
+        view->ndim = 2;
+        view->shape = self->shape;
+    }
+    else {
+        view->ndim = 1;
+        view->shape = NULL;
+    }
+    view->strides =
+        (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+static PyObject *
+matrix_richcompare(PyObject *o1, PyObject *o2, int op)
+{
+    pgMatrix *m1 = (pgMatrix *)o1, *m2 = (pgMatrix *)o2;
+    Py_ssize_t i;
+    int equal = 1;
+
+    if ((op != Py_EQ && op != Py_NE) || Py_TYPE(o1) != Py_TYPE(o2)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    for (i = 0; i < m1->size * m1->size; i++) {
+        if (m1->m[i] != m2->m[i]) {
+            equal = 0;
+            break;
+        }
+    }
+    return PyBool_FromLong(op == Py_EQ ? equal : !equal);
+}
+
+/* Sets task up to transform vectors by the matrix, as points which are
+ * translated or as directions which aren't. */
+static void
+_matrix_task(pgMatrix *self, vectorarray_task *task, int points)
+{
+    Py_ssize_t n = self->size, dim = n - 1, r, c;
+
+    task->op = VA_TRANSFORM;
+    task->dim = dim;
+    for (r = 0; r < dim; r++) {
+        for (c = 0; c < dim; c++)
+            task->matrix[r * dim + c] = self->m[r * n + c];
+        task->offset[r] = points ? self->m[r * n + dim] : 0;
+    }
+    if (points && !_matrix_is_affine(self)) {
+        task->op = VA_PROJECT;
+        for (c = 0; c < n; c++)
+            task->projection[c] = self->m[dim * n + c];
+    }
+}
+
+static PyObject *
+_matrix_transform(pgMatrix *self, PyObject *vector, int points)
+{
+    vectorarray_task task = {0};
+    double coords[3];
+    pgVector *ret;
+    Py_ssize_t dim = self->size - 1;
+
+    if (!pgVectorCompatible_Check(vector, dim) ||
+        !PySequence_AsVectorCoords(vector, coords, dim)) {
+        return PyErr_Format(PyExc_TypeError, "expected a Vector%zd", dim);
+    }
+    ret = (pgVector *)pgVector_NEW(dim);
+    if (ret == NULL) {
+        return NULL;
+    }
+    _matrix_task(self, &task, points);
+    task.src = coords;
+    task.dst = ret->coords;
+    if (!vectorarray_apply(&task, 1, NULL)) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+matrix_transform_point(pgMatrix *self, PyObject *point)
+{
+    return _matrix_transform(self, point, 1);
+}
+
+static PyObject *
+matrix_transform_vector(pgMatrix *self, PyObject *vector)
+{
+    return _matrix_transform(self, vector, 0);
+}
+
+static PyObject *
+matrix_transform_points(pgMatrix *self, PyObject *points)
+{
+    vectorarray_task task = {0};
+    pgVectorArray *ret;
+    PyTypeObject *type =
+        self->size == 3 ? &pgVector2Array_Type : &pgVector3Array_Type;
+
+    ret = (pgVectorArray *)PyObject_CallFunctionObjArgs((PyObject *)type,
+                                                        points, NULL);
+    if (ret == NULL) {
+        return NULL;
+    }
+    _matrix_task(self, &task, 1);
+    task.src = task.dst = ret->data;
+    if (!vectorarray_apply(&task, ret->length, NULL)) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+matrix_transform_points_ip(pgMatrix *self, PyObject *points)
+{
+    vectorarray_task task = {0};
+    Py_buffer view;
+    Py_ssize_t dim = self->size - 1, length;
+    int ok;
+
+    if (PyObject_GetBuffer(points, &view,
+                           PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS |
+                               PyBUF_FORMAT) < 0) {
+        return NULL;
+    }
+    if (!_vectorarray_buffer_check(&view, dim)) {
+        PyBuffer_Release(&view);
+        return PyErr_Format(PyExc_TypeError,
+                            "points must be a Vector%zdArray or a buffer of "
+                            "doubles, %zd for each point",
+                            dim, dim);
+    }
+    length = view.len / view.itemsize / dim;
+    if (length > INT_MAX) {
+        PyBuffer_Release(&view);
+        return RAISE(PyExc_ValueError, "too many points");
+    }
+
+    _matrix_task(self, &task, 1);
+    task.src = task.dst = (double *)view.buf;
+    /* A projection can fail on some point, so it is run into a copy first
+     * to leave the points unchanged by a failure. */
+    if (task.op == VA_PROJECT) {
+        task.dst = PyMem_New(double, MAX(length * dim, 1));
+        if (task.dst == NULL) {
+            PyBuffer_Release(&view);
+            return PyErr_NoMemory();
+        }
+    }
+    ok = vectorarray_apply(&task, length, NULL);
+    if (ok && task.dst != task.src) {
+        memcpy(view.buf, task.dst, length * dim * sizeof(double));
+    }
+    if (task.dst != task.src) {
+        PyMem_Free(task.dst);
+    }
+    PyBuffer_Release(&view);
+    if (!ok) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+matrix_matmul(PyObject *o1, PyObject *o2)
+{
+    pgMatrix *self = (pgMatrix *)o1, *ret;
+    Py_ssize_t dim;
+
+    if (!pgMatrix_Check(o1)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    dim = self->size - 1;
+    if (Py_TYPE(o2) == Py_TYPE(o1)) {
+        ret = _matrix_new(Py_TYPE(self));
+        if (ret != NULL) {
+            _matrix_multiply(ret->m, self->m, ((pgMatrix *)o2)->m,
+                             self->size);
+        }
+        return (PyObject *)ret;
+    }
+    if (pgVectorArray_Check(o2) && ((pgVectorArray *)o2)->dim == dim) {
+        return matrix_transform_points(self, o2);
+    }
+    if (pgVectorCompatible_Check(o2, dim)) {
+        return _matrix_transform(self, o2, 1);
+    }
+    Py_RETURN_NOTIMPLEMENTED;
+}
+
+static PyObject *
+matrix_inplace_matmul(PyObject *o1, PyObject *o2)
+{
+    pgMatrix *self = (pgMatrix *)o1;
+
+    if (Py_TYPE(o2) != Py_TYPE(o1)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    _matrix_multiply(self->m, self->m, ((pgMatrix *)o2)->m, self->size);
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+static PyObject *
+matrix_copy(pgMatrix *self, PyObject *_null)
 {
-    PyObject *module, *apiobj;
+    pgMatrix *ret = _matrix_new(Py_TYPE(self));
+
+    if (ret != NULL) {
+        memcpy(ret->m, self->m, sizeof(self->m));
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+matrix_determinant(pgMatrix *self, PyObject *_null)
+{
+    return PyFloat_FromDouble(_matrix_determinant(self->m, self->size));
+}
+
+static PyObject *
+matrix_inverse(pgMatrix *self, PyObject *_null)
+{
+    pgMatrix *ret = _matrix_new(Py_TYPE(self));
+
+    if (ret != NULL && !_matrix_inverse(ret->m, self->m, self->size)) {
+        Py_DECREF(ret);
+        return RAISE(PyExc_ValueError, "Matrix is not invertible");
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+matrix_transpose(pgMatrix *self, PyObject *_null)
+{
+    pgMatrix *ret = _matrix_new(Py_TYPE(self));
+    Py_ssize_t n = self->size, r, c;
+
+    if (ret != NULL) {
+        for (r = 0; r < n; r++) {
+            for (c = 0; c < n; c++)
+                ret->m[c * n + r] = self->m[r * n + c];
+        }
+    }
+    return (PyObject *)ret;
+}
+
+/* Splits a rotation matrix of 3D vectors into an angle in radians and a
+ * unit axis, the way _vector3_rotate_helper() puts them together. */
+static double
+_matrix_rotation_axis(const double *rot, double *axis)
+{
+    double cos_angle, angle, skew[3], length;
+    Py_ssize_t i, j, k;
+
+    cos_angle = (rot[0] + rot[4] + rot[8] - 1) / 2;
+    cos_angle = (cos_angle < -1 ? -1 : (cos_angle > 1 ? 1 : cos_angle));
+    angle = acos(cos_angle);
+    skew[0] = rot[7] - rot[5];
+    skew[1] = rot[2] - rot[6];
+    skew[2] = rot[3] - rot[1];
+
+    if (angle < VECTOR_EPSILON) {
+        axis[0] = axis[1] = 0;
+        axis[2] = 1;
+        return 0;
+    }
+    if (cos_angle >= 0) {
+        /* The skew part is 2 * sin(angle) * axis. */
+        for (i = 0; i < 3; i++)
+            axis[i] = skew[i];
+    }
+    else {
+        /* Near 180 degrees sin(angle) gets too small, so use the symmetric
+           part, (1 - cos(angle)) * axis * axis^T on the diagonal and off
+           it, from the largest element of the axis. */
+        k = 0;
+        for (i = 1; i < 3; i++) {
+            if (rot[i * 4] > rot[k * 4])
+                k = i;
+        }
+        axis[k] = sqrt((rot[k * 4] - cos_angle) / (1 - cos_angle));
+        for (j = 0; j < 3; j++) {
+            if (j != k) {
+                axis[j] = (rot[k * 3 + j] + rot[j * 3 + k]) /
+                          (2 * (1 - cos_angle) * axis[k]);
+            }
+        }
+        if (_scalar_product(axis, skew, 3) < 0) {
+            for (i = 0; i < 3; i++)
+                axis[i] = -axis[i];
+        }
+    }
+    length = sqrt(_scalar_product(axis, axis, 3));
+    for (i = 0; i < 3; i++)
+        axis[i] /= length;
+    return angle;
+}
+
+static PyObject *
+matrix_decompose(pgMatrix *self, PyObject *_null)
+{
+    const double *m = self->m;
+    double offset[3], scale[3], rot[9], axis[3], angle;
+    Py_ssize_t r, c;
+
+    if (!_matrix_is_affine(self)) {
+        return RAISE(PyExc_ValueError,
+                     "Can't decompose a Matrix that is not affine");
+    }
+    if (self->size == 3) {
+        scale[0] = sqrt(m[0] * m[0] + m[3] * m[3]);
+        if (scale[0] == 0) {
+            return RAISE(PyExc_ValueError,
+                         "Can't decompose a Matrix with a scale of zero");
+        }
+        angle = atan2(m[3], m[0]);
+        scale[1] = (m[0] * m[4] - m[1] * m[3]) / scale[0];
+        offset[0] = m[2];
+        offset[1] = m[5];
+        return Py_BuildValue("(NdN)", _matrix_vector(2, offset),
+                             RAD2DEG(angle), _matrix_vector(2, scale));
+    }
+
+    for (c = 0; c < 3; c++) {
+        scale[c] = sqrt(m[c] * m[c] + m[4 + c] * m[4 + c] +
+                        m[8 + c] * m[8 + c]);
+        if (scale[c] == 0) {
+            return RAISE(PyExc_ValueError,
+                         "Can't decompose a Matrix with a scale of zero");
+        }
+    }
+    for (r = 0; r < 3; r++) {
+        for (c = 0; c < 3; c++)
+            rot[r * 3 + c] = m[r * 4 + c];
+    }
+    /* A reflection is kept as a negative scale of x. */
+    if (_matrix_determinant(rot, 3) < 0) {
+        scale[0] = -scale[0];
+    }
+    for (r = 0; r < 3; r++) {
+        for (c = 0; c < 3; c++)
+            rot[r * 3 + c] /= scale[c];
+    }
+    angle = _matrix_rotation_axis(rot, axis);
+
+    offset[0] = m[3];
+    offset[1] = m[7];
+    offset[2] = m[11];
+    return Py_BuildValue("(NdNN)", _matrix_vector(3, offset), RAD2DEG(angle),
+                         _matrix_vector(3, axis), _matrix_vector(3, scale));
+}
+
+static PyNumberMethods matrix_as_number = {
+    .nb_matrix_multiply = (binaryfunc)matrix_matmul,
+    .nb_inplace_matrix_multiply = (binaryfunc)matrix_inplace_matmul,
+};
+
+static PyMappingMethods matrix_as_mapping = {
+    .mp_subscript = (binaryfunc)matrix_subscript,
+    .mp_ass_subscript = (objobjargproc)matrix_ass_subscript,
+};
+
+static PyBufferProcs matrix_as_buffer = {
+    .bf_getbuffer = (getbufferproc)matrix_getbuffer,
+};
+
+static PyMethodDef matrix3_methods[] = {
+    {"from_translation", (PyCFunction)matrix_from_translation,
+     METH_O | METH_CLASS, DOC_MATRIX3FROMTRANSLATION},
+    {"from_rotation", (PyCFunction)matrix_from_rotation,
+     METH_VARARGS | METH_CLASS, DOC_MATRIX3FROMROTATION},
+    {"from_scale", (PyCFunction)matrix_from_scale, METH_O | METH_CLASS,
+     DOC_MATRIX3FROMSCALE},
+    {"copy", (PyCFunction)matrix_copy, METH_NOARGS, DOC_MATRIX3COPY},
+    {"__copy__", (PyCFunction)matrix_copy, METH_NOARGS, NULL},
+    {"determinant", (PyCFunction)matrix_determinant, METH_NOARGS,
+     DOC_MATRIX3DETERMINANT},
+    {"inverse", (PyCFunction)matrix_inverse, METH_NOARGS,
+     DOC_MATRIX3INVERSE},
+    {"transpose", (PyCFunction)matrix_transpose, METH_NOARGS,
+     DOC_MATRIX3TRANSPOSE},
+    {"decompose", (PyCFunction)matrix_decompose, METH_NOARGS,
+     DOC_MATRIX3DECOMPOSE},
+    {"transform_point", (PyCFunction)matrix_transform_point, METH_O,
+     DOC_MATRIX3TRANSFORMPOINT},
+    {"transform_vector", (PyCFunction)matrix_transform_vector, METH_O,
+     DOC_MATRIX3TRANSFORMVECTOR},
+    {"transform_points", (PyCFunction)matrix_transform_points, METH_O,
+     DOC_MATRIX3TRANSFORMPOINTS},
+    {"transform_points_ip", (PyCFunction)matrix_transform_points_ip, METH_O,
+     DOC_MATRIX3TRANSFORMPOINTSIP},
+
+    {NULL} /* Sentinel */
+};
+
+static PyMethodDef matrix4_methods[] = {
+    {"from_translation", (PyCFunction)matrix_from_translation,
+     METH_O | METH_CLASS, DOC_MATRIX4FROMTRANSLATION},
+    {"from_rotation", (PyCFunction)matrix_from_rotation,
+     METH_VARARGS | METH_CLASS, DOC_MATRIX4FROMROTATION},
+    {"from_scale", (PyCFunction)matrix_from_scale, METH_O | METH_CLASS,
+     DOC_MATRIX4FROMSCALE},
+    {"copy", (PyCFunction)matrix_copy, METH_NOARGS, DOC_MATRIX4COPY},
+    {"__copy__", (PyCFunction)matrix_copy, METH_NOARGS, NULL},
+    {"determinant", (PyCFunction)matrix_determinant, METH_NOARGS,
+     DOC_MATRIX4DETERMINANT},
+    {"inverse", (PyCFunction)matrix_inverse, METH_NOARGS,
+     DOC_MATRIX4INVERSE},
+    {"transpose", (PyCFunction)matrix_transpose, METH_NOARGS,
+     DOC_MATRIX4TRANSPOSE},
+    {"decompose", (PyCFunction)matrix_decompose, METH_NOARGS,
+     DOC_MATRIX4DECOMPOSE},
+    {"transform_point", (PyCFunction)matrix_transform_point, METH_O,
+     DOC_MATRIX4TRANSFORMPOINT},
+    {"transform_vector", (PyCFunction)matrix_transform_vector, METH_O,
+     DOC_MATRIX4TRANSFORMVECTOR},
+    {"transform_points", (PyCFunction)matrix_transform_points, METH_O,
+     DOC_MATRIX4TRANSFORMPOINTS},
+    {"transform_points_ip", (PyCFunction)matrix_transform_points_ip, METH_O,
+     DOC_MATRIX4TRANSFORMPOINTSIP},
+
+    {NULL} /* Sentinel */
+};
+
+/********************************************
+ * pgMatrix3 and pgMatrix4 type definitions
+ ********************************************/
+
+static PyTypeObject pgMatrix3_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.math.Matrix3",
+    .tp_basicsize = sizeof(pgMatrix),
+    .tp_repr = (reprfunc)matrix_repr,
+    .tp_as_number = &matrix_as_number,
+    .tp_as_mapping = &matrix_as_mapping,
+    .tp_as_buffer = &matrix_as_buffer,
+    /* Not subtypable for now, no Py_TPFLAGS_BASETYPE */
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEMATHMATRIX3,
+    .tp_richcompare = (richcmpfunc)matrix_richcompare,
+    .tp_methods = matrix3_methods,
+    .tp_new = (newfunc)matrix_new,
+};
+
+static PyTypeObject pgMatrix4_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.math.Matrix4",
+    .tp_basicsize = sizeof(pgMatrix),
+    .tp_repr = (reprfunc)matrix_repr,
+    .tp_as_number = &matrix_as_number,
+    .tp_as_mapping = &matrix_as_mapping,
+    .tp_as_buffer = &matrix_as_buffer,
+    /* Not subtypable for now, no Py_TPFLAGS_BASETYPE */
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEMATHMATRIX4,
+    .tp_richcompare = (richcmpfunc)matrix_richcompare,
+    .tp_methods = matrix4_methods,
+    .tp_new = (newfunc)matrix_new,
+};
+
+static PyObject *
+math_enable_swizzling(pgVector *self, PyObject *_null)
+{
+    if (PyErr_WarnEx(PyExc_DeprecationWarning,
+                     "pygame.math.enable_swizzling() is deprecated, "
+                     "and its functionality is removed. This function will be "
+                     "removed in a later version.",
+                     1) == -1) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+math_disable_swizzling(pgVector *self, PyObject *_null)
+{
+    if (PyErr_WarnEx(PyExc_DeprecationWarning,
+                     "pygame.math.disable_swizzling() is deprecated, "
+                     "and its functionality is removed. This function will be "
+                     "removed in a later version.",
+                     1) == -1) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef _math_methods[] = {
+    {"enable_swizzling", (PyCFunction)math_enable_swizzling, METH_NOARGS,
+     "Deprecated, will be removed in a future version"},
+    {"disable_swizzling", (PyCFunction)math_disable_swizzling, METH_NOARGS,
+     "Deprecated, will be removed in a future version."},
+    {NULL, NULL, 0, NULL}};
+
+/****************************
+ * Module init function
+ ****************************/
+
+MODINIT_DEFINE(math)
+{
+    PyObject *module, *module_array, *apiobj;
     static void *c_api[PYGAMEAPI_MATH_NUMSLOTS];
 
     static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
@@ -4137,11 +6388,23 @@ MODINIT_DEFINE(math)
                                          NULL,
                                          NULL};
 
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
     /* initialize the extension types */
     if ((PyType_Ready(&pgVector2_Type) < 0) ||
         (PyType_Ready(&pgVector3_Type) < 0) ||
         (PyType_Ready(&pgVectorIter_Type) < 0) ||
-        (PyType_Ready(&pgVectorElementwiseProxy_Type) < 0) /*||
+        (PyType_Ready(&pgVectorElementwiseProxy_Type) < 0) ||
+        (PyType_Ready(&pgVector2Array_Type) < 0) ||
+        (PyType_Ready(&pgVector3Array_Type) < 0) ||
+        (PyType_Ready(&pgMatrix3_Type) < 0) ||
+        (PyType_Ready(&pgMatrix4_Type) < 0) /*||
         (PyType_Ready(&pgVector4_Type) < 0)*/) {
         return NULL;
     }
@@ -4158,6 +6421,10 @@ MODINIT_DEFINE(math)
     Py_INCREF(&pgVector3_Type);
     Py_INCREF(&pgVectorIter_Type);
     Py_INCREF(&pgVectorElementwiseProxy_Type);
+    Py_INCREF(&pgVector2Array_Type);
+    Py_INCREF(&pgVector3Array_Type);
+    Py_INCREF(&pgMatrix3_Type);
+    Py_INCREF(&pgMatrix4_Type);
     /*
     Py_INCREF(&pgVector4_Type);
     */
@@ -4169,7 +6436,15 @@ MODINIT_DEFINE(math)
                             (PyObject *)&pgVectorElementwiseProxy_Type) !=
          0) ||
         (PyModule_AddObject(module, "VectorIterator",
-                            (PyObject *)&pgVectorIter_Type) != 0) /*||
+                            (PyObject *)&pgVectorIter_Type) != 0) ||
+        (PyModule_AddObject(module, "Vector2Array",
+                            (PyObject *)&pgVector2Array_Type) != 0) ||
+        (PyModule_AddObject(module, "Vector3Array",
+                            (PyObject *)&pgVector3Array_Type) != 0) ||
+        (PyModule_AddObject(module, "Matrix3", (PyObject *)&pgMatrix3_Type) !=
+         0) ||
+        (PyModule_AddObject(module, "Matrix4", (PyObject *)&pgMatrix4_Type) !=
+         0) /*||
 (PyModule_AddObject(module, "Vector4", (PyObject *)&pgVector4_Type) !=
 0)*/) {
         if (!PyObject_HasAttrString(module, "Vector2"))
@@ -4180,6 +6455,14 @@ MODINIT_DEFINE(math)
             Py_DECREF(&pgVectorElementwiseProxy_Type);
         if (!PyObject_HasAttrString(module, "VectorIterator"))
             Py_DECREF(&pgVectorIter_Type);
+        if (!PyObject_HasAttrString(module, "Vector2Array"))
+            Py_DECREF(&pgVector2Array_Type);
+        if (!PyObject_HasAttrString(module, "Vector3Array"))
+            Py_DECREF(&pgVector3Array_Type);
+        if (!PyObject_HasAttrString(module, "Matrix3"))
+            Py_DECREF(&pgMatrix3_Type);
+        if (!PyObject_HasAttrString(module, "Matrix4"))
+            Py_DECREF(&pgMatrix4_Type);
         /*
         if (!PyObject_HasAttrString(module, "Vector4"))
             Py_DECREF(&pgVector4_Type);
@@ -4188,6 +6471,19 @@ MODINIT_DEFINE(math)
         return NULL;
     }
 
+    /* the results of the batch operations giving numbers are array.arrays */
+    module_array = PyImport_ImportModule("array");
+    if (module_array == NULL) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    vectorarray_scalar_type = PyObject_GetAttrString(module_array, "array");
+    Py_DECREF(module_array);
+    if (vectorarray_scalar_type == NULL) {
+        Py_DECREF(module);
+        return NULL;
+    }
+
     /* export the C api */
     c_api[0] = &pgVector2_Type;
     c_api[1] = &pgVector3_Type;
@@ -313,6 +313,8 @@ _pxarray_new_internal(PyTypeObject *type, pgSurfaceObject *surface,
             Py_TYPE(self)->tp_free((PyObject *)self);
             return 0;
         }
+        /* Any pixel can be set through the array */
+        pgSurface_AddDamage(surface, NULL);
     }
     else {
         self->parent = parent;
@@ -746,6 +746,7 @@ array_to_surface(PyObject *self, PyObject *arg)
     if (!pgSurface_UnlockBy(surfobj, arrayobj)) {
         return NULL;
     }
+    pgSurface_AddDamage(surfobj, NULL);
     Py_RETURN_NONE;
 }
 
@@ -101,8 +101,23 @@ typedef struct pg_BlitMap {
 int
 pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
                SDL_Rect *dstrect, SDL_Rect *srcrect, int the_args);
+static void
+pgSurface_AddDamage(pgSurfaceObject *surfobj, const SDL_Rect *rect);
+static int
+pgSurface_TakeDamage(pgSurfaceObject *surfobj, SDL_Rect *rects);
 
 /* statics */
+/* The damage of the surfaces tracking it. It is kept here rather than in
+ * pgSurfaceObject, so that the object's layout stays the same for compiled
+ * extensions. Few surfaces track damage, so a list is enough. */
+static struct pgDamage_Data *damage_list = NULL;
+
+static struct pgDamage_Data *
+damage_find(pgSurfaceObject *surfobj);
+static void
+damage_remove(pgSurfaceObject *surfobj);
+static void
+damage_add(struct pgDamage_Data *damage, const SDL_Rect *rect);
 static PyObject *
 pgSurface_New2(SDL_Surface *info, int owner);
 static PyObject *
@@ -178,6 +193,13 @@ surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
 surf_scroll(PyObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
+surf_set_damage_tracking(pgSurfaceObject *self, PyObject *args,
+                         PyObject *keywds);
+static PyObject *
+surf_get_damage(pgSurfaceObject *self, PyObject *args);
+static PyObject *
+surf_clear_damage(pgSurfaceObject *self, PyObject *args);
+static PyObject *
 surf_get_abs_offset(PyObject *self, PyObject *args);
 static PyObject *
 surf_get_abs_parent(PyObject *self, PyObject *args);
@@ -346,6 +368,13 @@ static struct PyMethodDef surface_methods[] = {
     {"scroll", (PyCFunction)surf_scroll, METH_VARARGS | METH_KEYWORDS,
      DOC_SURFACESCROLL},
 
+    {"set_damage_tracking", (PyCFunction)surf_set_damage_tracking,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACESETDAMAGETRACKING},
+    {"get_damage", (PyCFunction)surf_get_damage, METH_NOARGS,
+     DOC_SURFACEGETDAMAGE},
+    {"clear_damage", (PyCFunction)surf_clear_damage, METH_NOARGS,
+     DOC_SURFACECLEARDAMAGE},
+
     {"get_flags", surf_get_flags, METH_NOARGS, DOC_SURFACEGETFLAGS},
     {"get_size", surf_get_size, METH_NOARGS, DOC_SURFACEGETSIZE},
     {"get_width", surf_get_width, METH_NOARGS, DOC_SURFACEGETWIDTH},
@@ -481,6 +510,7 @@ surface_dealloc(PyObject *self)
     if (((pgSurfaceObject *)self)->weakreflist)
         PyObject_ClearWeakRefs(self);
     surface_cleanup((pgSurfaceObject *)self);
+    damage_remove((pgSurfaceObject *)self);
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -801,6 +831,7 @@ surf_set_at(PyObject *self, PyObject *args)
     Uint8 rgba[4] = {0, 0, 0, 0};
     PyObject *rgba_obj;
     Uint8 *byte_buf;
+    SDL_Rect drawn;
 
     if (!PyArg_ParseTuple(args, "(ii)O", &x, &y, &rgba_obj))
         return NULL;
@@ -869,6 +900,11 @@ surf_set_at(PyObject *self, PyObject *args)
 
     if (!pgSurface_Unlock((pgSurfaceObject *)self))
         return NULL;
+
+    drawn.x = x;
+    drawn.y = y;
+    drawn.w = drawn.h = 1;
+    pgSurface_AddDamage((pgSurfaceObject *)self, &drawn);
     Py_RETURN_NONE;
 }
 
@@ -971,6 +1007,8 @@ surf_lock(PyObject *self, PyObject *_null)
 {
     if (!pgSurface_Lock((pgSurfaceObject *)self))
         return NULL;
+    /* Locking is for writing the pixels directly */
+    pgSurface_AddDamage((pgSurfaceObject *)self, NULL);
     Py_RETURN_NONE;
 }
 
@@ -1743,7 +1781,7 @@ surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
     int result;
     PyObject *rgba_obj;
     Uint8 rgba[4];
-    SDL_Rect sdlrect;
+    SDL_Rect sdlrect, drawn;
     int blendargs = 0;
 
     static char *kwids[] = {"color", "rect", "special_flags", NULL};
@@ -1823,6 +1861,8 @@ surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
         }
         if (result == -1)
             return RAISE(pgExc_SDLError, SDL_GetError());
+        if (SDL_IntersectRect(&sdlrect, &surf->clip_rect, &drawn))
+            pgSurface_AddDamage(self, &drawn);
     }
     return pgRect_New(&sdlrect);
 }
@@ -2175,6 +2215,84 @@ surf_scroll(PyObject *self, PyObject *args, PyObject *keywds)
         return NULL;
     }
 
+    pgSurface_AddDamage((pgSurfaceObject *)self, clip_rect);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_set_damage_tracking(pgSurfaceObject *self, PyObject *args,
+                         PyObject *keywds)
+{
+    struct pgDamage_Data *damage = damage_find(self);
+    SDL_Rect rects[PG_DAMAGE_MAX_RECTS + 1];
+    int enable = 1, max_rects = 16;
+    int i, count;
+
+    static char *kwids[] = {"enable", "max_rects", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|pi", kwids, &enable,
+                                     &max_rects))
+        return NULL;
+
+    if (max_rects < 1 || max_rects > PG_DAMAGE_MAX_RECTS) {
+        return PyErr_Format(PyExc_ValueError,
+                            "max_rects must be between 1 and %d",
+                            PG_DAMAGE_MAX_RECTS);
+    }
+
+    if (!enable) {
+        damage_remove(self);
+        Py_RETURN_NONE;
+    }
+
+    if (!damage) {
+        damage = PyMem_New(struct pgDamage_Data, 1);
+        if (!damage)
+            return PyErr_NoMemory();
+        damage->surfobj = (PyObject *)self;
+        damage->count = 0;
+        damage->next = damage_list;
+        damage_list = damage;
+    }
+
+    /* Merge what is already recorded down to the new limit. */
+    count = damage->count;
+    memcpy(rects, damage->rects, count * sizeof(SDL_Rect));
+    damage->count = 0;
+    damage->max_rects = max_rects;
+    for (i = 0; i < count; i++) {
+        damage_add(damage, rects + i);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_damage(pgSurfaceObject *self, PyObject *_null)
+{
+    struct pgDamage_Data *damage = damage_find(self);
+    PyObject *list, *rect;
+    int i, count = damage ? damage->count : 0;
+
+    list = PyList_New(count);
+    if (!list)
+        return NULL;
+    for (i = 0; i < count; i++) {
+        rect = pgRect_New(damage->rects + i);
+        if (!rect) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, rect);
+    }
+    return list;
+}
+
+static PyObject *
+surf_clear_damage(pgSurfaceObject *self, PyObject *_null)
+{
+    struct pgDamage_Data *damage = damage_find(self);
+
+    if (damage)
+        damage->count = 0;
     Py_RETURN_NONE;
 }
 
@@ -3368,6 +3486,8 @@ _init_buffer(PyObject *surf, Py_buffer *view_p, int flags)
         PyMem_Free(internal);
         return -1;
     }
+    /* The consumer can write anywhere in the pixels */
+    pgSurface_AddDamage((pgSurfaceObject *)surf, NULL);
     if (PyBUF_HAS_FLAG(flags, PyBUF_ND)) {
         view_p->shape = internal->mem;
         if (PyBUF_HAS_FLAG(flags, PyBUF_STRIDES)) {
@@ -3490,6 +3610,7 @@ surf_get_pixels_address(PyObject *self, PyObject *closure)
     if (!surface->pixels) {
         return PyLong_FromLong(0L);
     }
+    pgSurface_AddDamage((pgSurfaceObject *)self, NULL);
     address = surface->pixels;
 #if SIZEOF_VOID_P > SIZEOF_LONG
     return PyLong_FromUnsignedLongLong((unsigned PY_LONG_LONG)address);
@@ -3597,6 +3718,171 @@ surface_do_overlap(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
     return dstoffset < span || dstoffset > src->pitch - span;
 }
 
+static struct pgDamage_Data *
+damage_find(pgSurfaceObject *surfobj)
+{
+    struct pgDamage_Data *damage;
+
+    for (damage = damage_list; damage; damage = damage->next) {
+        if (damage->surfobj == (PyObject *)surfobj)
+            return damage;
+    }
+    return NULL;
+}
+
+static void
+damage_remove(pgSurfaceObject *surfobj)
+{
+    struct pgDamage_Data **link = &damage_list, *damage;
+
+    while ((damage = *link)) {
+        if (damage->surfobj == (PyObject *)surfobj) {
+            *link = damage->next;
+            PyMem_Free(damage);
+            return;
+        }
+        link = &damage->next;
+    }
+}
+
+static Sint64
+damage_area(const SDL_Rect *r)
+{
+    return (Sint64)r->w * r->h;
+}
+
+static void
+damage_union(const SDL_Rect *a, const SDL_Rect *b, SDL_Rect *u)
+{
+    int x = MIN(a->x, b->x);
+    int y = MIN(a->y, b->y);
+
+    u->w = MAX(a->x + a->w, b->x + b->w) - x;
+    u->h = MAX(a->y + a->h, b->y + b->h) - y;
+    u->x = x;
+    u->y = y;
+}
+
+/* Adds a non-empty rect to the damage. It is merged with the recorded rects
+ * whose bounding box with it is no bigger than the two together, which
+ * covers overlapping, nested and adjoining rects without updating pixels
+ * nobody drew to. Past max_rects, the two rects whose bounding box adds the
+ * fewest pixels are merged. */
+static void
+damage_add(struct pgDamage_Data *damage, const SDL_Rect *rect)
+{
+    SDL_Rect *rects = damage->rects;
+    SDL_Rect r = *rect, u;
+    Sint64 waste, best_waste;
+    int i, j, best_i = 0, best_j = 1;
+
+    i = 0;
+    while (i < damage->count) {
+        damage_union(rects + i, &r, &u);
+        if (damage_area(&u) <= damage_area(rects + i) + damage_area(&r)) {
+            /* The merged rect can now reach ones checked already. */
+            r = u;
+            rects[i] = rects[--damage->count];
+            i = 0;
+        }
+        else {
+            ++i;
+        }
+    }
+    rects[damage->count++] = r;
+
+    if (damage->count <= damage->max_rects)
+        return;
+
+    best_waste = -1;
+    for (i = 0; i < damage->count; i++) {
+        for (j = i + 1; j < damage->count; j++) {
+            damage_union(rects + i, rects + j, &u);
+            waste = damage_area(&u) - damage_area(rects + i) -
+                    damage_area(rects + j);
+            if (best_waste < 0 || waste < best_waste) {
+                best_waste = waste;
+                best_i = i;
+                best_j = j;
+            }
+        }
+    }
+    damage_union(rects + best_i, rects + best_j, &u);
+    rects[best_j] = rects[--damage->count];
+    rects[best_i] = rects[--damage->count];
+    damage_add(damage, &u);
+}
+
+/* Records rect, or all of the surface if rect is NULL, as drawn to on
+ * surfobj and the surfaces it is a subsurface of, for those of them
+ * tracking damage. Accessible through the C api. */
+static void
+pgSurface_AddDamage(pgSurfaceObject *surfobj, const SDL_Rect *rect)
+{
+    SDL_Rect r, bounds, clipped;
+    struct pgSubSurface_Data *subdata;
+    struct pgDamage_Data *damage;
+
+    if (!damage_list || !surfobj || !surfobj->surf)
+        return;
+    if (rect) {
+        r = *rect;
+    }
+    else {
+        r.x = r.y = 0;
+        r.w = surfobj->surf->w;
+        r.h = surfobj->surf->h;
+    }
+
+    while (surfobj && surfobj->surf) {
+        bounds.x = bounds.y = 0;
+        bounds.w = surfobj->surf->w;
+        bounds.h = surfobj->surf->h;
+        if (!SDL_IntersectRect(&r, &bounds, &clipped))
+            return;
+        damage = damage_find(surfobj);
+        if (damage)
+            damage_add(damage, &clipped);
+
+        subdata = surfobj->subsurface;
+        if (!subdata)
+            return;
+        r.x = clipped.x + subdata->offsetx;
+        r.y = clipped.y + subdata->offsety;
+        r.w = clipped.w;
+        r.h = clipped.h;
+        surfobj = (pgSurfaceObject *)subdata->owner;
+    }
+}
+
+/* Copies the damage recorded on surfobj to rects, which has room for
+ * PG_DAMAGE_MAX_RECTS rects, or drops it if rects is NULL, and clears it.
+ * Returns the number of rects, or -1 if the damage is not known: when
+ * surfobj does not track damage, or while its pixels can be written
+ * directly by a buffer, a PixelArray or Surface.lock(). In that case all
+ * of surfobj is kept as damaged, as it can change until it is unlocked.
+ * Accessible through the C api. */
+static int
+pgSurface_TakeDamage(pgSurfaceObject *surfobj, SDL_Rect *rects)
+{
+    struct pgDamage_Data *damage = damage_find(surfobj);
+    int count;
+
+    if (!damage)
+        return -1;
+    if (surfobj->locklist && PyList_Size(surfobj->locklist) > 0) {
+        damage->count = 0;
+        pgSurface_AddDamage(surfobj, NULL);
+        return -1;
+    }
+
+    count = damage->count;
+    if (rects)
+        memcpy(rects, damage->rects, count * sizeof(SDL_Rect));
+    damage->count = 0;
+    return count;
+}
+
 /*this internal blit function is accessible through the C api*/
 int
 pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
@@ -3729,6 +4015,8 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
     if (result == -2)
         PyErr_SetString(pgExc_SDLError, "Surface was lost");
+    if (result == 0)
+        pgSurface_AddDamage(dstobj, dstrect);
 
     return result != 0;
 }
@@ -3804,6 +4092,9 @@ MODINIT_DEFINE(surface)
     c_api[1] = pgSurface_New2;
     c_api[2] = pgSurface_Blit;
     c_api[3] = pgSurface_SetSurface;
+    c_api[4] = pgSurface_AddDamage;
+    c_api[5] = pygame_Blit;
+    c_api[6] = pgSurface_TakeDamage;
     apiobj = encapsulate_api(c_api, "surface");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
@@ -33,6 +33,7 @@ typedef struct pgEventTimer {
     intptr_t timer_id;
     pgEventObject *event;
     int repeat;
+    int plain; /* the event has no attributes when the timer is set */
 } pgEventTimer;
 
 static pgEventTimer *pg_event_timer = NULL;
@@ -100,6 +101,7 @@ _pg_add_event_timer(pgEventObject *ev, int repeat)
     new->timer_id = pg_timer_id;
     new->event = ev;
     new->repeat = repeat;
+    new->plain = !PyDict_Size(ev->dict);
     pg_event_timer = new;
 
     /* Chances of it failing here are next to zero, dont do anything */
@@ -135,11 +137,15 @@ _pg_remove_event_timer(pgEventObject *ev)
     SDL_UnlockMutex(timermutex);
 }
 
+/* Also gets the type of a plain timer event in *plain_type, or -1, and
+ * the repeats left. They are read under the lock, as the timer can be
+ * removed by another thread while the callback does not hold the GIL */
 static pgEventTimer *
-_pg_get_event_on_timer(intptr_t timer_id)
+_pg_get_event_on_timer(intptr_t timer_id, int *plain_type, int *repeat)
 {
     pgEventTimer *hunt;
 
+    *plain_type = -1;
     if (SDL_LockMutex(timermutex) < 0)
         return NULL;
 
@@ -149,6 +155,10 @@ _pg_get_event_on_timer(intptr_t timer_id)
             if (hunt->repeat >= 0) {
                 hunt->repeat--;
             }
+            if (hunt->plain) {
+                *plain_type = hunt->event->type;
+            }
+            *repeat = hunt->repeat;
             break;
         }
         hunt = hunt->next;
@@ -165,22 +175,33 @@ timer_callback(Uint32 interval, void *param)
     pgEventTimer *evtimer;
     SDL_Event event;
     PyGILState_STATE gstate;
+    int plain_type, repeat, video;
 
-    evtimer = _pg_get_event_on_timer((intptr_t)param);
+    evtimer = _pg_get_event_on_timer((intptr_t)param, &plain_type, &repeat);
     if (!evtimer)
         return 0;
+    video = SDL_WasInit(SDL_INIT_VIDEO);
+
+    /* An event without attributes needs no python objects, so it is
+     * posted without the GIL, which is then only needed for cleanup */
+    if (plain_type != -1 && video) {
+        pgEvent_PostPayload(plain_type, NULL, 0);
+        if (repeat)
+            return interval;
+    }
 
     /* This function runs in a seperate thread, so we acquire the GIL,
      * pgEvent_FillUserEvent and _pg_remove_event_timer do python API calls */
     gstate = PyGILState_Ensure();
 
-    if (SDL_WasInit(SDL_INIT_VIDEO)) {
+    if (!video) {
+        evtimer->repeat = 0;
+    }
+    else if (plain_type == -1) {
         pgEvent_FillUserEvent(evtimer->event, &event);
         if (SDL_PushEvent(&event) <= 0)
             Py_DECREF(evtimer->event->dict);
     }
-    else
-        evtimer->repeat = 0;
 
     if (!evtimer->repeat) {
         /* This does memory cleanup */
@@ -575,6 +575,7 @@ surf_scale(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 
     if (surfobj2) {
+        pgSurface_AddDamage((pgSurfaceObject *)surfobj2, NULL);
         Py_INCREF(surfobj2);
         return surfobj2;
     }
@@ -669,6 +670,7 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
     SDL_UnlockSurface(newsurf);
 
     if (surfobj2) {
+        pgSurface_AddDamage((pgSurfaceObject *)surfobj2, NULL);
         Py_INCREF(surfobj2);
         return surfobj2;
     }
@@ -1535,6 +1537,7 @@ surf_scalesmooth(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 
     if (surfobj2) {
+        pgSurface_AddDamage((pgSurfaceObject *)surfobj2, NULL);
         Py_INCREF(surfobj2);
         return surfobj2;
     }
@@ -1990,8 +1993,10 @@ surf_threshold(PyObject *self, PyObject *args, PyObject *kwds)
                       color_set_color, set_behavior, search_surf, inverse_set);
     Py_END_ALLOW_THREADS;
 
-    if (dest_surf)
+    if (dest_surf) {
         pgSurface_Unlock((pgSurfaceObject *)dest_surf_obj);
+        pgSurface_AddDamage((pgSurfaceObject *)dest_surf_obj, NULL);
+    }
     pgSurface_Unlock(surf_obj);
     if (search_surf)
         pgSurface_Unlock((pgSurfaceObject *)search_surf_obj);
@@ -2336,6 +2341,7 @@ surf_laplacian(PyObject *self, PyObject *args, PyObject *kwargs)
     SDL_UnlockSurface(newsurf);
 
     if (surfobj2) {
+        pgSurface_AddDamage((pgSurfaceObject *)surfobj2, NULL);
         Py_INCREF(surfobj2);
         return surfobj2;
     }
@@ -2655,6 +2661,7 @@ surf_average_surfaces(PyObject *self, PyObject *args, PyObject *kwargs)
         SDL_UnlockSurface(newsurf);
 
         if (surfobj2) {
+            pgSurface_AddDamage((pgSurfaceObject *)surfobj2, NULL);
             Py_INCREF(surfobj2);
             ret = surfobj2;
         }
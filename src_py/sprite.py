@@ -93,6 +93,7 @@ import pygame
 from pygame.rect import Rect
 from pygame.time import get_ticks
 from pygame.mask import from_surface
+from pygame._spritegroup import GroupCore, LayerOrder, draw_dirty
 
 
 class Sprite:
@@ -644,6 +645,68 @@ RenderPlain = Group
 RenderClear = Group
 
 
+class FastGroup(AbstractGroup):
+    """container class for many Sprites, stored in native arrays
+
+    pygame.sprite.FastGroup(*sprites): return FastGroup
+
+    Behaves like pygame.sprite.Group(), but keeps its Sprites in contiguous
+    native storage. Adding, removing and membership tests are O(1), and
+    update(), draw() and clear() walk that storage directly instead of
+    building a list of Sprites on every call. draw() requires a Surface.
+
+    Removing a Sprite moves the last Sprite into its place, so the order
+    of sprites() changes as the group changes, just like Group's order is
+    not defined.
+
+    The spritedict and lostsprites attributes are rebuilt on access; they
+    are snapshots, and changing them does not change the group.
+
+    """
+
+    def __init__(self, *sprites):  # noqa pylint: disable=super-init-not-called
+        self._core = GroupCore()
+        self.add(*sprites)
+
+    @property
+    def spritedict(self):
+        return self._core.spritedict()
+
+    @property
+    def lostsprites(self):
+        return self._core.lostsprites()
+
+    def sprites(self):
+        return self._core.sprites()
+
+    def add_internal(self, sprite, layer=None):
+        self._core.add(sprite)
+
+    def remove_internal(self, sprite):
+        self._core.remove(sprite)
+
+    def has_internal(self, sprite):
+        return sprite in self._core
+
+    def update(self, *args, **kwargs):
+        self._core.update(*args, **kwargs)
+
+    def draw(self, surface):
+        self._core.draw(surface)
+        return []
+
+    def clear(self, surface, bgd):
+        self._core.clear(surface, bgd)
+
+    def __nonzero__(self):
+        return len(self._core) != 0
+
+    __bool__ = __nonzero__
+
+    def __len__(self):
+        return len(self._core)
+
+
 class RenderUpdates(Group):
     """Group class that tracks dirty updates
 
@@ -710,6 +773,11 @@ class LayeredUpdates(AbstractGroup):
     This group is fully compatible with pygame.sprite.Sprite.
     New in pygame 1.8.0
 
+    Changed in pygame 2.1.3: _spritelist is no longer a list. It can be
+    indexed, sliced and iterated but not changed with list methods, and
+    _spritelayers is a read-only property returning a new dict. Subclasses
+    should use add(), remove() and change_layer() instead.
+
     """
 
     _init_rect = Rect(0, 0, 0, 0)
@@ -727,13 +795,16 @@ class LayeredUpdates(AbstractGroup):
         used to add the sprites.
 
         """
-        self._spritelayers = {}
-        self._spritelist = []
+        self._spritelist = LayerOrder()
         AbstractGroup.__init__(self)
         self._default_layer = kwargs.get("default_layer", 0)
 
         self.add(*sprites, **kwargs)
 
+    @property
+    def _spritelayers(self):
+        return self._spritelist.layer_dict()
+
     def add_internal(self, sprite, layer=None):
         """Do not use this method directly.
 
@@ -751,25 +822,7 @@ class LayeredUpdates(AbstractGroup):
         elif hasattr(sprite, "_layer"):
             setattr(sprite, "_layer", layer)
 
-        sprites = self._spritelist  # speedup
-        sprites_layers = self._spritelayers
-        sprites_layers[sprite] = layer
-
-        # add the sprite at the right position
-        # bisect algorithmus
-        leng = len(sprites)
-        low = mid = 0
-        high = leng - 1
-        while low <= high:
-            mid = low + (high - low) // 2
-            if sprites_layers[sprites[mid]] <= layer:
-                low = mid + 1
-            else:
-                high = mid - 1
-        # linear search to find final position
-        while mid < leng and sprites_layers[sprites[mid]] <= layer:
-            mid += 1
-        sprites.insert(mid, sprite)
+        self._spritelist.add(sprite, layer)
 
     def add(self, *sprites, **kwargs):
         """add a sprite or sequence of sprites to a group
@@ -829,7 +882,6 @@ class LayeredUpdates(AbstractGroup):
             self.lostsprites.append(sprite.rect)  # dirty rect
 
         del self.spritedict[sprite]
-        del self._spritelayers[sprite]
 
     def sprites(self):
         """return a ordered list of sprites (first back, last top).
@@ -837,7 +889,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.sprites(): return sprites
 
         """
-        return list(self._spritelist)
+        return self._spritelist.sprites()
 
     def draw(self, surface):
         """draw all sprites in the right order onto the passed surface
@@ -873,7 +925,7 @@ class LayeredUpdates(AbstractGroup):
         Bottom sprites are listed first; the top ones are listed last.
 
         """
-        _sprites = self._spritelist
+        _sprites = self._spritelist.sprites()
         rect = Rect(pos, (1, 1))
         colliding_idx = rect.collidelistall(_sprites)
         return [_sprites[i] for i in colliding_idx]
@@ -905,7 +957,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.layers(): return layers
 
         """
-        return sorted(set(self._spritelayers.values()))
+        return self._spritelist.layers()
 
     def change_layer(self, sprite, new_layer):
         """change the layer of the sprite
@@ -916,32 +968,23 @@ class LayeredUpdates(AbstractGroup):
         checked.
 
         """
-        sprites = self._spritelist  # speedup
-        sprites_layers = self._spritelayers  # speedup
-
-        sprites.remove(sprite)
-        sprites_layers.pop(sprite)
-
-        # add the sprite at the right position
-        # bisect algorithmus
-        leng = len(sprites)
-        low = mid = 0
-        high = leng - 1
-        while low <= high:
-            mid = low + (high - low) // 2
-            if sprites_layers[sprites[mid]] <= new_layer:
-                low = mid + 1
-            else:
-                high = mid - 1
-        # linear search to find final position
-        while mid < leng and sprites_layers[sprites[mid]] <= new_layer:
-            mid += 1
-        sprites.insert(mid, sprite)
+        self._spritelist.move(sprite, new_layer)
         if hasattr(sprite, "_layer"):
             setattr(sprite, "_layer", new_layer)
 
-        # add layer info
-        sprites_layers[sprite] = new_layer
+    def sort_layers(self, key):
+        """change the layer of every sprite at once
+
+        LayeredUpdates.sort_layers(key): return None
+
+        Sets the layer of each sprite to key(sprite) and reorders the group,
+        as if change_layer() had been called for every sprite, but sprites
+        that end up on the same layer keep their relative order. This is
+        meant for depth sorting, e.g. key=lambda spr: spr.rect.bottom, and is
+        cheapest when the order changes little from one call to the next.
+
+        """
+        self._spritelist.resort(key, "_layer")
 
     def get_layer_of_sprite(self, sprite):
         """return the layer that sprite is currently in
@@ -949,7 +992,7 @@ class LayeredUpdates(AbstractGroup):
         If the sprite is not found, then it will return the default layer.
 
         """
-        return self._spritelayers.get(sprite, self._default_layer)
+        return self._spritelist.layer_of(sprite, self._default_layer)
 
     def get_top_layer(self):
         """return the top layer
@@ -957,7 +1000,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.get_top_layer(): return layer
 
         """
-        return self._spritelayers[self._spritelist[-1]]
+        return self._spritelist.layer_of(self._spritelist[-1])
 
     def get_bottom_layer(self):
         """return the bottom layer
@@ -965,7 +1008,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.get_bottom_layer(): return layer
 
         """
-        return self._spritelayers[self._spritelist[0]]
+        return self._spritelist.layer_of(self._spritelist[0])
 
     def move_to_front(self, sprite):
         """bring the sprite to front layer
@@ -1008,17 +1051,7 @@ class LayeredUpdates(AbstractGroup):
         layer.
 
         """
-        sprites = []
-        sprites_append = sprites.append
-        sprite_layers = self._spritelayers
-        for spr in self._spritelist:
-            if sprite_layers[spr] == layer:
-                sprites_append(spr)
-            elif sprite_layers[spr] > layer:
-                # break after because no other will
-                # follow with same layer
-                break
-        return sprites
+        return self._spritelist.from_layer(layer)
 
     def switch_layer(self, layer1_nr, layer2_nr):
         """switch the sprites from layer1_nr to layer2_nr
@@ -1123,61 +1156,31 @@ class LayeredDirty(LayeredUpdates):
         value that is not None, then the bgd argument has no effect.
 
         """
-        # functions and classes assigned locally to speed up loops
         orig_clip = surface.get_clip()
         latest_clip = self._clip
         if latest_clip is None:
             latest_clip = orig_clip
 
-        local_sprites = self._spritelist
-        local_old_rect = self.spritedict
-        local_update = self.lostsprites
-        rect_type = Rect
-
-        surf_blit_func = surface.blit
         if bgd is not None:
             self._bgd = bgd
-        local_bgd = self._bgd
 
         surface.set_clip(latest_clip)
         # -------
         # 0. decide whether to render with update or flip
         start_time = get_ticks()
-        if self._use_update:  # dirty rects mode
-            # 1. find dirty area on screen and put the rects into
-            # self.lostsprites still not happy with that part
-            self._find_dirty_area(
-                latest_clip,
-                local_old_rect,
-                rect_type,
-                local_sprites,
-                local_update,
-                local_update.append,
-                self._init_rect,
-            )
-            # can it be done better? because that is an O(n**2) algorithm in
-            # worst case
-
-            # clear using background
-            if local_bgd is not None:
-                for rec in local_update:
-                    surf_blit_func(local_bgd, rec, rec)
-
-            # 2. draw
-            self._draw_dirty_internal(
-                local_old_rect, rect_type, local_sprites, surf_blit_func, local_update
-            )
-            local_ret = list(local_update)
-        else:  # flip, full screen mode
-            if local_bgd is not None:
-                surf_blit_func(local_bgd, (0, 0))
-            for spr in local_sprites:
-                if spr.visible:
-                    local_old_rect[spr] = surf_blit_func(
-                        spr.image, spr.rect, spr.source_rect, spr.blendmode
-                    )
-            # return only the part of the screen changed
-            local_ret = [rect_type(latest_clip)]
+        # In dirty rects mode this merges the dirty areas and the lost
+        # sprites into the rects to repaint, clears them with the background
+        # and draws the sprites over them. Sprites hidden under opaque
+        # sprites are skipped in both modes.
+        local_ret = draw_dirty(
+            surface,
+            self._spritelist.sprites(),
+            self.spritedict,
+            self.lostsprites,
+            self._bgd,
+            self._init_rect,
+            self._use_update,
+        )
 
         # timing for switching modes
         # How may a good threshold be found? It depends on the hardware.
@@ -1188,85 +1191,13 @@ class LayeredDirty(LayeredUpdates):
             self._use_update = True
 
         # emtpy dirty rects list
-        local_update[:] = []
+        self.lostsprites[:] = []
 
         # -------
         # restore original clip
         surface.set_clip(orig_clip)
         return local_ret
 
-    @staticmethod
-    def _draw_dirty_internal(_old_rect, _rect, _sprites, _surf_blit, _update):
-        for spr in _sprites:
-            if spr.dirty < 1 and spr.visible:
-                # sprite not dirty; blit only the intersecting part
-                if spr.source_rect is not None:
-                    # For possible future speed up, source_rect's data
-                    # can be pre-fetched outside of this loop.
-                    _spr_rect = _rect(spr.rect.topleft, spr.source_rect.size)
-                    rect_offset_x = spr.source_rect[0] - _spr_rect[0]
-                    rect_offset_y = spr.source_rect[1] - _spr_rect[1]
-                else:
-                    _spr_rect = spr.rect
-                    rect_offset_x = -_spr_rect[0]
-                    rect_offset_y = -_spr_rect[1]
-
-                _spr_rect_clip = _spr_rect.clip
-
-                for idx in _spr_rect.collidelistall(_update):
-                    # clip
-                    clip = _spr_rect_clip(_update[idx])
-                    _surf_blit(
-                        spr.image,
-                        clip,
-                        (
-                            clip[0] + rect_offset_x,
-                            clip[1] + rect_offset_y,
-                            clip[2],
-                            clip[3],
-                        ),
-                        spr.blendmode,
-                    )
-            else:  # dirty sprite
-                if spr.visible:
-                    _old_rect[spr] = _surf_blit(
-                        spr.image, spr.rect, spr.source_rect, spr.blendmode
-                    )
-                if spr.dirty == 1:
-                    spr.dirty = 0
-
-    @staticmethod
-    def _find_dirty_area(
-        _clip, _old_rect, _rect, _sprites, _update, _update_append, init_rect
-    ):
-        for spr in _sprites:
-            if spr.dirty > 0:
-                # chose the right rect
-                if spr.source_rect:
-                    _union_rect = _rect(spr.rect.topleft, spr.source_rect.size)
-                else:
-                    _union_rect = _rect(spr.rect)
-
-                _union_rect_collidelist = _union_rect.collidelist
-                _union_rect_union_ip = _union_rect.union_ip
-                i = _union_rect_collidelist(_update)
-                while i > -1:
-                    _union_rect_union_ip(_update[i])
-                    del _update[i]
-                    i = _union_rect_collidelist(_update)
-                _update_append(_union_rect.clip(_clip))
-
-                if _old_rect[spr] is not init_rect:
-                    _union_rect = _rect(_old_rect[spr])
-                    _union_rect_collidelist = _union_rect.collidelist
-                    _union_rect_union_ip = _union_rect.union_ip
-                    i = _union_rect_collidelist(_update)
-                    while i > -1:
-                        _union_rect_union_ip(_update[i])
-                        del _update[i]
-                        i = _union_rect_collidelist(_update)
-                    _update_append(_union_rect.clip(_clip))
-
     def clear(self, surface, bgd):
         """use to set background
 
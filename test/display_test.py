@@ -707,6 +707,46 @@ class DisplayUpdateTest(unittest.TestCase):
         pygame.event.pump()  # so mac updates
         self.question("Is the screen green in (100, 100, 100, 100)?")
 
+    def test_update_damage(self):
+        """updates only the areas drawn to when the screen tracks damage."""
+        self.screen.set_damage_tracking()
+        self.screen.fill("green", (100, 100, 100, 100))
+        pygame.draw.circle(self.screen, "green", (350, 350), 50)
+        self.assertEqual(len(self.screen.get_damage()), 2)
+
+        pygame.display.update()
+        pygame.event.pump()  # so mac updates
+
+        self.assertEqual(self.screen.get_damage(), [])
+        self.question(
+            "Is the screen green in (100, 100, 100, 100) and a circle at "
+            "(350, 350), and black elsewhere?"
+        )
+
+        self.screen.fill("green", (0, 0, 10, 10))
+        pygame.display.flip()
+        self.assertEqual(self.screen.get_damage(), [])
+
+    def test_update_damage__locked(self):
+        """updates all of the screen while its pixels can be written
+        directly, as the areas drawn to are not known then."""
+        screen_rect = self.screen.get_rect()
+        self.screen.set_damage_tracking()
+        view = memoryview(self.screen.get_view("2"))
+        self.assertEqual(self.screen.get_damage(), [screen_rect])
+
+        pygame.display.update()
+        self.assertEqual(self.screen.get_damage(), [screen_rect])
+
+        view.release()
+        pygame.display.update()
+        self.assertEqual(self.screen.get_damage(), [])
+
+        self.screen.lock()
+        pygame.display.flip()
+        self.assertEqual(self.screen.get_damage(), [screen_rect])
+        self.screen.unlock()
+
     def test_update_incorrect_args(self):
         """raises a ValueError when inputs are wrong."""
 
@@ -1,6 +1,9 @@
+import array
 import math
+import random
 import unittest
 import sys
+import time
 import warnings
 
 import pygame
@@ -13,6 +16,8 @@ from pygame.math import Vector2
 
 RED = BG_RED = pygame.Color("red")
 GREEN = FG_GREEN = pygame.Color("green")
+BLUE = pygame.Color("blue")
+WHITE = pygame.Color("white")
 
 # Clockwise from the top left corner and ending with the center point.
 RECT_POSITION_ATTRIBUTES = (
@@ -4431,6 +4436,37 @@ class DrawPolygonTest(DrawPolygonMixin, DrawTestCase):
     the class to add any draw.polygon specific tests to.
     """
 
+    def test_polygon__long_spans(self):
+        """Ensures filled spans of various lengths and start offsets are
+        drawn exactly, on surfaces of every pixel depth.
+        """
+        surf_size = (140, 12)
+        surf_color = pygame.Color(10, 20, 30)
+        poly_color = pygame.Color(200, 150, 100)
+
+        for depth in (8, 16, 24, 32):
+            surface = pygame.Surface(surf_size, 0, depth)
+            expected_color = surface.unmap_rgb(surface.map_rgb(poly_color))
+            expected_surf_color = surface.unmap_rgb(surface.map_rgb(surf_color))
+
+            for left, right in ((0, 139), (1, 50), (3, 100), (7, 8), (13, 129)):
+                surface.fill(surf_color)
+                points = [(left, 2), (right, 2), (right, 9), (left, 9)]
+
+                bounding_rect = draw.polygon(surface, poly_color, points)
+
+                self.assertEqual(
+                    bounding_rect, pygame.Rect(left, 2, right - left + 1, 8)
+                )
+                for x in range(surf_size[0]):
+                    for y in range(surf_size[1]):
+                        expected = (
+                            expected_color
+                            if left <= x <= right and 2 <= y <= 9
+                            else expected_surf_color
+                        )
+                        self.assertEqual(surface.get_at((x, y)), expected, (x, y))
+
 
 # Commented out to avoid cluttering the test output. Add back in if draw_py
 # ever fully supports drawing polygons.
@@ -6457,6 +6493,922 @@ class DrawArcTest(DrawArcMixin, DrawTestCase):
 #    """
 
 
+### Batch Testing #############################################################
+
+
+class DrawBatchTest(unittest.TestCase):
+    """Test the batch drawing functions lines_batch, circles and rects.
+
+    Each batch call must draw the same pixels as the single shape functions
+    called once per item.
+    """
+
+    SURF_SIZE = (60, 50)
+    CLIP = pygame.Rect(5, 7, 48, 40)
+
+    @staticmethod
+    def _int_buffer(rows, fmt="i"):
+        """Returns a 2D buffer of the given rows, like a numpy array."""
+        flat = array.array(fmt, [value for row in rows for value in row])
+        return memoryview(flat).cast("B").cast(fmt, (len(rows), len(rows[0])))
+
+    def _surfaces(self, depth):
+        """Returns two identical cleared surfaces with a clip rect."""
+        surfaces = []
+        for _ in range(2):
+            surface = pygame.Surface(self.SURF_SIZE, 0, depth)
+            surface.fill((10, 20, 30))
+            surface.set_clip(self.CLIP)
+            surfaces.append(surface)
+        return surfaces
+
+    def _assert_same(self, batch_surf, single_surf, batch_rect, single_rects):
+        self.assertEqual(batch_surf.get_buffer().raw, single_surf.get_buffer().raw)
+        drawn = [rect for rect in single_rects if rect.size != (0, 0)]
+        if drawn:
+            self.assertEqual(batch_rect, drawn[0].unionall(drawn[1:]))
+        else:
+            self.assertEqual(batch_rect.size, (0, 0))
+
+    def test_lines_batch__same_as_line(self):
+        """Ensures lines_batch draws the same pixels and area as line()."""
+        rng = random.Random(31)
+        colors = [(255, 0, 0), (0, 255, 0), (0, 0, 255), (200, 100, 50)]
+
+        for depth in (8, 16, 24, 32):
+            for width in (1, 3):
+                lines = [
+                    tuple(rng.randint(-20, 80) for _ in range(4)) for _ in range(30)
+                ]
+                line_colors = [colors[i % len(colors)] for i in range(len(lines))]
+                batch_surf, single_surf = self._surfaces(depth)
+
+                batch_rect = draw.lines_batch(batch_surf, line_colors, lines, width)
+                single_rects = [
+                    draw.line(single_surf, color, line[:2], line[2:], width)
+                    for color, line in zip(line_colors, lines)
+                ]
+
+                self._assert_same(batch_surf, single_surf, batch_rect, single_rects)
+
+    def test_lines_batch__buffers(self):
+        """Ensures lines_batch reads lines and colors from buffers."""
+        lines = [(0, 0, 40, 30), (50, 2, 3, 45), (10, 20, 10, 20)]
+        colors = [(255, 0, 0), (0, 255, 0), (0, 0, 255)]
+        expected_surf, surface = self._surfaces(32)
+        expected_rect = draw.lines_batch(expected_surf, colors, lines)
+
+        for lines_buf in (
+            self._int_buffer(lines),
+            self._int_buffer(lines, "d"),
+            self._int_buffer(lines, "h"),
+        ):
+            surface.fill((10, 20, 30))
+            bounding_rect = draw.lines_batch(
+                surface, self._int_buffer(colors, "B"), lines_buf
+            )
+
+            self.assertEqual(bounding_rect, expected_rect)
+            self.assertEqual(surface.get_buffer().raw, expected_surf.get_buffer().raw)
+
+    def test_circles__same_as_circle(self):
+        """Ensures circles draws the same pixels and area as circle()."""
+        rng = random.Random(32)
+
+        for depth in (8, 16, 24, 32):
+            for width in (0, 1, 4):
+                centers = [
+                    (rng.randint(-10, 70), rng.randint(-10, 60)) for _ in range(20)
+                ]
+                radii = [rng.randint(0, 15) for _ in centers]
+                batch_surf, single_surf = self._surfaces(depth)
+
+                batch_rect = draw.circles(batch_surf, GREEN, centers, radii, width)
+                single_rects = [
+                    draw.circle(single_surf, GREEN, center, radius, width)
+                    for center, radius in zip(centers, radii)
+                ]
+
+                self._assert_same(batch_surf, single_surf, batch_rect, single_rects)
+
+    def test_circles__single_radius(self):
+        """Ensures circles takes one radius for all circles."""
+        centers = [(10, 10), (30, 25)]
+        batch_surf, single_surf = self._surfaces(32)
+
+        batch_rect = draw.circles(batch_surf, RED, self._int_buffer(centers), 6)
+        single_rects = [draw.circle(single_surf, RED, center, 6) for center in centers]
+
+        self._assert_same(batch_surf, single_surf, batch_rect, single_rects)
+
+    def test_rects__same_as_rect(self):
+        """Ensures rects draws the same pixels and area as rect()."""
+        rng = random.Random(33)
+
+        for depth in (8, 16, 24, 32):
+            for width in (0, 1, 3):
+                rects = [
+                    pygame.Rect(
+                        rng.randint(-10, 60),
+                        rng.randint(-10, 50),
+                        rng.randint(-2, 25),
+                        rng.randint(-2, 25),
+                    )
+                    for _ in range(20)
+                ]
+                batch_surf, single_surf = self._surfaces(depth)
+
+                batch_rect = draw.rects(batch_surf, RED, rects, width)
+                single_rects = [
+                    draw.rect(single_surf, RED, rect, width) for rect in rects
+                ]
+
+                self._assert_same(batch_surf, single_surf, batch_rect, single_rects)
+
+    def test_batch__nothing_drawn(self):
+        """Ensures an empty rect is returned when nothing is drawn."""
+        surface = pygame.Surface(self.SURF_SIZE)
+
+        self.assertEqual(draw.lines_batch(surface, RED, []), pygame.Rect(0, 0, 0, 0))
+        self.assertEqual(draw.circles(surface, RED, [], 3), pygame.Rect(0, 0, 0, 0))
+        self.assertEqual(
+            draw.rects(surface, RED, [(-20, 4, 5, 5)]), pygame.Rect(-20, 4, 0, 0)
+        )
+        self.assertEqual(
+            draw.lines_batch(surface, RED, [(1, 2, 3, 4)], 0), pygame.Rect(1, 2, 0, 0)
+        )
+
+    def test_batch__out_of_range_buffer_values(self):
+        """Ensures buffer values outside the int range are clamped."""
+        surface = pygame.Surface(self.SURF_SIZE, 0, 32)
+        expected = pygame.Surface(self.SURF_SIZE, 0, 32)
+
+        # Wrapping 2**32 + 5 would give 5, which is on the surface.
+        lines = [(2**32 + 5, 5, 2**32 + 9, 5), (5, -(2**32) + 5, 9, -(2**32) + 9)]
+        draw.lines_batch(surface, RED, self._int_buffer(lines[:1], "Q"))
+        draw.lines_batch(surface, RED, self._int_buffer(lines, "q"))
+
+        self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw)
+
+        # Mapped colors are clamped to the Uint32 range instead.
+        white = surface.map_rgb((255, 255, 255, 255))
+        for fmt, values in (("I", [white, 0]), ("q", [2**40, -7]), ("d", [1e20, -1])):
+            colors = memoryview(array.array(fmt, values))
+
+            draw.circles(surface, colors, [(10, 10), (30, 30)], 3)
+
+            self.assertEqual(surface.get_at((10, 10)), (255, 255, 255, 255))
+            self.assertEqual(surface.get_at((30, 30)), (0, 0, 0, 255))
+
+    def test_batch__invalid_args(self):
+        """Ensures invalid batch arguments raise exceptions."""
+        surface = pygame.Surface(self.SURF_SIZE)
+        lines = [(0, 0, 5, 5), (5, 5, 9, 0)]
+
+        with self.assertRaises(TypeError):
+            draw.lines_batch(surface, RED, 5)
+
+        with self.assertRaises(TypeError):
+            draw.lines_batch(surface, RED, [(0, 0, 5, 5), "abc"])
+
+        with self.assertRaises(ValueError):
+            draw.lines_batch(surface, RED, self._int_buffer([(0, 0, 5)]))
+
+        with self.assertRaises(ValueError):
+            draw.lines_batch(surface, [RED], lines)
+
+        with self.assertRaises(ValueError):
+            draw.lines_batch(surface, self._int_buffer([(255, 0, 300)] * 2), lines)
+
+        with self.assertRaises(ValueError):
+            draw.circles(surface, RED, [(1, 1), (4, 4)], [1, 2, 3])
+
+        for colors in (2**70, [RED, 2**70]):
+            with self.assertRaises(OverflowError):
+                draw.lines_batch(surface, colors, lines)
+
+
+class DrawAATest(unittest.TestCase):
+    """Test the coverage antialiased functions aapolygon, aacircle and
+    aastroke.
+    """
+
+    BG = pygame.Color(0, 0, 0)
+
+    def setUp(self):
+        self.surface = pygame.Surface((60, 50), 0, 32)
+        self.surface.fill(self.BG)
+
+    def _is_partial(self, pos, color):
+        """Returns True if pos is a blend of the background and color."""
+        return self.surface.get_at(pos) not in (self.BG, color)
+
+    def test_aapolygon__pixel_aligned(self):
+        """Ensures a polygon on pixel edges covers whole pixels only."""
+        expected = pygame.Surface(self.surface.get_size(), 0, 32)
+        expected.fill(self.BG)
+        expected.fill(RED, (10, 10, 10, 10))
+        points = [(9.5, 9.5), (19.5, 9.5), (19.5, 19.5), (9.5, 19.5)]
+
+        bounding_rect = draw.aapolygon(self.surface, RED, points)
+
+        self.assertEqual(bounding_rect, pygame.Rect(10, 10, 10, 10))
+        self.assertEqual(self.surface.get_buffer().raw, expected.get_buffer().raw)
+
+    def test_aapolygon__antialiased_edge(self):
+        """Ensures a slanted polygon edge is blended."""
+        draw.aapolygon(self.surface, RED, [(5, 5), (40, 20), (5, 40)])
+
+        self.assertEqual(self.surface.get_at((10, 20)), RED)
+        self.assertTrue(any(self._is_partial((x, 10), RED) for x in range(5, 40)))
+        self.assertEqual(self.surface.get_at((45, 20)), self.BG)
+
+    def test_aapolygon__even_odd(self):
+        """Ensures self-intersecting polygons are filled like polygon()."""
+        points = [
+            (
+                30 + 20 * math.sin(math.radians(144 * i)),
+                25 - 20 * math.cos(math.radians(144 * i)),
+            )
+            for i in range(5)
+        ]
+        expected = pygame.Surface(self.surface.get_size(), 0, 32)
+        expected.fill(self.BG)
+        draw.polygon(expected, RED, points)
+
+        draw.aapolygon(self.surface, RED, points)
+
+        # The middle of the star is inside two of its edges, so it is empty.
+        for pos in ((30, 25), (30, 10), (20, 30), (40, 30)):
+            self.assertEqual(self.surface.get_at(pos), expected.get_at(pos), pos)
+
+    def test_aacircle(self):
+        """Ensures a filled circle is solid inside with a blended edge."""
+        bounding_rect = draw.aacircle(self.surface, GREEN, (30, 25), 10.5)
+
+        self.assertEqual(self.surface.get_at((30, 25)), GREEN)
+        self.assertEqual(self.surface.get_at((30, 5)), self.BG)
+        self.assertTrue(
+            any(self._is_partial(pos, GREEN) for pos in [(37, 18), (38, 18)])
+        )
+        self.assertTrue(bounding_rect.contains((20, 15, 21, 21)))
+        self.assertTrue(pygame.Rect(19, 14, 23, 23).contains(bounding_rect))
+
+    def test_aacircle__width(self):
+        """Ensures a circle with a width leaves its middle untouched."""
+        draw.aacircle(self.surface, GREEN, (30, 25), 15, 4)
+
+        self.assertEqual(self.surface.get_at((30, 25)), self.BG)
+        self.assertEqual(self.surface.get_at((30, 12)), GREEN)
+        self.assertEqual(self.surface.get_at((30, 5)), self.BG)
+
+    def test_aacircle__alpha_blends(self):
+        """Ensures the color's alpha blends the circle over the surface."""
+        draw.aacircle(self.surface, (200, 100, 0, 128), (30, 25), 10)
+
+        color = self.surface.get_at((30, 25))
+
+        for value, expected in zip(color[:3], (100, 50, 0)):
+            self.assertAlmostEqual(value, expected, delta=1)
+
+    def test_aastroke(self):
+        """Ensures aastroke draws a line of the given width with round ends."""
+        bounding_rect = draw.aastroke(self.surface, BLUE, False, [(5, 10), (30, 10)], 3)
+
+        for y in (9, 10, 11):
+            self.assertEqual(self.surface.get_at((17, y)), BLUE)
+        for y in (8, 12):
+            self.assertEqual(self.surface.get_at((17, y)), self.BG)
+        self.assertEqual(bounding_rect, pygame.Rect(4, 9, 28, 3))
+
+    def test_aastroke__closed(self):
+        """Ensures a closed stroke joins its last point to its first."""
+        points = [(10, 10), (40, 10), (40, 40)]
+
+        draw.aastroke(self.surface, BLUE, False, points, 2)
+        self.assertEqual(self.surface.get_at((25, 25)), self.BG)
+
+        draw.aastroke(self.surface, BLUE, True, points, 2)
+        self.assertEqual(self.surface.get_at((25, 25)), BLUE)
+
+    def test_aa__nothing_drawn(self):
+        """Ensures an empty rect is returned when nothing is drawn."""
+        surface = self.surface
+        expected = surface.copy()
+
+        for bounding_rect in (
+            draw.aapolygon(surface, RED, [(3, 4), (9, 4), (9, 9)], -1),
+            draw.aacircle(surface, RED, (3, 4), 0),
+            draw.aacircle(surface, RED, (3, 4), 5, -1),
+            draw.aastroke(surface, RED, False, [(3, 4), (9, 9)], 0),
+            draw.aapolygon(surface, RED, [(-30, -40), (-9, -4), (-9, -9)]),
+        ):
+            self.assertEqual(bounding_rect.size, (0, 0))
+        self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw)
+
+    def test_aa__invalid_args(self):
+        """Ensures invalid arguments raise exceptions."""
+        surface = self.surface
+
+        with self.assertRaises(ValueError):
+            draw.aapolygon(surface, RED, [(0, 0), (5, 5)])
+
+        with self.assertRaises(ValueError):
+            draw.aastroke(surface, RED, False, [(0, 0)])
+
+        with self.assertRaises(ValueError):
+            draw.aapolygon(surface, RED, [(0, 0), (5, 5), (float("nan"), 0)])
+
+        with self.assertRaises(ValueError):
+            draw.aacircle(surface, RED, (0, 0), float("inf"))
+
+        with self.assertRaises(TypeError):
+            draw.aapolygon(surface, RED, [(0, 0), (5, 5), "ab"])
+
+        with self.assertRaises(TypeError):
+            draw.aacircle(surface, RED, (0, 0, 0), 5)
+
+        with self.assertRaises(TypeError):
+            draw.aastroke(surface, object(), False, [(0, 0), (5, 5)])
+
+
+class DrawPathTest(unittest.TestCase):
+    """Test the Path object, which keeps the pixels it covers for drawing the
+    same outlines again.
+    """
+
+    BG = pygame.Color(0, 0, 0)
+    POINTS = [(5, 5), (40, 20), (5, 40)]
+
+    def setUp(self):
+        self.surface = pygame.Surface((60, 50), 0, 32)
+        self.surface.fill(self.BG)
+
+    def _new_surface(self):
+        surface = pygame.Surface(self.surface.get_size(), 0, 32)
+        surface.fill(self.BG)
+        return surface
+
+    def _assert_same_pixels(self, surface, expected):
+        self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw)
+
+    def test_draw__same_as_aapolygon(self):
+        """Ensures a filled path draws the same as aapolygon."""
+        expected = self._new_surface()
+        path = draw.Path()
+        path.add_polygon(self.POINTS)
+
+        bounding_rect = path.draw(self.surface, RED)
+        expected_rect = draw.aapolygon(expected, RED, self.POINTS)
+
+        self.assertEqual(bounding_rect, expected_rect)
+        self._assert_same_pixels(self.surface, expected)
+
+    def test_draw__reused_at_other_positions(self):
+        """Ensures drawing again at another position moves the path."""
+        path = draw.Path()
+        path.add_polygon(self.POINTS)
+        path.draw(self._new_surface(), RED)
+
+        for pos in ((7, 3), (-4, 2), (7.25, 3.5)):
+            surface = self._new_surface()
+            expected = self._new_surface()
+            moved = [(x + pos[0], y + pos[1]) for x, y in self.POINTS]
+
+            bounding_rect = path.draw(surface, RED, pos)
+            expected_rect = draw.aapolygon(expected, RED, moved)
+
+            self.assertEqual(bounding_rect, expected_rect)
+            self._assert_same_pixels(surface, expected)
+
+    def test_draw__width(self):
+        """Ensures a path with a width draws the same as aastroke."""
+        expected = self._new_surface()
+        path = draw.Path()
+        path.move_to(self.POINTS[0])
+        for point in self.POINTS[1:]:
+            path.line_to(point)
+
+        bounding_rect = path.draw(self.surface, BLUE, width=2)
+        expected_rect = draw.aastroke(expected, BLUE, False, self.POINTS, 2)
+
+        self.assertEqual(bounding_rect, expected_rect)
+        self._assert_same_pixels(self.surface, expected)
+
+        path.close()
+        path.draw(self.surface, BLUE, width=2)
+        draw.aastroke(expected, BLUE, True, self.POINTS, 2)
+
+        self._assert_same_pixels(self.surface, expected)
+
+    def test_draw__after_change(self):
+        """Ensures changing a path after drawing it changes what is drawn."""
+        path = draw.Path()
+        path.add_rect((5, 6, 10, 12))
+        self.assertEqual(path.draw(self.surface, RED), pygame.Rect(5, 6, 10, 12))
+
+        path.add_circle((40, 30), 5)
+        self.assertEqual(path.draw(self.surface, RED), pygame.Rect(5, 6, 41, 30))
+
+        path.clear()
+        self.assertEqual(path.draw(self.surface, RED, (3, 4)), pygame.Rect(3, 4, 0, 0))
+
+    def test_add_rect(self):
+        """Ensures a filled rect covers exactly its pixels."""
+        expected = self._new_surface()
+        expected.fill(GREEN, (5, 6, 10, 12))
+        path = draw.Path()
+        path.add_rect(pygame.Rect(5, 6, 10, 12))
+
+        path.draw(self.surface, GREEN)
+
+        self._assert_same_pixels(self.surface, expected)
+
+    def test_add_rect__border_radius(self):
+        """Ensures a rect with a border radius has rounded corners."""
+        path = draw.Path()
+        path.add_rect((10, 10, 30, 20), border_radius=6)
+
+        bounding_rect = path.draw(self.surface, GREEN)
+
+        self.assertEqual(bounding_rect, pygame.Rect(10, 10, 30, 20))
+        self.assertEqual(self.surface.get_at((10, 10)), self.BG)
+        self.assertEqual(self.surface.get_at((25, 10)), GREEN)
+        self.assertEqual(self.surface.get_at((10, 20)), GREEN)
+
+    def test_curves(self):
+        """Ensures curves stay within the hull of their control points."""
+        path = draw.Path()
+        path.move_to((5, 25))
+        path.quad_to((25, 5), (45, 25))
+        path.cubic_to((35, 45), (15, 45), (5, 25))
+
+        bounding_rect = path.draw(self.surface, RED)
+
+        self.assertTrue(pygame.Rect(5, 5, 41, 41).contains(bounding_rect))
+        self.assertEqual(bounding_rect.top, 15)
+        self.assertEqual(self.surface.get_at((25, 25)), RED)
+
+    def test_arc(self):
+        """Ensures an arc goes counterclockwise from start_angle."""
+        path = draw.Path()
+        path.arc((30, 30), 20, 0, math.pi)
+        path.close()
+
+        bounding_rect = path.draw(self.surface, RED)
+
+        self.assertEqual(self.surface.get_at((30, 20)), RED)
+        self.assertEqual(self.surface.get_at((30, 40)), self.BG)
+        self.assertEqual(bounding_rect.bottom, 31)
+
+    def test_draw__nothing_drawn(self):
+        """Ensures an empty rect is returned when nothing is drawn."""
+        path = draw.Path()
+        path.move_to((10, 10))
+        path.line_to((20, 10))
+
+        self.assertEqual(path.draw(self.surface, RED), pygame.Rect(0, 0, 0, 0))
+
+        path.add_polygon(self.POINTS)
+
+        for bounding_rect in (
+            path.draw(self.surface, RED, (2, 3), -1),
+            path.draw(self.surface, RED, (-100, 3)),
+        ):
+            self.assertEqual(bounding_rect.size, (0, 0))
+        self._assert_same_pixels(self.surface, self._new_surface())
+
+    def test_draw__huge_path(self):
+        """Ensures a path much larger than the surface only works out the
+        pixels in the clip area, drawing them in bounded time."""
+        radius = 1000000
+        fill = draw.Path()
+        fill.add_circle((30, 25), radius)
+        stroke = draw.Path()
+        stroke.add_circle((30, 25 + radius), radius)
+        expected = self._new_surface()
+        expected.fill(RED)
+        start = time.perf_counter()
+
+        for pos in ((0, 0), (3, -2)):
+            self.surface.fill(self.BG)
+            bounding_rect = fill.draw(self.surface, RED, pos)
+
+            self.assertEqual(bounding_rect, self.surface.get_rect())
+            self._assert_same_pixels(self.surface, expected)
+
+        self.surface.fill(self.BG)
+        self.surface.set_clip((20, 20, 20, 10))
+        bounding_rect = stroke.draw(self.surface, RED, width=3)
+
+        self.assertEqual(self.surface.get_at((30, 25)), RED)
+        self.assertEqual(self.surface.get_at((30, 20)), self.BG)
+        self.assertTrue(self.surface.get_clip().contains(bounding_rect))
+        self.assertLess(time.perf_counter() - start, 10)
+
+    def test_invalid_args(self):
+        """Ensures invalid arguments raise exceptions."""
+        path = draw.Path()
+
+        with self.assertRaises(ValueError):
+            path.add_polygon([(0, 0), (5, 5)])
+
+        with self.assertRaises(ValueError):
+            path.line_to((float("nan"), 0))
+
+        with self.assertRaises(ValueError):
+            path.arc((0, 0), -1, 0, 1)
+
+        with self.assertRaises(TypeError):
+            path.move_to((0, 0, 0))
+
+        with self.assertRaises(TypeError):
+            path.add_rect(object())
+
+        with self.assertRaises(TypeError):
+            path.draw(self.surface, object())
+
+        with self.assertRaises(ValueError):
+            path.draw(self.surface, RED, (0, float("inf")))
+
+
+class DrawLargeFilledShapesTest(unittest.TestCase):
+    """Test filling shapes large enough to be drawn in parallel bands of
+    rows.
+
+    Each shape is compared with the same shape drawn through a grid of
+    small clip areas, which is too small to be split into bands.
+    """
+
+    SURF_SIZE = (1000, 800)
+    TILE = 200
+
+    def _assert_same_as_tiled(self, draw_func):
+        surface = pygame.Surface(self.SURF_SIZE, 0, 32)
+        tiled = pygame.Surface(self.SURF_SIZE, 0, 32)
+        surface.fill((10, 20, 30))
+        tiled.fill((10, 20, 30))
+
+        bounding_rect = draw_func(surface)
+
+        tile_rects = []
+        for x in range(0, self.SURF_SIZE[0], self.TILE):
+            for y in range(0, self.SURF_SIZE[1], self.TILE):
+                tiled.set_clip((x, y, self.TILE, self.TILE))
+                tile_rect = draw_func(tiled)
+                if tile_rect.size != (0, 0):
+                    tile_rects.append(tile_rect)
+
+        self.assertEqual(surface.get_buffer().raw, tiled.get_buffer().raw)
+        self.assertEqual(bounding_rect, tile_rects[0].unionall(tile_rects[1:]))
+
+    def test_polygon(self):
+        """Ensures a large polygon is filled the same in parallel."""
+        points = []
+        for i in range(200):
+            radius = 480 if i % 2 else 250
+            angle = math.pi * i / 100
+            points.append(
+                (500 + radius * math.cos(angle), 390 + radius * math.sin(angle))
+            )
+
+        self._assert_same_as_tiled(lambda surf: draw.polygon(surf, RED, points))
+
+    def test_circle(self):
+        """Ensures a large circle is filled the same in parallel."""
+        self._assert_same_as_tiled(
+            lambda surf: draw.circle(surf, GREEN, (480, 410), 430)
+        )
+
+    def test_ellipse(self):
+        """Ensures a large ellipse is filled the same in parallel."""
+        self._assert_same_as_tiled(
+            lambda surf: draw.ellipse(surf, BLUE, (-30, 15, 1043, 770))
+        )
+
+
+class DrawFloodFillTest(unittest.TestCase):
+    """Test flood_fill, which fills the area of about the same color around
+    a position.
+    """
+
+    BG = pygame.Color(0, 0, 0)
+
+    def _outlined_surface(self, depth=32):
+        """A surface with a white square outline, 10 to 29 across."""
+        surface = pygame.Surface((40, 40), 0, depth)
+        surface.fill(self.BG)
+        draw.rect(surface, WHITE, (10, 10, 20, 20), 1)
+        return surface
+
+    def test_flood_fill__inside_outline(self):
+        """Ensures only the pixels inside an outline are filled, for every
+        bit depth."""
+        for depth in (8, 16, 24, 32):
+            surface = self._outlined_surface(depth)
+            expected = self._outlined_surface(depth)
+            expected.fill(RED, (11, 11, 18, 18))
+
+            bounding_rect = draw.flood_fill(surface, RED, (20, 15))
+
+            self.assertEqual(bounding_rect, pygame.Rect(11, 11, 18, 18))
+            self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw, depth)
+
+    def test_flood_fill__outside_outline(self):
+        """Ensures the area around an outline does not leak into it."""
+        surface = self._outlined_surface()
+
+        bounding_rect = draw.flood_fill(surface, GREEN, (0, 0))
+
+        self.assertEqual(bounding_rect, surface.get_rect())
+        self.assertEqual(surface.get_at((39, 39)), GREEN)
+        self.assertEqual(surface.get_at((10, 10)), WHITE)
+        self.assertEqual(surface.get_at((20, 20)), self.BG)
+
+    def test_flood_fill__tolerance(self):
+        """Ensures pixels close enough to the color at pos are filled."""
+        surface = pygame.Surface((30, 1), 0, 32)
+        for x in range(30):
+            surface.set_at((x, 0), (x * 4, 0, 0))
+
+        bounding_rect = draw.flood_fill(surface, BLUE, (10, 0), 8)
+
+        self.assertEqual(bounding_rect, pygame.Rect(8, 0, 5, 1))
+        self.assertEqual(surface.get_at((7, 0)), (28, 0, 0))
+        self.assertEqual(surface.get_at((13, 0)), (52, 0, 0))
+
+        surface.fill((1, 2, 3))
+        surface.set_at((5, 0), (255, 255, 255))
+        draw.flood_fill(surface, BLUE, (0, 0), 255)
+        self.assertEqual(surface.get_at((5, 0)), BLUE)
+
+    def test_flood_fill__same_color(self):
+        """Ensures filling with the color already there ends."""
+        surface = self._outlined_surface()
+
+        bounding_rect = draw.flood_fill(surface, self.BG, (20, 20), 5)
+
+        self.assertEqual(bounding_rect, pygame.Rect(11, 11, 18, 18))
+        self.assertEqual(surface.get_at((20, 20)), self.BG)
+
+    def test_flood_fill__mask(self):
+        """Ensures the filled area is set in a mask, without changing the
+        surface when color is None."""
+        surface = self._outlined_surface()
+        before = surface.get_buffer().raw
+        mask = pygame.mask.Mask(surface.get_size())
+        mask.set_at((0, 0))
+
+        bounding_rect = draw.flood_fill(surface, None, (15, 15), mask=mask)
+
+        self.assertEqual(surface.get_buffer().raw, before)
+        self.assertEqual(bounding_rect, pygame.Rect(11, 11, 18, 18))
+        self.assertEqual(mask.count(), 18 * 18 + 1)
+        self.assertEqual(mask.get_bounding_rects()[-1], bounding_rect)
+
+    def test_flood_fill__surface_clip(self):
+        """Ensures only the pixels within the clip area are filled."""
+        surface = self._outlined_surface()
+        surface.set_clip((15, 15, 5, 30))
+
+        bounding_rect = draw.flood_fill(surface, RED, (16, 16))
+
+        self.assertEqual(bounding_rect, pygame.Rect(15, 15, 5, 14))
+        self.assertEqual(surface.get_at((14, 16)), self.BG)
+        self.assertEqual(surface.get_at((19, 28)), RED)
+
+        bounding_rect = draw.flood_fill(surface, RED, (0, 0))
+        self.assertEqual(bounding_rect, pygame.Rect(0, 0, 0, 0))
+        self.assertEqual(surface.get_at((0, 0)), self.BG)
+
+    def test_flood_fill__invalid_args(self):
+        """Ensures invalid arguments raise exceptions."""
+        surface = self._outlined_surface()
+
+        with self.assertRaises(ValueError):
+            draw.flood_fill(surface, RED, (0, 0), -1)
+
+        with self.assertRaises(ValueError):
+            draw.flood_fill(surface, RED, (0, 0), 256)
+
+        with self.assertRaises(ValueError):
+            draw.flood_fill(surface, RED, (0, 0), mask=pygame.mask.Mask((4, 4)))
+
+        with self.assertRaises(TypeError):
+            draw.flood_fill(surface, RED, (0, 0), mask=surface)
+
+        with self.assertRaises(TypeError):
+            draw.flood_fill(surface, RED, (0, 0, 0))
+
+        with self.assertRaises(TypeError):
+            draw.flood_fill(surface, object(), (0, 0))
+
+
+class DrawRenderQueueTest(unittest.TestCase):
+    """Test RenderQueue, which records drawing and runs it in tiles."""
+
+    SURF_SIZE = (700, 500)
+
+    def _draw_all(self, target):
+        """Draws the same shapes on a Surface, with the draw functions, or
+        records them in a RenderQueue."""
+        points = [(30, 20), (650, 90), (400, 480), (120, 300)]
+        if isinstance(target, draw.RenderQueue):
+            target.fill((10, 20, 30))
+            target.rect(RED, (40, 50, 300, 200))
+            target.rect(GREEN, (200, 150, 400, 250), 7)
+            target.line(BLUE, (-10, 490), (690, 5), 5)
+            target.lines(WHITE, True, points, 3)
+            target.circle("yellow", (350, 250), 180, 12)
+            target.polygon("magenta", points[1:])
+        else:
+            target.fill((10, 20, 30))
+            draw.rect(target, RED, (40, 50, 300, 200))
+            draw.rect(target, GREEN, (200, 150, 400, 250), 7)
+            draw.line(target, BLUE, (-10, 490), (690, 5), 5)
+            draw.lines(target, WHITE, True, points, 3)
+            draw.circle(target, "yellow", (350, 250), 180, 12)
+            draw.polygon(target, "magenta", points[1:])
+
+    def test_execute__same_as_drawing(self):
+        """Ensures a queue draws the same pixels as the draw functions, in
+        the order they were recorded."""
+        queue = draw.RenderQueue()
+        self._draw_all(queue)
+
+        for depth in (8, 16, 24, 32):
+            surface = pygame.Surface(self.SURF_SIZE, 0, depth)
+            drawn = pygame.Surface(self.SURF_SIZE, 0, depth)
+            self._draw_all(drawn)
+
+            bounding_rect = queue.execute(surface)
+
+            self.assertEqual(bounding_rect, surface.get_rect())
+            self.assertEqual(surface.get_buffer().raw, drawn.get_buffer().raw, depth)
+        self.assertEqual(len(queue), 7)
+
+    def test_execute__thin_shapes_across_tiles(self):
+        """Ensures lines and thin circles crossing many tiles, or starting
+        outside of the clip area, draw the same pixels as the draw
+        functions."""
+        lines = [
+            ((-50, -30), (690, 470), 1),
+            ((650, -200), (10, 900), 1),
+            ((-900, 250), (1500, 260), 4),
+            ((300, 700), (320, -40), 9),
+        ]
+        circles = [((350, 250), 230), ((-10, 480), 300), ((600, 20), 2)]
+        points = [point for line in lines for point in line[:2]]
+
+        for clip in (None, (37, 51, 400, 300)):
+            surface = pygame.Surface(self.SURF_SIZE, 0, 32)
+            expected = pygame.Surface(self.SURF_SIZE, 0, 32)
+            surface.set_clip(clip)
+            expected.set_clip(clip)
+            queue = draw.RenderQueue()
+
+            for start, end, width in lines:
+                queue.line(RED, start, end, width)
+                draw.line(expected, RED, start, end, width)
+            for center, radius in circles:
+                queue.circle(WHITE, center, radius, 1)
+                draw.circle(expected, WHITE, center, radius, 1)
+            queue.lines(GREEN, True, points, 2)
+            draw.lines(expected, GREEN, True, points, 2)
+            queue.execute(surface)
+
+            self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw)
+
+    def test_execute__surface_clip(self):
+        """Ensures only the clip area is drawn, and the drawn area is
+        returned."""
+        surface = pygame.Surface((100, 100), 0, 32)
+        expected = pygame.Surface((100, 100), 0, 32)
+        surface.set_clip((10, 20, 30, 40))
+        expected.set_clip((10, 20, 30, 40))
+        queue = draw.RenderQueue()
+        queue.circle(RED, (50, 50), 25)
+
+        bounding_rect = queue.execute(surface)
+
+        self.assertEqual(bounding_rect, draw.circle(expected, RED, (50, 50), 25))
+        self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw)
+
+        surface.set_clip((80, 0, 20, 20))
+        bounding_rect = queue.execute(surface)
+        self.assertEqual(bounding_rect, pygame.Rect(80, 0, 0, 0))
+
+    def test_blit(self):
+        """Ensures blits are drawn in order with the shapes."""
+        image = pygame.Surface((300, 200), 0, 32)
+        image.fill(GREEN)
+        image.fill(BLUE, (0, 0, 150, 100))
+        surface = pygame.Surface(self.SURF_SIZE, 0, 32)
+        expected = pygame.Surface(self.SURF_SIZE, 0, 32)
+        queue = draw.RenderQueue()
+
+        queue.rect(RED, (0, 0, 100, 100))
+        queue.blit(image, (50, 60))
+        queue.blit(image, pygame.Rect(400, 300, 1, 1), (100, 50, 200, 150))
+        queue.circle(WHITE, (60, 70), 5)
+        bounding_rect = queue.execute(surface)
+
+        draw.rect(expected, RED, (0, 0, 100, 100))
+        expected.blit(image, (50, 60))
+        expected.blit(image, (400, 300), (100, 50, 200, 150))
+        draw.circle(expected, WHITE, (60, 70), 5)
+
+        self.assertEqual(bounding_rect, pygame.Rect(0, 0, 600, 450))
+        self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw)
+
+    def test_path(self):
+        """Ensures a path is drawn as Path.draw draws it, as it was when
+        recorded."""
+        path = draw.Path()
+        path.add_circle((20, 20), 15)
+        surface = pygame.Surface((80, 80), 0, 32)
+        expected = pygame.Surface((80, 80), 0, 32)
+        queue = draw.RenderQueue()
+
+        queue.path(path, RED, (10.5, 20))
+        path.clear()
+        queue.execute(surface)
+
+        path.add_circle((20, 20), 15)
+        path.draw(expected, RED, (10.5, 20))
+        self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw)
+
+    def test_path__huge(self):
+        """Ensures a path much larger than the surface is only rasterized
+        within the clip area, in bounded time."""
+        path = draw.Path()
+        path.add_circle((0, 0), 1000000)
+        surface = pygame.Surface((80, 80), 0, 32)
+        expected = pygame.Surface((80, 80), 0, 32)
+        surface.set_clip((10, 20, 30, 40))
+        expected.fill(RED, (10, 20, 30, 40))
+        queue = draw.RenderQueue()
+        queue.path(path, RED)
+        start = time.perf_counter()
+
+        bounding_rect = queue.execute(surface)
+
+        self.assertEqual(bounding_rect, pygame.Rect(10, 20, 30, 40))
+        self.assertEqual(surface.get_buffer().raw, expected.get_buffer().raw)
+
+        surface.set_clip(None)
+        queue.execute(surface)
+
+        self.assertEqual(surface.get_at((79, 79)), RED)
+        self.assertLess(time.perf_counter() - start, 10)
+
+    def test_clear(self):
+        """Ensures clear removes the recorded commands."""
+        surface = pygame.Surface((10, 10), 0, 32)
+        queue = draw.RenderQueue()
+        queue.fill(RED)
+        queue.line(GREEN, (0, 0), (9, 9))
+        self.assertEqual(len(queue), 2)
+
+        queue.clear()
+
+        self.assertEqual(len(queue), 0)
+        self.assertEqual(queue.execute(surface), pygame.Rect(0, 0, 0, 0))
+        self.assertEqual(surface.get_at((0, 0)), (0, 0, 0))
+
+    def test_invalid_args(self):
+        """Ensures invalid arguments raise exceptions."""
+        surface = pygame.Surface((10, 10), 0, 32)
+        queue = draw.RenderQueue()
+
+        with self.assertRaises(ValueError):
+            queue.lines(RED, False, [(0, 0)])
+
+        with self.assertRaises(ValueError):
+            queue.polygon(RED, [(0, 0), (1, 1)])
+
+        with self.assertRaises(ValueError):
+            queue.blit(surface, (0, 0), special_flags=pygame.BLEND_ALPHA_SDL2)
+
+        with self.assertRaises(TypeError):
+            queue.rect(RED, (0, 0))
+
+        with self.assertRaises(TypeError):
+            queue.circle(object(), (0, 0), 3)
+
+        with self.assertRaises(OverflowError):
+            queue.fill(2**64)
+
+        with self.assertRaises(TypeError):
+            queue.execute(queue)
+
+        self.assertEqual(len(queue), 0)
+
+        queue.blit(surface.subsurface((0, 0, 5, 5)), (5, 5))
+        with self.assertRaises(ValueError):
+            queue.execute(surface)
+
+
 ### Draw Module Testing #######################################################
 
 
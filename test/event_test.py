@@ -1,4 +1,6 @@
 import collections
+import struct
+import threading
 import time
 import unittest
 
@@ -443,6 +445,180 @@ class EventModuleTest(unittest.TestCase):
         self.assertTrue(pygame.event.post(pygame.event.Event(pygame.USEREVENT)))
         self.assertEqual(pygame.event.poll(), pygame.event.Event(pygame.USEREVENT))
 
+    def test_post_payload(self):
+        """Ensure payload events keep their bytes, and their order."""
+        pygame.event.post(pygame.event.Event(pygame.USEREVENT, order=1))
+        self.assertTrue(pygame.event.post_payload(pygame.USEREVENT, b"\x00two"))
+        self.assertTrue(pygame.event.post_payload(pygame.USEREVENT, bytearray(40)))
+        self.assertTrue(pygame.event.post_payload(pygame.KEYDOWN))
+        pygame.event.post(pygame.event.Event(pygame.USEREVENT, order=5))
+
+        queue = pygame.event.get()
+
+        self.assertEqual(len(queue), 5)
+        self.assertEqual(queue[0].order, 1)
+        self.assertEqual(
+            queue[1], pygame.event.Event(pygame.USEREVENT, payload=b"\x00two")
+        )
+        self.assertEqual(queue[2].payload, bytes(40))
+        self.assertEqual(queue[3], pygame.event.Event(pygame.KEYDOWN, payload=b""))
+        self.assertEqual(queue[4].order, 5)
+
+    def test_post_payload__blocked(self):
+        """Ensure blocked payload events are not posted."""
+        pygame.event.set_blocked(pygame.USEREVENT)
+        self.assertFalse(pygame.event.post_payload(pygame.USEREVENT, b"x"))
+        self.assertFalse(pygame.event.poll())
+        pygame.event.set_allowed(pygame.USEREVENT)
+
+        # blocked after posting, before the queue is pumped
+        self.assertTrue(pygame.event.post_payload(pygame.USEREVENT, b"x"))
+        pygame.event.set_blocked(pygame.USEREVENT)
+        self.assertFalse(pygame.event.poll())
+        pygame.event.set_allowed(pygame.USEREVENT)
+
+    def test_post_payload__quit(self):
+        """Ensure payload events posted before quitting are dropped."""
+        for _ in range(3):
+            self.assertTrue(pygame.event.post_payload(pygame.USEREVENT, b"x"))
+        pygame.display.quit()
+        pygame.display.init()
+
+        self.assertEqual(pygame.event.get(pygame.USEREVENT), [])
+
+    def test_post_payload__invalid(self):
+        """Ensure bad payloads and event types raise errors."""
+        self.assertRaises(ValueError, pygame.event.post_payload, 0, bytes(41))
+        self.assertRaises(ValueError, pygame.event.post_payload, -1)
+        self.assertRaises(ValueError, pygame.event.post_payload, pygame.NUMEVENTS)
+        self.assertRaises(TypeError, pygame.event.post_payload, pygame.USEREVENT, "x")
+
+    def test_post_payload__threads(self):
+        """Ensure events posted from many threads all arrive in order."""
+        thread_count = 4
+        event_count = 500
+
+        def post(thread_id):
+            for i in range(event_count):
+                payload = bytes([thread_id]) + str(i).encode()
+                pygame.event.post_payload(pygame.USEREVENT, payload)
+
+        threads = [
+            threading.Thread(target=post, args=(i,)) for i in range(thread_count)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        posted = collections.defaultdict(list)
+        for e in pygame.event.get(pygame.USEREVENT):
+            posted[e.payload[0]].append(int(e.payload[1:]))
+
+        for i in range(thread_count):
+            self.assertEqual(posted[i], list(range(event_count)))
+
+    def test_set_rate_limit(self):
+        """Ensure only the newest events within the rate limit are kept."""
+        dropped = pygame.event.get_filter_stats()[1]
+        pygame.event.set_rate_limit(pygame.USEREVENT, 0.5)
+        try:
+            posted = [pygame.event.post(pygame.event.Event(pygame.USEREVENT))]
+            posted.append(pygame.event.post(pygame.event.Event(pygame.USEREVENT)))
+            pygame.event.post_payload(pygame.USEREVENT, b"last")
+            posted.append(pygame.event.post(pygame.event.Event(pygame.USEREVENT + 1)))
+
+            self.assertEqual(posted, [True, True, True])
+            self.assertEqual(
+                pygame.event.get(),
+                [
+                    pygame.event.Event(pygame.USEREVENT, payload=b"last"),
+                    pygame.event.Event(pygame.USEREVENT + 1),
+                ],
+            )
+            self.assertEqual(pygame.event.get_filter_stats()[1], dropped + 2)
+
+            # too soon after the one kept by the last pump
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+            self.assertEqual(pygame.event.get(), [])
+        finally:
+            pygame.event.set_rate_limit(pygame.USEREVENT)
+
+        self.assertTrue(pygame.event.post(pygame.event.Event(pygame.USEREVENT)))
+        self.assertEqual(len(pygame.event.get()), 1)
+
+    def test_set_rate_limit__kept_event_queued(self):
+        """Ensure newer events replace the kept one while it is queued."""
+        pygame.event.set_rate_limit(pygame.USEREVENT, 0.5)
+        try:
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT, order=1))
+            self.assertEqual(pygame.event.get(pygame.USEREVENT + 1), [])
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT, order=2))
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT + 1))
+
+            self.assertEqual(
+                [(e.type, getattr(e, "order", None)) for e in pygame.event.get()],
+                [(pygame.USEREVENT, 2), (pygame.USEREVENT + 1, None)],
+            )
+        finally:
+            pygame.event.set_rate_limit(pygame.USEREVENT)
+
+    def test_set_rate_limit__tiny_rate(self):
+        """Ensure a rate too small for the timestamps keeps one event."""
+        pygame.event.set_rate_limit(pygame.USEREVENT, 1e-300)
+        try:
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT, order=1))
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT, order=2))
+            self.assertEqual([e.order for e in pygame.event.get()], [2])
+        finally:
+            pygame.event.set_rate_limit(pygame.USEREVENT)
+
+    def test_set_rate_limit__invalid(self):
+        """Ensure bad rates and event types raise errors."""
+        self.assertRaises(ValueError, pygame.event.set_rate_limit, pygame.KEYDOWN, -1)
+        self.assertRaises(ValueError, pygame.event.set_rate_limit, -1, 10)
+        self.assertRaises(TypeError, pygame.event.set_rate_limit, "x", 10)
+
+        # nothing is limited when one of the types is bad
+        self.assertRaises(
+            ValueError, pygame.event.set_rate_limit, [pygame.USEREVENT, -1], 0.5
+        )
+        for _ in range(2):
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+        self.assertEqual(len(pygame.event.get()), 2)
+
+    def test_set_coalesce(self):
+        """Ensure posted motion events are not merged."""
+        merged = pygame.event.get_filter_stats()[0]
+        pygame.event.set_coalesce([pygame.MOUSEMOTION, pygame.FINGERMOTION])
+        try:
+            for i in range(3):
+                pygame.event.post(pygame.event.Event(pygame.MOUSEMOTION, rel=(i, i)))
+
+            self.assertEqual(len(pygame.event.get()), 3)
+            self.assertEqual(pygame.event.get_filter_stats()[0], merged)
+        finally:
+            pygame.event.set_coalesce([pygame.MOUSEMOTION, pygame.FINGERMOTION], False)
+
+    def test_set_coalesce__invalid(self):
+        """Ensure only motion events can be coalesced."""
+        self.assertRaises(ValueError, pygame.event.set_coalesce, pygame.KEYDOWN)
+        self.assertRaises(ValueError, pygame.event.set_coalesce, pygame.NUMEVENTS)
+        self.assertRaises(
+            ValueError, pygame.event.set_coalesce, [pygame.MOUSEMOTION, pygame.KEYDOWN]
+        )
+        pygame.event.set_coalesce(
+            (pygame.JOYAXISMOTION, pygame.CONTROLLERAXISMOTION), coalesce=False
+        )
+
+    def test_get_filter_stats(self):
+        """Ensure the filter counters are a pair of ints."""
+        stats = pygame.event.get_filter_stats()
+
+        self.assertIsInstance(stats, tuple)
+        self.assertEqual(len(stats), 2)
+        self.assertTrue(all(isinstance(count, int) for count in stats))
+
     def test_get(self):
         """Ensure get() retrieves all the events on the queue."""
         event_cnt = 10
@@ -454,6 +630,45 @@ class EventModuleTest(unittest.TestCase):
         self.assertEqual(len(queue), event_cnt)
         self.assertTrue(all(e.type == pygame.USEREVENT for e in queue))
 
+    def test_get_into(self):
+        """Ensure get_into() writes the events on the queue as records."""
+        pygame.event.post_payload(pygame.USEREVENT, b"0123456789abcdefghij")
+        pygame.event.post_payload(pygame.USEREVENT + 1)
+        pygame.event.post(pygame.event.Event(pygame.KEYDOWN, key=pygame.K_a))
+        buffer = bytearray(32 * 4)
+
+        count = pygame.event.get_into(buffer)
+
+        self.assertEqual(count, 3)
+        records = [struct.unpack_from("IIIi16s", buffer, 32 * i) for i in range(3)]
+        self.assertEqual(records[0][0], pygame.USEREVENT)
+        self.assertEqual(records[0][2:], (0, 20, b"0123456789abcdef"))
+        self.assertEqual(records[1][0], pygame.USEREVENT + 1)
+        self.assertEqual(records[1][2:], (0, 0, bytes(16)))
+        self.assertEqual(records[2][0], pygame.KEYDOWN)
+        self.assertEqual(records[2][2:], (0, 0, bytes(16)))
+        self.assertFalse(pygame.event.peek())
+
+    def test_get_into__full_buffer(self):
+        """Ensure the events that do not fit in the buffer stay queued."""
+        for i in range(5):
+            pygame.event.post_payload(pygame.USEREVENT, bytes([i]))
+        buffer = bytearray(32 * 2 + 16)
+
+        self.assertEqual(pygame.event.get_into(buffer, coalesce=True), 2)
+        self.assertEqual(buffer[16], 0)
+        self.assertEqual(buffer[48], 1)
+        self.assertEqual(
+            [e.payload for e in pygame.event.get()], [b"\x02", b"\x03", b"\x04"]
+        )
+        self.assertEqual(pygame.event.get_into(buffer), 0)
+
+    def test_get_into__invalid_buffer(self):
+        """Ensure get_into() needs a writable buffer for a record."""
+        self.assertRaises(BufferError, pygame.event.get_into, bytes(32))
+        self.assertRaises(TypeError, pygame.event.get_into, None)
+        self.assertRaises(ValueError, pygame.event.get_into, bytearray(31))
+
     def test_get_type(self):
         ev = pygame.event.Event(pygame.USEREVENT)
         pygame.event.post(ev)
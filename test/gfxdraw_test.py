@@ -152,6 +152,26 @@ class GfxdrawDefaultTest(unittest.TestCase):
                     else:
                         self.check_at(surf, (x, y), bg_adjusted)
 
+    def test_pixels(self):
+        """pixels(surface, points, color): return None"""
+        fg = self.foreground_color
+        bg = self.background_color
+        points = [(2, 2), (5, 7), (-1, 3), (4, 1000), [9, 9]]
+        for surf in self.surfaces:
+            fg_adjusted = surf.unmap_rgb(surf.map_rgb(fg))
+            bg_adjusted = surf.unmap_rgb(surf.map_rgb(bg))
+            pygame.gfxdraw.pixels(surf, points, fg)
+            pygame.gfxdraw.pixels(surf, [], fg)
+            for posn in [(2, 2), (5, 7), (9, 9)]:
+                self.check_at(surf, posn, fg_adjusted)
+            for posn in [(2, 3), (0, 3), (4, 7), (9, 8)]:
+                self.check_at(surf, posn, bg_adjusted)
+
+        surf = self.surfaces[0]
+        self.assertRaises(TypeError, pygame.gfxdraw.pixels, surf, 5, fg)
+        self.assertRaises(TypeError, pygame.gfxdraw.pixels, surf, [(1,)], fg)
+        self.assertRaises(TypeError, pygame.gfxdraw.pixels, surf, [(1, 2)], "x")
+
     def test_hline(self):
         """hline(surface, x1, x2, y, color): return None"""
         fg = self.foreground_color
@@ -276,6 +296,42 @@ class GfxdrawDefaultTest(unittest.TestCase):
             for posn in bg_test_points:
                 self.check_at(surf, posn, bg_adjusted)
 
+    def test_boxes(self):
+        """boxes(surface, rects, color): return None"""
+        fg = self.foreground_color
+        bg = self.background_color
+        rects = [pygame.Rect(10, 15, 20, 10), (40, 5, 5, 30), (60, 60, 0, 9)]
+        for surf in self.surfaces:
+            fg_adjusted = surf.unmap_rgb(surf.map_rgb(fg))
+            bg_adjusted = surf.unmap_rgb(surf.map_rgb(bg))
+            pygame.gfxdraw.boxes(surf, rects, fg)
+            for posn in [(10, 15), (29, 24), (40, 5), (44, 34)]:
+                self.check_at(surf, posn, fg_adjusted)
+            for posn in [(9, 15), (30, 24), (10, 25), (45, 34), (60, 60)]:
+                self.check_at(surf, posn, bg_adjusted)
+
+        surf = self.surfaces[0]
+        self.assertRaises(TypeError, pygame.gfxdraw.boxes, surf, 5, fg)
+        self.assertRaises(TypeError, pygame.gfxdraw.boxes, surf, [(1, 2)], fg)
+
+    def test_box__blend_matches_pixel(self):
+        """Ensures a blended box gives the same colors as blended pixels."""
+        color = (200, 100, 50, 128)
+        for size in (16, 32):
+            for dest in ((10, 20, 30, 255), (250, 240, 230, 90)):
+                surf = pygame.Surface((8, 8), SRCALPHA, size)
+                surf.fill(dest)
+                pygame.gfxdraw.box(surf, (0, 0, 4, 8), color)
+                for y in range(8):
+                    pygame.gfxdraw.pixel(surf, 5, y, color)
+                pygame.gfxdraw.boxes(surf, [(6, 0, 2, 8)], color)
+
+                expected = surf.get_at((5, 3))
+                dest_adjusted = surf.unmap_rgb(surf.map_rgb(dest))
+                self.assertNotEqual(expected, dest_adjusted)
+                for posn in ((0, 0), (3, 7), (6, 2), (7, 7)):
+                    self.check_at(surf, posn, expected)
+
     def test_line(self):
         """line(surface, x1, y1, x2, y2, color): return None"""
         fg = self.foreground_color
@@ -805,6 +861,27 @@ class GfxdrawDefaultTest(unittest.TestCase):
             for posn in bg_test_points:
                 self.check_at(surf, posn, bg_adjusted)
 
+    def test_filled_polygon__large(self):
+        """Ensures a polygon large enough to be filled in parallel bands of
+        rows matches the same polygon filled through small clip areas.
+        """
+        size = (1000, 800)
+        points = [(-20, 30), (990, 5), (700, 790), (500, 300), (10, 760)]
+
+        for color in ((200, 100, 50), (200, 100, 50, 120)):
+            surface = pygame.Surface(size, 0, 32)
+            tiled = pygame.Surface(size, 0, 32)
+            surface.fill((10, 20, 30))
+            tiled.fill((10, 20, 30))
+
+            pygame.gfxdraw.filled_polygon(surface, points, color)
+            for x in range(0, size[0], 200):
+                for y in range(0, size[1], 200):
+                    tiled.set_clip((x, y, 200, 200))
+                    pygame.gfxdraw.filled_polygon(tiled, points, color)
+
+            self.assertEqual(surface.get_buffer().raw, tiled.get_buffer().raw)
+
     def test_textured_polygon(self):
         """textured_polygon(surface, points, texture, tx, ty): return None"""
         w, h = self.default_size
@@ -851,6 +928,93 @@ class GfxdrawDefaultTest(unittest.TestCase):
             0,
         )
 
+    def test_textured_triangles(self):
+        """Ensures textured_triangles maps a texture onto a quad made of two
+        triangles texel for texel, with and without smoothing.
+        """
+        texture = pygame.Surface((16, 8), SRCALPHA, 32)
+        for x in range(16):
+            for y in range(8):
+                texture.set_at((x, y), (x * 16, y * 32, 100, 255))
+        vertices = [(10, 5), (26, 5), (26, 13), (10, 13)]
+        uvs = [(0, 0), (16, 0), (16, 8), (0, 8)]
+        indices = [0, 1, 2, 0, 2, 3]
+
+        for smooth in (False, True):
+            surf = pygame.Surface((40, 20), 0, 32)
+            surf.fill(self.background_color)
+            pygame.gfxdraw.textured_triangles(
+                surf, texture, vertices, uvs, indices=indices, smooth=smooth
+            )
+            for x in range(40):
+                for y in range(20):
+                    if 10 <= x < 26 and 5 <= y < 13:
+                        expected = texture.get_at((x - 10, y - 5))
+                    else:
+                        expected = self.background_color
+                    self.check_at(surf, (x, y), expected)
+
+    def test_textured_triangles__colors(self):
+        """Ensures the vertex colors multiply the texels."""
+        texture = pygame.Surface((4, 4), 0, 32)
+        texture.fill((255, 255, 255))
+        surf = pygame.Surface((20, 20), 0, 32)
+        surf.fill((0, 0, 0))
+        vertices = [(0, 0), (20, 0), (0, 20)]
+        uvs = [(0, 0), (4, 0), (0, 4)]
+        colors = [(200, 100, 50)] * 3
+
+        pygame.gfxdraw.textured_triangles(surf, texture, vertices, uvs, colors)
+
+        self.check_at(surf, (3, 3), (200, 100, 50))
+        self.check_at(surf, (18, 18), (0, 0, 0))
+
+    def test_textured_triangles__perspective(self):
+        """Ensures vertices with a w are interpolated with perspective
+        correction.
+        """
+        texture = pygame.Surface((2, 1), 0, 32)
+        texture.set_at((0, 0), (255, 0, 0))
+        texture.set_at((1, 0), (0, 0, 255))
+        uvs = [(0, 0.5), (2, 0.5), (2, 0.5), (0, 0.5)]
+        indices = [0, 1, 2, 0, 2, 3]
+        affine = [(0, 0), (100, 0), (100, 10), (0, 10)]
+        perspective = [(0, 0, 1), (100, 0, 3), (100, 10, 3), (0, 10, 1)]
+
+        for vertices, expected in ((affine, (0, 0, 255)), (perspective, (255, 0, 0))):
+            surf = pygame.Surface((100, 10), 0, 32)
+            pygame.gfxdraw.textured_triangles(
+                surf, texture, vertices, uvs, indices=indices
+            )
+            self.check_at(surf, (25, 5), (255, 0, 0))
+            self.check_at(surf, (60, 5), expected)
+            self.check_at(surf, (90, 5), (0, 0, 255))
+
+    def test_textured_triangles__invalid_args(self):
+        """Ensures textured_triangles rejects invalid arguments."""
+        surf = pygame.Surface((10, 10), 0, 32)
+        texture = pygame.Surface((4, 4), 0, 32)
+        vertices = [(0, 0), (5, 0), (0, 5)]
+        uvs = [(0, 0), (4, 0), (0, 4)]
+        draw = pygame.gfxdraw.textured_triangles
+
+        with self.assertRaises(TypeError):
+            draw(surf, "texture", vertices, uvs)
+        with self.assertRaises(TypeError):
+            draw(surf, texture, [(0, 0), (5,), (0, 5)], uvs)
+        with self.assertRaises(ValueError):
+            draw(surf, texture, vertices, uvs[:2])
+        with self.assertRaises(ValueError):
+            draw(surf, texture, vertices[:2], uvs[:2])
+        with self.assertRaises(ValueError):
+            draw(surf, texture, [(0, 0, 1), (5, 0, 0), (0, 5, 1)], uvs)
+        with self.assertRaises(ValueError):
+            draw(surf, texture, vertices, uvs, colors=[(0, 0, 0)])
+        with self.assertRaises(ValueError):
+            draw(surf, texture, vertices, uvs, indices=[0, 1])
+        with self.assertRaises(IndexError):
+            draw(surf, texture, vertices, uvs, indices=[0, 1, 3])
+
     def test_bezier(self):
         """bezier(surface, points, steps, color): return None"""
         fg = self.foreground_color
@@ -872,6 +1036,29 @@ class GfxdrawDefaultTest(unittest.TestCase):
             for posn in bg_test_points:
                 self.check_at(surf, posn, bg_adjusted)
 
+    def test_damage_tracking(self):
+        """Drawing records the bounding box of the shape, within the clip
+        area, on surfaces tracking damage"""
+        fg = self.foreground_color
+        surf = pygame.Surface((100, 100))
+        surf.set_damage_tracking()
+
+        pygame.gfxdraw.filled_circle(surf, 50, 50, 10, fg)
+        self.assertEqual(surf.get_damage(), [pygame.Rect(40, 40, 21, 21)])
+
+        surf.clear_damage()
+        surf.set_clip((0, 0, 50, 100))
+        pygame.gfxdraw.filled_polygon(surf, [(30, 5), (70, 5), (50, 25)], fg)
+        self.assertEqual(surf.get_damage(), [pygame.Rect(30, 5, 20, 21)])
+
+        surf.clear_damage()
+        boxes = [(0, 0, 5, 5), (5, 0, 5, 5), (0, 90, 5, 5)]
+        pygame.gfxdraw.boxes(surf, boxes, fg)
+        self.assertEqual(
+            sorted(surf.get_damage()),
+            [pygame.Rect(0, 0, 10, 5), pygame.Rect(0, 90, 5, 5)],
+        )
+
 
 if __name__ == "__main__":
     unittest.main()
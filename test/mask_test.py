@@ -1,5 +1,6 @@
 from collections import OrderedDict
 import copy
+import math
 import platform
 import random
 import unittest
@@ -1335,6 +1336,114 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         with self.assertRaises(ValueError):
             mask.scale((10, -1))
 
+    def test_rotate(self):
+        """Ensure a mask can be rotated by multiples of 90 degrees."""
+        width, height = 70, 37
+        mask = random_mask((width, height))
+
+        rotated = mask.rotate(90)
+
+        self.assertIsInstance(rotated, pygame.mask.Mask)
+        self.assertEqual(rotated.get_size(), (height, width))
+
+        for x in range(height):
+            for y in range(width):
+                self.assertEqual(
+                    rotated.get_at((x, y)), mask.get_at((width - 1 - y, x))
+                )
+
+        rotated = mask.rotate(180)
+
+        self.assertEqual(rotated.get_size(), (width, height))
+
+        for x in range(width):
+            for y in range(height):
+                self.assertEqual(
+                    rotated.get_at((x, y)),
+                    mask.get_at((width - 1 - x, height - 1 - y)),
+                )
+
+        # Four quarter turns give back the original mask.
+        rotated = mask
+        for _ in range(4):
+            rotated = rotated.rotate(-90)
+
+        self.assertEqual(rotated.get_size(), mask.get_size())
+        self.assertEqual(rotated.overlap_area(mask, (0, 0)), mask.count())
+        self.assertEqual(rotated.count(), mask.count())
+
+    def test_rotate__matches_transform_rotate(self):
+        """Ensure rotate gives the same bits as rotating a surface."""
+        size = (43, 61)
+        surface = pygame.Surface(size, SRCALPHA, 32)
+        surface.fill((0, 0, 0, 0))
+        mask = random_mask(size)
+
+        for x in range(size[0]):
+            for y in range(size[1]):
+                if mask.get_at((x, y)):
+                    surface.set_at((x, y), (255, 255, 255, 255))
+
+        for angle in (-135, -30, 0, 1, 17.5, 45, 90, 200, 270, 359, 725):
+            msg = "angle={}".format(angle)
+            expected_mask = pygame.mask.from_surface(
+                pygame.transform.rotate(surface, angle)
+            )
+
+            rotated = mask.rotate(angle)
+
+            self.assertEqual(rotated.get_size(), expected_mask.get_size(), msg)
+            self.assertEqual(rotated.count(), expected_mask.count(), msg)
+            self.assertEqual(
+                rotated.overlap_area(expected_mask, (0, 0)),
+                expected_mask.count(),
+                msg,
+            )
+
+            # Ensure the original mask is unchanged.
+            self.assertEqual(mask.get_size(), size, msg)
+
+    def test_rotate__zero_sized(self):
+        """Ensure zero sized masks can be rotated."""
+        for size in ((0, 0), (0, 10), (10, 0)):
+            mask = pygame.mask.Mask(size)
+
+            rotated = mask.rotate(33)
+
+            self.assertIsInstance(rotated, pygame.mask.Mask)
+            self.assertEqual(rotated.get_size(), size)
+
+    def test_rotate__large_angle(self):
+        """Ensure quarter turns larger than an int are handled correctly."""
+        mask = random_mask((7, 3))
+
+        for angle in (90.0 * 2**40, -90.0 * 2**40, 360.0 * 2**50):
+            rotated = mask.rotate(angle)
+
+            self.assertEqual(rotated.get_size(), mask.get_size())
+            self.assertEqual(rotated.overlap_area(mask, (0, 0)), mask.count())
+            self.assertEqual(rotated.count(), mask.count())
+
+    def test_rotate__wide_mask(self):
+        """Ensure masks too wide for 16.16 fixed point in an int rotate."""
+        mask = pygame.mask.Mask((40000, 2), fill=True)
+
+        rotated = mask.rotate(1)
+
+        self.assertGreater(rotated.count(), 0.9 * mask.count())
+        self.assertLess(rotated.count(), 1.1 * mask.count())
+
+    def test_rotate__invalid_angle(self):
+        """Ensure rotate handles non finite angles correctly."""
+        mask = pygame.mask.Mask((10, 10), fill=True)
+
+        for angle in (float("inf"), float("-inf"), float("nan")):
+            with self.assertRaises(ValueError):
+                mask.rotate(angle)
+
+        with self.assertRaises(TypeError):
+            mask.rotate("45")
+
     def test_draw(self):
         """Ensure a mask can be drawn onto another mask.
 
@@ -1723,6 +1832,114 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         with self.assertRaises(TypeError):
             mask1.erase(mask2, offset)
 
+    def test_compose(self):
+        """Ensure compose matches drawing and erasing in order."""
+        random.seed(14)
+        size = (203, 37)
+        mask = random_mask(size)
+        expected_mask = mask.copy()
+        operations = []
+
+        for _ in range(60):
+            other = random_mask((random.randint(0, 90), random.randint(0, 20)))
+            offset = (random.randint(-100, 220), random.randint(-25, 40))
+
+            if random.random() < 0.5:
+                operations.append((other, offset))
+                expected_mask.draw(other, offset)
+            else:
+                operations.append((other, offset, "erase"))
+                expected_mask.erase(other, offset)
+
+        result = mask.compose(operations)
+
+        self.assertIsNone(result)
+        assertMaskEqual(self, mask, expected_mask)
+
+    def test_compose__large(self):
+        """Ensure compose on a large mask, which is split over threads, matches
+        draw and erase."""
+        random.seed(3)
+        mask = pygame.mask.Mask((1500, 900))
+        expected_mask = pygame.mask.Mask((1500, 900))
+        stamp = pygame.mask.Mask((40, 40), fill=True)
+        crater = pygame.mask.Mask((25, 25), fill=True)
+        operations = []
+
+        for _ in range(2000):
+            offset = (random.randint(-40, 1500), random.randint(-40, 900))
+            operations.append((stamp, offset, "draw"))
+            expected_mask.draw(stamp, offset)
+
+            offset = (random.randint(-25, 1500), random.randint(-25, 900))
+            operations.append((crater, offset, "erase"))
+            expected_mask.erase(crater, offset)
+
+        mask.compose(operations)
+
+        self.assertEqual(mask.count(), expected_mask.count())
+        self.assertEqual(mask.overlap_area(expected_mask, (0, 0)), mask.count())
+
+    def test_compose__bit_boundaries(self):
+        """Ensures compose handles masks of different sizes correctly."""
+        for width in range(1, 68):
+            mask_size = (width, 3)
+            other = pygame.mask.Mask(mask_size, fill=True)
+
+            for offset in self.ORIGIN_OFFSETS:
+                msg = "size={}, offset={}".format(mask_size, offset)
+                mask = pygame.mask.Mask(mask_size)
+                expected_mask = pygame.mask.Mask(mask_size)
+
+                mask.compose([(other, offset)])
+                expected_mask.draw(other, offset)
+
+                assertMaskEqual(self, mask, expected_mask, msg)
+                self.assertEqual(mask.count(), expected_mask.count(), msg)
+
+    def test_compose__self(self):
+        """Ensure a mask composed onto itself is read as it was before."""
+        mask = pygame.mask.Mask((10, 3))
+        mask.set_at((0, 1))
+
+        mask.compose([(mask, (1, 0)), (mask, (2, 0))])
+
+        self.assertEqual(mask.count(), 3)
+
+        for x in range(3):
+            self.assertEqual(mask.get_at((x, 1)), 1)
+
+    def test_compose__empty(self):
+        """Ensure composing no operations leaves the mask unchanged."""
+        mask = pygame.mask.Mask((5, 5), fill=True)
+
+        mask.compose([])
+        pygame.mask.Mask((0, 0)).compose([(mask, (0, 0))])
+
+        self.assertEqual(mask.count(), 25)
+
+    def test_compose__invalid_args(self):
+        """Ensure compose rejects invalid operations."""
+        mask = pygame.mask.Mask((5, 5))
+        other = pygame.mask.Mask((2, 2))
+
+        for operations in (
+            None,
+            [other],
+            [(other,)],
+            [(other, (0, 0), "draw", 1)],
+            [(pygame.Surface((2, 2)), (0, 0))],
+            [(other, "(0, 0)")],
+        ):
+            with self.assertRaises(TypeError):
+                mask.compose(operations)
+
+        for op in ("xor", None):
+            with self.assertRaises(ValueError):
+                mask.compose([(other, (0, 0)), (other, (1, 1), op)])
+
+        self.assertEqual(mask.count(), 0)
+
     def test_count(self):
         """Ensure a mask's set bits are correctly counted."""
         side = 67
@@ -1981,6 +2198,119 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
 
         # TODO: Test more corner case outlines.
 
+    @staticmethod
+    def _contour_points(points):
+        """Returns the points of a contour as a list of [x, y] lists.
+
+        The points' format carries a byte order prefix, which memoryview
+        can't convert to a list, so it is recast through bytes.
+        """
+        shape = memoryview(points).shape
+        return memoryview(points).cast("B").cast("i", shape).tolist()
+
+    def test_contours(self):
+        """Ensure contours traces the outer and hole borders."""
+        mask = pygame.mask.Mask((12, 12))
+
+        for x in range(2, 7):
+            for y in range(3, 8):
+                mask.set_at((x, y))
+
+        mask.set_at((4, 5), 0)
+        mask.set_at((10, 10))
+
+        contours = mask.contours()
+
+        self.assertEqual(len(contours), 3)
+
+        outer, hole, dot = (points for points, _ in contours)
+
+        self.assertEqual([is_hole for _, is_hole in contours], [False, True, False])
+
+        for points in (outer, hole, dot):
+            self.assertIsInstance(points, pygame.BufferProxy)
+            self.assertEqual(memoryview(points).itemsize, 4)
+            self.assertTrue(memoryview(points).c_contiguous)
+            self.assertEqual(points.__array_interface__["typestr"][1:], "i4")
+
+        # Outer borders run counterclockwise, holes clockwise.
+        self.assertEqual(
+            self._contour_points(outer),
+            [[2, 3], [2, 4], [2, 5], [2, 6], [2, 7], [3, 7], [4, 7], [5, 7]]
+            + [[6, 7], [6, 6], [6, 5], [6, 4], [6, 3], [5, 3], [4, 3], [3, 3]],
+        )
+        self.assertEqual(self._contour_points(hole), [[3, 5], [4, 4], [5, 5], [4, 6]])
+        self.assertEqual(memoryview(dot).shape, (1, 2))
+        self.assertEqual(self._contour_points(dot), [[10, 10]])
+
+    def test_contours__simplified(self):
+        """Ensure epsilon simplifies the borders."""
+        mask = pygame.mask.Mask((12, 12))
+
+        for x in range(2, 7):
+            for y in range(3, 8):
+                mask.set_at((x, y))
+
+        contours = mask.contours(epsilon=0.5)
+
+        self.assertEqual(len(contours), 1)
+        self.assertEqual(
+            self._contour_points(contours[0][0]), [[2, 3], [2, 7], [6, 7], [6, 3]]
+        )
+
+    def test_contours__matches_components(self):
+        """Ensure there is one outer border per connected component and all
+        border points are set bits next to each other."""
+        random.seed(29)
+
+        for size in ((1, 1), (63, 20), (64, 9), (65, 31), (130, 17)):
+            mask = random_mask(size)
+            contours = mask.contours()
+            outer = [points for points, is_hole in contours if not is_hole]
+
+            self.assertEqual(len(outer), len(mask.connected_components()))
+
+            for points, _ in contours:
+                points = self._contour_points(points)
+
+                for i, (x, y) in enumerate(points):
+                    next_x, next_y = points[(i + 1) % len(points)]
+
+                    self.assertEqual(mask.get_at((x, y)), 1)
+                    self.assertLessEqual(abs(x - next_x), 1)
+                    self.assertLessEqual(abs(y - next_y), 1)
+
+            for epsilon in (1, 2.5):
+                simplified = mask.contours(epsilon)
+
+                self.assertEqual(len(simplified), len(contours))
+
+                for (points, is_hole), (full, full_is_hole) in zip(
+                    simplified, contours
+                ):
+                    self.assertEqual(is_hole, full_is_hole)
+                    self.assertLessEqual(
+                        len(self._contour_points(points)),
+                        len(self._contour_points(full)),
+                    )
+                    self.assertEqual(
+                        self._contour_points(points)[0],
+                        self._contour_points(full)[0],
+                    )
+
+    def test_contours__empty(self):
+        """Ensure empty and zero sized masks have no contours."""
+        for size in ((0, 0), (0, 5), (5, 0), (5, 5)):
+            self.assertEqual(pygame.mask.Mask(size).contours(), [])
+
+    def test_contours__invalid_epsilon(self):
+        """Ensure invalid epsilons are rejected."""
+        mask = pygame.mask.Mask((5, 5), fill=True)
+
+        for epsilon in (-1, float("inf"), float("nan")):
+            with self.assertRaises(ValueError):
+                mask.contours(epsilon)
+
     def test_convolve__size(self):
         sizes = [(1, 1), (31, 31), (32, 32), (100, 100)]
         for s1 in sizes:
@@ -2048,6 +2378,40 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
             self.assertIsInstance(convolve_mask, pygame.mask.Mask)
             self.assertEqual(convolve_mask.count(), expected_count)
 
+    def test_convolve__solid_kernels(self):
+        """Ensure kernels with long runs of bits, which are convolved a run at
+        a time, give the same result as drawing bit by bit."""
+        random.seed(30)
+        mask = random_mask((150, 70))
+
+        for kernel_size in ((1, 1), (3, 64), (64, 64), (70, 9), (130, 5)):
+            kernel = pygame.mask.Mask(kernel_size, fill=True)
+
+            # Cut some gaps so the runs have different lengths.
+            for y in range(0, kernel_size[1], 3):
+                kernel.set_at((random.randrange(kernel_size[0]), y), 0)
+
+            for offset in ((0, 0), (-5, 3), (64, -70)):
+                msg = "kernel={}, offset={}".format(kernel_size, offset)
+                width, height = kernel_size
+                output_size = (
+                    mask.get_size()[0] + width - 1,
+                    mask.get_size()[1] + height - 1,
+                )
+                expected = pygame.mask.Mask(output_size)
+
+                for x in range(width):
+                    for y in range(height):
+                        if kernel.get_at((x, y)):
+                            expected.draw(
+                                mask,
+                                (offset[0] + width - 1 - x, offset[1] + height - 1 - y),
+                            )
+
+                output = mask.convolve(kernel, None, offset)
+
+                assertMaskEqual(self, output, expected, msg)
+
     @unittest.skipIf(IS_PYPY, "Segfaults on pypy")
     def test_convolve(self):
         """Tests the definition of convolution"""
@@ -2062,6 +2426,99 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
                     conv.get_at((i, j)) == 0, m1.overlap(m2, (i - 99, j - 99)) is None
                 )
 
+    @staticmethod
+    def _float_field_view(field):
+        """Returns a native float memoryview of a float distance field.
+
+        The field's format carries a byte order prefix, which memoryview
+        can't index, so it is recast through bytes.
+        """
+        shape = memoryview(field).shape
+        return memoryview(field).cast("B").cast("f", shape)
+
+    def test_distance_field(self):
+        """Ensure distance_field gives the distance to the nearest set bit."""
+        width, height = 37, 23
+        mask = pygame.mask.Mask((width, height))
+        set_bits = ((0, 0), (20, 5), (36, 22), (10, 17))
+
+        for pos in set_bits:
+            mask.set_at(pos)
+
+        field = mask.distance_field()
+        view = self._float_field_view(field)
+
+        self.assertIsInstance(field, pygame.BufferProxy)
+        self.assertEqual(memoryview(field).shape, (width, height))
+        self.assertEqual(view.shape, (width, height))
+
+        for x in range(width):
+            for y in range(height):
+                expected = min(math.hypot(x - bx, y - by) for bx, by in set_bits)
+                self.assertAlmostEqual(view[x, y], expected, places=4)
+
+    def test_distance_field__uint8(self):
+        """Ensure the byte format rounds and saturates the distances."""
+        width, height = 300, 3
+        mask = pygame.mask.Mask((width, height))
+        mask.set_at((0, 1))
+
+        view = memoryview(mask.distance_field(format="B"))
+
+        self.assertEqual(view.shape, (width, height))
+        self.assertEqual(view.format, "B")
+
+        for x in range(width):
+            for y in range(height):
+                expected = min(255, int(math.hypot(x, y - 1) + 0.5))
+                self.assertEqual(view[x, y], expected)
+
+    def test_distance_field__no_set_bits(self):
+        """Ensure distances are infinite when no bits are set."""
+        mask = pygame.mask.Mask((5, 4))
+
+        view = self._float_field_view(mask.distance_field())
+        byte_view = memoryview(mask.distance_field("B"))
+
+        for x in range(5):
+            for y in range(4):
+                self.assertEqual(view[x, y], float("inf"))
+                self.assertEqual(byte_view[x, y], 255)
+
+    def test_distance_field__full_and_zero_sized(self):
+        """Ensure full and zero sized masks are handled."""
+        view = self._float_field_view(
+            pygame.mask.Mask((70, 65), fill=True).distance_field()
+        )
+
+        self.assertEqual(view.tolist(), [[0.0] * 65] * 70)
+
+        for size in ((0, 0), (0, 10), (10, 0)):
+            field = pygame.mask.Mask(size).distance_field()
+
+            self.assertEqual(field.length, 0)
+
+    def test_distance_field__large(self):
+        """Ensure large masks, which are split over threads, are exact."""
+        width, height = 700, 500
+        mask = pygame.mask.Mask((width, height))
+        mask.set_at((3, 499))
+        mask.set_at((699, 0))
+
+        view = self._float_field_view(mask.distance_field())
+
+        for x in range(0, width, 7):
+            for y in range(0, height, 11):
+                expected = min(math.hypot(x - 3, y - 499), math.hypot(x - 699, y))
+                self.assertAlmostEqual(view[x, y], expected, places=2)
+
+    def test_distance_field__invalid_format(self):
+        """Ensure an invalid format is rejected."""
+        mask = pygame.mask.Mask((5, 5))
+
+        with self.assertRaises(ValueError):
+            mask.distance_field("d")
+
     def _draw_component_pattern_box(self, mask, size, pos, inverse=False):
         # Helper method to create/draw a 'box' pattern for testing.
         #
@@ -6436,5 +6893,119 @@ class MaskModuleTest(unittest.TestCase):
             )
 
 
+@unittest.skipIf(IS_PYPY, "pypy has lots of mask failures")  # TODO
+class RotationCacheTest(unittest.TestCase):
+    def test_rotation_cache(self):
+        """Ensure a rotation cache holds the mask rotated to each step."""
+        mask = random_mask((31, 17))
+        steps = 24
+
+        cache = pygame.mask.RotationCache(mask, steps)
+
+        self.assertEqual(len(cache), steps)
+        self.assertEqual(cache.steps, steps)
+
+        for i in range(steps):
+            angle = i * 360.0 / steps
+            expected_mask = mask.rotate(angle)
+
+            rotated = cache.get(angle)
+
+            self.assertIsInstance(rotated, pygame.mask.Mask)
+            self.assertEqual(rotated.get_size(), expected_mask.get_size())
+            self.assertEqual(rotated.count(), expected_mask.count())
+            self.assertEqual(
+                rotated.overlap_area(expected_mask, (0, 0)),
+                expected_mask.count(),
+            )
+
+    def test_rotation_cache__default_steps(self):
+        """Ensure a rotation cache stores every degree by default."""
+        cache = pygame.mask.RotationCache(pygame.mask.Mask((5, 5), fill=True))
+
+        self.assertEqual(len(cache), 360)
+
+    def test_get__nearest_step(self):
+        """Ensure get returns the mask of the nearest stored angle."""
+        mask = random_mask((20, 10))
+        cache = pygame.mask.RotationCache(mask, steps=4)
+
+        self.assertIs(cache.get(44), cache.get(0))
+        self.assertIs(cache.get(-44), cache.get(0))
+        self.assertIs(cache.get(359), cache.get(0))
+        self.assertIs(cache.get(720), cache.get(0))
+        self.assertIs(cache.get(46), cache.get(90))
+        self.assertIs(cache.get(-90), cache.get(270))
+        self.assertEqual(cache.get(90).get_size(), (10, 20))
+
+    def test_get__invalid_angle(self):
+        """Ensure get handles non finite angles correctly."""
+        cache = pygame.mask.RotationCache(pygame.mask.Mask((5, 5)), 8)
+
+        for angle in (float("inf"), float("-inf"), float("nan")):
+            with self.assertRaises(ValueError):
+                cache.get(angle)
+
+    def test_quantize(self):
+        """Ensure quantize returns the stored angle get uses."""
+        cache = pygame.mask.RotationCache(pygame.mask.Mask((5, 5)), 8)
+
+        self.assertEqual(cache.quantize(0), 0.0)
+        self.assertEqual(cache.quantize(50), 45.0)
+        self.assertEqual(cache.quantize(-50), 315.0)
+        self.assertEqual(cache.quantize(359), 0.0)
+        self.assertEqual(cache.quantize(405), 45.0)
+
+    def test_cache_unaffected_by_source_changes(self):
+        """Ensure changing the source mask does not change the cache."""
+        mask = pygame.mask.Mask((8, 8), fill=True)
+        cache = pygame.mask.RotationCache(mask, 4)
+
+        mask.clear()
+
+        self.assertEqual(cache.get(0).count(), 64)
+
+    def test_nbytes(self):
+        """Ensure the memory used is reported and bounded."""
+        mask = pygame.mask.Mask((64, 64), fill=True)
+        small_cache = pygame.mask.RotationCache(mask, 4)
+        large_cache = pygame.mask.RotationCache(mask, 36)
+
+        self.assertGreater(small_cache.nbytes, 0)
+        self.assertGreater(large_cache.nbytes, small_cache.nbytes)
+
+        # The exact bound is allowed, one byte less is not.
+        bounded_cache = pygame.mask.RotationCache(
+            mask, 36, max_bytes=large_cache.nbytes
+        )
+
+        self.assertEqual(bounded_cache.nbytes, large_cache.nbytes)
+
+        with self.assertRaises(ValueError):
+            pygame.mask.RotationCache(mask, 36, max_bytes=large_cache.nbytes - 1)
+
+    def test_nbytes__default_bound(self):
+        """Ensure the memory is bounded by default, and None lifts the bound."""
+        with self.assertRaises(ValueError):
+            pygame.mask.RotationCache(pygame.mask.Mask((4096, 4096)))
+
+        cache = pygame.mask.RotationCache(pygame.mask.Mask((8, 8)), max_bytes=None)
+
+        self.assertEqual(len(cache), 360)
+
+    def test_invalid_args(self):
+        """Ensure invalid arguments are rejected."""
+        mask = pygame.mask.Mask((5, 5))
+
+        with self.assertRaises(ValueError):
+            pygame.mask.RotationCache(mask, 0)
+
+        with self.assertRaises(ValueError):
+            pygame.mask.RotationCache(mask, 4, max_bytes=-1)
+
+        with self.assertRaises(TypeError):
+            pygame.mask.RotationCache(pygame.Surface((5, 5)))
+
+
 if __name__ == "__main__":
     unittest.main()
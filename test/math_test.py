@@ -1,11 +1,21 @@
 # -*- coding: utf-8 -*-
+import array
+import decimal
+import fractions
 import math
 import platform
 import unittest
 from collections.abc import Collection, Sequence
 
 import pygame.math
-from pygame.math import Vector2, Vector3
+from pygame.math import (
+    Matrix3,
+    Matrix4,
+    Vector2,
+    Vector2Array,
+    Vector3,
+    Vector3Array,
+)
 
 IS_PYPY = "PyPy" == platform.python_implementation()
 
@@ -1059,6 +1069,53 @@ class Vector2TypeTest(unittest.TestCase):
         vec_a + vec_b
         vec_a *= 2
 
+    def test_reused_vectors(self):
+        """Ensures new vectors don't keep anything of freed ones."""
+        for _ in range(3):
+            temporaries = [Vector2(i, -i) + (1, 1) for i in range(1000)]
+            for v in temporaries:
+                v.epsilon = 0.5
+            del temporaries
+
+            v = Vector2.__new__(Vector2)
+            self.assertEqual(v, (0, 0))
+            self.assertEqual(v.epsilon, Vector2().epsilon)
+            self.assertEqual(len(v), 2)
+            self.assertEqual(Vector3(1, 2, 3) + (1, 1, 1), (2, 3, 4))
+
+    def test_builtin_operands(self):
+        """Ensures tuples, lists, floats and ints give the same results
+        as vectors and other numbers."""
+        v = Vector2(1.5, -2)
+        for other in ((3, 4), [3, 4], (3.0, 4.0), [3, 4.0]):
+            self.assertEqual(v + other, v + Vector2(3, 4))
+            self.assertEqual(other - v, Vector2(3, 4) - v)
+            self.assertEqual(v * other, v * Vector2(3, 4))
+            self.assertEqual(v.dot(other), v.dot(Vector2(3, 4)))
+            self.assertEqual(v == other, False)
+        self.assertEqual(v + (decimal.Decimal(3), fractions.Fraction(4)), (4.5, 2))
+        self.assertEqual(v * 2, v * 2.0)
+        self.assertEqual(v / 4, v * 0.25)
+        self.assertEqual(v * fractions.Fraction(1, 2), (0.75, -1))
+        self.assertEqual(v * True, v)
+        self.assertEqual(v + (1, True), (2.5, -1))
+
+        self.assertRaises(OverflowError, lambda: v * 10**400)
+        self.assertRaises(OverflowError, lambda: v + (10**400, 1))
+        self.assertRaises(TypeError, lambda: v + (1, "2"))
+        self.assertRaises(TypeError, lambda: v + (1, 2, 3))
+        self.assertRaises(TypeError, lambda: v + [1])
+
+    def test_swizzle_str_subclass(self):
+        class Name(str):
+            pass
+
+        v = Vector2(1, 2)
+        self.assertEqual(getattr(v, Name("yx")), (2, 1))
+        self.assertEqual(getattr(v, Name("x")), 1)
+        self.assertRaises(AttributeError, getattr, v, Name("xq"))
+        self.assertRaises(AttributeError, getattr, v, "")
+
     def test_project_v2_onto_x_axis(self):
         """Project onto x-axis, e.g. get the component pointing in the x-axis direction."""
         # arrange
@@ -2556,5 +2613,493 @@ class Vector3TypeTest(unittest.TestCase):
         self.assertEqual(type(other.elementwise() ** 3), TestVector)
 
 
+class Vector2ArrayTypeTest(unittest.TestCase):
+    def setUp(self):
+        self.vectors = [Vector2(1.5, -2), Vector2(0, 3), Vector2(-4, 0.25)]
+        self.others = [Vector2(2, 1), Vector2(-1, 1), Vector2(3, -3)]
+        self.a = Vector2Array(self.vectors)
+        self.b = Vector2Array(self.others)
+
+    def assertVectorsEqual(self, array, vectors):
+        self.assertEqual(len(array), len(vectors))
+        for got, expected in zip(array, vectors):
+            self.assertAlmostEqual(got.x, expected.x)
+            self.assertAlmostEqual(got.y, expected.y)
+
+    def assertNumbersEqual(self, numbers, expected):
+        self.assertEqual(len(numbers), len(expected))
+        for got, want in zip(numbers, expected):
+            self.assertAlmostEqual(got, want)
+
+    def test_construction(self):
+        self.assertEqual(len(Vector2Array()), 0)
+        self.assertEqual(list(Vector2Array(3)), [Vector2()] * 3)
+        self.assertEqual(list(self.a), self.vectors)
+        self.assertEqual(list(Vector2Array([(1, 2), [3, 4]])), [(1, 2), (3, 4)])
+        self.assertEqual(list(Vector2Array(self.a)), self.vectors)
+        self.assertEqual(
+            list(Vector2Array(array.array("d", [1, 2, 3, 4]))), [(1, 2), (3, 4)]
+        )
+        self.assertRaises(ValueError, Vector2Array, -1)
+        self.assertRaises(TypeError, Vector2Array, [(1, 2, 3)])
+        self.assertRaises(TypeError, Vector2Array, [(1, "2")])
+        self.assertRaises(TypeError, Vector2Array, 1.5)
+
+    def test_sequence(self):
+        self.assertEqual(self.a[1], self.vectors[1])
+        self.assertEqual(self.a[-1], self.vectors[-1])
+        self.assertIsInstance(self.a[0], Vector2)
+        self.a[0] = (7, 8)
+        self.assertEqual(self.a[0], (7, 8))
+        self.a[0].x = 10
+        self.assertEqual(self.a[0], (7, 8))
+        with self.assertRaises(IndexError):
+            self.a[3]
+        with self.assertRaises(IndexError):
+            self.a[3] = (1, 2)
+        with self.assertRaises(TypeError):
+            self.a[0] = (1, 2, 3)
+        with self.assertRaises(TypeError):
+            del self.a[0]
+
+    def test_buffer(self):
+        view = memoryview(self.a)
+        self.assertEqual(view.format, "d")
+        self.assertEqual(view.shape, (3, 2))
+        self.assertEqual(view.tolist()[2], [-4, 0.25])
+        view[1, 0] = 5
+        self.assertEqual(self.a[1], (5, 3))
+
+    def test_arithmetic(self):
+        self.assertVectorsEqual(
+            self.a + self.b, [v + o for v, o in zip(self.vectors, self.others)]
+        )
+        self.assertVectorsEqual(
+            self.a - self.b, [v - o for v, o in zip(self.vectors, self.others)]
+        )
+        self.assertVectorsEqual(self.a + (1, 2), [v + (1, 2) for v in self.vectors])
+        self.assertVectorsEqual((1, 2) - self.a, [(1, 2) - v for v in self.vectors])
+        self.assertVectorsEqual(self.a * 3, [v * 3 for v in self.vectors])
+        self.assertVectorsEqual(3 * self.a, [v * 3 for v in self.vectors])
+        self.assertEqual(list(self.a / 4), [v / 4 for v in self.vectors])
+        # dividing must not be done as multiplying by 1 / 0.1
+        self.assertEqual(list(Vector2Array([(0.7, 0.7)]) / 0.1), [Vector2(0.7) / 0.1])
+        self.assertEqual((Vector2(0.7) / 0.1).x, 0.7 / 0.1)
+        self.assertRaises(OverflowError, lambda: self.a * 10**400)
+        self.assertRaises(OverflowError, lambda: self.a / 10**400)
+        self.assertVectorsEqual(-self.a, [-v for v in self.vectors])
+        self.assertRaises(ZeroDivisionError, lambda: self.a / 0)
+        self.assertRaises(ValueError, lambda: self.a + Vector2Array(2))
+        self.assertRaises(TypeError, lambda: self.a * self.b)
+        self.assertRaises(TypeError, lambda: self.a + 1)
+
+        a = self.a
+        a += self.b
+        a *= 2
+        self.assertIs(a, self.a)
+        self.assertVectorsEqual(
+            a, [(v + o) * 2 for v, o in zip(self.vectors, self.others)]
+        )
+
+    def test_copy(self):
+        copy = self.a.copy()
+        copy[0] = (0, 0)
+        self.assertEqual(self.a[0], self.vectors[0])
+        self.assertEqual(list(copy)[1:], self.vectors[1:])
+
+    def test_lengths_and_products(self):
+        self.assertIsInstance(self.a.length(), array.array)
+        self.assertNumbersEqual(self.a.length(), [v.length() for v in self.vectors])
+        self.assertNumbersEqual(
+            self.a.length_squared(), [v.length_squared() for v in self.vectors]
+        )
+        self.assertNumbersEqual(
+            self.a.dot(self.b), [v.dot(o) for v, o in zip(self.vectors, self.others)]
+        )
+        self.assertNumbersEqual(
+            self.a.cross((1, 2)), [v.cross((1, 2)) for v in self.vectors]
+        )
+        self.assertNumbersEqual(
+            self.a.distance_to(self.b),
+            [v.distance_to(o) for v, o in zip(self.vectors, self.others)],
+        )
+        self.assertNumbersEqual(
+            self.a.distance_squared_to((1, 1)),
+            [v.distance_squared_to((1, 1)) for v in self.vectors],
+        )
+        self.assertRaises(TypeError, self.a.dot, 1)
+
+    def test_normalize(self):
+        self.assertVectorsEqual(
+            self.a.normalize(), [v.normalize() for v in self.vectors]
+        )
+        self.assertIsNone(self.a.normalize_ip())
+        self.assertVectorsEqual(self.a, [v.normalize() for v in self.vectors])
+
+        self.a[1] = (0, 0)
+        before = list(self.a)
+        self.assertRaises(ValueError, self.a.normalize)
+        self.assertRaises(ValueError, self.a.normalize_ip)
+        self.assertEqual(list(self.a), before)
+
+    def test_rotate(self):
+        for angle in (0, 90, 180, -270, 33.3):
+            self.assertVectorsEqual(
+                self.a.rotate(angle), [v.rotate(angle) for v in self.vectors]
+            )
+        self.assertEqual(list(self.a.rotate(90)), [v.rotate(90) for v in self.vectors])
+        self.assertIsNone(self.a.rotate_ip(45))
+        self.assertVectorsEqual(self.a, [v.rotate(45) for v in self.vectors])
+
+    def test_reflect(self):
+        self.assertVectorsEqual(
+            self.a.reflect((1, 1)), [v.reflect((1, 1)) for v in self.vectors]
+        )
+        self.assertVectorsEqual(
+            self.a.reflect(self.b),
+            [v.reflect(o) for v, o in zip(self.vectors, self.others)],
+        )
+        self.assertRaises(ValueError, self.a.reflect, (0, 0))
+        self.b[2] = (0, 0)
+        self.assertRaises(ValueError, self.a.reflect_ip, self.b)
+        self.assertEqual(list(self.a), self.vectors)
+
+    def test_interpolation(self):
+        self.assertVectorsEqual(
+            self.a.lerp(self.b, 0.25),
+            [v.lerp(o, 0.25) for v, o in zip(self.vectors, self.others)],
+        )
+        self.assertVectorsEqual(
+            self.a.slerp(self.b, -0.5),
+            [v.slerp(o, -0.5) for v, o in zip(self.vectors, self.others)],
+        )
+        self.assertRaises(ValueError, self.a.lerp, self.b, 2)
+        self.assertRaises(ValueError, self.a.slerp, self.b, 2)
+        self.assertRaises(ValueError, self.a.slerp, (0, 0), 0.5)
+        self.assertRaises(ValueError, self.a.slerp, -self.a, 0.5)
+
+    def test_move_towards(self):
+        for distance in (0.5, 2, 100, -1):
+            self.assertVectorsEqual(
+                self.a.move_towards(self.b, distance),
+                [
+                    v.move_towards(o, distance)
+                    for v, o in zip(self.vectors, self.others)
+                ],
+            )
+        self.assertIsNone(self.a.move_towards_ip((0, 0), 1))
+        self.assertVectorsEqual(
+            self.a, [v.move_towards((0, 0), 1) for v in self.vectors]
+        )
+
+    def test_clamp_magnitude(self):
+        self.assertVectorsEqual(
+            self.a.clamp_magnitude(3), [v.clamp_magnitude(3) for v in self.vectors]
+        )
+        self.assertVectorsEqual(
+            self.a.clamp_magnitude(3.5, 4),
+            [v.clamp_magnitude(3.5, 4) for v in self.vectors],
+        )
+        self.assertIsNone(self.a.clamp_magnitude_ip(2))
+        self.assertVectorsEqual(self.a, [v.clamp_magnitude(2) for v in self.vectors])
+        self.a[0] = (0, 0)
+        self.assertRaises(ValueError, self.a.clamp_magnitude, 2)
+
+    def test_large_arrays(self):
+        """The threaded batches give the same results as small ones."""
+        count = 100000
+        a = Vector2Array([(i % 7 - 3, i % 5 + 1) for i in range(count)])
+        lengths = a.length()
+        rotated = a.rotate(30)
+        a.normalize_ip()
+        for i in (0, count // 3, count - 1):
+            v = Vector2(i % 7 - 3, i % 5 + 1)
+            self.assertEqual(lengths[i], v.length())
+            self.assertAlmostEqual(rotated[i].x, v.rotate(30).x)
+            self.assertEqual(a[i], v.normalize())
+
+        a[count // 2] = (0, 0)
+        self.assertRaises(ValueError, a.normalize)
+
+
+class Vector3ArrayTypeTest(unittest.TestCase):
+    def setUp(self):
+        self.vectors = [Vector3(1.5, -2, 1), Vector3(0, 3, -1), Vector3(-4, 0.25, 2)]
+        self.others = [Vector3(2, 1, 0), Vector3(-1, 1, 1), Vector3(3, -3, 0.5)]
+        self.a = Vector3Array(self.vectors)
+        self.b = Vector3Array(self.others)
+
+    def assertVectorsEqual(self, array, vectors):
+        self.assertEqual(len(array), len(vectors))
+        for got, expected in zip(array, vectors):
+            self.assertAlmostEqual(got.x, expected.x)
+            self.assertAlmostEqual(got.y, expected.y)
+            self.assertAlmostEqual(got.z, expected.z)
+
+    def test_construction(self):
+        self.assertEqual(list(Vector3Array(2)), [Vector3()] * 2)
+        self.assertEqual(list(self.a), self.vectors)
+        self.assertEqual(
+            list(Vector3Array(array.array("d", range(6)))), [(0, 1, 2), (3, 4, 5)]
+        )
+        self.assertRaises(TypeError, Vector3Array, [(1, 2)])
+        self.assertRaises(TypeError, Vector3Array, Vector2Array(1))
+        self.assertEqual(memoryview(self.a).shape, (3, 3))
+
+    def test_arithmetic(self):
+        self.assertVectorsEqual(
+            self.a - self.b, [v - o for v, o in zip(self.vectors, self.others)]
+        )
+        self.assertVectorsEqual(self.a * -2, [v * -2 for v in self.vectors])
+        self.assertRaises(TypeError, lambda: self.a + Vector2Array(3))
+
+    def test_cross(self):
+        crossed = self.a.cross(self.b)
+        self.assertIsInstance(crossed, Vector3Array)
+        self.assertVectorsEqual(
+            crossed, [v.cross(o) for v, o in zip(self.vectors, self.others)]
+        )
+
+    def test_rotate(self):
+        for angle, axis in ((90, (0, 0, 1)), (33.3, (1, 2, 3)), (-180, (1, 0, 0))):
+            self.assertVectorsEqual(
+                self.a.rotate(angle, axis),
+                [v.rotate(angle, axis) for v in self.vectors],
+            )
+        self.assertRaises(TypeError, self.a.rotate, 90)
+        self.assertRaises(TypeError, self.a.rotate, 90, (1, 0))
+        self.assertRaises(ValueError, self.a.rotate, 90, (0, 0, 0))
+
+    def test_batch_methods(self):
+        self.assertVectorsEqual(
+            self.a.normalize(), [v.normalize() for v in self.vectors]
+        )
+        self.assertVectorsEqual(
+            self.a.reflect(self.b),
+            [v.reflect(o) for v, o in zip(self.vectors, self.others)],
+        )
+        self.assertVectorsEqual(
+            self.a.slerp(self.b, 0.5),
+            [v.slerp(o, 0.5) for v, o in zip(self.vectors, self.others)],
+        )
+        self.assertVectorsEqual(
+            self.a.move_towards((1, 1, 1), 0.5),
+            [v.move_towards((1, 1, 1), 0.5) for v in self.vectors],
+        )
+        self.assertVectorsEqual(
+            self.a.clamp_magnitude(1, 2),
+            [v.clamp_magnitude(1, 2) for v in self.vectors],
+        )
+        for got, v, o in zip(self.a.dot(self.b), self.vectors, self.others):
+            self.assertAlmostEqual(got, v.dot(o))
+
+
+class Matrix3TypeTest(unittest.TestCase):
+    def setUp(self):
+        self.m = (
+            Matrix3.from_translation((10, -5))
+            @ Matrix3.from_rotation(30)
+            @ Matrix3.from_scale((2, 0.5))
+        )
+        self.points = [Vector2(1, 2), Vector2(-3, 0.5), Vector2(0, 0)]
+
+    def assertVectorAlmostEqual(self, got, expected):
+        for a, b in zip(got, expected):
+            self.assertAlmostEqual(a, b)
+
+    def test_construction(self):
+        identity = Matrix3()
+        self.assertEqual(
+            memoryview(identity).tolist(), [[1, 0, 0], [0, 1, 0], [0, 0, 1]]
+        )
+        self.assertEqual(Matrix3(range(9)), Matrix3([[0, 1, 2], [3, 4, 5], [6, 7, 8]]))
+        self.assertEqual(Matrix3(self.m), self.m)
+        self.assertEqual(Matrix3.from_scale(2), Matrix3.from_scale((2, 2)))
+        self.assertRaises(TypeError, Matrix3, range(8))
+        self.assertRaises(TypeError, Matrix3, [[1, 2], [3, 4]])
+        self.assertRaises(TypeError, Matrix3, Matrix4())
+        self.assertRaises(TypeError, Matrix3.from_translation, (1, 2, 3))
+
+        # ints too big for a float raise instead of leaving an error set
+        self.assertRaises(OverflowError, Matrix3, [[10**400, 0, 0], [0, 1, 0], [0] * 3])
+        self.assertRaises(OverflowError, Matrix3, [10**400] + [0] * 8)
+        self.assertRaises(OverflowError, Matrix3.from_scale, 10**400)
+
+    def test_subscript(self):
+        m = Matrix3(range(9))
+        self.assertEqual(m[1, 2], 5)
+        self.assertEqual(m[-1, 0], 6)
+        m[0, 1] = 7.5
+        self.assertEqual(m[0, 1], 7.5)
+        self.assertRaises(IndexError, lambda: m[3, 0])
+        self.assertRaises(TypeError, lambda: m[0])
+        with self.assertRaises(TypeError):
+            del m[0, 0]
+
+    def test_transform(self):
+        for point in self.points:
+            expected = point.elementwise() * (2, 0.5)
+            expected = expected.rotate(30) + (10, -5)
+            self.assertVectorAlmostEqual(self.m.transform_point(point), expected)
+            self.assertVectorAlmostEqual(self.m @ point, expected)
+            self.assertVectorAlmostEqual(
+                self.m.transform_vector(point),
+                (point.elementwise() * (2, 0.5)).rotate(30),
+            )
+        self.assertIsInstance(self.m @ (1, 2), Vector2)
+        self.assertEqual(
+            Matrix3.from_rotation(90) @ Vector2(1, 2), Vector2(1, 2).rotate(90)
+        )
+        self.assertRaises(TypeError, self.m.transform_point, (1, 2, 3))
+
+    def test_projection(self):
+        m = Matrix3([1, 0, 0, 0, 1, 0, 0.5, 0, 1])
+        self.assertVectorAlmostEqual(m @ Vector2(2, 4), (1, 2))
+        self.assertVectorAlmostEqual(m.transform_vector((2, 4)), (2, 4))
+
+        # the point (-2, 0) would be projected to infinity
+        self.assertRaises(ValueError, m.transform_point, (-2, 0))
+        self.assertRaises(ValueError, m.transform_points, [(1, 1), (-2, 0)])
+        points = Vector2Array([(1, 1), (-2, 0)])
+        self.assertRaises(ValueError, m.transform_points_ip, points)
+        self.assertEqual(list(points), [Vector2(1, 1), Vector2(-2, 0)])
+        self.assertRaises(ValueError, m.decompose)
+
+    def test_transform_points(self):
+        expected = [self.m @ point for point in self.points]
+        transformed = self.m.transform_points(self.points)
+        self.assertIsInstance(transformed, Vector2Array)
+        for got, want in zip(transformed, expected):
+            self.assertVectorAlmostEqual(got, want)
+
+        points = Vector2Array(self.points)
+        for got, want in zip(self.m @ points, expected):
+            self.assertVectorAlmostEqual(got, want)
+        self.assertEqual(list(points), self.points)
+
+        self.assertIsNone(self.m.transform_points_ip(points))
+        for got, want in zip(points, expected):
+            self.assertVectorAlmostEqual(got, want)
+
+        buffer = array.array("d", [1, 2, -3, 0.5])
+        self.m.transform_points_ip(buffer)
+        self.assertVectorAlmostEqual(buffer[2:], expected[1])
+        self.assertRaises(TypeError, self.m.transform_points_ip, array.array("d", [1]))
+        self.assertRaises(TypeError, self.m.transform_points_ip, bytearray(16))
+
+    def test_compose_and_invert(self):
+        inverse = self.m.inverse()
+        product = self.m @ inverse
+        for row in range(3):
+            for col in range(3):
+                self.assertAlmostEqual(product[row, col], row == col)
+        self.assertAlmostEqual(self.m.determinant(), 1)
+        self.assertAlmostEqual(inverse.determinant(), 1)
+        self.assertRaises(ValueError, Matrix3.from_scale(0).inverse)
+        self.assertEqual(self.m.transpose().transpose(), self.m)
+        self.assertEqual(self.m.transpose()[2, 0], self.m[0, 2])
+
+        m = self.m.copy()
+        other = Matrix3.from_translation((1, 1))
+        m @= other
+        self.assertEqual(m, self.m @ other)
+        self.assertNotEqual(m, self.m)
+
+    def test_decompose(self):
+        translation, angle, scale = self.m.decompose()
+        self.assertVectorAlmostEqual(translation, (10, -5))
+        self.assertAlmostEqual(angle, 30)
+        self.assertVectorAlmostEqual(scale, (2, 0.5))
+
+        _, angle, scale = Matrix3.from_scale((1, -2)).decompose()
+        self.assertAlmostEqual(angle, 0)
+        self.assertVectorAlmostEqual(scale, (1, -2))
+        self.assertRaises(ValueError, Matrix3.from_scale(0).decompose)
+
+
+class Matrix4TypeTest(unittest.TestCase):
+    def setUp(self):
+        self.axis = Vector3(1, 2, -3).normalize()
+        self.m = (
+            Matrix4.from_translation((1, 2, 3))
+            @ Matrix4.from_rotation(40, self.axis)
+            @ Matrix4.from_scale((2, 3, 4))
+        )
+        self.points = [Vector3(1, 2, 3), Vector3(-3, 0.5, 0), Vector3(0, 0, 0)]
+
+    def assertVectorAlmostEqual(self, got, expected):
+        for a, b in zip(got, expected):
+            self.assertAlmostEqual(a, b)
+
+    def test_construction(self):
+        self.assertEqual(Matrix4(), Matrix4.from_scale(1))
+        self.assertEqual(Matrix4(range(16))[3, 1], 13)
+        self.assertEqual(memoryview(self.m).shape, (4, 4))
+        self.assertRaises(TypeError, Matrix4, range(9))
+        self.assertRaises(TypeError, Matrix4.from_rotation, 90)
+        self.assertRaises(ValueError, Matrix4.from_rotation, 90, (0, 0, 0))
+
+    def test_transform(self):
+        for point in self.points:
+            expected = point.elementwise() * (2, 3, 4)
+            expected = expected.rotate(40, self.axis) + (1, 2, 3)
+            self.assertVectorAlmostEqual(self.m @ point, expected)
+        self.assertEqual(
+            Matrix4.from_rotation(90, (0, 0, 1)) @ Vector3(1, 2, 3),
+            Vector3(1, 2, 3).rotate(90, (0, 0, 1)),
+        )
+        perspective = Matrix4([1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0])
+        self.assertVectorAlmostEqual(perspective @ Vector3(2, 4, 2), (1, 2, 1))
+        self.assertRaises(ValueError, perspective.__matmul__, Vector3(1, 2, 0))
+        self.assertRaises(ValueError, perspective.decompose)
+
+        transformed = self.m @ Vector3Array(self.points)
+        self.assertIsInstance(transformed, Vector3Array)
+        for got, point in zip(transformed, self.points):
+            self.assertVectorAlmostEqual(got, self.m @ point)
+
+    def test_compose_and_invert(self):
+        product = self.m.inverse() @ self.m
+        for row in range(4):
+            for col in range(4):
+                self.assertAlmostEqual(product[row, col], row == col)
+        self.assertAlmostEqual(self.m.determinant(), 24)
+        self.assertRaises(ValueError, Matrix4.from_scale((1, 0, 1)).inverse)
+
+    def assertRebuilds(self, m):
+        translation, angle, axis, scale = m.decompose()
+        rebuilt = (
+            Matrix4.from_translation(translation)
+            @ Matrix4.from_rotation(angle, axis)
+            @ Matrix4.from_scale(scale)
+        )
+        for row in range(4):
+            for col in range(4):
+                self.assertAlmostEqual(rebuilt[row, col], m[row, col])
+        return translation, angle, axis, scale
+
+    def test_decompose(self):
+        for angle in (40, 0.5, 135, 179.9, 180):
+            m = (
+                Matrix4.from_translation((1, 2, 3))
+                @ Matrix4.from_rotation(angle, self.axis)
+                @ Matrix4.from_scale((2, 3, 4))
+            )
+            translation, got_angle, axis, scale = self.assertRebuilds(m)
+            self.assertVectorAlmostEqual(translation, (1, 2, 3))
+            self.assertVectorAlmostEqual(scale, (2, 3, 4))
+            self.assertAlmostEqual(got_angle, angle, places=4)
+            if angle < 180:
+                self.assertVectorAlmostEqual(axis, self.axis)
+
+        # a reflection is put into the scale of x
+        m = Matrix4.from_rotation(40, self.axis) @ Matrix4.from_scale((2, -3, 4))
+        self.assertLess(self.assertRebuilds(m)[3].x, 0)
+
+        _, angle, axis, _ = Matrix4().decompose()
+        self.assertEqual(angle, 0)
+        self.assertRaises(ValueError, Matrix4.from_scale(0).decompose)
+
+
 if __name__ == "__main__":
     unittest.main()
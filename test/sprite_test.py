@@ -665,6 +665,109 @@ class AbstractGroupTypeTest(unittest.TestCase):
         self.assertEqual(test_sprite.sink_kwargs, {"foo": 4, "bar": 5})
 
 
+class FastGroupTypeTest(unittest.TestCase):
+    def setUp(self):
+        self.group = sprite.FastGroup()
+        self.sprites = []
+        for i, color in enumerate(("red", "green", "blue", "white")):
+            spr = sprite.Sprite(self.group)
+            spr.image = pygame.Surface((10, 10))
+            spr.image.fill(pygame.Color(color))
+            spr.rect = spr.image.get_rect(topleft=(10 * (i % 2), 10 * (i // 2)))
+            self.sprites.append(spr)
+
+        self.bg = pygame.Surface((20, 20))
+        self.scr = pygame.Surface((20, 20))
+        self.scr.fill(pygame.Color("grey"))
+
+    def test_add_remove(self):
+        s1, s2, s3, s4 = self.sprites
+        self.assertEqual(len(self.group), 4)
+        self.assertTrue(self.group)
+
+        self.group.add(s1)
+        self.assertEqual(len(self.group), 4)
+
+        self.group.remove(s2)
+        self.assertNotIn(s2, self.group)
+        self.assertNotIn(self.group, s2.groups())
+        self.assertCountEqual(self.group.sprites(), [s1, s3, s4])
+
+        s1.kill()
+        self.assertCountEqual(self.group.sprites(), [s3, s4])
+
+        self.group.empty()
+        self.assertEqual(len(self.group), 0)
+        self.assertFalse(self.group)
+
+    def test_add_remove_many(self):
+        sprites = [sprite.Sprite() for _ in range(1000)]
+        self.group.add(sprites)
+        self.group.remove(sprites[::2])
+
+        self.assertCountEqual(self.group.sprites(), self.sprites + sprites[1::2])
+        for spr in sprites[1::2]:
+            self.assertIn(spr, self.group)
+        for spr in sprites[::2]:
+            self.assertNotIn(spr, self.group)
+
+    def test_draw(self):
+        self.assertEqual(self.group.draw(self.scr), [])
+        self.assertEqual(self.scr.get_at((5, 5)), (255, 0, 0, 255))
+        self.assertEqual(self.scr.get_at((15, 5)), (0, 255, 0, 255))
+        self.assertEqual(self.scr.get_at((5, 15)), (0, 0, 255, 255))
+        self.assertEqual(self.scr.get_at((15, 15)), (255, 255, 255, 255))
+
+        spritedict = self.group.spritedict
+        self.assertEqual(spritedict[self.sprites[0]], pygame.Rect(0, 0, 10, 10))
+        self.assertEqual(spritedict[self.sprites[3]], pygame.Rect(10, 10, 10, 10))
+
+    def test_draw__requires_surface_image(self):
+        self.sprites[0].image = None
+
+        with self.assertRaises(TypeError):
+            self.group.draw(self.scr)
+
+    def test_clear(self):
+        self.group.draw(self.scr)
+        self.group.remove(self.sprites[3])
+        self.assertEqual(self.group.lostsprites, [pygame.Rect(10, 10, 10, 10)])
+
+        self.group.clear(self.scr, self.bg)
+        for pos in ((5, 5), (15, 5), (5, 15), (15, 15)):
+            self.assertEqual(self.scr.get_at(pos), (0, 0, 0, 255))
+
+        self.group.draw(self.scr)
+        self.assertEqual(self.group.lostsprites, [])
+
+    def test_clear__callable(self):
+        cleared = []
+        self.group.draw(self.scr)
+        self.group.clear(self.scr, lambda surf, rect: cleared.append(rect))
+
+        self.assertCountEqual(cleared, [spr.rect for spr in self.sprites])
+
+    def test_update(self):
+        class test_sprite(sprite.Sprite):
+            def update(self, *args, **kwargs):
+                self.received = (args, kwargs)
+                self.kill()
+
+        sprites = [test_sprite(self.group) for _ in range(3)]
+        self.group.update(1, 2, foo=3)
+
+        for spr in sprites:
+            self.assertEqual(spr.received, ((1, 2), {"foo": 3}))
+            self.assertNotIn(spr, self.group)
+        self.assertEqual(len(self.group), 4)
+
+    def test_copy(self):
+        group = self.group.copy()
+
+        self.assertIsInstance(group, sprite.FastGroup)
+        self.assertCountEqual(group.sprites(), self.sprites)
+
+
 ################################################################################
 
 # A base class to share tests between similar classes
@@ -1067,6 +1170,105 @@ class LayeredGroupBase:
         self.assertListEqual(sprites2, layer2_sprites)
         self.assertEqual(len(self.LG), len(sprites1) + len(sprites2))
 
+    def test_change_layer__many_sprites(self):
+        sprites = [self.sprite() for _ in range(2000)]
+        for i, spr in enumerate(sprites):
+            self.LG.add(spr, layer=i % 7)
+        for i, spr in enumerate(sprites[::3]):
+            self.LG.change_layer(spr, i % 5)
+        self.LG.remove(sprites[1::5])
+
+        layers = [self.LG.get_layer_of_sprite(spr) for spr in self.LG.sprites()]
+        self.assertEqual(layers, sorted(layers))
+        self.assertEqual(len(self.LG), len(sprites) - len(sprites[1::5]))
+        for layer in self.LG.layers():
+            self.assertEqual(
+                self.LG.get_sprites_from_layer(layer),
+                [
+                    spr
+                    for spr in self.LG.sprites()
+                    if self.LG.get_layer_of_sprite(spr) == layer
+                ],
+            )
+
+    def test_sort_layers(self):
+        depths = [5, 3, 5, 1, 3, 5, 2]
+        sprites = [self.sprite() for _ in depths]
+        for spr, depth in zip(sprites, depths):
+            self.LG.add(spr, layer=0)
+            spr.depth = depth
+
+        self.LG.sort_layers(lambda spr: spr.depth)
+
+        # sprites with equal keys keep the order they had
+        self.assertEqual(self.LG.sprites(), sorted(sprites, key=lambda spr: spr.depth))
+        for spr in sprites:
+            self.assertEqual(self.LG.get_layer_of_sprite(spr), spr.depth)
+            if hasattr(spr, "_layer"):
+                self.assertEqual(spr.layer, spr.depth)
+        self.assertEqual(self.LG.layers(), [1, 2, 3, 5])
+
+        sprites[3].depth = 4
+        self.LG.sort_layers(lambda spr: spr.depth)
+        self.assertEqual(self.LG.get_sprites_from_layer(4), [sprites[3]])
+        self.assertEqual(self.LG.get_top_sprite(), sprites[5])
+
+        spr = self.sprite()
+        self.LG.add(spr, layer=3)
+        self.assertEqual(
+            self.LG.get_sprites_from_layer(3), [sprites[1], sprites[4], spr]
+        )
+
+    def test_sort_layers__invalid_key(self):
+        sprites = [self.sprite() for _ in range(3)]
+        self.LG.add(sprites)
+
+        with self.assertRaises(TypeError):
+            self.LG.sort_layers(lambda spr: "top")
+        self.assertEqual(self.LG.sprites(), sprites)
+
+        # a key failing part way through must not change any sprite
+        keys = iter([2, 1])
+        with self.assertRaises(StopIteration):
+            self.LG.sort_layers(lambda spr: next(keys))
+        self.assertEqual(self.LG.sprites(), sprites)
+        for spr in sprites:
+            self.assertEqual(self.LG.get_layer_of_sprite(spr), 0)
+            if hasattr(spr, "_layer"):
+                self.assertEqual(spr._layer, 0)
+
+    def test_sort_layers__failing_setattr(self):
+        class FussySprite(self.sprite):
+            @property
+            def _layer(self):
+                return self.__dict__.get("layer_value", 0)
+
+            @_layer.setter
+            def _layer(self, value):
+                if value == 2:
+                    raise ValueError("no layer 2")
+                self.__dict__["layer_value"] = value
+
+        sprites = [FussySprite() for _ in range(3)]
+        self.LG.add(sprites)
+
+        with self.assertRaises(ValueError):
+            self.LG.sort_layers(lambda spr: 3 - sprites.index(spr))
+        self.assertEqual(self.LG.sprites(), sprites)
+        for spr in sprites:
+            self.assertEqual(self.LG.get_layer_of_sprite(spr), 0)
+            self.assertEqual(spr._layer, 0)
+
+    def test_spritelist_slicing(self):
+        sprites = [self.sprite() for _ in range(4)]
+        for layer, spr in enumerate(sprites):
+            self.LG.add(spr, layer=3 - layer)
+
+        self.assertEqual(self.LG._spritelist[:], sprites[::-1])
+        self.assertEqual(self.LG._spritelist[1:3], sprites[2:0:-1])
+        self.assertEqual(self.LG._spritelist[-1], sprites[0])
+        self.assertEqual(self.LG._spritelist[::-1], sprites)
+
     def test_copy(self):
         self.LG.add(self.sprite())
         spr = self.LG.sprites()[0]
@@ -1222,6 +1424,74 @@ class LayeredDirtyTypeTest__DirtySprite(LayeredGroupBase, unittest.TestCase):
         """
         self._nondirty_intersections_redrawn(True)
 
+    def test_draw__overlapping_lost_areas(self):
+        """Ensure a sprite is redrawn once where removed sprites overlapped."""
+        surface = pygame.Surface((40, 40))
+        background = pygame.Surface((40, 40))
+        background.fill((0, 0, 0))
+        image = pygame.Surface((40, 40), pygame.SRCALPHA)
+        image.fill((255, 0, 0, 128))
+
+        translucent = self.sprite()
+        translucent.image = image
+        translucent.rect = image.get_rect()
+        self.LG.add(translucent)
+        covers = []
+        for x in (0, 10):
+            cover = self.sprite()
+            cover.image = pygame.Surface((20, 20))
+            cover.rect = pygame.Rect(x, 0, 20, 20)
+            self.LG.add(cover, layer=1)
+            covers.append(cover)
+
+        self.LG.draw(surface, background)
+        self.LG._use_update = True
+        self.LG.draw(surface)
+        self.LG.remove(covers)
+        self.LG._use_update = True
+        rects = self.LG.draw(surface)
+
+        for i, rect in enumerate(rects):
+            self.assertEqual(rect.collidelist(rects[i + 1 :]), -1)
+        self.assertEqual(surface.get_at((15, 5)), surface.get_at((5, 5)))
+        self.assertEqual(surface.get_at((15, 5)), surface.get_at((15, 30)))
+
+    def test_draw__sprite_under_opaque_sprite(self):
+        """Ensure a sprite hidden by an opaque sprite is drawn once uncovered."""
+        RED = pygame.Color("red")
+        BLUE = pygame.Color("blue")
+        surface = pygame.Surface((60, 60))
+        background = pygame.Surface((60, 60))
+        background.fill((0, 0, 0))
+
+        hidden = self.sprite()
+        hidden.image = pygame.Surface((10, 10))
+        hidden.image.fill(RED)
+        hidden.rect = pygame.Rect(20, 20, 10, 10)
+        hidden.dirty = 2
+        self.LG.add(hidden)
+        cover = self.sprite()
+        cover.image = pygame.Surface((30, 30))
+        cover.image.fill(BLUE)
+        cover.rect = pygame.Rect(10, 10, 30, 30)
+        self.LG.add(cover, layer=1)
+
+        for use_update in (False, True):
+            self.LG._use_update = use_update
+            self.LG.draw(surface, background)
+
+            self.assertEqual(surface.get_at((25, 25)), BLUE)
+            self.assertEqual(self.LG.spritedict[hidden], hidden.rect)
+
+        cover.rect.x = 40
+        cover.dirty = 1
+        self.LG._use_update = True
+        self.LG.draw(surface)
+
+        self.assertEqual(surface.get_at((25, 25)), RED)
+        self.assertEqual(surface.get_at((15, 15)), (0, 0, 0))
+        self.assertEqual(surface.get_at((45, 15)), BLUE)
+
 
 ############################### SPRITE BASE CLASS ##############################
 #
@@ -1344,6 +1614,7 @@ class SpriteTypeTest(SpriteBase, unittest.TestCase):
 
     Groups = [
         sprite.Group,
+        sprite.FastGroup,
         sprite.LayeredUpdates,
         sprite.RenderUpdates,
         sprite.OrderedUpdates,
@@ -1355,6 +1626,7 @@ class DirtySpriteTypeTest(SpriteBase, unittest.TestCase):
 
     Groups = [
         sprite.Group,
+        sprite.FastGroup,
         sprite.LayeredUpdates,
         sprite.RenderUpdates,
         sprite.OrderedUpdates,
@@ -2581,6 +2581,106 @@ class GeneralSurfaceTests(AssertRaisesRegexMixin, unittest.TestCase):
         surf.scroll(dx=-3, dy=-3)
         self.assertEqual(surf.get_at((0, 0)), spot_color)
 
+    def test_damage_tracking(self):
+        """Ensures blit, fill, set_at and draw calls are recorded as damage."""
+        surf = pygame.Surface((100, 100))
+        sprite = pygame.Surface((10, 10))
+
+        surf.fill((1, 2, 3))
+        self.assertEqual(surf.get_damage(), [])
+
+        surf.set_damage_tracking()
+        surf.blit(sprite, (95, -5))
+        self.assertEqual(surf.get_damage(), [Rect(95, 0, 5, 5)])
+
+        surf.fill((255, 0, 0), (95, 5, 5, 10))
+        self.assertEqual(surf.get_damage(), [Rect(95, 0, 5, 15)])
+
+        surf.set_at((0, 0), (0, 255, 0))
+        drawn = pygame.draw.rect(surf, (0, 0, 255), (40, 40, 10, 10), 1)
+        self.assertEqual(
+            sorted(surf.get_damage()),
+            sorted([Rect(95, 0, 5, 15), Rect(0, 0, 1, 1), drawn]),
+        )
+
+        surf.clear_damage()
+        self.assertEqual(surf.get_damage(), [])
+
+        surf.set_damage_tracking(False)
+        surf.fill((0, 0, 0))
+        self.assertEqual(surf.get_damage(), [])
+
+    def test_damage_tracking__max_rects(self):
+        """Ensures the damage is merged down to max_rects rects covering
+        everything drawn."""
+        surf = pygame.Surface((100, 100))
+        surf.set_damage_tracking(max_rects=4)
+        spots = [Rect(x * 11, y * 11, 5, 5) for x in range(9) for y in range(9)]
+        for spot in spots:
+            surf.fill((255, 255, 255), spot)
+
+        damage = surf.get_damage()
+        self.assertLessEqual(len(damage), 4)
+        for spot in spots:
+            self.assertTrue(any(r.contains(spot) for r in damage))
+
+        surf.set_damage_tracking(max_rects=1)
+        self.assertEqual(surf.get_damage(), [Rect(0, 0, 93, 93)])
+
+        for max_rects in (0, 65):
+            with self.assertRaises(ValueError):
+                surf.set_damage_tracking(max_rects=max_rects)
+
+    def test_damage_tracking__subsurface(self):
+        """Ensures drawing to a subsurface is recorded on its parents."""
+        surf = pygame.Surface((100, 100))
+        sub = surf.subsurface((10, 20, 50, 50))
+        subsub = sub.subsurface((5, 5, 20, 20))
+        surf.set_damage_tracking()
+        sub.set_damage_tracking()
+
+        subsub.fill((255, 255, 255), (0, 0, 30, 5))
+
+        self.assertEqual(sub.get_damage(), [Rect(5, 5, 20, 5)])
+        self.assertEqual(surf.get_damage(), [Rect(15, 25, 20, 5)])
+        self.assertEqual(subsub.get_damage(), [])
+
+    def test_damage_tracking__pixel_access(self):
+        """Ensures all of the surface is recorded as damage when its pixels
+        can be written directly."""
+        surf = pygame.Surface((100, 100))
+        sub = surf.subsurface((10, 20, 30, 40))
+        surf.set_damage_tracking()
+
+        def written(access):
+            surf.clear_damage()
+            access()
+            return surf.get_damage()
+
+        whole = [surf.get_rect()]
+        self.assertEqual(written(surf.get_view), [])  # buffer not taken yet
+        self.assertEqual(written(lambda: memoryview(surf.get_view())), whole)
+        self.assertEqual(written(lambda: surf.get_buffer().write(b"x")), whole)
+        self.assertEqual(written(lambda: surf._pixels_address), whole)
+        self.assertEqual(written(surf.lock), whole)
+        surf.unlock()
+        self.assertEqual(written(lambda: pygame.PixelArray(surf)), whole)
+        self.assertEqual(
+            written(lambda: memoryview(sub.get_view())), [Rect(10, 20, 30, 40)]
+        )
+
+        source = pygame.Surface((50, 50))
+        self.assertEqual(
+            written(lambda: pygame.transform.scale(source, (100, 100), surf)),
+            whole,
+        )
+
+        mask = pygame.mask.Mask((10, 10), fill=True)
+        self.assertEqual(
+            written(lambda: mask.to_surface(surf, dest=(95, 5))),
+            [Rect(95, 5, 5, 10)],
+        )
+
 
 class SurfaceSubtypeTest(unittest.TestCase):
     """Issue #280: Methods that return a new Surface preserve subclasses"""